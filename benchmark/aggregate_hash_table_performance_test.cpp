@@ -14,6 +14,10 @@ See the Mulan PSL v2 for more details. */
 #include "common/lang/vector.h"
 #include "sql/expr/aggregate_hash_table.h"
 
+/**
+ * @brief 单个 INTS 类型的 group by 列，单个 SUM 聚合列
+ * @details state.range(0) 是 chunk 的行数，state.range(1) 是分组的个数
+ */
 class AggregateHashTableBenchmark : public benchmark::Fixture
 {
 public:
@@ -22,7 +26,7 @@ public:
     unique_ptr<Column> column1 = make_unique<Column>(AttrType::INTS, 4);
     unique_ptr<Column> column2 = make_unique<Column>(AttrType::INTS, 4);
     for (int i = 0; i < state.range(0); i++) {
-      int key = i % 8;
+      int key = i % state.range(1);
       column1->append_one((char *)&key);
       column2->append_one((char *)&i);
     }
@@ -36,6 +40,11 @@ public:
     aggr_chunk_.reset();
   }
 
+  static void register_args(benchmark::internal::Benchmark *b)
+  {
+    b->Args({16, 8})->Args({1024, 8})->Args({8192, 8})->Args({8192, 1024})->Args({8192, 8192});
+  }
+
 protected:
   Chunk group_chunk_;
   Chunk aggr_chunk_;
@@ -63,9 +72,125 @@ BENCHMARK_DEFINE_F(DISABLED_StandardAggregateHashTableBenchmark, Aggregate)(benc
   for (auto _ : state) {
     standard_hash_table_->add_chunk(group_chunk_, aggr_chunk_);
   }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_REGISTER_F(DISABLED_StandardAggregateHashTableBenchmark, Aggregate)
+    ->Apply(AggregateHashTableBenchmark::register_args);
+
+class DISABLED_OpenAddressingAggregateHashTableBenchmark : public AggregateHashTableBenchmark
+{
+public:
+  void SetUp(const ::benchmark::State &state) override
+  {
+    AggregateHashTableBenchmark::SetUp(state);
+    AggregateExpr        aggregate_expr(AggregateExpr::Type::SUM, nullptr);
+    vector<Expression *> aggregate_exprs;
+    aggregate_exprs.push_back(&aggregate_expr);
+    open_addressing_hash_table_ = make_unique<OpenAddressingAggregateHashTable>(aggregate_exprs);
+  }
+
+protected:
+  unique_ptr<AggregateHashTable> open_addressing_hash_table_;
+};
+
+BENCHMARK_DEFINE_F(DISABLED_OpenAddressingAggregateHashTableBenchmark, Aggregate)(benchmark::State &state)
+{
+  for (auto _ : state) {
+    open_addressing_hash_table_->add_chunk(group_chunk_, aggr_chunk_);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_REGISTER_F(DISABLED_OpenAddressingAggregateHashTableBenchmark, Aggregate)
+    ->Apply(AggregateHashTableBenchmark::register_args);
+
+/**
+ * @brief 多个 group by 列(INTS, CHARS(8), DATES)，多个聚合列(COUNT, SUM, AVG, MAX)
+ */
+class MultiColumnAggregateHashTableBenchmark : public benchmark::Fixture
+{
+public:
+  void SetUp(const ::benchmark::State &state) override
+  {
+    auto group1 = make_unique<Column>(AttrType::INTS, 4);
+    auto group2 = make_unique<Column>(AttrType::CHARS, 8);
+    auto group3 = make_unique<Column>(AttrType::DATES, 4);
+    auto aggr1  = make_unique<Column>(AttrType::INTS, 4);
+    auto aggr2  = make_unique<Column>(AttrType::INTS, 4);
+    auto aggr3  = make_unique<Column>(AttrType::FLOATS, 4);
+    auto aggr4  = make_unique<Column>(AttrType::CHARS, 8);
+    for (int i = 0; i < state.range(0); i++) {
+      int   key  = i % state.range(1);
+      int   date = 20200101 + key % 28;
+      float fval = i + 0.5f;
+      char  str[8];
+      memset(str, 0, sizeof(str));
+      snprintf(str, sizeof(str), "k%d", key % 16);
+
+      group1->append_one((char *)&key);
+      group2->append_one(str);
+      group3->append_one((char *)&date);
+      aggr1->append_one((char *)&i);
+      aggr2->append_one((char *)&i);
+      aggr3->append_one((char *)&fval);
+      aggr4->append_one(str);
+    }
+    group_chunk_.add_column(std::move(group1), 0);
+    group_chunk_.add_column(std::move(group2), 1);
+    group_chunk_.add_column(std::move(group3), 2);
+    aggr_chunk_.add_column(std::move(aggr1), 0);
+    aggr_chunk_.add_column(std::move(aggr2), 1);
+    aggr_chunk_.add_column(std::move(aggr3), 2);
+    aggr_chunk_.add_column(std::move(aggr4), 3);
+
+    for (AggregateExpr::Type type : {AggregateExpr::Type::COUNT,
+             AggregateExpr::Type::SUM,
+             AggregateExpr::Type::AVG,
+             AggregateExpr::Type::MAX}) {
+      aggregate_exprs_.push_back(make_unique<AggregateExpr>(type, nullptr));
+      aggregations_.push_back(aggregate_exprs_.back().get());
+    }
+  }
+
+  void TearDown(const ::benchmark::State &state) override
+  {
+    group_chunk_.reset();
+    aggr_chunk_.reset();
+    aggregations_.clear();
+    aggregate_exprs_.clear();
+  }
+
+protected:
+  Chunk                             group_chunk_;
+  Chunk                             aggr_chunk_;
+  vector<unique_ptr<AggregateExpr>> aggregate_exprs_;
+  vector<Expression *>              aggregations_;
+};
+
+BENCHMARK_DEFINE_F(MultiColumnAggregateHashTableBenchmark, Standard)(benchmark::State &state)
+{
+  StandardAggregateHashTable hash_table(aggregations_);
+  for (auto _ : state) {
+    hash_table.add_chunk(group_chunk_, aggr_chunk_);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_REGISTER_F(MultiColumnAggregateHashTableBenchmark, Standard)
+    ->Apply(AggregateHashTableBenchmark::register_args);
+
+BENCHMARK_DEFINE_F(MultiColumnAggregateHashTableBenchmark, OpenAddressing)(benchmark::State &state)
+{
+  OpenAddressingAggregateHashTable hash_table(aggregations_);
+  for (auto _ : state) {
+    hash_table.add_chunk(group_chunk_, aggr_chunk_);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
 }
 
-BENCHMARK_REGISTER_F(DISABLED_StandardAggregateHashTableBenchmark, Aggregate)->Arg(16)->Arg(1024)->Arg(8192);
+BENCHMARK_REGISTER_F(MultiColumnAggregateHashTableBenchmark, OpenAddressing)
+    ->Apply(AggregateHashTableBenchmark::register_args);
 
 #ifdef USE_SIMD
 class DISABLED_LinearProbingAggregateHashTableBenchmark : public AggregateHashTableBenchmark
@@ -89,7 +214,8 @@ BENCHMARK_DEFINE_F(DISABLED_LinearProbingAggregateHashTableBenchmark, Aggregate)
   }
 }
 
-BENCHMARK_REGISTER_F(DISABLED_LinearProbingAggregateHashTableBenchmark, Aggregate)->Arg(16)->Arg(1024)->Arg(8192);
+BENCHMARK_REGISTER_F(DISABLED_LinearProbingAggregateHashTableBenchmark, Aggregate)
+    ->Apply(AggregateHashTableBenchmark::register_args);
 #endif
 
 BENCHMARK_MAIN();
\ No newline at end of file
@@ -40,6 +40,10 @@ struct Stat
   int64_t scan_open_failed_count = 0;
   int64_t mismatch_count         = 0;
   int64_t scan_other_count       = 0;
+
+  int64_t lookup_success_count   = 0;
+  int64_t lookup_not_exist_count = 0;
+  int64_t lookup_other_count     = 0;
 };
 
 class BenchmarkBase : public Fixture
@@ -65,13 +69,17 @@ public:
 
     ::remove(btree_filename.c_str());
 
-    const int internal_max_size = 200;
-    const int leaf_max_size     = 200;
-
     const char *filename = btree_filename.c_str();
 
-    RC rc = handler_.create(
-        log_handler_, bpm_, filename, AttrType::INTS, sizeof(int32_t) /*attr_len*/, internal_max_size, leaf_max_size);
+    IndexMeta index_meta;
+    FieldMeta field_meta("key", AttrType::INTS, 0 /*attr_offset*/, sizeof(int32_t) /*attr_len*/, true /*visible*/,
+        0 /*field_id*/, false /*nullable*/);
+    RC rc = index_meta.init(btree_filename.c_str(), IndexType::BPlusTreeIndex, {field_meta});
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to init index meta");
+    }
+
+    rc = handler_.create(log_handler_, bpm_, filename, index_meta);
     if (rc != RC::SUCCESS) {
       throw runtime_error("failed to create btree handler");
     }
@@ -180,6 +188,21 @@ public:
     }
   }
 
+  void Lookup(uint32_t value, Stat &stat)
+  {
+    const char *key = reinterpret_cast<const char *>(&value);
+
+    list<RID> rids;
+    RC        rc = handler_.get_entry(key, sizeof(value), rids);
+    if (rc != RC::SUCCESS) {
+      stat.lookup_other_count++;
+    } else if (rids.empty()) {
+      stat.lookup_not_exist_count++;
+    } else {
+      stat.lookup_success_count++;
+    }
+  }
+
 protected:
   BufferPoolManager bpm_{512};
   BplusTreeHandler  handler_;
@@ -294,6 +317,84 @@ BENCHMARK_REGISTER_F(ScanBenchmark, Scan)->Threads(10)->Arg(4 * 10000);
 
 ////////////////////////////////////////////////////////////////////////////////
 
+/**
+ * @brief 点查询，主要看线程数增加时吞吐量能不能跟着增加
+ * @details 点查询几乎只访问 buffer pool 中已经存在的页面，瓶颈在 BPFrameManager 的锁上
+ */
+class LookupBenchmark : public BenchmarkBase
+{
+public:
+  string Name() const override { return "lookup"; }
+
+  void SetUp(const State &state) override
+  {
+    if (0 != state.thread_index()) {
+      return;
+    }
+
+    BenchmarkBase::SetUp(state);
+
+    uint32_t max = GetRangeMax(state);
+    ASSERT(max > 0, "invalid argument count. %ld", state.range(0));
+    FillUp(0, max);
+  }
+};
+
+BENCHMARK_DEFINE_F(LookupBenchmark, Lookup)(State &state)
+{
+  IntegerGenerator generator(0, GetRangeMax(state) - 1);
+  Stat             stat;
+
+  for (auto _ : state) {
+    Lookup(static_cast<uint32_t>(generator.next()), stat);
+  }
+
+  state.counters["success"]   = Counter(stat.lookup_success_count, Counter::kIsRate);
+  state.counters["not_exist"] = Counter(stat.lookup_not_exist_count, Counter::kIsRate);
+  state.counters["other"]     = Counter(stat.lookup_other_count, Counter::kIsRate);
+}
+
+BENCHMARK_REGISTER_F(LookupBenchmark, Lookup)->ThreadRange(1, 32)->Arg(4 * 10000)->UseRealTime();
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief 读多写少，点查询中夹杂少量插入
+ * @details 读操作使用乐观读，不加锁。看有写操作时读操作的吞吐量能不能随着线程数增加
+ */
+class ReadMostlyBenchmark : public LookupBenchmark
+{
+public:
+  string Name() const override { return "read_mostly"; }
+};
+
+BENCHMARK_DEFINE_F(ReadMostlyBenchmark, ReadMostly)(State &state)
+{
+  const uint32_t   max = GetRangeMax(state);
+  IntegerGenerator lookup_generator(0, max - 1);
+  IntegerGenerator insert_generator(max, max * 2);
+  IntegerGenerator operation_generator(0, 99);
+  Stat             stat;
+
+  for (auto _ : state) {
+    if (operation_generator.next() < 5) {
+      Insert(static_cast<uint32_t>(insert_generator.next()), stat);
+    } else {
+      Lookup(static_cast<uint32_t>(lookup_generator.next()), stat);
+    }
+  }
+
+  state.counters["lookup_success"]   = Counter(stat.lookup_success_count, Counter::kIsRate);
+  state.counters["lookup_not_exist"] = Counter(stat.lookup_not_exist_count, Counter::kIsRate);
+  state.counters["lookup_other"]     = Counter(stat.lookup_other_count, Counter::kIsRate);
+  state.counters["insert_success"]   = Counter(stat.insert_success_count, Counter::kIsRate);
+  state.counters["insert_other"]     = Counter(stat.insert_other_count, Counter::kIsRate);
+}
+
+BENCHMARK_REGISTER_F(ReadMostlyBenchmark, ReadMostly)->ThreadRange(1, 32)->Arg(4 * 10000)->UseRealTime();
+
+////////////////////////////////////////////////////////////////////////////////
+
 struct MixtureBenchmark : public BenchmarkBase
 {
   string Name() const override { return "mixture"; }
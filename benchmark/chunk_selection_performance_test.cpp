@@ -0,0 +1,119 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/18.
+//
+
+#include <benchmark/benchmark.h>
+
+#include "common/lang/random.h"
+#include "storage/common/chunk.h"
+
+using namespace std;
+
+/**
+ * @brief 过滤之后输出满足条件的行
+ * @details 对比三种做法：逐行逐列构造 Value 复制(原来的做法)，只设置选择向量，设置选择向量之后再按列收集。
+ * 参数是满足条件的行的百分比。
+ */
+class ChunkSelectionBenchmark : public benchmark::Fixture
+{
+public:
+  static constexpr int ROW_NUM = 8192;
+
+  void SetUp(const ::benchmark::State &state) override
+  {
+    const int selectivity = state.range(0);
+
+    mt19937 gen(1);
+    chunk_.reset();
+    output_.reset();
+    for (const auto &[type, len] : COLUMN_TYPES) {
+      chunk_.add_column(make_unique<Column>(type, len, ROW_NUM), chunk_.column_num());
+      output_.add_column(make_unique<Column>(type, len, ROW_NUM), output_.column_num());
+    }
+
+    vector<char> data(32, 0);
+    for (int i = 0; i < ROW_NUM; i++) {
+      for (int j = 0; j < chunk_.column_num(); j++) {
+        for (char &c : data) {
+          c = static_cast<char>('a' + gen() % 26);
+        }
+        chunk_.column(j).append_one(data.data());
+      }
+    }
+
+    select_.resize(ROW_NUM);
+    for (int i = 0; i < ROW_NUM; i++) {
+      select_[i] = static_cast<int>(gen() % 100) < selectivity ? 1 : 0;
+    }
+  }
+
+  void TearDown(const ::benchmark::State &state) override
+  {
+    chunk_.reset();
+    output_.reset();
+  }
+
+protected:
+  static inline const vector<pair<AttrType, int>> COLUMN_TYPES = {
+      {AttrType::INTS, 4}, {AttrType::FLOATS, 4}, {AttrType::DATES, 4}, {AttrType::CHARS, 8}, {AttrType::CHARS, 20}};
+
+  Chunk           chunk_;
+  Chunk           output_;
+  vector<uint8_t> select_;
+};
+
+BENCHMARK_DEFINE_F(ChunkSelectionBenchmark, RowByRowCopy)(benchmark::State &state)
+{
+  for (auto _ : state) {
+    output_.reset_data();
+    for (int i = 0; i < chunk_.rows(); i++) {
+      if (select_[i] == 0) {
+        continue;
+      }
+      for (int j = 0; j < chunk_.column_num(); j++) {
+        output_.column(j).append_one((char *)chunk_.get_value(j, i).data());
+      }
+    }
+    benchmark::DoNotOptimize(output_.rows());
+  }
+  state.SetItemsProcessed(state.iterations() * ROW_NUM);
+}
+
+BENCHMARK_DEFINE_F(ChunkSelectionBenchmark, SelectionVector)(benchmark::State &state)
+{
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(chunk_.set_selection(select_));
+  }
+  state.SetItemsProcessed(state.iterations() * ROW_NUM);
+}
+
+BENCHMARK_DEFINE_F(ChunkSelectionBenchmark, SelectionGather)(benchmark::State &state)
+{
+  for (auto _ : state) {
+    output_.reset_data();
+    const int rows = chunk_.set_selection(select_);
+    for (int j = 0; j < chunk_.column_num(); j++) {
+      output_.column(j).append_selected(chunk_.column(j), chunk_.selection().data(), rows);
+    }
+    benchmark::DoNotOptimize(output_.rows());
+  }
+  state.SetItemsProcessed(state.iterations() * ROW_NUM);
+}
+
+static void selectivity_args(benchmark::internal::Benchmark *b) { b->Arg(1)->Arg(10)->Arg(50)->Arg(90)->Arg(99); }
+
+BENCHMARK_REGISTER_F(ChunkSelectionBenchmark, RowByRowCopy)->Apply(selectivity_args);
+BENCHMARK_REGISTER_F(ChunkSelectionBenchmark, SelectionVector)->Apply(selectivity_args);
+BENCHMARK_REGISTER_F(ChunkSelectionBenchmark, SelectionGather)->Apply(selectivity_args);
+
+BENCHMARK_MAIN();
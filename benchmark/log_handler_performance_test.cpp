@@ -0,0 +1,162 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/18.
+//
+
+#include <benchmark/benchmark.h>
+
+#include "common/lang/filesystem.h"
+#include "common/lang/stdexcept.h"
+#include "common/log/log.h"
+#include "storage/clog/disk_log_handler.h"
+#include "storage/clog/log_replayer.h"
+
+using namespace std;
+using namespace common;
+using namespace benchmark;
+
+class EmptyLogReplayer : public LogReplayer
+{
+public:
+  RC replay(const LogEntry &) override { return RC::SUCCESS; }
+};
+
+/**
+ * @brief 模拟事务提交：每次追加一条日志，然后等待它落盘
+ * @details 多个线程同时提交时，一次刷盘可以让多个事务一起完成，提交的吞吐量随线程数增长
+ */
+class CommitBenchmark : public Fixture
+{
+public:
+  void SetUp(const State &state) override
+  {
+    if (0 != state.thread_index()) {
+      return;
+    }
+
+    LoggerFactory::init_default("log_handler_performance_test.log", LOG_LEVEL_WARN);
+
+    filesystem::remove_all(directory_);
+    handler_ = make_unique<DiskLogHandler>();
+    handler_->set_flush_interval_ms(static_cast<int>(state.range(0)));
+
+    EmptyLogReplayer replayer;
+    if (OB_FAIL(handler_->init(directory_)) || OB_FAIL(handler_->replay(replayer, 0)) ||
+        OB_FAIL(handler_->start())) {
+      throw runtime_error("failed to start log handler");
+    }
+  }
+
+  void TearDown(const State &state) override
+  {
+    if (0 != state.thread_index()) {
+      return;
+    }
+
+    handler_->stop();
+    handler_->await_termination();
+    handler_.reset();
+    filesystem::remove_all(directory_);
+  }
+
+protected:
+  const char                *directory_ = "log_handler_performance_test";
+  unique_ptr<DiskLogHandler> handler_;
+};
+
+BENCHMARK_DEFINE_F(CommitBenchmark, Commit)(State &state)
+{
+  int64_t failed_count = 0;
+  for (auto _ : state) {
+    LSN lsn = 0;
+    RC  rc  = handler_->append(lsn, LogModule::Id::TRANSACTION, vector<char>(64));
+    if (OB_SUCC(rc)) {
+      rc = handler_->wait_lsn(lsn);
+    }
+    if (OB_FAIL(rc)) {
+      failed_count++;
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  state.counters["failed"] = Counter(failed_count, Counter::kIsRate);
+}
+
+// 参数是刷盘线程空闲时的等待时间(毫秒)，不应该影响提交的延迟
+BENCHMARK_REGISTER_F(CommitBenchmark, Commit)->ThreadRange(1, 16)->Arg(10)->Arg(100)->UseRealTime();
+
+/**
+ * @brief 只追加日志不等待落盘，测试多个线程同时写日志缓冲区的开销
+ */
+BENCHMARK_DEFINE_F(CommitBenchmark, Append)(State &state)
+{
+  const vector<char> data(256);
+  int64_t            failed_count = 0;
+  for (auto _ : state) {
+    LSN lsn = 0;
+    if (OB_FAIL(handler_->append(lsn, LogModule::Id::TRANSACTION, span<const char>(data)))) {
+      failed_count++;
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * data.size());
+  state.counters["failed"] = Counter(failed_count, Counter::kIsRate);
+}
+
+BENCHMARK_REGISTER_F(CommitBenchmark, Append)->ThreadRange(1, 16)->Arg(10)->UseRealTime();
+
+/**
+ * @brief 像修改页面一样，写日志前用 LogLsnGuard 登记，第一个线程还会像检查点一样不时计算 stable_lsn
+ * @details 与 Append 比较，就是登记LSN的开销
+ */
+BENCHMARK_DEFINE_F(CommitBenchmark, GuardedAppend)(State &state)
+{
+  const vector<char> data(256);
+  int64_t            failed_count = 0;
+  LSN                stable_lsn   = 0;
+  int64_t            count        = 0;
+  for (auto _ : state) {
+    if (0 == state.thread_index() && 0 == (++count & 1023)) {
+      stable_lsn = max(stable_lsn, handler_->stable_lsn());
+    }
+
+    LogLsnGuard guard(*handler_);
+    LSN         lsn = 0;
+    if (OB_FAIL(handler_->append(lsn, LogModule::Id::BUFFER_POOL, span<const char>(data)))) {
+      failed_count++;
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * data.size());
+  state.counters["failed"] = Counter(failed_count, Counter::kIsRate);
+  DoNotOptimize(stable_lsn);
+}
+
+BENCHMARK_REGISTER_F(CommitBenchmark, GuardedAppend)->ThreadRange(1, 16)->Arg(10)->UseRealTime();
+
+/**
+ * @brief 只登记和取消登记LSN，不写日志
+ */
+BENCHMARK_DEFINE_F(CommitBenchmark, Guard)(State &state)
+{
+  for (auto _ : state) {
+    LogLsnGuard guard(*handler_);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_REGISTER_F(CommitBenchmark, Guard)->ThreadRange(1, 16)->Arg(10)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,174 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/18.
+//
+
+#include <benchmark/benchmark.h>
+
+#include "common/lang/filesystem.h"
+#include "common/lang/stdexcept.h"
+#include "common/log/log.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/buffer/double_write_buffer.h"
+#include "storage/clog/disk_log_handler.h"
+#include "storage/clog/integrated_log_replayer.h"
+#include "storage/record/record_manager.h"
+
+using namespace std;
+using namespace common;
+using namespace benchmark;
+
+/**
+ * @brief 测试恢复时回放日志的耗时
+ * @details 先向多个记录文件中插入、更新记录，生成日志。每一轮测试都把数据文件恢复成刚创建时的样子，
+ * 只是文件长度与写完数据后一样，相当于所有数据页面都没来得及刷盘，然后从头回放所有日志。参数是回放日志的线程数，需要在 CONCURRENCY 模式下编译才会并行回放。
+ * 调大 RECORD_NUM 可以生成更大的日志。
+ */
+class LogReplayBenchmark : public Fixture
+{
+public:
+  static constexpr int FILE_NUM    = 8;
+  static constexpr int RECORD_SIZE = 128;
+  static constexpr int RECORD_NUM  = 200000;
+
+  void SetUp(const State &state) override
+  {
+    LoggerFactory::init_default("log_replay_performance_test.log", LOG_LEVEL_WARN);
+
+    if (!generated_) {
+      generate();
+      generated_ = true;
+    }
+  }
+
+  void replay(State &state)
+  {
+    state.PauseTiming();
+    for (int i = 0; i < FILE_NUM; i++) {
+      filesystem::copy_file(origin_file(i), data_file(i), filesystem::copy_options::overwrite_existing);
+    }
+
+    BufferPoolManager bpm;
+    DiskLogHandler    log_handler;
+    if (OB_FAIL(bpm.init(make_unique<VacuousDoubleWriteBuffer>()))) {
+      throw runtime_error("failed to init buffer pool manager");
+    }
+    for (int i = 0; i < FILE_NUM; i++) {
+      DiskBufferPool *buffer_pool = nullptr;
+      if (OB_FAIL(bpm.open_file(log_handler, data_file(i).c_str(), buffer_pool))) {
+        throw runtime_error("failed to open buffer pool file");
+      }
+    }
+    state.ResumeTiming();
+
+    IntegratedLogReplayer replayer(bpm, static_cast<int>(state.range(0)));
+    if (OB_FAIL(log_handler.init(directory_)) || OB_FAIL(log_handler.replay(replayer, 0)) ||
+        OB_FAIL(replayer.on_done())) {
+      throw runtime_error("failed to replay log");
+    }
+
+    state.PauseTiming();
+    for (int i = 0; i < FILE_NUM; i++) {
+      bpm.close_file(data_file(i).c_str());
+    }
+    state.ResumeTiming();
+  }
+
+private:
+  string data_file(int i) const { return (filesystem::path(directory_) / ("data_" + to_string(i) + ".bp")).string(); }
+  string origin_file(int i) const { return data_file(i) + ".origin"; }
+
+  void generate()
+  {
+    filesystem::remove_all(directory_);
+    filesystem::create_directories(directory_);
+
+    BufferPoolManager bpm;
+    DiskLogHandler    log_handler;
+    if (OB_FAIL(bpm.init(make_unique<VacuousDoubleWriteBuffer>()))) {
+      throw runtime_error("failed to init buffer pool manager");
+    }
+
+    IntegratedLogReplayer replayer(bpm);
+    if (OB_FAIL(log_handler.init(directory_)) || OB_FAIL(log_handler.replay(replayer, 0)) ||
+        OB_FAIL(log_handler.start())) {
+      throw runtime_error("failed to start log handler");
+    }
+
+    vector<unique_ptr<RecordFileHandler>> handlers;
+    for (int i = 0; i < FILE_NUM; i++) {
+      DiskBufferPool *buffer_pool = nullptr;
+      if (OB_FAIL(bpm.create_file(data_file(i).c_str()))) {
+        throw runtime_error("failed to create buffer pool file");
+      }
+      filesystem::copy_file(data_file(i), origin_file(i), filesystem::copy_options::overwrite_existing);
+      if (OB_FAIL(bpm.open_file(log_handler, data_file(i).c_str(), buffer_pool))) {
+        throw runtime_error("failed to open buffer pool file");
+      }
+
+      auto handler = make_unique<RecordFileHandler>(StorageFormat::ROW_FORMAT);
+      if (OB_FAIL(handler->init(*buffer_pool, log_handler, nullptr))) {
+        throw runtime_error("failed to init record file handler");
+      }
+      handlers.push_back(std::move(handler));
+    }
+
+    // 每条记录插入后再更新一次
+    char record[RECORD_SIZE] = {0};
+    for (int i = 0; i < RECORD_NUM; i++) {
+      RID rid;
+      memcpy(record, &i, sizeof(i));
+      RecordFileHandler &handler = *handlers[i % FILE_NUM];
+      if (OB_FAIL(handler.insert_record(record, RECORD_SIZE, &rid)) ||
+          OB_FAIL(handler.visit_record(rid, [](Record &record) {
+            record.data()[sizeof(int)] = 1;
+            return true;
+          }))) {
+        throw runtime_error("failed to write record");
+      }
+    }
+
+    for (int i = 0; i < FILE_NUM; i++) {
+      handlers[i]->close();
+      bpm.close_file(data_file(i).c_str());
+      filesystem::resize_file(origin_file(i), filesystem::file_size(data_file(i)));
+    }
+    log_handler.stop();
+    log_handler.await_termination();
+  }
+
+protected:
+  const char *directory_ = "log_replay_performance_test";
+
+  static bool generated_;
+};
+
+bool LogReplayBenchmark::generated_ = false;
+
+BENCHMARK_DEFINE_F(LogReplayBenchmark, Replay)(State &state)
+{
+  for (auto _ : state) {
+    replay(state);
+  }
+
+  state.SetItemsProcessed(state.iterations() * RECORD_NUM);
+}
+
+BENCHMARK_REGISTER_F(LogReplayBenchmark, Replay)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
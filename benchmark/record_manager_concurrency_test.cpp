@@ -43,6 +43,9 @@ struct Stat
   int64_t scan_open_failed_count = 0;
   int64_t mismatch_count         = 0;
   int64_t scan_other_count       = 0;
+
+  int64_t lookup_success_count = 0;
+  int64_t lookup_other_count   = 0;
 };
 
 struct TestRecord
@@ -228,6 +231,20 @@ public:
     }
   }
 
+  void Lookup(const RID &rid, Stat &stat)
+  {
+    Record record;
+    RC     rc = handler_->get_record(rid, record);
+    switch (rc) {
+      case RC::SUCCESS: {
+        stat.lookup_success_count++;
+      } break;
+      default: {
+        stat.lookup_other_count++;
+      } break;
+    }
+  }
+
 protected:
   BufferPoolManager  bpm_{512};
   DiskBufferPool    *buffer_pool_ = nullptr;
@@ -355,6 +372,62 @@ BENCHMARK_REGISTER_F(ScanBenchmark, Scan)->Threads(10)->Arg(4 * 10000);
 
 ////////////////////////////////////////////////////////////////////////////////
 
+/**
+ * @brief 按照RID读取记录，主要看线程数增加时吞吐量能不能跟着增加
+ */
+class LookupBenchmark : public BenchmarkBase
+{
+public:
+  string Name() const override { return "lookup"; }
+
+  void SetUp(const State &state) override
+  {
+    if (0 != state.thread_index()) {
+      while (!setup_done_) {
+        this_thread::sleep_for(chrono::milliseconds(100));
+      }
+      return;
+    }
+
+    BenchmarkBase::SetUp(state);
+
+    uint32_t max = GetRangeMax(state);
+    ASSERT(max > 0, "invalid argument count. %ld", state.range(0));
+    FillUp(0, max, rids_);
+    setup_done_ = true;
+  }
+
+  void TearDown(const State &state) override
+  {
+    BenchmarkBase::TearDown(state);
+    if (0 == state.thread_index()) {
+      rids_.clear();
+      setup_done_ = false;
+    }
+  }
+
+protected:
+  volatile bool setup_done_ = false;
+  vector<RID>   rids_;
+};
+
+BENCHMARK_DEFINE_F(LookupBenchmark, Lookup)(State &state)
+{
+  IntegerGenerator generator(0, static_cast<int>(rids_.size() - 1));
+  Stat             stat;
+
+  for (auto _ : state) {
+    Lookup(rids_[generator.next()], stat);
+  }
+
+  state.counters["success"] = Counter(stat.lookup_success_count, Counter::kIsRate);
+  state.counters["other"]   = Counter(stat.lookup_other_count, Counter::kIsRate);
+}
+
+BENCHMARK_REGISTER_F(LookupBenchmark, Lookup)->ThreadRange(1, 32)->Arg(4 * 10000)->UseRealTime();
+
+////////////////////////////////////////////////////////////////////////////////
+
 struct MixtureBenchmark : public BenchmarkBase
 {
   string Name() const override { return "mixture"; }
@@ -14,4 +14,5 @@ See the Mulan PSL v2 for more details. */
 
 using std::advance;
 using std::distance;
+using std::make_move_iterator;
 using std::random_access_iterator_tag;
\ No newline at end of file
@@ -0,0 +1,60 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/18.
+//
+
+#pragma once
+
+#include "common/queue/queue.h"
+#include "common/lang/chrono.h"
+#include "common/lang/mutex.h"
+#include "common/lang/queue.h"
+
+namespace common {
+
+/**
+ * @brief 取任务时可以等待的任务队列
+ * @details SimpleQueue 在队列为空时立即返回，线程池的线程没有任务时会一直空转。
+ * 这个队列在为空时最多等待 wait_timeout，适合任务比较稀疏的后台线程池。
+ * @tparam T 任务数据类型。
+ * @ingroup Queue
+ */
+template <typename T>
+class BlockingQueue : public Queue<T>
+{
+public:
+  using value_type = T;
+
+public:
+  explicit BlockingQueue(chrono::milliseconds wait_timeout = chrono::milliseconds(100))
+      : Queue<T>(), wait_timeout_(wait_timeout)
+  {}
+  virtual ~BlockingQueue() {}
+
+  //! @copydoc Queue::emplace
+  int push(value_type &&value) override;
+  //! @copydoc Queue::pop
+  //! @details 队列为空时最多等待 wait_timeout
+  int pop(value_type &value) override;
+  //! @copydoc Queue::size
+  int size() const override;
+
+private:
+  mutable mutex        mutex_;
+  condition_variable   cond_;
+  queue<value_type>    queue_;
+  chrono::milliseconds wait_timeout_;
+};
+
+}  // namespace common
+
+#include "common/queue/blocking_queue.ipp"
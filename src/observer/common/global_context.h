@@ -16,8 +16,14 @@ See the Mulan PSL v2 for more details. */
 
 class BufferPoolManager;
 class DefaultHandler;
+class PlanCache;
+class QueryCache;
 class TrxKit;
 
+namespace common {
+class ThreadPoolExecutor;
+}
+
 /**
  * @brief 放一些全局对象
  * @details 为了更好的管理全局对象，这里将其封装到一个类中。初始化的过程可以参考 init_global_objects
@@ -25,7 +31,11 @@ class TrxKit;
 struct GlobalContext
 {
   // BufferPoolManager *buffer_pool_manager_ = nullptr;
-  DefaultHandler *handler_ = nullptr;
+  DefaultHandler *handler_    = nullptr;
+  PlanCache      *plan_cache_  = nullptr;  ///< 执行计划缓存，所有连接共享
+  QueryCache     *query_cache_ = nullptr;  ///< 查询结果缓存，所有连接共享
+
+  common::ThreadPoolExecutor *parallel_executor_ = nullptr;  ///< 执行并行查询的线程池，所有连接共享
   // TrxKit            *trx_kit_             = nullptr;
 
   static GlobalContext &instance();
@@ -15,6 +15,7 @@ See the Mulan PSL v2 for more details. */
 #include "common/init.h"
 
 #include "common/conf/ini.h"
+#include "common/lang/algorithm.h"
 #include "common/lang/string.h"
 #include "common/lang/iostream.h"
 #include "common/log/log.h"
@@ -22,11 +23,16 @@ See the Mulan PSL v2 for more details. */
 #include "common/os/pidfile.h"
 #include "common/os/process.h"
 #include "common/os/signal.h"
+#include "common/queue/blocking_queue.h"
+#include "common/thread/thread_pool_executor.h"
 #include "global_context.h"
 #include "session/session.h"
 #include "session/session_stage.h"
+#include "sql/plan_cache/plan_cache.h"
 #include "sql/plan_cache/plan_cache_stage.h"
+#include "sql/query_cache/query_cache.h"
 #include "storage/buffer/disk_buffer_pool.h"
+#include "storage/db/checkpointer.h"
 #include "storage/default/default_handler.h"
 #include "storage/trx/trx.h"
 
@@ -137,17 +143,65 @@ int init_global_objects(ProcessParam *process_param, Ini &properties)
 
   int ret = 0;
 
-  RC rc =
-      GCTX.handler_->init("miniob", process_param->trx_kit_name().c_str(), process_param->durability_mode().c_str());
+  // 缓冲池的页帧淘汰策略，比如 lru、2q
+  const string eviction_policy = properties.get("EVICTION_POLICY", "", "BUFFER_POOL");
+  // 后台刷脏页希望保持的干净页帧比例，0 表示不启动
+  int clean_percent = PageCleaner::DEFAULT_CLEAN_PERCENT;
+  str_to_val(properties.get("CLEAN_FRAME_PERCENT", std::to_string(clean_percent), "BUFFER_POOL"), clean_percent);
+  // 后台做检查点的间隔，0 表示不启动
+  int checkpoint_interval_ms = Checkpointer::DEFAULT_INTERVAL_MS;
+  str_to_val(properties.get("CHECKPOINT_INTERVAL_MS", std::to_string(checkpoint_interval_ms), "CLOG"),
+      checkpoint_interval_ms);
+  // 恢复时并行回放日志的线程数，不大于1时单线程回放
+  int redo_thread_num = 1;
+  str_to_val(properties.get("REDO_THREAD_NUM", std::to_string(redo_thread_num), "CLOG"), redo_thread_num);
+
+  RC rc = GCTX.handler_->init("miniob",
+      process_param->trx_kit_name().c_str(),
+      process_param->durability_mode().c_str(),
+      eviction_policy.empty() ? nullptr : eviction_policy.c_str(),
+      clean_percent,
+      checkpoint_interval_ms,
+      redo_thread_num);
   if (OB_FAIL(rc)) {
     LOG_ERROR("failed to init handler. rc=%s", strrc(rc));
     return -1;
   }
+
+  GCTX.plan_cache_  = new PlanCache();
+  GCTX.query_cache_ = new QueryCache();
+
+  // 并行查询的任务都是计算密集的，线程个数不超过CPU核数，空闲一段时间后退出
+  GCTX.parallel_executor_ = new ThreadPoolExecutor();
+  ret                     = GCTX.parallel_executor_->init("ParallelQuery",
+      0,                                                         // core size
+      max(1, static_cast<int>(thread::hardware_concurrency())),  // max size
+      60 * 1000,                                                 // keep alive time
+      make_unique<BlockingQueue<unique_ptr<Runnable>>>());
+  if (0 != ret) {
+    LOG_ERROR("failed to init parallel query thread pool. ret=%d", ret);
+    delete GCTX.parallel_executor_;
+    GCTX.parallel_executor_ = nullptr;
+    return ret;
+  }
   return ret;
 }
 
 int uninit_global_objects()
 {
+  if (GCTX.parallel_executor_ != nullptr) {
+    GCTX.parallel_executor_->shutdown();
+    GCTX.parallel_executor_->await_termination();
+    delete GCTX.parallel_executor_;
+    GCTX.parallel_executor_ = nullptr;
+  }
+
+  // 缓存的执行计划和查询结果引用了表对象，要在数据库关闭之前释放
+  delete GCTX.plan_cache_;
+  GCTX.plan_cache_ = nullptr;
+  delete GCTX.query_cache_;
+  GCTX.query_cache_ = nullptr;
+
   delete GCTX.handler_;
   GCTX.handler_ = nullptr;
 
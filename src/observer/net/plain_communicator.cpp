@@ -325,38 +325,19 @@ RC PlainCommunicator::write_chunk_result(SqlResult *sql_result)
   Chunk chunk;
   while (RC::SUCCESS == (rc = sql_result->next_chunk(chunk))) {
     int col_num = chunk.column_num();
-    for (int row_idx = 0; row_idx < chunk.rows(); row_idx++) {
+    // 与 write_tuple_result 一样先存入流中，表头写出之后再一起写出
+    for (int i = 0; i < chunk.selected_rows(); i++) {
+      const int row_idx = chunk.row_index(i);
       for (int col_idx = 0; col_idx < col_num; col_idx++) {
         if (col_idx != 0) {
           const char *delim = " | ";
-
-          rc = writer_->writen(delim, strlen(delim));
-          if (OB_FAIL(rc)) {
-            LOG_WARN("failed to send data to client. err=%s", strerror(errno));
-            sql_result->close();
-            return rc;
-          }
+          sql_result_stream << delim;
         }
 
         Value value = chunk.get_value(col_idx, row_idx);
-
-        string cell_str = value.to_string();
-
-        rc = writer_->writen(cell_str.data(), cell_str.size());
-        if (OB_FAIL(rc)) {
-          LOG_WARN("failed to send data to client. err=%s", strerror(errno));
-          sql_result->close();
-          return rc;
-        }
-      }
-      char newline = '\n';
-
-      rc = writer_->writen(&newline, 1);
-      if (OB_FAIL(rc)) {
-        LOG_WARN("failed to send data to client. err=%s", strerror(errno));
-        sql_result->close();
-        return rc;
+        sql_result_stream << value.to_string();
       }
+      sql_result_stream << '\n';
     }
     chunk.reset();
   }
@@ -17,6 +17,7 @@ See the Mulan PSL v2 for more details. */
 #include "event/session_event.h"
 #include "event/sql_event.h"
 #include "session/session.h"
+#include "storage/db/db.h"
 
 RC SqlTaskHandler::handle_event(Communicator *communicator)
 {
@@ -44,6 +45,17 @@ RC SqlTaskHandler::handle_event(Communicator *communicator)
 
   rc = communicator->write_result(event, need_disconnect);
   LOG_INFO("write result return %s", strrc(rc));
+
+#ifndef CONCURRENCY
+  // 没有后台检查点线程，在两个请求之间回写提交事务号、推进检查点，见 Checkpointer
+  Db *db = event->session()->get_current_db();
+  if (db != nullptr) {
+    RC checkpoint_rc = db->checkpointer().checkpoint_if_need();
+    if (OB_FAIL(checkpoint_rc)) {
+      LOG_WARN("failed to do checkpoint. db=%s, rc=%s", db->name(), strrc(checkpoint_rc));
+    }
+  }
+#endif
   event->session()->set_current_request(nullptr);
   Session::set_current_session(nullptr);
 
@@ -63,29 +75,65 @@ RC SqlTaskHandler::handle_sql(SQLStageEvent *sql_event)
     return rc;
   }
 
-  rc = parse_stage_.handle_request(sql_event);
-  if (OB_FAIL(rc)) {
-    LOG_TRACE("failed to do parse. rc=%s", strrc(rc));
-    return rc;
+  // 没有命中查询缓存
+  if (sql_event->physical_operator() == nullptr) {
+    rc = handle_plan(sql_event);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+
+    rc = query_cache_stage_.handle_plan(sql_event);
+    if (OB_FAIL(rc)) {
+      LOG_TRACE("failed to do query cache. rc=%s", strrc(rc));
+      return rc;
+    }
   }
 
-  rc = resolve_stage_.handle_request(sql_event);
+  rc = execute_stage_.handle_request(sql_event);
   if (OB_FAIL(rc)) {
-    LOG_TRACE("failed to do resolve. rc=%s", strrc(rc));
+    LOG_TRACE("failed to do execute. rc=%s", strrc(rc));
     return rc;
   }
 
-  rc = optimize_stage_.handle_request(sql_event);
-  if (rc != RC::UNIMPLEMENTED && rc != RC::SUCCESS) {
-    LOG_TRACE("failed to do optimize. rc=%s", strrc(rc));
-    return rc;
-  }
+  return rc;
+}
 
-  rc = execute_stage_.handle_request(sql_event);
+RC SqlTaskHandler::handle_plan(SQLStageEvent *sql_event)
+{
+  RC rc = plan_cache_stage_.handle_request(sql_event);
   if (OB_FAIL(rc)) {
-    LOG_TRACE("failed to do execute. rc=%s", strrc(rc));
+    LOG_TRACE("failed to do plan cache. rc=%s", strrc(rc));
     return rc;
   }
 
-  return rc;
+  // 没有命中执行计划缓存
+  if (sql_event->physical_operator() == nullptr) {
+    rc = parse_stage_.handle_request(sql_event);
+    if (OB_FAIL(rc)) {
+      LOG_TRACE("failed to do parse. rc=%s", strrc(rc));
+      return rc;
+    }
+
+    rc = resolve_stage_.handle_request(sql_event);
+    if (OB_FAIL(rc)) {
+      LOG_TRACE("failed to do resolve. rc=%s", strrc(rc));
+      return rc;
+    }
+
+    rc = optimize_stage_.handle_request(sql_event);
+    if (rc != RC::UNIMPLEMENTED && rc != RC::SUCCESS) {
+      LOG_TRACE("failed to do optimize. rc=%s", strrc(rc));
+      return rc;
+    }
+
+    if (OB_SUCC(rc)) {
+      rc = plan_cache_stage_.handle_plan(sql_event);
+      if (OB_FAIL(rc)) {
+        LOG_TRACE("failed to do plan cache. rc=%s", strrc(rc));
+        return rc;
+      }
+    }
+  }
+
+  return RC::SUCCESS;
 }
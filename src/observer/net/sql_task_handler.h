@@ -20,6 +20,7 @@ See the Mulan PSL v2 for more details. */
 #include "sql/optimizer/optimize_stage.h"
 #include "sql/parser/parse_stage.h"
 #include "sql/parser/resolve_stage.h"
+#include "sql/plan_cache/plan_cache_stage.h"
 #include "sql/query_cache/query_cache_stage.h"
 
 class Communicator;
@@ -45,9 +46,18 @@ public:
 
   RC handle_sql(SQLStageEvent *sql_event);
 
+private:
+  /**
+   * @brief 生成执行计划
+   * @details 先查找执行计划缓存，没有命中时再依次解析、语义解析和优化。
+   * 不需要执行计划的语句(比如DDL)，完成后 sql_event 中只有 stmt
+   */
+  RC handle_plan(SQLStageEvent *sql_event);
+
 private:
   SessionStage    session_stage_;      /// 会话阶段
   QueryCacheStage query_cache_stage_;  /// 查询缓存阶段
+  PlanCacheStage  plan_cache_stage_;   /// 执行计划缓存阶段。命中时跳过解析和优化
   ParseStage      parse_stage_;        /// 解析阶段。将SQL解析成语法树 ParsedSqlNode
   ResolveStage    resolve_stage_;      /// 解析阶段。将语法树解析成Stmt(statement)
   OptimizeStage   optimize_stage_;     /// 优化阶段。将语句优化成执行计划，包含规则优化和物理优化
@@ -28,6 +28,8 @@ class SessionEvent;
 class Session
 {
 public:
+  static constexpr int MAX_PARALLEL_DEGREE = 64;  ///< parallel_degree 的上限
+
   /**
    * @brief 获取默认的会话数据，新生成的会话都基于默认会话设置参数
    * @note 当前并没有会话参数
@@ -83,6 +85,15 @@ public:
   void          set_execution_mode(const ExecutionMode mode) { execution_mode_ = mode; }
   ExecutionMode get_execution_mode() const { return execution_mode_; }
 
+  void    set_sort_buffer_size(int64_t size) { sort_buffer_size_ = size; }
+  int64_t sort_buffer_size() const { return sort_buffer_size_; }
+
+  void set_query_cache(bool query_cache) { query_cache_ = query_cache; }
+  bool query_cache_on() const { return query_cache_; }
+
+  void set_parallel_degree(int parallel_degree) { parallel_degree_ = parallel_degree; }
+  int  parallel_degree() const { return parallel_degree_; }
+
   bool used_chunk_mode() { return used_chunk_mode_; }
 
   void set_used_chunk_mode(bool used_chunk_mode) { used_chunk_mode_ = used_chunk_mode; }
@@ -113,4 +124,10 @@ private:
   bool used_chunk_mode_ = false;
 
   ExecutionMode execution_mode_ = ExecutionMode::TUPLE_ITERATOR;
+
+  int64_t sort_buffer_size_ = 64 * 1024 * 1024;  ///< 排序时可以使用的内存大小，超过后会写临时文件
+
+  bool query_cache_ = false;  ///< 是否使用查询缓存，需要显式打开
+
+  int parallel_degree_ = 1;  ///< 查询的并行度，大于1时扫描和聚合使用多个线程执行
 };
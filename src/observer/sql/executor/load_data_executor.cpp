@@ -13,6 +13,7 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include "sql/executor/load_data_executor.h"
+#include "common/lang/defer.h"
 #include "common/lang/string.h"
 #include "event/session_event.h"
 #include "event/sql_event.h"
@@ -89,6 +90,9 @@ void LoadDataExecutor::load_data(BaseTable *table, const char *file_name, SqlRes
     return;
   }
 
+  // 导入完成后递增版本号，让查询缓存中读过这张表的结果失效
+  DEFER(table->increase_data_version());
+
   struct timespec begin_time;
   clock_gettime(CLOCK_MONOTONIC, &begin_time);
   const int sys_field_num = table->table_meta().sys_field_num();
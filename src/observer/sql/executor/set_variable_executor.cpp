@@ -9,6 +9,8 @@ MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
 #include "sql/executor/set_variable_executor.h"
+#include "common/global_context.h"
+#include "sql/query_cache/query_cache.h"
 
 RC SetVariableExecutor::execute(SQLStageEvent *sql_event)
 {
@@ -34,6 +36,36 @@ RC SetVariableExecutor::execute(SQLStageEvent *sql_event)
     } else {
       rc = RC::INVALID_ARGUMENT;
     }
+  } else if (strcasecmp(var_name, "sort_buffer_size") == 0) {
+    if (var_value.attr_type() == AttrType::INTS && var_value.get_int() > 0) {
+      session->set_sort_buffer_size(var_value.get_int());
+      LOG_TRACE("set sort_buffer_size to %d", var_value.get_int());
+    } else {
+      rc = RC::VARIABLE_NOT_VALID;
+    }
+  } else if (strcasecmp(var_name, "query_cache") == 0) {
+    bool bool_value = false;
+    rc              = var_value_to_boolean(var_value, bool_value);
+    if (rc == RC::SUCCESS) {
+      session->set_query_cache(bool_value);
+      LOG_TRACE("set query_cache to %d", bool_value);
+    }
+  } else if (strcasecmp(var_name, "parallel_degree") == 0) {
+    if (var_value.attr_type() == AttrType::INTS && var_value.get_int() > 0 &&
+        var_value.get_int() <= Session::MAX_PARALLEL_DEGREE) {
+      session->set_parallel_degree(var_value.get_int());
+      LOG_TRACE("set parallel_degree to %d", var_value.get_int());
+    } else {
+      rc = RC::VARIABLE_NOT_VALID;
+    }
+  } else if (strcasecmp(var_name, "query_cache_size") == 0) {
+    // 查询缓存是全局的，修改后对所有会话生效
+    if (var_value.attr_type() == AttrType::INTS && var_value.get_int() >= 0 && GCTX.query_cache_ != nullptr) {
+      GCTX.query_cache_->set_memory_limit(var_value.get_int());
+      LOG_TRACE("set query_cache_size to %d", var_value.get_int());
+    } else {
+      rc = RC::VARIABLE_NOT_VALID;
+    }
   } else {
     rc = RC::VARIABLE_NOT_EXISTS;
   }
@@ -95,4 +127,4 @@ RC SetVariableExecutor::get_execution_mode(const Value &var_value, ExecutionMode
   }
 
   return rc;
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#include "sql/executor/show_status_executor.h"
+
+#include "common/global_context.h"
+#include "common/lang/string.h"
+#include "event/session_event.h"
+#include "event/sql_event.h"
+#include "session/session.h"
+#include "sql/executor/sql_result.h"
+#include "sql/operator/string_list_physical_operator.h"
+#include "sql/plan_cache/plan_cache.h"
+#include "sql/query_cache/query_cache.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/db/db.h"
+
+using namespace std;
+
+static string hit_ratio(uint64_t hit_count, uint64_t miss_count)
+{
+  const uint64_t total = hit_count + miss_count;
+  if (total == 0) {
+    return "0.0000";
+  }
+
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%.4f", static_cast<double>(hit_count) / total);
+  return buf;
+}
+
+RC ShowStatusExecutor::execute(SQLStageEvent *sql_event)
+{
+  SessionEvent *session_event = sql_event->session_event();
+  SqlResult    *sql_result    = session_event->sql_result();
+  Db           *db            = session_event->session()->get_current_db();
+
+  TupleSchema tuple_schema;
+  tuple_schema.append_cell(TupleCellSpec("", "Variable_name", "Variable_name"));
+  tuple_schema.append_cell(TupleCellSpec("", "Value", "Value"));
+  sql_result->set_tuple_schema(tuple_schema);
+
+  auto oper = new StringListPhysicalOperator;
+  if (db != nullptr) {
+    BufferPoolManager &buffer_pool_manager = db->buffer_pool_manager();
+    BPFrameManager    &frame_manager       = buffer_pool_manager.get_frame_manager();
+    oper->append({"buffer_pool_eviction_policy", frame_manager.eviction_policy()});
+    oper->append({"buffer_pool_frame_num", to_string(frame_manager.frame_num())});
+    oper->append({"buffer_pool_hit_count", to_string(frame_manager.hit_count())});
+    oper->append({"buffer_pool_miss_count", to_string(frame_manager.miss_count())});
+    oper->append({"buffer_pool_evict_count", to_string(frame_manager.evict_count())});
+    oper->append({"buffer_pool_hit_ratio", hit_ratio(frame_manager.hit_count(), frame_manager.miss_count())});
+    oper->append({"buffer_pool_read_ahead_count", to_string(buffer_pool_manager.read_ahead_count())});
+
+    PageCleaner &page_cleaner = buffer_pool_manager.page_cleaner();
+    oper->append({"buffer_pool_sync_flush_count", to_string(page_cleaner.sync_flush_count())});
+    oper->append({"page_cleaner_flushed_pages", to_string(page_cleaner.flushed_page_count())});
+    oper->append({"page_cleaner_flush_writes", to_string(page_cleaner.flush_write_count())});
+    oper->append({"page_cleaner_flush_rate", to_string(page_cleaner.flush_rate())});
+  }
+
+  if (GCTX.plan_cache_ != nullptr) {
+    oper->append({"plan_cache_hit_count", to_string(GCTX.plan_cache_->hit_count())});
+    oper->append({"plan_cache_miss_count", to_string(GCTX.plan_cache_->miss_count())});
+  }
+
+  if (GCTX.query_cache_ != nullptr) {
+    oper->append({"query_cache_hit_count", to_string(GCTX.query_cache_->hit_count())});
+    oper->append({"query_cache_miss_count", to_string(GCTX.query_cache_->miss_count())});
+  }
+
+  sql_result->set_operator(unique_ptr<PhysicalOperator>(oper));
+  return RC::SUCCESS;
+}
@@ -0,0 +1,33 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#pragma once
+
+#include "common/rc.h"
+
+class SQLStageEvent;
+
+/**
+ * @brief 显示运行状态的执行器
+ * @ingroup Executor
+ * @details 输出当前数据库缓冲池的淘汰策略和命中率，以及执行计划缓存和查询结果缓存的命中次数
+ */
+class ShowStatusExecutor
+{
+public:
+  ShowStatusExecutor()          = default;
+  virtual ~ShowStatusExecutor() = default;
+
+  RC execute(SQLStageEvent *sql_event);
+};
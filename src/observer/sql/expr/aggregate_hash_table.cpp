@@ -9,13 +9,143 @@ MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
 #include "sql/expr/aggregate_hash_table.h"
+#include "common/lang/algorithm.h"
+#include "common/lang/comparator.h"
+
+namespace {
+
+/// 常量列只有一个值，每一行都使用这个值
+inline int value_index(const Column &column, int row)
+{
+  return column.column_type() == Column::Type::CONSTANT_COLUMN ? 0 : row;
+}
+
+/// 把 len 个字节写入到列中，不足列的长度时补0，比如字符串的值
+RC append_bytes(Column &column, const char *data, int len)
+{
+  if (column.var_len()) {
+    return column.append_string(data, strnlen(data, len));
+  }
+  if (len >= column.attr_len()) {
+    return column.append_one(const_cast<char *>(data));
+  }
+
+  vector<char> buffer(column.attr_len(), 0);
+  memcpy(buffer.data(), data, len);
+  return column.append_one(buffer.data());
+}
+
+RC append_value(Column &column, const Value &value)
+{
+  if (value.is_null()) {
+    return column.append_null();
+  }
+  if (column.var_len()) {
+    return column.append_string(value.data(), value.length());
+  }
+
+  int len = value.length();
+  switch (value.attr_type()) {
+    case AttrType::INTS:
+    case AttrType::FLOATS:
+    case AttrType::DATES:
+    case AttrType::BOOLEANS: len = sizeof(int); break;
+    default: break;
+  }
+  return append_bytes(column, value.data(), min(len, column.attr_len()));
+}
+
+}  // namespace
+
+void AggregateHashTable::aggregate_result_type(
+    AggregateFunctionType aggr_type, AttrType value_type, int value_len, AttrType &result_type, int &result_len)
+{
+  switch (aggr_type) {
+    case AggregateFunctionType::COUNT: {
+      result_type = AttrType::INTS;
+      result_len  = sizeof(int);
+    } break;
+    case AggregateFunctionType::SUM: {
+      result_type = value_type;
+      result_len  = sizeof(int);  // INTS 或者 FLOATS
+    } break;
+    case AggregateFunctionType::AVG: {
+      result_type = AttrType::FLOATS;
+      result_len  = sizeof(float);
+    } break;
+    default: {
+      result_type = value_type;
+      result_len  = value_len;
+    } break;
+  }
+}
 
 // ----------------------------------StandardAggregateHashTable------------------
 
 RC StandardAggregateHashTable::add_chunk(Chunk &groups_chunk, Chunk &aggrs_chunk)
 {
-  // your code here
-  exit(-1);
+  if (aggrs_chunk.column_num() != static_cast<int>(aggr_types_.size())) {
+    LOG_WARN("aggregate column number mismatch. expect=%d, actual=%d", aggr_types_.size(), aggrs_chunk.column_num());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  const int rows = groups_chunk.rows();
+  for (int row = 0; row < rows; row++) {
+    vector<Value> group_values(groups_chunk.column_num());
+    for (int i = 0; i < groups_chunk.column_num(); i++) {
+      const Column &column = groups_chunk.column(i);
+      group_values[i]      = column.get_value(value_index(column, row));
+    }
+
+    auto iter = aggr_values_.find(group_values);
+    if (iter == aggr_values_.end()) {
+      vector<Value> aggr_values(value_num_);
+      for (size_t i = 0; i < aggr_types_.size(); i++) {
+        const Column &column = aggrs_chunk.column(i);
+        if (aggr_types_[i] == AggregateFunctionType::COUNT) {
+          aggr_values[i] = Value(1);
+        } else {
+          aggr_values[i] = column.get_value(value_index(column, row));
+        }
+        if (avg_count_pos_[i] != -1) {
+          aggr_values[avg_count_pos_[i]] = Value(1);
+        }
+      }
+      aggr_values_.emplace(std::move(group_values), std::move(aggr_values));
+      continue;
+    }
+
+    vector<Value> &aggr_values = iter->second;
+    for (size_t i = 0; i < aggr_types_.size(); i++) {
+      const Column &column = aggrs_chunk.column(i);
+      Value         value  = column.get_value(value_index(column, row));
+      Value        &result = aggr_values[i];
+      switch (aggr_types_[i]) {
+        case AggregateFunctionType::COUNT: {
+          result = Value(result.get_int() + 1);
+        } break;
+        case AggregateFunctionType::SUM: {
+          Value::add(value, result, result);
+        } break;
+        case AggregateFunctionType::AVG: {
+          Value::add(value, result, result);
+          Value &count = aggr_values[avg_count_pos_[i]];
+          count        = Value(count.get_int() + 1);
+        } break;
+        case AggregateFunctionType::MAX: {
+          if (value.compare(result) > 0) {
+            result = value;
+          }
+        } break;
+        case AggregateFunctionType::MIN: {
+          if (value.compare(result) < 0) {
+            result = value;
+          }
+        } break;
+      }
+    }
+  }
+  return RC::SUCCESS;
 }
 
 void StandardAggregateHashTable::Scanner::open_scan()
@@ -29,22 +159,26 @@ RC StandardAggregateHashTable::Scanner::next(Chunk &output_chunk)
   if (it_ == end_) {
     return RC::RECORD_EOF;
   }
-  while (it_ != end_ && output_chunk.rows() <= output_chunk.capacity()) {
+  auto *hash_table = static_cast<StandardAggregateHashTable *>(hash_table_);
+  while (it_ != end_ && output_chunk.rows() < output_chunk.capacity()) {
     auto &group_by_values = it_->first;
     auto &aggrs           = it_->second;
     for (int i = 0; i < output_chunk.column_num(); i++) {
       auto col_idx = output_chunk.column_ids(i);
       if (col_idx >= static_cast<int>(group_by_values.size())) {
-        output_chunk.column(i).append_one((char *)aggrs[col_idx - group_by_values.size()].data());
+        const int aggr_idx = col_idx - static_cast<int>(group_by_values.size());
+        if (hash_table->aggr_types_[aggr_idx] == AggregateFunctionType::AVG) {
+          const int count = aggrs[hash_table->avg_count_pos_[aggr_idx]].get_int();
+          append_value(output_chunk.column(i), Value(aggrs[aggr_idx].get_float() / static_cast<float>(count)));
+        } else {
+          append_value(output_chunk.column(i), aggrs[aggr_idx]);
+        }
       } else {
-        output_chunk.column(i).append_one((char *)group_by_values[col_idx].data());
+        append_value(output_chunk.column(i), group_by_values[col_idx]);
       }
     }
     it_++;
   }
-  if (it_ == end_) {
-    return RC::SUCCESS;
-  }
 
   return RC::SUCCESS;
 }
@@ -71,6 +205,508 @@ bool StandardAggregateHashTable::VectorEqual::operator()(const vector<Value> &lh
   return true;
 }
 
+// ----------------------------------OpenAddressingAggregateHashTable------------------
+
+namespace {
+
+/// 聚合状态按照4字节对齐
+inline int align4(int size) { return (size + 3) & ~3; }
+
+template <typename T>
+inline T load(const char *data)
+{
+  T value;
+  memcpy(&value, data, sizeof(T));
+  return value;
+}
+
+template <typename T>
+inline void store(char *data, T value)
+{
+  memcpy(data, &value, sizeof(T));
+}
+
+}  // namespace
+
+OpenAddressingAggregateHashTable::OpenAddressingAggregateHashTable(
+    const vector<Expression *> aggregations, int capacity /* = DEFAULT_CAPACITY */)
+{
+  for (auto &expr : aggregations) {
+    ASSERT(expr->type() == ExprType::AGGREGATION, "expect aggregate expression");
+    auto *aggregation_expr = static_cast<AggregateExpr *>(expr);
+    aggr_types_.push_back(aggregation_expr->aggregate_type());
+  }
+
+  // 槽数总是2的幂，用掩码代替取模
+  size_t slot_num = 16;
+  while (slot_num < static_cast<size_t>(capacity)) {
+    slot_num <<= 1;
+  }
+  slots_.resize(slot_num);
+  slot_mask_ = slot_num - 1;
+}
+
+RC OpenAddressingAggregateHashTable::init_layout(Chunk &groups_chunk, Chunk &aggrs_chunk)
+{
+  if (aggrs_chunk.column_num() != static_cast<int>(aggr_types_.size())) {
+    LOG_WARN("aggregate column number mismatch. expect=%d, actual=%d", aggr_types_.size(), aggrs_chunk.column_num());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  key_size_ = 0;
+  for (int i = 0; i < groups_chunk.column_num(); i++) {
+    const Column &column = groups_chunk.column(i);
+    const int     len    = column.var_len() ? sizeof(uint32_t) : column.attr_len();
+    key_columns_.push_back(KeyColumn{column.attr_type(), len, key_size_, column.nullable(), column.var_len()});
+    key_size_ += len + (column.nullable() ? 1 : 0);
+  }
+  dictionaries_.resize(key_columns_.size());
+
+  row_size_ = align4(key_size_);
+  for (int i = 0; i < aggrs_chunk.column_num(); i++) {
+    const Column &column    = aggrs_chunk.column(i);
+    const auto    aggr_type = aggr_types_[i];
+    if ((aggr_type == AggregateFunctionType::SUM || aggr_type == AggregateFunctionType::AVG) &&
+        column.attr_type() != AttrType::INTS && column.attr_type() != AttrType::FLOATS) {
+      LOG_WARN("unsupported value type of aggregation. type=%s", attr_type_to_string(column.attr_type()));
+      return RC::UNSUPPORTED;
+    }
+
+    AggrColumn aggr{aggr_type, column.attr_type(), column.attr_len(), row_size_, -1, column.var_len()};
+    switch (aggr_type) {
+      case AggregateFunctionType::COUNT: row_size_ += sizeof(int); break;
+      case AggregateFunctionType::SUM: row_size_ += sizeof(int); break;
+      case AggregateFunctionType::AVG: row_size_ += sizeof(int) * 2; break;  // 累加值以及计数
+      default: row_size_ += aggr.var_len ? sizeof(uint32_t) : align4(column.attr_len()); break;
+    }
+    // AVG 自己有计数，COUNT 的结果就是计数；其它的需要记录是否出现过非 NULL 值
+    if (column.nullable()) {
+      if (aggr_type == AggregateFunctionType::AVG) {
+        aggr.count_offset = aggr.offset + sizeof(int);
+      } else if (aggr_type != AggregateFunctionType::COUNT) {
+        aggr.count_offset = row_size_;
+        row_size_ += sizeof(int);
+      }
+    }
+    aggr_columns_.push_back(aggr);
+  }
+
+  // 没有聚合列也没有 group by 列时，每个分组至少占用一个字节，保证分组编号可以换算成地址
+  row_size_      = max(row_size_, 1);
+  layout_inited_ = true;
+  return RC::SUCCESS;
+}
+
+RC OpenAddressingAggregateHashTable::add_chunk(Chunk &groups_chunk, Chunk &aggrs_chunk)
+{
+  RC rc = RC::SUCCESS;
+  if (!layout_inited_ && OB_FAIL(rc = init_layout(groups_chunk, aggrs_chunk))) {
+    return rc;
+  }
+
+  if (groups_chunk.column_num() != static_cast<int>(key_columns_.size()) ||
+      aggrs_chunk.column_num() != static_cast<int>(aggr_columns_.size())) {
+    LOG_WARN("column number mismatch. group columns=%d, aggregate columns=%d",
+             groups_chunk.column_num(), aggrs_chunk.column_num());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  const int rows = groups_chunk.rows();
+  if (rows <= 0) {
+    return RC::SUCCESS;
+  }
+
+  build_keys(groups_chunk, rows);
+  find_or_create_groups(aggrs_chunk, rows);
+  for (size_t i = 0; i < aggr_columns_.size(); i++) {
+    update_aggregate(aggr_columns_[i], aggrs_chunk.column(i), rows);
+  }
+  return rc;
+}
+
+void OpenAddressingAggregateHashTable::build_keys(Chunk &groups_chunk, int rows)
+{
+  keys_.resize(static_cast<size_t>(rows) * key_size_);
+  hashes_.resize(rows);
+
+  // 一次处理一列，把每一行的值复制到键中对应的位置
+  for (size_t i = 0; i < key_columns_.size(); i++) {
+    const KeyColumn &key_column = key_columns_[i];
+    const Column    &column     = groups_chunk.column(i);
+    const char      *data       = column.data();
+    char            *key        = keys_.data() + key_column.offset;
+    const bool       constant   = column.column_type() == Column::Type::CONSTANT_COLUMN;
+    if (key_column.var_len) {
+      StringDictionary &dictionary = dictionaries_[i];
+      for (int row = 0; row < rows; row++, key += key_size_) {
+        int         len = 0;
+        const char *str = column.string_at(row, len);
+        store<uint32_t>(key, dictionary.get_or_add(str, len));
+      }
+    } else {
+      for (int row = 0; row < rows; row++, key += key_size_) {
+        memcpy(key, constant ? data : data + static_cast<size_t>(row) * key_column.len, key_column.len);
+      }
+    }
+
+    // NULL 行的值是未定义的，清零后由标记字节区分
+    if (key_column.nullable) {
+      key = keys_.data() + key_column.offset;
+      for (int row = 0; row < rows; row++, key += key_size_) {
+        const bool is_null = column.is_null(row);
+        if (is_null) {
+          memset(key, 0, key_column.len);
+        }
+        key[key_column.len] = is_null ? 1 : 0;
+      }
+    }
+
+    // 键按照字节比较，-0.0 与 0.0 相等，要规范成相同的字节
+    key = keys_.data() + key_column.offset;
+    if (key_column.type == AttrType::FLOATS) {
+      for (int row = 0; row < rows; row++, key += key_size_) {
+        if (load<float>(key) == 0) {
+          store<float>(key, 0);
+        }
+      }
+    }
+  }
+
+  for (int row = 0; row < rows; row++) {
+    hashes_[row] = hash_key(keys_.data() + static_cast<size_t>(row) * key_size_, key_size_);
+  }
+}
+
+void OpenAddressingAggregateHashTable::find_or_create_groups(Chunk &aggrs_chunk, int rows)
+{
+  group_ids_.resize(rows);
+  for (int row = 0; row < rows; row++) {
+    const char    *key  = keys_.data() + static_cast<size_t>(row) * key_size_;
+    const uint64_t hash = hashes_[row];
+    const uint32_t tag  = static_cast<uint32_t>(hash >> 32);
+
+    uint64_t pos = hash & slot_mask_;
+    while (true) {
+      Slot &slot = slots_[pos];
+      if (slot.group == EMPTY_GROUP) {
+        const uint32_t group = create_group(key, hash, aggrs_chunk, row);
+        slot.tag             = tag;
+        slot.group           = group;
+        group_ids_[row]      = group;
+        if (group_hashes_.size() * 2 > slots_.size()) {
+          resize();
+        }
+        break;
+      }
+
+      if (slot.tag == tag && memcmp(group_data(slot.group), key, key_size_) == 0) {
+        group_ids_[row] = slot.group;
+        break;
+      }
+      pos = (pos + 1) & slot_mask_;
+    }
+  }
+}
+
+uint32_t OpenAddressingAggregateHashTable::create_group(const char *key, uint64_t hash, Chunk &aggrs_chunk, int row)
+{
+  const uint32_t group = static_cast<uint32_t>(group_hashes_.size());
+  group_hashes_.push_back(hash);
+  rows_.resize(rows_.size() + row_size_, 0);
+
+  char *data = group_data(group);
+  memcpy(data, key, key_size_);
+
+  // COUNT/SUM/AVG 的初始状态是0，MAX/MIN 用创建分组的这一行的值作为初始值，后面再累加这一行时结果不变
+  for (size_t i = 0; i < aggr_columns_.size(); i++) {
+    const AggrColumn &aggr = aggr_columns_[i];
+    if (aggr.var_len && (aggr.aggr_type == AggregateFunctionType::MAX || aggr.aggr_type == AggregateFunctionType::MIN)) {
+      const Column &column = aggrs_chunk.column(i);
+      int           len    = 0;
+      const char   *str    = column.string_at(row, len);
+      store<uint32_t>(data + aggr.offset, static_cast<uint32_t>(string_states_.size()));
+      string_states_.emplace_back(str, len);
+    } else if (aggr.aggr_type == AggregateFunctionType::MAX || aggr.aggr_type == AggregateFunctionType::MIN) {
+      const Column &column = aggrs_chunk.column(i);
+      memcpy(data + aggr.offset, column.data() + static_cast<size_t>(value_index(column, row)) * aggr.value_len,
+             aggr.value_len);
+    }
+  }
+  return group;
+}
+
+void OpenAddressingAggregateHashTable::update_aggregate(const AggrColumn &aggr, const Column &column, int rows)
+{
+  const bool is_float = aggr.value_type == AttrType::FLOATS;
+  switch (aggr.aggr_type) {
+    case AggregateFunctionType::COUNT: {
+      const bool check_null = column.has_null();
+      for (int row = 0; row < rows; row++) {
+        if (check_null && column.is_null(row)) {
+          continue;
+        }
+        char *state = group_data(group_ids_[row]) + aggr.offset;
+        store<int>(state, load<int>(state) + 1);
+      }
+    } break;
+    case AggregateFunctionType::SUM: {
+      is_float ? update_sum<float>(aggr, column, rows) : update_sum<int>(aggr, column, rows);
+    } break;
+    case AggregateFunctionType::AVG: {
+      is_float ? update_avg<float>(aggr, column, rows) : update_avg<int>(aggr, column, rows);
+    } break;
+    case AggregateFunctionType::MAX: {
+      if (aggr.var_len) {
+        update_extreme_var_len<true>(aggr, column, rows);
+      } else if (is_float) {
+        update_extreme<float, true>(aggr, column, rows);
+      } else if (aggr.value_type == AttrType::INTS || aggr.value_type == AttrType::DATES) {
+        update_extreme<int, true>(aggr, column, rows);
+      } else {
+        update_extreme_string<true>(aggr, column, rows);
+      }
+    } break;
+    case AggregateFunctionType::MIN: {
+      if (aggr.var_len) {
+        update_extreme_var_len<false>(aggr, column, rows);
+      } else if (is_float) {
+        update_extreme<float, false>(aggr, column, rows);
+      } else if (aggr.value_type == AttrType::INTS || aggr.value_type == AttrType::DATES) {
+        update_extreme<int, false>(aggr, column, rows);
+      } else {
+        update_extreme_string<false>(aggr, column, rows);
+      }
+    } break;
+  }
+}
+
+// 列值不一定按照 T 对齐，统一用 load/store 访问。NULL 值跳过，没有 NULL 时只多一次分支判断
+
+template <typename T>
+void OpenAddressingAggregateHashTable::update_sum(const AggrColumn &aggr, const Column &column, int rows)
+{
+  const char *values     = column.data();
+  const int   stride     = column.column_type() == Column::Type::CONSTANT_COLUMN ? 0 : column.attr_len();
+  const bool  check_null = column.has_null();
+  for (int row = 0; row < rows; row++, values += stride) {
+    if (check_null && column.is_null(row)) {
+      continue;
+    }
+    char *group = group_data(group_ids_[row]);
+    char *state = group + aggr.offset;
+    store<T>(state, load<T>(state) + load<T>(values));
+    if (aggr.count_offset >= 0) {
+      store<int>(group + aggr.count_offset, load<int>(group + aggr.count_offset) + 1);
+    }
+  }
+}
+
+template <typename T>
+void OpenAddressingAggregateHashTable::update_avg(const AggrColumn &aggr, const Column &column, int rows)
+{
+  const char *values     = column.data();
+  const int   stride     = column.column_type() == Column::Type::CONSTANT_COLUMN ? 0 : column.attr_len();
+  const bool  check_null = column.has_null();
+  for (int row = 0; row < rows; row++, values += stride) {
+    if (check_null && column.is_null(row)) {
+      continue;
+    }
+    char *state = group_data(group_ids_[row]) + aggr.offset;
+    store<T>(state, load<T>(state) + load<T>(values));
+    store<int>(state + sizeof(T), load<int>(state + sizeof(T)) + 1);
+  }
+}
+
+template <typename T, bool IS_MAX>
+void OpenAddressingAggregateHashTable::update_extreme(const AggrColumn &aggr, const Column &column, int rows)
+{
+  const char *values     = column.data();
+  const int   stride     = column.column_type() == Column::Type::CONSTANT_COLUMN ? 0 : column.attr_len();
+  const bool  check_null = column.has_null();
+  for (int row = 0; row < rows; row++, values += stride) {
+    if (check_null && column.is_null(row)) {
+      continue;
+    }
+    char   *group = group_data(group_ids_[row]);
+    char   *state = group + aggr.offset;
+    const T value = load<T>(values);
+    // 创建分组的那一行可能是 NULL，第一个非 NULL 值直接作为初始值
+    if (aggr.count_offset >= 0 && load<int>(group + aggr.count_offset) == 0) {
+      memcpy(state, values, aggr.value_len);
+    } else if (IS_MAX ? value > load<T>(state) : value < load<T>(state)) {
+      memcpy(state, values, aggr.value_len);
+    }
+    if (aggr.count_offset >= 0) {
+      store<int>(group + aggr.count_offset, load<int>(group + aggr.count_offset) + 1);
+    }
+  }
+}
+
+template <bool IS_MAX>
+void OpenAddressingAggregateHashTable::update_extreme_string(const AggrColumn &aggr, const Column &column, int rows)
+{
+  const bool check_null = column.has_null();
+  for (int row = 0; row < rows; row++) {
+    if (check_null && column.is_null(row)) {
+      continue;
+    }
+    char *group  = group_data(group_ids_[row]);
+    char *state  = group + aggr.offset;
+    char *value  = column.data() + static_cast<size_t>(value_index(column, row)) * aggr.value_len;
+    int   result = common::compare_string(value, aggr.value_len, state, aggr.value_len);
+    if (aggr.count_offset >= 0 && load<int>(group + aggr.count_offset) == 0) {
+      memcpy(state, value, aggr.value_len);
+    } else if (IS_MAX ? result > 0 : result < 0) {
+      memcpy(state, value, aggr.value_len);
+    }
+    if (aggr.count_offset >= 0) {
+      store<int>(group + aggr.count_offset, load<int>(group + aggr.count_offset) + 1);
+    }
+  }
+}
+
+template <bool IS_MAX>
+void OpenAddressingAggregateHashTable::update_extreme_var_len(const AggrColumn &aggr, const Column &column, int rows)
+{
+  const bool check_null = column.has_null();
+  for (int row = 0; row < rows; row++) {
+    if (check_null && column.is_null(row)) {
+      continue;
+    }
+    char        *group = group_data(group_ids_[row]);
+    string      &state = string_states_[load<uint32_t>(group + aggr.offset)];
+    int          len   = 0;
+    const char  *value = column.string_at(row, len);
+    const int    result = common::compare_string((void *)value, len, state.data(), static_cast<int>(state.size()));
+    if (aggr.count_offset >= 0 && load<int>(group + aggr.count_offset) == 0) {
+      state.assign(value, len);
+    } else if (IS_MAX ? result > 0 : result < 0) {
+      state.assign(value, len);
+    }
+    if (aggr.count_offset >= 0) {
+      store<int>(group + aggr.count_offset, load<int>(group + aggr.count_offset) + 1);
+    }
+  }
+}
+
+RC OpenAddressingAggregateHashTable::append_result(const AggrColumn &aggr, const char *group_data, Column &column) const
+{
+  const char *state = group_data + aggr.offset;
+  if (aggr.count_offset >= 0 && load<int>(group_data + aggr.count_offset) == 0) {
+    return column.append_null();
+  }
+  switch (aggr.aggr_type) {
+    case AggregateFunctionType::COUNT:
+    case AggregateFunctionType::SUM: {
+      return append_bytes(column, state, sizeof(int));
+    }
+    case AggregateFunctionType::AVG: {
+      const int   count = load<int>(state + sizeof(int));
+      const float sum   = aggr.value_type == AttrType::FLOATS ? load<float>(state) : load<int>(state);
+      const float avg   = sum / static_cast<float>(count);
+      return append_bytes(column, reinterpret_cast<const char *>(&avg), sizeof(avg));
+    }
+    default: {
+      if (aggr.var_len) {
+        const string &value = string_states_[load<uint32_t>(state)];
+        return column.append_string(value.data(), static_cast<int>(value.size()));
+      }
+      return append_bytes(column, state, aggr.value_len);
+    }
+  }
+}
+
+void OpenAddressingAggregateHashTable::resize()
+{
+  vector<Slot> new_slots(slots_.size() * 2);
+  slot_mask_ = new_slots.size() - 1;
+  for (uint32_t group = 0; group < static_cast<uint32_t>(group_hashes_.size()); group++) {
+    const uint64_t hash = group_hashes_[group];
+    uint64_t       pos  = hash & slot_mask_;
+    while (new_slots[pos].group != EMPTY_GROUP) {
+      pos = (pos + 1) & slot_mask_;
+    }
+    new_slots[pos].tag   = static_cast<uint32_t>(hash >> 32);
+    new_slots[pos].group = group;
+  }
+  slots_ = std::move(new_slots);
+}
+
+uint64_t OpenAddressingAggregateHashTable::hash_key(const char *key, int len)
+{
+  // 每次处理8个字节，混合函数参考 MurmurHash64A
+  const uint64_t m    = 0xc6a4a7935bd1e995ULL;
+  uint64_t       hash = 0x9e3779b97f4a7c15ULL ^ (static_cast<uint64_t>(len) * m);
+  int            i    = 0;
+  for (; i + 8 <= len; i += 8) {
+    uint64_t k = load<uint64_t>(key + i);
+    k *= m;
+    k ^= k >> 47;
+    k *= m;
+    hash ^= k;
+    hash *= m;
+  }
+  if (i < len) {
+    uint64_t k = 0;
+    memcpy(&k, key + i, len - i);
+    hash ^= k;
+    hash *= m;
+  }
+  hash ^= hash >> 47;
+  hash *= m;
+  hash ^= hash >> 47;
+  return hash;
+}
+
+uint32_t OpenAddressingAggregateHashTable::StringDictionary::get_or_add(const char *str, int len)
+{
+  auto [iter, inserted] = ids.try_emplace(string(str, len), static_cast<uint32_t>(values.size()));
+  if (inserted) {
+    values.push_back(iter->first);
+  }
+  return iter->second;
+}
+
+void OpenAddressingAggregateHashTable::Scanner::open_scan() { scan_pos_ = 0; }
+
+RC OpenAddressingAggregateHashTable::Scanner::next(Chunk &output_chunk)
+{
+  auto *hash_table = static_cast<OpenAddressingAggregateHashTable *>(hash_table_);
+  if (scan_pos_ < 0 || scan_pos_ >= hash_table->size()) {
+    return RC::RECORD_EOF;
+  }
+
+  const int key_column_num = static_cast<int>(hash_table->key_columns_.size());
+  while (scan_pos_ < hash_table->size() && output_chunk.rows() < output_chunk.capacity()) {
+    const char *data = hash_table->group_data(static_cast<uint32_t>(scan_pos_));
+    for (int i = 0; i < output_chunk.column_num(); i++) {
+      const int col_idx = output_chunk.column_ids(i);
+      RC        rc      = RC::SUCCESS;
+      if (col_idx < key_column_num) {
+        const KeyColumn &key_column = hash_table->key_columns_[col_idx];
+        if (key_column.nullable && data[key_column.offset + key_column.len] != 0) {
+          rc = output_chunk.column(i).append_null();
+        } else if (key_column.var_len) {
+          const string &value = hash_table->dictionaries_[col_idx].values[load<uint32_t>(data + key_column.offset)];
+          rc = output_chunk.column(i).append_string(value.data(), static_cast<int>(value.size()));
+        } else {
+          rc = append_bytes(output_chunk.column(i), data + key_column.offset, key_column.len);
+        }
+      } else {
+        rc = hash_table->append_result(hash_table->aggr_columns_[col_idx - key_column_num], data, output_chunk.column(i));
+      }
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to append aggregate result. rc=%s", strrc(rc));
+        return rc;
+      }
+    }
+    scan_pos_++;
+  }
+  return RC::SUCCESS;
+}
+
+void OpenAddressingAggregateHashTable::Scanner::close_scan() { scan_pos_ = -1; }
+
 // ----------------------------------LinearProbingAggregateHashTable------------------
 #ifdef USE_SIMD
 template <typename V>
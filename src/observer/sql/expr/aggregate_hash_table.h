@@ -47,6 +47,14 @@ public:
   virtual RC add_chunk(Chunk &groups_chunk, Chunk &aggrs_chunk) = 0;
 
   virtual ~AggregateHashTable() = default;
+
+  /**
+   * @brief 聚合结果的类型
+   * @details COUNT 的结果是整数，AVG 的结果是浮点数，SUM 的结果与参数的类型相同，
+   * MAX/MIN 的结果与参数的类型和长度都相同
+   */
+  static void aggregate_result_type(
+      AggregateFunctionType aggr_type, AttrType value_type, int value_len, AttrType &result_type, int &result_len);
 };
 
 class StandardAggregateHashTable : public AggregateHashTable
@@ -85,6 +93,11 @@ public:
       auto *aggregation_expr = static_cast<AggregateExpr *>(expr);
       aggr_types_.push_back(aggregation_expr->aggregate_type());
     }
+    int value_num = static_cast<int>(aggr_types_.size());
+    for (AggregateFunctionType aggr_type : aggr_types_) {
+      avg_count_pos_.push_back(aggr_type == AggregateFunctionType::AVG ? value_num++ : -1);
+    }
+    value_num_ = value_num;
   }
 
   virtual ~StandardAggregateHashTable() {}
@@ -96,8 +109,162 @@ public:
 
 private:
   /// group by values -> aggregate values
+  /// 每个聚合表达式对应一个值，AVG 记录的是累加值，它的计数依次放在所有聚合值的后面
   StandardHashTable                  aggr_values_;
   std::vector<AggregateFunctionType> aggr_types_;
+  std::vector<int>                   avg_count_pos_;  ///< AVG 的计数在聚合值中的位置，其它聚合函数是 -1
+  int                                value_num_ = 0;  ///< 每个分组的聚合值个数
+};
+
+/**
+ * @brief 开放地址哈希表实现，支持多个任意定长类型的 group by 列以及多个聚合列
+ * @details 每个分组占用 rows_ 中的一段定长内存，前面是 group by 列的值拼接成的键，后面依次是每个聚合函数的状态，
+ * 分组按照插入的顺序存放，扫描时也按照这个顺序输出。
+ * 哈希槽 slots_ 只记录哈希值的高32位和分组的编号，每个槽8个字节，使用线性探测解决冲突，
+ * 比较键之前先比较哈希值，大部分不相同的键不需要访问分组的内存。元素个数超过槽数的一半时，槽数翻倍。
+ *
+ * add_chunk 按照列处理数据：先把 group by 列拼成键并计算哈希值，再逐行查找或者创建分组，
+ * 最后对每个聚合列，用一个紧凑的循环把整列的值累加到对应分组的状态中。
+ * @note 聚合状态与 AggregateExpr 在按行执行时的计算方式保持一致，比如整数的 SUM 还是用 int 累加。
+ * 可以为 NULL 的 group by 列在键中多一个字节的 NULL 标记，NULL 单独成为一个分组；聚合时跳过 NULL 值，
+ * 一个非 NULL 值都没有的分组，SUM/AVG/MAX/MIN 的结果是 NULL。
+ * 变长的 group by 列先在字典中换成4字节的编号再放到键中，变长列的 MAX/MIN 状态是 string_states_ 中的下标，
+ * 这样键和聚合状态总是定长的，不会按照字段定义的最大长度占用内存。
+ */
+class OpenAddressingAggregateHashTable : public AggregateHashTable
+{
+public:
+  class Scanner : public AggregateHashTable::Scanner
+  {
+  public:
+    explicit Scanner(AggregateHashTable *hash_table) : AggregateHashTable::Scanner(hash_table) {}
+    ~Scanner() = default;
+
+    void open_scan() override;
+
+    /**
+     * @details output_chunk.column_ids(i) 小于 group by 列的个数时，表示输出第几个 group by 列，
+     * 否则表示输出第 (column_ids(i) - group by 列的个数) 个聚合结果。与 StandardAggregateHashTable 相同。
+     */
+    RC next(Chunk &chunk) override;
+
+    void close_scan() override;
+
+  private:
+    int scan_pos_ = -1;
+  };
+
+  OpenAddressingAggregateHashTable(const std::vector<Expression *> aggregations, int capacity = DEFAULT_CAPACITY);
+  virtual ~OpenAddressingAggregateHashTable() = default;
+
+  RC add_chunk(Chunk &groups_chunk, Chunk &aggrs_chunk) override;
+
+  /// @brief 分组的个数
+  int size() const { return static_cast<int>(group_hashes_.size()); }
+  /// @brief 哈希槽的个数
+  int capacity() const { return static_cast<int>(slots_.size()); }
+
+private:
+  static constexpr int      DEFAULT_CAPACITY = 1024;
+  static constexpr uint32_t EMPTY_GROUP      = 0xffffffff;
+
+  struct Slot
+  {
+    uint32_t tag   = 0;            ///< 哈希值的高32位
+    uint32_t group = EMPTY_GROUP;  ///< 分组的编号
+  };
+
+  struct KeyColumn
+  {
+    AttrType type;
+    int      len;
+    int      offset;    ///< 在键中的偏移量
+    bool     nullable;  ///< 为 true 时值的后面有一个字节的 NULL 标记
+    bool     var_len;   ///< 为 true 时键中保存的是字符串在字典中的编号
+  };
+
+  /// 变长 group by 列的字典，编号就是字符串在 values 中的下标
+  struct StringDictionary
+  {
+    std::unordered_map<std::string, uint32_t> ids;
+    std::vector<std::string>                  values;
+
+    uint32_t get_or_add(const char *str, int len);
+  };
+
+  struct AggrColumn
+  {
+    AggregateFunctionType aggr_type;
+    AttrType              value_type;
+    int                   value_len;
+    int                   offset;        ///< 状态在分组内存中的偏移量
+    int                   count_offset;  ///< 非 NULL 值个数在分组内存中的偏移量，列不可以为 NULL 时是 -1
+    bool                  var_len;       ///< 为 true 时状态是 string_states_ 中的下标
+  };
+
+  /**
+   * @brief 第一次添加数据时，根据各个列的类型确定分组内存的布局
+   */
+  RC init_layout(Chunk &groups_chunk, Chunk &aggrs_chunk);
+
+  /**
+   * @brief 把 group by 列的值拼接成键并计算哈希值，结果放在 keys_ 和 hashes_ 中
+   */
+  void build_keys(Chunk &groups_chunk, int rows);
+
+  /**
+   * @brief 查找每一行所在的分组，没有时创建，结果放在 group_ids_ 中
+   */
+  void find_or_create_groups(Chunk &aggrs_chunk, int rows);
+
+  uint32_t create_group(const char *key, uint64_t hash, Chunk &aggrs_chunk, int row);
+
+  void update_aggregate(const AggrColumn &aggr, const Column &column, int rows);
+
+  template <typename T>
+  void update_sum(const AggrColumn &aggr, const Column &column, int rows);
+  template <typename T>
+  void update_avg(const AggrColumn &aggr, const Column &column, int rows);
+  template <typename T, bool IS_MAX>
+  void update_extreme(const AggrColumn &aggr, const Column &column, int rows);
+  template <bool IS_MAX>
+  void update_extreme_string(const AggrColumn &aggr, const Column &column, int rows);
+  template <bool IS_MAX>
+  void update_extreme_var_len(const AggrColumn &aggr, const Column &column, int rows);
+
+  /**
+   * @brief 把聚合状态转换成聚合结果，写到 column 中
+   */
+  RC append_result(const AggrColumn &aggr, const char *group_data, Column &column) const;
+
+  void resize();
+
+  char       *group_data(uint32_t group) { return rows_.data() + static_cast<size_t>(group) * row_size_; }
+  const char *group_data(uint32_t group) const { return rows_.data() + static_cast<size_t>(group) * row_size_; }
+
+  static uint64_t hash_key(const char *key, int len);
+
+private:
+  std::vector<AggregateFunctionType> aggr_types_;
+
+  bool                    layout_inited_ = false;
+  std::vector<KeyColumn>  key_columns_;
+  std::vector<AggrColumn> aggr_columns_;
+  int                     key_size_ = 0;  ///< 键的长度
+  int                     row_size_ = 0;  ///< 每个分组占用的内存大小，包括键和所有聚合状态
+
+  std::vector<Slot>     slots_;
+  uint64_t              slot_mask_ = 0;
+  std::vector<char>     rows_;          ///< 所有分组的内存，按照插入顺序存放
+  std::vector<uint64_t> group_hashes_;  ///< 每个分组的键的哈希值，扩容时使用
+
+  std::vector<StringDictionary> dictionaries_;   ///< 与 key_columns_ 一一对应，只有变长列使用
+  std::vector<std::string>      string_states_;  ///< 变长列的 MAX/MIN 状态
+
+  /// 处理一个 chunk 时使用的临时内存，避免每次重新分配
+  std::vector<char>     keys_;
+  std::vector<uint64_t> hashes_;
+  std::vector<uint32_t> group_ids_;
 };
 
 /**
@@ -14,6 +14,7 @@ See the Mulan PSL v2 for more details. */
 #include "common/math/simd_util.h"
 #endif
 
+#include "common/lang/comparator.h"
 #include "storage/common/column.h"
 
 struct Equal
@@ -371,4 +372,62 @@ void compare_result(T *left, T *right, int n, std::vector<uint8_t> &result, Comp
     }
     default: break;
   }
+}
+
+/**
+ * @brief 字符串列的比较，定长和变长的列都通过 Column::string_at 访问
+ * @details 比较的语义与 CharType::compare 相同。已经不满足条件的行不再比较。
+ */
+template <bool LEFT_CONSTANT, bool RIGHT_CONSTANT, class OP>
+void compare_string_operation(const Column &left, const Column &right, int n, std::vector<uint8_t> &result)
+{
+  int         left_len    = 0;
+  int         right_len   = 0;
+  const char *left_value  = LEFT_CONSTANT ? left.string_at(0, left_len) : nullptr;
+  const char *right_value = RIGHT_CONSTANT ? right.string_at(0, right_len) : nullptr;
+  for (int i = 0; i < n; i++) {
+    if (result[i] == 0) {
+      continue;
+    }
+    if constexpr (!LEFT_CONSTANT) {
+      left_value = left.string_at(i, left_len);
+    }
+    if constexpr (!RIGHT_CONSTANT) {
+      right_value = right.string_at(i, right_len);
+    }
+    const int cmp = common::compare_string((void *)left_value, left_len, (void *)right_value, right_len);
+    result[i] &= OP::operation(cmp, 0) ? 1 : 0;
+  }
+}
+
+template <bool LEFT_CONSTANT, bool RIGHT_CONSTANT>
+void compare_string_result(const Column &left, const Column &right, int n, std::vector<uint8_t> &result, CompOp op)
+{
+  switch (op) {
+    case CompOp::EQUAL_TO: {
+      compare_string_operation<LEFT_CONSTANT, RIGHT_CONSTANT, Equal>(left, right, n, result);
+      break;
+    }
+    case CompOp::NOT_EQUAL: {
+      compare_string_operation<LEFT_CONSTANT, RIGHT_CONSTANT, NotEqual>(left, right, n, result);
+      break;
+    }
+    case CompOp::GREAT_EQUAL: {
+      compare_string_operation<LEFT_CONSTANT, RIGHT_CONSTANT, GreatEqual>(left, right, n, result);
+      break;
+    }
+    case CompOp::GREAT_THAN: {
+      compare_string_operation<LEFT_CONSTANT, RIGHT_CONSTANT, GreatThan>(left, right, n, result);
+      break;
+    }
+    case CompOp::LESS_EQUAL: {
+      compare_string_operation<LEFT_CONSTANT, RIGHT_CONSTANT, LessEqual>(left, right, n, result);
+      break;
+    }
+    case CompOp::LESS_THAN: {
+      compare_string_operation<LEFT_CONSTANT, RIGHT_CONSTANT, LessThan>(left, right, n, result);
+      break;
+    }
+    default: break;
+  }
 }
\ No newline at end of file
@@ -52,9 +52,15 @@ RC FieldExpr::get_column(Chunk &chunk, Column &column)
 {
   if (pos_ != -1) {
     column.reference(chunk.column(pos_));
-  } else {
-    column.reference(chunk.column(field().meta()->field_id()));
+    return RC::SUCCESS;
   }
+
+  Column *field_column = chunk.column_by_id(field().meta()->field_id());
+  if (nullptr == field_column) {
+    LOG_WARN("field is not in chunk. field=%s", field_name());
+    return RC::SCHEMA_FIELD_MISSING;
+  }
+  column.reference(*field_column);
   return RC::SUCCESS;
 }
 
@@ -324,6 +330,95 @@ RC ComparisonExpr::get_value(const Tuple &tuple, Value &value)
   return rc;
 }
 
+namespace {
+/**
+ * @brief LIKE 的模式匹配。% 匹配任意个字符，_ 匹配一个字符，其它字符按原样比较
+ * @details 遇到 % 时记录位置，后面匹配失败就回到这里多吞掉一个字符，不会出现指数级的回溯
+ */
+bool like_match(const char *str, int str_len, const char *pattern, int pattern_len)
+{
+  int s = 0, p = 0;
+  int star_p = -1, star_s = 0;
+  while (s < str_len) {
+    if (p < pattern_len && pattern[p] == '%') {
+      star_p = p++;
+      star_s = s;
+    } else if (p < pattern_len && (pattern[p] == '_' || pattern[p] == str[s])) {
+      s++;
+      p++;
+    } else if (star_p != -1) {
+      p = star_p + 1;
+      s = ++star_s;
+    } else {
+      return false;
+    }
+  }
+  while (p < pattern_len && pattern[p] == '%') {
+    p++;
+  }
+  return p == pattern_len;
+}
+
+/**
+ * @brief 字符串列与常量模式的 LIKE/NOT LIKE，定长和变长的列都可以
+ * @details 没有通配符的模式退化成等值比较，只在末尾有一个 % 的模式是前缀比较，都只需要一次 memcmp
+ */
+void like_column(const Column &column, const string &pattern, bool like, int n, vector<uint8_t> &select)
+{
+  enum class Kind
+  {
+    EXACT,
+    PREFIX,
+    GENERAL
+  };
+  const size_t wildcard  = pattern.find_first_of("%_");
+  const int    fixed_len = static_cast<int>(wildcard == string::npos ? pattern.size() : wildcard);
+  Kind         kind      = Kind::GENERAL;
+  if (wildcard == string::npos) {
+    kind = Kind::EXACT;
+  } else if (wildcard == pattern.size() - 1 && pattern[wildcard] == '%') {
+    kind = Kind::PREFIX;
+  }
+
+  for (int i = 0; i < n; i++) {
+    if (select[i] == 0) {
+      continue;
+    }
+    int         len     = 0;
+    const char *value   = column.string_at(i, len);
+    bool        matched = false;
+    switch (kind) {
+      case Kind::EXACT: matched = len == fixed_len && memcmp(value, pattern.data(), fixed_len) == 0; break;
+      case Kind::PREFIX: matched = len >= fixed_len && memcmp(value, pattern.data(), fixed_len) == 0; break;
+      case Kind::GENERAL: matched = like_match(value, len, pattern.data(), static_cast<int>(pattern.size())); break;
+    }
+    select[i] &= (matched == like) ? 1 : 0;
+  }
+}
+
+/**
+ * @brief 把整数列转换成浮点数列，整数与浮点数比较时使用
+ */
+void int_column_to_float(const Column &column, Column &result)
+{
+  if (column.column_type() == Column::Type::CONSTANT_COLUMN) {
+    const Value value = column.get_value(0);
+    result.init(value.is_null() ? value : Value(static_cast<float>(value.get_int())));
+    return;
+  }
+
+  result.init(AttrType::FLOATS, sizeof(float), std::max(column.count(), 1), column.nullable());
+  const int *values = reinterpret_cast<const int *>(column.data());
+  for (int i = 0; i < column.count(); i++) {
+    float value = static_cast<float>(values[i]);
+    result.append_one(reinterpret_cast<char *>(&value));
+    if (column.is_null(i)) {
+      result.set_null(i);
+    }
+  }
+}
+}  // namespace
+
 RC ComparisonExpr::eval(Chunk &chunk, std::vector<uint8_t> &select)
 {
   RC     rc = RC::SUCCESS;
@@ -340,18 +435,106 @@ RC ComparisonExpr::eval(Chunk &chunk, std::vector<uint8_t> &select)
     LOG_WARN("failed to get value of right expression. rc=%s", strrc(rc));
     return rc;
   }
-  if (left_column.attr_type() != right_column.attr_type()) {
-    LOG_WARN("cannot compare columns with different types");
-    return RC::INTERNAL;
+
+  const int n = static_cast<int>(select.size());
+  if (comp_ == IS_OP || comp_ == IS_NOT_OP) {
+    if (right_column.attr_type() != AttrType::NULLS) {
+      return RC::NOT_NULL_AFTER_IS;
+    }
+    // 直接看 null 位图，不可以为 NULL 的列没有位图
+    const bool expect_null = comp_ == IS_OP;
+    for (int i = 0; i < n; i++) {
+      select[i] &= left_column.is_null(i) == expect_null ? 1 : 0;
+    }
+    return RC::SUCCESS;
+  }
+
+  // 与 NULL 常量比较的结果总是 false
+  auto is_null_constant = [](const Column &column) {
+    return column.column_type() == Column::Type::CONSTANT_COLUMN && column.has_null();
+  };
+  if (is_null_constant(left_column) || is_null_constant(right_column)) {
+    std::fill(select.begin(), select.end(), 0);
+    return RC::SUCCESS;
   }
-  if (left_column.attr_type() == AttrType::INTS) {
-    rc = compare_column<int>(left_column, right_column, select);
-  } else if (left_column.attr_type() == AttrType::FLOATS) {
-    rc = compare_column<float>(left_column, right_column, select);
-  } else {
-    // TODO: support string compare
-    LOG_WARN("unsupported data type %d", left_column.attr_type());
-    return RC::INTERNAL;
+
+  // 类型不同时，整数转换成浮点数，常量转换成另一边的类型
+  const Column *left  = &left_column;
+  const Column *right = &right_column;
+  Column        cast_column;
+  if (left->attr_type() != right->attr_type()) {
+    if (left->attr_type() == AttrType::INTS && right->attr_type() == AttrType::FLOATS) {
+      int_column_to_float(*left, cast_column);
+      left = &cast_column;
+    } else if (left->attr_type() == AttrType::FLOATS && right->attr_type() == AttrType::INTS) {
+      int_column_to_float(*right, cast_column);
+      right = &cast_column;
+    } else {
+      const bool    right_const = right->column_type() == Column::Type::CONSTANT_COLUMN;
+      const Column *constant    = right_const ? right : left;
+      const Column *other       = right_const ? left : right;
+      if (constant->column_type() != Column::Type::CONSTANT_COLUMN) {
+        LOG_WARN("cannot compare columns with different types. left=%s, right=%s",
+                 attr_type_to_string(left->attr_type()), attr_type_to_string(right->attr_type()));
+        return RC::UNSUPPORTED;
+      }
+      Value cast_value;
+      rc = Value::cast_to(constant->get_value(0), other->attr_type(), cast_value);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to cast constant. from=%s, to=%s, rc=%s",
+                 attr_type_to_string(constant->attr_type()), attr_type_to_string(other->attr_type()), strrc(rc));
+        return rc;
+      }
+      cast_column.init(cast_value);
+      (right_const ? right : left) = &cast_column;
+    }
+  }
+
+  switch (comp_) {
+    case EQUAL_TO:
+    case NOT_EQUAL:
+    case LESS_THAN:
+    case LESS_EQUAL:
+    case GREAT_THAN:
+    case GREAT_EQUAL: {
+      switch (left->attr_type()) {
+        case AttrType::INTS:
+        case AttrType::DATES: rc = compare_column<int>(*left, *right, select); break;
+        case AttrType::FLOATS: rc = compare_column<float>(*left, *right, select); break;
+        case AttrType::BOOLEANS: rc = compare_column<bool>(*left, *right, select); break;
+        case AttrType::CHARS:
+        case AttrType::TEXTS: rc = compare_string_column(*left, *right, select); break;
+        default: {
+          LOG_WARN("unsupported data type %s", attr_type_to_string(left->attr_type()));
+          return RC::UNSUPPORTED;
+        }
+      }
+    } break;
+    case LIKE_OP:
+    case NOT_LIKE_OP: {
+      if ((left->attr_type() != AttrType::CHARS && left->attr_type() != AttrType::TEXTS) ||
+          right->column_type() != Column::Type::CONSTANT_COLUMN) {
+        LOG_WARN("LIKE only support string column and constant pattern");
+        return RC::UNSUPPORTED;
+      }
+      like_column(*left, right->get_value(0).get_string(), comp_ == LIKE_OP, n, select);
+    } break;
+    default: {
+      LOG_WARN("unsupported comparison. %d", comp_);
+      return RC::UNSUPPORTED;
+    }
+  }
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  // 有 NULL 参与的比较结果总是 false
+  for (const Column *column : {left, right}) {
+    if (column->has_null()) {
+      for (int i = 0; i < n; i++) {
+        select[i] &= column->is_null(i) ? 0 : 1;
+      }
+    }
   }
   return rc;
 }
@@ -361,20 +544,38 @@ RC ComparisonExpr::compare_column(const Column &left, const Column &right, std::
 {
   RC rc = RC::SUCCESS;
 
-  bool left_const  = left.column_type() == Column::Type::CONSTANT_COLUMN;
-  bool right_const = right.column_type() == Column::Type::CONSTANT_COLUMN;
+  const int n           = static_cast<int>(result.size());
+  bool      left_const  = left.column_type() == Column::Type::CONSTANT_COLUMN;
+  bool      right_const = right.column_type() == Column::Type::CONSTANT_COLUMN;
   if (left_const && right_const) {
-    compare_result<T, true, true>((T *)left.data(), (T *)right.data(), left.count(), result, comp_);
+    compare_result<T, true, true>((T *)left.data(), (T *)right.data(), n, result, comp_);
   } else if (left_const && !right_const) {
-    compare_result<T, true, false>((T *)left.data(), (T *)right.data(), right.count(), result, comp_);
+    compare_result<T, true, false>((T *)left.data(), (T *)right.data(), n, result, comp_);
   } else if (!left_const && right_const) {
-    compare_result<T, false, true>((T *)left.data(), (T *)right.data(), left.count(), result, comp_);
+    compare_result<T, false, true>((T *)left.data(), (T *)right.data(), n, result, comp_);
   } else {
-    compare_result<T, false, false>((T *)left.data(), (T *)right.data(), left.count(), result, comp_);
+    compare_result<T, false, false>((T *)left.data(), (T *)right.data(), n, result, comp_);
   }
   return rc;
 }
 
+RC ComparisonExpr::compare_string_column(const Column &left, const Column &right, std::vector<uint8_t> &result) const
+{
+  const int n           = static_cast<int>(result.size());
+  bool      left_const  = left.column_type() == Column::Type::CONSTANT_COLUMN;
+  bool      right_const = right.column_type() == Column::Type::CONSTANT_COLUMN;
+  if (left_const && right_const) {
+    compare_string_result<true, true>(left, right, n, result, comp_);
+  } else if (left_const && !right_const) {
+    compare_string_result<true, false>(left, right, n, result, comp_);
+  } else if (!left_const && right_const) {
+    compare_string_result<false, true>(left, right, n, result, comp_);
+  } else {
+    compare_string_result<false, false>(left, right, n, result, comp_);
+  }
+  return RC::SUCCESS;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ConjunctionExpr::ConjunctionExpr(Type type, vector<unique_ptr<Expression>> &children)
     : conjunction_type_(type), children_(std::move(children))
@@ -616,7 +817,8 @@ RC ArithmeticExpr::calc_column(const Column &left_column, const Column &right_co
   RC rc = RC::SUCCESS;
 
   const AttrType target_type = value_type();
-  column.init(target_type, left_column.attr_len(), std::max(left_column.count(), right_column.count()));
+  const bool     nullable    = left_column.nullable() || right_column.nullable();
+  column.init(target_type, left_column.attr_len(), std::max(left_column.count(), right_column.count()), nullable);
   bool left_const  = left_column.column_type() == Column::Type::CONSTANT_COLUMN;
   bool right_const = right_column.column_type() == Column::Type::CONSTANT_COLUMN;
   if (left_const && right_const) {
@@ -632,6 +834,15 @@ RC ArithmeticExpr::calc_column(const Column &left_column, const Column &right_co
     column.set_column_type(Column::Type::NORMAL_COLUMN);
     rc = execute_calc<false, false>(left_column, right_column, column, arithmetic_type_, target_type);
   }
+
+  // 任意一边是 NULL 时结果是 NULL
+  if (OB_SUCC(rc) && (left_column.has_null() || right_column.has_null())) {
+    for (int i = 0; i < column.count(); i++) {
+      if (left_column.is_null(i) || right_column.is_null(i)) {
+        column.set_null(i);
+      }
+    }
+  }
   return rc;
 }
 
@@ -206,7 +206,11 @@ public:
 
   ExprType type() const override { return ExprType::FIELD; }
   AttrType value_type() const override { return field_.attr_type(); }
-  int      value_length() const override { return field_.meta()->len(); }
+  /// 记录中可以为 NULL 的字段最后有一个字节的 NULL 标记，不算在值的长度中
+  int      value_length() const override
+  {
+    return field_.meta()->nullable() ? field_.meta()->len() - 1 : field_.meta()->len();
+  }
 
   Field &field() { return field_; }
 
@@ -214,6 +218,7 @@ public:
 
   const char *table_name() const { return field_.table_name(); }
   const char *field_name() const { return field_.field_name(); }
+  const char *table_alias() const { return table_alias_.c_str(); }
 
   RC get_column(Chunk &chunk, Column &column) override;
 
@@ -254,9 +259,18 @@ public:
 
   void         get_value(Value &value) const { value = value_; }
   const Value &get_value() const { return value_; }
+  void         set_value(const Value &value) { value_ = value; }
+
+  /**
+   * @brief 常量在SQL语句中的序号
+   * @details 由SQL中的常量直接生成的表达式才有序号，执行计划缓存根据序号把新的常量绑定到缓存的计划中
+   */
+  int  param_index() const { return param_index_; }
+  void set_param_index(int index) { param_index_ = index; }
 
 private:
   Value value_;
+  int   param_index_ = -1;
 };
 
 /**
@@ -328,6 +342,11 @@ public:
   template <typename T>
   RC compare_column(const Column &left, const Column &right, std::vector<uint8_t> &result) const;
 
+  /**
+   * @brief 字符串列的比较，与 CharType::compare 的结果一致
+   */
+  RC compare_string_column(const Column &left, const Column &right, std::vector<uint8_t> &result) const;
+
 private:
   CompOp                      comp_;
   std::unique_ptr<Expression> left_;
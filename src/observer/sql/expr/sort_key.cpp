@@ -0,0 +1,78 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#include "sql/expr/sort_key.h"
+
+#include <cstring>
+
+using namespace std;
+
+static void append_uint32(uint32_t value, string &key)
+{
+  key.push_back(static_cast<char>(value >> 24));
+  key.push_back(static_cast<char>(value >> 16));
+  key.push_back(static_cast<char>(value >> 8));
+  key.push_back(static_cast<char>(value));
+}
+
+static void append_string(const char *data, int length, string &key)
+{
+  // 字符串比较到'\0'为止，所以中间的'\0'之后的内容可以不要
+  if (data != nullptr) {
+    key.append(data, strnlen(data, length));
+  }
+  key.push_back('\0');
+}
+
+void SortKey::append(const Value &value, bool is_asc, string &key)
+{
+  const size_t begin = key.size();
+  if (value.is_null() || value.attr_type() == AttrType::NULLS) {
+    key.push_back('\0');
+  } else {
+    key.push_back('\1');
+    switch (value.attr_type()) {
+      case AttrType::INTS: {
+        append_uint32(static_cast<uint32_t>(value.get_int()) ^ 0x80000000u, key);
+      } break;
+      case AttrType::DATES: {
+        append_uint32(static_cast<uint32_t>(value.get_date()) ^ 0x80000000u, key);
+      } break;
+      case AttrType::BOOLEANS: {
+        key.push_back(value.get_boolean() ? '\1' : '\0');
+      } break;
+      case AttrType::FLOATS: {
+        float    float_value = value.get_float();
+        uint32_t bits        = 0;
+        memcpy(&bits, &float_value, sizeof(bits));
+        bits = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+        append_uint32(bits, key);
+      } break;
+      case AttrType::CHARS:
+      case AttrType::TEXTS: {
+        append_string(value.data(), value.length(), key);
+      } break;
+      default: {
+        string str = value.to_string();
+        append_string(str.data(), static_cast<int>(str.size()), key);
+      } break;
+    }
+  }
+
+  if (!is_asc) {
+    for (size_t i = begin; i < key.size(); i++) {
+      key[i] = static_cast<char>(~key[i]);
+    }
+  }
+}
@@ -0,0 +1,40 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#pragma once
+
+#include <string>
+
+#include "common/value.h"
+
+/**
+ * @brief 排序键的归一化编码
+ * @ingroup Expression
+ * @details 把多个排序列编码成一个字节串，直接使用 memcmp 比较两个字节串就能得到排序结果，
+ * 不需要再逐个比较 Value，也便于写入到外部排序的临时文件中。
+ * 每一列的编码是：一个字节的 NULL 标识(NULL 排在最前面)，然后是数据本身：
+ * - INTS/DATES 使用大端序，并翻转符号位；
+ * - FLOATS 使用 IEEE 754 编码，正数翻转符号位，负数翻转所有位；
+ * - CHARS/TEXTS 使用原始字节，以'\0'结尾；
+ * - 降序的列在编码后翻转所有位。
+ */
+class SortKey
+{
+public:
+  /**
+   * @brief 将一个值编码后追加到 key 的末尾
+   * @param is_asc 是否升序
+   */
+  static void append(const Value &value, bool is_asc, std::string &key);
+};
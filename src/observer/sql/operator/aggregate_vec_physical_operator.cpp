@@ -9,8 +9,12 @@ MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
 #include <algorithm>
+#include "common/global_context.h"
+#include "common/lang/mutex.h"
 #include "common/log/log.h"
+#include "common/thread/thread_pool_executor.h"
 #include "sql/operator/aggregate_vec_physical_operator.h"
+#include "sql/operator/table_scan_vec_physical_operator.h"
 #include "sql/expr/aggregate_state.h"
 #include "sql/expr/expression_tuple.h"
 #include "sql/expr/composite_tuple.h"
@@ -37,14 +41,8 @@ AggregateVecPhysicalOperator::AggregateVecPhysicalOperator(vector<Expression *>
 
     if (aggregate_expr->aggregate_type() == AggregateFunctionType::SUM) {
       if (aggregate_expr->value_type() == AttrType::INTS) {
-        void *aggr_value                     = malloc(sizeof(SumState<int>));
-        ((SumState<int> *)aggr_value)->value = 0;
-        aggr_values_.insert(aggr_value);
         output_chunk_.add_column(make_unique<Column>(AttrType::INTS, sizeof(int)), i);
       } else if (aggregate_expr->value_type() == AttrType::FLOATS) {
-        void *aggr_value                       = malloc(sizeof(SumState<float>));
-        ((SumState<float> *)aggr_value)->value = 0;
-        aggr_values_.insert(aggr_value);
         output_chunk_.add_column(make_unique<Column>(AttrType::FLOATS, sizeof(float)), i);
       }
     } else {
@@ -53,34 +51,45 @@ AggregateVecPhysicalOperator::AggregateVecPhysicalOperator(vector<Expression *>
   }
 }
 
+void AggregateVecPhysicalOperator::init_aggregate_values(AggregateValues &aggr_values)
+{
+  aggr_values.clear();
+  for (Expression *expr : aggregate_expressions_) {
+    auto *aggregate_expr = static_cast<AggregateExpr *>(expr);
+    if (aggregate_expr->value_type() == AttrType::INTS) {
+      void *aggr_value                     = malloc(sizeof(SumState<int>));
+      ((SumState<int> *)aggr_value)->value = 0;
+      aggr_values.insert(aggr_value);
+    } else if (aggregate_expr->value_type() == AttrType::FLOATS) {
+      void *aggr_value                       = malloc(sizeof(SumState<float>));
+      ((SumState<float> *)aggr_value)->value = 0;
+      aggr_values.insert(aggr_value);
+    }
+  }
+}
+
 RC AggregateVecPhysicalOperator::open(Trx *trx)
 {
   ASSERT(children_.size() == 1, "group by operator only support one child, but got %d", children_.size());
 
+  init_aggregate_values(aggr_values_);
+  outputted_ = false;
+
   PhysicalOperator &child = *children_[0];
-  RC                rc    = child.open(trx);
+  if (parallel_degree_ > 1 && child.type() == PhysicalOperatorType::TABLE_SCAN_VEC &&
+      GCTX.parallel_executor_ != nullptr) {
+    return open_parallel(trx, static_cast<TableScanVecPhysicalOperator &>(child));
+  }
+
+  RC rc = child.open(trx);
   if (OB_FAIL(rc)) {
     LOG_INFO("failed to open child operator. rc=%s", strrc(rc));
     return rc;
   }
 
   while (OB_SUCC(rc = child.next(chunk_))) {
-    for (size_t aggr_idx = 0; aggr_idx < aggregate_expressions_.size(); aggr_idx++) {
-      Column column;
-      value_expressions_[aggr_idx]->get_column(chunk_, column);
-      ASSERT(aggregate_expressions_[aggr_idx]->type() == ExprType::AGGREGATION, "expect aggregate expression");
-      auto *aggregate_expr = static_cast<AggregateExpr *>(aggregate_expressions_[aggr_idx]);
-      if (aggregate_expr->aggregate_type() == AggregateFunctionType::SUM) {
-        if (aggregate_expr->value_type() == AttrType::INTS) {
-          update_aggregate_state<SumState<int>, int>(aggr_values_.at(aggr_idx), column);
-        } else if (aggregate_expr->value_type() == AttrType::FLOATS) {
-          update_aggregate_state<SumState<float>, float>(aggr_values_.at(aggr_idx), column);
-        } else {
-          ASSERT(false, "not supported value type");
-        }
-      } else {
-        ASSERT(false, "not supported aggregation type");
-      }
+    if (OB_FAIL(rc = aggregate_chunk(chunk_, aggr_values_))) {
+      return rc;
     }
   }
 
@@ -90,6 +99,116 @@ RC AggregateVecPhysicalOperator::open(Trx *trx)
 
   return rc;
 }
+
+RC AggregateVecPhysicalOperator::open_parallel(Trx *trx, TableScanVecPhysicalOperator &scan_oper)
+{
+  vector<TableScanVecPhysicalOperator::ScanState *> states;
+  RC rc = scan_oper.open_parallel(trx, parallel_degree_, states);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open parallel table scan. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  const int                           task_num = static_cast<int>(states.size());
+  vector<unique_ptr<AggregateValues>> partial_values(task_num);
+  vector<RC>                          results(task_num, RC::SUCCESS);
+  for (int i = 0; i < task_num; i++) {
+    partial_values[i] = make_unique<AggregateValues>();
+    init_aggregate_values(*partial_values[i]);
+  }
+
+  auto run_task = [&](int i) {
+    Chunk chunk;
+    RC    task_rc = RC::SUCCESS;
+    while (OB_SUCC(task_rc = scan_oper.parallel_next(*states[i], chunk))) {
+      if (OB_FAIL(task_rc = aggregate_chunk(chunk, *partial_values[i]))) {
+        break;
+      }
+    }
+    results[i] = task_rc == RC::RECORD_EOF ? RC::SUCCESS : task_rc;
+  };
+
+  // 当前线程也执行一个任务，其它的任务放到线程池中。线程池的队列满了就在当前线程中执行
+  mutex              lock;
+  condition_variable finished;
+  int                running = task_num - 1;
+  for (int i = 1; i < task_num; i++) {
+    int ret = GCTX.parallel_executor_->execute([&, i]() {
+      run_task(i);
+      lock_guard<mutex> guard(lock);
+      if (--running == 0) {
+        finished.notify_all();
+      }
+    });
+    if (ret != 0) {
+      run_task(i);
+      lock_guard<mutex> guard(lock);
+      running--;
+    }
+  }
+  run_task(0);
+  {
+    unique_lock<mutex> guard(lock);
+    finished.wait(guard, [&running]() { return running == 0; });
+  }
+
+  for (int i = 0; i < task_num; i++) {
+    if (OB_FAIL(results[i])) {
+      LOG_WARN("failed to run parallel aggregation task. task=%d, rc=%s", i, strrc(results[i]));
+      return results[i];
+    }
+  }
+
+  // 合并每个线程部分聚合的结果
+  for (size_t aggr_idx = 0; aggr_idx < aggregate_expressions_.size(); aggr_idx++) {
+    auto *aggregate_expr = static_cast<AggregateExpr *>(aggregate_expressions_[aggr_idx]);
+    for (int i = 0; i < task_num; i++) {
+      void *partial = partial_values[i]->at(aggr_idx);
+      if (aggregate_expr->value_type() == AttrType::INTS) {
+        static_cast<SumState<int> *>(aggr_values_.at(aggr_idx))->merge(*static_cast<SumState<int> *>(partial));
+      } else if (aggregate_expr->value_type() == AttrType::FLOATS) {
+        static_cast<SumState<float> *>(aggr_values_.at(aggr_idx))->merge(*static_cast<SumState<float> *>(partial));
+      }
+    }
+  }
+  LOG_TRACE("parallel aggregation finished. parallel degree=%d", task_num);
+  return RC::SUCCESS;
+}
+
+RC AggregateVecPhysicalOperator::aggregate_chunk(Chunk &chunk, AggregateValues &aggr_values)
+{
+  for (size_t aggr_idx = 0; aggr_idx < aggregate_expressions_.size(); aggr_idx++) {
+    Column all_rows;
+    Column selected_rows;
+    RC     rc = value_expressions_[aggr_idx]->get_column(chunk, all_rows);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get column of aggregation. rc=%s", strrc(rc));
+      return rc;
+    }
+    // 有选择向量时只收集有效的行
+    const bool compact = chunk.has_selection() && all_rows.column_type() == Column::Type::NORMAL_COLUMN;
+    if (compact) {
+      selected_rows.init(all_rows.attr_type(), all_rows.attr_len(), max(chunk.selected_rows(), 1), all_rows.nullable());
+      selected_rows.append_selected(all_rows, chunk.selection().data(), chunk.selected_rows());
+    }
+    const Column &column = compact ? selected_rows : all_rows;
+    ASSERT(aggregate_expressions_[aggr_idx]->type() == ExprType::AGGREGATION, "expect aggregate expression");
+    auto *aggregate_expr = static_cast<AggregateExpr *>(aggregate_expressions_[aggr_idx]);
+    if (aggregate_expr->aggregate_type() == AggregateFunctionType::SUM) {
+      if (aggregate_expr->value_type() == AttrType::INTS) {
+        update_aggregate_state<SumState<int>, int>(aggr_values.at(aggr_idx), column);
+      } else if (aggregate_expr->value_type() == AttrType::FLOATS) {
+        update_aggregate_state<SumState<float>, float>(aggr_values.at(aggr_idx), column);
+      } else {
+        ASSERT(false, "not supported value type");
+      }
+    } else {
+      ASSERT(false, "not supported aggregation type");
+    }
+  }
+  return RC::SUCCESS;
+}
+
 template <class STATE, typename T>
 void AggregateVecPhysicalOperator::update_aggregate_state(void *state, const Column &column)
 {
@@ -100,8 +219,21 @@ void AggregateVecPhysicalOperator::update_aggregate_state(void *state, const Col
 
 RC AggregateVecPhysicalOperator::next(Chunk &chunk)
 {
-  // your code here
-  exit(-1);
+  if (outputted_) {
+    return RC::RECORD_EOF;
+  }
+
+  output_chunk_.reset_data();
+  for (size_t i = 0; i < aggregate_expressions_.size(); i++) {
+    auto *aggregate_expr = static_cast<AggregateExpr *>(aggregate_expressions_[i]);
+    if (aggregate_expr->value_type() == AttrType::INTS) {
+      append_to_column<SumState<int>, int>(aggr_values_.at(i), output_chunk_.column(i));
+    } else if (aggregate_expr->value_type() == AttrType::FLOATS) {
+      append_to_column<SumState<float>, float>(aggr_values_.at(i), output_chunk_.column(i));
+    }
+  }
+  outputted_ = true;
+  return chunk.reference(output_chunk_);
 }
 
 RC AggregateVecPhysicalOperator::close()
@@ -109,4 +241,4 @@ RC AggregateVecPhysicalOperator::close()
   children_[0]->close();
   LOG_INFO("close group by operator");
   return RC::SUCCESS;
-}
\ No newline at end of file
+}
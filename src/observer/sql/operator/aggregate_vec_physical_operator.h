@@ -12,9 +12,13 @@ See the Mulan PSL v2 for more details. */
 
 #include "sql/operator/physical_operator.h"
 
+class TableScanVecPhysicalOperator;
+
 /**
  * @brief 聚合物理算子 (Vectorized)
  * @ingroup PhysicalOperator
+ * @details 并行度大于1并且子算子是向量化的表扫描时，使用 morsel 并行执行：每个线程从表扫描中领取页面，
+ * 过滤之后在自己的聚合状态上计算部分结果，所有线程结束后再合并成最终的结果。
  */
 class AggregateVecPhysicalOperator : public PhysicalOperator
 {
@@ -25,21 +29,13 @@ public:
 
   PhysicalOperatorType type() const override { return PhysicalOperatorType::AGGREGATE_VEC; }
 
+  /// @brief 设置并行度，参考会话变量 parallel_degree
+  void set_parallel_degree(int parallel_degree) { parallel_degree_ = parallel_degree; }
+
   RC open(Trx *trx) override;
   RC next(Chunk &chunk) override;
   RC close() override;
 
-private:
-  template <class STATE, typename T>
-  void update_aggregate_state(void *state, const Column &column);
-
-  template <class STATE, typename T>
-  void append_to_column(void *state, Column &column)
-  {
-    STATE *state_ptr = reinterpret_cast<STATE *>(state);
-    column.append_one((char *)&state_ptr->value);
-  }
-
 private:
   class AggregateValues
   {
@@ -55,20 +51,46 @@ private:
     }
 
     size_t size() { return data_.size(); }
-    ~AggregateValues()
+
+    void clear()
     {
       for (auto &aggr_value : data_) {
         free(aggr_value);
         aggr_value = nullptr;
       }
+      data_.clear();
     }
 
+    ~AggregateValues() { clear(); }
+
   private:
     std::vector<void *> data_;
   };
+
+  /// @brief 为每个聚合表达式创建初始的聚合状态
+  void init_aggregate_values(AggregateValues &aggr_values);
+
+  RC aggregate_chunk(Chunk &chunk, AggregateValues &aggr_values);
+
+  /// @brief 每个线程计算部分聚合的结果，然后合并到 aggr_values_ 中
+  RC open_parallel(Trx *trx, TableScanVecPhysicalOperator &scan_oper);
+
+  template <class STATE, typename T>
+  void update_aggregate_state(void *state, const Column &column);
+
+  template <class STATE, typename T>
+  void append_to_column(void *state, Column &column)
+  {
+    STATE *state_ptr = reinterpret_cast<STATE *>(state);
+    column.append_one((char *)&state_ptr->value);
+  }
+
+private:
   std::vector<Expression *> aggregate_expressions_;  /// 聚合表达式
   std::vector<Expression *> value_expressions_;
   Chunk                     chunk_;
   Chunk                     output_chunk_;
   AggregateValues           aggr_values_;
-};
\ No newline at end of file
+  int                       parallel_degree_ = 1;
+  bool                      outputted_       = false;
+};
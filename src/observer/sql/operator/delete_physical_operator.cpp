@@ -13,6 +13,7 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include "sql/operator/delete_physical_operator.h"
+#include "common/lang/defer.h"
 #include "common/log/log.h"
 #include "storage/table/table.h"
 #include "storage/trx/trx.h"
@@ -48,6 +49,9 @@ RC DeletePhysicalOperator::open(Trx *trx)
 
   child->close();
 
+  // 修改完成后递增版本号，让查询缓存中读过这张表的结果失效
+  DEFER(table_->increase_data_version());
+
   // 先收集记录再删除
   // 记录的有效性由事务来保证，如果事务不保证删除的有效性，那说明此事务类型不支持并发控制，比如VacuousTrx
   for (Record &record : records_) {
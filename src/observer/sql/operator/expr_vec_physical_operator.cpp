@@ -48,6 +48,8 @@ RC ExprVecPhysicalOperator::next(Chunk &chunk)
       expressions_[i]->get_column(chunk_, *column);
       evaled_chunk_.add_column(std::move(column), i);
     }
+    // 表达式按照所有行计算，计算结果与子算子的行一一对应，沿用子算子的选择向量
+    evaled_chunk_.copy_selection(chunk_);
     chunk.reference(evaled_chunk_);
   }
   return rc;
@@ -8,4 +8,146 @@ EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
 MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
-#include "sql/operator/group_by_vec_physical_operator.h"
\ No newline at end of file
+#include "sql/operator/group_by_vec_physical_operator.h"
+#include "common/log/log.h"
+
+using namespace std;
+using namespace common;
+
+GroupByVecPhysicalOperator::GroupByVecPhysicalOperator(
+    vector<unique_ptr<Expression>> &&group_by_exprs, vector<Expression *> &&expressions)
+    : group_by_exprs_(std::move(group_by_exprs)), aggregate_expressions_(std::move(expressions))
+{
+  value_expressions_.reserve(aggregate_expressions_.size());
+  for (Expression *expr : aggregate_expressions_) {
+    ASSERT(expr->type() == ExprType::AGGREGATION, "expected an aggregation expression");
+    auto       *aggregate_expr = static_cast<AggregateExpr *>(expr);
+    Expression *child_expr     = aggregate_expr->child().get();
+    ASSERT(child_expr != nullptr, "aggregation expression must have a child expression");
+    value_expressions_.emplace_back(child_expr);
+  }
+
+  int col_id = 0;
+  for (const unique_ptr<Expression> &expr : group_by_exprs_) {
+    output_chunk_.add_column(
+        make_unique<Column>(expr->value_type(), expr->value_length(), Column::DEFAULT_CAPACITY, true /*nullable*/),
+        col_id++);
+  }
+  for (Expression *expr : aggregate_expressions_) {
+    auto    *aggregate_expr = static_cast<AggregateExpr *>(expr);
+    AttrType result_type;
+    int      result_len;
+    AggregateHashTable::aggregate_result_type(aggregate_expr->aggregate_type(),
+        aggregate_expr->child()->value_type(),
+        aggregate_expr->child()->value_length(),
+        result_type,
+        result_len);
+    output_chunk_.add_column(
+        make_unique<Column>(result_type, result_len, Column::DEFAULT_CAPACITY, true /*nullable*/), col_id++);
+  }
+}
+
+RC GroupByVecPhysicalOperator::open(Trx *trx)
+{
+  ASSERT(children_.size() == 1, "group by operator only support one child, but got %d", children_.size());
+
+  PhysicalOperator &child = *children_[0];
+  RC                rc    = child.open(trx);
+  if (OB_FAIL(rc)) {
+    LOG_INFO("failed to open child operator. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  hash_table_ = make_unique<OpenAddressingAggregateHashTable>(aggregate_expressions_);
+
+  while (OB_SUCC(rc = child.next(chunk_))) {
+    if (chunk_.selected_rows() == 0) {
+      continue;
+    }
+
+    Chunk groups_chunk;
+    Chunk aggrs_chunk;
+    for (size_t i = 0; i < group_by_exprs_.size(); i++) {
+      unique_ptr<Column> column;
+      if (OB_FAIL(rc = eval_column(*group_by_exprs_[i], chunk_, true /*expand_constant*/, column))) {
+        return rc;
+      }
+      groups_chunk.add_column(std::move(column), i);
+    }
+    for (size_t i = 0; i < value_expressions_.size(); i++) {
+      unique_ptr<Column> column;
+      if (OB_FAIL(rc = eval_column(*value_expressions_[i], chunk_, false /*expand_constant*/, column))) {
+        return rc;
+      }
+      aggrs_chunk.add_column(std::move(column), i);
+    }
+
+    rc = hash_table_->add_chunk(groups_chunk, aggrs_chunk);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to add chunk to aggregate hash table. rc=%s", strrc(rc));
+      return rc;
+    }
+  }
+
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to get next chunk from child. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  scanner_ = make_unique<OpenAddressingAggregateHashTable::Scanner>(hash_table_.get());
+  scanner_->open_scan();
+  return RC::SUCCESS;
+}
+
+RC GroupByVecPhysicalOperator::eval_column(
+    Expression &expr, Chunk &chunk, bool expand_constant, unique_ptr<Column> &column)
+{
+  column = make_unique<Column>();
+  RC rc  = expr.get_column(chunk, *column);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to get column of expression. expr=%s, rc=%s", expr.name(), strrc(rc));
+    return rc;
+  }
+
+  const bool is_constant = column->column_type() == Column::Type::CONSTANT_COLUMN;
+  if (is_constant ? !expand_constant : !chunk.has_selection()) {
+    return RC::SUCCESS;
+  }
+
+  // 常量列展开成有效行数那么多行；有选择向量时只收集有效的行，哈希表处理的总是连续的行
+  const int rows      = chunk.selected_rows();
+  auto compacted = make_unique<Column>(column->attr_type(), column->attr_len(), max(rows, 1), column->nullable());
+  rc                  = compacted->append_selected(*column, chunk.selection().data(), rows);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to compact column of expression. expr=%s, rc=%s", expr.name(), strrc(rc));
+    return rc;
+  }
+  column = std::move(compacted);
+  return RC::SUCCESS;
+}
+
+RC GroupByVecPhysicalOperator::next(Chunk &chunk)
+{
+  if (scanner_ == nullptr) {
+    return RC::RECORD_EOF;
+  }
+
+  output_chunk_.reset_data();
+  RC rc = scanner_->next(output_chunk_);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+  return chunk.reference(output_chunk_);
+}
+
+RC GroupByVecPhysicalOperator::close()
+{
+  if (scanner_ != nullptr) {
+    scanner_->close_scan();
+    scanner_.reset();
+  }
+  hash_table_.reset();
+  children_[0]->close();
+  LOG_INFO("close group by operator");
+  return RC::SUCCESS;
+}
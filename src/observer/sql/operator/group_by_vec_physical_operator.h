@@ -16,20 +16,38 @@ See the Mulan PSL v2 for more details. */
 /**
  * @brief Group By 物理算子(vectorized)
  * @ingroup PhysicalOperator
+ * @details open 时读取子算子的所有 chunk，按列计算 group by 表达式以及聚合函数的参数，写入哈希表；
+ * next 时从哈希表中扫描出聚合结果。输出的 chunk 中先是 group by 列，然后是聚合列，
+ * 与 LogicalPlanGenerator 中给表达式设置的 pos 一致。
  */
 class GroupByVecPhysicalOperator : public PhysicalOperator
 {
 public:
   GroupByVecPhysicalOperator(
-      std::vector<std::unique_ptr<Expression>> &&group_by_exprs, std::vector<Expression *> &&expressions) {};
+      std::vector<std::unique_ptr<Expression>> &&group_by_exprs, std::vector<Expression *> &&expressions);
 
   virtual ~GroupByVecPhysicalOperator() = default;
 
   PhysicalOperatorType type() const override { return PhysicalOperatorType::GROUP_BY_VEC; }
 
-  RC open(Trx *trx) override { return RC::UNIMPLEMENTED; }
-  RC next(Chunk &chunk) override { return RC::UNIMPLEMENTED; }
-  RC close() override { return RC::UNIMPLEMENTED; }
+  RC open(Trx *trx) override;
+  RC next(Chunk &chunk) override;
+  RC close() override;
 
 private:
+  /**
+   * @brief 计算表达式得到的列
+   * @details 常量列只有一个值，group by 列需要展开成 rows 行，哈希表按照 group by 列的行数处理。
+   * Chunk 有选择向量时，按列收集有效的行
+   */
+  RC eval_column(Expression &expr, Chunk &chunk, bool expand_constant, std::unique_ptr<Column> &column);
+
+private:
+  std::vector<std::unique_ptr<Expression>>     group_by_exprs_;
+  std::vector<Expression *>                    aggregate_expressions_;  /// 聚合表达式
+  std::vector<Expression *>                    value_expressions_;      /// 聚合函数的参数
+  std::unique_ptr<AggregateHashTable>          hash_table_;
+  std::unique_ptr<AggregateHashTable::Scanner> scanner_;
+  Chunk                                        chunk_;
+  Chunk                                        output_chunk_;
 };
\ No newline at end of file
@@ -0,0 +1,296 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#include "sql/operator/hash_join_physical_operator.h"
+
+#include <cstring>
+#include <string_view>
+
+using namespace std;
+
+size_t HashJoinPhysicalOperator::JoinKeyHash::operator()(const JoinKey &key) const
+{
+  size_t hash = 0;
+  for (const Value &value : key) {
+    size_t value_hash = 0;
+    switch (value.attr_type()) {
+      case AttrType::INTS: value_hash = std::hash<int>()(value.get_int()); break;
+      case AttrType::DATES: value_hash = std::hash<int>()(value.get_date()); break;
+      case AttrType::BOOLEANS: value_hash = std::hash<bool>()(value.get_boolean()); break;
+      case AttrType::CHARS: {
+        // CHARS 比较时只看第一个'\0'之前的内容
+        const char *data = value.data();
+        value_hash       = std::hash<string_view>()(string_view(data, strnlen(data, value.length())));
+      } break;
+      default: value_hash = std::hash<string>()(value.to_string()); break;
+    }
+    hash ^= value_hash + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  }
+  return hash;
+}
+
+bool HashJoinPhysicalOperator::JoinKeyEqual::operator()(const JoinKey &lhs, const JoinKey &rhs) const
+{
+  for (size_t i = 0; i < lhs.size(); i++) {
+    if (lhs[i].compare(rhs[i]) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+HashJoinPhysicalOperator::HashJoinPhysicalOperator(
+    vector<unique_ptr<Expression>> &&left_keys, vector<unique_ptr<Expression>> &&right_keys)
+    : left_keys_(std::move(left_keys)), right_keys_(std::move(right_keys))
+{
+  ASSERT(left_keys_.size() == right_keys_.size(), "hash join keys should be in pairs");
+}
+
+string HashJoinPhysicalOperator::param() const
+{
+  string str;
+  for (size_t i = 0; i < left_keys_.size(); i++) {
+    if (i > 0) {
+      str += " AND ";
+    }
+    str += left_keys_[i]->name();
+    str += "=";
+    str += right_keys_[i]->name();
+  }
+  return str;
+}
+
+RC HashJoinPhysicalOperator::open(Trx *trx)
+{
+  if (children_.size() != 2) {
+    LOG_WARN("hash join operator should have 2 children");
+    return RC::INTERNAL;
+  }
+
+  left_  = children_[0].get();
+  right_ = children_[1].get();
+
+  RC rc = left_->open(trx);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open left child. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  rc = right_->open(trx);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open right child. rc=%s", strrc(rc));
+    left_->close();
+    return rc;
+  }
+
+  // 两边交替读取，先读完的一边数据量更小
+  bool left_eof  = false;
+  bool right_eof = false;
+  while (!left_eof && !right_eof) {
+    rc = buffer_row(*left_, left_keys_, left_rows_);
+    if (rc == RC::RECORD_EOF) {
+      left_eof = true;
+    } else if (OB_FAIL(rc)) {
+      return rc;
+    }
+
+    rc = buffer_row(*right_, right_keys_, right_rows_);
+    if (rc == RC::RECORD_EOF) {
+      right_eof = true;
+    } else if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+
+  build_left_       = left_eof;
+  probe_child_eof_  = build_left_ ? right_eof : left_eof;
+  probe_buffer_pos_ = 0;
+  probe_tuple_      = nullptr;
+
+  rc = build();
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  match_iter_ = match_end_ = hash_table_.end();
+  return RC::SUCCESS;
+}
+
+RC HashJoinPhysicalOperator::buffer_row(
+    PhysicalOperator &child, vector<unique_ptr<Expression>> &key_exprs, vector<BufferedRow> &rows)
+{
+  RC rc = child.next();
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  Tuple  *tuple    = child.current_tuple();
+  JoinKey key;
+  bool    has_null = false;
+  rc               = eval_key(key_exprs, *tuple, key, has_null);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  if (has_null) {
+    // 内连接中 NULL 不会与任何值相等，不需要保留
+    return RC::SUCCESS;
+  }
+
+  unique_ptr<Tuple> copy(tuple->copy());
+  auto              base_rids = tuple->base_rids();
+  copy->set_base_rids(base_rids);
+  rows.push_back(BufferedRow{std::move(key), std::move(copy)});
+  return RC::SUCCESS;
+}
+
+RC HashJoinPhysicalOperator::eval_key(
+    vector<unique_ptr<Expression>> &key_exprs, const Tuple &tuple, JoinKey &key, bool &has_null)
+{
+  key.clear();
+  key.reserve(key_exprs.size());
+  has_null = false;
+  for (unique_ptr<Expression> &expr : key_exprs) {
+    Value value;
+    RC    rc = expr->get_value(tuple, value);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get join key value. rc=%s", strrc(rc));
+      return rc;
+    }
+    if (value.is_null()) {
+      has_null = true;
+    }
+    key.emplace_back(std::move(value));
+  }
+  return RC::SUCCESS;
+}
+
+RC HashJoinPhysicalOperator::build()
+{
+  vector<BufferedRow> &build_rows = build_left_ ? left_rows_ : right_rows_;
+  hash_table_.reserve(build_rows.size());
+  for (BufferedRow &row : build_rows) {
+    hash_table_.emplace(row.key, row.tuple.get());
+  }
+  LOG_TRACE("hash join build on %s side with %zu rows", build_left_ ? "left" : "right", build_rows.size());
+  return RC::SUCCESS;
+}
+
+RC HashJoinPhysicalOperator::next_probe_tuple()
+{
+  vector<BufferedRow> &probe_rows = build_left_ ? right_rows_ : left_rows_;
+  if (probe_buffer_pos_ < probe_rows.size()) {
+    BufferedRow &row = probe_rows[probe_buffer_pos_++];
+    probe_tuple_     = row.tuple.get();
+    probe_key_       = row.key;
+    return RC::SUCCESS;
+  }
+
+  if (probe_child_eof_) {
+    return RC::RECORD_EOF;
+  }
+
+  PhysicalOperator               &probe_child = build_left_ ? *right_ : *left_;
+  vector<unique_ptr<Expression>> &probe_keys  = build_left_ ? right_keys_ : left_keys_;
+  while (true) {
+    RC rc = probe_child.next();
+    if (OB_FAIL(rc)) {
+      if (rc == RC::RECORD_EOF) {
+        probe_child_eof_ = true;
+      }
+      return rc;
+    }
+
+    Tuple *tuple    = probe_child.current_tuple();
+    bool   has_null = false;
+    rc              = eval_key(probe_keys, *tuple, probe_key_, has_null);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    if (!has_null) {
+      probe_tuple_ = tuple;
+      return RC::SUCCESS;
+    }
+  }
+}
+
+RC HashJoinPhysicalOperator::next()
+{
+  if (hash_table_.empty()) {
+    return RC::RECORD_EOF;
+  }
+
+  while (match_iter_ == match_end_) {
+    RC rc = next_probe_tuple();
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+
+    std::tie(match_iter_, match_end_) = hash_table_.equal_range(probe_key_);
+  }
+
+  Tuple *build_tuple = match_iter_->second;
+  ++match_iter_;
+  if (build_left_) {
+    joined_tuple_.set_left(build_tuple);
+    joined_tuple_.set_right(probe_tuple_);
+  } else {
+    joined_tuple_.set_left(probe_tuple_);
+    joined_tuple_.set_right(build_tuple);
+  }
+  return RC::SUCCESS;
+}
+
+RC HashJoinPhysicalOperator::close()
+{
+  RC rc = left_->close();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to close left oper. rc=%s", strrc(rc));
+  }
+
+  RC right_rc = right_->close();
+  if (OB_FAIL(right_rc)) {
+    LOG_WARN("failed to close right oper. rc=%s", strrc(right_rc));
+    rc = right_rc;
+  }
+
+  hash_table_.clear();
+  left_rows_.clear();
+  right_rows_.clear();
+  match_iter_ = match_end_ = hash_table_.end();
+  return rc;
+}
+
+Tuple *HashJoinPhysicalOperator::current_tuple()
+{
+  auto left_base_rids  = joined_tuple_.left_base_rids();
+  auto right_base_rids = joined_tuple_.right_base_rids();
+  left_base_rids.insert(left_base_rids.end(), right_base_rids.begin(), right_base_rids.end());
+  joined_tuple_.set_base_rids(left_base_rids);
+
+  return &joined_tuple_;
+}
+
+RC HashJoinPhysicalOperator::visit_expressions(const function<RC(unique_ptr<Expression> &)> &visitor)
+{
+  for (vector<unique_ptr<Expression>> *keys : {&left_keys_, &right_keys_}) {
+    for (unique_ptr<Expression> &expr : *keys) {
+      RC rc = visitor(expr);
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+    }
+  }
+  return RC::SUCCESS;
+}
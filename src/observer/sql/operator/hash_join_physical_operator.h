@@ -0,0 +1,105 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#pragma once
+
+#include <unordered_map>
+
+#include "sql/operator/physical_operator.h"
+
+/**
+ * @brief 基于等值条件的两表 hash join 算子
+ * @ingroup PhysicalOperator
+ * @details 每个等值条件 `left_keys_[i] = right_keys_[i]`，左边的表达式在左孩子的元组上求值，右边的在右孩子上。
+ * open 时交替地从左右两个孩子拉取数据，先读完的一边就是较小的输入，用它来建 hash 表，
+ * 另一边已经读出来的元组和后续的元组依次做探测。这样不需要统计信息也能保证在较小的一侧建表，
+ * 并且缓存的元组数量不会超过较小一侧的两倍。
+ * 连接键为 NULL 的元组不会匹配任何元组。
+ */
+class HashJoinPhysicalOperator : public PhysicalOperator
+{
+public:
+  HashJoinPhysicalOperator(
+      std::vector<std::unique_ptr<Expression>> &&left_keys, std::vector<std::unique_ptr<Expression>> &&right_keys);
+  virtual ~HashJoinPhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::HASH_JOIN; }
+
+  std::string param() const override;
+
+  RC     open(Trx *trx) override;
+  RC     next() override;
+  RC     close() override;
+  Tuple *current_tuple() override;
+
+  RC visit_expressions(const std::function<RC(std::unique_ptr<Expression> &)> &visitor) override;
+
+private:
+  using JoinKey = std::vector<Value>;
+
+  struct JoinKeyHash
+  {
+    size_t operator()(const JoinKey &key) const;
+  };
+
+  struct JoinKeyEqual
+  {
+    bool operator()(const JoinKey &lhs, const JoinKey &rhs) const;
+  };
+
+  /// 缓存下来的一行数据，拷贝自孩子算子的元组
+  struct BufferedRow
+  {
+    JoinKey                key;
+    std::unique_ptr<Tuple> tuple;
+  };
+
+  /**
+   * @brief 计算元组的连接键
+   * @param has_null 连接键中是否有 NULL 值，有的话这一行不会匹配任何行
+   */
+  RC eval_key(std::vector<std::unique_ptr<Expression>> &key_exprs, const Tuple &tuple, JoinKey &key, bool &has_null);
+
+  RC buffer_row(PhysicalOperator &child, std::vector<std::unique_ptr<Expression>> &key_exprs,
+      std::vector<BufferedRow> &rows);
+  RC build();
+
+  /// 取下一个探测元组，先消费 open 时读出来的缓存，然后再从探测侧的孩子算子读取
+  RC next_probe_tuple();
+
+private:
+  std::vector<std::unique_ptr<Expression>> left_keys_;
+  std::vector<std::unique_ptr<Expression>> right_keys_;
+
+  PhysicalOperator *left_  = nullptr;
+  PhysicalOperator *right_ = nullptr;
+
+  bool build_left_ = false;  ///< 是否在左孩子上建 hash 表
+
+  std::vector<BufferedRow> left_rows_;
+  std::vector<BufferedRow> right_rows_;
+
+  std::unordered_multimap<JoinKey, Tuple *, JoinKeyHash, JoinKeyEqual> hash_table_;
+
+  using MatchIterator = decltype(hash_table_)::iterator;
+
+  bool          probe_child_eof_ = false;  ///< 探测侧的孩子是否已经读完
+  size_t        probe_buffer_pos_ = 0;     ///< 下一个要使用的探测侧缓存元组
+  Tuple        *probe_tuple_      = nullptr;
+  JoinKey       probe_key_;
+  MatchIterator match_iter_;
+  MatchIterator match_end_;
+
+  JoinedTuple joined_tuple_;
+};
@@ -13,6 +13,7 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include "sql/operator/index_scan_physical_operator.h"
+#include "common/lang/algorithm.h"
 #include "storage/index/index.h"
 #include "storage/trx/trx.h"
 
@@ -47,6 +48,24 @@ RC IndexScanPhysicalOperator::open(Trx *trx)
     return RC::INTERNAL;
   }
 
+  record_handler_ = table_->record_handler();
+  if (nullptr == record_handler_) {
+    LOG_WARN("invalid record handler");
+    return RC::INTERNAL;
+  }
+
+  tuple_.set_schema(table_, table_->table_meta().field_metas());
+  trx_ = trx;
+
+  if (!key_exprs_.empty()) {
+    return fetch_key_list();
+  }
+
+  if (key_expr_ != nullptr) {
+    left_value_  = key_expr_->get_value();
+    right_value_ = key_expr_->get_value();
+  }
+
   IndexScanner *index_scanner = index_->create_scanner(left_value_.data(),
       left_value_.length(),
       left_inclusive_,
@@ -58,17 +77,55 @@ RC IndexScanPhysicalOperator::open(Trx *trx)
     return RC::INTERNAL;
   }
 
-  record_handler_ = table_->record_handler();
-  if (nullptr == record_handler_) {
-    LOG_WARN("invalid record handler");
-    index_scanner->destroy();
-    return RC::INTERNAL;
-  }
   index_scanner_ = index_scanner;
+  return RC::SUCCESS;
+}
 
-  tuple_.set_schema(table_, table_->table_meta().field_metas());
+RC IndexScanPhysicalOperator::fetch_key_list()
+{
+  const FieldMeta &field      = index_->index_meta().fields().front();
+  const int        key_length = index_->index_meta().fields_total_len();
+  const int        data_len   = field.len() - (field.nullable() ? 1 : 0);
+
+  // 键值的格式与记录中的字段一样，不是NULL的字段最后一个字节是0
+  std::vector<char> key_data(key_exprs_.size() * key_length, 0);
+  std::vector<const char *> keys;
+  for (const ValueExpr *key_expr : key_exprs_) {
+    const Value &value = key_expr->get_value();
+    if (value.is_null()) {
+      continue;  // NULL 不等于任何值
+    }
 
-  trx_ = trx;
+    Value real_value = value;
+    if (value.attr_type() != field.type()) {
+      RC rc = Value::cast_to(value, field.type(), real_value);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to cast value in list. value=%s, field=%s, rc=%s",
+            value.to_string().c_str(), field.name(), strrc(rc));
+        return rc;
+      }
+    }
+
+    char *key = key_data.data() + keys.size() * key_length;
+    memcpy(key, real_value.data(), std::min(real_value.length(), data_len));
+    keys.push_back(key);
+  }
+
+  std::vector<RID> rids;
+  RC               rc = index_->get_entries(keys, rids);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to get entries from index. index=%s, rc=%s", index_->index_meta().name(), strrc(rc));
+    return rc;
+  }
+
+  // 索引返回的RID已经按页面排序，每个页面只需要访问一次
+  rc = record_handler_->get_records(rids, records_);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to get records. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  record_index_ = 0;
   return RC::SUCCESS;
 }
 
@@ -78,6 +135,28 @@ RC IndexScanPhysicalOperator::next()
   RC  rc = RC::SUCCESS;
 
   bool filter_result = false;
+  if (!key_exprs_.empty()) {
+    while (record_index_ < records_.size()) {
+      current_record_ = std::move(records_[record_index_++]);
+      tuple_.set_record(&current_record_);
+      rc = filter(tuple_, filter_result);
+      if (OB_FAIL(rc)) {
+        LOG_TRACE("failed to filter record. rc=%s", strrc(rc));
+        return rc;
+      }
+
+      if (!filter_result) {
+        continue;
+      }
+
+      rc = trx_->visit_record(table_, current_record_, mode_);
+      if (rc != RC::RECORD_INVISIBLE) {
+        return rc;
+      }
+    }
+    return RC::RECORD_EOF;
+  }
+
   while (RC::SUCCESS == (rc = index_scanner_->next_entry(&rid))) {
     rc = record_handler_->get_record(rid, current_record_);
     if (OB_FAIL(rc)) {
@@ -113,8 +192,11 @@ RC IndexScanPhysicalOperator::next()
 
 RC IndexScanPhysicalOperator::close()
 {
-  index_scanner_->destroy();
-  index_scanner_ = nullptr;
+  if (index_scanner_ != nullptr) {
+    index_scanner_->destroy();
+    index_scanner_ = nullptr;
+  }
+  records_.clear();
   return RC::SUCCESS;
 }
 
@@ -154,3 +236,14 @@ std::string IndexScanPhysicalOperator::param() const
 {
   return std::string(index_->index_meta().name()) + " ON " + table_->name();
 }
+
+RC IndexScanPhysicalOperator::visit_expressions(const std::function<RC(std::unique_ptr<Expression> &)> &visitor)
+{
+  for (std::unique_ptr<Expression> &expr : predicates_) {
+    RC rc = visitor(expr);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
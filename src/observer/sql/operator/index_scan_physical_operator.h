@@ -36,6 +36,8 @@ public:
 
   PhysicalOperatorType type() const override { return PhysicalOperatorType::INDEX_SCAN; }
 
+  Table *table() const { return table_; }
+
   std::string param() const override;
 
   RC open(Trx *trx) override;
@@ -46,10 +48,31 @@ public:
 
   void set_predicates(std::vector<std::unique_ptr<Expression>> &&exprs);
 
+  /**
+   * @brief 设置索引查找使用的常量表达式
+   * @details 表达式属于 predicates_，open 时用它的值重新计算扫描范围，
+   * 这样执行计划缓存修改常量的值以后，同一个算子可以直接用新的值扫描索引
+   */
+  void set_key_expr(const ValueExpr *key_expr) { key_expr_ = key_expr; }
+
+  /**
+   * @brief 设置 IN 列表中的常量表达式
+   * @details 设置以后不再按范围扫描索引，而是把列表中所有的值一次交给索引批量查找，
+   * 再按照页面的顺序读取记录，每个页面只访问一次。表达式同样属于 predicates_，在 open 时取值
+   */
+  void set_key_exprs(std::vector<const ValueExpr *> key_exprs) { key_exprs_ = std::move(key_exprs); }
+
+  RC visit_expressions(const std::function<RC(std::unique_ptr<Expression> &)> &visitor) override;
+
 private:
   // 与TableScanPhysicalOperator代码相同，可以优化
   RC filter(RowTuple &tuple, bool &result);
 
+  /**
+   * @brief 批量查找 IN 列表中的所有值，并读取匹配的记录
+   */
+  RC fetch_key_list();
+
 private:
   Trx               *trx_            = nullptr;
   Table             *table_          = nullptr;
@@ -66,5 +89,11 @@ private:
   bool  left_inclusive_  = false;
   bool  right_inclusive_ = false;
 
+  const ValueExpr *key_expr_ = nullptr;
+
+  std::vector<const ValueExpr *> key_exprs_;
+  std::vector<Record>            records_;           ///< IN 列表批量查找到的记录
+  size_t                         record_index_ = 0;  ///< 下一个要返回的记录
+
   std::vector<std::unique_ptr<Expression>> predicates_;
 };
@@ -13,6 +13,7 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include "sql/operator/insert_physical_operator.h"
+#include "common/lang/defer.h"
 #include "sql/stmt/insert_stmt.h"
 #include "storage/table/table.h"
 #include "storage/trx/trx.h"
@@ -33,6 +34,9 @@ RC InsertPhysicalOperator::open(Trx *trx)
     }
   }
 
+  // 修改完成后递增版本号，让查询缓存中读过这张表的结果失效
+  DEFER(table_->increase_data_version());
+
   int size = static_cast<int>(records.size());
   for (int i = 0; i < size; ++i) {
     rc = trx->insert_record(table_, records[i]);
@@ -26,6 +26,8 @@ RC NestedLoopJoinPhysicalOperator::open(Trx *trx)
   RC rc         = RC::SUCCESS;
   left_         = children_[0].get();
   right_        = children_[1].get();
+  left_tuple_   = nullptr;
+  right_tuple_  = nullptr;
   right_closed_ = true;
   round_done_   = true;
 
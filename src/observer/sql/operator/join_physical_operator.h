@@ -35,6 +35,8 @@ public:
   RC     close() override;
   Tuple *current_tuple() override;
 
+  RC visit_expressions(const std::function<RC(std::unique_ptr<Expression> &)> &) override { return RC::SUCCESS; }
+
 private:
   RC left_next();   //! 左表遍历下一条数据
   RC right_next();  //! 右表遍历下一条数据，如果上一轮结束了就重新开始新的一轮
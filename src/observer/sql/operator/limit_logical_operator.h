@@ -19,12 +19,14 @@ See the Mulan PSL v2 for more details. */
 class LimitLogicalOperator : public LogicalOperator
 {
 public:
-  LimitLogicalOperator(int limit) : limit_(limit) {}
+  LimitLogicalOperator(int limit, int offset = 0) : limit_(limit), offset_(offset) {}
 
   LogicalOperatorType type() const override { return LogicalOperatorType::LIMIT; }
 
   int limit() const { return limit_; }
+  int offset() const { return offset_; }
 
 private:
   int limit_;
+  int offset_ = 0;
 };
\ No newline at end of file
@@ -10,13 +10,27 @@ See the Mulan PSL v2 for more details. */
 
 #include "limit_physical_operator.h"
 
-RC LimitPhysicalOperator::open(Trx *trx) { return children_[0]->open(trx); }
+RC LimitPhysicalOperator::open(Trx *trx)
+{
+  pos_ = 0;
+  return children_[0]->open(trx);
+}
 
 RC LimitPhysicalOperator::next()
 {
   if (pos_ == limit_) {
     return RC::RECORD_EOF;
   }
+
+  // 跳过 offset 行
+  if (pos_ == 0) {
+    for (int i = 0; i < offset_; i++) {
+      RC rc = children_[0]->next();
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+    }
+  }
   pos_++;
   return children_[0]->next();
 }
@@ -20,13 +20,14 @@ See the Mulan PSL v2 for more details. */
 class LimitPhysicalOperator : public PhysicalOperator
 {
 public:
-  LimitPhysicalOperator(int limit) : limit_(limit) {}
+  LimitPhysicalOperator(int limit, int offset = 0) : limit_(limit), offset_(offset) {}
 
   virtual ~LimitPhysicalOperator() = default;
 
   PhysicalOperatorType type() const override { return PhysicalOperatorType::LIMIT; }
 
   int limit() const { return limit_; }
+  int offset() const { return offset_; }
 
   RC open(Trx *trx) override;
   RC next() override;
@@ -34,7 +35,10 @@ public:
 
   Tuple *current_tuple() override;
 
+  RC visit_expressions(const std::function<RC(std::unique_ptr<Expression> &)> &) override { return RC::SUCCESS; }
+
 private:
   int pos_ = 0;
   int limit_;
+  int offset_ = 0;
 };
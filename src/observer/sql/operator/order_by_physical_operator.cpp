@@ -14,56 +14,171 @@ See the Mulan PSL v2 for more details. */
 
 #include "order_by_physical_operator.h"
 
+#include <algorithm>
+#include <atomic>
+#include <unistd.h>
 #include <utility>
 
-OrderByPhysicalOperator::OrderByPhysicalOperator(vector<OrderBySqlNode> order_by) : order_by_(std::move(order_by))
+#include "common/lang/filesystem.h"
+#include "sql/expr/sort_key.h"
+
+OrderByPhysicalOperator::OrderByPhysicalOperator(vector<OrderBySqlNode> order_by, int64_t memory_limit)
+    : order_by_(std::move(order_by)), memory_limit_(memory_limit)
 {
-  order_and_field_line = order_list([this](const order_line &cells_a, const order_line &cells_b) -> bool {
-    auto  order_size   = order_by_.size();
-    auto &order_line_a = cells_a.first;
-    auto &order_line_b = cells_b.first;
-    assert(order_line_a.size() == order_size);
-    assert(order_line_b.size() == order_size);
-    assert(order_by_.size() == order_size);
-
-    for (size_t i = 0; i < order_size; i++) {
-      auto &a      = order_line_a[i];
-      auto &b      = order_line_b[i];
-      auto  result = a.compare(b);
-      auto  is_asc = order_by_[i].is_asc;
-      if (result < 0) {
-        // a < b
-        return !is_asc;
-      } else if (result > 0) {
-        // a > 0
-        return is_asc;
-      }
+  merge_heap_ = decltype(merge_heap_)([](const MergeSource *a, const MergeSource *b) -> bool {
+    // 小顶堆，键相同时编号小的有序段优先，保证排序是稳定的
+    int result = a->key->compare(*b->key);
+    if (result != 0) {
+      return result > 0;
     }
-
-    // order_line_a == order_line_b
-    return true;
+    return a->index > b->index;
   });
 }
 
+OrderByPhysicalOperator::~OrderByPhysicalOperator() { clear(); }
+
+RC OrderByPhysicalOperator::make_key(const Tuple &tuple, string &key)
+{
+  key.clear();
+  for (auto &[expr, asc] : order_by_) {
+    Value cell;
+    RC    rc = expr->get_value(tuple, cell);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    SortKey::append(cell, asc, key);
+  }
+  return RC::SUCCESS;
+}
+
+void OrderByPhysicalOperator::sort_rows()
+{
+  std::stable_sort(
+      rows_.begin(), rows_.end(), [](const SortRow &a, const SortRow &b) -> bool { return a.key < b.key; });
+}
+
 RC OrderByPhysicalOperator::fetch_and_sort_tables()
 {
   RC rc = RC::SUCCESS;
 
   while (RC::SUCCESS == (rc = children_[0]->next())) {
-    // 获取 order by 字段的 values
-    vector<Value> order_by_line;
-    for (auto &[expr, asc] : order_by_) {
-      Value cell;
-      rc = expr->get_value(*children_[0]->current_tuple(), cell);
+    Tuple *tuple = children_[0]->current_tuple();
+
+    SortRow row;
+    rc = make_key(*tuple, row.key);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+
+    row.tuple.reset(tuple->copy());
+    memory_used_ += static_cast<int64_t>(row.key.size()) + estimate_tuple_memory(*tuple);
+    rows_.emplace_back(std::move(row));
+
+    if (memory_used_ > memory_limit_) {
+      rc = spill();
       if (OB_FAIL(rc)) {
+        LOG_WARN("failed to spill sort rows to disk. rc=%s", strrc(rc));
         return rc;
       }
-      order_by_line.emplace_back(cell);
     }
+  }
 
-    order_and_field_line.emplace(order_by_line, children_[0]->current_tuple()->copy());
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to fetch tuple from child. rc=%s", strrc(rc));
+    return rc;
   }
 
+  sort_rows();
+  if (!run_files_.empty()) {
+    return init_merge();
+  }
+  return RC::SUCCESS;
+}
+
+RC OrderByPhysicalOperator::spill()
+{
+  sort_rows();
+
+  static std::atomic<uint64_t> run_sequence{0};
+
+  string file_name = (filesystem::temp_directory_path() / ("miniob_sort_" + std::to_string(getpid()) + "_" +
+                                                              std::to_string(run_sequence.fetch_add(1)) + ".run"))
+                         .string();
+
+  SortRunWriter writer;
+  RC            rc = writer.open(file_name, *rows_.front().tuple);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+  run_files_.push_back(file_name);
+
+  for (SortRow &row : rows_) {
+    rc = writer.write(row.key, *row.tuple);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+
+  rc = writer.close();
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  LOG_INFO("spill %zu sorted rows to %s. memory used=%lld", rows_.size(), file_name.c_str(), memory_used_);
+  rows_.clear();
+  memory_used_ = 0;
+  return RC::SUCCESS;
+}
+
+RC OrderByPhysicalOperator::init_merge()
+{
+  sources_.reserve(run_files_.size() + 1);
+  for (size_t i = 0; i < run_files_.size(); i++) {
+    auto reader = std::make_unique<SortRunReader>();
+    RC   rc     = reader->open(run_files_[i]);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+
+    sources_.push_back(MergeSource{i, nullptr, std::move(reader)});
+  }
+
+  if (!rows_.empty()) {
+    sources_.push_back(MergeSource{run_files_.size(), nullptr, nullptr});
+  }
+
+  for (MergeSource &source : sources_) {
+    if (source.reader) {
+      RC rc = advance(source);
+      if (rc == RC::RECORD_EOF) {
+        continue;
+      } else if (OB_FAIL(rc)) {
+        return rc;
+      }
+    } else {
+      row_pos_    = 0;
+      source.key = &rows_[row_pos_].key;
+    }
+    merge_heap_.push(&source);
+  }
+  return RC::SUCCESS;
+}
+
+RC OrderByPhysicalOperator::advance(MergeSource &source)
+{
+  if (source.reader) {
+    RC rc = source.reader->next();
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    source.key = &source.reader->key();
+    return RC::SUCCESS;
+  }
+
+  if (++row_pos_ >= rows_.size()) {
+    return RC::RECORD_EOF;
+  }
+  source.key = &rows_[row_pos_].key;
   return RC::SUCCESS;
 }
 
@@ -73,6 +188,8 @@ RC OrderByPhysicalOperator::open(Trx *trx)
   if (children_.size() != 1) {
     return RC::INTERNAL;
   }
+
+  clear();
   rc = children_[0]->open(trx);
   if (OB_FAIL(rc)) {
     return rc;
@@ -83,15 +200,71 @@ RC OrderByPhysicalOperator::open(Trx *trx)
 
 RC OrderByPhysicalOperator::next()
 {
-  if (order_and_field_line.empty()) {
+  if (run_files_.empty()) {
+    if (row_pos_ >= rows_.size()) {
+      return RC::RECORD_EOF;
+    }
+
+    tuple_ = rows_[row_pos_++].tuple.get();
+    return RC::SUCCESS;
+  }
+
+  // 上一次输出的数据在这次调用之前都必须有效，所以在这里才移动上一次输出的有序段
+  if (tuple_ != nullptr) {
+    MergeSource *last = merge_heap_.top();
+    merge_heap_.pop();
+
+    RC rc = advance(*last);
+    if (OB_SUCC(rc)) {
+      merge_heap_.push(last);
+    } else if (rc != RC::RECORD_EOF) {
+      return rc;
+    }
+  }
+
+  if (merge_heap_.empty()) {
+    tuple_ = nullptr;
     return RC::RECORD_EOF;
   }
 
-  tuple_ = order_and_field_line.top().second;
-  order_and_field_line.pop();
+  MergeSource *top = merge_heap_.top();
+  tuple_           = top->reader ? &top->reader->tuple() : rows_[row_pos_].tuple.get();
   return RC::SUCCESS;
 }
 
-RC OrderByPhysicalOperator::close() { return children_[0]->close(); }
+RC OrderByPhysicalOperator::close()
+{
+  clear();
+  return children_[0]->close();
+}
+
+void OrderByPhysicalOperator::clear()
+{
+  while (!merge_heap_.empty()) {
+    merge_heap_.pop();
+  }
+  sources_.clear();
+
+  for (const string &file_name : run_files_) {
+    PersistHandler().remove_file(file_name.c_str());
+  }
+  run_files_.clear();
+
+  rows_.clear();
+  memory_used_ = 0;
+  row_pos_     = 0;
+  tuple_       = nullptr;
+}
 
 Tuple *OrderByPhysicalOperator::current_tuple() { return tuple_; }
+
+RC OrderByPhysicalOperator::visit_expressions(const function<RC(unique_ptr<Expression> &)> &visitor)
+{
+  for (OrderBySqlNode &node : order_by_) {
+    RC rc = visitor(node.expr);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
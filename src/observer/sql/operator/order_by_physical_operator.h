@@ -12,18 +12,30 @@ See the Mulan PSL v2 for more details. */
 // Created by HuXin on 24-10-9.
 //
 
+#pragma once
+
+#include <memory>
+
 #include "sql/operator/physical_operator.h"
+#include "sql/operator/sort_run.h"
 #include "sql/expr/tuple.h"
 #include "sql/expr/expression_tuple.h"
 #include <functional>
 #include <queue>
 
+/**
+ * @brief 排序算子
+ * @ingroup PhysicalOperator
+ * @details 排序键使用 SortKey 编码成字节串，按字节比较。
+ * 缓存的数据超过内存限制(会话变量 sort_buffer_size)时，把内存中的数据排好序后写到临时文件中，
+ * 最后对所有的有序段(包括内存中剩余的数据)做多路归并。
+ */
 class OrderByPhysicalOperator : public PhysicalOperator
 {
 public:
-  OrderByPhysicalOperator(std::vector<OrderBySqlNode> order_by);
+  OrderByPhysicalOperator(std::vector<OrderBySqlNode> order_by, int64_t memory_limit = DEFAULT_MEMORY_LIMIT);
 
-  virtual ~OrderByPhysicalOperator() = default;
+  virtual ~OrderByPhysicalOperator();
 
   PhysicalOperatorType type() const override { return PhysicalOperatorType::ORDER_BY; }
 
@@ -36,13 +48,48 @@ public:
 
   Tuple *current_tuple() override;
 
+  RC visit_expressions(const std::function<RC(std::unique_ptr<Expression> &)> &visitor) override;
+
+  /// 写到临时文件中的有序段个数
+  size_t spilled_run_num() const { return run_files_.size(); }
+
+  static constexpr int64_t DEFAULT_MEMORY_LIMIT = 64 * 1024 * 1024;
+
+private:
+  struct SortRow
+  {
+    std::string            key;
+    std::unique_ptr<Tuple> tuple;
+  };
+
+  /// 归并时每个有序段的当前位置
+  struct MergeSource
+  {
+    size_t                         index;  ///< 有序段的编号，等于 run_files_.size() 时表示内存中的数据
+    const std::string             *key;
+    std::unique_ptr<SortRunReader> reader;
+  };
+
+  RC make_key(const Tuple &tuple, std::string &key);
+  void sort_rows();
+  RC spill();
+  RC init_merge();
+  RC advance(MergeSource &source);
+  void clear();
+
 private:
   std::vector<OrderBySqlNode> order_by_;
+  int64_t                     memory_limit_ = DEFAULT_MEMORY_LIMIT;
+
+  std::vector<SortRow> rows_;
+  int64_t              memory_used_ = 0;
+  size_t               row_pos_     = 0;
+
+  std::vector<std::string> run_files_;
+  std::vector<MergeSource> sources_;
 
-  using order_line = pair<vector<Value>, Tuple *>;
-  using order_func = std::function<bool(const order_line &, const order_line &)>;
-  using order_list = std::priority_queue<order_line, vector<order_line>, order_func>;
-  order_list order_and_field_line;
+  using merge_func = std::function<bool(const MergeSource *, const MergeSource *)>;
+  std::priority_queue<MergeSource *, std::vector<MergeSource *>, merge_func> merge_heap_;
 
   Tuple *tuple_ = nullptr;
 };
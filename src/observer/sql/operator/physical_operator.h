@@ -14,6 +14,7 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -43,6 +44,7 @@ enum class PhysicalOperatorType
   VIEW_SCAN,
   VECTOR_INDEX_SCAN,
   NESTED_LOOP_JOIN,
+  HASH_JOIN,
   EXPLAIN,
   PREDICATE,
   PREDICATE_VEC,
@@ -50,6 +52,7 @@ enum class PhysicalOperatorType
   PROJECT_VEC,
   CALC,
   STRING_LIST,
+  CACHED_RESULT,
   DELETE,
   INSERT,
   UPDATE,
@@ -58,6 +61,7 @@ enum class PhysicalOperatorType
   GROUP_BY_VEC,
   AGGREGATE_VEC,
   ORDER_BY,
+  TOP_N,
   LIMIT,
   EXPR_VEC,
 };
@@ -90,6 +94,17 @@ public:
 
   virtual RC tuple_schema(TupleSchema &schema) const { return RC::UNIMPLEMENTED; }
 
+  /**
+   * @brief 遍历当前算子持有的表达式(不包含子算子)
+   * @details 执行计划缓存通过这个接口找到计划中的常量，再次执行时替换成新的值。
+   * 没有实现这个接口的算子返回 UNIMPLEMENTED，包含这种算子的计划不会被缓存。
+   * 实现了这个接口的算子，需要保证 close 之后可以再次 open。
+   */
+  virtual RC visit_expressions(const std::function<RC(std::unique_ptr<Expression> &)> &visitor)
+  {
+    return RC::UNIMPLEMENTED;
+  }
+
   void add_child(std::unique_ptr<PhysicalOperator> oper) { children_.emplace_back(std::move(oper)); }
   void set_parent_tuple(const Tuple *tuple);
 
@@ -77,3 +77,8 @@ RC PredicatePhysicalOperator::close()
 Tuple *PredicatePhysicalOperator::current_tuple() { return children_[0]->current_tuple(); }
 
 RC PredicatePhysicalOperator::tuple_schema(TupleSchema &schema) const { return children_[0]->tuple_schema(schema); }
+
+RC PredicatePhysicalOperator::visit_expressions(const std::function<RC(std::unique_ptr<Expression> &)> &visitor)
+{
+  return visitor(expression_);
+}
@@ -40,6 +40,8 @@ public:
 
   RC tuple_schema(TupleSchema &schema) const override;
 
+  RC visit_expressions(const std::function<RC(std::unique_ptr<Expression> &)> &visitor) override;
+
 private:
   std::unique_ptr<Expression> expression_;
 };
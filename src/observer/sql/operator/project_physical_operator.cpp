@@ -70,3 +70,14 @@ RC ProjectPhysicalOperator::tuple_schema(TupleSchema &schema) const
   }
   return RC::SUCCESS;
 }
+
+RC ProjectPhysicalOperator::visit_expressions(const function<RC(unique_ptr<Expression> &)> &visitor)
+{
+  for (unique_ptr<Expression> &expr : expressions_) {
+    RC rc = visitor(expr);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
@@ -40,6 +40,8 @@ public:
 
   RC tuple_schema(TupleSchema &schema) const override;
 
+  RC visit_expressions(const std::function<RC(std::unique_ptr<Expression> &)> &visitor) override;
+
 private:
   std::vector<std::unique_ptr<Expression>>     expressions_;
   ExpressionTuple<std::unique_ptr<Expression>> tuple_;
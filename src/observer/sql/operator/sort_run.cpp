@@ -0,0 +1,288 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#include "sql/operator/sort_run.h"
+
+using namespace std;
+using namespace common;
+
+/// 临时文件读写时的缓冲区大小
+static constexpr int SORT_RUN_IO_SIZE = 64 * 1024;
+
+static void write_string(Serializer &serializer, const char *str)
+{
+  int32_t len = static_cast<int32_t>(strlen(str));
+  serializer.write_int32(len);
+  serializer.write(str, len);
+}
+
+SortRunWriter::~SortRunWriter() { close(); }
+
+RC SortRunWriter::open(const string &file_name, const Tuple &schema_tuple)
+{
+  RC rc = file_.create_file(file_name.c_str());
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to create sort run file. file=%s, rc=%s", file_name.c_str(), strrc(rc));
+    return rc;
+  }
+
+  rc = file_.open_file();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open sort run file. file=%s, rc=%s", file_name.c_str(), strrc(rc));
+    file_.remove_file();
+    return rc;
+  }
+  opened_ = true;
+
+  cell_num_ = schema_tuple.cell_num();
+  buffer_.write_int32(cell_num_);
+  for (int i = 0; i < cell_num_; i++) {
+    TupleCellSpec spec;
+    rc = schema_tuple.spec_at(i, spec);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get tuple cell spec. index=%d, rc=%s", i, strrc(rc));
+      return rc;
+    }
+    write_string(buffer_, spec.table_name());
+    write_string(buffer_, spec.field_name());
+    write_string(buffer_, spec.alias());
+  }
+  return RC::SUCCESS;
+}
+
+RC SortRunWriter::write(const string &key, const Tuple &tuple)
+{
+  buffer_.write_int32(static_cast<int32_t>(key.size()));
+  buffer_.write(key.data(), static_cast<int>(key.size()));
+
+  for (int i = 0; i < cell_num_; i++) {
+    Value value;
+    RC    rc = tuple.cell_at(i, value);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get tuple cell. index=%d, rc=%s", i, strrc(rc));
+      return rc;
+    }
+
+    buffer_.write_int32(static_cast<int32_t>(value.attr_type()));
+    const char is_null = value.is_null() ? 1 : 0;
+    buffer_.write(&is_null, 1);
+    if (value.is_null()) {
+      continue;
+    }
+
+    switch (value.attr_type()) {
+      case AttrType::BOOLEANS: {
+        buffer_.write_int32(value.get_boolean() ? 1 : 0);
+      } break;
+      case AttrType::CHARS:
+      case AttrType::TEXTS:
+      case AttrType::VECTORS: {
+        buffer_.write_int32(value.length());
+        buffer_.write(value.data(), value.length());
+      } break;
+      default: {
+        buffer_.write(value.data(), 4);
+      } break;
+    }
+  }
+
+  if (buffer_.size() >= SORT_RUN_IO_SIZE) {
+    return flush();
+  }
+  return RC::SUCCESS;
+}
+
+RC SortRunWriter::flush()
+{
+  if (buffer_.size() == 0) {
+    return RC::SUCCESS;
+  }
+
+  RC rc = file_.write_file(static_cast<int>(buffer_.size()), buffer_.data().data());
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to write sort run file. rc=%s", strrc(rc));
+    return rc;
+  }
+  buffer_.data().clear();
+  return RC::SUCCESS;
+}
+
+RC SortRunWriter::close()
+{
+  if (!opened_) {
+    return RC::SUCCESS;
+  }
+
+  opened_ = false;
+  RC rc   = flush();
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+  return file_.close_file();
+}
+
+SortRunReader::~SortRunReader() { close(); }
+
+RC SortRunReader::open(const string &file_name)
+{
+  RC rc = file_.open_file(file_name.c_str());
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open sort run file. file=%s, rc=%s", file_name.c_str(), strrc(rc));
+    return rc;
+  }
+  opened_ = true;
+
+  buffer_.resize(SORT_RUN_IO_SIZE);
+  buffer_pos_  = 0;
+  buffer_size_ = 0;
+  file_offset_ = 0;
+
+  int32_t cell_num = 0;
+  rc               = read_int32(cell_num);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  specs_.clear();
+  for (int32_t i = 0; i < cell_num; i++) {
+    string table_name, field_name, alias;
+    if (OB_FAIL(rc = read_string(table_name)) || OB_FAIL(rc = read_string(field_name)) ||
+        OB_FAIL(rc = read_string(alias))) {
+      return rc;
+    }
+    specs_.emplace_back(table_name.c_str(), field_name.c_str(), alias.c_str());
+  }
+  tuple_.set_names(specs_);
+  return RC::SUCCESS;
+}
+
+RC SortRunReader::read(char *data, int size)
+{
+  while (size > 0) {
+    if (buffer_pos_ == buffer_size_) {
+      int64_t read_size = 0;
+      RC      rc        = file_.read_at(file_offset_, static_cast<int>(buffer_.size()), buffer_.data(), &read_size);
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+      if (read_size <= 0) {
+        return RC::RECORD_EOF;
+      }
+      file_offset_ += read_size;
+      buffer_pos_  = 0;
+      buffer_size_ = static_cast<int>(read_size);
+    }
+
+    int copy_size = min(size, buffer_size_ - buffer_pos_);
+    memcpy(data, buffer_.data() + buffer_pos_, copy_size);
+    buffer_pos_ += copy_size;
+    data += copy_size;
+    size -= copy_size;
+  }
+  return RC::SUCCESS;
+}
+
+RC SortRunReader::read_int32(int32_t &value) { return read(reinterpret_cast<char *>(&value), sizeof(value)); }
+
+RC SortRunReader::read_string(string &str)
+{
+  int32_t len = 0;
+  RC      rc  = read_int32(len);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+  str.resize(len);
+  return read(str.data(), len);
+}
+
+RC SortRunReader::next()
+{
+  RC rc = read_string(key_);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  vector<Value> cells(specs_.size());
+  vector<char>  data;
+  for (Value &value : cells) {
+    int32_t type    = 0;
+    char    is_null = 0;
+    if (OB_FAIL(rc = read_int32(type)) || OB_FAIL(rc = read(&is_null, 1))) {
+      return rc;
+    }
+
+    const AttrType attr_type = static_cast<AttrType>(type);
+    if (is_null) {
+      value.set_type(attr_type);
+      value.set_null(true);
+      continue;
+    }
+
+    switch (attr_type) {
+      case AttrType::CHARS:
+      case AttrType::TEXTS:
+      case AttrType::VECTORS: {
+        int32_t len = 0;
+        if (OB_FAIL(rc = read_int32(len))) {
+          return rc;
+        }
+        data.resize(len + 1);
+        if (OB_FAIL(rc = read(data.data(), len))) {
+          return rc;
+        }
+        data[len] = '\0';
+        if (attr_type == AttrType::VECTORS) {
+          const float *begin = reinterpret_cast<const float *>(data.data());
+          value              = Value(vector<float>(begin, begin + len / sizeof(float)));
+        } else {
+          value.set_type(attr_type);
+          value.set_data(data.data(), len);
+        }
+      } break;
+      default: {
+        char buf[4];
+        if (OB_FAIL(rc = read(buf, sizeof(buf)))) {
+          return rc;
+        }
+        value.set_type(attr_type);
+        value.set_data(buf, sizeof(buf));
+      } break;
+    }
+  }
+
+  tuple_.set_cells(cells);
+  return RC::SUCCESS;
+}
+
+RC SortRunReader::close()
+{
+  if (!opened_) {
+    return RC::SUCCESS;
+  }
+  opened_ = false;
+  return file_.close_file();
+}
+
+int64_t estimate_tuple_memory(const Tuple &tuple)
+{
+  int64_t   size     = sizeof(Tuple);
+  const int cell_num = tuple.cell_num();
+  for (int i = 0; i < cell_num; i++) {
+    Value value;
+    if (OB_SUCC(tuple.cell_at(i, value))) {
+      size += sizeof(Value) + value.length();
+    }
+  }
+  return size;
+}
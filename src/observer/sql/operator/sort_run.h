@@ -0,0 +1,96 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "common/lang/serializer.h"
+#include "sql/expr/tuple.h"
+#include "storage/persist/persist.h"
+
+/**
+ * @brief 外部排序时写到临时文件中的一个有序段(run)
+ * @ingroup PhysicalOperator
+ * @details 文件格式：
+ * - 头部：列的个数，以及每一列的 TupleCellSpec(table_name, field_name, alias)
+ * - 每一行：排序键的长度和内容，然后是每一列的类型、是否为NULL、数据长度和数据
+ * 读回来的行使用 ValueListTuple 表示，与 HashGroupBy 缓存子算子的元组时的做法一样。
+ */
+class SortRunWriter
+{
+public:
+  SortRunWriter() = default;
+  ~SortRunWriter();
+
+  /**
+   * @brief 创建临时文件，并根据第一行数据写入列的描述
+   */
+  RC open(const std::string &file_name, const Tuple &schema_tuple);
+  RC write(const std::string &key, const Tuple &tuple);
+  RC close();
+
+private:
+  RC flush();
+
+private:
+  PersistHandler     file_;
+  bool               opened_ = false;
+  int                cell_num_ = 0;
+  common::Serializer buffer_;
+};
+
+class SortRunReader
+{
+public:
+  SortRunReader() = default;
+  ~SortRunReader();
+
+  RC open(const std::string &file_name);
+
+  /**
+   * @brief 读取下一行
+   * @return 读完时返回 RECORD_EOF
+   */
+  RC next();
+
+  const std::string &key() const { return key_; }
+  ValueListTuple    &tuple() { return tuple_; }
+
+  RC close();
+
+private:
+  RC read(char *data, int size);
+  RC read_int32(int32_t &value);
+  RC read_string(std::string &str);
+
+private:
+  PersistHandler file_;
+  bool           opened_ = false;
+
+  std::vector<char> buffer_;
+  int               buffer_pos_  = 0;
+  int               buffer_size_ = 0;
+  uint64_t          file_offset_ = 0;
+
+  std::vector<TupleCellSpec> specs_;
+  std::string                key_;
+  ValueListTuple             tuple_;
+};
+
+/**
+ * @brief 估算一个元组占用的内存大小，用于排序时的内存控制
+ */
+int64_t estimate_tuple_memory(const Tuple &tuple);
@@ -37,6 +37,13 @@ public:
   void set_predicates(std::vector<std::unique_ptr<Expression>> &&exprs);
   auto predicates() -> std::vector<std::unique_ptr<Expression>> & { return predicates_; }
 
+  /**
+   * @brief 查询中用到的字段，向量化扫描时只读取这些列
+   * @details 为空时读取所有字段
+   */
+  void set_projection(std::vector<int> &&field_ids) { projection_ = std::move(field_ids); }
+  auto projection() -> std::vector<int> & { return projection_; }
+
   std::string &table_alias() { return table_alias_; }
 
   std::vector<float> &base_vector() { return base_vector_; }
@@ -61,6 +68,9 @@ private:
   // 如果有多个表达式，他们的关系都是 AND
   std::vector<std::unique_ptr<Expression>> predicates_;
 
+  // 查询中用到的字段的 field_id，按照 field_id 排序
+  std::vector<int> projection_;
+
   // 向量索引参数
   Index             *index_ = nullptr;
   std::vector<float> base_vector_;  // 要比较的向量
@@ -71,6 +71,17 @@ void TableScanPhysicalOperator::set_predicates(vector<unique_ptr<Expression>> &&
   predicates_ = std::move(exprs);
 }
 
+RC TableScanPhysicalOperator::visit_expressions(const function<RC(unique_ptr<Expression> &)> &visitor)
+{
+  for (unique_ptr<Expression> &expr : predicates_) {
+    RC rc = visitor(expr);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
+
 RC TableScanPhysicalOperator::filter(RowTuple &tuple, bool &result)
 {
   RC          rc = RC::SUCCESS;
@@ -41,6 +41,8 @@ public:
 
   PhysicalOperatorType type() const override { return PhysicalOperatorType::TABLE_SCAN; }
 
+  Table *table() const { return table_; }
+
   RC open(Trx *trx) override;
   RC next() override;
   RC close() override;
@@ -49,6 +51,8 @@ public:
 
   void set_predicates(std::vector<std::unique_ptr<Expression>> &&exprs);
 
+  RC visit_expressions(const std::function<RC(std::unique_ptr<Expression> &)> &visitor) override;
+
 private:
   RC filter(RowTuple &tuple, bool &result);
 
@@ -9,61 +9,92 @@ MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
 #include "sql/operator/table_scan_vec_physical_operator.h"
+#include "common/lang/algorithm.h"
 #include "event/sql_debug.h"
 #include "storage/table/table.h"
 
 using namespace std;
 
-RC TableScanVecPhysicalOperator::open(Trx *trx)
+RC TableScanVecPhysicalOperator::open(Trx *trx) { return open_state(trx, state_, nullptr /*morsels*/); }
+
+RC TableScanVecPhysicalOperator::open_parallel(Trx *trx, int parallel_degree, vector<ScanState *> &states)
+{
+  morsels_ = make_unique<MorselQueue>();
+  parallel_states_.clear();
+  states.clear();
+  for (int i = 0; i < parallel_degree; i++) {
+    auto state = make_unique<ScanState>();
+    RC   rc    = open_state(trx, *state, morsels_.get());
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    states.push_back(state.get());
+    parallel_states_.push_back(std::move(state));
+  }
+  return RC::SUCCESS;
+}
+
+RC TableScanVecPhysicalOperator::open_state(Trx *trx, ScanState &state, MorselQueue *morsels)
 {
-  RC rc = table_->get_chunk_scanner(chunk_scanner_, trx, mode_);
+  RC rc = table_->get_chunk_scanner(state.chunk_scanner, trx, mode_, morsels);
   if (rc != RC::SUCCESS) {
     LOG_WARN("failed to get chunk scanner", strrc(rc));
     return rc;
   }
-  // TODO: don't need to fetch all columns from record manager
-  for (int i = 0; i < table_->table_meta().field_num(); ++i) {
-    all_columns_.add_column(
-        make_unique<Column>(*table_->table_meta().field(i)), table_->table_meta().field(i)->field_id());
-    filterd_columns_.add_column(
-        make_unique<Column>(*table_->table_meta().field(i)), table_->table_meta().field(i)->field_id());
+  // 每次读取一个页面中的所有记录，列的容量至少要能放下一个页面的记录
+  const TableMeta &table_meta  = table_->table_meta();
+  const int        record_size = max(table_meta.record_size(), 1);
+  const size_t     capacity = max(Column::DEFAULT_CAPACITY, static_cast<size_t>(BP_PAGE_DATA_SIZE / record_size));
+  // 只创建查询用到的列，ChunkFileScanner 只读取 Chunk 中的列
+  state.all_columns.reset();
+  for (int i = 0; i < table_meta.field_num(); ++i) {
+    const FieldMeta *field_meta = table_meta.field(i);
+    if (projection_.empty() || binary_search(projection_.begin(), projection_.end(), field_meta->field_id())) {
+      state.all_columns.add_column(make_unique<Column>(*field_meta, capacity), field_meta->field_id());
+    }
   }
   return rc;
 }
 
-RC TableScanVecPhysicalOperator::next(Chunk &chunk)
+RC TableScanVecPhysicalOperator::next(Chunk &chunk) { return parallel_next(state_, chunk); }
+
+RC TableScanVecPhysicalOperator::parallel_next(ScanState &state, Chunk &chunk)
 {
   RC rc = RC::SUCCESS;
 
-  all_columns_.reset_data();
-  filterd_columns_.reset_data();
-  if (OB_SUCC(rc = chunk_scanner_.next_chunk(all_columns_))) {
-    select_.assign(all_columns_.rows(), 1);
+  Chunk &all_columns = state.all_columns;
+  all_columns.reset_data();
+  while (OB_SUCC(rc = state.chunk_scanner.next_chunk(all_columns))) {
     if (predicates_.empty()) {
-      chunk.reference(all_columns_);
-    } else {
-      rc = filter(all_columns_);
-      if (rc != RC::SUCCESS) {
-        LOG_TRACE("filtered failed=%s", strrc(rc));
-        return rc;
-      }
-      // TODO: if all setted, it doesn't need to set one by one
-      for (int i = 0; i < all_columns_.rows(); i++) {
-        if (select_[i] == 0) {
-          continue;
-        }
-        for (int j = 0; j < all_columns_.column_num(); j++) {
-          filterd_columns_.column(j).append_one(
-              (char *)all_columns_.column(filterd_columns_.column_ids(j)).get_value(i).data());
-        }
-      }
-      chunk.reference(filterd_columns_);
+      break;
     }
+
+    state.select.assign(all_columns.rows(), 1);
+    rc = filter(state);
+    if (rc != RC::SUCCESS) {
+      LOG_TRACE("filtered failed=%s", strrc(rc));
+      return rc;
+    }
+
+    // 不复制满足条件的行，只记录选择向量，由下游算子按需收集。一行都不满足时直接读下一批
+    if (all_columns.set_selection(state.select) > 0) {
+      break;
+    }
+    all_columns.reset_data();
+  }
+
+  if (OB_SUCC(rc)) {
+    rc = chunk.reference(all_columns);
   }
   return rc;
 }
 
-RC TableScanVecPhysicalOperator::close() { return chunk_scanner_.close_scan(); }
+RC TableScanVecPhysicalOperator::close()
+{
+  parallel_states_.clear();
+  morsels_.reset();
+  return state_.chunk_scanner.close_scan();
+}
 
 string TableScanVecPhysicalOperator::param() const { return table_->name(); }
 
@@ -72,11 +103,11 @@ void TableScanVecPhysicalOperator::set_predicates(vector<unique_ptr<Expression>>
   predicates_ = std::move(exprs);
 }
 
-RC TableScanVecPhysicalOperator::filter(Chunk &chunk)
+RC TableScanVecPhysicalOperator::filter(ScanState &state)
 {
   RC rc = RC::SUCCESS;
   for (unique_ptr<Expression> &expr : predicates_) {
-    rc = expr->eval(chunk, select_);
+    rc = expr->eval(state.all_columns, state.select);
     if (rc != RC::SUCCESS) {
       return rc;
     }
@@ -20,9 +20,24 @@ class Table;
 /**
  * @brief 表扫描物理算子(vectorized)
  * @ingroup PhysicalOperator
+ * @details 除了普通的 open/next，还可以打开一个并行扫描：文件的页面切分成多个 morsel(参考 MorselQueue)，
+ * 每个线程使用自己的 ScanState 领取页面并读取数据，由上层算子(比如 AggregateVecPhysicalOperator)
+ * 在每个线程中完成过滤和部分聚合，最后再合并。
  */
 class TableScanVecPhysicalOperator : public PhysicalOperator
 {
+public:
+  /**
+   * @brief 一个扫描的状态
+   * @details 并行扫描时每个线程使用自己的状态。过滤条件在线程之间共享，向量化的 eval 不会修改表达式
+   */
+  struct ScanState
+  {
+    ChunkFileScanner     chunk_scanner;
+    Chunk                all_columns;
+    std::vector<uint8_t> select;
+  };
+
 public:
   TableScanVecPhysicalOperator(Table *table, ReadWriteMode mode) : table_(table), mode_(mode) {}
 
@@ -32,21 +47,44 @@ public:
 
   PhysicalOperatorType type() const override { return PhysicalOperatorType::TABLE_SCAN_VEC; }
 
+  Table *table() const { return table_; }
+
   RC open(Trx *trx) override;
   RC next(Chunk &chunk) override;
   RC close() override;
 
+  /**
+   * @brief 打开一个并行扫描
+   * @details 返回的状态由算子持有，在 close 时释放。每个状态同一时间只能由一个线程使用
+   * @param parallel_degree 并行度，也就是状态的个数
+   * @param[out] states 每个线程使用的状态
+   */
+  RC open_parallel(Trx *trx, int parallel_degree, std::vector<ScanState *> &states);
+
+  /**
+   * @brief 使用指定的状态读取下一批数据
+   * @details 不同的线程可以同时使用不同的状态读取数据
+   */
+  RC parallel_next(ScanState &state, Chunk &chunk);
+
   void set_predicates(std::vector<std::unique_ptr<Expression>> &&exprs);
 
+  /**
+   * @brief 设置需要读取的字段
+   * @details 输出的 Chunk 只包含这些字段，列的 id 是字段的 field_id。为空时读取所有字段
+   */
+  void set_projection(std::vector<int> &&field_ids) { projection_ = std::move(field_ids); }
+
 private:
-  RC filter(Chunk &chunk);
+  RC open_state(Trx *trx, ScanState &state, MorselQueue *morsels);
+  RC filter(ScanState &state);
 
 private:
   Table                                   *table_ = nullptr;
   ReadWriteMode                            mode_  = ReadWriteMode::READ_WRITE;
-  ChunkFileScanner                         chunk_scanner_;
-  Chunk                                    all_columns_;
-  Chunk                                    filterd_columns_;
-  std::vector<uint8_t>                     select_;
+  std::vector<int>                         projection_;
   std::vector<std::unique_ptr<Expression>> predicates_;
+  ScanState                                state_;
+  std::unique_ptr<MorselQueue>             morsels_;          ///< 并行扫描时切分的页面
+  std::vector<std::unique_ptr<ScanState>>  parallel_states_;  ///< 并行扫描时每个线程的状态
 };
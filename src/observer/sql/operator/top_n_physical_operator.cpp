@@ -0,0 +1,145 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#include "sql/operator/top_n_physical_operator.h"
+
+#include <algorithm>
+
+#include "common/log/log.h"
+#include "sql/expr/sort_key.h"
+
+TopNPhysicalOperator::TopNPhysicalOperator(vector<OrderBySqlNode> order_by, int limit, int offset)
+    : order_by_(std::move(order_by)), limit_(limit), offset_(offset)
+{}
+
+string TopNPhysicalOperator::param() const
+{
+  return "limit=" + std::to_string(limit_) + ", offset=" + std::to_string(offset_);
+}
+
+RC TopNPhysicalOperator::make_key(const Tuple &tuple, string &key)
+{
+  key.clear();
+  for (auto &[expr, asc] : order_by_) {
+    Value cell;
+    RC    rc = expr->get_value(tuple, cell);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    SortKey::append(cell, asc, key);
+  }
+  return RC::SUCCESS;
+}
+
+RC TopNPhysicalOperator::fetch_top_n()
+{
+  const size_t capacity = static_cast<size_t>(limit_) + static_cast<size_t>(offset_);
+  if (capacity == 0) {
+    return RC::SUCCESS;
+  }
+
+  PhysicalOperator *child = children_[0].get();
+
+  RC       rc  = RC::SUCCESS;
+  uint64_t seq = 0;
+  TopNRow  candidate;
+  while (OB_SUCC(rc = child->next())) {
+    Tuple *tuple = child->current_tuple();
+
+    candidate.seq = seq++;
+    rc            = make_key(*tuple, candidate.key);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to make sort key. rc=%s", strrc(rc));
+      return rc;
+    }
+
+    if (rows_.size() < capacity) {
+      candidate.tuple.reset(tuple->copy());
+      rows_.emplace_back(std::move(candidate));
+      std::push_heap(rows_.begin(), rows_.end());
+      continue;
+    }
+
+    // 堆已满，只有比堆顶(当前保留的最大的一行)小的行才需要拷贝
+    if (!(candidate < rows_.front())) {
+      continue;
+    }
+
+    std::pop_heap(rows_.begin(), rows_.end());
+    TopNRow &last = rows_.back();
+    last.key.swap(candidate.key);
+    last.seq = candidate.seq;
+    last.tuple.reset(tuple->copy());
+    std::push_heap(rows_.begin(), rows_.end());
+  }
+
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to fetch tuple from child. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  std::sort_heap(rows_.begin(), rows_.end());
+  return RC::SUCCESS;
+}
+
+RC TopNPhysicalOperator::open(Trx *trx)
+{
+  if (children_.size() != 1) {
+    LOG_WARN("top n operator must has one child");
+    return RC::INTERNAL;
+  }
+
+  rows_.clear();
+  row_pos_ = static_cast<size_t>(offset_);
+  tuple_   = nullptr;
+
+  RC rc = children_[0]->open(trx);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open child operator. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  return fetch_top_n();
+}
+
+RC TopNPhysicalOperator::next()
+{
+  if (row_pos_ >= rows_.size()) {
+    tuple_ = nullptr;
+    return RC::RECORD_EOF;
+  }
+
+  tuple_ = rows_[row_pos_++].tuple.get();
+  return RC::SUCCESS;
+}
+
+RC TopNPhysicalOperator::close()
+{
+  rows_.clear();
+  tuple_ = nullptr;
+  return children_[0]->close();
+}
+
+Tuple *TopNPhysicalOperator::current_tuple() { return tuple_; }
+
+RC TopNPhysicalOperator::visit_expressions(const function<RC(unique_ptr<Expression> &)> &visitor)
+{
+  for (OrderBySqlNode &node : order_by_) {
+    RC rc = visitor(node.expr);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
@@ -0,0 +1,75 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#pragma once
+
+#include <memory>
+
+#include "sql/operator/physical_operator.h"
+
+/**
+ * @brief ORDER BY ... LIMIT count OFFSET offset 合并后的算子
+ * @ingroup PhysicalOperator
+ * @details 只需要排序结果的前 offset + count 行，所以用一个大小为 offset + count 的大顶堆
+ * 保存当前最小的若干行，新来的行比堆顶小时替换堆顶，内存中最多只保留 offset + count 个元组。
+ * 子算子读完后对堆中的数据排序，跳过前 offset 行输出。
+ * 排序键与 OrderByPhysicalOperator 一样使用 SortKey 编码，键相同时先读到的行排在前面。
+ */
+class TopNPhysicalOperator : public PhysicalOperator
+{
+public:
+  TopNPhysicalOperator(std::vector<OrderBySqlNode> order_by, int limit, int offset);
+  virtual ~TopNPhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::TOP_N; }
+
+  std::string param() const override;
+
+  int limit() const { return limit_; }
+  int offset() const { return offset_; }
+
+  RC open(Trx *trx) override;
+  RC next() override;
+  RC close() override;
+
+  Tuple *current_tuple() override;
+
+  RC visit_expressions(const std::function<RC(std::unique_ptr<Expression> &)> &visitor) override;
+
+private:
+  struct TopNRow
+  {
+    std::string            key;
+    uint64_t               seq;  ///< 读取的顺序，键相同时保证排序稳定
+    std::unique_ptr<Tuple> tuple;
+
+    bool operator<(const TopNRow &other) const
+    {
+      int result = key.compare(other.key);
+      return result != 0 ? result < 0 : seq < other.seq;
+    }
+  };
+
+  RC make_key(const Tuple &tuple, std::string &key);
+  RC fetch_top_n();
+
+private:
+  std::vector<OrderBySqlNode> order_by_;
+  int                         limit_  = 0;
+  int                         offset_ = 0;
+
+  std::vector<TopNRow> rows_;  ///< 读数据时是一个大顶堆，读完后是有序的
+  size_t               row_pos_ = 0;
+  Tuple               *tuple_   = nullptr;
+};
@@ -11,6 +11,7 @@
  ***************************************************************/
 
 #include "update_physical_operator.h"
+#include "common/lang/defer.h"
 #include "storage/trx/trx.h"
 
 RC UpdatePhysicalOperator::open(Trx *trx)
@@ -120,6 +121,9 @@ RC UpdatePhysicalOperator::open(Trx *trx)
     real_values[i] = std::move(value);
   }
 
+  // 修改完成后递增版本号，让查询缓存中读过这张表的结果失效
+  DEFER(table_->increase_data_version());
+
   // 先收集记录再更新
   // 记录的有效性由事务来保证，如果事务不保证删除的有效性，那说明此事务类型不支持并发控制，比如VacuousTrx
   Record new_record;
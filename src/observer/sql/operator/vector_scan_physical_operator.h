@@ -32,6 +32,8 @@ public:
 
   PhysicalOperatorType type() const override { return PhysicalOperatorType::VECTOR_INDEX_SCAN; }
 
+  Table *table() const { return table_; }
+
   std::string param() const override;
 
   RC open(Trx *trx) override;
@@ -0,0 +1,175 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#include "sql/optimizer/join_predicate_pushdown_rewriter.h"
+#include "common/lang/string.h"
+#include "common/log/log.h"
+#include "sql/expr/expression.h"
+#include "sql/operator/logical_operator.h"
+#include "sql/operator/table_get_logical_operator.h"
+
+using namespace std;
+
+RC JoinPredicatePushdownRewriter::rewrite(unique_ptr<LogicalOperator> &oper, bool &change_made)
+{
+  RC rc = RC::SUCCESS;
+  if (oper->type() != LogicalOperatorType::PREDICATE) {
+    return rc;
+  }
+
+  if (oper->children().size() != 1 || oper->children().front()->type() != LogicalOperatorType::JOIN) {
+    return rc;
+  }
+
+  vector<unique_ptr<Expression>> &predicate_oper_exprs = oper->expressions();
+  if (predicate_oper_exprs.size() != 1 || predicate_oper_exprs.front()->type() != ExprType::CONJUNCTION) {
+    return rc;
+  }
+
+  auto conjunction_expr = static_cast<ConjunctionExpr *>(predicate_oper_exprs.front().get());
+  if (conjunction_expr->conjunction_type() != ConjunctionExpr::Type::AND) {
+    return rc;
+  }
+
+  LogicalOperator                &join_oper   = *oper->children().front();
+  vector<unique_ptr<Expression>> &child_exprs = conjunction_expr->children();
+  for (auto iter = child_exprs.begin(); iter != child_exprs.end();) {
+    if (try_pushdown(join_oper, *iter)) {
+      change_made = true;
+      iter        = child_exprs.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+
+  if (child_exprs.empty()) {
+    // 与 PredicatePushdownRewriter 一样，谓词算子没办法删除，放一个恒为真的表达式
+    Value value((bool)true);
+    predicate_oper_exprs.front() = make_unique<ValueExpr>(value);
+  }
+  return rc;
+}
+
+bool JoinPredicatePushdownRewriter::is_hash_join_key(AttrType left_type, AttrType right_type)
+{
+  if (left_type != right_type) {
+    return false;
+  }
+
+  switch (left_type) {
+    case AttrType::INTS:
+    case AttrType::CHARS:
+    case AttrType::DATES:
+    case AttrType::BOOLEANS: return true;
+    default: return false;
+  }
+}
+
+bool JoinPredicatePushdownRewriter::try_pushdown(LogicalOperator &join_oper, unique_ptr<Expression> &expr)
+{
+  if (expr->type() != ExprType::COMPARISON) {
+    return false;
+  }
+
+  auto comparison_expr = static_cast<ComparisonExpr *>(expr.get());
+  if (comparison_expr->comp() != EQUAL_TO) {
+    return false;
+  }
+
+  unique_ptr<Expression> &left_expr  = comparison_expr->left();
+  unique_ptr<Expression> &right_expr = comparison_expr->right();
+  if (left_expr->type() != ExprType::FIELD || right_expr->type() != ExprType::FIELD) {
+    return false;
+  }
+
+  if (!is_hash_join_key(left_expr->value_type(), right_expr->value_type())) {
+    return false;
+  }
+
+  auto left_field  = static_cast<FieldExpr *>(left_expr.get());
+  auto right_field = static_cast<FieldExpr *>(right_expr.get());
+
+  // 左深树，从最上层的join开始，找到第一个能把两个字段分到左右两边的join
+  LogicalOperator *current = &join_oper;
+  while (current != nullptr && current->type() == LogicalOperatorType::JOIN) {
+    LogicalOperator *left_child  = current->children()[0].get();
+    LogicalOperator *right_child = current->children()[1].get();
+
+    vector<TableGetLogicalOperator *> left_tables;
+    vector<TableGetLogicalOperator *> right_tables;
+    collect_tables(*left_child, left_tables);
+    collect_tables(*right_child, right_tables);
+
+    const bool left_in_left   = belongs_to(*left_field, left_tables);
+    const bool left_in_right  = belongs_to(*left_field, right_tables);
+    const bool right_in_left  = belongs_to(*right_field, left_tables);
+    const bool right_in_right = belongs_to(*right_field, right_tables);
+
+    if (left_in_left && left_in_right) {
+      // 自连接但是没有别名，无法区分字段属于哪一边
+      return false;
+    }
+    if (right_in_left && right_in_right) {
+      return false;
+    }
+
+    if (left_in_left && right_in_right) {
+      current->expressions().emplace_back(std::move(expr));
+      return true;
+    }
+
+    if (left_in_right && right_in_left) {
+      // 等值比较是对称的，交换一下，让左边的表达式对应左孩子
+      std::swap(left_expr, right_expr);
+      current->expressions().emplace_back(std::move(expr));
+      return true;
+    }
+
+    if (left_in_left && right_in_left) {
+      current = left_child;
+    } else if (left_in_right && right_in_right) {
+      current = right_child;
+    } else {
+      return false;
+    }
+  }
+  return false;
+}
+
+void JoinPredicatePushdownRewriter::collect_tables(LogicalOperator &oper, vector<TableGetLogicalOperator *> &tables)
+{
+  if (oper.type() == LogicalOperatorType::TABLE_GET) {
+    tables.push_back(static_cast<TableGetLogicalOperator *>(&oper));
+    return;
+  }
+
+  for (unique_ptr<LogicalOperator> &child : oper.children()) {
+    collect_tables(*child, tables);
+  }
+}
+
+bool JoinPredicatePushdownRewriter::belongs_to(
+    const FieldExpr &field_expr, const vector<TableGetLogicalOperator *> &tables)
+{
+  const char *alias = field_expr.table_alias();
+  for (TableGetLogicalOperator *table_get : tables) {
+    if (0 != strcmp(field_expr.table_name(), table_get->table()->name())) {
+      continue;
+    }
+    if (common::is_blank(alias) || table_get->table_alias() == alias) {
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,55 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#pragma once
+
+#include <vector>
+
+#include "common/type/attr_type.h"
+#include "sql/optimizer/rewrite_rule.h"
+
+class FieldExpr;
+class TableGetLogicalOperator;
+
+/**
+ * @brief 将连接上的等值条件从谓词算子下推到连接算子中
+ * @ingroup Rewriter
+ * @details 只下推形如 `t1.a = t2.b` 的条件，并且两边的字段分别来自连接的左右两侧。
+ * 下推之后，比较表达式的左边总是对应连接的左孩子，右边对应右孩子。
+ * 物理计划生成时，带有等值条件的连接会使用 HashJoin，否则仍然使用 NestedLoopJoin。
+ */
+class JoinPredicatePushdownRewriter : public RewriteRule
+{
+public:
+  JoinPredicatePushdownRewriter()          = default;
+  virtual ~JoinPredicatePushdownRewriter() = default;
+
+  RC rewrite(std::unique_ptr<LogicalOperator> &oper, bool &change_made) override;
+
+  /**
+   * @brief 判断一个等值条件能否作为 hash join 的连接键
+   * @details 浮点数比较时带有误差，无法保证相等的值哈希值也相等，因此不作为连接键
+   */
+  static bool is_hash_join_key(AttrType left_type, AttrType right_type);
+
+private:
+  /**
+   * @brief 尝试把一个表达式下推到 join 算子或其子孙 join 算子中
+   * @param expr 如果下推成功，expr 会被置空
+   */
+  bool try_pushdown(LogicalOperator &join_oper, std::unique_ptr<Expression> &expr);
+
+  static void collect_tables(LogicalOperator &oper, std::vector<TableGetLogicalOperator *> &tables);
+  static bool belongs_to(const FieldExpr &field_expr, const std::vector<TableGetLogicalOperator *> &tables);
+};
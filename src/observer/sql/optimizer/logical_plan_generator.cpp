@@ -181,7 +181,7 @@ RC LogicalPlanGenerator::create_plan(SelectStmt *select_stmt, unique_ptr<Logical
   }
 
   if (select_stmt->limit() != -1) {
-    unique_ptr<LimitLogicalOperator> limit_oper = std::make_unique<LimitLogicalOperator>(select_stmt->limit());
+    unique_ptr<LimitLogicalOperator> limit_oper = std::make_unique<LimitLogicalOperator>(select_stmt->limit(), select_stmt->offset());
     if (*last_oper) {
       limit_oper->add_child(std::move(*last_oper));
     }
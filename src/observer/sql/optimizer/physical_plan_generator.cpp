@@ -14,7 +14,10 @@ See the Mulan PSL v2 for more details. */
 
 #include <utility>
 
+#include "common/lang/map.h"
+#include "common/lang/set.h"
 #include "common/log/log.h"
+#include "session/session.h"
 #include "sql/expr/expression.h"
 #include "sql/operator/aggregate_vec_physical_operator.h"
 #include "sql/operator/calc_logical_operator.h"
@@ -25,6 +28,7 @@ See the Mulan PSL v2 for more details. */
 #include "sql/operator/explain_physical_operator.h"
 #include "sql/operator/expr_vec_physical_operator.h"
 #include "sql/operator/group_by_vec_physical_operator.h"
+#include "sql/operator/hash_join_physical_operator.h"
 #include "sql/operator/index_scan_physical_operator.h"
 #include "sql/operator/order_by_logical_operator.h"
 #include "sql/operator/limit_logical_operator.h"
@@ -40,6 +44,7 @@ See the Mulan PSL v2 for more details. */
 #include "sql/operator/project_vec_physical_operator.h"
 #include "sql/operator/table_get_logical_operator.h"
 #include "sql/operator/table_scan_physical_operator.h"
+#include "sql/operator/top_n_physical_operator.h"
 #include "sql/operator/order_by_physical_operator.h"
 #include "sql/operator/group_by_logical_operator.h"
 #include "sql/operator/group_by_physical_operator.h"
@@ -52,6 +57,7 @@ See the Mulan PSL v2 for more details. */
 #include "sql/operator/view_scan_physical_operator.h"
 
 #include <sql/operator/vector_scan_physical_operator.h>
+#include "sql/expr/expression_iterator.h"
 
 using namespace std;
 
@@ -150,6 +156,8 @@ RC PhysicalPlanGenerator::create_plan(TableGetLogicalOperator &table_get_oper, u
   ValueExpr *value_expr = nullptr;
   Table     *table      = nullptr;
 
+  vector<const ValueExpr *> key_exprs;  // 可以批量查找索引的 IN 列表
+
   if (base_table->type() == TableType::Table) {
     table = dynamic_cast<Table *>(base_table);
 
@@ -206,9 +214,62 @@ RC PhysicalPlanGenerator::create_plan(TableGetLogicalOperator &table_get_oper, u
         }
       }
     }
+
+    // 没有可用的等值条件时，看看有没有常量组成的 IN 列表，可以把所有的值一次交给索引查找
+    for (auto &expr : predicates) {
+      if (index != nullptr) {
+        break;
+      }
+      if (expr->type() != ExprType::COMPARISON) {
+        continue;
+      }
+
+      auto comparison_expr = static_cast<ComparisonExpr *>(expr.get());
+      if (comparison_expr->comp() != IN_OP || comparison_expr->left()->type() != ExprType::FIELD ||
+          comparison_expr->right()->type() != ExprType::EXPRLIST) {
+        continue;
+      }
+
+      // 只处理在记录中定长存放的类型，这些类型的值可以直接作为索引的键值
+      const Field &field = static_cast<FieldExpr *>(comparison_expr->left().get())->field();
+      AttrType     type  = field.attr_type();
+      if (type != AttrType::INTS && type != AttrType::FLOATS && type != AttrType::DATES && type != AttrType::CHARS) {
+        continue;
+      }
+
+      vector<const ValueExpr *> list_values;
+      for (unique_ptr<Expression> &item : static_cast<ListExpr *>(comparison_expr->right().get())->get_list()) {
+        if (item->type() != ExprType::VALUE || static_cast<ValueExpr *>(item.get())->get_value().attr_type() != type) {
+          list_values.clear();
+          break;
+        }
+        list_values.push_back(static_cast<ValueExpr *>(item.get()));
+      }
+
+      if (!list_values.empty()) {
+        index = table->find_index_by_field(field.field_name());
+        if (index != nullptr) {
+          key_exprs = std::move(list_values);
+        }
+      }
+    }
   }
 
-  if (index != nullptr) {
+  if (index != nullptr && !key_exprs.empty()) {
+    IndexScanPhysicalOperator *index_scan_oper = new IndexScanPhysicalOperator(table,
+        std::move(table_get_oper.table_alias()),
+        index,
+        table_get_oper.read_write_mode(),
+        nullptr /*left_value*/,
+        true /*left_inclusive*/,
+        nullptr /*right_value*/,
+        true /*right_inclusive*/);
+
+    index_scan_oper->set_key_exprs(std::move(key_exprs));
+    index_scan_oper->set_predicates(std::move(predicates));
+    oper = unique_ptr<PhysicalOperator>(index_scan_oper);
+    LOG_TRACE("Index multi-get used on table: {}", table->name());
+  } else if (index != nullptr) {
     ASSERT(value_expr != nullptr, "got an index but value expr is null ?");
 
     const Value               &value           = value_expr->get_value();
@@ -221,6 +282,7 @@ RC PhysicalPlanGenerator::create_plan(TableGetLogicalOperator &table_get_oper, u
         &value,
         true /*right_inclusive*/);
 
+    index_scan_oper->set_key_expr(value_expr);
     index_scan_oper->set_predicates(std::move(predicates));
     oper = unique_ptr<PhysicalOperator>(index_scan_oper);
     LOG_TRACE("Index scan used on table: {}", table->name());
@@ -387,7 +449,24 @@ RC PhysicalPlanGenerator::create_plan(JoinLogicalOperator &join_oper, unique_ptr
     return RC::INTERNAL;
   }
 
-  unique_ptr<PhysicalOperator> join_physical_oper(new NestedLoopJoinPhysicalOperator);
+  // 有等值连接条件时使用 hash join，其它的连接条件留在上层的谓词算子中过滤
+  unique_ptr<PhysicalOperator>    join_physical_oper;
+  vector<unique_ptr<Expression>> &join_conditions = join_oper.expressions();
+  if (!join_conditions.empty()) {
+    vector<unique_ptr<Expression>> left_keys;
+    vector<unique_ptr<Expression>> right_keys;
+    for (unique_ptr<Expression> &condition : join_conditions) {
+      ASSERT(condition->type() == ExprType::COMPARISON, "join condition should be a comparison expression");
+      auto comparison_expr = static_cast<ComparisonExpr *>(condition.get());
+      left_keys.emplace_back(std::move(comparison_expr->left()));
+      right_keys.emplace_back(std::move(comparison_expr->right()));
+    }
+    join_physical_oper = make_unique<HashJoinPhysicalOperator>(std::move(left_keys), std::move(right_keys));
+    LOG_TRACE("use hash join");
+  } else {
+    join_physical_oper = make_unique<NestedLoopJoinPhysicalOperator>();
+  }
+
   for (auto &child_oper : child_opers) {
     unique_ptr<PhysicalOperator> child_physical_oper;
     rc = create(*child_oper, child_physical_oper);
@@ -456,7 +535,14 @@ RC PhysicalPlanGenerator::create_plan(OrderByLogicalOperator &logical_oper, std:
     }
   }
 
-  OrderByPhysicalOperator *orderby_operator = new OrderByPhysicalOperator(std::move(logical_oper.order_by()));
+  int64_t  memory_limit = OrderByPhysicalOperator::DEFAULT_MEMORY_LIMIT;
+  Session *session      = Session::current_session();
+  if (session != nullptr) {
+    memory_limit = session->sort_buffer_size();
+  }
+
+  OrderByPhysicalOperator *orderby_operator =
+      new OrderByPhysicalOperator(std::move(logical_oper.order_by()), memory_limit);
   if (child_phy_oper) {
     orderby_operator->add_child(std::move(child_phy_oper));
   }
@@ -470,6 +556,12 @@ RC PhysicalPlanGenerator::create_plan(LimitLogicalOperator &logical_oper, unique
   vector<unique_ptr<LogicalOperator>> &child_opers = logical_oper.children();
   unique_ptr<PhysicalOperator>         child_phy_oper;
 
+  // LIMIT 直接作用在 ORDER BY 上时，只需要保留前 offset + limit 行，使用 Top-N 算子代替完整的排序
+  if (child_opers.size() == 1 && child_opers.front()->type() == LogicalOperatorType::ORDER_BY &&
+      child_opers.front()->children().size() == 1) {
+    return create_top_n_plan(logical_oper, static_cast<OrderByLogicalOperator &>(*child_opers.front()), oper);
+  }
+
   RC rc = RC::SUCCESS;
   if (!child_opers.empty()) {
     LogicalOperator *child_oper = child_opers.front().get();
@@ -480,13 +572,127 @@ RC PhysicalPlanGenerator::create_plan(LimitLogicalOperator &logical_oper, unique
     }
   }
 
-  LimitPhysicalOperator *limit_oper = new LimitPhysicalOperator(logical_oper.limit());
+  LimitPhysicalOperator *limit_oper = new LimitPhysicalOperator(logical_oper.limit(), logical_oper.offset());
   limit_oper->add_child(std::move(child_phy_oper));
 
   oper = unique_ptr<PhysicalOperator>(limit_oper);
   return rc;
 }
 
+RC PhysicalPlanGenerator::create_top_n_plan(
+    LimitLogicalOperator &limit_oper, OrderByLogicalOperator &orderby_oper, unique_ptr<PhysicalOperator> &oper)
+{
+  unique_ptr<PhysicalOperator> child_phy_oper;
+
+  RC rc = create(*orderby_oper.children().front(), child_phy_oper);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to create orderby logical operator's child physical operator. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  auto top_n_oper =
+      make_unique<TopNPhysicalOperator>(std::move(orderby_oper.order_by()), limit_oper.limit(), limit_oper.offset());
+  top_n_oper->add_child(std::move(child_phy_oper));
+
+  oper = std::move(top_n_oper);
+  return rc;
+}
+
+namespace {
+using TableFields = map<const BaseTable *, set<int>>;
+
+RC collect_fields(Expression &expr, TableFields &fields)
+{
+  switch (expr.type()) {
+    case ExprType::FIELD: {
+      auto &field_expr = static_cast<FieldExpr &>(expr);
+      fields[field_expr.field().table()].insert(field_expr.field().meta()->field_id());
+      return RC::SUCCESS;
+    }
+    case ExprType::SUBQUERY:
+    case ExprType::EXPRLIST: {
+      return RC::UNSUPPORTED;
+    }
+    default: {
+      return ExpressionIterator::iterate_child_expr(expr, [&fields](unique_ptr<Expression> &child) {
+        return child == nullptr ? RC::SUCCESS : collect_fields(*child, fields);
+      });
+    }
+  }
+}
+
+RC collect_fields(LogicalOperator &oper, TableFields &fields, vector<TableGetLogicalOperator *> &table_gets)
+{
+  RC rc = RC::SUCCESS;
+  for (unique_ptr<Expression> &expr : oper.expressions()) {
+    if (OB_FAIL(rc = collect_fields(*expr, fields))) {
+      return rc;
+    }
+  }
+
+  if (oper.type() == LogicalOperatorType::GROUP_BY) {
+    auto &group_by_oper = static_cast<GroupByLogicalOperator &>(oper);
+    for (unique_ptr<Expression> &expr : group_by_oper.group_by_expressions()) {
+      if (OB_FAIL(rc = collect_fields(*expr, fields))) {
+        return rc;
+      }
+    }
+    for (Expression *expr : group_by_oper.aggregate_expressions()) {
+      if (OB_FAIL(rc = collect_fields(*expr, fields))) {
+        return rc;
+      }
+    }
+  } else if (oper.type() == LogicalOperatorType::TABLE_GET) {
+    auto &table_get_oper = static_cast<TableGetLogicalOperator &>(oper);
+    for (unique_ptr<Expression> &expr : table_get_oper.predicates()) {
+      if (OB_FAIL(rc = collect_fields(*expr, fields))) {
+        return rc;
+      }
+    }
+    table_gets.push_back(&table_get_oper);
+  }
+
+  for (unique_ptr<LogicalOperator> &child : oper.children()) {
+    if (OB_FAIL(rc = collect_fields(*child, fields, table_gets))) {
+      return rc;
+    }
+  }
+  return rc;
+}
+}  // namespace
+
+void PhysicalPlanGenerator::push_down_projection(LogicalOperator &logical_oper)
+{
+  TableFields                       fields;
+  vector<TableGetLogicalOperator *> table_gets;
+  RC                                rc = collect_fields(logical_oper, fields, table_gets);
+  if (OB_FAIL(rc)) {
+    LOG_TRACE("cannot collect referenced fields, scan all fields. rc=%s", strrc(rc));
+    return;
+  }
+
+  for (TableGetLogicalOperator *table_get_oper : table_gets) {
+    const BaseTable *table = table_get_oper->table();
+    const set<int>  &ids   = fields[table];
+    vector<int>      projection(ids.begin(), ids.end());
+    if (projection.empty()) {
+      // 比如 count(*) 不用到任何字段，但是 Chunk 需要至少一列来表示行数，选择最短的字段
+      const TableMeta &table_meta = table->table_meta();
+      const FieldMeta *shortest   = nullptr;
+      for (int i = table_meta.sys_field_num(); i < table_meta.field_num(); i++) {
+        const FieldMeta *field_meta = table_meta.field(i);
+        if (shortest == nullptr || field_meta->len() < shortest->len()) {
+          shortest = field_meta;
+        }
+      }
+      if (shortest != nullptr) {
+        projection.push_back(shortest->field_id());
+      }
+    }
+    table_get_oper->set_projection(std::move(projection));
+  }
+}
+
 RC PhysicalPlanGenerator::create_vec_plan(TableGetLogicalOperator &table_get_oper, unique_ptr<PhysicalOperator> &oper)
 {
   vector<unique_ptr<Expression>> &predicates = table_get_oper.predicates();
@@ -497,6 +703,7 @@ RC PhysicalPlanGenerator::create_vec_plan(TableGetLogicalOperator &table_get_ope
     TableScanVecPhysicalOperator *table_scan_oper =
         new TableScanVecPhysicalOperator(table, table_get_oper.read_write_mode());
     table_scan_oper->set_predicates(std::move(predicates));
+    table_scan_oper->set_projection(std::move(table_get_oper.projection()));
     oper = unique_ptr<PhysicalOperator>(table_scan_oper);
     LOG_TRACE("use vectorized table scan");
   }
@@ -509,7 +716,12 @@ RC PhysicalPlanGenerator::create_vec_plan(GroupByLogicalOperator &logical_oper,
   RC                           rc            = RC::SUCCESS;
   unique_ptr<PhysicalOperator> physical_oper = nullptr;
   if (logical_oper.group_by_expressions().empty()) {
-    physical_oper = make_unique<AggregateVecPhysicalOperator>(std::move(logical_oper.aggregate_expressions()));
+    auto     aggregate_oper = make_unique<AggregateVecPhysicalOperator>(std::move(logical_oper.aggregate_expressions()));
+    Session *session        = Session::current_session();
+    if (session != nullptr) {
+      aggregate_oper->set_parallel_degree(session->parallel_degree());
+    }
+    physical_oper = std::move(aggregate_oper);
   } else {
     physical_oper = make_unique<GroupByVecPhysicalOperator>(
         std::move(logical_oper.group_by_expressions()), std::move(logical_oper.aggregate_expressions()));
@@ -533,6 +745,9 @@ RC PhysicalPlanGenerator::create_vec_plan(GroupByLogicalOperator &logical_oper,
 
 RC PhysicalPlanGenerator::create_vec_plan(ProjectLogicalOperator &project_oper, unique_ptr<PhysicalOperator> &oper)
 {
+  // 投影算子在最上层，可以看到查询中所有的表达式
+  push_down_projection(project_oper);
+
   vector<unique_ptr<LogicalOperator>> &child_opers = project_oper.children();
 
   unique_ptr<PhysicalOperator> child_phy_oper;
@@ -59,8 +59,16 @@ private:
   static RC create_plan(GroupByLogicalOperator &logical_oper, std::unique_ptr<PhysicalOperator> &oper);
   static RC create_plan(OrderByLogicalOperator &logical_oper, std::unique_ptr<PhysicalOperator> &oper);
   static RC create_plan(LimitLogicalOperator &logical_oper, std::unique_ptr<PhysicalOperator> &oper);
+  static RC create_top_n_plan(LimitLogicalOperator &limit_oper, OrderByLogicalOperator &orderby_oper,
+      std::unique_ptr<PhysicalOperator> &oper);
   static RC create_vec_plan(ProjectLogicalOperator &logical_oper, std::unique_ptr<PhysicalOperator> &oper);
   static RC create_vec_plan(TableGetLogicalOperator &logical_oper, std::unique_ptr<PhysicalOperator> &oper);
   static RC create_vec_plan(GroupByLogicalOperator &logical_oper, std::unique_ptr<PhysicalOperator> &oper);
   static RC create_vec_plan(ExplainLogicalOperator &logical_oper, std::unique_ptr<PhysicalOperator> &oper);
+
+  /**
+   * @brief 收集查询中用到的字段，设置到每个表扫描算子上，向量化扫描时只读取这些列
+   * @details 表达式中有不支持分析的子查询时不做处理，扫描所有字段
+   */
+  static void push_down_projection(LogicalOperator &logical_oper);
 };
@@ -93,6 +93,9 @@ RC VectorIndexScanRewrite::rewrite(std::unique_ptr<LogicalOperator> &oper, bool
       }
 
       auto limit_oper = dynamic_cast<LimitLogicalOperator *>(child_oper.get());
+      if (limit_oper->offset() != 0) {
+        return RC::SUCCESS;
+      }
 
       // 设置向量索引必要的参数
       table_get_oper->set_index(index);
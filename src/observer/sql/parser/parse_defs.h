@@ -107,6 +107,7 @@ struct OrderBySqlNode
 struct LimitSqlNode
 {
   int number;
+  int offset = 0;  ///< 跳过前面多少行
 };
 
 /**
@@ -300,6 +301,16 @@ struct ShowIndexSqlNode
   std::string relation_name;  ///< Relation name
 };
 
+/**
+ * @brief 描述一个show status语句
+ * @ingroup SQLParser
+ * @details 语法上允许 SHOW 后面跟任意的名字，在 resolve 阶段检查名字是不是 status
+ */
+struct ShowStatusSqlNode
+{
+  std::string name;
+};
+
 /**
  * @brief 描述一个desc table语句
  * @ingroup SQLParser
@@ -377,6 +388,7 @@ enum SqlCommandFlag
   SCF_SHOW_INDEX,
   SCF_SYNC,
   SCF_SHOW_TABLES,
+  SCF_SHOW_STATUS,
   SCF_DESC_TABLE,
   SCF_CREATE_VIEW,
   SCF_DROP_VIEW,
@@ -409,6 +421,7 @@ public:
   CreateIndexSqlNode  create_index;
   DropIndexSqlNode    drop_index;
   ShowIndexSqlNode    show_index;
+  ShowStatusSqlNode   show_status;
   DescTableSqlNode    desc_table;
   CreateViewSqlNode   create_view;
   DropViewSqlNode     drop_view;
@@ -432,6 +445,10 @@ public:
 
   std::vector<std::unique_ptr<ParsedSqlNode>> &sql_nodes() { return sql_nodes_; }
 
+  /// @brief 按照在SQL中出现的顺序给常量分配序号
+  int next_param_index() { return param_num_++; }
+
 private:
   std::vector<std::unique_ptr<ParsedSqlNode>> sql_nodes_;  ///< 这里记录SQL命令。虽然看起来支持多个，但是当前仅处理一个
+  int                                         param_num_ = 0;
 };
@@ -110,6 +110,19 @@ ArithmeticExpr *create_arithmetic_expression(ArithmeticExpr::Type type,
   return expr;
 }
 
+ValueExpr *create_value_expression(Value *value, ParsedSqlResult *sql_result, const char *sql_string, YYLTYPE *llocp)
+{
+  ValueExpr *expr = new ValueExpr(*value);
+  expr->set_name(token_name(sql_string, llocp));
+  // 只有数字和字符串常量可以参数化，与 PlanCache::parameterize 保持一致
+  AttrType type = value->attr_type();
+  if (!value->is_null() && (type == AttrType::INTS || type == AttrType::FLOATS || type == AttrType::CHARS)) {
+    expr->set_param_index(sql_result->next_param_index());
+  }
+  delete value;
+  return expr;
+}
+
 UnboundFunctionExpr *create_aggregate_expression(const char *function_name,
                                                  std::vector<std::unique_ptr<Expression>> child,
                                                  const char *sql_string,
@@ -151,7 +164,7 @@ ParsedSqlNode *create_table_sql_node(char *table_name,
     return parsed_sql_node;
 }
 
-#line 155 "yacc_sql.cpp"
+#line 168 "yacc_sql.cpp"
 
 # ifndef YY_CAST
 #  ifdef __cplusplus
@@ -278,56 +291,57 @@ enum yysymbol_kind_t
   YYSYMBOL_rollback_stmt = 96,             /* rollback_stmt  */
   YYSYMBOL_drop_table_stmt = 97,           /* drop_table_stmt  */
   YYSYMBOL_show_tables_stmt = 98,          /* show_tables_stmt  */
-  YYSYMBOL_desc_table_stmt = 99,           /* desc_table_stmt  */
-  YYSYMBOL_show_index_stmt = 100,          /* show_index_stmt  */
-  YYSYMBOL_create_index_stmt = 101,        /* create_index_stmt  */
-  YYSYMBOL_opt_unique = 102,               /* opt_unique  */
-  YYSYMBOL_index_type = 103,               /* index_type  */
-  YYSYMBOL_vector_index_config = 104,      /* vector_index_config  */
-  YYSYMBOL_attr_list = 105,                /* attr_list  */
-  YYSYMBOL_drop_index_stmt = 106,          /* drop_index_stmt  */
-  YYSYMBOL_create_table_stmt = 107,        /* create_table_stmt  */
-  YYSYMBOL_create_view_stmt = 108,         /* create_view_stmt  */
-  YYSYMBOL_drop_view_stmt = 109,           /* drop_view_stmt  */
-  YYSYMBOL_attr_def_list = 110,            /* attr_def_list  */
-  YYSYMBOL_attr_def = 111,                 /* attr_def  */
-  YYSYMBOL_nullable_constraint = 112,      /* nullable_constraint  */
-  YYSYMBOL_type = 113,                     /* type  */
-  YYSYMBOL_insert_stmt = 114,              /* insert_stmt  */
-  YYSYMBOL_values_list = 115,              /* values_list  */
-  YYSYMBOL_digits = 116,                   /* digits  */
-  YYSYMBOL_digits_list = 117,              /* digits_list  */
-  YYSYMBOL_value_list = 118,               /* value_list  */
-  YYSYMBOL_value = 119,                    /* value  */
-  YYSYMBOL_nonnegative_value = 120,        /* nonnegative_value  */
-  YYSYMBOL_storage_format = 121,           /* storage_format  */
-  YYSYMBOL_delete_stmt = 122,              /* delete_stmt  */
-  YYSYMBOL_update_stmt = 123,              /* update_stmt  */
-  YYSYMBOL_set_clauses = 124,              /* set_clauses  */
-  YYSYMBOL_set_clause = 125,               /* set_clause  */
-  YYSYMBOL_select_stmt = 126,              /* select_stmt  */
-  YYSYMBOL_calc_stmt = 127,                /* calc_stmt  */
-  YYSYMBOL_expression_list = 128,          /* expression_list  */
-  YYSYMBOL_expression = 129,               /* expression  */
-  YYSYMBOL_alias = 130,                    /* alias  */
-  YYSYMBOL_func_expr = 131,                /* func_expr  */
-  YYSYMBOL_sub_query_expr = 132,           /* sub_query_expr  */
-  YYSYMBOL_rel_attr = 133,                 /* rel_attr  */
-  YYSYMBOL_relation = 134,                 /* relation  */
-  YYSYMBOL_rel_list = 135,                 /* rel_list  */
-  YYSYMBOL_join_clauses = 136,             /* join_clauses  */
-  YYSYMBOL_where = 137,                    /* where  */
-  YYSYMBOL_condition = 138,                /* condition  */
-  YYSYMBOL_comp_op = 139,                  /* comp_op  */
-  YYSYMBOL_opt_order_by = 140,             /* opt_order_by  */
-  YYSYMBOL_sort_list = 141,                /* sort_list  */
-  YYSYMBOL_sort_unit = 142,                /* sort_unit  */
-  YYSYMBOL_group_by = 143,                 /* group_by  */
-  YYSYMBOL_opt_having = 144,               /* opt_having  */
-  YYSYMBOL_opt_limit = 145,                /* opt_limit  */
-  YYSYMBOL_explain_stmt = 146,             /* explain_stmt  */
-  YYSYMBOL_set_variable_stmt = 147,        /* set_variable_stmt  */
-  YYSYMBOL_opt_semicolon = 148             /* opt_semicolon  */
+  YYSYMBOL_show_status_stmt = 99,          /* show_status_stmt  */
+  YYSYMBOL_desc_table_stmt = 100,          /* desc_table_stmt  */
+  YYSYMBOL_show_index_stmt = 101,          /* show_index_stmt  */
+  YYSYMBOL_create_index_stmt = 102,        /* create_index_stmt  */
+  YYSYMBOL_opt_unique = 103,               /* opt_unique  */
+  YYSYMBOL_index_type = 104,               /* index_type  */
+  YYSYMBOL_vector_index_config = 105,      /* vector_index_config  */
+  YYSYMBOL_attr_list = 106,                /* attr_list  */
+  YYSYMBOL_drop_index_stmt = 107,          /* drop_index_stmt  */
+  YYSYMBOL_create_table_stmt = 108,        /* create_table_stmt  */
+  YYSYMBOL_create_view_stmt = 109,         /* create_view_stmt  */
+  YYSYMBOL_drop_view_stmt = 110,           /* drop_view_stmt  */
+  YYSYMBOL_attr_def_list = 111,            /* attr_def_list  */
+  YYSYMBOL_attr_def = 112,                 /* attr_def  */
+  YYSYMBOL_nullable_constraint = 113,      /* nullable_constraint  */
+  YYSYMBOL_type = 114,                     /* type  */
+  YYSYMBOL_insert_stmt = 115,              /* insert_stmt  */
+  YYSYMBOL_values_list = 116,              /* values_list  */
+  YYSYMBOL_digits = 117,                   /* digits  */
+  YYSYMBOL_digits_list = 118,              /* digits_list  */
+  YYSYMBOL_value_list = 119,               /* value_list  */
+  YYSYMBOL_value = 120,                    /* value  */
+  YYSYMBOL_nonnegative_value = 121,        /* nonnegative_value  */
+  YYSYMBOL_storage_format = 122,           /* storage_format  */
+  YYSYMBOL_delete_stmt = 123,              /* delete_stmt  */
+  YYSYMBOL_update_stmt = 124,              /* update_stmt  */
+  YYSYMBOL_set_clauses = 125,              /* set_clauses  */
+  YYSYMBOL_set_clause = 126,               /* set_clause  */
+  YYSYMBOL_select_stmt = 127,              /* select_stmt  */
+  YYSYMBOL_calc_stmt = 128,                /* calc_stmt  */
+  YYSYMBOL_expression_list = 129,          /* expression_list  */
+  YYSYMBOL_expression = 130,               /* expression  */
+  YYSYMBOL_alias = 131,                    /* alias  */
+  YYSYMBOL_func_expr = 132,                /* func_expr  */
+  YYSYMBOL_sub_query_expr = 133,           /* sub_query_expr  */
+  YYSYMBOL_rel_attr = 134,                 /* rel_attr  */
+  YYSYMBOL_relation = 135,                 /* relation  */
+  YYSYMBOL_rel_list = 136,                 /* rel_list  */
+  YYSYMBOL_join_clauses = 137,             /* join_clauses  */
+  YYSYMBOL_where = 138,                    /* where  */
+  YYSYMBOL_condition = 139,                /* condition  */
+  YYSYMBOL_comp_op = 140,                  /* comp_op  */
+  YYSYMBOL_opt_order_by = 141,             /* opt_order_by  */
+  YYSYMBOL_sort_list = 142,                /* sort_list  */
+  YYSYMBOL_sort_unit = 143,                /* sort_unit  */
+  YYSYMBOL_group_by = 144,                 /* group_by  */
+  YYSYMBOL_opt_having = 145,               /* opt_having  */
+  YYSYMBOL_opt_limit = 146,                /* opt_limit  */
+  YYSYMBOL_explain_stmt = 147,             /* explain_stmt  */
+  YYSYMBOL_set_variable_stmt = 148,        /* set_variable_stmt  */
+  YYSYMBOL_opt_semicolon = 149             /* opt_semicolon  */
 };
 typedef enum yysymbol_kind_t yysymbol_kind_t;
 
@@ -656,18 +670,18 @@ union yyalloc
 #endif /* !YYCOPY_NEEDED */
 
 /* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  76
+#define YYFINAL  78
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   346
+#define YYLAST   349
 
 /* YYNTOKENS -- Number of terminals.  */
 #define YYNTOKENS  88
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  61
+#define YYNNTS  62
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  165
+#define YYNRULES  169
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  323
+#define YYNSTATES  329
 
 /* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   338
@@ -724,23 +738,23 @@ static const yytype_int8 yytranslate[] =
 /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_int16 yyrline[] =
 {
-       0,   282,   282,   290,   291,   292,   293,   294,   295,   296,
-     297,   298,   299,   300,   301,   302,   303,   304,   305,   306,
-     307,   308,   309,   310,   311,   315,   321,   326,   332,   338,
-     344,   350,   357,   363,   371,   381,   393,   409,   410,   414,
-     421,   428,   437,   449,   455,   464,   474,   478,   482,   486,
-     490,   497,   505,   517,   527,   530,   543,   561,   590,   594,
-     598,   603,   609,   610,   611,   612,   613,   614,   618,   628,
-     642,   648,   655,   659,   663,   667,   675,   678,   683,   691,
-     694,   700,   708,   711,   715,   722,   726,   730,   736,   739,
-     742,   745,   752,   755,   762,   774,   788,   793,   800,   810,
-     848,   881,   887,   896,   899,   908,   924,   927,   930,   933,
-     936,   944,   947,   952,   958,   961,   964,   967,   974,   977,
-     980,   985,   993,  1000,  1005,  1015,  1021,  1031,  1048,  1055,
-    1067,  1070,  1076,  1080,  1087,  1091,  1098,  1099,  1100,  1101,
-    1102,  1103,  1104,  1105,  1106,  1107,  1108,  1109,  1110,  1111,
-    1116,  1119,  1127,  1132,  1140,  1146,  1152,  1162,  1165,  1173,
-    1176,  1184,  1187,  1195,  1203,  1214
+       0,   296,   296,   304,   305,   306,   307,   308,   309,   310,
+     311,   312,   313,   314,   315,   316,   317,   318,   319,   320,
+     321,   322,   323,   324,   325,   326,   330,   336,   341,   347,
+     353,   359,   365,   372,   378,   386,   394,   404,   416,   432,
+     433,   437,   444,   451,   460,   472,   478,   487,   497,   501,
+     505,   509,   513,   520,   528,   540,   550,   553,   566,   584,
+     613,   617,   621,   626,   632,   633,   634,   635,   636,   637,
+     641,   651,   665,   671,   678,   682,   686,   690,   698,   701,
+     706,   714,   717,   723,   731,   734,   738,   745,   749,   753,
+     759,   762,   765,   768,   775,   778,   785,   797,   811,   816,
+     823,   833,   871,   904,   910,   919,   922,   931,   947,   950,
+     953,   956,   959,   967,   970,   973,   979,   982,   985,   988,
+     995,   998,  1001,  1006,  1014,  1021,  1026,  1036,  1042,  1052,
+    1069,  1076,  1088,  1091,  1097,  1101,  1108,  1112,  1119,  1120,
+    1121,  1122,  1123,  1124,  1125,  1126,  1127,  1128,  1129,  1130,
+    1131,  1132,  1137,  1140,  1148,  1153,  1161,  1167,  1173,  1183,
+    1186,  1194,  1197,  1205,  1208,  1213,  1220,  1236,  1244,  1255
 };
 #endif
 
@@ -770,18 +784,18 @@ static const char *const yytname[] =
   "'+'", "'-'", "'*'", "'/'", "UMINUS", "$accept", "commands",
   "command_wrapper", "exit_stmt", "help_stmt", "sync_stmt", "begin_stmt",
   "commit_stmt", "rollback_stmt", "drop_table_stmt", "show_tables_stmt",
-  "desc_table_stmt", "show_index_stmt", "create_index_stmt", "opt_unique",
-  "index_type", "vector_index_config", "attr_list", "drop_index_stmt",
-  "create_table_stmt", "create_view_stmt", "drop_view_stmt",
-  "attr_def_list", "attr_def", "nullable_constraint", "type",
-  "insert_stmt", "values_list", "digits", "digits_list", "value_list",
-  "value", "nonnegative_value", "storage_format", "delete_stmt",
-  "update_stmt", "set_clauses", "set_clause", "select_stmt", "calc_stmt",
-  "expression_list", "expression", "alias", "func_expr", "sub_query_expr",
-  "rel_attr", "relation", "rel_list", "join_clauses", "where", "condition",
-  "comp_op", "opt_order_by", "sort_list", "sort_unit", "group_by",
-  "opt_having", "opt_limit", "explain_stmt", "set_variable_stmt",
-  "opt_semicolon", YY_NULLPTR
+  "show_status_stmt", "desc_table_stmt", "show_index_stmt",
+  "create_index_stmt", "opt_unique", "index_type", "vector_index_config",
+  "attr_list", "drop_index_stmt", "create_table_stmt", "create_view_stmt",
+  "drop_view_stmt", "attr_def_list", "attr_def", "nullable_constraint",
+  "type", "insert_stmt", "values_list", "digits", "digits_list",
+  "value_list", "value", "nonnegative_value", "storage_format",
+  "delete_stmt", "update_stmt", "set_clauses", "set_clause", "select_stmt",
+  "calc_stmt", "expression_list", "expression", "alias", "func_expr",
+  "sub_query_expr", "rel_attr", "relation", "rel_list", "join_clauses",
+  "where", "condition", "comp_op", "opt_order_by", "sort_list",
+  "sort_unit", "group_by", "opt_having", "opt_limit", "explain_stmt",
+  "set_variable_stmt", "opt_semicolon", YY_NULLPTR
 };
 
 static const char *
@@ -791,7 +805,7 @@ yysymbol_name (yysymbol_kind_t yysymbol)
 }
 #endif
 
-#define YYPACT_NINF (-203)
+#define YYPACT_NINF (-134)
 
 #define yypact_value_is_default(Yyn) \
   ((Yyn) == YYPACT_NINF)
@@ -805,39 +819,39 @@ yysymbol_name (yysymbol_kind_t yysymbol)
    STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
-     281,    13,     4,   140,   140,   -66,    46,  -203,   -14,    51,
-     -43,  -203,  -203,  -203,  -203,  -203,   -34,   281,    85,   106,
-    -203,  -203,  -203,  -203,  -203,  -203,  -203,  -203,  -203,  -203,
-    -203,  -203,  -203,  -203,  -203,  -203,  -203,  -203,  -203,  -203,
-    -203,  -203,    53,   113,  -203,    61,   123,    75,    84,    88,
-      32,    47,  -203,  -203,  -203,  -203,  -203,    -8,  -203,   140,
-    -203,  -203,  -203,     8,  -203,  -203,  -203,    95,  -203,  -203,
-     118,    90,    91,   117,   108,  -203,  -203,  -203,  -203,    -6,
-      96,    26,    97,  -203,   119,  -203,   140,   157,   159,  -203,
-    -203,    57,  -203,    -5,   140,   -56,  -203,   104,  -203,   140,
-     140,   140,   140,   161,   109,   109,    -3,   134,   110,   160,
-     111,   127,    16,   136,   180,   120,   141,   121,    95,  -203,
-    -203,  -203,  -203,  -203,    47,   174,  -203,  -203,  -203,    58,
-      58,  -203,  -203,   140,  -203,     0,   134,  -203,   120,   181,
-     202,  -203,   133,     6,  -203,    66,  -203,  -203,    83,   178,
-     142,   180,  -203,   146,  -203,   195,   205,   150,  -203,  -203,
-    -203,  -203,   170,   206,   228,   216,   160,   218,  -203,  -203,
-      19,  -203,  -203,  -203,  -203,  -203,  -203,  -203,   207,    77,
-      25,   140,   140,   110,  -203,  -203,  -203,  -203,  -203,  -203,
-    -203,  -203,  -203,    33,   111,   222,   168,  -203,   226,   120,
-     247,   229,   109,   109,   246,   243,   204,    59,  -203,   232,
-    -203,  -203,  -203,  -203,   140,   202,   202,   -13,   -13,  -203,
-     179,   214,  -203,  -203,  -203,   178,   199,  -203,   120,  -203,
-     180,   120,   203,   134,     7,  -203,   140,   202,   249,   181,
-    -203,   160,   160,   -13,  -203,   208,   238,  -203,  -203,    20,
-     239,  -203,   240,   202,   228,  -203,    25,   260,   223,   218,
-    -203,   105,    54,   180,  -203,   220,  -203,   -23,  -203,   140,
-     189,  -203,  -203,  -203,  -203,   245,   209,    22,  -203,   242,
-    -203,   101,  -203,   109,  -203,  -203,   140,   200,   219,  -203,
-    -203,   210,   224,   264,  -203,   265,   241,   230,   234,   235,
-     224,   233,   107,   267,  -203,   248,   250,   236,   244,   160,
-     160,   285,   289,   251,   252,   253,   254,   160,   160,   284,
-     294,  -203,  -203
+     260,    11,    41,    -8,    -8,   -32,     5,  -134,     8,    12,
+     -15,  -134,  -134,  -134,  -134,  -134,     0,   260,    60,    88,
+    -134,  -134,  -134,  -134,  -134,  -134,  -134,  -134,  -134,  -134,
+    -134,  -134,  -134,  -134,  -134,  -134,  -134,  -134,  -134,  -134,
+    -134,  -134,  -134,    20,   102,  -134,    51,   124,    64,    70,
+      72,   230,    50,  -134,  -134,  -134,  -134,  -134,    -1,  -134,
+      -8,  -134,  -134,  -134,     4,  -134,  -134,  -134,   103,  -134,
+    -134,   127,  -134,    94,   100,   114,   116,  -134,  -134,  -134,
+    -134,   -10,   101,    13,   105,  -134,   132,  -134,    -8,   166,
+     167,  -134,  -134,   -48,  -134,   137,    -8,   -56,  -134,   112,
+    -134,    -8,    -8,    -8,    -8,   172,   113,   113,   -13,   142,
+     120,    92,   122,   143,    35,   149,   191,   130,   158,   138,
+     103,  -134,  -134,  -134,  -134,  -134,    50,   195,  -134,  -134,
+    -134,    81,    81,  -134,  -134,    -8,  -134,    17,   142,  -134,
+     130,   199,   164,  -134,   153,     2,  -134,    89,  -134,  -134,
+     110,   197,   155,   191,  -134,   146,  -134,   200,   205,   150,
+    -134,  -134,  -134,  -134,   169,   222,   223,   226,    92,   224,
+    -134,  -134,     3,  -134,  -134,  -134,  -134,  -134,  -134,  -134,
+     212,    37,   123,    -8,    -8,   120,  -134,  -134,  -134,  -134,
+    -134,  -134,  -134,  -134,  -134,    16,   122,   232,   174,  -134,
+     234,   130,   255,   236,   113,   113,   256,   250,   215,    91,
+    -134,   239,  -134,  -134,  -134,  -134,    -8,   164,   164,    77,
+      77,  -134,   190,   227,  -134,  -134,  -134,   197,   211,  -134,
+     130,  -134,   191,   130,   217,   142,    18,  -134,    -8,   164,
+     263,   199,  -134,    92,    92,    77,  -134,   218,   259,  -134,
+    -134,    65,   261,  -134,   262,   164,   223,  -134,   123,   279,
+     244,   224,  -134,   108,   111,   191,  -134,   228,  -134,   -21,
+    -134,    -8,   213,  -134,  -134,  -134,  -134,   270,   233,    10,
+    -134,   267,   -18,   118,  -134,   113,  -134,  -134,    -8,   219,
+     220,   229,   231,  -134,  -134,  -134,  -134,   216,   235,   273,
+    -134,   275,   237,   241,   242,   246,   235,   240,   115,   290,
+    -134,   252,   254,   253,   257,    92,    92,   295,   297,   258,
+     264,   265,   266,    92,    92,   301,   304,  -134,  -134
 };
 
 /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
@@ -845,63 +859,63 @@ static const yytype_int16 yypact[] =
    means the default is an error.  */
 static const yytype_uint8 yydefact[] =
 {
-       0,    38,     0,   103,   103,     0,     0,    27,     0,     0,
-       0,    28,    29,    30,    26,    25,     0,     0,     0,     0,
-      24,    23,    17,    18,    19,    20,     9,    10,    11,    14,
-      12,    13,     8,    15,    16,     5,     7,     6,     3,     4,
-      21,    22,     0,     0,    37,     0,     0,     0,     0,     0,
-     103,    76,    88,    89,    90,    85,    86,   123,    87,     0,
-     114,   112,   101,   118,   116,   117,   113,   102,    33,    32,
-       0,     0,     0,     0,     0,   163,     1,   165,     2,    92,
-       0,     0,     0,    31,     0,    53,   103,     0,     0,    72,
-      74,     0,    77,     0,   103,     0,   111,     0,   119,     0,
-       0,     0,     0,   104,     0,     0,     0,   130,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,   122,
-     110,    73,    75,    91,     0,     0,   124,   115,   120,   106,
-     107,   108,   109,   103,   125,   118,   130,    34,     0,     0,
-       0,    94,     0,   130,    96,     0,   164,    82,     0,    54,
-       0,     0,    50,     0,    51,    43,     0,     0,    45,    78,
-     121,   105,     0,   126,   157,     0,    79,    68,   148,   146,
-       0,   136,   137,   138,   139,   140,   141,   144,   142,     0,
-     131,     0,     0,     0,    95,    83,    84,    62,    63,    64,
-      65,    66,    67,    61,     0,     0,     0,    49,     0,     0,
-       0,     0,     0,     0,     0,   159,     0,     0,    80,     0,
-     149,   147,   145,   143,     0,     0,     0,   133,    98,    97,
-       0,     0,    60,    59,    57,    54,    92,    93,     0,    44,
-       0,     0,     0,   130,   118,   127,   103,     0,   150,     0,
-      70,     0,    79,   132,   134,   135,     0,    58,    55,    48,
-       0,    52,     0,     0,   157,   158,   160,     0,   161,    69,
-      81,     0,    61,     0,    47,     0,    35,   128,   100,     0,
-       0,    99,    71,    56,    46,     0,     0,   154,   151,   152,
-     162,     0,    36,     0,   156,   155,     0,     0,     0,   129,
-     153,     0,     0,     0,    39,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,    40,     0,     0,     0,     0,     0,
+       0,    40,     0,   105,   105,     0,     0,    28,     0,     0,
+       0,    29,    30,    31,    27,    26,     0,     0,     0,     0,
+      25,    24,    18,    19,    20,    21,     9,    10,    11,    12,
+      15,    13,    14,     8,    16,    17,     5,     7,     6,     3,
+       4,    22,    23,     0,     0,    39,     0,     0,     0,     0,
+       0,   105,    78,    90,    91,    92,    87,    88,   125,    89,
+       0,   116,   114,   103,   120,   118,   119,   115,   104,    35,
+      33,     0,    34,     0,     0,     0,     0,   167,     1,   169,
+       2,    94,     0,     0,     0,    32,     0,    55,   105,     0,
+       0,    74,    76,     0,    79,     0,   105,     0,   113,     0,
+     121,     0,     0,     0,     0,   106,     0,     0,     0,   132,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,    41,    42
+       0,   124,   112,    75,    77,    93,     0,     0,   126,   117,
+     122,   108,   109,   110,   111,   105,   127,   120,   132,    36,
+       0,     0,     0,    96,     0,   132,    98,     0,   168,    84,
+       0,    56,     0,     0,    52,     0,    53,    45,     0,     0,
+      47,    80,   123,   107,     0,   128,   159,     0,    81,    70,
+     150,   148,     0,   138,   139,   140,   141,   142,   143,   146,
+     144,     0,   133,     0,     0,     0,    97,    85,    86,    64,
+      65,    66,    67,    68,    69,    63,     0,     0,     0,    51,
+       0,     0,     0,     0,     0,     0,     0,   161,     0,     0,
+      82,     0,   151,   149,   147,   145,     0,     0,     0,   135,
+     100,    99,     0,     0,    62,    61,    59,    56,    94,    95,
+       0,    46,     0,     0,     0,   132,   120,   129,   105,     0,
+     152,     0,    72,     0,    81,   134,   136,   137,     0,    60,
+      57,    50,     0,    54,     0,     0,   159,   160,   162,     0,
+     163,    71,    83,     0,    63,     0,    49,     0,    37,   130,
+     102,     0,     0,   101,    73,    58,    48,     0,     0,   156,
+     153,   154,   164,     0,    38,     0,   158,   157,     0,     0,
+       0,     0,     0,   131,   155,   165,   166,     0,     0,     0,
+      41,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+      42,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,    43,    44
 };
 
 /* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] =
 {
-    -203,  -203,   305,  -203,  -203,  -203,  -203,  -203,  -203,  -203,
-    -203,  -203,  -203,  -203,  -203,    23,  -203,  -130,  -203,  -203,
-    -203,  -203,   103,   132,    68,  -203,  -203,    92,   211,  -203,
-      94,  -100,  -102,   112,  -203,  -203,  -203,   149,   -49,  -203,
-      -4,   -57,   270,  -203,  -203,  -203,   -99,   131,    56,  -133,
-    -202,   162,  -203,    60,  -203,    89,  -203,  -203,  -203,  -203,
-    -203
+    -134,  -134,   313,  -134,  -134,  -134,  -134,  -134,  -134,  -134,
+    -134,  -134,  -134,  -134,  -134,  -134,    25,  -134,  -133,  -134,
+    -134,  -134,  -134,   107,   136,    71,  -134,  -134,    97,   214,
+    -134,    95,  -102,  -106,   117,  -134,  -134,  -134,   156,   -49,
+    -134,    -4,   -59,   278,  -134,  -134,  -134,  -103,   139,    58,
+    -132,  -111,   165,  -134,    59,  -134,    93,  -134,  -134,  -134,
+    -134,  -134
 };
 
 /* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int16 yydefgoto[] =
 {
        0,    18,    19,    20,    21,    22,    23,    24,    25,    26,
-      27,    28,    29,    30,    46,   295,   282,   156,    31,    32,
-      33,    34,   195,   149,   224,   193,    35,   167,    92,    93,
-     207,   208,    61,   112,    36,    37,   143,   144,    38,    39,
-      62,    63,   163,    64,    65,    66,   232,   136,   233,   141,
-     180,   181,   258,   278,   279,   205,   238,   271,    40,    41,
-      78
+      27,    28,    29,    30,    31,    47,   301,   284,   158,    32,
+      33,    34,    35,   197,   151,   226,   195,    36,   169,    94,
+      95,   209,   210,    62,   114,    37,    38,   145,   146,    39,
+      40,    63,    64,   165,    65,    66,    67,   234,   138,   235,
+     143,   182,   183,   260,   280,   281,   207,   240,   273,    41,
+      42,    80
 };
 
 /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
@@ -909,80 +923,80 @@ static const yytype_int16 yydefgoto[] =
    number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int16 yytable[] =
 {
-      67,    87,    96,   164,    97,   135,   137,   147,   165,   146,
-     184,    97,    97,   244,   245,    68,    94,    47,   110,    48,
-     151,   138,   123,   124,   263,   126,    42,   284,   210,   127,
-     114,   215,   216,    86,   183,   256,    71,    86,    73,   276,
-     285,    95,   129,   130,   131,   132,    88,    74,   139,    86,
-     115,   267,   211,    43,   111,    44,    50,   220,    51,   140,
-      69,    70,   162,   152,   147,   154,    52,    53,    49,   229,
-      99,   100,   101,   102,   221,    54,   222,    45,   223,   215,
-     216,    98,   118,   179,   240,    76,   168,   241,    98,    98,
-     125,    99,   100,   101,   102,   221,   212,   222,   250,   223,
-     254,   252,   197,    72,   234,    99,   100,   101,   102,    77,
-     169,    55,    56,    57,    58,   187,    59,    60,   170,   188,
-     189,   190,   191,   192,   217,   218,    89,    90,    80,   161,
-     272,    91,   304,   241,    79,   305,   121,   122,    82,   147,
-     147,   260,    81,   101,   102,   185,   186,   104,   171,   172,
-     173,   174,   175,   176,   177,   178,    83,   243,   179,   179,
-      99,   100,   101,   102,    50,    84,    51,   287,   288,    85,
-     105,   106,   107,   108,    52,    53,   117,   113,   116,   109,
-     179,   251,   119,    54,   120,   128,    51,   140,   150,   133,
-     134,   142,   148,   153,    52,    53,   179,    86,   157,   160,
-     264,   155,   158,    54,   182,   166,   194,   147,   147,   311,
-     312,   168,   277,   196,   274,   147,   147,   319,   320,    55,
-      56,    57,    58,   199,    59,    60,    50,   198,    51,   277,
-     200,   201,   255,   202,   203,   169,    52,    53,   204,    55,
-      56,   206,    58,   170,   145,    54,   209,   226,   213,   227,
-     228,   230,   236,   231,   237,   239,   242,   247,   246,   111,
-     253,   257,   215,   262,   265,   266,   269,   270,   280,   281,
-     286,   291,   283,   171,   172,   173,   174,   175,   176,   177,
-     178,    55,    56,    57,    58,   275,    59,    60,     1,     2,
-     292,   293,   296,   297,   294,   306,   299,     3,     4,     5,
-       6,     7,     8,     9,    10,   300,   301,   309,   298,   321,
-      11,    12,    13,   313,   303,   310,   307,   314,   308,   322,
-     315,   316,    75,   302,   317,   318,   225,    14,   248,    15,
-     273,   259,   219,   103,   235,   159,   261,    16,   249,   289,
-      17,   214,     0,   268,     0,     0,   290
+      68,    98,    89,   137,   139,   149,   166,   167,    99,   148,
+     289,   140,   212,   186,   112,   286,    51,   116,    52,    70,
+      71,    99,    99,    96,    43,   128,    53,    54,   287,   129,
+     185,   123,   124,   217,   218,    55,   213,   117,   141,   153,
+     222,   278,   131,   132,   133,   134,   170,    90,    97,    69,
+     113,    44,    88,    45,    48,   142,    49,   223,    73,   224,
+      78,   225,   149,   290,    74,   154,    75,   156,   231,   265,
+     171,    56,    57,    58,    59,    46,    60,    61,   172,   164,
+     214,    76,    88,   181,   120,   100,    72,   101,   102,   103,
+     104,    79,   127,   101,   102,   103,   104,   252,   100,   100,
+     254,    81,   236,   256,   199,    50,   246,   247,   173,   174,
+     175,   176,   177,   178,   179,   180,   242,    82,    52,   243,
+     101,   102,   103,   104,   219,   220,    53,    54,   258,    91,
+      92,   163,    83,   274,    93,    55,   243,   149,   149,    84,
+     310,   262,   189,   311,   269,    85,   190,   191,   192,   193,
+     194,    86,   223,    87,   224,   106,   225,   245,   181,   181,
+     101,   102,   103,   104,   125,   126,   103,   104,   187,   188,
+     110,    56,    57,   170,    59,   108,   147,   217,   218,   107,
+     181,   109,   115,   253,   291,   292,   118,   111,    51,   119,
+      52,   121,   122,   130,   136,   142,   181,   171,    53,    54,
+     135,   144,   266,   150,   152,   172,   155,    55,    88,   149,
+     149,   157,   279,   317,   318,   159,   276,   149,   149,   160,
+     162,   325,   326,   168,   184,   196,   198,   200,   201,   279,
+     202,   203,   204,   206,   257,   173,   174,   175,   176,   177,
+     178,   179,   180,    56,    57,    58,    59,    88,    60,    61,
+     205,   208,   211,   215,    51,   229,    52,   228,   230,   232,
+     233,   239,   238,   244,    53,    54,   241,     1,     2,   248,
+     249,   113,   217,    55,   255,   259,     3,     4,     5,     6,
+       7,     8,     9,    10,   264,   271,   267,   268,   272,    11,
+      12,    13,   282,   277,   283,   288,   285,   299,   295,   296,
+     297,   302,   298,   303,   304,   300,    14,   305,    15,    56,
+      57,    58,    59,   306,    60,    61,    16,   307,   312,    17,
+     313,   309,   314,   319,   315,   320,   327,   321,   316,   328,
+      77,   308,   227,   322,   250,   275,   323,   324,   261,   263,
+     161,   221,   105,   293,   237,   251,   216,   294,     0,   270
 };
 
 static const yytype_int16 yycheck[] =
 {
-       4,    50,    59,   136,     4,   104,   105,   109,   138,   109,
-     143,     4,     4,   215,   216,    81,    24,    13,    24,    15,
-       4,    24,    27,    28,     4,    81,    13,     5,     9,    85,
-       4,    54,    55,    17,    28,   237,    50,    17,    81,    62,
-      18,    49,    99,   100,   101,   102,    50,    81,    51,    17,
-      24,   253,    33,    40,    60,    42,    24,    24,    26,    53,
-      14,    15,    62,   112,   166,   114,    34,    35,    64,   199,
-      83,    84,    85,    86,    41,    43,    43,    64,    45,    54,
-      55,    81,    86,   140,    25,     0,     9,    28,    81,    81,
-      94,    83,    84,    85,    86,    41,    77,    43,   228,    45,
-     233,   231,   151,    52,   203,    83,    84,    85,    86,     3,
-      33,    79,    80,    81,    82,    32,    84,    85,    41,    36,
-      37,    38,    39,    40,   181,   182,    79,    80,    15,   133,
-      25,    84,    25,    28,    81,    28,    79,    80,    15,   241,
-     242,   241,    81,    85,    86,    79,    80,    52,    71,    72,
-      73,    74,    75,    76,    77,    78,    81,   214,   215,   216,
-      83,    84,    85,    86,    24,    81,    26,    66,    67,    81,
-      52,    81,    81,    56,    34,    35,    57,    81,    81,    71,
-     237,   230,    25,    43,    25,    81,    26,    53,    61,    28,
-      81,    81,    81,    57,    34,    35,   253,    17,    57,    25,
-     249,    81,    81,    43,    71,    24,    28,   309,   310,   309,
-     310,     9,   269,    71,   263,   317,   318,   317,   318,    79,
-      80,    81,    82,    28,    84,    85,    24,    81,    26,   286,
-      25,    81,   236,    63,    28,    33,    34,    35,    10,    79,
-      80,    25,    82,    41,    84,    43,    28,    25,    41,    81,
-      24,     4,     6,    24,    11,    51,    24,    43,    79,    60,
-      57,    12,    54,    25,    25,    25,     6,    44,    79,    24,
-      28,    71,    63,    71,    72,    73,    74,    75,    76,    77,
-      78,    79,    80,    81,    82,    65,    84,    85,     7,     8,
-      71,    81,    28,    28,    70,    28,    66,    16,    17,    18,
-      19,    20,    21,    22,    23,    71,    71,    71,    67,    25,
-      29,    30,    31,    28,    81,    71,    68,    28,    68,    25,
-      69,    69,    17,   300,    71,    71,   194,    46,   225,    48,
-     262,   239,   183,    63,   203,   124,   242,    56,   226,   283,
-      59,   179,    -1,   254,    -1,    -1,   286
+       4,    60,    51,   106,   107,   111,   138,   140,     4,   111,
+      28,    24,     9,   145,    24,     5,    24,     4,    26,    14,
+      15,     4,     4,    24,    13,    81,    34,    35,    18,    85,
+      28,    79,    80,    54,    55,    43,    33,    24,    51,     4,
+      24,    62,   101,   102,   103,   104,     9,    51,    49,    81,
+      60,    40,    17,    42,    13,    53,    15,    41,    50,    43,
+       0,    45,   168,    81,    52,   114,    81,   116,   201,     4,
+      33,    79,    80,    81,    82,    64,    84,    85,    41,    62,
+      77,    81,    17,   142,    88,    81,    81,    83,    84,    85,
+      86,     3,    96,    83,    84,    85,    86,   230,    81,    81,
+     233,    81,   205,   235,   153,    64,   217,   218,    71,    72,
+      73,    74,    75,    76,    77,    78,    25,    15,    26,    28,
+      83,    84,    85,    86,   183,   184,    34,    35,   239,    79,
+      80,   135,    81,    25,    84,    43,    28,   243,   244,    15,
+      25,   243,    32,    28,   255,    81,    36,    37,    38,    39,
+      40,    81,    41,    81,    43,    52,    45,   216,   217,   218,
+      83,    84,    85,    86,    27,    28,    85,    86,    79,    80,
+      56,    79,    80,     9,    82,    81,    84,    54,    55,    52,
+     239,    81,    81,   232,    66,    67,    81,    71,    24,    57,
+      26,    25,    25,    81,    81,    53,   255,    33,    34,    35,
+      28,    81,   251,    81,    61,    41,    57,    43,    17,   315,
+     316,    81,   271,   315,   316,    57,   265,   323,   324,    81,
+      25,   323,   324,    24,    71,    28,    71,    81,    28,   288,
+      25,    81,    63,    10,   238,    71,    72,    73,    74,    75,
+      76,    77,    78,    79,    80,    81,    82,    17,    84,    85,
+      28,    25,    28,    41,    24,    81,    26,    25,    24,     4,
+      24,    11,     6,    24,    34,    35,    51,     7,     8,    79,
+      43,    60,    54,    43,    57,    12,    16,    17,    18,    19,
+      20,    21,    22,    23,    25,     6,    25,    25,    44,    29,
+      30,    31,    79,    65,    24,    28,    63,    81,    79,    79,
+      71,    28,    71,    28,    67,    70,    46,    66,    48,    79,
+      80,    81,    82,    71,    84,    85,    56,    71,    28,    59,
+      68,    81,    68,    28,    71,    28,    25,    69,    71,    25,
+      17,   306,   196,    69,   227,   264,    71,    71,   241,   244,
+     126,   185,    64,   285,   205,   228,   181,   288,    -1,   256
 };
 
 /* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
@@ -992,36 +1006,36 @@ static const yytype_uint8 yystos[] =
        0,     7,     8,    16,    17,    18,    19,    20,    21,    22,
       23,    29,    30,    31,    46,    48,    56,    59,    89,    90,
       91,    92,    93,    94,    95,    96,    97,    98,    99,   100,
-     101,   106,   107,   108,   109,   114,   122,   123,   126,   127,
-     146,   147,    13,    40,    42,    64,   102,    13,    15,    64,
-      24,    26,    34,    35,    43,    79,    80,    81,    82,    84,
-      85,   120,   128,   129,   131,   132,   133,   128,    81,    14,
-      15,    50,    52,    81,    81,    90,     0,     3,   148,    81,
-      15,    81,    15,    81,    81,    81,    17,   126,   128,    79,
-      80,    84,   116,   117,    24,    49,   129,     4,    81,    83,
-      84,    85,    86,   130,    52,    52,    81,    81,    56,    71,
-      24,    60,   121,    81,     4,    24,    81,    57,   128,    25,
-      25,    79,    80,    27,    28,   128,    81,    85,    81,   129,
-     129,   129,   129,    28,    81,   134,   135,   134,    24,    51,
-      53,   137,    81,   124,   125,    84,   119,   120,    81,   111,
-      61,     4,   126,    57,   126,    81,   105,    57,    81,   116,
-      25,   128,    62,   130,   137,   105,    24,   115,     9,    33,
-      41,    71,    72,    73,    74,    75,    76,    77,    78,   129,
-     138,   139,    71,    28,   137,    79,    80,    32,    36,    37,
-      38,    39,    40,   113,    28,   110,    71,   126,    81,    28,
-      25,    81,    63,    28,    10,   143,    25,   118,   119,    28,
-       9,    33,    77,    41,   139,    54,    55,   129,   129,   125,
-      24,    41,    43,    45,   112,   111,    25,    81,    24,   105,
-       4,    24,   134,   136,   134,   135,     6,    11,   144,    51,
-      25,    28,    24,   129,   138,   138,    79,    43,   110,   121,
-     105,   126,   105,    57,   137,   128,   138,    12,   140,   115,
-     119,   118,    25,     4,   126,    25,    25,   138,   143,     6,
-      44,   145,    25,   112,   126,    65,    62,   129,   141,   142,
-      79,    24,   104,    63,     5,    18,    28,    66,    67,   136,
-     141,    71,    71,    81,    70,   103,    28,    28,    67,    66,
-      71,    71,   103,    81,    25,    28,    28,    68,    68,    71,
-      71,   119,   119,    28,    28,    69,    69,    71,    71,   119,
-     119,    25,    25
+     101,   102,   107,   108,   109,   110,   115,   123,   124,   127,
+     128,   147,   148,    13,    40,    42,    64,   103,    13,    15,
+      64,    24,    26,    34,    35,    43,    79,    80,    81,    82,
+      84,    85,   121,   129,   130,   132,   133,   134,   129,    81,
+      14,    15,    81,    50,    52,    81,    81,    90,     0,     3,
+     149,    81,    15,    81,    15,    81,    81,    81,    17,   127,
+     129,    79,    80,    84,   117,   118,    24,    49,   130,     4,
+      81,    83,    84,    85,    86,   131,    52,    52,    81,    81,
+      56,    71,    24,    60,   122,    81,     4,    24,    81,    57,
+     129,    25,    25,    79,    80,    27,    28,   129,    81,    85,
+      81,   130,   130,   130,   130,    28,    81,   135,   136,   135,
+      24,    51,    53,   138,    81,   125,   126,    84,   120,   121,
+      81,   112,    61,     4,   127,    57,   127,    81,   106,    57,
+      81,   117,    25,   129,    62,   131,   138,   106,    24,   116,
+       9,    33,    41,    71,    72,    73,    74,    75,    76,    77,
+      78,   130,   139,   140,    71,    28,   138,    79,    80,    32,
+      36,    37,    38,    39,    40,   114,    28,   111,    71,   127,
+      81,    28,    25,    81,    63,    28,    10,   144,    25,   119,
+     120,    28,     9,    33,    77,    41,   140,    54,    55,   130,
+     130,   126,    24,    41,    43,    45,   113,   112,    25,    81,
+      24,   106,     4,    24,   135,   137,   135,   136,     6,    11,
+     145,    51,    25,    28,    24,   130,   139,   139,    79,    43,
+     111,   122,   106,   127,   106,    57,   138,   129,   139,    12,
+     141,   116,   120,   119,    25,     4,   127,    25,    25,   139,
+     144,     6,    44,   146,    25,   113,   127,    65,    62,   130,
+     142,   143,    79,    24,   105,    63,     5,    18,    28,    28,
+      81,    66,    67,   137,   142,    79,    79,    71,    71,    81,
+      70,   104,    28,    28,    67,    66,    71,    71,   104,    81,
+      25,    28,    28,    68,    68,    71,    71,   120,   120,    28,
+      28,    69,    69,    71,    71,   120,   120,    25,    25
 };
 
 /* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
@@ -1029,21 +1043,21 @@ static const yytype_uint8 yyr1[] =
 {
        0,    88,    89,    90,    90,    90,    90,    90,    90,    90,
       90,    90,    90,    90,    90,    90,    90,    90,    90,    90,
-      90,    90,    90,    90,    90,    91,    92,    93,    94,    95,
-      96,    97,    98,    99,   100,   101,   101,   102,   102,   103,
-     104,   104,   104,   105,   105,   106,   107,   107,   107,   107,
-     107,   108,   108,   109,   110,   110,   111,   111,   112,   112,
-     112,   112,   113,   113,   113,   113,   113,   113,   114,   114,
-     115,   115,   116,   116,   116,   116,   117,   117,   117,   118,
-     118,   118,   119,   119,   119,   120,   120,   120,   120,   120,
-     120,   120,   121,   121,   122,   123,   124,   124,   125,   126,
-     126,   127,   127,   128,   128,   128,   129,   129,   129,   129,
-     129,   129,   129,   129,   129,   129,   129,   129,   130,   130,
-     130,   131,   132,   133,   133,   134,   135,   135,   136,   136,
-     137,   137,   138,   138,   138,   138,   139,   139,   139,   139,
-     139,   139,   139,   139,   139,   139,   139,   139,   139,   139,
-     140,   140,   141,   141,   142,   142,   142,   143,   143,   144,
-     144,   145,   145,   146,   147,   148
+      90,    90,    90,    90,    90,    90,    91,    92,    93,    94,
+      95,    96,    97,    98,    99,   100,   101,   102,   102,   103,
+     103,   104,   105,   105,   105,   106,   106,   107,   108,   108,
+     108,   108,   108,   109,   109,   110,   111,   111,   112,   112,
+     113,   113,   113,   113,   114,   114,   114,   114,   114,   114,
+     115,   115,   116,   116,   117,   117,   117,   117,   118,   118,
+     118,   119,   119,   119,   120,   120,   120,   121,   121,   121,
+     121,   121,   121,   121,   122,   122,   123,   124,   125,   125,
+     126,   127,   127,   128,   128,   129,   129,   129,   130,   130,
+     130,   130,   130,   130,   130,   130,   130,   130,   130,   130,
+     131,   131,   131,   132,   133,   134,   134,   135,   136,   136,
+     137,   137,   138,   138,   139,   139,   139,   139,   140,   140,
+     140,   140,   140,   140,   140,   140,   140,   140,   140,   140,
+     140,   140,   141,   141,   142,   142,   143,   143,   143,   144,
+     144,   145,   145,   146,   146,   146,   146,   147,   148,   149
 };
 
 /* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
@@ -1052,20 +1066,20 @@ static const yytype_int8 yyr2[] =
        0,     2,     2,     1,     1,     1,     1,     1,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     3,     2,     2,     4,     9,    11,     1,     0,     1,
-       9,    17,    17,     1,     3,     5,    10,     9,     8,     6,
-       5,     5,     8,     3,     0,     3,     6,     3,     2,     1,
-       1,     0,     1,     1,     1,     1,     1,     1,     5,     8,
-       3,     5,     1,     2,     1,     2,     0,     1,     3,     0,
-       1,     3,     1,     2,     2,     1,     1,     1,     1,     1,
-       1,     3,     0,     4,     4,     5,     1,     3,     3,     9,
-       9,     2,     2,     0,     2,     4,     3,     3,     3,     3,
-       3,     2,     1,     1,     1,     3,     1,     1,     0,     1,
-       2,     4,     3,     1,     3,     1,     2,     4,     3,     6,
-       0,     2,     3,     2,     3,     3,     1,     1,     1,     1,
-       1,     1,     1,     2,     1,     2,     1,     2,     1,     2,
-       0,     3,     1,     3,     1,     2,     2,     0,     3,     0,
-       2,     0,     2,     2,     4,     1
+       1,     1,     3,     2,     2,     2,     4,     9,    11,     1,
+       0,     1,     9,    17,    17,     1,     3,     5,    10,     9,
+       8,     6,     5,     5,     8,     3,     0,     3,     6,     3,
+       2,     1,     1,     0,     1,     1,     1,     1,     1,     1,
+       5,     8,     3,     5,     1,     2,     1,     2,     0,     1,
+       3,     0,     1,     3,     1,     2,     2,     1,     1,     1,
+       1,     1,     1,     3,     0,     4,     4,     5,     1,     3,
+       3,     9,     9,     2,     2,     0,     2,     4,     3,     3,
+       3,     3,     3,     2,     1,     1,     1,     3,     1,     1,
+       0,     1,     2,     4,     3,     1,     3,     1,     2,     4,
+       3,     6,     0,     2,     3,     2,     3,     3,     1,     1,
+       1,     1,     1,     1,     1,     2,     1,     2,     1,     2,
+       1,     2,     0,     3,     1,     3,     1,     2,     2,     0,
+       3,     0,     2,     0,     2,     4,     4,     2,     4,     1
 };
 
 
@@ -1927,104 +1941,114 @@ yyreduce:
   switch (yyn)
     {
   case 2: /* commands: command_wrapper opt_semicolon  */
-#line 283 "yacc_sql.y"
+#line 297 "yacc_sql.y"
   {
     std::unique_ptr<ParsedSqlNode> sql_node = std::unique_ptr<ParsedSqlNode>((yyvsp[-1].sql_node));
     sql_result->add_sql_node(std::move(sql_node));
   }
-#line 1936 "yacc_sql.cpp"
+#line 1950 "yacc_sql.cpp"
     break;
 
-  case 25: /* exit_stmt: EXIT  */
-#line 315 "yacc_sql.y"
+  case 26: /* exit_stmt: EXIT  */
+#line 330 "yacc_sql.y"
          {
       (void)yynerrs;  // 这么写为了消除yynerrs未使用的告警。如果你有更好的方法欢迎提PR
       (yyval.sql_node) = new ParsedSqlNode(SCF_EXIT);
     }
-#line 1945 "yacc_sql.cpp"
+#line 1959 "yacc_sql.cpp"
     break;
 
-  case 26: /* help_stmt: HELP  */
-#line 321 "yacc_sql.y"
+  case 27: /* help_stmt: HELP  */
+#line 336 "yacc_sql.y"
          {
       (yyval.sql_node) = new ParsedSqlNode(SCF_HELP);
     }
-#line 1953 "yacc_sql.cpp"
+#line 1967 "yacc_sql.cpp"
     break;
 
-  case 27: /* sync_stmt: SYNC  */
-#line 326 "yacc_sql.y"
+  case 28: /* sync_stmt: SYNC  */
+#line 341 "yacc_sql.y"
          {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SYNC);
     }
-#line 1961 "yacc_sql.cpp"
+#line 1975 "yacc_sql.cpp"
     break;
 
-  case 28: /* begin_stmt: TRX_BEGIN  */
-#line 332 "yacc_sql.y"
+  case 29: /* begin_stmt: TRX_BEGIN  */
+#line 347 "yacc_sql.y"
                {
       (yyval.sql_node) = new ParsedSqlNode(SCF_BEGIN);
     }
-#line 1969 "yacc_sql.cpp"
+#line 1983 "yacc_sql.cpp"
     break;
 
-  case 29: /* commit_stmt: TRX_COMMIT  */
-#line 338 "yacc_sql.y"
+  case 30: /* commit_stmt: TRX_COMMIT  */
+#line 353 "yacc_sql.y"
                {
       (yyval.sql_node) = new ParsedSqlNode(SCF_COMMIT);
     }
-#line 1977 "yacc_sql.cpp"
+#line 1991 "yacc_sql.cpp"
     break;
 
-  case 30: /* rollback_stmt: TRX_ROLLBACK  */
-#line 344 "yacc_sql.y"
+  case 31: /* rollback_stmt: TRX_ROLLBACK  */
+#line 359 "yacc_sql.y"
                   {
       (yyval.sql_node) = new ParsedSqlNode(SCF_ROLLBACK);
     }
-#line 1985 "yacc_sql.cpp"
+#line 1999 "yacc_sql.cpp"
     break;
 
-  case 31: /* drop_table_stmt: DROP TABLE ID  */
-#line 350 "yacc_sql.y"
+  case 32: /* drop_table_stmt: DROP TABLE ID  */
+#line 365 "yacc_sql.y"
                   {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DROP_TABLE);
       (yyval.sql_node)->drop_table.relation_name = (yyvsp[0].string);
       free((yyvsp[0].string));
     }
-#line 1995 "yacc_sql.cpp"
+#line 2009 "yacc_sql.cpp"
     break;
 
-  case 32: /* show_tables_stmt: SHOW TABLES  */
-#line 357 "yacc_sql.y"
+  case 33: /* show_tables_stmt: SHOW TABLES  */
+#line 372 "yacc_sql.y"
                 {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SHOW_TABLES);
     }
-#line 2003 "yacc_sql.cpp"
+#line 2017 "yacc_sql.cpp"
     break;
 
-  case 33: /* desc_table_stmt: DESC ID  */
-#line 363 "yacc_sql.y"
+  case 34: /* show_status_stmt: SHOW ID  */
+#line 378 "yacc_sql.y"
+            {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_SHOW_STATUS);
+      (yyval.sql_node)->show_status.name = (yyvsp[0].string);
+      free((yyvsp[0].string));
+    }
+#line 2027 "yacc_sql.cpp"
+    break;
+
+  case 35: /* desc_table_stmt: DESC ID  */
+#line 386 "yacc_sql.y"
              {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DESC_TABLE);
       (yyval.sql_node)->desc_table.relation_name = (yyvsp[0].string);
       free((yyvsp[0].string));
     }
-#line 2013 "yacc_sql.cpp"
+#line 2037 "yacc_sql.cpp"
     break;
 
-  case 34: /* show_index_stmt: SHOW INDEX FROM relation  */
-#line 372 "yacc_sql.y"
+  case 36: /* show_index_stmt: SHOW INDEX FROM relation  */
+#line 395 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SHOW_INDEX);
       ShowIndexSqlNode &show_index = (yyval.sql_node)->show_index;
       show_index.relation_name = (yyvsp[0].string);
       free((yyvsp[0].string));
     }
-#line 2024 "yacc_sql.cpp"
+#line 2048 "yacc_sql.cpp"
     break;
 
-  case 35: /* create_index_stmt: CREATE opt_unique INDEX ID ON ID LBRACE attr_list RBRACE  */
-#line 382 "yacc_sql.y"
+  case 37: /* create_index_stmt: CREATE opt_unique INDEX ID ON ID LBRACE attr_list RBRACE  */
+#line 405 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_INDEX);
       CreateIndexSqlNode &create_index = (yyval.sql_node)->create_index;
@@ -2036,11 +2060,11 @@ yyreduce:
       free((yyvsp[-5].string));
       free((yyvsp[-3].string));
     }
-#line 2040 "yacc_sql.cpp"
+#line 2064 "yacc_sql.cpp"
     break;
 
-  case 36: /* create_index_stmt: CREATE VECTOR_T INDEX ID ON ID LBRACE attr_list RBRACE WITH vector_index_config  */
-#line 394 "yacc_sql.y"
+  case 38: /* create_index_stmt: CREATE VECTOR_T INDEX ID ON ID LBRACE attr_list RBRACE WITH vector_index_config  */
+#line 417 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_INDEX);
       CreateIndexSqlNode &create_index = (yyval.sql_node)->create_index;
@@ -2053,42 +2077,42 @@ yyreduce:
       free((yyvsp[-7].string));
       free((yyvsp[-5].string));
     }
-#line 2057 "yacc_sql.cpp"
+#line 2081 "yacc_sql.cpp"
     break;
 
-  case 37: /* opt_unique: UNIQUE  */
-#line 409 "yacc_sql.y"
+  case 39: /* opt_unique: UNIQUE  */
+#line 432 "yacc_sql.y"
            { (yyval.unique) = true; }
-#line 2063 "yacc_sql.cpp"
+#line 2087 "yacc_sql.cpp"
     break;
 
-  case 38: /* opt_unique: %empty  */
-#line 410 "yacc_sql.y"
+  case 40: /* opt_unique: %empty  */
+#line 433 "yacc_sql.y"
                 { (yyval.unique) = false; }
-#line 2069 "yacc_sql.cpp"
+#line 2093 "yacc_sql.cpp"
     break;
 
-  case 39: /* index_type: IVFFLAT  */
-#line 415 "yacc_sql.y"
+  case 41: /* index_type: IVFFLAT  */
+#line 438 "yacc_sql.y"
     {
       (yyval.index_type) = IndexType::VectorIVFFlatIndex;
     }
-#line 2077 "yacc_sql.cpp"
+#line 2101 "yacc_sql.cpp"
     break;
 
-  case 40: /* vector_index_config: LBRACE DISTANCE EQ ID COMMA TYPE EQ index_type RBRACE  */
-#line 422 "yacc_sql.y"
+  case 42: /* vector_index_config: LBRACE DISTANCE EQ ID COMMA TYPE EQ index_type RBRACE  */
+#line 445 "yacc_sql.y"
     {
       (yyval.vector_index_config) = new VectorIndexConfig;
       (yyval.vector_index_config)->distance_fn = (yyvsp[-5].string);
       (yyval.vector_index_config)->index_type = (yyvsp[-1].index_type);
       free((yyvsp[-5].string));
     }
-#line 2088 "yacc_sql.cpp"
+#line 2112 "yacc_sql.cpp"
     break;
 
-  case 41: /* vector_index_config: LBRACE DISTANCE EQ ID COMMA TYPE EQ index_type COMMA LISTS EQ value COMMA PROBES EQ value RBRACE  */
-#line 429 "yacc_sql.y"
+  case 43: /* vector_index_config: LBRACE DISTANCE EQ ID COMMA TYPE EQ index_type COMMA LISTS EQ value COMMA PROBES EQ value RBRACE  */
+#line 452 "yacc_sql.y"
     {
       (yyval.vector_index_config) = new VectorIndexConfig;
       (yyval.vector_index_config)->distance_fn = (yyvsp[-13].string);
@@ -2097,11 +2121,11 @@ yyreduce:
       (yyval.vector_index_config)->probes = std::move(*(yyvsp[-1].value));
       free((yyvsp[-13].string));
     }
-#line 2101 "yacc_sql.cpp"
+#line 2125 "yacc_sql.cpp"
     break;
 
-  case 42: /* vector_index_config: LBRACE TYPE EQ index_type COMMA DISTANCE EQ ID COMMA LISTS EQ value COMMA PROBES EQ value RBRACE  */
-#line 438 "yacc_sql.y"
+  case 44: /* vector_index_config: LBRACE TYPE EQ index_type COMMA DISTANCE EQ ID COMMA LISTS EQ value COMMA PROBES EQ value RBRACE  */
+#line 461 "yacc_sql.y"
     {
       (yyval.vector_index_config) = new VectorIndexConfig;
       (yyval.vector_index_config)->distance_fn = (yyvsp[-9].string);
@@ -2110,31 +2134,31 @@ yyreduce:
       (yyval.vector_index_config)->probes = std::move(*(yyvsp[-1].value));
       free((yyvsp[-9].string));
     }
-#line 2114 "yacc_sql.cpp"
+#line 2138 "yacc_sql.cpp"
     break;
 
-  case 43: /* attr_list: ID  */
-#line 450 "yacc_sql.y"
+  case 45: /* attr_list: ID  */
+#line 473 "yacc_sql.y"
     {
       (yyval.index_attr_list) = new std::vector<std::string>; // 创建一个新的 vector
       (yyval.index_attr_list)->emplace_back((yyvsp[0].string)); // 将列名加入 vector
       free((yyvsp[0].string));
     }
-#line 2124 "yacc_sql.cpp"
+#line 2148 "yacc_sql.cpp"
     break;
 
-  case 44: /* attr_list: ID COMMA attr_list  */
-#line 456 "yacc_sql.y"
+  case 46: /* attr_list: ID COMMA attr_list  */
+#line 479 "yacc_sql.y"
     {
       (yyval.index_attr_list) = (yyvsp[0].index_attr_list); // 使用现有的 vector
       (yyval.index_attr_list)->emplace((yyval.index_attr_list)->begin(), (yyvsp[-2].string)); // 将新列名加入 vector 开头
       free((yyvsp[-2].string));
     }
-#line 2134 "yacc_sql.cpp"
+#line 2158 "yacc_sql.cpp"
     break;
 
-  case 45: /* drop_index_stmt: DROP INDEX ID ON ID  */
-#line 465 "yacc_sql.y"
+  case 47: /* drop_index_stmt: DROP INDEX ID ON ID  */
+#line 488 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DROP_INDEX);
       (yyval.sql_node)->drop_index.index_name = (yyvsp[-2].string);
@@ -2142,51 +2166,51 @@ yyreduce:
       free((yyvsp[-2].string));
       free((yyvsp[0].string));
     }
-#line 2146 "yacc_sql.cpp"
+#line 2170 "yacc_sql.cpp"
     break;
 
-  case 46: /* create_table_stmt: CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE storage_format AS select_stmt  */
-#line 475 "yacc_sql.y"
+  case 48: /* create_table_stmt: CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE storage_format AS select_stmt  */
+#line 498 "yacc_sql.y"
     {
         (yyval.sql_node) = create_table_sql_node((yyvsp[-7].string), (yyvsp[-5].attr_info), (yyvsp[-4].attr_infos), (yyvsp[-2].string), (yyvsp[0].sql_node));
     }
-#line 2154 "yacc_sql.cpp"
+#line 2178 "yacc_sql.cpp"
     break;
 
-  case 47: /* create_table_stmt: CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE storage_format select_stmt  */
-#line 479 "yacc_sql.y"
+  case 49: /* create_table_stmt: CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE storage_format select_stmt  */
+#line 502 "yacc_sql.y"
     {
         (yyval.sql_node) = create_table_sql_node((yyvsp[-6].string), (yyvsp[-4].attr_info), (yyvsp[-3].attr_infos), (yyvsp[-1].string), (yyvsp[0].sql_node));
     }
-#line 2162 "yacc_sql.cpp"
+#line 2186 "yacc_sql.cpp"
     break;
 
-  case 48: /* create_table_stmt: CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE storage_format  */
-#line 483 "yacc_sql.y"
+  case 50: /* create_table_stmt: CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE storage_format  */
+#line 506 "yacc_sql.y"
     {
         (yyval.sql_node) = create_table_sql_node((yyvsp[-5].string), (yyvsp[-3].attr_info), (yyvsp[-2].attr_infos), (yyvsp[0].string), nullptr);
     }
-#line 2170 "yacc_sql.cpp"
+#line 2194 "yacc_sql.cpp"
     break;
 
-  case 49: /* create_table_stmt: CREATE TABLE ID storage_format AS select_stmt  */
-#line 487 "yacc_sql.y"
+  case 51: /* create_table_stmt: CREATE TABLE ID storage_format AS select_stmt  */
+#line 510 "yacc_sql.y"
     {
         (yyval.sql_node) = create_table_sql_node((yyvsp[-3].string), nullptr, nullptr, (yyvsp[-2].string), (yyvsp[0].sql_node));
     }
-#line 2178 "yacc_sql.cpp"
+#line 2202 "yacc_sql.cpp"
     break;
 
-  case 50: /* create_table_stmt: CREATE TABLE ID storage_format select_stmt  */
-#line 491 "yacc_sql.y"
+  case 52: /* create_table_stmt: CREATE TABLE ID storage_format select_stmt  */
+#line 514 "yacc_sql.y"
     {
       (yyval.sql_node) = create_table_sql_node((yyvsp[-2].string), nullptr, nullptr, (yyvsp[-1].string), (yyvsp[0].sql_node));
     }
-#line 2186 "yacc_sql.cpp"
+#line 2210 "yacc_sql.cpp"
     break;
 
-  case 51: /* create_view_stmt: CREATE VIEW ID AS select_stmt  */
-#line 498 "yacc_sql.y"
+  case 53: /* create_view_stmt: CREATE VIEW ID AS select_stmt  */
+#line 521 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_VIEW);
       CreateViewSqlNode &create_view = (yyval.sql_node)->create_view;
@@ -2194,11 +2218,11 @@ yyreduce:
       create_view.create_view_select = std::make_unique<SelectSqlNode>(std::move((yyvsp[0].sql_node)->selection));
       free((yyvsp[-2].string));
     }
-#line 2198 "yacc_sql.cpp"
+#line 2222 "yacc_sql.cpp"
     break;
 
-  case 52: /* create_view_stmt: CREATE VIEW ID LBRACE attr_list RBRACE AS select_stmt  */
-#line 506 "yacc_sql.y"
+  case 54: /* create_view_stmt: CREATE VIEW ID LBRACE attr_list RBRACE AS select_stmt  */
+#line 529 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_VIEW);
       CreateViewSqlNode &create_view = (yyval.sql_node)->create_view;
@@ -2207,29 +2231,29 @@ yyreduce:
       create_view.create_view_select = std::make_unique<SelectSqlNode>(std::move((yyvsp[0].sql_node)->selection));
       free((yyvsp[-5].string));
     }
-#line 2211 "yacc_sql.cpp"
+#line 2235 "yacc_sql.cpp"
     break;
 
-  case 53: /* drop_view_stmt: DROP VIEW ID  */
-#line 518 "yacc_sql.y"
+  case 55: /* drop_view_stmt: DROP VIEW ID  */
+#line 541 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DROP_VIEW);
       (yyval.sql_node)->drop_view.relation_name = (yyvsp[0].string);
       free((yyvsp[0].string));
     }
-#line 2221 "yacc_sql.cpp"
+#line 2245 "yacc_sql.cpp"
     break;
 
-  case 54: /* attr_def_list: %empty  */
-#line 527 "yacc_sql.y"
+  case 56: /* attr_def_list: %empty  */
+#line 550 "yacc_sql.y"
     {
       (yyval.attr_infos) = nullptr;
     }
-#line 2229 "yacc_sql.cpp"
+#line 2253 "yacc_sql.cpp"
     break;
 
-  case 55: /* attr_def_list: COMMA attr_def attr_def_list  */
-#line 531 "yacc_sql.y"
+  case 57: /* attr_def_list: COMMA attr_def attr_def_list  */
+#line 554 "yacc_sql.y"
     {
       if ((yyvsp[0].attr_infos) != nullptr) {
         (yyval.attr_infos) = (yyvsp[0].attr_infos);
@@ -2239,11 +2263,11 @@ yyreduce:
       (yyval.attr_infos)->emplace_back(*(yyvsp[-1].attr_info));
       delete (yyvsp[-1].attr_info);
     }
-#line 2243 "yacc_sql.cpp"
+#line 2267 "yacc_sql.cpp"
     break;
 
-  case 56: /* attr_def: ID type LBRACE NUMBER RBRACE nullable_constraint  */
-#line 544 "yacc_sql.y"
+  case 58: /* attr_def: ID type LBRACE NUMBER RBRACE nullable_constraint  */
+#line 567 "yacc_sql.y"
     {
       (yyval.attr_info) = new AttrInfoSqlNode;
       (yyval.attr_info)->name = (yyvsp[-5].string);
@@ -2261,11 +2285,11 @@ yyreduce:
       }
       free((yyvsp[-5].string));
     }
-#line 2265 "yacc_sql.cpp"
+#line 2289 "yacc_sql.cpp"
     break;
 
-  case 57: /* attr_def: ID type nullable_constraint  */
-#line 562 "yacc_sql.y"
+  case 59: /* attr_def: ID type nullable_constraint  */
+#line 585 "yacc_sql.y"
     {
       (yyval.attr_info) = new AttrInfoSqlNode;
       (yyval.attr_info)->type = (AttrType)(yyvsp[-1].number);
@@ -2291,79 +2315,79 @@ yyreduce:
       }
       free((yyvsp[-2].string));
     }
-#line 2295 "yacc_sql.cpp"
+#line 2319 "yacc_sql.cpp"
     break;
 
-  case 58: /* nullable_constraint: NOT NULL_T  */
-#line 591 "yacc_sql.y"
+  case 60: /* nullable_constraint: NOT NULL_T  */
+#line 614 "yacc_sql.y"
     {
       (yyval.nullable_info) = false;  // NOT NULL 对应的可空性为 false
     }
-#line 2303 "yacc_sql.cpp"
+#line 2327 "yacc_sql.cpp"
     break;
 
-  case 59: /* nullable_constraint: NULLABLE  */
-#line 595 "yacc_sql.y"
+  case 61: /* nullable_constraint: NULLABLE  */
+#line 618 "yacc_sql.y"
     {
       (yyval.nullable_info) = true;  // NULLABLE 对应的可空性为 true 2022
     }
-#line 2311 "yacc_sql.cpp"
+#line 2335 "yacc_sql.cpp"
     break;
 
-  case 60: /* nullable_constraint: NULL_T  */
-#line 599 "yacc_sql.y"
+  case 62: /* nullable_constraint: NULL_T  */
+#line 622 "yacc_sql.y"
     {
       (yyval.nullable_info) = true;  // NULL 对应的可空性也为 true 2023
     }
-#line 2319 "yacc_sql.cpp"
+#line 2343 "yacc_sql.cpp"
     break;
 
-  case 61: /* nullable_constraint: %empty  */
-#line 603 "yacc_sql.y"
+  case 63: /* nullable_constraint: %empty  */
+#line 626 "yacc_sql.y"
     {
       (yyval.nullable_info) = true;  // 默认情况为 NULL
     }
-#line 2327 "yacc_sql.cpp"
+#line 2351 "yacc_sql.cpp"
     break;
 
-  case 62: /* type: INT_T  */
-#line 609 "yacc_sql.y"
+  case 64: /* type: INT_T  */
+#line 632 "yacc_sql.y"
                  { (yyval.number) = static_cast<int>(AttrType::INTS);   }
-#line 2333 "yacc_sql.cpp"
+#line 2357 "yacc_sql.cpp"
     break;
 
-  case 63: /* type: STRING_T  */
-#line 610 "yacc_sql.y"
+  case 65: /* type: STRING_T  */
+#line 633 "yacc_sql.y"
                  { (yyval.number) = static_cast<int>(AttrType::CHARS);  }
-#line 2339 "yacc_sql.cpp"
+#line 2363 "yacc_sql.cpp"
     break;
 
-  case 64: /* type: FLOAT_T  */
-#line 611 "yacc_sql.y"
+  case 66: /* type: FLOAT_T  */
+#line 634 "yacc_sql.y"
                  { (yyval.number) = static_cast<int>(AttrType::FLOATS); }
-#line 2345 "yacc_sql.cpp"
+#line 2369 "yacc_sql.cpp"
     break;
 
-  case 65: /* type: DATE_T  */
-#line 612 "yacc_sql.y"
+  case 67: /* type: DATE_T  */
+#line 635 "yacc_sql.y"
                  { (yyval.number) = static_cast<int>(AttrType::DATES);  }
-#line 2351 "yacc_sql.cpp"
+#line 2375 "yacc_sql.cpp"
     break;
 
-  case 66: /* type: TEXT_T  */
-#line 613 "yacc_sql.y"
+  case 68: /* type: TEXT_T  */
+#line 636 "yacc_sql.y"
                  { (yyval.number) = static_cast<int>(AttrType::TEXTS);  }
-#line 2357 "yacc_sql.cpp"
+#line 2381 "yacc_sql.cpp"
     break;
 
-  case 67: /* type: VECTOR_T  */
-#line 614 "yacc_sql.y"
+  case 69: /* type: VECTOR_T  */
+#line 637 "yacc_sql.y"
                  { (yyval.number) = static_cast<int>(AttrType::VECTORS);  }
-#line 2363 "yacc_sql.cpp"
+#line 2387 "yacc_sql.cpp"
     break;
 
-  case 68: /* insert_stmt: INSERT INTO ID VALUES values_list  */
-#line 619 "yacc_sql.y"
+  case 70: /* insert_stmt: INSERT INTO ID VALUES values_list  */
+#line 642 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_INSERT);
       (yyval.sql_node)->insertion.relation_name = (yyvsp[-2].string);
@@ -2373,11 +2397,11 @@ yyreduce:
       }
       free((yyvsp[-2].string));
     }
-#line 2377 "yacc_sql.cpp"
+#line 2401 "yacc_sql.cpp"
     break;
 
-  case 69: /* insert_stmt: INSERT INTO ID LBRACE attr_list RBRACE VALUES values_list  */
-#line 629 "yacc_sql.y"
+  case 71: /* insert_stmt: INSERT INTO ID LBRACE attr_list RBRACE VALUES values_list  */
+#line 652 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_INSERT);
       (yyval.sql_node)->insertion.relation_name = (yyvsp[-5].string);
@@ -2388,217 +2412,217 @@ yyreduce:
       }
       free((yyvsp[-5].string));
     }
-#line 2392 "yacc_sql.cpp"
+#line 2416 "yacc_sql.cpp"
     break;
 
-  case 70: /* values_list: LBRACE value_list RBRACE  */
-#line 643 "yacc_sql.y"
+  case 72: /* values_list: LBRACE value_list RBRACE  */
+#line 666 "yacc_sql.y"
     {
       (yyval.values_list) = new std::vector<std::vector<Value>>;
       (yyval.values_list)->emplace_back(*(yyvsp[-1].value_list));
       delete (yyvsp[-1].value_list);
     }
-#line 2402 "yacc_sql.cpp"
+#line 2426 "yacc_sql.cpp"
     break;
 
-  case 71: /* values_list: values_list COMMA LBRACE value_list RBRACE  */
-#line 649 "yacc_sql.y"
+  case 73: /* values_list: values_list COMMA LBRACE value_list RBRACE  */
+#line 672 "yacc_sql.y"
     {
       (yyval.values_list)->emplace_back(*(yyvsp[-1].value_list));
       delete (yyvsp[-1].value_list);
     }
-#line 2411 "yacc_sql.cpp"
+#line 2435 "yacc_sql.cpp"
     break;
 
-  case 72: /* digits: NUMBER  */
-#line 656 "yacc_sql.y"
+  case 74: /* digits: NUMBER  */
+#line 679 "yacc_sql.y"
     {
       (yyval.digits) = float((yyvsp[0].number));
     }
-#line 2419 "yacc_sql.cpp"
+#line 2443 "yacc_sql.cpp"
     break;
 
-  case 73: /* digits: '-' NUMBER  */
-#line 660 "yacc_sql.y"
+  case 75: /* digits: '-' NUMBER  */
+#line 683 "yacc_sql.y"
     {
       (yyval.digits) = float(-(yyvsp[0].number));
     }
-#line 2427 "yacc_sql.cpp"
+#line 2451 "yacc_sql.cpp"
     break;
 
-  case 74: /* digits: FLOAT  */
-#line 664 "yacc_sql.y"
+  case 76: /* digits: FLOAT  */
+#line 687 "yacc_sql.y"
     {
       (yyval.digits) = (yyvsp[0].floats);
     }
-#line 2435 "yacc_sql.cpp"
+#line 2459 "yacc_sql.cpp"
     break;
 
-  case 75: /* digits: '-' FLOAT  */
-#line 668 "yacc_sql.y"
+  case 77: /* digits: '-' FLOAT  */
+#line 691 "yacc_sql.y"
     {
       (yyval.digits) = (yyvsp[0].floats);
     }
-#line 2443 "yacc_sql.cpp"
+#line 2467 "yacc_sql.cpp"
     break;
 
-  case 76: /* digits_list: %empty  */
-#line 675 "yacc_sql.y"
+  case 78: /* digits_list: %empty  */
+#line 698 "yacc_sql.y"
     {
       (yyval.digits_list) = new std::vector<float>();
     }
-#line 2451 "yacc_sql.cpp"
+#line 2475 "yacc_sql.cpp"
     break;
 
-  case 77: /* digits_list: digits  */
-#line 679 "yacc_sql.y"
+  case 79: /* digits_list: digits  */
+#line 702 "yacc_sql.y"
     {
       (yyval.digits_list) = new std::vector<float>();
       (yyval.digits_list)->push_back((yyvsp[0].digits));
     }
-#line 2460 "yacc_sql.cpp"
+#line 2484 "yacc_sql.cpp"
     break;
 
-  case 78: /* digits_list: digits_list COMMA digits  */
-#line 684 "yacc_sql.y"
+  case 80: /* digits_list: digits_list COMMA digits  */
+#line 707 "yacc_sql.y"
     {
       (yyval.digits_list)->push_back((yyvsp[0].digits));
     }
-#line 2468 "yacc_sql.cpp"
+#line 2492 "yacc_sql.cpp"
     break;
 
-  case 79: /* value_list: %empty  */
-#line 691 "yacc_sql.y"
+  case 81: /* value_list: %empty  */
+#line 714 "yacc_sql.y"
     {
       (yyval.value_list) = new std::vector<Value>;
     }
-#line 2476 "yacc_sql.cpp"
+#line 2500 "yacc_sql.cpp"
     break;
 
-  case 80: /* value_list: value  */
-#line 695 "yacc_sql.y"
+  case 82: /* value_list: value  */
+#line 718 "yacc_sql.y"
     {
       (yyval.value_list) = new std::vector<Value>;
       (yyval.value_list)->emplace_back(*(yyvsp[0].value));
       delete (yyvsp[0].value);
     }
-#line 2486 "yacc_sql.cpp"
+#line 2510 "yacc_sql.cpp"
     break;
 
-  case 81: /* value_list: value_list COMMA value  */
-#line 701 "yacc_sql.y"
+  case 83: /* value_list: value_list COMMA value  */
+#line 724 "yacc_sql.y"
     {
       (yyval.value_list)->emplace_back(*(yyvsp[0].value));
       delete (yyvsp[0].value);
     }
-#line 2495 "yacc_sql.cpp"
+#line 2519 "yacc_sql.cpp"
     break;
 
-  case 82: /* value: nonnegative_value  */
-#line 708 "yacc_sql.y"
+  case 84: /* value: nonnegative_value  */
+#line 731 "yacc_sql.y"
                       {
       (yyval.value) = (yyvsp[0].value);
     }
-#line 2503 "yacc_sql.cpp"
+#line 2527 "yacc_sql.cpp"
     break;
 
-  case 83: /* value: '-' NUMBER  */
-#line 711 "yacc_sql.y"
+  case 85: /* value: '-' NUMBER  */
+#line 734 "yacc_sql.y"
                  {
       (yyval.value) = new Value(-(yyvsp[0].number));
       (yyloc) = (yylsp[-1]);
     }
-#line 2512 "yacc_sql.cpp"
+#line 2536 "yacc_sql.cpp"
     break;
 
-  case 84: /* value: '-' FLOAT  */
-#line 715 "yacc_sql.y"
+  case 86: /* value: '-' FLOAT  */
+#line 738 "yacc_sql.y"
                 {
       (yyval.value) = new Value(-(yyvsp[0].floats));
       (yyloc) = (yylsp[-1]);
     }
-#line 2521 "yacc_sql.cpp"
+#line 2545 "yacc_sql.cpp"
     break;
 
-  case 85: /* nonnegative_value: NUMBER  */
-#line 722 "yacc_sql.y"
+  case 87: /* nonnegative_value: NUMBER  */
+#line 745 "yacc_sql.y"
            {
       (yyval.value) = new Value((yyvsp[0].number));
       (yyloc) = (yylsp[0]);
     }
-#line 2530 "yacc_sql.cpp"
+#line 2554 "yacc_sql.cpp"
     break;
 
-  case 86: /* nonnegative_value: FLOAT  */
-#line 726 "yacc_sql.y"
+  case 88: /* nonnegative_value: FLOAT  */
+#line 749 "yacc_sql.y"
             {
       (yyval.value) = new Value((yyvsp[0].floats));
       (yyloc) = (yylsp[0]);
     }
-#line 2539 "yacc_sql.cpp"
+#line 2563 "yacc_sql.cpp"
     break;
 
-  case 87: /* nonnegative_value: SSS  */
-#line 730 "yacc_sql.y"
+  case 89: /* nonnegative_value: SSS  */
+#line 753 "yacc_sql.y"
           {
       char *tmp = common::substr((yyvsp[0].string),1,strlen((yyvsp[0].string))-2);
       (yyval.value) = new Value(tmp);
       free(tmp);
       free((yyvsp[0].string));
     }
-#line 2550 "yacc_sql.cpp"
+#line 2574 "yacc_sql.cpp"
     break;
 
-  case 88: /* nonnegative_value: TRUE  */
-#line 736 "yacc_sql.y"
+  case 90: /* nonnegative_value: TRUE  */
+#line 759 "yacc_sql.y"
            {
       (yyval.value) = new Value(true);
     }
-#line 2558 "yacc_sql.cpp"
+#line 2582 "yacc_sql.cpp"
     break;
 
-  case 89: /* nonnegative_value: FALSE  */
-#line 739 "yacc_sql.y"
+  case 91: /* nonnegative_value: FALSE  */
+#line 762 "yacc_sql.y"
             {
       (yyval.value) = new Value(false);
     }
-#line 2566 "yacc_sql.cpp"
+#line 2590 "yacc_sql.cpp"
     break;
 
-  case 90: /* nonnegative_value: NULL_T  */
-#line 742 "yacc_sql.y"
+  case 92: /* nonnegative_value: NULL_T  */
+#line 765 "yacc_sql.y"
              {
       (yyval.value) = new Value(NullValue());
     }
-#line 2574 "yacc_sql.cpp"
+#line 2598 "yacc_sql.cpp"
     break;
 
-  case 91: /* nonnegative_value: LSBRACE digits_list RSBRACE  */
-#line 745 "yacc_sql.y"
+  case 93: /* nonnegative_value: LSBRACE digits_list RSBRACE  */
+#line 768 "yacc_sql.y"
                                   {
       (yyval.value) = new Value(*(yyvsp[-1].digits_list));
     }
-#line 2582 "yacc_sql.cpp"
+#line 2606 "yacc_sql.cpp"
     break;
 
-  case 92: /* storage_format: %empty  */
-#line 752 "yacc_sql.y"
+  case 94: /* storage_format: %empty  */
+#line 775 "yacc_sql.y"
     {
       (yyval.string) = nullptr;
     }
-#line 2590 "yacc_sql.cpp"
+#line 2614 "yacc_sql.cpp"
     break;
 
-  case 93: /* storage_format: STORAGE FORMAT EQ ID  */
-#line 756 "yacc_sql.y"
+  case 95: /* storage_format: STORAGE FORMAT EQ ID  */
+#line 779 "yacc_sql.y"
     {
       (yyval.string) = (yyvsp[0].string);
     }
-#line 2598 "yacc_sql.cpp"
+#line 2622 "yacc_sql.cpp"
     break;
 
-  case 94: /* delete_stmt: DELETE FROM ID where  */
-#line 763 "yacc_sql.y"
+  case 96: /* delete_stmt: DELETE FROM ID where  */
+#line 786 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DELETE);
       (yyval.sql_node)->deletion.relation_name = (yyvsp[-1].string);
@@ -2607,11 +2631,11 @@ yyreduce:
       }
       free((yyvsp[-1].string));
     }
-#line 2611 "yacc_sql.cpp"
+#line 2635 "yacc_sql.cpp"
     break;
 
-  case 95: /* update_stmt: UPDATE ID SET set_clauses where  */
-#line 775 "yacc_sql.y"
+  case 97: /* update_stmt: UPDATE ID SET set_clauses where  */
+#line 798 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_UPDATE);
       (yyval.sql_node)->update.relation_name = (yyvsp[-3].string);
@@ -2622,39 +2646,39 @@ yyreduce:
       free((yyvsp[-3].string));
       delete (yyvsp[-1].set_clauses);
     }
-#line 2626 "yacc_sql.cpp"
+#line 2650 "yacc_sql.cpp"
     break;
 
-  case 96: /* set_clauses: set_clause  */
-#line 789 "yacc_sql.y"
+  case 98: /* set_clauses: set_clause  */
+#line 812 "yacc_sql.y"
     {
       (yyval.set_clauses) = new std::vector<SetClauseSqlNode>;
       (yyval.set_clauses)->emplace_back(std::move(*(yyvsp[0].set_clause)));
     }
-#line 2635 "yacc_sql.cpp"
+#line 2659 "yacc_sql.cpp"
     break;
 
-  case 97: /* set_clauses: set_clauses COMMA set_clause  */
-#line 794 "yacc_sql.y"
+  case 99: /* set_clauses: set_clauses COMMA set_clause  */
+#line 817 "yacc_sql.y"
     {
       (yyval.set_clauses)->emplace_back(std::move(*(yyvsp[0].set_clause)));
     }
-#line 2643 "yacc_sql.cpp"
+#line 2667 "yacc_sql.cpp"
     break;
 
-  case 98: /* set_clause: ID EQ expression  */
-#line 801 "yacc_sql.y"
+  case 100: /* set_clause: ID EQ expression  */
+#line 824 "yacc_sql.y"
     {
       (yyval.set_clause) = new SetClauseSqlNode;
       (yyval.set_clause)->field_name = (yyvsp[-2].string);
       (yyval.set_clause)->value = std::unique_ptr<Expression>((yyvsp[0].expression));
       free((yyvsp[-2].string));
     }
-#line 2654 "yacc_sql.cpp"
+#line 2678 "yacc_sql.cpp"
     break;
 
-  case 99: /* select_stmt: SELECT expression_list FROM rel_list where group_by opt_having opt_order_by opt_limit  */
-#line 811 "yacc_sql.y"
+  case 101: /* select_stmt: SELECT expression_list FROM rel_list where group_by opt_having opt_order_by opt_limit  */
+#line 834 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SELECT);
       if ((yyvsp[-7].expression_list) != nullptr) {
@@ -2692,11 +2716,11 @@ yyreduce:
         delete (yyvsp[0].limited_info);
       }
     }
-#line 2696 "yacc_sql.cpp"
+#line 2720 "yacc_sql.cpp"
     break;
 
-  case 100: /* select_stmt: SELECT expression_list FROM relation INNER JOIN join_clauses where group_by  */
-#line 849 "yacc_sql.y"
+  case 102: /* select_stmt: SELECT expression_list FROM relation INNER JOIN join_clauses where group_by  */
+#line 872 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SELECT);
       if ((yyvsp[-7].expression_list) != nullptr) {
@@ -2726,39 +2750,39 @@ yyreduce:
         delete (yyvsp[0].expression_list);
       }
     }
-#line 2730 "yacc_sql.cpp"
+#line 2754 "yacc_sql.cpp"
     break;
 
-  case 101: /* calc_stmt: CALC expression_list  */
-#line 882 "yacc_sql.y"
+  case 103: /* calc_stmt: CALC expression_list  */
+#line 905 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CALC);
       (yyval.sql_node)->calc.expressions.swap(*(yyvsp[0].expression_list));
       delete (yyvsp[0].expression_list);
     }
-#line 2740 "yacc_sql.cpp"
+#line 2764 "yacc_sql.cpp"
     break;
 
-  case 102: /* calc_stmt: SELECT expression_list  */
-#line 888 "yacc_sql.y"
+  case 104: /* calc_stmt: SELECT expression_list  */
+#line 911 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CALC);
       (yyval.sql_node)->calc.expressions.swap(*(yyvsp[0].expression_list));
       delete (yyvsp[0].expression_list);
     }
-#line 2750 "yacc_sql.cpp"
+#line 2774 "yacc_sql.cpp"
     break;
 
-  case 103: /* expression_list: %empty  */
-#line 896 "yacc_sql.y"
+  case 105: /* expression_list: %empty  */
+#line 919 "yacc_sql.y"
                 {
       (yyval.expression_list) = new std::vector<std::unique_ptr<Expression>>;
     }
-#line 2758 "yacc_sql.cpp"
+#line 2782 "yacc_sql.cpp"
     break;
 
-  case 104: /* expression_list: expression alias  */
-#line 900 "yacc_sql.y"
+  case 106: /* expression_list: expression alias  */
+#line 923 "yacc_sql.y"
     {
       (yyval.expression_list) = new std::vector<std::unique_ptr<Expression>>;
       if (nullptr != (yyvsp[0].string)) {
@@ -2767,11 +2791,11 @@ yyreduce:
       (yyval.expression_list)->emplace_back((yyvsp[-1].expression));
       free((yyvsp[0].string));
     }
-#line 2771 "yacc_sql.cpp"
+#line 2795 "yacc_sql.cpp"
     break;
 
-  case 105: /* expression_list: expression alias COMMA expression_list  */
-#line 909 "yacc_sql.y"
+  case 107: /* expression_list: expression alias COMMA expression_list  */
+#line 932 "yacc_sql.y"
     {
       if ((yyvsp[0].expression_list) != nullptr) {
         (yyval.expression_list) = (yyvsp[0].expression_list);
@@ -2784,43 +2808,43 @@ yyreduce:
       (yyval.expression_list)->emplace((yyval.expression_list)->begin(),std::move((yyvsp[-3].expression)));
       free((yyvsp[-2].string));
     }
-#line 2788 "yacc_sql.cpp"
+#line 2812 "yacc_sql.cpp"
     break;
 
-  case 106: /* expression: expression '+' expression  */
-#line 924 "yacc_sql.y"
+  case 108: /* expression: expression '+' expression  */
+#line 947 "yacc_sql.y"
                               {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::ADD, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2796 "yacc_sql.cpp"
+#line 2820 "yacc_sql.cpp"
     break;
 
-  case 107: /* expression: expression '-' expression  */
-#line 927 "yacc_sql.y"
+  case 109: /* expression: expression '-' expression  */
+#line 950 "yacc_sql.y"
                                 {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::SUB, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2804 "yacc_sql.cpp"
+#line 2828 "yacc_sql.cpp"
     break;
 
-  case 108: /* expression: expression '*' expression  */
-#line 930 "yacc_sql.y"
+  case 110: /* expression: expression '*' expression  */
+#line 953 "yacc_sql.y"
                                 {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::MUL, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2812 "yacc_sql.cpp"
+#line 2836 "yacc_sql.cpp"
     break;
 
-  case 109: /* expression: expression '/' expression  */
-#line 933 "yacc_sql.y"
+  case 111: /* expression: expression '/' expression  */
+#line 956 "yacc_sql.y"
                                 {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::DIV, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2820 "yacc_sql.cpp"
+#line 2844 "yacc_sql.cpp"
     break;
 
-  case 110: /* expression: LBRACE expression_list RBRACE  */
-#line 936 "yacc_sql.y"
+  case 112: /* expression: LBRACE expression_list RBRACE  */
+#line 959 "yacc_sql.y"
                                     {
       if ((yyvsp[-1].expression_list)->size() == 1) {
         (yyval.expression) = (yyvsp[-1].expression_list)->front().get();
@@ -2829,123 +2853,121 @@ yyreduce:
       }
       (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
     }
-#line 2833 "yacc_sql.cpp"
+#line 2857 "yacc_sql.cpp"
     break;
 
-  case 111: /* expression: '-' expression  */
-#line 944 "yacc_sql.y"
+  case 113: /* expression: '-' expression  */
+#line 967 "yacc_sql.y"
                                   {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::NEGATIVE, (yyvsp[0].expression), nullptr, sql_string, &(yyloc));
     }
-#line 2841 "yacc_sql.cpp"
+#line 2865 "yacc_sql.cpp"
     break;
 
-  case 112: /* expression: nonnegative_value  */
-#line 947 "yacc_sql.y"
+  case 114: /* expression: nonnegative_value  */
+#line 970 "yacc_sql.y"
                         {
-      (yyval.expression) = new ValueExpr(*(yyvsp[0].value));
-      (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
-      delete (yyvsp[0].value);
+      (yyval.expression) = create_value_expression((yyvsp[0].value), sql_result, sql_string, &(yyloc));
     }
-#line 2851 "yacc_sql.cpp"
+#line 2873 "yacc_sql.cpp"
     break;
 
-  case 113: /* expression: rel_attr  */
-#line 952 "yacc_sql.y"
+  case 115: /* expression: rel_attr  */
+#line 973 "yacc_sql.y"
                {
       RelAttrSqlNode *node = (yyvsp[0].rel_attr);
       (yyval.expression) = new UnboundFieldExpr(node->relation_name, node->attribute_name);
       (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
       delete (yyvsp[0].rel_attr);
     }
-#line 2862 "yacc_sql.cpp"
+#line 2884 "yacc_sql.cpp"
     break;
 
-  case 114: /* expression: '*'  */
-#line 958 "yacc_sql.y"
+  case 116: /* expression: '*'  */
+#line 979 "yacc_sql.y"
           {
       (yyval.expression) = new StarExpr();
     }
-#line 2870 "yacc_sql.cpp"
+#line 2892 "yacc_sql.cpp"
     break;
 
-  case 115: /* expression: ID DOT '*'  */
-#line 961 "yacc_sql.y"
+  case 117: /* expression: ID DOT '*'  */
+#line 982 "yacc_sql.y"
                  {
       (yyval.expression) = new StarExpr((yyvsp[-2].string));
     }
-#line 2878 "yacc_sql.cpp"
+#line 2900 "yacc_sql.cpp"
     break;
 
-  case 116: /* expression: func_expr  */
-#line 964 "yacc_sql.y"
+  case 118: /* expression: func_expr  */
+#line 985 "yacc_sql.y"
                 {
       (yyval.expression) = (yyvsp[0].expression);      // AggrFuncExpr
     }
-#line 2886 "yacc_sql.cpp"
+#line 2908 "yacc_sql.cpp"
     break;
 
-  case 117: /* expression: sub_query_expr  */
-#line 967 "yacc_sql.y"
+  case 119: /* expression: sub_query_expr  */
+#line 988 "yacc_sql.y"
                      {
       (yyval.expression) = (yyvsp[0].expression); // SubQueryExpr
     }
-#line 2894 "yacc_sql.cpp"
+#line 2916 "yacc_sql.cpp"
     break;
 
-  case 118: /* alias: %empty  */
-#line 974 "yacc_sql.y"
+  case 120: /* alias: %empty  */
+#line 995 "yacc_sql.y"
                 {
       (yyval.string) = nullptr;
     }
-#line 2902 "yacc_sql.cpp"
+#line 2924 "yacc_sql.cpp"
     break;
 
-  case 119: /* alias: ID  */
-#line 977 "yacc_sql.y"
+  case 121: /* alias: ID  */
+#line 998 "yacc_sql.y"
          {
       (yyval.string) = (yyvsp[0].string);
     }
-#line 2910 "yacc_sql.cpp"
+#line 2932 "yacc_sql.cpp"
     break;
 
-  case 120: /* alias: AS ID  */
-#line 980 "yacc_sql.y"
+  case 122: /* alias: AS ID  */
+#line 1001 "yacc_sql.y"
             {
       (yyval.string) = (yyvsp[0].string);
     }
-#line 2918 "yacc_sql.cpp"
+#line 2940 "yacc_sql.cpp"
     break;
 
-  case 121: /* func_expr: ID LBRACE expression_list RBRACE  */
-#line 986 "yacc_sql.y"
+  case 123: /* func_expr: ID LBRACE expression_list RBRACE  */
+#line 1007 "yacc_sql.y"
     {
         (yyval.expression) = new UnboundFunctionExpr((yyvsp[-3].string), std::move(*(yyvsp[-1].expression_list)));
         (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
     }
-#line 2927 "yacc_sql.cpp"
+#line 2949 "yacc_sql.cpp"
     break;
 
-  case 122: /* sub_query_expr: LBRACE select_stmt RBRACE  */
-#line 994 "yacc_sql.y"
+  case 124: /* sub_query_expr: LBRACE select_stmt RBRACE  */
+#line 1015 "yacc_sql.y"
     {
       (yyval.expression) = new SubQueryExpr((yyvsp[-1].sql_node)->selection);
     }
-#line 2935 "yacc_sql.cpp"
+#line 2957 "yacc_sql.cpp"
     break;
 
-  case 123: /* rel_attr: ID  */
-#line 1000 "yacc_sql.y"
+  case 125: /* rel_attr: ID  */
+#line 1021 "yacc_sql.y"
        {
       (yyval.rel_attr) = new RelAttrSqlNode;
       (yyval.rel_attr)->attribute_name = (yyvsp[0].string);
       free((yyvsp[0].string));
     }
-#line 2945 "yacc_sql.cpp"
+#line 2967 "yacc_sql.cpp"
     break;
 
-  case 124: /* rel_attr: ID DOT ID  */
-#line 1005 "yacc_sql.y"
+  case 126: /* rel_attr: ID DOT ID  */
+#line 1026 "yacc_sql.y"
                 {
       (yyval.rel_attr) = new RelAttrSqlNode;
       (yyval.rel_attr)->relation_name  = (yyvsp[-2].string);
@@ -2953,19 +2975,19 @@ yyreduce:
       free((yyvsp[-2].string));
       free((yyvsp[0].string));
     }
-#line 2957 "yacc_sql.cpp"
+#line 2979 "yacc_sql.cpp"
     break;
 
-  case 125: /* relation: ID  */
-#line 1015 "yacc_sql.y"
+  case 127: /* relation: ID  */
+#line 1036 "yacc_sql.y"
        {
       (yyval.string) = (yyvsp[0].string);
     }
-#line 2965 "yacc_sql.cpp"
+#line 2987 "yacc_sql.cpp"
     break;
 
-  case 126: /* rel_list: relation alias  */
-#line 1021 "yacc_sql.y"
+  case 128: /* rel_list: relation alias  */
+#line 1042 "yacc_sql.y"
                    {
       (yyval.relation_list) = new std::vector<RelationNode>();
       if(nullptr!=(yyvsp[0].string)){
@@ -2976,11 +2998,11 @@ yyreduce:
       }
       free((yyvsp[-1].string));
     }
-#line 2980 "yacc_sql.cpp"
+#line 3002 "yacc_sql.cpp"
     break;
 
-  case 127: /* rel_list: relation alias COMMA rel_list  */
-#line 1031 "yacc_sql.y"
+  case 129: /* rel_list: relation alias COMMA rel_list  */
+#line 1052 "yacc_sql.y"
                                     {
       if ((yyvsp[0].relation_list) != nullptr) {
         (yyval.relation_list) = (yyvsp[0].relation_list);
@@ -2995,22 +3017,22 @@ yyreduce:
       }
       free((yyvsp[-3].string));
     }
-#line 2999 "yacc_sql.cpp"
+#line 3021 "yacc_sql.cpp"
     break;
 
-  case 128: /* join_clauses: relation ON condition  */
-#line 1049 "yacc_sql.y"
+  case 130: /* join_clauses: relation ON condition  */
+#line 1070 "yacc_sql.y"
     {
       (yyval.join_clauses) = new JoinSqlNode;
       (yyval.join_clauses)->relations.emplace_back((yyvsp[-2].string));
       (yyval.join_clauses)->conditions = std::unique_ptr<Expression>((yyvsp[0].expression));
       free((yyvsp[-2].string));
     }
-#line 3010 "yacc_sql.cpp"
+#line 3032 "yacc_sql.cpp"
     break;
 
-  case 129: /* join_clauses: relation ON condition INNER JOIN join_clauses  */
-#line 1056 "yacc_sql.y"
+  case 131: /* join_clauses: relation ON condition INNER JOIN join_clauses  */
+#line 1077 "yacc_sql.y"
     {
       (yyval.join_clauses) = (yyvsp[0].join_clauses);
       (yyval.join_clauses)->relations.emplace_back((yyvsp[-5].string));
@@ -3018,269 +3040,297 @@ yyreduce:
       (yyval.join_clauses)->conditions = std::make_unique<ConjunctionExpr>(ConjunctionExpr::Type::AND, ptr, (yyvsp[-3].expression));
       free((yyvsp[-5].string));
     }
-#line 3022 "yacc_sql.cpp"
+#line 3044 "yacc_sql.cpp"
     break;
 
-  case 130: /* where: %empty  */
-#line 1067 "yacc_sql.y"
+  case 132: /* where: %empty  */
+#line 1088 "yacc_sql.y"
     {
       (yyval.expression) = nullptr;
     }
-#line 3030 "yacc_sql.cpp"
+#line 3052 "yacc_sql.cpp"
     break;
 
-  case 131: /* where: WHERE condition  */
-#line 1070 "yacc_sql.y"
+  case 133: /* where: WHERE condition  */
+#line 1091 "yacc_sql.y"
                       {
       (yyval.expression) = (yyvsp[0].expression);  
     }
-#line 3038 "yacc_sql.cpp"
+#line 3060 "yacc_sql.cpp"
     break;
 
-  case 132: /* condition: expression comp_op expression  */
-#line 1077 "yacc_sql.y"
+  case 134: /* condition: expression comp_op expression  */
+#line 1098 "yacc_sql.y"
     {
       (yyval.expression) = new ComparisonExpr((yyvsp[-1].comp), (yyvsp[-2].expression), (yyvsp[0].expression));
     }
-#line 3046 "yacc_sql.cpp"
+#line 3068 "yacc_sql.cpp"
     break;
 
-  case 133: /* condition: comp_op expression  */
-#line 1081 "yacc_sql.y"
+  case 135: /* condition: comp_op expression  */
+#line 1102 "yacc_sql.y"
     {
       Value val;
       val.set_null(true);
       ValueExpr *temp_expr = new ValueExpr(val);
       (yyval.expression) = new ComparisonExpr((yyvsp[-1].comp),temp_expr, (yyvsp[0].expression));
     }
-#line 3057 "yacc_sql.cpp"
+#line 3079 "yacc_sql.cpp"
     break;
 
-  case 134: /* condition: condition AND condition  */
-#line 1088 "yacc_sql.y"
+  case 136: /* condition: condition AND condition  */
+#line 1109 "yacc_sql.y"
     {
       (yyval.expression) = new ConjunctionExpr(ConjunctionExpr::Type::AND, (yyvsp[-2].expression), (yyvsp[0].expression));
     }
-#line 3065 "yacc_sql.cpp"
+#line 3087 "yacc_sql.cpp"
     break;
 
-  case 135: /* condition: condition OR condition  */
-#line 1092 "yacc_sql.y"
+  case 137: /* condition: condition OR condition  */
+#line 1113 "yacc_sql.y"
     {
       (yyval.expression) = new ConjunctionExpr(ConjunctionExpr::Type::OR, (yyvsp[-2].expression), (yyvsp[0].expression));
     }
-#line 3073 "yacc_sql.cpp"
+#line 3095 "yacc_sql.cpp"
     break;
 
-  case 136: /* comp_op: EQ  */
-#line 1098 "yacc_sql.y"
+  case 138: /* comp_op: EQ  */
+#line 1119 "yacc_sql.y"
          { (yyval.comp) = EQUAL_TO; }
-#line 3079 "yacc_sql.cpp"
+#line 3101 "yacc_sql.cpp"
     break;
 
-  case 137: /* comp_op: LT  */
-#line 1099 "yacc_sql.y"
+  case 139: /* comp_op: LT  */
+#line 1120 "yacc_sql.y"
          { (yyval.comp) = LESS_THAN; }
-#line 3085 "yacc_sql.cpp"
+#line 3107 "yacc_sql.cpp"
     break;
 
-  case 138: /* comp_op: GT  */
-#line 1100 "yacc_sql.y"
+  case 140: /* comp_op: GT  */
+#line 1121 "yacc_sql.y"
          { (yyval.comp) = GREAT_THAN; }
-#line 3091 "yacc_sql.cpp"
+#line 3113 "yacc_sql.cpp"
     break;
 
-  case 139: /* comp_op: LE  */
-#line 1101 "yacc_sql.y"
+  case 141: /* comp_op: LE  */
+#line 1122 "yacc_sql.y"
          { (yyval.comp) = LESS_EQUAL; }
-#line 3097 "yacc_sql.cpp"
+#line 3119 "yacc_sql.cpp"
     break;
 
-  case 140: /* comp_op: GE  */
-#line 1102 "yacc_sql.y"
+  case 142: /* comp_op: GE  */
+#line 1123 "yacc_sql.y"
          { (yyval.comp) = GREAT_EQUAL; }
-#line 3103 "yacc_sql.cpp"
+#line 3125 "yacc_sql.cpp"
     break;
 
-  case 141: /* comp_op: NE  */
-#line 1103 "yacc_sql.y"
+  case 143: /* comp_op: NE  */
+#line 1124 "yacc_sql.y"
          { (yyval.comp) = NOT_EQUAL; }
-#line 3109 "yacc_sql.cpp"
+#line 3131 "yacc_sql.cpp"
     break;
 
-  case 142: /* comp_op: IS  */
-#line 1104 "yacc_sql.y"
+  case 144: /* comp_op: IS  */
+#line 1125 "yacc_sql.y"
          { (yyval.comp) = IS_OP; }
-#line 3115 "yacc_sql.cpp"
+#line 3137 "yacc_sql.cpp"
     break;
 
-  case 143: /* comp_op: IS NOT  */
-#line 1105 "yacc_sql.y"
+  case 145: /* comp_op: IS NOT  */
+#line 1126 "yacc_sql.y"
              { (yyval.comp) = IS_NOT_OP; }
-#line 3121 "yacc_sql.cpp"
+#line 3143 "yacc_sql.cpp"
     break;
 
-  case 144: /* comp_op: LIKE  */
-#line 1106 "yacc_sql.y"
+  case 146: /* comp_op: LIKE  */
+#line 1127 "yacc_sql.y"
            { (yyval.comp) = LIKE_OP;}
-#line 3127 "yacc_sql.cpp"
+#line 3149 "yacc_sql.cpp"
     break;
 
-  case 145: /* comp_op: NOT LIKE  */
-#line 1107 "yacc_sql.y"
+  case 147: /* comp_op: NOT LIKE  */
+#line 1128 "yacc_sql.y"
                {(yyval.comp) = NOT_LIKE_OP;}
-#line 3133 "yacc_sql.cpp"
+#line 3155 "yacc_sql.cpp"
     break;
 
-  case 146: /* comp_op: IN  */
-#line 1108 "yacc_sql.y"
+  case 148: /* comp_op: IN  */
+#line 1129 "yacc_sql.y"
          { (yyval.comp) = IN_OP; }
-#line 3139 "yacc_sql.cpp"
+#line 3161 "yacc_sql.cpp"
     break;
 
-  case 147: /* comp_op: NOT IN  */
-#line 1109 "yacc_sql.y"
+  case 149: /* comp_op: NOT IN  */
+#line 1130 "yacc_sql.y"
              { (yyval.comp) = NOT_IN_OP; }
-#line 3145 "yacc_sql.cpp"
+#line 3167 "yacc_sql.cpp"
     break;
 
-  case 148: /* comp_op: EXISTS  */
-#line 1110 "yacc_sql.y"
+  case 150: /* comp_op: EXISTS  */
+#line 1131 "yacc_sql.y"
              { (yyval.comp) = EXISTS_OP; }
-#line 3151 "yacc_sql.cpp"
+#line 3173 "yacc_sql.cpp"
     break;
 
-  case 149: /* comp_op: NOT EXISTS  */
-#line 1111 "yacc_sql.y"
+  case 151: /* comp_op: NOT EXISTS  */
+#line 1132 "yacc_sql.y"
                  { (yyval.comp) = NOT_EXISTS_OP; }
-#line 3157 "yacc_sql.cpp"
+#line 3179 "yacc_sql.cpp"
     break;
 
-  case 150: /* opt_order_by: %empty  */
-#line 1116 "yacc_sql.y"
+  case 152: /* opt_order_by: %empty  */
+#line 1137 "yacc_sql.y"
     {
       (yyval.orderby_list) = nullptr;
     }
-#line 3165 "yacc_sql.cpp"
+#line 3187 "yacc_sql.cpp"
     break;
 
-  case 151: /* opt_order_by: ORDER BY sort_list  */
-#line 1120 "yacc_sql.y"
+  case 153: /* opt_order_by: ORDER BY sort_list  */
+#line 1141 "yacc_sql.y"
     {
       (yyval.orderby_list) = (yyvsp[0].orderby_list);
       std::reverse((yyval.orderby_list)->begin(),(yyval.orderby_list)->end());
     }
-#line 3174 "yacc_sql.cpp"
+#line 3196 "yacc_sql.cpp"
     break;
 
-  case 152: /* sort_list: sort_unit  */
-#line 1128 "yacc_sql.y"
+  case 154: /* sort_list: sort_unit  */
+#line 1149 "yacc_sql.y"
         {
       (yyval.orderby_list) = new std::vector<OrderBySqlNode>;
       (yyval.orderby_list)->emplace_back(std::move(*(yyvsp[0].orderby_unit)));
 	}
-#line 3183 "yacc_sql.cpp"
+#line 3205 "yacc_sql.cpp"
     break;
 
-  case 153: /* sort_list: sort_unit COMMA sort_list  */
-#line 1133 "yacc_sql.y"
+  case 155: /* sort_list: sort_unit COMMA sort_list  */
+#line 1154 "yacc_sql.y"
         {
       (yyvsp[0].orderby_list)->emplace_back(std::move(*(yyvsp[-2].orderby_unit)));
       (yyval.orderby_list) = (yyvsp[0].orderby_list);
 	}
-#line 3192 "yacc_sql.cpp"
+#line 3214 "yacc_sql.cpp"
     break;
 
-  case 154: /* sort_unit: expression  */
-#line 1141 "yacc_sql.y"
+  case 156: /* sort_unit: expression  */
+#line 1162 "yacc_sql.y"
         {
       (yyval.orderby_unit) = new OrderBySqlNode();
       (yyval.orderby_unit)->expr = std::unique_ptr<Expression>((yyvsp[0].expression));
       (yyval.orderby_unit)->is_asc = true;
 	}
-#line 3202 "yacc_sql.cpp"
+#line 3224 "yacc_sql.cpp"
     break;
 
-  case 155: /* sort_unit: expression DESC  */
-#line 1147 "yacc_sql.y"
+  case 157: /* sort_unit: expression DESC  */
+#line 1168 "yacc_sql.y"
         {
       (yyval.orderby_unit) = new OrderBySqlNode();
       (yyval.orderby_unit)->expr = std::unique_ptr<Expression>((yyvsp[-1].expression));
       (yyval.orderby_unit)->is_asc = false;
 	}
-#line 3212 "yacc_sql.cpp"
+#line 3234 "yacc_sql.cpp"
     break;
 
-  case 156: /* sort_unit: expression ASC  */
-#line 1153 "yacc_sql.y"
+  case 158: /* sort_unit: expression ASC  */
+#line 1174 "yacc_sql.y"
         {
       (yyval.orderby_unit) = new OrderBySqlNode(); // 默认是升序
       (yyval.orderby_unit)->expr = std::unique_ptr<Expression>((yyvsp[-1].expression));
       (yyval.orderby_unit)->is_asc = true;
 	}
-#line 3222 "yacc_sql.cpp"
+#line 3244 "yacc_sql.cpp"
     break;
 
-  case 157: /* group_by: %empty  */
-#line 1162 "yacc_sql.y"
+  case 159: /* group_by: %empty  */
+#line 1183 "yacc_sql.y"
     {
       (yyval.expression_list) = nullptr;
     }
-#line 3230 "yacc_sql.cpp"
+#line 3252 "yacc_sql.cpp"
     break;
 
-  case 158: /* group_by: GROUP BY expression_list  */
-#line 1166 "yacc_sql.y"
+  case 160: /* group_by: GROUP BY expression_list  */
+#line 1187 "yacc_sql.y"
     {
       (yyval.expression_list) = (yyvsp[0].expression_list);
     }
-#line 3238 "yacc_sql.cpp"
+#line 3260 "yacc_sql.cpp"
     break;
 
-  case 159: /* opt_having: %empty  */
-#line 1173 "yacc_sql.y"
+  case 161: /* opt_having: %empty  */
+#line 1194 "yacc_sql.y"
     {
       (yyval.expression) = nullptr;
     }
-#line 3246 "yacc_sql.cpp"
+#line 3268 "yacc_sql.cpp"
     break;
 
-  case 160: /* opt_having: HAVING condition  */
-#line 1177 "yacc_sql.y"
+  case 162: /* opt_having: HAVING condition  */
+#line 1198 "yacc_sql.y"
     {
       (yyval.expression) = (yyvsp[0].expression);
     }
-#line 3254 "yacc_sql.cpp"
+#line 3276 "yacc_sql.cpp"
     break;
 
-  case 161: /* opt_limit: %empty  */
-#line 1184 "yacc_sql.y"
+  case 163: /* opt_limit: %empty  */
+#line 1205 "yacc_sql.y"
     {
       (yyval.limited_info) = nullptr;
     }
-#line 3262 "yacc_sql.cpp"
+#line 3284 "yacc_sql.cpp"
+    break;
+
+  case 164: /* opt_limit: LIMIT NUMBER  */
+#line 1209 "yacc_sql.y"
+    {
+      (yyval.limited_info) = new LimitSqlNode();
+      (yyval.limited_info)->number = (yyvsp[0].number);
+    }
+#line 3293 "yacc_sql.cpp"
     break;
 
-  case 162: /* opt_limit: LIMIT NUMBER  */
-#line 1188 "yacc_sql.y"
+  case 165: /* opt_limit: LIMIT NUMBER COMMA NUMBER  */
+#line 1214 "yacc_sql.y"
     {
+      // 与 MySQL 一致，LIMIT offset, count
       (yyval.limited_info) = new LimitSqlNode();
+      (yyval.limited_info)->offset = (yyvsp[-2].number);
       (yyval.limited_info)->number = (yyvsp[0].number);
     }
-#line 3271 "yacc_sql.cpp"
+#line 3304 "yacc_sql.cpp"
+    break;
+
+  case 166: /* opt_limit: LIMIT NUMBER ID NUMBER  */
+#line 1221 "yacc_sql.y"
+    {
+      // LIMIT count OFFSET offset，OFFSET 不是保留字，这里按照标识符处理
+      if (strcasecmp((yyvsp[-1].string), "offset") != 0) {
+        free((yyvsp[-1].string));
+        yyerror(&(yyloc), sql_string, sql_result, scanner, "expect OFFSET after LIMIT");
+        YYERROR;
+      }
+      free((yyvsp[-1].string));
+      (yyval.limited_info) = new LimitSqlNode();
+      (yyval.limited_info)->number = (yyvsp[-2].number);
+      (yyval.limited_info)->offset = (yyvsp[0].number);
+    }
+#line 3321 "yacc_sql.cpp"
     break;
 
-  case 163: /* explain_stmt: EXPLAIN command_wrapper  */
-#line 1196 "yacc_sql.y"
+  case 167: /* explain_stmt: EXPLAIN command_wrapper  */
+#line 1237 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_EXPLAIN);
       (yyval.sql_node)->explain.sql_node = std::unique_ptr<ParsedSqlNode>((yyvsp[0].sql_node));
     }
-#line 3280 "yacc_sql.cpp"
+#line 3330 "yacc_sql.cpp"
     break;
 
-  case 164: /* set_variable_stmt: SET ID EQ value  */
-#line 1204 "yacc_sql.y"
+  case 168: /* set_variable_stmt: SET ID EQ value  */
+#line 1245 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SET_VARIABLE);
       (yyval.sql_node)->set_variable.name  = (yyvsp[-2].string);
@@ -3288,11 +3338,11 @@ yyreduce:
       free((yyvsp[-2].string));
       delete (yyvsp[0].value);
     }
-#line 3292 "yacc_sql.cpp"
+#line 3342 "yacc_sql.cpp"
     break;
 
 
-#line 3296 "yacc_sql.cpp"
+#line 3346 "yacc_sql.cpp"
 
       default: break;
     }
@@ -3521,7 +3571,7 @@ yyreturnlab:
   return yyresult;
 }
 
-#line 1216 "yacc_sql.y"
+#line 1257 "yacc_sql.y"
 
 //_____________________________________________________________________
 extern void scan_string(const char *str, yyscan_t scanner);
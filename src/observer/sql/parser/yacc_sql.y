@@ -41,6 +41,19 @@ ArithmeticExpr *create_arithmetic_expression(ArithmeticExpr::Type type,
   return expr;
 }
 
+ValueExpr *create_value_expression(Value *value, ParsedSqlResult *sql_result, const char *sql_string, YYLTYPE *llocp)
+{
+  ValueExpr *expr = new ValueExpr(*value);
+  expr->set_name(token_name(sql_string, llocp));
+  // 只有数字和字符串常量可以参数化，与 PlanCache::parameterize 保持一致
+  AttrType type = value->attr_type();
+  if (!value->is_null() && (type == AttrType::INTS || type == AttrType::FLOATS || type == AttrType::CHARS)) {
+    expr->set_param_index(sql_result->next_param_index());
+  }
+  delete value;
+  return expr;
+}
+
 UnboundFunctionExpr *create_aggregate_expression(const char *function_name,
                                                  std::vector<std::unique_ptr<Expression>> child,
                                                  const char *sql_string,
@@ -253,6 +266,7 @@ ParsedSqlNode *create_table_sql_node(char *table_name,
 %type <sql_node>            create_table_stmt
 %type <sql_node>            drop_table_stmt
 %type <sql_node>            show_tables_stmt
+%type <sql_node>            show_status_stmt
 %type <sql_node>            desc_table_stmt
 %type <sql_node>            create_index_stmt
 %type <sql_node>            drop_index_stmt
@@ -295,6 +309,7 @@ command_wrapper:
   | create_table_stmt
   | drop_table_stmt
   | show_tables_stmt
+  | show_status_stmt
   | desc_table_stmt
   | create_index_stmt
   | drop_index_stmt
@@ -359,6 +374,14 @@ show_tables_stmt:
     }
     ;
 
+show_status_stmt:
+    SHOW ID {
+      $$ = new ParsedSqlNode(SCF_SHOW_STATUS);
+      $$->show_status.name = $2;
+      free($2);
+    }
+    ;
+
 desc_table_stmt:
     DESC ID  {
       $$ = new ParsedSqlNode(SCF_DESC_TABLE);
@@ -945,9 +968,7 @@ expression:
       $$ = create_arithmetic_expression(ArithmeticExpr::Type::NEGATIVE, $2, nullptr, sql_string, &@$);
     }
     | nonnegative_value {
-      $$ = new ValueExpr(*$1);
-      $$->set_name(token_name(sql_string, &@$));
-      delete $1;
+      $$ = create_value_expression($1, sql_result, sql_string, &@$);
     }
     | rel_attr {
       RelAttrSqlNode *node = $1;
@@ -1189,6 +1210,26 @@ opt_limit:
       $$ = new LimitSqlNode();
       $$->number = $2;
     }
+    | LIMIT NUMBER COMMA NUMBER
+    {
+      // 与 MySQL 一致，LIMIT offset, count
+      $$ = new LimitSqlNode();
+      $$->offset = $2;
+      $$->number = $4;
+    }
+    | LIMIT NUMBER ID NUMBER
+    {
+      // LIMIT count OFFSET offset，OFFSET 不是保留字，这里按照标识符处理
+      if (strcasecmp($3, "offset") != 0) {
+        free($3);
+        yyerror(&@$, sql_string, sql_result, scanner, "expect OFFSET after LIMIT");
+        YYERROR;
+      }
+      free($3);
+      $$ = new LimitSqlNode();
+      $$->number = $2;
+      $$->offset = $4;
+    }
     ;
 
 explain_stmt:
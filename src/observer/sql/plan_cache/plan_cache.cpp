@@ -0,0 +1,341 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#include "sql/plan_cache/plan_cache.h"
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include "common/log/log.h"
+#include "sql/expr/expression.h"
+#include "sql/expr/expression_iterator.h"
+
+using namespace std;
+using namespace common;
+
+unique_ptr<PhysicalOperator> PlanCacheEntry::check_out()
+{
+  lock_guard<mutex> guard(mutex_);
+  return std::move(plan_);
+}
+
+void PlanCacheEntry::check_in(unique_ptr<PhysicalOperator> plan)
+{
+  lock_guard<mutex> guard(mutex_);
+  plan_ = std::move(plan);
+}
+
+void PlanCacheEntry::bind(const vector<PlanCacheLiteral> &literals)
+{
+  ASSERT(literals.size() == params_.size(), "literal number mismatch");
+  for (size_t i = 0; i < params_.size(); i++) {
+    if (params_[i] != nullptr) {
+      params_[i]->set_value(literals[i].value);
+    }
+  }
+}
+
+CachedPlanPhysicalOperator::~CachedPlanPhysicalOperator()
+{
+  if (reusable_ && !opened_) {
+    entry_->check_in(std::move(plan_));
+  }
+}
+
+RC CachedPlanPhysicalOperator::open(Trx *trx)
+{
+  RC rc   = plan_->open(trx);
+  opened_ = true;
+  if (OB_FAIL(rc)) {
+    reusable_ = false;
+  }
+  return rc;
+}
+
+RC CachedPlanPhysicalOperator::close()
+{
+  RC rc   = plan_->close();
+  opened_ = false;
+  if (OB_FAIL(rc)) {
+    reusable_ = false;
+  }
+  return rc;
+}
+
+static bool is_word(const char *word, size_t len, const char *expected)
+{
+  return strlen(expected) == len && 0 == strncasecmp(word, expected, len);
+}
+
+bool PlanCache::parameterize(const char *sql, string &text, vector<PlanCacheLiteral> &literals)
+{
+  text.clear();
+  literals.clear();
+
+  int  paren_depth   = 0;
+  int  bracket_depth = 0;
+  bool first_word    = true;
+  bool after_from    = false;  // 是否已经出现了最外层的 FROM
+  bool after_limit   = false;  // LIMIT 是最后一个子句，后面的数字都不是表达式
+
+  auto append_token = [&text](const char *token, size_t len) {
+    if (!text.empty()) {
+      text.push_back(' ');
+    }
+    text.append(token, len);
+  };
+
+  const char *p = sql;
+  while (*p != '\0') {
+    const unsigned char c = *p;
+    if (isspace(c)) {
+      p++;
+      continue;
+    }
+
+    if (isalpha(c) || c == '_') {
+      const char *begin = p;
+      while (isalnum(static_cast<unsigned char>(*p)) || *p == '_') {
+        p++;
+      }
+      const size_t len = p - begin;
+      if (first_word && !is_word(begin, len, "select")) {
+        return false;
+      }
+      first_word = false;
+
+      if (paren_depth == 0 && is_word(begin, len, "from")) {
+        after_from = true;
+      } else if (is_word(begin, len, "limit")) {
+        after_limit = true;
+      }
+      append_token(begin, len);
+      continue;
+    }
+
+    if (first_word) {
+      return false;
+    }
+
+    if (isdigit(c) || c == '\'' || c == '"') {
+      const char      *begin = p;
+      PlanCacheLiteral literal;
+      const char      *placeholder = nullptr;
+      if (c == '\'' || c == '"') {
+        const char *end = strchr(p + 1, c);
+        if (end == nullptr) {
+          return false;
+        }
+        p = end + 1;
+        literal.value = Value(string(begin + 1, end - begin - 1).c_str());
+        placeholder   = "?s";
+      } else {
+        while (isdigit(static_cast<unsigned char>(*p))) {
+          p++;
+        }
+        if (*p == '.' && isdigit(static_cast<unsigned char>(*(p + 1)))) {
+          p++;
+          while (isdigit(static_cast<unsigned char>(*p))) {
+            p++;
+          }
+          literal.value = Value(static_cast<float>(atof(begin)));
+          placeholder = "?f";
+        } else {
+          literal.value = Value(atoi(begin));
+          placeholder = "?i";
+        }
+
+        // LIMIT 的参数和向量常量中的数字不是 ValueExpr，原样保留
+        if (after_limit || bracket_depth > 0) {
+          append_token(begin, p - begin);
+          continue;
+        }
+      }
+
+      literal.fixed = !after_from;
+      if (literal.fixed) {
+        append_token(begin, p - begin);
+      } else {
+        append_token(placeholder, strlen(placeholder));
+      }
+      literals.emplace_back(std::move(literal));
+      continue;
+    }
+
+    // 比较运算符放在一起，避免 "< =" 与 "<=" 得到相同的结果
+    if (c == '<' || c == '>' || c == '=' || c == '!') {
+      const char *begin = p;
+      while (*p == '<' || *p == '>' || *p == '=' || *p == '!') {
+        p++;
+      }
+      append_token(begin, p - begin);
+      continue;
+    }
+
+    switch (c) {
+      case '(': paren_depth++; break;
+      case ')': paren_depth--; break;
+      case '[': bracket_depth++; break;
+      case ']': bracket_depth--; break;
+      default: break;
+    }
+    append_token(p, 1);
+    p++;
+  }
+
+  return !first_word;
+}
+
+RC PlanCache::collect_params(
+    PhysicalOperator &oper, const vector<PlanCacheLiteral> &literals, vector<ValueExpr *> &params)
+{
+  function<RC(unique_ptr<Expression> &)> visit_expr = [&](unique_ptr<Expression> &expr) -> RC {
+    if (!expr) {
+      return RC::SUCCESS;
+    }
+
+    switch (expr->type()) {
+      case ExprType::SUBQUERY:
+      case ExprType::EXPRLIST:
+      case ExprType::UNBOUND_FIELD:
+      case ExprType::UNBOUND_FUNCTION: {
+        return RC::UNSUPPORTED;
+      }
+
+      case ExprType::VALUE: {
+        auto *value_expr = static_cast<ValueExpr *>(expr.get());
+        int   index      = value_expr->param_index();
+        if (index < 0) {
+          return RC::SUCCESS;
+        }
+        if (index >= static_cast<int>(literals.size())) {
+          return RC::UNSUPPORTED;
+        }
+        if (literals[index].fixed) {
+          return RC::SUCCESS;
+        }
+
+        const Value &value = value_expr->get_value();
+        if (params[index] != nullptr || value.attr_type() != literals[index].value.attr_type() ||
+            value.compare(literals[index].value) != 0) {
+          return RC::UNSUPPORTED;
+        }
+        params[index] = value_expr;
+        return RC::SUCCESS;
+      }
+
+      default: {
+        return ExpressionIterator::iterate_child_expr(*expr, visit_expr);
+      }
+    }
+  };
+
+  function<RC(PhysicalOperator &)> visit_oper = [&](PhysicalOperator &oper) -> RC {
+    RC rc = oper.visit_expressions(visit_expr);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    for (unique_ptr<PhysicalOperator> &child : oper.children()) {
+      rc = visit_oper(*child);
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+    }
+    return RC::SUCCESS;
+  };
+
+  params.assign(literals.size(), nullptr);
+  RC rc = visit_oper(oper);
+  if (OB_FAIL(rc)) {
+    return RC::UNSUPPORTED;
+  }
+
+  // 每个参数化的常量都要在计划中出现，否则它已经被优化掉了，换一个值计划可能就不对了
+  for (size_t i = 0; i < literals.size(); i++) {
+    if (!literals[i].fixed && params[i] == nullptr) {
+      return RC::UNSUPPORTED;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC PlanCache::get(const string &key, uint64_t schema_version, const vector<PlanCacheLiteral> &literals,
+    unique_ptr<PhysicalOperator> &plan, bool &used_chunk_mode)
+{
+  shared_ptr<PlanCacheEntry> entry;
+  {
+    lock_guard<mutex> guard(mutex_);
+    if (!cache_.get(key, entry)) {
+      miss_count_++;
+      return RC::NOTFOUND;
+    }
+
+    if (entry->schema_version() != schema_version) {
+      cache_.remove(key);
+      miss_count_++;
+      return RC::NOTFOUND;
+    }
+  }
+
+  // 同一个计划正在被其它请求使用
+  unique_ptr<PhysicalOperator> cached_plan = entry->check_out();
+  if (!cached_plan) {
+    miss_count_++;
+    return RC::NOTFOUND;
+  }
+
+  entry->bind(literals);
+  used_chunk_mode = entry->used_chunk_mode();
+  plan            = make_unique<CachedPlanPhysicalOperator>(std::move(entry), std::move(cached_plan));
+  hit_count_++;
+  return RC::SUCCESS;
+}
+
+RC PlanCache::put(const string &key, uint64_t schema_version, const vector<PlanCacheLiteral> &literals,
+    unique_ptr<PhysicalOperator> &plan, bool used_chunk_mode)
+{
+  vector<ValueExpr *> params;
+  RC                  rc = collect_params(*plan, literals, params);
+  if (OB_FAIL(rc)) {
+    LOG_TRACE("plan is not cacheable. key=%s", key.c_str());
+    return rc;
+  }
+
+  auto entry = make_shared<PlanCacheEntry>(schema_version, used_chunk_mode, std::move(params));
+  {
+    lock_guard<mutex> guard(mutex_);
+    cache_.remove(key);
+    while (cache_.count() >= capacity_) {
+      string victim;
+      cache_.foreach_reverse([&victim](const string &key, const shared_ptr<PlanCacheEntry> &) {
+        victim = key;
+        return false;
+      });
+      cache_.remove(victim);
+    }
+    cache_.put(key, entry);
+  }
+
+  // 新生成的计划当前就要执行，执行结束后才放到缓存项中
+  plan = make_unique<CachedPlanPhysicalOperator>(std::move(entry), std::move(plan));
+  return RC::SUCCESS;
+}
+
+size_t PlanCache::size()
+{
+  lock_guard<mutex> guard(mutex_);
+  return cache_.count();
+}
@@ -0,0 +1,166 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common/lang/lru_cache.h"
+#include "common/rc.h"
+#include "sql/operator/physical_operator.h"
+
+class ValueExpr;
+
+/**
+ * @brief SQL 语句中的一个常量
+ * @ingroup PlanCache
+ */
+struct PlanCacheLiteral
+{
+  Value value;
+  bool  fixed = false;  ///< 出现在 FROM 之前的常量会决定输出的列名，原样保留在缓存的键中，不参与参数化
+};
+
+/**
+ * @brief 执行计划缓存中的一项
+ * @ingroup PlanCache
+ * @details 缓存的执行计划同一时间只能被一个请求使用。使用时从缓存项中取出，执行结束后再放回来。
+ * params_ 记录每个常量在执行计划中对应的表达式，下标就是常量在SQL中的序号，不参与参数化的常量对应 nullptr。
+ */
+class PlanCacheEntry
+{
+public:
+  PlanCacheEntry(uint64_t schema_version, bool used_chunk_mode, std::vector<ValueExpr *> params)
+      : schema_version_(schema_version), used_chunk_mode_(used_chunk_mode), params_(std::move(params))
+  {}
+
+  uint64_t schema_version() const { return schema_version_; }
+  bool     used_chunk_mode() const { return used_chunk_mode_; }
+
+  /// @brief 取出缓存的执行计划。计划正在被别的请求使用时返回空
+  std::unique_ptr<PhysicalOperator> check_out();
+  /// @brief 执行结束后放回执行计划
+  void check_in(std::unique_ptr<PhysicalOperator> plan);
+
+  /// @brief 把新的常量绑定到执行计划中。调用者需要持有取出来的执行计划
+  void bind(const std::vector<PlanCacheLiteral> &literals);
+
+private:
+  std::mutex                        mutex_;
+  uint64_t                          schema_version_  = 0;
+  bool                              used_chunk_mode_ = false;
+  std::unique_ptr<PhysicalOperator> plan_;
+  std::vector<ValueExpr *>          params_;
+};
+
+/**
+ * @brief 使用缓存的执行计划时，在外面包装的一层算子
+ * @ingroup PlanCache
+ * @details 所有操作都转给真正的执行计划。析构时如果计划已经正常关闭，就把它放回缓存项中，供下次使用。
+ */
+class CachedPlanPhysicalOperator : public PhysicalOperator
+{
+public:
+  CachedPlanPhysicalOperator(std::shared_ptr<PlanCacheEntry> entry, std::unique_ptr<PhysicalOperator> plan)
+      : entry_(std::move(entry)), plan_(std::move(plan))
+  {}
+  ~CachedPlanPhysicalOperator() override;
+
+  std::string          name() const override { return plan_->name(); }
+  std::string          param() const override { return plan_->param(); }
+  PhysicalOperatorType type() const override { return plan_->type(); }
+
+  RC open(Trx *trx) override;
+  RC next() override { return plan_->next(); }
+  RC next(Chunk &chunk) override { return plan_->next(chunk); }
+  RC close() override;
+
+  Tuple *current_tuple() override { return plan_->current_tuple(); }
+
+  RC tuple_schema(TupleSchema &schema) const override { return plan_->tuple_schema(schema); }
+
+  PhysicalOperator &plan() { return *plan_; }
+
+private:
+  std::shared_ptr<PlanCacheEntry>   entry_;
+  std::unique_ptr<PhysicalOperator> plan_;
+  bool                              opened_   = false;
+  bool                              reusable_ = true;  ///< open/close 失败后计划的状态不确定，不再放回缓存
+};
+
+/**
+ * @brief 执行计划缓存
+ * @defgroup PlanCache
+ * @details 缓存的键是参数化之后的SQL：把SQL中的数字和字符串常量替换成带类型的占位符，
+ * 再加上当前的数据库名称以及会影响计划生成的会话变量。缓存项记录生成计划时数据库的模式版本号，
+ * 建表、删表、创建索引之后版本号发生变化，旧的计划就不再使用。
+ * 再次执行相同的语句时，跳过解析、语义解析、重写和生成物理计划，把新的常量绑定到缓存的计划中直接执行。
+ * 当前只缓存 SELECT 语句，并且计划中的算子都要实现 PhysicalOperator::visit_expressions。
+ * 常量在优化过程中被折叠或者做了类型转换的计划也不会缓存，因为换了常量以后这个计划不一定正确。
+ */
+class PlanCache
+{
+public:
+  static constexpr size_t DEFAULT_CAPACITY = 1024;
+
+  explicit PlanCache(size_t capacity = DEFAULT_CAPACITY) : capacity_(capacity) {}
+  virtual ~PlanCache() = default;
+
+  /**
+   * @brief 参数化SQL语句
+   * @details 按照词法分析的规则切分SQL，数字和字符串常量替换成占位符，多余的空白去掉。
+   * 常量的顺序与语法分析时分配给 ValueExpr 的序号一致。LIMIT 后面的数字不是表达式，原样保留。
+   * @param sql 原始的SQL
+   * @param text 参数化之后的SQL
+   * @param literals SQL中的常量
+   * @return 是否可以缓存。只有 SELECT 语句可以
+   */
+  static bool parameterize(const char *sql, std::string &text, std::vector<PlanCacheLiteral> &literals);
+
+  /**
+   * @brief 查找缓存的执行计划
+   * @details 命中时绑定新的常量，返回的计划执行结束后会自动放回缓存
+   * @return 没有命中时返回 RC::NOTFOUND
+   */
+  RC get(const std::string &key, uint64_t schema_version, const std::vector<PlanCacheLiteral> &literals,
+      std::unique_ptr<PhysicalOperator> &plan, bool &used_chunk_mode);
+
+  /**
+   * @brief 缓存新生成的执行计划
+   * @details 计划可以缓存时，plan 会被替换成包装之后的算子。不能缓存时返回 RC::UNSUPPORTED，plan 保持不变
+   */
+  RC put(const std::string &key, uint64_t schema_version, const std::vector<PlanCacheLiteral> &literals,
+      std::unique_ptr<PhysicalOperator> &plan, bool used_chunk_mode);
+
+  uint64_t hit_count() const { return hit_count_.load(); }
+  uint64_t miss_count() const { return miss_count_.load(); }
+  size_t   size();
+
+private:
+  /// @brief 找到计划中每个常量对应的表达式
+  static RC collect_params(PhysicalOperator &oper, const std::vector<PlanCacheLiteral> &literals,
+      std::vector<ValueExpr *> &params);
+
+private:
+  std::mutex                                                     mutex_;
+  size_t                                                         capacity_ = DEFAULT_CAPACITY;
+  common::LruCache<std::string, std::shared_ptr<PlanCacheEntry>> cache_;
+
+  std::atomic<uint64_t> hit_count_{0};
+  std::atomic<uint64_t> miss_count_{0};
+};
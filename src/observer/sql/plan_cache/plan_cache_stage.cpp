@@ -21,5 +21,79 @@ See the Mulan PSL v2 for more details. */
 #include "common/io/io.h"
 #include "common/lang/string.h"
 #include "common/log/log.h"
+#include "common/global_context.h"
+#include "event/session_event.h"
+#include "event/sql_event.h"
+#include "session/session.h"
+#include "sql/plan_cache/plan_cache.h"
+#include "sql/stmt/stmt.h"
+#include "storage/db/db.h"
 
 using namespace common;
+
+/**
+ * @brief 缓存的键
+ * @details 除了SQL本身，还要包含当前的数据库以及会影响计划生成的会话变量
+ */
+static string plan_cache_key(Session *session, const string &text)
+{
+  string key(session->get_current_db_name());
+  key.append("|").append(std::to_string(static_cast<int>(session->get_execution_mode())));
+  key.append("|").append(std::to_string(session->sort_buffer_size()));
+  key.append("|").append(std::to_string(session->parallel_degree()));
+  key.append("|").append(text);
+  return key;
+}
+
+RC PlanCacheStage::handle_request(SQLStageEvent *sql_event)
+{
+  PlanCache *plan_cache = GCTX.plan_cache_;
+  Session   *session    = sql_event->session_event()->session();
+  Db        *db         = session->get_current_db();
+  if (nullptr == plan_cache || nullptr == db) {
+    return RC::SUCCESS;
+  }
+
+  string                   text;
+  vector<PlanCacheLiteral> literals;
+  if (!PlanCache::parameterize(sql_event->sql().c_str(), text, literals)) {
+    return RC::SUCCESS;
+  }
+
+  unique_ptr<PhysicalOperator> plan;
+  bool                         used_chunk_mode = false;
+
+  RC rc = plan_cache->get(plan_cache_key(session, text), db->schema_version(), literals, plan, used_chunk_mode);
+  if (OB_SUCC(rc)) {
+    LOG_TRACE("plan cache hit. sql=%s", sql_event->sql().c_str());
+    session->set_used_chunk_mode(used_chunk_mode);
+    sql_event->set_operator(std::move(plan));
+  }
+  return RC::SUCCESS;
+}
+
+RC PlanCacheStage::handle_plan(SQLStageEvent *sql_event)
+{
+  PlanCache *plan_cache = GCTX.plan_cache_;
+  Session   *session    = sql_event->session_event()->session();
+  Db        *db         = session->get_current_db();
+  Stmt      *stmt       = sql_event->stmt();
+  if (nullptr == plan_cache || nullptr == db || nullptr == stmt || stmt->type() != StmtType::SELECT ||
+      nullptr == sql_event->physical_operator()) {
+    return RC::SUCCESS;
+  }
+
+  string                   text;
+  vector<PlanCacheLiteral> literals;
+  if (!PlanCache::parameterize(sql_event->sql().c_str(), text, literals)) {
+    return RC::SUCCESS;
+  }
+
+  // 不能缓存的计划照常执行
+  (void)plan_cache->put(plan_cache_key(session, text),
+      db->schema_version(),
+      literals,
+      sql_event->physical_operator(),
+      session->used_chunk_mode());
+  return RC::SUCCESS;
+}
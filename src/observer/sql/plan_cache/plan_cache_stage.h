@@ -16,11 +16,25 @@ See the Mulan PSL v2 for more details. */
 
 #include "common/rc.h"
 
+class SQLStageEvent;
+
 /**
  * @brief 尝试从Plan的缓存中获取Plan，如果没有命中，则执行Optimizer
  * @ingroup SQLStage
- * @details 实际上现在什么都没做。不过PlanCache对数据库的优化提升明显，是一个非常有趣的功能，
- * 感兴趣的同学可以参考OceanBase的实现
+ * @details 缓存本身是全局的(GlobalContext::plan_cache_)，参考 PlanCache。
+ * 在解析之前用参数化之后的SQL查找缓存，命中时直接使用缓存的执行计划；
+ * 没有命中时走完正常的解析和优化流程，再把生成的执行计划放到缓存中。
  */
 class PlanCacheStage
-{};
+{
+public:
+  PlanCacheStage()          = default;
+  virtual ~PlanCacheStage() = default;
+
+public:
+  /// @brief 查找缓存的执行计划，命中时设置到 sql_event 中
+  RC handle_request(SQLStageEvent *sql_event);
+
+  /// @brief 优化完成后，缓存新生成的执行计划
+  RC handle_plan(SQLStageEvent *sql_event);
+};
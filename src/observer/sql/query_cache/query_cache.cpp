@@ -0,0 +1,367 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#include "sql/query_cache/query_cache.h"
+
+#include <ctype.h>
+#include <string.h>
+#include <strings.h>
+
+#include "common/log/log.h"
+#include "sql/operator/index_scan_physical_operator.h"
+#include "sql/operator/table_scan_physical_operator.h"
+#include "sql/operator/table_scan_vec_physical_operator.h"
+#include "sql/operator/vector_scan_physical_operator.h"
+#include "sql/plan_cache/plan_cache.h"
+#include "storage/table/base_table.h"
+
+using namespace std;
+using namespace common;
+
+/**
+ * @brief 估算一行数据占用的内存
+ */
+static int64_t row_memory_size(const vector<Value> &row)
+{
+  int64_t size = sizeof(row) + row.size() * sizeof(Value);
+  for (const Value &cell : row) {
+    if (!cell.is_null() && (cell.attr_type() == AttrType::CHARS || cell.attr_type() == AttrType::TEXTS)) {
+      size += cell.length() + 1;
+    }
+  }
+  return size;
+}
+
+int64_t QueryCacheResult::memory_size() const
+{
+  int64_t size = sizeof(*this);
+  for (const vector<Value> &row : rows) {
+    size += row_memory_size(row);
+  }
+  return size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+QueryCacheRecordPhysicalOperator::QueryCacheRecordPhysicalOperator(QueryCache &cache, string key,
+    uint64_t schema_version, QueryCacheTableVersions table_versions, unique_ptr<PhysicalOperator> child)
+    : cache_(cache), key_(std::move(key)), schema_version_(schema_version), table_versions_(std::move(table_versions))
+{
+  children_.emplace_back(std::move(child));
+}
+
+RC QueryCacheRecordPhysicalOperator::open(Trx *trx)
+{
+  RC rc = children_[0]->open(trx);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  result_      = make_shared<QueryCacheResult>();
+  memory_size_ = static_cast<int64_t>(key_.size());
+  finished_    = false;
+  recording_   = OB_SUCC(children_[0]->tuple_schema(result_->schema));
+  return rc;
+}
+
+RC QueryCacheRecordPhysicalOperator::next()
+{
+  RC rc = children_[0]->next();
+  if (rc == RC::RECORD_EOF) {
+    finished_ = true;
+    return rc;
+  }
+  if (OB_FAIL(rc) || !recording_) {
+    recording_ = recording_ && OB_SUCC(rc);
+    return rc;
+  }
+
+  Tuple *tuple = children_[0]->current_tuple();
+  if (nullptr == tuple) {
+    recording_ = false;
+    return rc;
+  }
+
+  vector<Value> row(tuple->cell_num());
+  for (int i = 0; i < tuple->cell_num() && recording_; i++) {
+    Value cell;
+    if (OB_FAIL(tuple->cell_at(i, cell))) {
+      recording_ = false;
+      break;
+    }
+
+    // 字符串可能引用的是记录中的内存，要复制一份；向量总是引用外部的内存，不缓存
+    if (cell.is_null()) {
+      row[i] = cell;
+    } else if (cell.attr_type() == AttrType::CHARS || cell.attr_type() == AttrType::TEXTS) {
+      row[i] = Value(cell.attr_type(), const_cast<char *>(cell.data()), cell.length());
+    } else if (cell.attr_type() == AttrType::VECTORS) {
+      recording_ = false;
+    } else {
+      row[i] = cell;
+    }
+  }
+
+  if (recording_) {
+    memory_size_ += row_memory_size(row);
+    if (memory_size_ > cache_.memory_limit()) {
+      recording_ = false;
+    } else {
+      result_->rows.emplace_back(std::move(row));
+    }
+  }
+
+  if (!recording_) {
+    result_.reset();
+  }
+  return rc;
+}
+
+RC QueryCacheRecordPhysicalOperator::close()
+{
+  RC rc = children_[0]->close();
+  if (OB_SUCC(rc) && recording_ && finished_) {
+    (void)cache_.put(key_, schema_version_, std::move(table_versions_), std::move(result_));
+  }
+  recording_ = false;
+  result_.reset();
+  return rc;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+QueryCacheResultPhysicalOperator::QueryCacheResultPhysicalOperator(shared_ptr<const QueryCacheResult> result)
+    : result_(std::move(result))
+{
+  vector<TupleCellSpec> specs;
+  for (int i = 0; i < result_->schema.cell_num(); i++) {
+    specs.push_back(result_->schema.cell_at(i));
+  }
+  tuple_.set_names(specs);
+}
+
+RC QueryCacheResultPhysicalOperator::open(Trx *trx)
+{
+  row_pos_ = 0;
+  started_ = false;
+  return RC::SUCCESS;
+}
+
+RC QueryCacheResultPhysicalOperator::next()
+{
+  if (started_) {
+    row_pos_++;
+  }
+  started_ = true;
+
+  if (row_pos_ >= result_->rows.size()) {
+    return RC::RECORD_EOF;
+  }
+
+  tuple_.set_cells(result_->rows[row_pos_]);
+  return RC::SUCCESS;
+}
+
+RC QueryCacheResultPhysicalOperator::tuple_schema(TupleSchema &schema) const
+{
+  schema = result_->schema;
+  return RC::SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static bool is_select_word(const char *word, size_t len) { return len == 6 && 0 == strncasecmp(word, "select", len); }
+
+bool QueryCache::cacheable(const char *sql)
+{
+  int select_count = 0;
+  int word_count   = 0;
+
+  const char *p = sql;
+  while (*p != '\0') {
+    const unsigned char c = *p;
+    if (c == '\'' || c == '"') {
+      const char *end = strchr(p + 1, c);
+      if (end == nullptr) {
+        return false;
+      }
+      p = end + 1;
+      word_count++;
+      continue;
+    }
+
+    if (isalpha(c) || c == '_') {
+      const char *begin = p;
+      while (isalnum(static_cast<unsigned char>(*p)) || *p == '_') {
+        p++;
+      }
+      if (is_select_word(begin, p - begin)) {
+        select_count++;
+      } else if (word_count == 0) {
+        return false;
+      }
+      word_count++;
+      continue;
+    }
+
+    if (!isspace(c) && word_count == 0) {
+      return false;
+    }
+    p++;
+  }
+  return select_count == 1;
+}
+
+RC QueryCache::collect_tables(PhysicalOperator &oper, vector<const BaseTable *> &tables)
+{
+  auto *cached_plan = dynamic_cast<CachedPlanPhysicalOperator *>(&oper);
+  if (cached_plan != nullptr) {
+    return collect_tables(cached_plan->plan(), tables);
+  }
+
+  switch (oper.type()) {
+    case PhysicalOperatorType::TABLE_SCAN: {
+      tables.push_back(static_cast<TableScanPhysicalOperator &>(oper).table());
+    } break;
+    case PhysicalOperatorType::INDEX_SCAN: {
+      tables.push_back(static_cast<IndexScanPhysicalOperator &>(oper).table());
+    } break;
+    case PhysicalOperatorType::TABLE_SCAN_VEC: {
+      tables.push_back(static_cast<TableScanVecPhysicalOperator &>(oper).table());
+    } break;
+    case PhysicalOperatorType::VECTOR_INDEX_SCAN: {
+      tables.push_back(static_cast<VectorScanPhysicalOperator &>(oper).table());
+    } break;
+
+    // 视图的数据来自其它表，修改语句和 EXPLAIN 的结果也不能缓存
+    case PhysicalOperatorType::VIEW_SCAN:
+    case PhysicalOperatorType::EXPLAIN:
+    case PhysicalOperatorType::INSERT:
+    case PhysicalOperatorType::DELETE:
+    case PhysicalOperatorType::UPDATE:
+    case PhysicalOperatorType::CACHED_RESULT: {
+      return RC::UNSUPPORTED;
+    }
+    default: break;
+  }
+
+  for (unique_ptr<PhysicalOperator> &child : oper.children()) {
+    RC rc = collect_tables(*child, tables);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+QueryCacheTableVersions QueryCache::table_versions(const vector<const BaseTable *> &tables)
+{
+  QueryCacheTableVersions versions;
+  for (const BaseTable *table : tables) {
+    versions.emplace_back(table, table->data_version());
+  }
+  return versions;
+}
+
+RC QueryCache::get(const string &key, uint64_t schema_version, shared_ptr<const QueryCacheResult> &result)
+{
+  lock_guard<mutex> guard(mutex_);
+
+  Entry entry;
+  if (!cache_.get(key, entry)) {
+    miss_count_++;
+    return RC::NOTFOUND;
+  }
+
+  // 先检查模式版本号，表被删除之后不能再访问表对象
+  bool valid = entry.schema_version == schema_version;
+  for (size_t i = 0; valid && i < entry.table_versions.size(); i++) {
+    auto &[table, data_version] = entry.table_versions[i];
+    valid                       = table->data_version() == data_version;
+  }
+
+  if (!valid) {
+    remove_entry(key, entry);
+    miss_count_++;
+    return RC::NOTFOUND;
+  }
+
+  result = entry.result;
+  hit_count_++;
+  return RC::SUCCESS;
+}
+
+RC QueryCache::put(
+    const string &key, uint64_t schema_version, QueryCacheTableVersions table_versions, shared_ptr<QueryCacheResult> result)
+{
+  Entry entry;
+  entry.schema_version = schema_version;
+  entry.table_versions = std::move(table_versions);
+  entry.memory_size    = static_cast<int64_t>(key.size()) + result->memory_size();
+  entry.result         = std::move(result);
+
+  lock_guard<mutex> guard(mutex_);
+
+  const int64_t memory_limit = memory_limit_.load();
+  if (entry.memory_size > memory_limit) {
+    LOG_TRACE("query result is too large to cache. key=%s, size=%ld", key.c_str(), entry.memory_size);
+    return RC::UNSUPPORTED;
+  }
+
+  Entry old_entry;
+  if (cache_.get(key, old_entry)) {
+    remove_entry(key, old_entry);
+  }
+
+  evict(memory_limit - entry.memory_size);
+  memory_usage_ += entry.memory_size;
+  cache_.put(key, entry);
+  return RC::SUCCESS;
+}
+
+void QueryCache::remove_entry(const string &key, const Entry &entry)
+{
+  memory_usage_ -= entry.memory_size;
+  cache_.remove(key);
+}
+
+void QueryCache::evict(int64_t memory_limit)
+{
+  while (memory_usage_ > memory_limit && cache_.count() > 0) {
+    string victim;
+    Entry  victim_entry;
+    cache_.foreach_reverse([&victim, &victim_entry](const string &key, const Entry &entry) {
+      victim       = key;
+      victim_entry = entry;
+      return false;
+    });
+    remove_entry(victim, victim_entry);
+  }
+}
+
+void QueryCache::set_memory_limit(int64_t memory_limit)
+{
+  lock_guard<mutex> guard(mutex_);
+  memory_limit_.store(memory_limit);
+  evict(memory_limit);
+}
+
+int64_t QueryCache::memory_usage()
+{
+  lock_guard<mutex> guard(mutex_);
+  return memory_usage_;
+}
+
+size_t QueryCache::size()
+{
+  lock_guard<mutex> guard(mutex_);
+  return cache_.count();
+}
@@ -0,0 +1,192 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/lang/lru_cache.h"
+#include "common/rc.h"
+#include "sql/operator/physical_operator.h"
+
+class BaseTable;
+class QueryCache;
+
+/**
+ * @brief 缓存的查询结果
+ * @ingroup QueryCache
+ */
+struct QueryCacheResult
+{
+  TupleSchema                     schema;
+  std::vector<std::vector<Value>> rows;
+
+  /// @brief 估算结果占用的内存
+  int64_t memory_size() const;
+};
+
+/**
+ * @brief 查询结果依赖的表以及执行查询之前表的数据版本号
+ * @ingroup QueryCache
+ */
+using QueryCacheTableVersions = std::vector<std::pair<const BaseTable *, uint64_t>>;
+
+/**
+ * @brief 执行查询时记录结果的算子
+ * @ingroup QueryCache
+ * @details 包装在执行计划的最外层，所有操作都转给子算子，同时把输出的每一行复制下来。
+ * 子算子正常读到结尾并关闭后，把完整的结果放到查询缓存中。结果超过缓存的内存上限时放弃记录。
+ */
+class QueryCacheRecordPhysicalOperator : public PhysicalOperator
+{
+public:
+  QueryCacheRecordPhysicalOperator(QueryCache &cache, std::string key, uint64_t schema_version,
+      QueryCacheTableVersions table_versions, std::unique_ptr<PhysicalOperator> child);
+  virtual ~QueryCacheRecordPhysicalOperator() = default;
+
+  std::string          name() const override { return children_[0]->name(); }
+  std::string          param() const override { return children_[0]->param(); }
+  PhysicalOperatorType type() const override { return children_[0]->type(); }
+
+  RC open(Trx *trx) override;
+  RC next() override;
+  RC close() override;
+
+  Tuple *current_tuple() override { return children_[0]->current_tuple(); }
+
+  RC tuple_schema(TupleSchema &schema) const override { return children_[0]->tuple_schema(schema); }
+
+private:
+  QueryCache             &cache_;
+  std::string             key_;
+  uint64_t                schema_version_ = 0;
+  QueryCacheTableVersions table_versions_;
+
+  std::shared_ptr<QueryCacheResult> result_;
+  int64_t                           memory_size_ = 0;
+  bool                              recording_   = false;
+  bool                              finished_    = false;  ///< 子算子已经返回了 RECORD_EOF
+};
+
+/**
+ * @brief 输出缓存结果的算子
+ * @ingroup QueryCache
+ */
+class QueryCacheResultPhysicalOperator : public PhysicalOperator
+{
+public:
+  explicit QueryCacheResultPhysicalOperator(std::shared_ptr<const QueryCacheResult> result);
+  virtual ~QueryCacheResultPhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::CACHED_RESULT; }
+
+  RC open(Trx *trx) override;
+  RC next() override;
+  RC close() override { return RC::SUCCESS; }
+
+  Tuple *current_tuple() override { return &tuple_; }
+
+  RC tuple_schema(TupleSchema &schema) const override;
+
+private:
+  std::shared_ptr<const QueryCacheResult> result_;
+  size_t                                  row_pos_ = 0;
+  bool                                    started_ = false;
+  ValueListTuple                          tuple_;
+};
+
+/**
+ * @brief 查询结果缓存
+ * @defgroup QueryCache
+ * @details 缓存的键是当前的数据库名称加上原始的SQL，值是完整的查询结果。
+ * 缓存项中记录执行查询之前数据库的模式版本号以及查询用到的每张表的数据版本号。
+ * 表上的增删改、导入数据和事务提交都会递增表的数据版本号(BaseTable::increase_data_version)，
+ * 查找时只要有一个版本号对不上，缓存项就失效。
+ * 所有缓存结果的总大小不超过 memory_limit，超过时按照最近最少使用的顺序淘汰。
+ * 当前只缓存不带子查询的 SELECT 语句，并且计划中只能有普通表的扫描算子，不支持视图。
+ */
+class QueryCache
+{
+public:
+  static constexpr int64_t DEFAULT_MEMORY_LIMIT = 16 * 1024 * 1024;
+
+  explicit QueryCache(int64_t memory_limit = DEFAULT_MEMORY_LIMIT) : memory_limit_(memory_limit) {}
+  virtual ~QueryCache() = default;
+
+  /**
+   * @brief 根据SQL判断是否可以缓存
+   * @details 第一个单词是 SELECT，并且没有其它的 SELECT (即子查询)
+   */
+  static bool cacheable(const char *sql);
+
+  /**
+   * @brief 找到执行计划扫描的所有表
+   * @details 计划中有不认识的扫描算子(比如视图)时返回 RC::UNSUPPORTED
+   */
+  static RC collect_tables(PhysicalOperator &oper, std::vector<const BaseTable *> &tables);
+
+  /**
+   * @brief 记录当前每张表的数据版本号
+   */
+  static QueryCacheTableVersions table_versions(const std::vector<const BaseTable *> &tables);
+
+  /**
+   * @brief 查找缓存的结果
+   * @return 没有命中或者缓存项已经失效时返回 RC::NOTFOUND
+   */
+  RC get(const std::string &key, uint64_t schema_version, std::shared_ptr<const QueryCacheResult> &result);
+
+  /**
+   * @brief 缓存查询结果
+   * @param table_versions 执行查询之前记录的表数据版本号
+   * @return 结果超过内存上限时返回 RC::UNSUPPORTED
+   */
+  RC put(const std::string &key, uint64_t schema_version, QueryCacheTableVersions table_versions,
+      std::shared_ptr<QueryCacheResult> result);
+
+  void    set_memory_limit(int64_t memory_limit);
+  int64_t memory_limit() const { return memory_limit_.load(); }
+  int64_t memory_usage();
+
+  uint64_t hit_count() const { return hit_count_.load(); }
+  uint64_t miss_count() const { return miss_count_.load(); }
+  size_t   size();
+
+private:
+  struct Entry
+  {
+    uint64_t                                schema_version = 0;
+    QueryCacheTableVersions                 table_versions;
+    std::shared_ptr<const QueryCacheResult> result;
+    int64_t                                 memory_size = 0;
+  };
+
+  void remove_entry(const std::string &key, const Entry &entry);
+  /// @brief 淘汰最久没有使用的缓存项，直到内存占用不超过 memory_limit
+  void evict(int64_t memory_limit);
+
+private:
+  std::mutex                              mutex_;
+  std::atomic<int64_t>                    memory_limit_{DEFAULT_MEMORY_LIMIT};
+  int64_t                                 memory_usage_ = 0;
+  common::LruCache<std::string, Entry>    cache_;
+
+  std::atomic<uint64_t> hit_count_{0};
+  std::atomic<uint64_t> miss_count_{0};
+};
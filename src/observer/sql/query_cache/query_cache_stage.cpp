@@ -21,7 +21,74 @@ See the Mulan PSL v2 for more details. */
 #include "common/io/io.h"
 #include "common/lang/string.h"
 #include "common/log/log.h"
+#include "common/global_context.h"
+#include "event/session_event.h"
+#include "event/sql_event.h"
+#include "session/session.h"
+#include "sql/query_cache/query_cache.h"
+#include "sql/stmt/stmt.h"
+#include "storage/db/db.h"
 
+using namespace std;
 using namespace common;
 
-RC QueryCacheStage::handle_request(SQLStageEvent *sql_event) { return RC::SUCCESS; }
+static bool use_query_cache(Session *session, const string &sql)
+{
+  return GCTX.query_cache_ != nullptr && session->query_cache_on() && !session->is_trx_multi_operation_mode() &&
+         session->get_current_db() != nullptr && QueryCache::cacheable(sql.c_str());
+}
+
+static string query_cache_key(Session *session, const string &sql)
+{
+  string key(session->get_current_db_name());
+  key.append("|").append(sql);
+  return key;
+}
+
+RC QueryCacheStage::handle_request(SQLStageEvent *sql_event)
+{
+  Session *session = sql_event->session_event()->session();
+  if (!use_query_cache(session, sql_event->sql())) {
+    return RC::SUCCESS;
+  }
+
+  shared_ptr<const QueryCacheResult> result;
+
+  RC rc = GCTX.query_cache_->get(
+      query_cache_key(session, sql_event->sql()), session->get_current_db()->schema_version(), result);
+  if (OB_SUCC(rc)) {
+    LOG_TRACE("query cache hit. sql=%s", sql_event->sql().c_str());
+    session->set_used_chunk_mode(false);
+    sql_event->set_operator(make_unique<QueryCacheResultPhysicalOperator>(std::move(result)));
+  }
+  return RC::SUCCESS;
+}
+
+RC QueryCacheStage::handle_plan(SQLStageEvent *sql_event)
+{
+  Session                      *session = sql_event->session_event()->session();
+  unique_ptr<PhysicalOperator> &plan    = sql_event->physical_operator();
+  if (nullptr == plan || session->used_chunk_mode() || !use_query_cache(session, sql_event->sql())) {
+    return RC::SUCCESS;
+  }
+
+  // 命中执行计划缓存时没有 stmt
+  Stmt *stmt = sql_event->stmt();
+  if (stmt != nullptr && stmt->type() != StmtType::SELECT) {
+    return RC::SUCCESS;
+  }
+
+  vector<const BaseTable *> tables;
+  RC                        rc = QueryCache::collect_tables(*plan, tables);
+  if (OB_FAIL(rc)) {
+    return RC::SUCCESS;
+  }
+
+  // 版本号要在执行之前记录，执行过程中表被修改了，缓存的结果在下次查找时就会失效
+  plan = make_unique<QueryCacheRecordPhysicalOperator>(*GCTX.query_cache_,
+      query_cache_key(session, sql_event->sql()),
+      session->get_current_db()->schema_version(),
+      QueryCache::table_versions(tables),
+      std::move(plan));
+  return RC::SUCCESS;
+}
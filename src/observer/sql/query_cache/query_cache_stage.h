@@ -21,7 +21,10 @@ class SQLStageEvent;
 /**
  * @brief 查询缓存处理
  * @ingroup SQLStage
- * @details 当前什么都没做
+ * @details 缓存本身是全局的(GlobalContext::query_cache_)，参考 QueryCache。
+ * 会话打开 query_cache 变量后才使用：在解析之前用原始的SQL查找缓存，命中时直接输出缓存的结果；
+ * 没有命中时在生成的执行计划外面包装一层记录结果的算子，执行完成后把结果放到缓存中。
+ * 多语句事务中的查询可能读到自己未提交的修改，不使用缓存。
  */
 class QueryCacheStage
 {
@@ -30,5 +33,9 @@ public:
   virtual ~QueryCacheStage() = default;
 
 public:
+  /// @brief 查找缓存的结果，命中时设置输出结果的算子到 sql_event 中
   RC handle_request(SQLStageEvent *sql_event);
+
+  /// @brief 生成执行计划后，包装记录结果的算子
+  RC handle_plan(SQLStageEvent *sql_event);
 };
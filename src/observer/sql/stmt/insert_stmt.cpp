@@ -12,6 +12,7 @@ See the Mulan PSL v2 for more details. */
 // Created by Wangyunlai on 2022/5/22.
 //
 
+#include <unordered_set>
 #include <utility>
 
 #include "common/log/log.h"
@@ -121,9 +121,11 @@ RC SelectStmt::create(Db *db, SelectSqlNode &select_sql, Stmt *&stmt,
     order_by_.push_back({std::move(order_by_expressions[i]), select_sql.order_by[i].is_asc});
   }
 
-  int limit = -1;
+  int limit  = -1;
+  int offset = 0;
   if (select_sql.limit) {
-    limit = select_sql.limit->number;
+    limit  = select_sql.limit->number;
+    offset = select_sql.limit->offset;
   }
 
   // create filter statement in `where` statement
@@ -153,6 +155,7 @@ RC SelectStmt::create(Db *db, SelectSqlNode &select_sql, Stmt *&stmt,
   select_stmt->group_by_.swap(group_by_expressions);
   select_stmt->order_by_.swap(order_by_);
   select_stmt->limit_              = limit;
+  select_stmt->offset_             = offset;
   select_stmt->having_filter_stmt_ = having_filter_stmt;
   stmt                             = select_stmt;
   return RC::SUCCESS;
@@ -53,6 +53,7 @@ public:
   std::vector<OrderBySqlNode>              &order_by() { return order_by_; }
   std::vector<std::string>                 &tables_alias() { return tables_alias_; }
   int                                       limit() const { return limit_; }
+  int                                       offset() const { return offset_; }
 
 private:
   std::vector<std::unique_ptr<Expression>> query_expressions_;
@@ -63,4 +64,5 @@ private:
   std::vector<OrderBySqlNode>              order_by_;
   FilterStmt                              *having_filter_stmt_ = nullptr;
   int                                      limit_;
+  int                                      offset_ = 0;
 };
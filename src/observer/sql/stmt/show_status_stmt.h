@@ -0,0 +1,47 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#pragma once
+
+#include <strings.h>
+
+#include "common/log/log.h"
+#include "sql/stmt/stmt.h"
+
+struct ShowStatusSqlNode;
+
+/**
+ * @brief 显示运行状态的语句
+ * @ingroup Statement
+ * @details 当前只支持 SHOW STATUS
+ */
+class ShowStatusStmt : public Stmt
+{
+public:
+  ShowStatusStmt()          = default;
+  virtual ~ShowStatusStmt() = default;
+
+  StmtType type() const override { return StmtType::SHOW_STATUS; }
+
+  static RC create(const ShowStatusSqlNode &show_status, Stmt *&stmt)
+  {
+    if (0 != strcasecmp(show_status.name.c_str(), "status")) {
+      LOG_WARN("unsupported show command: %s", show_status.name.c_str());
+      return RC::UNSUPPORTED;
+    }
+
+    stmt = new ShowStatusStmt();
+    return RC::SUCCESS;
+  }
+};
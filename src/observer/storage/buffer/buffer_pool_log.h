@@ -103,6 +103,9 @@ public:
    */
   RC flush_page(Page &page);
 
+  /// @brief 用来登记正在写的日志，见 LogLsnGuard
+  LogHandler &log_handler() { return log_handler_; }
+
 private:
   RC append_log(BufferPoolOperation::Type type, PageNum page_num, LSN &lsn);
 
@@ -13,14 +13,20 @@ See the Mulan PSL v2 for more details. */
 //
 #include <errno.h>
 #include <string.h>
+#include <sys/uio.h>
 
 #include "common/io/io.h"
 #include "common/lang/mutex.h"
 #include "common/lang/algorithm.h"
+#include "common/lang/chrono.h"
+#include "common/lang/limits.h"
+#include "common/lang/thread.h"
 #include "common/log/log.h"
 #include "common/math/crc.h"
+#include "common/queue/blocking_queue.h"
 #include "storage/buffer/disk_buffer_pool.h"
 #include "storage/buffer/buffer_pool_log.h"
+#include "storage/clog/log_handler.h"
 #include "storage/db/db.h"
 
 using namespace common;
@@ -40,36 +46,86 @@ string BPFileHeader::to_string() const
 
 BPFrameManager::BPFrameManager(const char *name) : allocator_(name) {}
 
-RC BPFrameManager::init(int pool_num)
+RC BPFrameManager::init(int pool_num, int partition_num /* = DEFAULT_PARTITION_NUM */,
+    const char *eviction_policy /* = nullptr */)
 {
+  partition_num = max(partition_num, 1);
+
+  // 页帧是所有分区共享的，按照平均值估算每个分区的页帧个数
+  const size_t capacity = static_cast<size_t>(pool_num) * DEFAULT_ITEM_NUM_PER_POOL / partition_num;
+
+  partitions_.clear();
+  for (int i = 0; i < partition_num; i++) {
+    auto partition      = make_unique<Partition>();
+    partition->replacer = FrameReplacer::create(eviction_policy, capacity);
+    if (partition->replacer == nullptr) {
+      LOG_WARN("unknown buffer pool eviction policy: %s", eviction_policy);
+      partitions_.clear();
+      return RC::INVALID_ARGUMENT;
+    }
+    partitions_.emplace_back(std::move(partition));
+  }
+
   int ret = allocator_.init(false, pool_num);
-  if (ret == 0) {
-    return RC::SUCCESS;
+  if (ret != 0) {
+    return RC::NOMEM;
   }
-  return RC::NOMEM;
+  return RC::SUCCESS;
 }
 
 RC BPFrameManager::cleanup()
 {
-  if (frames_.count() > 0) {
+  if (frame_num() > 0) {
     return RC::INTERNAL;
   }
 
-  frames_.destroy();
+  for (unique_ptr<Partition> &partition : partitions_) {
+    partition->frames.clear();
+  }
   return RC::SUCCESS;
 }
 
-int BPFrameManager::purge_frames(int count, function<RC(Frame *frame)> purger)
+BPFrameManager::Partition &BPFrameManager::partition(const FrameId &frame_id)
 {
-  lock_guard<mutex> lock_guard(lock_);
+  // 高位是 buffer pool id，混合进来让不同文件的相同页号落到不同的分区
+  size_t hash = frame_id.hash();
+  hash ^= hash >> 32;
+  return *partitions_[hash % partitions_.size()];
+}
 
-  vector<Frame *> frames_can_purge;
+size_t BPFrameManager::frame_num() const
+{
+  size_t num = 0;
+  for (const unique_ptr<Partition> &partition : partitions_) {
+    num += partition->frames.size();
+  }
+  return num;
+}
+
+int BPFrameManager::purge_frames(int count, function<RC(Frame *frame)> purger)
+{
   if (count <= 0) {
     count = 1;
   }
+
+  // 每次从不同的分区开始找，避免总是淘汰同一个分区中的页面
+  const size_t start       = purge_cursor_.fetch_add(1);
+  int          freed_count = 0;
+  for (size_t i = 0; i < partitions_.size() && freed_count < count; i++) {
+    Partition &partition = *partitions_[(start + i) % partitions_.size()];
+    freed_count += purge_frames(partition, count - freed_count, purger);
+  }
+  return freed_count;
+}
+
+int BPFrameManager::purge_frames(Partition &partition, int count, const function<RC(Frame *frame)> &purger)
+{
+  lock_guard<mutex> lock_guard(partition.lock);
+
+  vector<Frame *> frames_can_purge;
   frames_can_purge.reserve(count);
 
-  auto purge_finder = [&frames_can_purge, count](const FrameId &frame_id, Frame *const frame) {
+  auto purge_finder = [&frames_can_purge, count](Frame *frame) {
     if (frame->can_purge()) {
       frame->pin();
       frames_can_purge.push_back(frame);
@@ -80,16 +136,19 @@ int BPFrameManager::purge_frames(int count, function<RC(Frame *frame)> purger)
     return true;  // true continue to look up
   };
 
-  frames_.foreach_reverse(purge_finder);
+  partition.replacer->foreach_victim(purge_finder);
+  if (frames_can_purge.empty()) {
+    return 0;
+  }
   LOG_INFO("purge frames find %ld pages total", frames_can_purge.size());
 
-  /// 当前还在frameManager的锁内，而 purger 是一个非常耗时的操作
-  /// 他需要把脏页数据刷新到磁盘上去，所以这里会极大地降低并发度
+  /// 当前还在分区的锁内，而 purger 是一个非常耗时的操作
+  /// 他需要把脏页数据刷新到磁盘上去，所以这里会降低这个分区的并发度
   int freed_count = 0;
   for (Frame *frame : frames_can_purge) {
     RC rc = purger(frame);
     if (RC::SUCCESS == rc) {
-      free_internal(frame->frame_id(), frame);
+      free_internal(partition, frame->frame_id(), frame, true /*evicted*/);
       freed_count++;
     } else {
       frame->unpin();
@@ -98,34 +157,115 @@ int BPFrameManager::purge_frames(int count, function<RC(Frame *frame)> purger)
     }
   }
   LOG_INFO("purge frame done. number=%d", freed_count);
+  evict_count_ += freed_count;
   return freed_count;
 }
 
-Frame *BPFrameManager::get(int buffer_pool_id, PageNum page_num)
+int BPFrameManager::collect_dirty_frames(int clean_count, int max_count, const function<void(Frame *frame)> &collector)
 {
-  FrameId frame_id(buffer_pool_id, page_num);
+  const int partition_count = static_cast<int>(partitions_.size());
+  const int partition_clean = (clean_count + partition_count - 1) / partition_count;
 
-  lock_guard<mutex> lock_guard(lock_);
-  return get_internal(frame_id);
+  int collected = 0;
+  for (unique_ptr<Partition> &partition : partitions_) {
+    if (collected >= max_count) {
+      break;
+    }
+
+    lock_guard<mutex> lock_guard(partition->lock);
+
+    int  clean_num = 0;
+    auto finder    = [&](Frame *frame) {
+      if (!frame->can_purge()) {
+        return true;
+      }
+      if (frame->dirty()) {
+        if (collected >= max_count) {
+          return false;
+        }
+        frame->pin();
+        collector(frame);
+        collected++;
+      }
+      return ++clean_num < partition_clean;
+    };
+    partition->replacer->foreach_victim(finder);
+  }
+  return collected;
 }
 
-Frame *BPFrameManager::get_internal(const FrameId &frame_id)
+int BPFrameManager::collect_old_dirty_frames(LSN lsn, int max_count, const function<void(Frame *frame)> &collector)
 {
-  Frame *frame = nullptr;
-  (void)frames_.get(frame_id, frame);
+  int collected = 0;
+  for (unique_ptr<Partition> &partition : partitions_) {
+    lock_guard<mutex> lock_guard(partition->lock);
+    for (auto &[frame_id, frame] : partition->frames) {
+      if (collected >= max_count) {
+        return collected;
+      }
+
+      const LSN rec_lsn = frame->rec_lsn();
+      if (frame->dirty() && rec_lsn != 0 && rec_lsn < lsn && frame->can_purge()) {
+        frame->pin();
+        collector(frame);
+        collected++;
+      }
+    }
+  }
+  return collected;
+}
+
+LSN BPFrameManager::min_rec_lsn()
+{
+  LSN min_lsn = 0;
+  for (unique_ptr<Partition> &partition : partitions_) {
+    lock_guard<mutex> lock_guard(partition->lock);
+    for (auto &[frame_id, frame] : partition->frames) {
+      // 写完日志、设置了LSN之后才会标记脏页，只看 rec_lsn
+      const LSN rec_lsn = frame->rec_lsn();
+      if (rec_lsn != 0 && (min_lsn == 0 || rec_lsn < min_lsn)) {
+        min_lsn = rec_lsn;
+      }
+    }
+  }
+  return min_lsn;
+}
+
+Frame *BPFrameManager::get(int buffer_pool_id, PageNum page_num)
+{
+  FrameId    frame_id(buffer_pool_id, page_num);
+  Partition &frame_partition = partition(frame_id);
+
+  lock_guard<mutex> lock_guard(frame_partition.lock);
+
+  Frame *frame = get_internal(frame_partition, frame_id);
   if (frame != nullptr) {
-    frame->pin();
+    hit_count_++;
   }
   return frame;
 }
 
+Frame *BPFrameManager::get_internal(Partition &partition, const FrameId &frame_id)
+{
+  auto iter = partition.frames.find(frame_id);
+  if (iter == partition.frames.end()) {
+    return nullptr;
+  }
+
+  Frame *frame = iter->second;
+  partition.replacer->access(frame);
+  frame->pin();
+  return frame;
+}
+
 Frame *BPFrameManager::alloc(int buffer_pool_id, PageNum page_num)
 {
-  FrameId frame_id(buffer_pool_id, page_num);
+  FrameId    frame_id(buffer_pool_id, page_num);
+  Partition &frame_partition = partition(frame_id);
 
-  lock_guard<mutex> lock_guard(lock_);
+  lock_guard<mutex> lock_guard(frame_partition.lock);
 
-  Frame *frame = get_internal(frame_id);
+  Frame *frame = get_internal(frame_partition, frame_id);
   if (frame != nullptr) {
     return frame;
   }
@@ -137,81 +277,171 @@ Frame *BPFrameManager::alloc(int buffer_pool_id, PageNum page_num)
     frame->set_buffer_pool_id(buffer_pool_id);
     frame->set_page_num(page_num);
     frame->pin();
-    frames_.put(frame_id, frame);
+    frame_partition.frames.emplace(frame_id, frame);
+    frame_partition.replacer->insert(frame);
+    miss_count_++;
   }
   return frame;
 }
 
+RC BPFrameManager::alloc_for_read_ahead(int buffer_pool_id, PageNum page_num, Frame *&frame)
+{
+  FrameId    frame_id(buffer_pool_id, page_num);
+  Partition &frame_partition = partition(frame_id);
+
+  frame = nullptr;
+
+  lock_guard<mutex> lock_guard(frame_partition.lock);
+  if (frame_partition.frames.find(frame_id) != frame_partition.frames.end()) {
+    return RC::SUCCESS;
+  }
+
+  Frame *new_frame = allocator_.alloc();
+  if (new_frame == nullptr) {
+    return RC::BUFFERPOOL_NOBUF;
+  }
+
+  ASSERT(new_frame->pin_count() == 0, "got an invalid frame that pin count is not 0. frame=%s",
+         new_frame->to_string().c_str());
+  new_frame->set_buffer_pool_id(buffer_pool_id);
+  new_frame->set_page_num(page_num);
+  new_frame->pin();
+  new_frame->write_latch();
+  frame_partition.frames.emplace(frame_id, new_frame);
+  frame_partition.replacer->insert(new_frame);
+  frame = new_frame;
+  return RC::SUCCESS;
+}
+
 RC BPFrameManager::free(int buffer_pool_id, PageNum page_num, Frame *frame)
 {
-  FrameId frame_id(buffer_pool_id, page_num);
+  FrameId    frame_id(buffer_pool_id, page_num);
+  Partition &frame_partition = partition(frame_id);
 
-  lock_guard<mutex> lock_guard(lock_);
-  return free_internal(frame_id, frame);
+  lock_guard<mutex> lock_guard(frame_partition.lock);
+  return free_internal(frame_partition, frame_id, frame, false /*evicted*/);
 }
 
-RC BPFrameManager::free_internal(const FrameId &frame_id, Frame *frame)
+RC BPFrameManager::try_free(int buffer_pool_id, PageNum page_num, Frame *frame)
 {
-  Frame                *frame_source = nullptr;
-  [[maybe_unused]] bool found        = frames_.get(frame_id, frame_source);
+  FrameId    frame_id(buffer_pool_id, page_num);
+  Partition &frame_partition = partition(frame_id);
+
+  lock_guard<mutex> lock_guard(frame_partition.lock);
+  if (frame->pin_count() != 1) {
+    return RC::LOCKED_UNLOCK;
+  }
+  return free_internal(frame_partition, frame_id, frame, false /*evicted*/);
+}
+
+RC BPFrameManager::free_internal(Partition &partition, const FrameId &frame_id, Frame *frame, bool evicted)
+{
+  auto                  iter         = partition.frames.find(frame_id);
+  [[maybe_unused]] bool found        = iter != partition.frames.end();
+  Frame                *frame_source = found ? iter->second : nullptr;
   ASSERT(found && frame == frame_source && frame->pin_count() == 1,
       "failed to free frame. found=%d, frameId=%s, frame_source=%p, frame=%p, pinCount=%d, lbt=%s",
       found, frame_id.to_string().c_str(), frame_source, frame, frame->pin_count(), lbt());
 
+  partition.replacer->remove(frame, evicted);
+  partition.frames.erase(iter);
+
   frame->set_page_num(-1);
   frame->unpin();
-  frames_.remove(frame_id);
   allocator_.free(frame);
   return RC::SUCCESS;
 }
 
 list<Frame *> BPFrameManager::find_list(int buffer_pool_id)
 {
-  lock_guard<mutex> lock_guard(lock_);
-
   list<Frame *> frames;
-  auto          fetcher = [&frames, buffer_pool_id](const FrameId &frame_id, Frame *const frame) -> bool {
-    if (buffer_pool_id == frame_id.buffer_pool_id()) {
-      frame->pin();
-      frames.push_back(frame);
+  for (unique_ptr<Partition> &partition : partitions_) {
+    lock_guard<mutex> lock_guard(partition->lock);
+    for (auto &[frame_id, frame] : partition->frames) {
+      if (buffer_pool_id == frame_id.buffer_pool_id()) {
+        frame->pin();
+        frames.push_back(frame);
+      }
     }
-    return true;
-  };
-  frames_.foreach (fetcher);
+  }
   return frames;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 BufferPoolIterator::BufferPoolIterator() {}
 BufferPoolIterator::~BufferPoolIterator() {}
-RC BufferPoolIterator::init(DiskBufferPool &bp, PageNum start_page /* = 0 */)
+RC BufferPoolIterator::init(DiskBufferPool &bp, PageNum start_page /* = 0 */, PageNum end_page /* = -1 */)
 {
-  bitmap_.init(bp.file_header_->bitmap, bp.file_header_->page_count);
+  buffer_pool_ = &bp;
+  page_count_  = bp.file_header_->page_count;
+  if (end_page >= 0) {
+    page_count_ = min(page_count_, end_page);
+  }
   if (start_page <= 0) {
     current_page_num_ = -1;
   } else {
     current_page_num_ = start_page - 1;
   }
+  sequential_count_    = 0;
+  read_ahead_page_num_ = -1;
   return RC::SUCCESS;
 }
 
-bool BufferPoolIterator::has_next() { return bitmap_.next_setted_bit(current_page_num_ + 1) != -1; }
+bool BufferPoolIterator::has_next()
+{
+  return buffer_pool_->alloc_map_.next_allocated_page(current_page_num_ + 1, page_count_) != BP_INVALID_PAGE_NUM;
+}
 
 PageNum BufferPoolIterator::next()
 {
-  PageNum next_page = bitmap_.next_setted_bit(current_page_num_ + 1);
-  if (next_page != -1) {
+  PageNum next_page = buffer_pool_->alloc_map_.next_allocated_page(current_page_num_ + 1, page_count_);
+  if (next_page != BP_INVALID_PAGE_NUM) {
     current_page_num_ = next_page;
+    read_ahead(next_page);
   }
   return next_page;
 }
 
 RC BufferPoolIterator::reset()
 {
-  current_page_num_ = 0;
+  current_page_num_    = 0;
+  sequential_count_    = 0;
+  read_ahead_page_num_ = -1;
   return RC::SUCCESS;
 }
 
+void BufferPoolIterator::read_ahead(PageNum page_num)
+{
+  // 只访问几个页面的扫描(比如带 LIMIT 的查询)不做预读
+  if (buffer_pool_ == nullptr || ++sequential_count_ < READ_AHEAD_TRIGGER) {
+    return;
+  }
+
+  // 预读的页面还有一半没有访问时不发起新的预读
+  if (read_ahead_page_num_ - page_num >= READ_AHEAD_PAGE_NUM / 2) {
+    return;
+  }
+
+  vector<PageNum> page_nums;
+  PageNum         next_page = max(page_num, read_ahead_page_num_);
+  while (static_cast<int>(page_nums.size()) < READ_AHEAD_PAGE_NUM) {
+    next_page = buffer_pool_->alloc_map_.next_allocated_page(next_page + 1, page_count_);
+    if (next_page == BP_INVALID_PAGE_NUM) {
+      break;
+    }
+    page_nums.push_back(next_page);
+  }
+
+  if (page_nums.empty()) {
+    // 已经预读到文件末尾
+    read_ahead_page_num_ = numeric_limits<PageNum>::max();
+    return;
+  }
+
+  read_ahead_page_num_ = page_nums.back();
+  (void)buffer_pool_->read_ahead(std::move(page_nums));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 DiskBufferPool::DiskBufferPool(BufferPoolManager &bp_manager, BPFrameManager &frame_manager,
     DoubleWriteBuffer &dblwr_manager, LogHandler &log_handler)
@@ -272,6 +502,20 @@ RC DiskBufferPool::open_file(const char *file_name)
 
   file_header_ = (BPFileHeader *)hdr_frame_->data();
 
+  alloc_map_.clear();
+  alloc_map_.add_segment(hdr_frame_, file_header_->bitmap);
+  for (int segment = 1; alloc_map_.segment_first_page(segment) < file_header_->page_count; segment++) {
+    if (OB_FAIL(rc = load_map_page(alloc_map_.segment_first_page(segment), false /*create*/))) {
+      LOG_ERROR("Failed to load allocation map of %s. segment=%d, rc=%s", file_name, segment, strrc(rc));
+      release_map_pages();
+      purge_all_pages();
+      purge_frame(BP_HEADER_PAGE, hdr_frame_);
+      close(fd);
+      file_desc_ = -1;
+      return rc;
+    }
+  }
+
   LOG_INFO("Successfully open %s. file_desc=%d, hdr_frame=%p, file header=%s",
            file_name, file_desc_, hdr_frame_, file_header_->to_string().c_str());
   return RC::SUCCESS;
@@ -284,7 +528,24 @@ RC DiskBufferPool::close_file()
     return rc;
   }
 
+  wait_read_ahead();
+
+  // 关闭文件时已经没有人访问这些页面了
+  dispose_deferred_pages();
+  {
+    lock_guard<mutex> deferred_guard(deferred_lock_);
+    if (!deferred_pages_.empty()) {
+      LOG_WARN("some disposed pages are still pinned while closing file. file=%s, count=%d",
+               file_name_.c_str(), static_cast<int>(deferred_pages_.size()));
+      deferred_pages_.clear();
+    }
+  }
+
+  // 后台刷脏页的线程一轮刷完之前不能关闭文件
+  unique_lock<mutex> cleaner_guard(bp_manager_.page_cleaner().lock());
+
   hdr_frame_->unpin();
+  release_map_pages();
 
   // TODO: 理论上是在回放时回滚未提交事务，但目前没有undo log，因此不下刷数据page，只通过redo log回放
   rc = purge_all_pages();
@@ -307,6 +568,7 @@ RC DiskBufferPool::close_file()
   }
   LOG_INFO("Successfully close file %d:%s.", file_desc_, file_name_.c_str());
   file_desc_ = -1;
+  cleaner_guard.unlock();
 
   bp_manager_.close_file(file_name_.c_str());
   return RC::SUCCESS;
@@ -317,8 +579,14 @@ RC DiskBufferPool::get_this_page(PageNum page_num, Frame **frame)
   RC rc  = RC::SUCCESS;
   *frame = nullptr;
 
+  bool   waited           = false;
   Frame *used_match_frame = frame_manager_.get(id(), page_num);
   if (used_match_frame != nullptr) {
+    rc = wait_page_loaded(page_num, used_match_frame, waited);
+    if (OB_FAIL(rc)) {
+      used_match_frame->unpin();
+      return rc;
+    }
     used_match_frame->access();
     *frame = used_match_frame;
     return RC::SUCCESS;
@@ -339,6 +607,19 @@ RC DiskBufferPool::get_this_page(PageNum page_num, Frame **frame)
   // allocated_frame->pin(); // pined in manager::get
   allocated_frame->access();
 
+  // 查找之后预读线程可能刚好把这个页面放到了内存中
+  rc = wait_page_loaded(page_num, allocated_frame, waited);
+  if (OB_FAIL(rc)) {
+    if (OB_FAIL(purge_frame(page_num, allocated_frame))) {
+      allocated_frame->unpin();
+    }
+    return rc;
+  }
+  if (waited) {
+    *frame = allocated_frame;
+    return RC::SUCCESS;
+  }
+
   if ((rc = load_page(page_num, allocated_frame)) != RC::SUCCESS) {
     LOG_ERROR("Failed to load page %s:%d", file_name_.c_str(), page_num);
     purge_frame(page_num, allocated_frame);
@@ -353,43 +634,52 @@ RC DiskBufferPool::allocate_page(Frame **frame)
 {
   RC rc = RC::SUCCESS;
 
+  // 延迟释放的页面不再被pin着时可以重新分配出去
+  dispose_deferred_pages();
+
   lock_.lock();
 
-  int byte = 0, bit = 0;
-  if ((file_header_->allocated_pages) < (file_header_->page_count)) {
+  PageNum free_page_num = alloc_map_.find_free_page(file_header_->page_count);
+  if (free_page_num != BP_INVALID_PAGE_NUM) {
     // There is one free page
-    for (int i = 0; i < file_header_->page_count; i++) {
-      byte = i / 8;
-      bit  = i % 8;
-      if (((file_header_->bitmap[byte]) & (1 << bit)) == 0) {
-        (file_header_->allocated_pages)++;
-        file_header_->bitmap[byte] |= (1 << bit);
-        // TODO,  do we need clean the loaded page's data?
-        hdr_frame_->mark_dirty();
-        LSN lsn = 0;
-        rc      = log_handler_.allocate_page(i, lsn);
-        if (OB_FAIL(rc)) {
-          LOG_ERROR("Failed to log allocate page %d, rc=%s", i, strrc(rc));
-          // 忽略了错误
-        }
+    LogLsnGuard lsn_guard(log_handler_.log_handler());
+    LSN         lsn = 0;
+    rc              = log_handler_.allocate_page(free_page_num, lsn);
+    if (OB_FAIL(rc)) {
+      LOG_ERROR("Failed to log allocate page %d, rc=%s", free_page_num, strrc(rc));
+      // 忽略了错误
+    }
 
-        hdr_frame_->set_lsn(lsn);
+    Frame *map_frame = alloc_map_.set_bit(free_page_num);
+    map_frame->set_lsn(lsn);
+    map_frame->mark_dirty();
 
-        lock_.unlock();
-        return get_this_page(i, frame);
-      }
-    }
+    (file_header_->allocated_pages)++;
+    // TODO,  do we need clean the loaded page's data?
+    hdr_frame_->mark_dirty();
+    hdr_frame_->set_lsn(lsn);
+
+    lock_.unlock();
+    return get_this_page(free_page_num, frame);
   }
 
-  if (file_header_->page_count >= BPFileHeader::MAX_PAGE_NUM) {
-    LOG_WARN("file buffer pool is full. page count %d, max page count %d",
-        file_header_->page_count, BPFileHeader::MAX_PAGE_NUM);
+  // 留出新的段的位图页面
+  if (file_header_->page_count >= numeric_limits<PageNum>::max() - 1) {
+    LOG_WARN("file buffer pool is full. page count %d", file_header_->page_count);
     lock_.unlock();
     return RC::BUFFERPOOL_NOBUF;
   }
 
-  LSN lsn = 0;
-  rc      = log_handler_.allocate_page(file_header_->page_count, lsn);
+  // 文件增长到了新的段，先分配段的位图页面
+  if (alloc_map_.is_map_page(file_header_->page_count) && OB_FAIL(rc = allocate_map_page())) {
+    LOG_WARN("Failed to allocate allocation map page. file=%s, rc=%s", file_name_.c_str(), strrc(rc));
+    lock_.unlock();
+    return rc;
+  }
+
+  LogLsnGuard lsn_guard(log_handler_.log_handler());
+  LSN         lsn = 0;
+  rc              = log_handler_.allocate_page(file_header_->page_count, lsn);
   if (OB_FAIL(rc)) {
     LOG_ERROR("Failed to log allocate page %d, rc=%s", file_header_->page_count, strrc(rc));
     // 忽略了错误
@@ -409,12 +699,12 @@ RC DiskBufferPool::allocate_page(Frame **frame)
 
   file_header_->allocated_pages++;
   file_header_->page_count++;
-
-  byte = page_num / 8;
-  bit  = page_num % 8;
-  file_header_->bitmap[byte] |= (1 << bit);
   hdr_frame_->mark_dirty();
 
+  Frame *map_frame = alloc_map_.set_bit(page_num);
+  map_frame->set_lsn(lsn);
+  map_frame->mark_dirty();
+
   allocated_frame->set_buffer_pool_id(id());
   allocated_frame->access();
   allocated_frame->clear_page();
@@ -439,29 +729,90 @@ RC DiskBufferPool::dispose_page(PageNum page_num)
     LOG_ERROR("Failed to dispose page %d, because it is the first page. filename=%s", page_num, file_name_.c_str());
     return RC::INTERNAL;
   }
+  if (alloc_map_.is_map_page(page_num)) {
+    LOG_ERROR("Failed to dispose page %d, because it is an allocation map page. filename=%s",
+              page_num, file_name_.c_str());
+    return RC::INTERNAL;
+  }
 
-  scoped_lock lock_guard(lock_);
-  Frame      *used_frame = frame_manager_.get(id(), page_num);
-  if (used_frame != nullptr) {
-    ASSERT("the page try to dispose is in use. frame:%s", used_frame->to_string().c_str());
-    frame_manager_.free(id(), page_num, used_frame);
-  } else {
+  // B+树的乐观读不加锁，只pin着页面，释放页帧前要等它们离开。读者校验版本号时会发现页面已经修改过，
+  // 很快就会释放页面。预读或者悲观读的线程可能pin很久，这时不等它们，先放到延迟释放列表中
+  if (!free_frame_for_dispose(page_num, DISPOSE_YIELD_TIMES)) {
+    LOG_DEBUG("page is still pinned, defer disposing it. file=%s, page=%d", file_name_.c_str(), page_num);
+    lock_guard<mutex> deferred_guard(deferred_lock_);
+    deferred_pages_.push_back(page_num);
+    return RC::SUCCESS;
+  }
+
+  deallocate_page(page_num);
+  dispose_deferred_pages();
+  return RC::SUCCESS;
+}
+
+bool DiskBufferPool::free_frame_for_dispose(PageNum page_num, int yield_times)
+{
+  Frame *used_frame = frame_manager_.get(id(), page_num);
+  if (used_frame == nullptr) {
     LOG_DEBUG("page not found in memory while disposing it. pageNum=%d", page_num);
+    return true;
   }
 
-  LSN lsn = 0;
-  RC  rc  = log_handler_.deallocate_page(page_num, lsn);
+  bp_manager_.page_cleaner().wait_frame_flushed(used_frame);
+  for (int i = 0; OB_FAIL(frame_manager_.try_free(id(), page_num, used_frame)); i++) {
+    if (i >= yield_times) {
+      used_frame->unpin();
+      return false;
+    }
+    std::this_thread::yield();
+  }
+  return true;
+}
+
+void DiskBufferPool::deallocate_page(PageNum page_num)
+{
+  scoped_lock lock_guard(lock_);
+
+  LogLsnGuard lsn_guard(log_handler_.log_handler());
+  LSN         lsn = 0;
+  RC          rc  = log_handler_.deallocate_page(page_num, lsn);
   if (OB_FAIL(rc)) {
     LOG_ERROR("Failed to log deallocate page %d, rc=%s", page_num, strrc(rc));
     // ignore error handle
   }
 
+  Frame *map_frame = alloc_map_.clear_bit(page_num);
+  map_frame->set_lsn(lsn);
+  map_frame->mark_dirty();
+
   hdr_frame_->set_lsn(lsn);
   hdr_frame_->mark_dirty();
   file_header_->allocated_pages--;
-  char tmp = 1 << (page_num % 8);
-  file_header_->bitmap[page_num / 8] &= ~tmp;
-  return RC::SUCCESS;
+}
+
+void DiskBufferPool::dispose_deferred_pages()
+{
+  vector<PageNum> page_nums;
+  {
+    lock_guard<mutex> deferred_guard(deferred_lock_);
+    page_nums.swap(deferred_pages_);
+  }
+  if (page_nums.empty()) {
+    return;
+  }
+
+  vector<PageNum> pinned_page_nums;
+  for (PageNum page_num : page_nums) {
+    if (free_frame_for_dispose(page_num, 0 /*yield_times*/)) {
+      deallocate_page(page_num);
+    } else {
+      pinned_page_nums.push_back(page_num);
+    }
+  }
+
+  if (!pinned_page_nums.empty()) {
+    lock_guard<mutex> deferred_guard(deferred_lock_);
+    deferred_pages_.insert(deferred_pages_.end(), pinned_page_nums.begin(), pinned_page_nums.end());
+  }
 }
 
 RC DiskBufferPool::unpin_page(Frame *frame)
@@ -472,6 +823,7 @@ RC DiskBufferPool::unpin_page(Frame *frame)
 
 RC DiskBufferPool::purge_frame(PageNum page_num, Frame *buf)
 {
+  bp_manager_.page_cleaner().wait_frame_flushed(buf);
   if (buf->pin_count() != 1) {
     LOG_INFO("Begin to free page %d frame_id=%s, but it's pin count > 1:%d.",
         buf->page_num(), buf->frame_id().to_string().c_str(), buf->pin_count());
@@ -523,10 +875,12 @@ RC DiskBufferPool::check_all_pages_unpinned()
   scoped_lock lock_guard(lock_);
   for (Frame *frame : frames) {
     frame->unpin();
-    if (frame->page_num() == BP_HEADER_PAGE && frame->pin_count() > 1) {
+    // 文件头和段的位图页面一直是 pin 住的
+    const bool always_pinned = frame->page_num() == BP_HEADER_PAGE || alloc_map_.is_map_page(frame->page_num());
+    if (always_pinned && frame->pin_count() > 1) {
       LOG_WARN("This page has been pinned. id=%d, pageNum:%d, pin count=%d",
           id(), frame->page_num(), frame->pin_count());
-    } else if (frame->page_num() != BP_HEADER_PAGE && frame->pin_count() > 0) {
+    } else if (!always_pinned && frame->pin_count() > 0) {
       LOG_WARN("This page has been pinned. id=%d, pageNum:%d, pin count=%d",
           id(), frame->page_num(), frame->pin_count());
     }
@@ -546,6 +900,9 @@ RC DiskBufferPool::flush_page_internal(Frame &frame)
   // The better way is use mmap the block into memory,
   // so it is easier to flush data to file.
 
+  // 后台线程正在刷这个页面的旧内容，等它写完，否则新的内容可能会被旧的覆盖
+  bp_manager_.page_cleaner().wait_frame_flushed(&frame);
+
   RC rc = log_handler_.flush_page(frame.page());
   if (OB_FAIL(rc)) {
     LOG_ERROR("Failed to log flush frame= %s, rc=%s", frame.to_string().c_str(), strrc(rc));
@@ -579,17 +936,39 @@ RC DiskBufferPool::flush_all_pages()
   return RC::SUCCESS;
 }
 
-RC DiskBufferPool::recover_page(PageNum page_num)
+RC DiskBufferPool::flush_old_map_pages(LSN lsn, int &count)
 {
-  int byte = 0, bit = 0;
-  byte = page_num / 8;
-  bit  = page_num % 8;
+  scoped_lock lock_guard(lock_);
+
+  count = 0;
+  for (int segment = 0; segment < alloc_map_.segment_num(); segment++) {
+    Frame    *frame   = alloc_map_.segment_frame(segment);
+    const LSN rec_lsn = frame->rec_lsn();
+    if (!frame->dirty() || rec_lsn == 0 || rec_lsn >= lsn) {
+      continue;
+    }
+
+    RC rc = flush_page_internal(*frame);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    count++;
+  }
+  return RC::SUCCESS;
+}
 
+RC DiskBufferPool::recover_page(PageNum page_num)
+{
   scoped_lock lock_guard(lock_);
-  if (!(file_header_->bitmap[byte] & (1 << bit))) {
-    file_header_->bitmap[byte] |= (1 << bit);
+  RC          rc = load_map_page_for_redo(page_num, 0 /*lsn*/);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  if (!alloc_map_.get_bit(page_num)) {
+    alloc_map_.set_bit(page_num)->mark_dirty();
     file_header_->allocated_pages++;
-    file_header_->page_count++;
+    file_header_->page_count = max(file_header_->page_count, page_num + 1);
     hdr_frame_->mark_dirty();
   }
   return RC::SUCCESS;
@@ -613,96 +992,168 @@ RC DiskBufferPool::write_page(PageNum page_num, Page &page)
   return RC::SUCCESS;
 }
 
-RC DiskBufferPool::redo_allocate_page(LSN lsn, PageNum page_num)
+RC DiskBufferPool::write_pages(PageNum first_page_num, const vector<Page *> &pages)
 {
-  if (hdr_frame_->lsn() >= lsn) {
-    return RC::SUCCESS;
+  if (pages.size() == 1) {
+    return write_page(first_page_num, *pages[0]);
+  }
+
+  vector<struct iovec> iov(pages.size());
+  for (size_t i = 0; i < pages.size(); i++) {
+    iov[i].iov_base = pages[i];
+    iov[i].iov_len  = sizeof(Page);
+  }
+
+  const int64_t offset   = static_cast<int64_t>(first_page_num) * sizeof(Page);
+  const ssize_t expected = static_cast<ssize_t>(pages.size() * sizeof(Page));
+  const ssize_t ret      = pwritev(file_desc_, iov.data(), static_cast<int>(iov.size()), offset);
+  if (ret != expected) {
+    // 可能只写了一部分，逐个页面重新写
+    LOG_WARN("failed to write pages. file=%s, page num=%d, count=%d, ret=%ld, error=%s",
+             file_name_.c_str(), first_page_num, static_cast<int>(pages.size()), ret, strerror(errno));
+    for (size_t i = 0; i < pages.size(); i++) {
+      RC rc = write_page(first_page_num + static_cast<PageNum>(i), *pages[i]);
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+    }
   }
 
-  // scoped_lock lock_guard(lock_); // redo 过程中可以不加锁
-  if (page_num < file_header_->page_count) {
-    Bitmap bitmap(file_header_->bitmap, file_header_->page_count);
-    if (bitmap.get_bit(page_num)) {
-      LOG_WARN("page %d has been allocated. file=%s", page_num, file_name_.c_str());
-      return RC::SUCCESS;
-    }
+  LOG_TRACE("write_pages: buffer_pool_id:%d, page_num:%d, count=%d", id(), first_page_num, static_cast<int>(pages.size()));
+  return RC::SUCCESS;
+}
 
-    bitmap.set_bit(page_num);
-    file_header_->allocated_pages++;
-    hdr_frame_->mark_dirty();
-    return RC::SUCCESS;
+RC DiskBufferPool::sync_file()
+{
+  if (fsync(file_desc_) != 0) {
+    LOG_ERROR("Failed to sync file %s, due to %s.", file_name_.c_str(), strerror(errno));
+    return RC::IOERR_SYNC;
+  }
+  return RC::SUCCESS;
+}
+
+RC DiskBufferPool::flush_page_copies(PageNum first_page_num, const vector<Page *> &pages)
+{
+  for (Page *page : pages) {
+    RC rc = log_handler_.flush_page(*page);
+    if (OB_FAIL(rc)) {
+      LOG_ERROR("Failed to log flush page. file=%s, lsn=%d, rc=%s", file_name_.c_str(), page->lsn, strrc(rc));
+      // ignore error handle
+    }
+    page->check_sum = crc32(page->data, BP_PAGE_DATA_SIZE);
   }
 
+  return dblwr_manager_.add_pages(this, first_page_num, pages);
+}
+
+RC DiskBufferPool::redo_allocate_page(LSN lsn, PageNum page_num)
+{
+  // 并行回放日志时，其它线程可能在同时访问这个文件的页面
+  scoped_lock lock_guard(lock_);
   if (page_num > file_header_->page_count) {
     LOG_WARN("page %d is not continuous. file=%s, page_count=%d",
              page_num, file_name_.c_str(), file_header_->page_count);
     return RC::INTERNAL;
   }
 
-  // page_num == file_header_->page_count
-  if (file_header_->page_count >= BPFileHeader::MAX_PAGE_NUM) {
-    LOG_WARN("file buffer pool is full. page count %d, max page count %d",
-        file_header_->page_count, BPFileHeader::MAX_PAGE_NUM);
-    return RC::INTERNAL;
+  if (page_num == file_header_->page_count) {
+    if (file_header_->page_count >= numeric_limits<PageNum>::max()) {
+      LOG_WARN("file buffer pool is full. page count %d", file_header_->page_count);
+      return RC::INTERNAL;
+    }
+
+    // 新的段的第一个页面是段的位图页面
+    RC rc = load_map_page_for_redo(page_num, lsn);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+
+    file_header_->page_count++;
+    hdr_frame_->mark_dirty();
+
+    // TODO 应该检查文件是否足够大，包含了当前新分配的页面
+    LOG_TRACE("[redo] allocate new page. file=%s, pageNum=%d", file_name_.c_str(), page_num);
   }
 
-  file_header_->allocated_pages++;
-  file_header_->page_count++;
-  hdr_frame_->set_lsn(lsn);
-  hdr_frame_->mark_dirty();
+  // 页面的分配位图可能在文件头中，也可能在段的位图页面中，根据位图所在页面的LSN判断是否需要回放
+  Frame *map_frame = alloc_map_.segment_frame(alloc_map_.segment_of(page_num));
+  if (map_frame->lsn() >= lsn) {
+    return RC::SUCCESS;
+  }
 
-  // TODO 应该检查文件是否足够大，包含了当前新分配的页面
+  if (alloc_map_.get_bit(page_num)) {
+    LOG_WARN("page %d has been allocated. file=%s", page_num, file_name_.c_str());
+  } else {
+    alloc_map_.set_bit(page_num);
+  }
+  map_frame->set_lsn(lsn);
+  map_frame->mark_dirty();
 
-  Bitmap bitmap(file_header_->bitmap, file_header_->page_count);
-  bitmap.set_bit(page_num);
-  LOG_TRACE("[redo] allocate new page. file=%s, pageNum=%d", file_name_.c_str(), page_num);
+  file_header_->allocated_pages = alloc_map_.allocated_page_num();
+  hdr_frame_->set_lsn(max(hdr_frame_->lsn(), lsn));
+  hdr_frame_->mark_dirty();
   return RC::SUCCESS;
 }
 
 RC DiskBufferPool::redo_deallocate_page(LSN lsn, PageNum page_num)
 {
-  if (hdr_frame_->lsn() >= lsn) {
-    return RC::SUCCESS;
-  }
-
+  scoped_lock lock_guard(lock_);
   if (page_num >= file_header_->page_count) {
     LOG_WARN("page %d is not exist. file=%s", page_num, file_name_.c_str());
     return RC::INTERNAL;
   }
 
-  Bitmap bitmap(file_header_->bitmap, file_header_->page_count);
-  if (!bitmap.get_bit(page_num)) {
+  Frame *map_frame = alloc_map_.segment_frame(alloc_map_.segment_of(page_num));
+  if (map_frame->lsn() >= lsn) {
+    return RC::SUCCESS;
+  }
+
+  if (!alloc_map_.get_bit(page_num)) {
     LOG_WARN("page %d has been deallocated. file=%s", page_num, file_name_.c_str());
     return RC::INTERNAL;
   }
 
-  bitmap.clear_bit(page_num);
-  file_header_->allocated_pages--;
-  hdr_frame_->set_lsn(lsn);
+  alloc_map_.clear_bit(page_num);
+  map_frame->set_lsn(lsn);
+  map_frame->mark_dirty();
+
+  file_header_->allocated_pages = alloc_map_.allocated_page_num();
+  hdr_frame_->set_lsn(max(hdr_frame_->lsn(), lsn));
   hdr_frame_->mark_dirty();
   LOG_TRACE("[redo] deallocate page. file=%s, pageNum=%d", file_name_.c_str(), page_num);
   return RC::SUCCESS;
 }
 
-RC DiskBufferPool::allocate_frame(PageNum page_num, Frame **buffer)
+bool DiskBufferPool::is_page_allocated(PageNum page_num) const
 {
-  auto purger = [this](Frame *frame) {
-    if (!frame->dirty()) {
-      return RC::SUCCESS;
-    }
+  return page_num >= 0 && page_num < file_header_->page_count && !alloc_map_.is_map_page(page_num) &&
+         alloc_map_.get_bit(page_num);
+}
 
-    RC rc = RC::SUCCESS;
-    if (frame->buffer_pool_id() == id()) {
-      rc = this->flush_page_internal(*frame);
-    } else {
-      rc = bp_manager_.flush_page(*frame);
-    }
+RC DiskBufferPool::flush_frame_for_purge(Frame *frame)
+{
+  if (!frame->dirty()) {
+    return RC::SUCCESS;
+  }
 
-    if (rc != RC::SUCCESS) {
-      LOG_ERROR("Failed to aclloc block due to failed to flush old block. rc=%s", strrc(rc));
-    }
-    return rc;
-  };
+  bp_manager_.page_cleaner().add_sync_flush_count();
+
+  RC rc = RC::SUCCESS;
+  if (frame->buffer_pool_id() == id()) {
+    rc = this->flush_page_internal(*frame);
+  } else {
+    rc = bp_manager_.flush_page(*frame);
+  }
+
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("Failed to aclloc block due to failed to flush old block. rc=%s", strrc(rc));
+  }
+  return rc;
+}
+
+RC DiskBufferPool::allocate_frame(PageNum page_num, Frame **buffer)
+{
+  auto purger = [this](Frame *frame) { return flush_frame_for_purge(frame); };
 
   while (true) {
     Frame *frame = frame_manager_.alloc(id(), page_num);
@@ -720,11 +1171,7 @@ RC DiskBufferPool::allocate_frame(PageNum page_num, Frame **buffer)
 
 RC DiskBufferPool::check_page_num(PageNum page_num)
 {
-  if (page_num >= file_header_->page_count) {
-    LOG_ERROR("Invalid pageNum:%d, file's name:%s", page_num, file_name_.c_str());
-    return RC::BUFFERPOOL_INVALID_PAGE_NUM;
-  }
-  if ((file_header_->bitmap[page_num / 8] & (1 << (page_num % 8))) == 0) {
+  if (!is_page_allocated(page_num)) {
     LOG_ERROR("Invalid pageNum:%d, file's name:%s", page_num, file_name_.c_str());
     return RC::BUFFERPOOL_INVALID_PAGE_NUM;
   }
@@ -761,22 +1208,321 @@ RC DiskBufferPool::load_page(PageNum page_num, Frame *frame)
   return RC::SUCCESS;
 }
 
+RC DiskBufferPool::load_map_page(PageNum page_num, bool create, LSN lsn /* = 0 */)
+{
+  Frame *frame = nullptr;
+  RC     rc    = allocate_frame(page_num, &frame);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("failed to allocate frame for allocation map page. file=%s, page num=%d", file_name_.c_str(), page_num);
+    return rc;
+  }
+
+  frame->set_buffer_pool_id(id());
+  frame->access();
+
+  BPAllocMapPage *map_page = reinterpret_cast<BPAllocMapPage *>(frame->data());
+  if (create) {
+    frame->clear_page();
+    frame->set_page_num(page_num);
+    frame->set_lsn(lsn);
+    frame->mark_dirty();
+    Bitmap(map_page->bitmap, BPAllocMapPage::MAX_PAGE_NUM).set_bit(0);
+  } else if (OB_FAIL(rc = load_page(page_num, frame))) {
+    LOG_ERROR("failed to load allocation map page. file=%s, page num=%d, rc=%s",
+              file_name_.c_str(), page_num, strrc(rc));
+    purge_frame(page_num, frame);
+    return rc;
+  }
+
+  alloc_map_.add_segment(frame, map_page->bitmap);
+  return RC::SUCCESS;
+}
+
+RC DiskBufferPool::load_map_page_for_redo(PageNum page_num, LSN lsn)
+{
+  while (!alloc_map_.contains(page_num)) {
+    const PageNum map_page_num = alloc_map_.segment_first_page(alloc_map_.segment_num());
+
+    // 文件头中的页面个数可能比较旧，位图页面已经写到磁盘上了
+    struct stat   st;
+    const int64_t map_page_end = (static_cast<int64_t>(map_page_num) + 1) * BP_PAGE_SIZE;
+    const bool    on_disk      = fstat(file_desc_, &st) == 0 && st.st_size >= map_page_end;
+
+    RC rc = load_map_page(map_page_num, !on_disk /*create*/, lsn);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    LOG_INFO("[redo] load allocation map page. file=%s, page num=%d, on disk=%d",
+             file_name_.c_str(), map_page_num, on_disk);
+  }
+  return RC::SUCCESS;
+}
+
+RC DiskBufferPool::allocate_map_page()
+{
+  const PageNum page_num = file_header_->page_count;
+
+  LogLsnGuard lsn_guard(log_handler_.log_handler());
+  LSN         lsn = 0;
+  RC          rc  = log_handler_.allocate_page(page_num, lsn);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to log allocate page %d, rc=%s", page_num, strrc(rc));
+    // 忽略了错误
+  }
+
+  rc = load_map_page(page_num, true /*create*/, lsn);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  file_header_->allocated_pages++;
+  file_header_->page_count++;
+  hdr_frame_->set_lsn(lsn);
+  hdr_frame_->mark_dirty();
+
+  // 与新分配的数据页面一样，马上写一次来扩展文件
+  Frame *frame = alloc_map_.segment_frame(alloc_map_.segment_num() - 1);
+  if (OB_FAIL(rc = flush_page_internal(*frame))) {
+    LOG_WARN("Failed to flush allocation map page %s:%d. rc=%s", file_name_.c_str(), page_num, strrc(rc));
+  }
+
+  LOG_INFO("allocate allocation map page. file=%s, pageNum=%d, segment=%d",
+           file_name_.c_str(), page_num, alloc_map_.segment_num() - 1);
+  return RC::SUCCESS;
+}
+
+void DiskBufferPool::release_map_pages()
+{
+  for (int segment = 1; segment < alloc_map_.segment_num(); segment++) {
+    alloc_map_.segment_frame(segment)->unpin();
+  }
+  alloc_map_.clear();
+}
+
 int DiskBufferPool::file_desc() const { return file_desc_; }
 
+RC DiskBufferPool::read_ahead(vector<PageNum> page_nums)
+{
+  common::ThreadPoolExecutor *executor = bp_manager_.read_ahead_executor();
+  if (executor == nullptr || page_nums.empty()) {
+    return RC::SUCCESS;
+  }
+
+  {
+    lock_guard<mutex> guard(read_ahead_lock_);
+    read_ahead_pending_++;
+  }
+
+  auto finish = [this]() {
+    lock_guard<mutex> guard(read_ahead_lock_);
+    read_ahead_pending_--;
+    read_ahead_cond_.notify_all();
+  };
+
+  auto task = [this, finish, page_nums = std::move(page_nums)]() {
+    load_pages_ahead(page_nums);
+    finish();
+  };
+
+  if (executor->execute(task) != 0) {
+    LOG_WARN("failed to submit read ahead task. file=%s", file_name_.c_str());
+    finish();
+    return RC::INTERNAL;
+  }
+  return RC::SUCCESS;
+}
+
+void DiskBufferPool::load_pages_ahead(const vector<PageNum> &page_nums)
+{
+  // 预读只淘汰干净的页帧。刷脏页会访问其它的 BufferPool，不应该放在后台线程中做
+  auto purger = [](Frame *frame) { return frame->dirty() ? RC::BUFFERPOOL_NOBUF : RC::SUCCESS; };
+
+  vector<Frame *> frames;
+  {
+    scoped_lock lock_guard(lock_);
+    for (size_t i = 0; i < page_nums.size(); i++) {
+      // 提交预读任务之后页面可能已经被释放了
+      const PageNum page_num = page_nums[i];
+      if (!is_page_allocated(page_num)) {
+        continue;
+      }
+
+      // 在页帧对其它线程可见之前标记页面正在加载
+      set_page_loading(page_num, true);
+
+      Frame *frame = nullptr;
+      RC     rc    = frame_manager_.alloc_for_read_ahead(id(), page_num, frame);
+      if (rc == RC::BUFFERPOOL_NOBUF) {
+        (void)frame_manager_.purge_frames(static_cast<int>(page_nums.size() - i), purger);
+        rc = frame_manager_.alloc_for_read_ahead(id(), page_num, frame);
+      }
+      if (frame == nullptr) {
+        set_page_loading(page_num, false);
+      }
+      if (OB_FAIL(rc)) {
+        LOG_TRACE("no free frame for read ahead. file=%s, page num=%d", file_name_.c_str(), page_num);
+        break;
+      }
+      if (frame != nullptr) {
+        frames.push_back(frame);
+      }
+    }
+  }
+
+  // 页帧已经加了写锁，读页面时不需要持有 lock_
+  vector<Frame *> batch;
+  vector<Frame *> failed_frames;
+  auto            read_batch = [this, &batch, &failed_frames]() {
+    if (!batch.empty() && OB_FAIL(read_pages(batch))) {
+      for (Frame *frame : batch) {
+        if (OB_FAIL(load_page(frame->page_num(), frame))) {
+          LOG_ERROR("failed to read ahead page. file=%s, page num=%d", file_name_.c_str(), frame->page_num());
+          failed_frames.push_back(frame);
+        }
+      }
+    }
+    batch.clear();
+  };
+
+  for (Frame *frame : frames) {
+    // 双写缓冲区中的页面比磁盘上的新
+    if (OB_SUCC(dblwr_manager_.read_page(this, frame->page_num(), frame->page()))) {
+      continue;
+    }
+    if (!batch.empty() && batch.back()->page_num() + 1 != frame->page_num()) {
+      read_batch();
+    }
+    batch.push_back(frame);
+  }
+  read_batch();
+
+  int loaded_count = 0;
+  for (Frame *frame : frames) {
+    const PageNum page_num = frame->page_num();
+    frame->write_unlatch();
+    if (find(failed_frames.begin(), failed_frames.end(), frame) == failed_frames.end()) {
+      frame->access();
+      frame->unpin();
+      loaded_count++;
+    } else if (OB_FAIL(frame_manager_.try_free(id(), page_num, frame))) {
+      // 已经有其它线程拿到了这个页帧，它们正在 wait_page_loaded 中等待，会重新加载页面
+      LOG_WARN("failed to free frame after read ahead failed. file=%s, page num=%d", file_name_.c_str(), page_num);
+      frame->unpin();
+      set_page_load_failed(page_num);
+      continue;
+    }
+    set_page_loading(page_num, false);
+  }
+
+  bp_manager_.add_read_ahead_count(loaded_count);
+  LOG_TRACE("read ahead done. file=%s, request=%d, loaded=%d",
+            file_name_.c_str(), static_cast<int>(page_nums.size()), loaded_count);
+}
+
+RC DiskBufferPool::read_pages(const vector<Frame *> &frames)
+{
+  vector<struct iovec> iov(frames.size());
+  for (size_t i = 0; i < frames.size(); i++) {
+    iov[i].iov_base = &frames[i]->page();
+    iov[i].iov_len  = BP_PAGE_SIZE;
+  }
+
+  const int64_t offset   = static_cast<int64_t>(frames.front()->page_num()) * BP_PAGE_SIZE;
+  const ssize_t expected = static_cast<ssize_t>(frames.size()) * BP_PAGE_SIZE;
+  const ssize_t ret      = preadv(file_desc_, iov.data(), static_cast<int>(iov.size()), offset);
+  if (ret != expected) {
+    LOG_WARN("failed to read pages. file=%s, page num=%d, count=%d, ret=%ld, error=%s",
+             file_name_.c_str(), frames.front()->page_num(), static_cast<int>(frames.size()), ret, strerror(errno));
+    return RC::IOERR_READ;
+  }
+  return RC::SUCCESS;
+}
+
+void DiskBufferPool::wait_read_ahead()
+{
+  unique_lock<mutex> lock(read_ahead_lock_);
+  read_ahead_cond_.wait(lock, [this]() { return read_ahead_pending_ == 0; });
+}
+
+void DiskBufferPool::set_page_loading(PageNum page_num, bool loading)
+{
+  lock_guard<mutex> guard(read_ahead_lock_);
+  if (loading) {
+    loading_pages_.insert(page_num);
+  } else {
+    loading_pages_.erase(page_num);
+    read_ahead_cond_.notify_all();
+  }
+  loading_page_num_.store(static_cast<int>(loading_pages_.size() + load_failed_pages_.size()));
+}
+
+void DiskBufferPool::set_page_load_failed(PageNum page_num)
+{
+  lock_guard<mutex> guard(read_ahead_lock_);
+  loading_pages_.erase(page_num);
+  load_failed_pages_.insert(page_num);
+  loading_page_num_.store(static_cast<int>(loading_pages_.size() + load_failed_pages_.size()));
+  read_ahead_cond_.notify_all();
+}
+
+RC DiskBufferPool::wait_page_loaded(PageNum page_num, Frame *frame, bool &waited)
+{
+  waited = false;
+  if (loading_page_num_.load() == 0) {
+    return RC::SUCCESS;
+  }
+
+  unique_lock<mutex> lock(read_ahead_lock_);
+  if (loading_pages_.count(page_num) == 0 && load_failed_pages_.count(page_num) == 0) {
+    return RC::SUCCESS;
+  }
+  read_ahead_cond_.wait(lock, [this, page_num]() { return loading_pages_.count(page_num) == 0; });
+  waited = true;
+
+  if (load_failed_pages_.erase(page_num) == 0) {
+    return RC::SUCCESS;
+  }
+
+  // 预读没有读到这个页面，由当前线程重新加载。期间标记为正在加载，其它访问这个页面的线程会等待
+  loading_pages_.insert(page_num);
+  lock.unlock();
+
+  RC rc = load_page(page_num, frame);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to reload page after read ahead failed. file=%s, page num=%d, rc=%s",
+             file_name_.c_str(), page_num, strrc(rc));
+    set_page_load_failed(page_num);
+    return rc;
+  }
+
+  set_page_loading(page_num, false);
+  return RC::SUCCESS;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
-BufferPoolManager::BufferPoolManager(int memory_size /* = 0 */)
+BufferPoolManager::BufferPoolManager(int memory_size /* = 0 */, const char *eviction_policy /* = nullptr */)
 {
   if (memory_size <= 0) {
     memory_size = MEM_POOL_ITEM_NUM * DEFAULT_ITEM_NUM_PER_POOL * BP_PAGE_SIZE;
   }
   const int pool_num = max(memory_size / BP_PAGE_SIZE / DEFAULT_ITEM_NUM_PER_POOL, 1);
-  frame_manager_.init(pool_num);
-  LOG_INFO("buffer pool manager init with memory size %d, page num: %d, pool num: %d",
-           memory_size, pool_num * DEFAULT_ITEM_NUM_PER_POOL, pool_num);
+  RC rc = frame_manager_.init(pool_num, BPFrameManager::DEFAULT_PARTITION_NUM, eviction_policy);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("failed to init frame manager. eviction policy=%s, rc=%s", eviction_policy, strrc(rc));
+  }
+  LOG_INFO("buffer pool manager init with memory size %d, page num: %d, pool num: %d, eviction policy: %s",
+           memory_size, pool_num * DEFAULT_ITEM_NUM_PER_POOL, pool_num, frame_manager_.eviction_policy());
 }
 
 BufferPoolManager::~BufferPoolManager()
 {
+  page_cleaner_.stop();
+
+  if (read_ahead_executor_) {
+    read_ahead_executor_->shutdown();
+    read_ahead_executor_->await_termination();
+  }
+
   unordered_map<string, DiskBufferPool *> tmp_bps;
   tmp_bps.swap(buffer_pools_);
 
@@ -785,9 +1531,30 @@ BufferPoolManager::~BufferPoolManager()
   }
 }
 
-RC BufferPoolManager::init(unique_ptr<DoubleWriteBuffer> dblwr_buffer)
+RC BufferPoolManager::init(unique_ptr<DoubleWriteBuffer> dblwr_buffer, int clean_percent /* = 0 */)
 {
   dblwr_buffer_ = std::move(dblwr_buffer);
+
+  if (clean_percent > 0) {
+    RC rc = page_cleaner_.start(clean_percent);
+    if (OB_FAIL(rc)) {
+      LOG_ERROR("failed to start page cleaner. clean percent=%d, rc=%s", clean_percent, strrc(rc));
+      return rc;
+    }
+  }
+
+  // 预读任务比较稀疏，使用可以等待的队列，避免线程空转
+  read_ahead_executor_ = make_unique<common::ThreadPoolExecutor>();
+  int ret              = read_ahead_executor_->init("ReadAhead",
+      0,                      // core size
+      READ_AHEAD_THREAD_NUM,  // max size
+      60 * 1000,              // keep alive time
+      make_unique<common::BlockingQueue<unique_ptr<common::Runnable>>>());
+  if (0 != ret) {
+    LOG_ERROR("failed to init read ahead thread pool. ret=%d", ret);
+    read_ahead_executor_.reset();
+    return RC::INTERNAL;
+  }
   return RC::SUCCESS;
 }
 
@@ -841,7 +1608,9 @@ RC BufferPoolManager::open_file(LogHandler &log_handler, const char *_file_name,
 {
   string file_name(_file_name);
 
-  scoped_lock lock_guard(lock_);
+  // 先于 lock_ 加锁，与后台刷脏页的加锁顺序一致
+  lock_guard<mutex> cleaner_guard(page_cleaner_.lock());
+  scoped_lock       lock_guard(lock_);
   if (buffer_pools_.find(file_name) != buffer_pools_.end()) {
     LOG_WARN("file already opened. file name=%s", _file_name);
     return RC::BUFFERPOOL_OPEN;
@@ -870,12 +1639,14 @@ RC BufferPoolManager::close_file(const char *_file_name)
 {
   string file_name(_file_name);
 
+  page_cleaner_.lock().lock();
   lock_.lock();
 
   auto iter = buffer_pools_.find(file_name);
   if (iter == buffer_pools_.end()) {
     LOG_TRACE("file has not opened: %s", _file_name);
     lock_.unlock();
+    page_cleaner_.lock().unlock();
     return RC::INTERNAL;
   }
 
@@ -884,6 +1655,7 @@ RC BufferPoolManager::close_file(const char *_file_name)
   DiskBufferPool *bp = iter->second;
   buffer_pools_.erase(iter);
   lock_.unlock();
+  page_cleaner_.lock().unlock();
 
   delete bp;
   return RC::SUCCESS;
@@ -893,14 +1665,18 @@ RC BufferPoolManager::flush_page(Frame &frame)
 {
   int buffer_pool_id = frame.buffer_pool_id();
 
-  scoped_lock lock_guard(lock_);
-  auto        iter = id_to_buffer_pools_.find(buffer_pool_id);
+  lock_.lock();
+  auto iter = id_to_buffer_pools_.find(buffer_pool_id);
   if (iter == id_to_buffer_pools_.end()) {
     LOG_WARN("unknown buffer pool of id %d", buffer_pool_id);
+    lock_.unlock();
     return RC::INTERNAL;
   }
 
   DiskBufferPool *bp = iter->second;
+  lock_.unlock();
+
+  // 刷页面时 double write buffer 可能会通过 get_buffer_pool 再次加锁，所以这里先释放
   return bp->flush_page(frame);
 }
 
@@ -919,3 +1695,13 @@ RC BufferPoolManager::get_buffer_pool(int32_t id, DiskBufferPool *&bp)
   bp = iter->second;
   return RC::SUCCESS;
 }
+
+void BufferPoolManager::all_buffer_pools(vector<DiskBufferPool *> &buffer_pools)
+{
+  scoped_lock lock_guard(lock_);
+
+  buffer_pools.clear();
+  for (auto &[id, bp] : id_to_buffer_pools_) {
+    buffer_pools.push_back(bp);
+  }
+}
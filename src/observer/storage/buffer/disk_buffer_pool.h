@@ -26,14 +26,19 @@ See the Mulan PSL v2 for more details. */
 #include <optional>
 
 #include "common/lang/bitmap.h"
-#include "common/lang/lru_cache.h"
 #include "common/lang/mutex.h"
 #include "common/lang/memory.h"
 #include "common/lang/unordered_map.h"
+#include "common/lang/unordered_set.h"
+#include "common/lang/vector.h"
 #include "common/mm/mem_pool.h"
+#include "common/thread/thread_pool_executor.h"
 #include "common/rc.h"
 #include "common/types.h"
 #include "storage/buffer/frame.h"
+#include "storage/buffer/frame_replacer.h"
+#include "storage/buffer/page_allocation_map.h"
+#include "storage/buffer/page_cleaner.h"
 #include "storage/buffer/page.h"
 #include "storage/buffer/buffer_pool_log.h"
 
@@ -51,31 +56,43 @@ class BufferPoolLogHandler;
 #define BP_FILE_SUB_HDR_SIZE (sizeof(BPFileSubHeader))
 
 /**
- * @brief BufferPool的文件第一个页面，存放一些元数据信息，包括了后面每页的分配信息。
+ * @brief BufferPool的文件第一个页面，存放一些元数据信息，包括了前面一部分页面的分配信息。
  * @ingroup BufferPool
- * @details
- * @code
- * TODO 1. 当前的做法，只能分配比较少的页面，你可以扩展一下，支持更多的页面或无限多的页面吗？
- *         可以参考Linux ext(n)和Windows NTFS等文件系统
- *      2. 当前使用bitmap存放页面分配情况，但是这种方法在页面非常多的时候，查找空闲页面的
- *         效率非常低，你有办法优化吗？
- * @endcode
+ * @details 文件头中的位图只管理前 MAX_PAGE_NUM 个页面，后面的页面放在 BPAllocMapPage 管理的段中，
+ * 参考 PageAllocationMap。
  */
 struct BPFileHeader
 {
   int32_t buffer_pool_id;   //! buffer pool id
-  int32_t page_count;       //! 当前文件一共有多少个页面
+  int32_t page_count;       //! 当前文件一共有多少个页面，包括存放分配位图的页面
   int32_t allocated_pages;  //! 已经分配了多少个页面
   char    bitmap[0];        //! 页面分配位图, 第0个页面(就是当前页面)，总是1
 
   /**
-   * 能够分配的最大的页面个数，即bitmap的字节数 乘以8
+   * 文件头中的位图能够管理的页面个数，即bitmap的字节数 乘以8
    */
-  static const int MAX_PAGE_NUM = (BP_PAGE_DATA_SIZE - sizeof(page_count) - sizeof(allocated_pages)) * 8;
+  static const int MAX_PAGE_NUM =
+      (BP_PAGE_DATA_SIZE - sizeof(buffer_pool_id) - sizeof(page_count) - sizeof(allocated_pages)) * 8;
 
   string to_string() const;
 };
 
+/**
+ * @brief 存放一个段的页面分配位图的页面
+ * @ingroup BufferPool
+ * @details 文件头管理的页面之后，每 MAX_PAGE_NUM 个页面是一个段，段的第一个页面就是这个页面。
+ * 位图中第0个页面就是当前页面，总是1。这些页面在文件打开期间一直 pin 在内存中。
+ */
+struct BPAllocMapPage
+{
+  char bitmap[0];  //! 页面分配位图
+
+  /**
+   * 一个段的页面个数
+   */
+  static const int MAX_PAGE_NUM = BP_PAGE_DATA_SIZE * 8;
+};
+
 /**
  * @brief 管理页面Frame
  * @ingroup BufferPool
@@ -83,13 +100,24 @@ struct BPFileHeader
  * 当内存中的页帧不够用时，需要从内存中淘汰一些页帧，以便为新的页帧腾出空间。
  * 这个管理器负责为所有的BufferPool提供页帧管理服务，也就是所有的BufferPool磁盘文件
  * 在访问时都使用这个管理器映射到内存。
+ * 页帧按照 FrameId 的哈希值分散到多个分区中，每个分区有自己的锁和淘汰策略(FrameReplacer)，
+ * 访问不同分区的页面不会互相阻塞。页帧的内存由所有分区共享，淘汰时轮流从各个分区中挑选，
+ * 所以淘汰顺序是近似的。淘汰策略可以配置，默认是LRU，扫描比较多的场景可以使用 2Q。
  */
 class BPFrameManager
 {
 public:
+  static constexpr int DEFAULT_PARTITION_NUM = 16;
+
   BPFrameManager(const char *tag);
 
-  RC init(int pool_num);
+  /**
+   * @brief 初始化
+   * @param pool_num 页帧内存池的个数，每个内存池有 DEFAULT_ITEM_NUM_PER_POOL 个页帧
+   * @param partition_num 分区的个数
+   * @param eviction_policy 淘汰策略的名字，参考 FrameReplacer::create。nullptr 表示默认的LRU
+   */
+  RC init(int pool_num, int partition_num = DEFAULT_PARTITION_NUM, const char *eviction_policy = nullptr);
   RC cleanup();
 
   /**
@@ -118,12 +146,28 @@ public:
    */
   Frame *alloc(int buffer_pool_id, PageNum page_num);
 
+  /**
+   * @brief 为预读分配一个页帧
+   * @details 与 alloc 不同，页面已经在内存中时不返回已有的页帧，frame 为 nullptr。
+   * 新的页帧在对其它线程可见之前就加上了写锁。没有开启 CONCURRENCY 时页帧锁不起作用，
+   * 调用者还需要在分配之前把页面标记为正在加载(参考 DiskBufferPool::wait_page_loaded)。
+   * 预读的页帧不计入 miss_count。
+   * @return 没有空闲的页帧时返回 RC::BUFFERPOOL_NOBUF
+   */
+  RC alloc_for_read_ahead(int buffer_pool_id, PageNum page_num, Frame *&frame);
+
   /**
    * 尽管frame中已经包含了buffer_pool_id和page_num，但是依然要求
    * 传入，因为frame可能忘记初始化或者没有初始化
    */
   RC free(int buffer_pool_id, PageNum page_num, Frame *frame);
 
+  /**
+   * @brief 与 free 相同，但是页帧还被其它人引用着时不释放
+   * @return 页帧的引用计数不是 1 时返回 RC::LOCKED_UNLOCK
+   */
+  RC try_free(int buffer_pool_id, PageNum page_num, Frame *frame);
+
   /**
    * 如果不能从空闲链表中分配新的页面，就使用这个接口，
    * 尝试从pin count=0的页面中淘汰一些
@@ -133,17 +177,50 @@ public:
    */
   int purge_frames(int count, function<RC(Frame *frame)> purger);
 
-  size_t frame_num() const { return frames_.count(); }
+  /**
+   * @brief 找出即将被淘汰的脏页帧，给后台刷脏页使用
+   * @details 在每个分区中按照淘汰的顺序遍历页帧，没有被引用的页帧都可以被淘汰，其中的脏页帧交给 collector。
+   * 每个分区找到 clean_count 平均到每个分区的个数后停止。
+   * 交给 collector 的页帧已经被 pin 住，collector 在分区的锁内执行，这期间没有其它人能引用这个页帧。
+   * @param clean_count 希望有多少个可以直接淘汰的干净页帧
+   * @param max_count 最多收集多少个脏页帧
+   * @return 收集的脏页帧个数
+   */
+  int collect_dirty_frames(int clean_count, int max_count, const function<void(Frame *frame)> &collector);
+
+  /**
+   * @brief 找出 rec_lsn 比指定LSN小的脏页帧，给检查点使用
+   * @details 这些页帧上有很早以前的修改，不刷出去检查点就没办法往前推进。只收集没有被引用的页帧，
+   * 交给 collector 的方式与 collect_dirty_frames 相同。
+   * @param lsn 收集 rec_lsn 小于这个LSN的页帧
+   * @param max_count 最多收集多少个脏页帧
+   * @return 收集的脏页帧个数
+   */
+  int collect_old_dirty_frames(LSN lsn, int max_count, const function<void(Frame *frame)> &collector);
+
+  /**
+   * @brief 所有脏页帧中最小的 rec_lsn
+   * @return 没有需要重做的脏页帧时返回 0
+   */
+  LSN min_rec_lsn();
+
+  size_t frame_num() const;
+  size_t partition_num() const { return partitions_.size(); }
+
+  /// @brief 淘汰策略的名字
+  const char *eviction_policy() const { return partitions_.empty() ? "" : partitions_[0]->replacer->name(); }
+  /// @brief 要访问的页面已经在内存中的次数
+  uint64_t hit_count() const { return hit_count_.load(); }
+  /// @brief 要访问的页面不在内存中，需要分配页帧的次数
+  uint64_t miss_count() const { return miss_count_.load(); }
+  /// @brief 因为内存不够淘汰的页帧个数
+  uint64_t evict_count() const { return evict_count_.load(); }
 
   /**
    * 测试使用。返回已经从内存申请的个数
    */
   size_t total_frame_num() const { return allocator_.get_size(); }
 
-private:
-  Frame *get_internal(const FrameId &frame_id);
-  RC     free_internal(const FrameId &frame_id, Frame *frame);
-
 private:
   class BPFrameIdHasher
   {
@@ -151,32 +228,68 @@ private:
     size_t operator()(const FrameId &frame_id) const { return frame_id.hash(); }
   };
 
-  using FrameLruCache  = common::LruCache<FrameId, Frame *, BPFrameIdHasher>;
   using FrameAllocator = common::MemPoolSimple<Frame>;
 
-  mutex          lock_;
-  FrameLruCache  frames_;
-  FrameAllocator allocator_;
+  /**
+   * @brief 一个分区，管理一部分页帧
+   */
+  struct Partition
+  {
+    mutex                                            lock;
+    unordered_map<FrameId, Frame *, BPFrameIdHasher> frames;
+    unique_ptr<FrameReplacer>                        replacer;
+  };
+
+  Partition &partition(const FrameId &frame_id);
+
+  Frame *get_internal(Partition &partition, const FrameId &frame_id);
+  RC     free_internal(Partition &partition, const FrameId &frame_id, Frame *frame, bool evicted);
+  int    purge_frames(Partition &partition, int count, const function<RC(Frame *frame)> &purger);
+
+private:
+  vector<unique_ptr<Partition>> partitions_;
+  atomic<size_t>                purge_cursor_{0};  ///< 下次淘汰时从哪个分区开始找
+  FrameAllocator                allocator_;
+
+  atomic<uint64_t> hit_count_{0};
+  atomic<uint64_t> miss_count_{0};
+  atomic<uint64_t> evict_count_{0};
 };
 
 /**
  * @brief 用于遍历BufferPool中的所有页面
  * @ingroup BufferPool
+ * @details 遍历的页面是按照页号顺序访问的。连续访问了 READ_AHEAD_TRIGGER 个页面之后，认为是在做顺序扫描，
+ * 开始预读后面的 READ_AHEAD_PAGE_NUM 个页面(DiskBufferPool::read_ahead)。已经预读的页面访问过一半时，
+ * 再预读下一批，这样后台线程加载页面与调用者处理页面可以同时进行。
  */
 class BufferPoolIterator
 {
 public:
+  static constexpr int READ_AHEAD_TRIGGER  = 4;   ///< 连续访问多少个页面后开始预读
+  static constexpr int READ_AHEAD_PAGE_NUM = 32;  ///< 每次预读多少个页面
+
   BufferPoolIterator();
   ~BufferPoolIterator();
 
-  RC      init(DiskBufferPool &bp, PageNum start_page = 0);
+  /**
+   * @param start_page 从哪个页面开始遍历，包含在内
+   * @param end_page 遍历到哪个页面为止，不包含在内。小于0时遍历到文件末尾
+   */
+  RC      init(DiskBufferPool &bp, PageNum start_page = 0, PageNum end_page = -1);
   bool    has_next();
   PageNum next();
   RC      reset();
 
 private:
-  common::Bitmap bitmap_;
-  PageNum        current_page_num_ = -1;
+  void read_ahead(PageNum page_num);
+
+private:
+  DiskBufferPool *buffer_pool_ = nullptr;
+  int             page_count_          = 0;   ///< 开始遍历时文件中的页面个数
+  PageNum         current_page_num_    = -1;
+  int             sequential_count_    = 0;   ///< 已经连续访问的页面个数
+  PageNum         read_ahead_page_num_ = -1;  ///< 已经发起预读的最大页号
 };
 
 /**
@@ -187,6 +300,9 @@ private:
  */
 class DiskBufferPool final
 {
+public:
+  static constexpr int DISPOSE_YIELD_TIMES = 16;  ///< 释放页面时最多让出几次CPU等其它线程unpin页面
+
 public:
   DiskBufferPool(BufferPoolManager &bp_manager, BPFrameManager &frame_manager, DoubleWriteBuffer &dblwr_manager,
       LogHandler &log_handler);
@@ -216,7 +332,8 @@ public:
 
   /**
    * @brief 释放某个页面，将此页面设置为未分配状态
-   *
+   * @details 页面还被其它线程pin着时让出几次CPU等它们unpin。仍然没有unpin的页面放到延迟释放列表中，
+   * 之后分配、释放页面或者关闭文件时再尝试释放，在这之前页面保持分配状态
    * @param page_num 待释放的页面
    */
   RC dispose_page(PageNum page_num);
@@ -255,6 +372,13 @@ public:
    */
   RC flush_all_pages();
 
+  /**
+   * @brief 把 rec_lsn 比指定LSN小的文件头和位图页面刷新到double write buffer
+   * @details 这些页面一直是 pin 住的，后台刷脏页不会处理它们，检查点使用这个接口把它们刷出去
+   * @param count 刷出的页面个数
+   */
+  RC flush_old_map_pages(LSN lsn, int &count);
+
   /**
    * 回放日志时处理page0中已被认定为不存在的page
    */
@@ -265,12 +389,47 @@ public:
    */
   RC write_page(PageNum page_num, Page &page);
 
+  /**
+   * @brief 使用一次 pwritev 把页号连续的多个页面写到磁盘
+   * @param first_page_num 第一个页面的页号，后面的页面页号依次加一
+   */
+  RC write_pages(PageNum first_page_num, const vector<Page *> &pages);
+
+  /**
+   * @brief 把已经写到文件中的页面落盘
+   */
+  RC sync_file();
+
+  /**
+   * @brief 把页号连续的页面副本刷新到double write buffer
+   * @details 后台刷脏页(PageCleaner)使用，页面是在页帧没有被引用时复制出来的，这里不访问页帧
+   */
+  RC flush_page_copies(PageNum first_page_num, const vector<Page *> &pages);
+
   RC redo_allocate_page(LSN lsn, PageNum page_num);
   RC redo_deallocate_page(LSN lsn, PageNum page_num);
 
+  /**
+   * @brief 页面是否已经分配。存放分配位图的页面不算
+   */
+  bool is_page_allocated(PageNum page_num) const;
+
+  /**
+   * @brief 异步地把指定的页面读到缓冲区
+   * @details 顺序扫描时由 BufferPoolIterator 调用，页面在 BufferPoolManager 的预读线程池中加载。
+   * 已经在内存中的页面会跳过，页号连续的页面使用一次 preadv 读取。
+   * 没有空闲页帧时会淘汰一些页帧，所有页帧都在使用时放弃剩下的页面。
+   * BufferPoolManager 没有初始化预读线程池时什么都不做。
+   * @param page_nums 按照页号从小到大排列的页面
+   */
+  RC read_ahead(vector<PageNum> page_nums);
+
 public:
   int32_t id() const { return buffer_pool_id_; }
 
+  /// @brief 文件中的页面个数，包括存放分配位图的页面
+  int page_count() const { return file_header_->page_count; }
+
   const char *filename() const { return file_name_.c_str(); }
 
 protected:
@@ -287,11 +446,85 @@ protected:
    */
   RC load_page(PageNum page_num, Frame *frame);
 
+  /**
+   * @brief 把段的分配位图页面加载到内存中，并一直 pin 住
+   * @param create 是否是新的页面，新的页面不从磁盘读取，只设置自己已经分配
+   * @param lsn 新页面的LSN
+   */
+  RC load_map_page(PageNum page_num, bool create, LSN lsn = 0);
+
+  /**
+   * @brief 回放日志时加载页面所在的段，磁盘上还没有的段按照新的页面处理
+   */
+  RC load_map_page_for_redo(PageNum page_num, LSN lsn);
+
+  /**
+   * @brief 文件增长到一个新的段时，分配这个段的位图页面
+   */
+  RC allocate_map_page();
+
+  /**
+   * @brief 释放所有段的分配位图页面，不包括文件头
+   */
+  void release_map_pages();
+
   /**
    * 如果页面是脏的，就将数据刷新到磁盘
    */
   RC flush_page_internal(Frame &frame);
 
+  /**
+   * @brief 淘汰页帧之前把脏页刷出去，给 BPFrameManager::purge_frames 使用
+   */
+  RC flush_frame_for_purge(Frame *frame);
+
+  /**
+   * @brief 在预读线程中加载页面
+   */
+  void load_pages_ahead(const vector<PageNum> &page_nums);
+
+  /**
+   * @brief 使用一次 preadv 读取页号连续的多个页面
+   */
+  RC read_pages(const vector<Frame *> &frames);
+
+  /**
+   * @brief 等待所有还没有完成的预读任务
+   */
+  void wait_read_ahead();
+
+  /**
+   * @brief 页面正在被预读线程加载时，等待加载完成
+   * @details 页面在预读线程分配页帧之前就标记为正在加载，所以从 BPFrameManager 中拿到的页帧如果还没有加载完，
+   * 这里一定可以看到。这个检查不依赖页帧锁，没有开启 CONCURRENCY 时也能保证不会读到加载了一半的页面。
+   * 预读失败但是页帧已经被其它线程pin住时，页面会标记为加载失败，这里会重新把页面读到 frame 中，
+   * 重新加载期间页面仍然标记为正在加载，其它线程会等待
+   * @param page_num 访问的页面
+   * @param frame    调用者pin住的这个页面的页帧
+   * @param[out] waited 是否等待了预读线程
+   */
+  RC   wait_page_loaded(PageNum page_num, Frame *frame, bool &waited);
+  void set_page_loading(PageNum page_num, bool loading);
+  void set_page_load_failed(PageNum page_num);
+
+  /**
+   * @brief 释放页面在内存中的页帧
+   * @details 不能持有缓冲池的锁，页面可能正在被后台刷脏页的线程复制
+   * @param yield_times 页帧还被其它线程pin着时最多让出几次CPU
+   * @return 页面不在内存中或者已经释放了页帧时返回true
+   */
+  bool free_frame_for_dispose(PageNum page_num, int yield_times);
+
+  /**
+   * @brief 在分配位图中释放页面并记录日志，页面已经没有页帧了
+   */
+  void deallocate_page(PageNum page_num);
+
+  /**
+   * @brief 重新尝试释放延迟释放列表中的页面
+   */
+  void dispose_deferred_pages();
+
 private:
   BufferPoolManager   &bp_manager_;     /// BufferPool 管理器
   BPFrameManager      &frame_manager_;  /// Frame 管理器
@@ -305,10 +538,23 @@ private:
   BPFileHeader *file_header_    = nullptr;  /// 文件头
   set<PageNum>  disposed_pages_;            /// 已经释放的页面
 
+  /// 页面分配位图，包括文件头和后面每个段的位图页面
+  PageAllocationMap alloc_map_{BPFileHeader::MAX_PAGE_NUM, BPAllocMapPage::MAX_PAGE_NUM};
+
   string file_name_;  /// 文件名
 
   common::Mutex lock_;
-  common::Mutex wr_lock_;
+  mutex         wr_lock_;  ///< 预读和刷脏页的线程也会读写文件，lseek 与读写要一起完成，不能使用 common::Mutex
+
+  mutex                  read_ahead_lock_;
+  condition_variable     read_ahead_cond_;
+  int                    read_ahead_pending_ = 0;  ///< 已经提交还没有完成的预读任务个数
+  unordered_set<PageNum> loading_pages_;           ///< 预读线程正在加载的页面
+  unordered_set<PageNum> load_failed_pages_;       ///< 预读失败、页帧没能释放的页面，下次访问时重新加载
+
+  mutex           deferred_lock_;
+  vector<PageNum> deferred_pages_;  ///< 释放时还被其它线程pin着的页面，之后再尝试释放
+  atomic<int>            loading_page_num_{0};     ///< 上面两个集合的大小之和，没有预读时访问页面不需要加锁
 
 private:
   friend class BufferPoolIterator;
@@ -321,10 +567,19 @@ private:
 class BufferPoolManager final
 {
 public:
-  BufferPoolManager(int memory_size = 0);
+  static constexpr int READ_AHEAD_THREAD_NUM = 2;  ///< 预读线程池的最大线程个数
+
+  /**
+   * @param memory_size 缓冲池使用的内存大小，0 表示使用默认值
+   * @param eviction_policy 页帧淘汰策略的名字，参考 FrameReplacer::create
+   */
+  BufferPoolManager(int memory_size = 0, const char *eviction_policy = nullptr);
   ~BufferPoolManager();
 
-  RC init(unique_ptr<DoubleWriteBuffer> dblwr_buffer);
+  /**
+   * @param clean_percent 大于 0 时启动后台刷脏页的线程，参考 PageCleaner
+   */
+  RC init(unique_ptr<DoubleWriteBuffer> dblwr_buffer, int clean_percent = 0);
 
   RC create_file(const char *file_name);
   RC open_file(LogHandler &log_handler, const char *file_name, DiskBufferPool *&bp);
@@ -334,6 +589,14 @@ public:
 
   BPFrameManager    &get_frame_manager() { return frame_manager_; }
   DoubleWriteBuffer *get_dblwr_buffer() { return dblwr_buffer_.get(); }
+  PageCleaner       &page_cleaner() { return page_cleaner_; }
+
+  /// @brief 预读使用的线程池。没有调用 init 时返回 nullptr，不做预读
+  common::ThreadPoolExecutor *read_ahead_executor() { return read_ahead_executor_.get(); }
+
+  /// @brief 记录预读加载的页面个数
+  void     add_read_ahead_count(uint64_t count) { read_ahead_count_ += count; }
+  uint64_t read_ahead_count() const { return read_ahead_count_.load(); }
 
   /**
    * @brief 根据ID获取对应的BufferPool对象
@@ -343,11 +606,22 @@ public:
    */
   RC get_buffer_pool(int32_t id, DiskBufferPool *&bp);
 
+  /**
+   * @brief 列出所有打开的BufferPool对象
+   * @details 调用者需要持有 page_cleaner().lock()，防止使用期间有文件被关闭
+   */
+  void all_buffer_pools(vector<DiskBufferPool *> &buffer_pools);
+
 private:
   BPFrameManager frame_manager_{"BufPool"};
 
   unique_ptr<DoubleWriteBuffer> dblwr_buffer_;
 
+  PageCleaner page_cleaner_{*this, frame_manager_};  ///< 后台刷脏页
+
+  unique_ptr<common::ThreadPoolExecutor> read_ahead_executor_;  ///< 预读线程池
+  atomic<uint64_t>                       read_ahead_count_{0};
+
   common::Mutex                            lock_;
   unordered_map<string, DiskBufferPool *>  buffer_pools_;
   unordered_map<int32_t, DiskBufferPool *> id_to_buffer_pools_;
@@ -45,6 +45,17 @@ DoubleWritePage::DoubleWritePage(int32_t buffer_pool_id, PageNum page_num, int32
 
 const int32_t DoubleWritePage::SIZE = sizeof(DoubleWritePage);
 
+RC DoubleWriteBuffer::add_pages(DiskBufferPool *bp, PageNum first_page_num, const vector<Page *> &pages)
+{
+  for (size_t i = 0; i < pages.size(); i++) {
+    RC rc = add_page(bp, first_page_num + static_cast<PageNum>(i), *pages[i]);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
+
 const int32_t DoubleWriteBufferHeader::SIZE = sizeof(DoubleWriteBufferHeader);
 
 DiskDoubleWriteBuffer::DiskDoubleWriteBuffer(BufferPoolManager &bp_manager, int max_pages /*=16*/)
@@ -75,16 +86,72 @@ RC DiskDoubleWriteBuffer::open_file(const char *filename)
 }
 
 RC DiskDoubleWriteBuffer::flush_page()
+{
+  scoped_lock lock_guard(lock_);
+  return flush_page_internal();
+}
+
+RC DiskDoubleWriteBuffer::flush_page_internal()
 {
   sync();
 
+  vector<DoubleWritePage *> pages;
+  pages.reserve(dblwr_pages_.size());
   for (const auto &pair : dblwr_pages_) {
-    RC rc = write_page(pair.second);
+    // skip invalid page
+    if (pair.second->valid) {
+      pages.push_back(pair.second);
+    }
+  }
+
+  sort(pages.begin(), pages.end(), [](DoubleWritePage *a, DoubleWritePage *b) {
+    return a->key.buffer_pool_id < b->key.buffer_pool_id ||
+           (a->key.buffer_pool_id == b->key.buffer_pool_id && a->key.page_num < b->key.page_num);
+  });
+
+  // 同一个文件中页号连续的页面一起写
+  vector<DiskBufferPool *> written_buffer_pools;
+  for (size_t begin = 0, end = 1; begin < pages.size(); begin = end++) {
+    const DoubleWritePageKey &first = pages[begin]->key;
+    while (end < pages.size() && pages[end]->key.buffer_pool_id == first.buffer_pool_id &&
+           pages[end]->key.page_num == pages[end - 1]->key.page_num + 1) {
+      end++;
+    }
+
+    DiskBufferPool *disk_buffer = nullptr;
+    RC              rc          = bp_manager_.get_buffer_pool(first.buffer_pool_id, disk_buffer);
+    ASSERT(OB_SUCC(rc) && disk_buffer != nullptr, "failed to get disk buffer pool of %d", first.buffer_pool_id);
+
+    vector<Page *> run;
+    run.reserve(end - begin);
+    for (size_t i = begin; i < end; i++) {
+      run.push_back(&pages[i]->page);
+    }
+
+    LOG_TRACE("double write buffer write pages. buffer_pool_id:%d,page_num:%d,count=%d",
+              first.buffer_pool_id, first.page_num, static_cast<int>(run.size()));
+    rc = disk_buffer->write_pages(first.page_num, run);
     if (rc != RC::SUCCESS) {
       return rc;
     }
-    pair.second->valid = false;
-    write_page_internal(pair.second);
+    if (written_buffer_pools.empty() || written_buffer_pools.back() != disk_buffer) {
+      written_buffer_pools.push_back(disk_buffer);
+    }
+  }
+
+  // 数据文件落盘之前，double write buffer 中的页面不能作废，否则宕机时两边都找不回这些页面
+  for (DiskBufferPool *disk_buffer : written_buffer_pools) {
+    RC rc = disk_buffer->sync_file();
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+
+  for (const auto &pair : dblwr_pages_) {
+    if (pair.second->valid) {
+      pair.second->valid = false;
+      write_page_internal(pair.second);
+    }
     delete pair.second;
   }
 
@@ -96,7 +163,46 @@ RC DiskDoubleWriteBuffer::flush_page()
 
 RC DiskDoubleWriteBuffer::add_page(DiskBufferPool *bp, PageNum page_num, Page &page)
 {
-  scoped_lock        lock_guard(lock_);
+  scoped_lock lock_guard(lock_);
+
+  RC rc = add_page_internal(bp, page_num, page);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  if (static_cast<int>(dblwr_pages_.size()) >= max_pages_) {
+    rc = flush_page_internal();
+    if (rc != RC::SUCCESS) {
+      LOG_ERROR("Failed to flush pages in double write buffer");
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC DiskDoubleWriteBuffer::add_pages(DiskBufferPool *bp, PageNum first_page_num, const vector<Page *> &pages)
+{
+  scoped_lock lock_guard(lock_);
+
+  for (size_t i = 0; i < pages.size(); i++) {
+    RC rc = add_page_internal(bp, first_page_num + static_cast<PageNum>(i), *pages[i]);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+
+  if (static_cast<int>(dblwr_pages_.size()) >= max_pages_) {
+    RC rc = flush_page_internal();
+    if (rc != RC::SUCCESS) {
+      LOG_ERROR("Failed to flush pages in double write buffer");
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC DiskDoubleWriteBuffer::add_page_internal(DiskBufferPool *bp, PageNum page_num, Page &page)
+{
   DoubleWritePageKey key{bp->id(), page_num};
   auto               iter = dblwr_pages_.find(key);
   if (iter != dblwr_pages_.end()) {
@@ -132,14 +238,6 @@ RC DiskDoubleWriteBuffer::add_page(DiskBufferPool *bp, PageNum page_num, Page &p
     }
   }
 
-  if (static_cast<int>(dblwr_pages_.size()) >= max_pages_) {
-    RC rc = flush_page();
-    if (rc != RC::SUCCESS) {
-      LOG_ERROR("Failed to flush pages in double write buffer");
-      return rc;
-    }
-  }
-
   return RC::SUCCESS;
 }
 
@@ -160,24 +258,6 @@ RC DiskDoubleWriteBuffer::write_page_internal(DoubleWritePage *page)
   return RC::SUCCESS;
 }
 
-RC DiskDoubleWriteBuffer::write_page(DoubleWritePage *dblwr_page)
-{
-  DiskBufferPool *disk_buffer = nullptr;
-  // skip invalid page
-  if (!dblwr_page->valid) {
-    LOG_TRACE("double write buffer write page invalid. buffer_pool_id:%d,page_num:%d,lsn=%d",
-              dblwr_page->key.buffer_pool_id, dblwr_page->key.page_num, dblwr_page->page.lsn);
-    return RC::SUCCESS;
-  }
-  RC rc = bp_manager_.get_buffer_pool(dblwr_page->key.buffer_pool_id, disk_buffer);
-  ASSERT(OB_SUCC(rc) && disk_buffer != nullptr, "failed to get disk buffer pool of %d", dblwr_page->key.buffer_pool_id);
-
-  LOG_TRACE("double write buffer write page. buffer_pool_id:%d,page_num:%d,lsn=%d",
-            dblwr_page->key.buffer_pool_id, dblwr_page->key.page_num, dblwr_page->page.lsn);
-
-  return disk_buffer->write_page(dblwr_page->key.page_num, dblwr_page->page);
-}
-
 RC DiskDoubleWriteBuffer::read_page(DiskBufferPool *bp, PageNum page_num, Page &page)
 {
   scoped_lock        lock_guard(lock_);
@@ -297,3 +377,8 @@ RC VacuousDoubleWriteBuffer::add_page(DiskBufferPool *bp, PageNum page_num, Page
 {
   return bp->write_page(page_num, page);
 }
+
+RC VacuousDoubleWriteBuffer::add_pages(DiskBufferPool *bp, PageNum first_page_num, const vector<Page *> &pages)
+{
+  return bp->write_pages(first_page_num, pages);
+}
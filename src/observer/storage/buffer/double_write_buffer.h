@@ -16,6 +16,7 @@ See the Mulan PSL v2 for more details. */
 
 #include "common/lang/mutex.h"
 #include "common/lang/unordered_map.h"
+#include "common/lang/vector.h"
 #include "common/types.h"
 #include "common/rc.h"
 #include "storage/buffer/page.h"
@@ -35,6 +36,13 @@ public:
    */
   virtual RC add_page(DiskBufferPool *bp, PageNum page_num, Page &page) = 0;
 
+  /**
+   * @brief 一次加入多个页号连续的页面
+   * @details 后台刷脏页时使用，写回数据文件时可以合并成一次写
+   * @param first_page_num 第一个页面的页号，后面的页面页号依次加一
+   */
+  virtual RC add_pages(DiskBufferPool *bp, PageNum first_page_num, const vector<Page *> &pages);
+
   virtual RC read_page(DiskBufferPool *bp, PageNum page_num, Page &page) = 0;
 
   /**
@@ -110,6 +118,8 @@ public:
    */
   RC add_page(DiskBufferPool *bp, PageNum page_num, Page &page) override;
 
+  RC add_pages(DiskBufferPool *bp, PageNum first_page_num, const vector<Page *> &pages) override;
+
   RC read_page(DiskBufferPool *bp, PageNum page_num, Page &page) override;
 
   /**
@@ -124,9 +134,15 @@ public:
 
 private:
   /**
-   * 将buffer中的页面写入对应的磁盘
+   * @brief 不加锁的 add_page，不会在 buffer 装满时刷盘
    */
-  RC write_page(DoubleWritePage *page);
+  RC add_page_internal(DiskBufferPool *bp, PageNum page_num, Page &page);
+
+  /**
+   * @brief 不加锁的 flush_page
+   * @details 同一个文件中页号连续的页面合并成一次写(DiskBufferPool::write_pages)
+   */
+  RC flush_page_internal();
 
   /**
    * 将页面写到当前double write buffer文件中
@@ -143,7 +159,7 @@ private:
 private:
   int                     file_desc_ = -1;
   int                     max_pages_ = 0;
-  common::Mutex           lock_;
+  mutex                   lock_;  ///< 后台刷脏页的线程也会访问，不能使用 CONCURRENCY 关闭时什么都不做的 common::Mutex
   BufferPoolManager      &bp_manager_;
   DoubleWriteBufferHeader header_;
 
@@ -160,6 +176,8 @@ public:
    */
   RC add_page(DiskBufferPool *bp, PageNum page_num, Page &page) override;
 
+  RC add_pages(DiskBufferPool *bp, PageNum first_page_num, const vector<Page *> &pages) override;
+
   RC read_page(DiskBufferPool *bp, PageNum page_num, Page &page) override { return RC::BUFFERPOOL_INVALID_PAGE_NUM; }
 
   /**
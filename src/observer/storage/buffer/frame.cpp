@@ -75,6 +75,9 @@ void Frame::write_latch(intptr_t xid)
   }
 
   lock_.lock();
+  if (version_latch_count_++ == 0) {
+    version_.fetch_add(1, std::memory_order_acq_rel);
+  }
 
 #ifdef DEBUG
   write_locker_ = xid;
@@ -120,9 +123,25 @@ void Frame::write_unlatch(intptr_t xid)
   }
   debug_lock_.unlock();
 
+  if (--version_latch_count_ == 0) {
+    version_.fetch_add(1, std::memory_order_release);
+  }
   lock_.unlock();
 }
 
+bool Frame::read_version(uint64_t &version) const
+{
+  version = version_.load(std::memory_order_acquire);
+  return (version & 1) == 0;
+}
+
+bool Frame::validate_version(uint64_t version) const
+{
+  // 保证前面读页面的操作不会被重排到读版本号之后
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return version_.load(std::memory_order_relaxed) == version;
+}
+
 void Frame::read_latch() { read_latch(get_default_debug_xid()); }
 
 void Frame::read_latch(intptr_t xid)
@@ -75,7 +75,7 @@ public:
    * @details 在 MemPoolSimple 分配和释放一个Frame对象时，不会调用构造函数和析构函数，
    * 而是调用reinit和reset。
    */
-  void reinit() {}
+  void reinit() { rec_lsn_.store(0); }
   void reset() {}
 
   void clear_page() { memset(&page_, 0, sizeof(page_)); }
@@ -104,7 +104,20 @@ public:
    * 序列号要小，那就可以从日志中读取这些更大序列号的日志，做重做操作，将页面恢复到最新状态，也就是redo。
    */
   LSN  lsn() const { return page_.lsn; }
-  void set_lsn(LSN lsn) { page_.lsn = lsn; }
+  void set_lsn(LSN lsn)
+  {
+    page_.lsn = lsn;
+    if (rec_lsn_.load() == 0) {
+      rec_lsn_.store(lsn);
+    }
+  }
+
+  /**
+   * @brief 页面上第一条还没有刷到磁盘的修改对应的日志序列号(recovery LSN)
+   * @details 页面刷出之后第一次 set_lsn 时记录，页面刷出时清零。恢复时只需要从所有脏页中最小的
+   * rec_lsn 开始重做，检查点使用它来决定哪些日志不再需要。0 表示页面上没有需要重做的修改。
+   */
+  LSN rec_lsn() const { return rec_lsn_.load(); }
 
   /**
    * @brief 页面校验和
@@ -132,9 +145,26 @@ public:
    * @brief 重置“脏”标记
    * @details 如果页面已经被写入磁盘文件，则应调用此函数。
    */
-  void clear_dirty() { dirty_ = false; }
+  void clear_dirty()
+  {
+    dirty_ = false;
+    rec_lsn_.store(0);
+  }
   bool dirty() const { return dirty_; }
 
+  /**
+   * @brief 页面没有刷成功，恢复脏标记
+   * @details 刷页面之前已经调用过 clear_dirty，这期间页面可能又被修改过，rec_lsn 取两者中较小的一个
+   * @param rec_lsn 调用 clear_dirty 之前的 rec_lsn
+   */
+  void restore_dirty(LSN rec_lsn)
+  {
+    dirty_      = true;
+    LSN current = rec_lsn_.load();
+    while (rec_lsn != 0 && (current == 0 || current > rec_lsn) && !rec_lsn_.compare_exchange_weak(current, rec_lsn)) {
+    }
+  }
+
   char *data() { return page_.data; }
 
   bool can_purge() { return pin_count_.load() == 0; }
@@ -166,12 +196,27 @@ public:
   void read_unlatch();
   void read_unlatch(intptr_t xid);
 
+  /**
+   * @brief 乐观读开始时获取页面的版本号
+   * @details 每次加写锁和释放写锁时版本号都会加1，版本号是奇数说明有人正在修改页面。
+   * 乐观读不加锁，读完之后使用 validate_version 校验版本号，没有变化就说明读到的数据是一致的。
+   * 乐观读期间需要一直pin着页面，防止页帧被淘汰后换成了其它页面
+   * @return 页面正在被修改时返回false
+   */
+  bool read_version(uint64_t &version) const;
+
+  /**
+   * @brief 校验乐观读期间页面有没有被修改过
+   */
+  bool validate_version(uint64_t version) const;
+
   string to_string() const;
 
 private:
   friend class BufferPool;
 
   bool          dirty_ = false;
+  atomic<LSN>   rec_lsn_{0};
   atomic<int>   pin_count_{0};
   unsigned long acc_time_ = 0;
   FrameId       frame_id_;
@@ -180,6 +225,10 @@ private:
   /// 在非并发编译时，加锁解锁动作将什么都不做
   common::RecursiveSharedMutex lock_;
 
+  /// 乐观读使用的版本号。写锁可以重入，只有最外层的加锁和解锁才会修改版本号
+  atomic<uint64_t> version_{0};
+  int              version_latch_count_ = 0;
+
   /// 使用一些手段来做测试，提前检测出头疼的死锁问题
   /// 如果编译时没有增加调试选项，这些代码什么都不做
   common::DebugMutex           debug_lock_;
@@ -0,0 +1,143 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#include "storage/buffer/frame_replacer.h"
+
+#include <strings.h>
+
+#include "common/lang/algorithm.h"
+
+unique_ptr<FrameReplacer> FrameReplacer::create(const char *name, size_t capacity)
+{
+  if (nullptr == name || 0 == strcasecmp(name, LruFrameReplacer::NAME)) {
+    return make_unique<LruFrameReplacer>();
+  }
+  if (0 == strcasecmp(name, TwoQueueFrameReplacer::NAME)) {
+    return make_unique<TwoQueueFrameReplacer>(capacity);
+  }
+  return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LruFrameReplacer::insert(Frame *frame)
+{
+  frames_.push_front(frame);
+  positions_[frame] = frames_.begin();
+}
+
+void LruFrameReplacer::access(Frame *frame)
+{
+  auto iter = positions_.find(frame);
+  if (iter != positions_.end()) {
+    frames_.splice(frames_.begin(), frames_, iter->second);
+  }
+}
+
+void LruFrameReplacer::remove(Frame *frame, bool /*evicted*/)
+{
+  auto iter = positions_.find(frame);
+  if (iter != positions_.end()) {
+    frames_.erase(iter->second);
+    positions_.erase(iter);
+  }
+}
+
+void LruFrameReplacer::foreach_victim(const function<bool(Frame *)> &visitor)
+{
+  for (auto iter = frames_.rbegin(); iter != frames_.rend(); ++iter) {
+    if (!visitor(*iter)) {
+      break;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TwoQueueFrameReplacer::TwoQueueFrameReplacer(size_t capacity)
+    : kin_(max(capacity / 4, static_cast<size_t>(1))), kout_(max(capacity / 2, static_cast<size_t>(1)))
+{}
+
+void TwoQueueFrameReplacer::insert(Frame *frame)
+{
+  auto ghost = a1out_positions_.find(frame->frame_id());
+  if (ghost != a1out_positions_.end()) {
+    a1out_.erase(ghost->second);
+    a1out_positions_.erase(ghost);
+
+    am_.push_front(frame);
+    positions_[frame] = Position{true, am_.begin()};
+  } else {
+    a1in_.push_back(frame);
+    positions_[frame] = Position{false, prev(a1in_.end())};
+  }
+}
+
+void TwoQueueFrameReplacer::access(Frame *frame)
+{
+  // 在 A1in 中的访问认为是同一次使用，不调整位置
+  auto iter = positions_.find(frame);
+  if (iter != positions_.end() && iter->second.in_am) {
+    am_.splice(am_.begin(), am_, iter->second.iter);
+  }
+}
+
+void TwoQueueFrameReplacer::remove(Frame *frame, bool evicted)
+{
+  auto iter = positions_.find(frame);
+  if (iter == positions_.end()) {
+    return;
+  }
+
+  if (iter->second.in_am) {
+    am_.erase(iter->second.iter);
+  } else {
+    a1in_.erase(iter->second.iter);
+
+    if (evicted && a1out_positions_.find(frame->frame_id()) == a1out_positions_.end()) {
+      a1out_.push_back(frame->frame_id());
+      a1out_positions_[frame->frame_id()] = prev(a1out_.end());
+      if (a1out_.size() > kout_) {
+        a1out_positions_.erase(a1out_.front());
+        a1out_.pop_front();
+      }
+    }
+  }
+  positions_.erase(iter);
+}
+
+void TwoQueueFrameReplacer::foreach_victim(const function<bool(Frame *)> &visitor)
+{
+  auto visit_a1in = [this, &visitor]() {
+    for (Frame *frame : a1in_) {
+      if (!visitor(frame)) {
+        return false;
+      }
+    }
+    return true;
+  };
+  auto visit_am = [this, &visitor]() {
+    for (auto iter = am_.rbegin(); iter != am_.rend(); ++iter) {
+      if (!visitor(*iter)) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  // 两个队列都要遍历，因为排在前面的页帧可能都被引用着，不能淘汰
+  if (a1in_.size() > kin_ || am_.empty()) {
+    (void)(visit_a1in() && visit_am());
+  } else {
+    (void)(visit_am() && visit_a1in());
+  }
+}
@@ -0,0 +1,136 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#pragma once
+
+#include "common/lang/functional.h"
+#include "common/lang/list.h"
+#include "common/lang/memory.h"
+#include "common/lang/unordered_map.h"
+#include "storage/buffer/frame.h"
+
+/**
+ * @brief 页帧淘汰策略
+ * @ingroup BufferPool
+ * @details 记录页帧的访问情况，决定内存不够时先淘汰哪些页帧。
+ * 每个 BPFrameManager 的分区有一个自己的淘汰策略对象，调用者负责加锁，所以实现不需要考虑并发。
+ */
+class FrameReplacer
+{
+public:
+  virtual ~FrameReplacer() = default;
+
+  virtual const char *name() const = 0;
+
+  /// @brief 新的页帧加入内存
+  virtual void insert(Frame *frame) = 0;
+
+  /// @brief 访问已经在内存中的页帧
+  virtual void access(Frame *frame) = 0;
+
+  /**
+   * @brief 页帧离开内存
+   * @param evicted 是否因为内存不够被淘汰。页面被删除时不是淘汰
+   */
+  virtual void remove(Frame *frame, bool evicted) = 0;
+
+  /**
+   * @brief 按照淘汰的优先顺序遍历页帧
+   * @param visitor 返回 false 时停止遍历。遍历过程中不能修改淘汰策略中的数据
+   */
+  virtual void foreach_victim(const function<bool(Frame *)> &visitor) = 0;
+
+  /**
+   * @brief 根据名字创建淘汰策略
+   * @param name 策略的名字，当前支持 lru 和 2q，不区分大小写
+   * @param capacity 预计最多管理多少个页帧
+   * @return 不认识的名字返回 nullptr
+   */
+  static unique_ptr<FrameReplacer> create(const char *name, size_t capacity);
+};
+
+/**
+ * @brief 最近最少使用(LRU)
+ * @ingroup BufferPool
+ */
+class LruFrameReplacer : public FrameReplacer
+{
+public:
+  static constexpr const char *NAME = "lru";
+
+  const char *name() const override { return NAME; }
+
+  void insert(Frame *frame) override;
+  void access(Frame *frame) override;
+  void remove(Frame *frame, bool evicted) override;
+  void foreach_victim(const function<bool(Frame *)> &visitor) override;
+
+private:
+  list<Frame *>                                   frames_;  ///< 头部是最近访问的
+  unordered_map<Frame *, list<Frame *>::iterator> positions_;
+};
+
+/**
+ * @brief 2Q 淘汰策略，可以抵抗全表扫描对缓存的冲刷
+ * @ingroup BufferPool
+ * @details 参考 Johnson & Shasha, 2Q: A Low Overhead High Performance Buffer Management Replacement Algorithm.
+ * 第一次进入内存的页帧放在先进先出的 A1in 队列中，在 A1in 中再次访问不会改变它的位置。
+ * 从 A1in 淘汰的页面只在 A1out 中记录页面编号，不占用页帧。如果页面在 A1out 中时又被读进来，
+ * 说明它会被反复访问，放到按照 LRU 管理的 Am 队列中。
+ * 淘汰时 A1in 超过 kin 个页帧就先淘汰 A1in 中的，否则淘汰 Am 中的。
+ * 扫描大表时每个页面只会进入 A1in，不会把 Am 中的热点页面(比如B+树的内部节点)挤出去。
+ */
+class TwoQueueFrameReplacer : public FrameReplacer
+{
+public:
+  static constexpr const char *NAME = "2q";
+
+  /**
+   * @param capacity 预计最多管理多少个页帧，A1in 的目标大小是它的 1/4，A1out 最多记录 1/2
+   */
+  explicit TwoQueueFrameReplacer(size_t capacity);
+
+  const char *name() const override { return NAME; }
+
+  void insert(Frame *frame) override;
+  void access(Frame *frame) override;
+  void remove(Frame *frame, bool evicted) override;
+  void foreach_victim(const function<bool(Frame *)> &visitor) override;
+
+  size_t a1in_size() const { return a1in_.size(); }
+  size_t am_size() const { return am_.size(); }
+
+private:
+  class FrameIdHasher
+  {
+  public:
+    size_t operator()(const FrameId &frame_id) const { return frame_id.hash(); }
+  };
+
+  struct Position
+  {
+    bool                    in_am;
+    list<Frame *>::iterator iter;
+  };
+
+  size_t kin_  = 0;
+  size_t kout_ = 0;
+
+  list<Frame *>                    a1in_;  ///< 头部是最早进入的
+  list<Frame *>                    am_;    ///< 头部是最近访问的
+  unordered_map<Frame *, Position> positions_;
+
+  list<FrameId>                                                  a1out_;  ///< 头部是最早淘汰的
+  unordered_map<FrameId, list<FrameId>::iterator, FrameIdHasher> a1out_positions_;
+};
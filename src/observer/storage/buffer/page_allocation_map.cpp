@@ -0,0 +1,201 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/18.
+//
+
+#include "storage/buffer/page_allocation_map.h"
+
+#include "common/lang/algorithm.h"
+#include "common/lang/bitmap.h"
+#include "storage/buffer/page.h"
+
+PageAllocationMap::PageAllocationMap(int first_segment_capacity, int segment_capacity)
+    : first_segment_capacity_(first_segment_capacity), segment_capacity_(segment_capacity)
+{}
+
+void PageAllocationMap::clear()
+{
+  segments_.clear();
+  free_segments_.clear();
+  allocated_page_num_ = 0;
+}
+
+void PageAllocationMap::add_segment(Frame *frame, char *bitmap)
+{
+  const int segment_index = segment_num();
+
+  Segment &segment   = segments_.emplace_back();
+  segment.frame      = frame;
+  segment.bitmap     = bitmap;
+  segment.first_page = segment_first_page(segment_index);
+  segment.capacity   = segment_index == 0 ? first_segment_capacity_ : segment_capacity_;
+
+  const int group_num = (segment.capacity + GROUP_SIZE - 1) / GROUP_SIZE;
+  segment.summary.resize((group_num + GROUP_SIZE - 1) / GROUP_SIZE, 0);
+  for (int group = 0; group < group_num; group++) {
+    update_group(segment_index, group);
+  }
+
+  const int byte_num = segment.capacity / 8;
+  for (int i = 0; i < byte_num; i++) {
+    allocated_page_num_ += __builtin_popcount(static_cast<unsigned char>(bitmap[i]));
+  }
+  for (int index = byte_num * 8; index < segment.capacity; index++) {
+    allocated_page_num_ += (bitmap[index / 8] >> (index % 8)) & 1;
+  }
+}
+
+int PageAllocationMap::segment_of(PageNum page_num) const
+{
+  if (page_num < first_segment_capacity_) {
+    return 0;
+  }
+  return 1 + (page_num - first_segment_capacity_) / segment_capacity_;
+}
+
+PageNum PageAllocationMap::segment_first_page(int segment) const
+{
+  if (segment == 0) {
+    return 0;
+  }
+  return static_cast<PageNum>(first_segment_capacity_ + static_cast<int64_t>(segment - 1) * segment_capacity_);
+}
+
+bool PageAllocationMap::is_map_page(PageNum page_num) const
+{
+  return page_num >= first_segment_capacity_ && (page_num - first_segment_capacity_) % segment_capacity_ == 0;
+}
+
+bool PageAllocationMap::get_bit(PageNum page_num) const
+{
+  const Segment &segment = segments_[segment_of(page_num)];
+  const int      index   = page_num - segment.first_page;
+  return (segment.bitmap[index / 8] & (1 << (index % 8))) != 0;
+}
+
+Frame *PageAllocationMap::set_bit(PageNum page_num)
+{
+  const int segment_index = segment_of(page_num);
+  Segment  &segment       = segments_[segment_index];
+  const int index         = page_num - segment.first_page;
+  if ((segment.bitmap[index / 8] & (1 << (index % 8))) == 0) {
+    segment.bitmap[index / 8] |= (1 << (index % 8));
+    allocated_page_num_++;
+    update_group(segment_index, index / GROUP_SIZE);
+  }
+  return segment.frame;
+}
+
+Frame *PageAllocationMap::clear_bit(PageNum page_num)
+{
+  const int segment_index = segment_of(page_num);
+  Segment  &segment       = segments_[segment_index];
+  const int index         = page_num - segment.first_page;
+  if ((segment.bitmap[index / 8] & (1 << (index % 8))) != 0) {
+    segment.bitmap[index / 8] &= ~(1 << (index % 8));
+    allocated_page_num_--;
+    update_group(segment_index, index / GROUP_SIZE);
+  }
+  return segment.frame;
+}
+
+PageNum PageAllocationMap::find_free_page(int page_count) const
+{
+  if (free_segments_.empty()) {
+    return BP_INVALID_PAGE_NUM;
+  }
+
+  // 只有最后一个段的后半部分会超出文件的页面个数，所以页号最小的空闲页面超出时，就是没有空闲页面了
+  const Segment &segment = segments_[*free_segments_.begin()];
+  for (size_t i = 0; i < segment.summary.size(); i++) {
+    if (segment.summary[i] == 0) {
+      continue;
+    }
+
+    const int begin = (static_cast<int>(i) * GROUP_SIZE + __builtin_ctzll(segment.summary[i])) * GROUP_SIZE;
+    const int end   = min(begin + GROUP_SIZE, segment.capacity);
+    for (int index = begin; index < end; index += 8) {
+      const unsigned char byte = static_cast<unsigned char>(segment.bitmap[index / 8]);
+      if (byte == 0xFF) {
+        continue;
+      }
+
+      const int free_index = index + __builtin_ctz(~byte & 0xFF);
+      if (free_index >= end) {
+        break;
+      }
+
+      const PageNum page_num = segment.first_page + free_index;
+      return page_num < page_count ? page_num : BP_INVALID_PAGE_NUM;
+    }
+  }
+  return BP_INVALID_PAGE_NUM;
+}
+
+PageNum PageAllocationMap::next_allocated_page(PageNum start, int page_count) const
+{
+  start = max(start, 0);
+  for (int segment_index = segment_of(start); segment_index < segment_num(); segment_index++) {
+    const Segment &segment = segments_[segment_index];
+    if (segment.first_page >= page_count) {
+      break;
+    }
+
+    // 段的第一个页面存放位图，不是数据页面
+    const int size  = min(segment.capacity, page_count - segment.first_page);
+    const int index = max(start - segment.first_page, segment_index == 0 ? 0 : 1);
+    if (index >= size) {
+      continue;
+    }
+
+    common::Bitmap bitmap(segment.bitmap, size);
+    const int      next = bitmap.next_setted_bit(index);
+    if (next != -1) {
+      return segment.first_page + next;
+    }
+  }
+  return BP_INVALID_PAGE_NUM;
+}
+
+bool PageAllocationMap::group_has_free(const Segment &segment, int group) const
+{
+  const int begin = group * GROUP_SIZE;
+  const int end   = min(begin + GROUP_SIZE, segment.capacity);
+  for (int index = begin; index < end; index += 8) {
+    const int           bits = min(8, end - index);
+    const unsigned char mask = static_cast<unsigned char>((1 << bits) - 1);
+    if ((static_cast<unsigned char>(segment.bitmap[index / 8]) & mask) != mask) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void PageAllocationMap::update_group(int segment_index, int group)
+{
+  Segment       &segment  = segments_[segment_index];
+  uint64_t      &word     = segment.summary[group / GROUP_SIZE];
+  const uint64_t mask     = 1ULL << (group % GROUP_SIZE);
+  const bool     has_free = group_has_free(segment, group);
+  const bool     was_free = (word & mask) != 0;
+  if (has_free && !was_free) {
+    word |= mask;
+    if (segment.free_group_num++ == 0) {
+      free_segments_.insert(segment_index);
+    }
+  } else if (!has_free && was_free) {
+    word &= ~mask;
+    if (--segment.free_group_num == 0) {
+      free_segments_.erase(segment_index);
+    }
+  }
+}
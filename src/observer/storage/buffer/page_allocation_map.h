@@ -0,0 +1,121 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/18.
+//
+
+#pragma once
+
+#include "common/lang/set.h"
+#include "common/lang/vector.h"
+#include "common/types.h"
+
+class Frame;
+
+/**
+ * @brief 文件中页面的分配位图
+ * @ingroup BufferPool
+ * @details 文件按照页号划分成多个段(segment)，每个段的分配位图放在一个页面中。
+ * 第0个段从文件头页面开始，位图就是 BPFileHeader 中的 bitmap；后面的段大小相同，
+ * 段的第一个页面存放这个段的位图，位图的第0位就是这个页面自己，总是1。
+ * 这样文件可以一直增长，直到页号达到 PageNum 的上限。
+ *
+ * 查找空闲页面时不再逐位扫描：每个段在内存中记录哪些组(每组64个页面)还有空闲页面，
+ * 同时记录哪些段还有空闲页面，先找页号最小的段，再找段中的组，最后在组内查找。
+ *
+ * 位图存放在页帧的内存中，这里只修改位图，由调用者标记页帧为脏页以及设置LSN。
+ * 调用者负责加锁。
+ */
+class PageAllocationMap
+{
+public:
+  /**
+   * @param first_segment_capacity 第0个段(文件头页面)能管理的页面个数
+   * @param segment_capacity 后面每个段能管理的页面个数，包括存放位图的页面
+   */
+  PageAllocationMap(int first_segment_capacity, int segment_capacity);
+
+  void clear();
+
+  /**
+   * @brief 追加下一个段
+   * @param frame 位图所在的页帧
+   * @param bitmap 位图的起始地址，长度是段的大小
+   */
+  void add_segment(Frame *frame, char *bitmap);
+
+  int    segment_num() const { return static_cast<int>(segments_.size()); }
+  Frame *segment_frame(int segment) const { return segments_[segment].frame; }
+
+  int     segment_of(PageNum page_num) const;
+  PageNum segment_first_page(int segment) const;
+
+  /// @brief 是否是存放段的位图的页面。不包括文件头页面
+  bool is_map_page(PageNum page_num) const;
+
+  /// @brief 页面所在的段是否已经加载
+  bool contains(PageNum page_num) const { return segment_of(page_num) < segment_num(); }
+
+  /**
+   * @brief 页面是否已经分配
+   * @details 页面所在的段必须已经加载
+   */
+  bool get_bit(PageNum page_num) const;
+
+  /**
+   * @brief 标记页面已经分配或者已经释放
+   * @return 位图所在的页帧
+   */
+  Frame *set_bit(PageNum page_num);
+  Frame *clear_bit(PageNum page_num);
+
+  /**
+   * @brief 查找页号最小的空闲页面
+   * @param page_count 文件中的页面个数，只在这个范围内查找
+   * @return 没有空闲页面时返回 BP_INVALID_PAGE_NUM
+   */
+  PageNum find_free_page(int page_count) const;
+
+  /**
+   * @brief 查找下一个已经分配的页面，跳过存放段的位图的页面
+   * @param start 从哪个页面开始查找，包含在内
+   * @param page_count 文件中的页面个数，只在这个范围内查找
+   * @return 没有时返回 BP_INVALID_PAGE_NUM
+   */
+  PageNum next_allocated_page(PageNum start, int page_count) const;
+
+  /// @brief 所有已经加载的段中已经分配的页面个数
+  int allocated_page_num() const { return allocated_page_num_; }
+
+private:
+  static constexpr int GROUP_SIZE = 64;  ///< 每组的页面个数，也是 summary 中每个元素的位数
+
+  struct Segment
+  {
+    Frame           *frame      = nullptr;
+    char            *bitmap     = nullptr;
+    PageNum          first_page = 0;
+    int              capacity   = 0;
+    vector<uint64_t> summary;             ///< 第 i 位表示第 i 组还有空闲页面
+    int              free_group_num = 0;  ///< 还有空闲页面的组的个数
+  };
+
+  bool group_has_free(const Segment &segment, int group) const;
+  void update_group(int segment_index, int group);
+
+private:
+  int first_segment_capacity_ = 0;
+  int segment_capacity_       = 0;
+
+  vector<Segment> segments_;
+  set<int>        free_segments_;  ///< 还有空闲页面的段
+  int             allocated_page_num_ = 0;
+};
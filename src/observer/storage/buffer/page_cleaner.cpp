@@ -0,0 +1,268 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/18.
+//
+
+#include "storage/buffer/page_cleaner.h"
+
+#include <string.h>
+
+#include "common/lang/algorithm.h"
+#include "common/log/log.h"
+#include "common/thread/thread_util.h"
+#include "storage/buffer/disk_buffer_pool.h"
+
+PageCleaner::PageCleaner(BufferPoolManager &bp_manager, BPFrameManager &frame_manager)
+    : bp_manager_(bp_manager), frame_manager_(frame_manager)
+{}
+
+PageCleaner::~PageCleaner() { stop(); }
+
+RC PageCleaner::start(int clean_percent, int interval_ms /* = DEFAULT_INTERVAL_MS */)
+{
+  if (clean_percent <= 0 || clean_percent > 100 || interval_ms <= 0) {
+    LOG_WARN("invalid page cleaner argument. clean percent=%d, interval=%dms", clean_percent, interval_ms);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  if (thread_) {
+    LOG_WARN("page cleaner has already been started");
+    return RC::INTERNAL;
+  }
+
+  clean_percent_ = clean_percent;
+  interval_ms_   = interval_ms;
+  page_copies_.resize(MAX_FLUSH_PAGE_NUM);
+
+  rate_start_time_  = chrono::steady_clock::now();
+  rate_start_count_ = flushed_page_count_.load();
+
+  running_.store(true);
+  thread_ = make_unique<thread>(&PageCleaner::thread_func, this);
+  LOG_INFO("page cleaner started. clean percent=%d, interval=%dms", clean_percent_, interval_ms_);
+  return RC::SUCCESS;
+}
+
+void PageCleaner::stop()
+{
+  if (!thread_) {
+    return;
+  }
+
+  {
+    lock_guard<mutex> guard(thread_lock_);
+    running_.store(false);
+    thread_cond_.notify_all();
+  }
+
+  thread_->join();
+  thread_.reset();
+  LOG_INFO("page cleaner stopped. flushed pages=%ld, writes=%ld",
+           flushed_page_count_.load(), flush_write_count_.load());
+}
+
+void PageCleaner::thread_func()
+{
+  common::thread_set_name("PageCleaner");
+  LOG_INFO("page cleaner thread started");
+
+  while (running_.load()) {
+    {
+      unique_lock<mutex> lock(thread_lock_);
+      thread_cond_.wait_for(lock, chrono::milliseconds(interval_ms_), [this]() { return wakeup_ || !running_.load(); });
+      wakeup_ = false;
+    }
+
+    if (!running_.load()) {
+      break;
+    }
+
+    // 刷满一轮说明脏页还比较多，紧接着再刷一轮
+    while (running_.load() && clean_once() >= MAX_FLUSH_PAGE_NUM) {
+    }
+    update_flush_rate();
+  }
+
+  LOG_INFO("page cleaner thread stopped");
+}
+
+void PageCleaner::update_flush_rate()
+{
+  const auto now     = chrono::steady_clock::now();
+  const auto elapsed = chrono::duration_cast<chrono::milliseconds>(now - rate_start_time_).count();
+  if (elapsed < 1000) {
+    return;
+  }
+
+  const uint64_t count = flushed_page_count_.load();
+  flush_rate_.store((count - rate_start_count_) * 1000 / elapsed);
+  rate_start_time_  = now;
+  rate_start_count_ = count;
+}
+
+int PageCleaner::clean_once()
+{
+  lock_guard<mutex> guard(lock_);
+
+  if (page_copies_.empty()) {
+    page_copies_.resize(MAX_FLUSH_PAGE_NUM);
+  }
+
+  // 空闲页帧不用刷，剩下的从即将被淘汰的页帧中找
+  const int total_num   = static_cast<int>(frame_manager_.total_frame_num());
+  const int free_num    = total_num - static_cast<int>(frame_manager_.frame_num());
+  const int clean_count = total_num * clean_percent_ / 100 - free_num;
+  if (clean_count <= 0) {
+    return 0;
+  }
+
+  vector<FlushPage> pages;
+  frame_manager_.collect_dirty_frames(clean_count, MAX_FLUSH_PAGE_NUM, collector(pages));
+
+  const int flushed_count = flush_collected_pages(pages);
+  LOG_TRACE("page cleaner flushed %d pages. clean count=%d", flushed_count, clean_count);
+  return flushed_count;
+}
+
+int PageCleaner::flush_old_pages(LSN lsn)
+{
+  lock_guard<mutex> guard(lock_);
+
+  if (page_copies_.empty()) {
+    page_copies_.resize(MAX_FLUSH_PAGE_NUM);
+  }
+
+  vector<FlushPage> pages;
+  frame_manager_.collect_old_dirty_frames(lsn, MAX_FLUSH_PAGE_NUM, collector(pages));
+  int flushed_count = flush_collected_pages(pages);
+
+  // 文件头和位图页面一直被 pin 着，不会被收集，由 DiskBufferPool 加着自己的锁刷出去
+  vector<DiskBufferPool *> buffer_pools;
+  bp_manager_.all_buffer_pools(buffer_pools);
+  for (DiskBufferPool *buffer_pool : buffer_pools) {
+    int count = 0;
+    RC  rc    = buffer_pool->flush_old_map_pages(lsn, count);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to flush allocation map pages. file=%s, rc=%s", buffer_pool->filename(), strrc(rc));
+    }
+    flushed_count += count;
+  }
+
+  LOG_TRACE("page cleaner flushed %d old pages. lsn=%ld", flushed_count, lsn);
+  return flushed_count;
+}
+
+function<void(Frame *)> PageCleaner::collector(vector<FlushPage> &pages)
+{
+  // 收集函数在分区的锁内执行，页帧没有被引用，可以安全地复制页面内容
+  return [this, &pages](Frame *frame) {
+    Page *page = &page_copies_[pages.size()];
+    memcpy(page, &frame->page(), sizeof(Page));
+    const LSN rec_lsn = frame->rec_lsn();
+    frame->clear_dirty();
+    set_frame_flushing(frame, true);
+    pages.push_back(FlushPage{frame, frame->buffer_pool_id(), frame->page_num(), rec_lsn, page});
+  };
+}
+
+int PageCleaner::flush_collected_pages(vector<FlushPage> &pages)
+{
+  if (pages.empty()) {
+    return 0;
+  }
+
+  sort(pages.begin(), pages.end(), [](const FlushPage &a, const FlushPage &b) {
+    return a.buffer_pool_id < b.buffer_pool_id || (a.buffer_pool_id == b.buffer_pool_id && a.page_num < b.page_num);
+  });
+
+  int flushed_count = 0;
+  for (size_t begin = 0, end = 1; begin < pages.size(); begin = end++) {
+    while (end < pages.size() && pages[end].buffer_pool_id == pages[begin].buffer_pool_id &&
+           pages[end].page_num == pages[end - 1].page_num + 1) {
+      end++;
+    }
+
+    RC rc = flush_pages(pages, begin, end);
+    if (OB_SUCC(rc)) {
+      flushed_count += static_cast<int>(end - begin);
+      flush_write_count_++;
+    } else {
+      // 没有刷成功，页帧还是脏的
+      for (size_t i = begin; i < end; i++) {
+        pages[i].frame->restore_dirty(pages[i].rec_lsn);
+      }
+    }
+  }
+
+  // 先 unpin 再通知等待者，等待者被唤醒时页帧的引用计数已经恢复了
+  for (FlushPage &page : pages) {
+    page.frame->unpin();
+    set_frame_flushing(page.frame, false);
+  }
+
+  flushed_page_count_ += flushed_count;
+  return flushed_count;
+}
+
+RC PageCleaner::flush_pages(const vector<FlushPage> &pages, size_t begin, size_t end)
+{
+  DiskBufferPool *buffer_pool = nullptr;
+  RC              rc          = bp_manager_.get_buffer_pool(pages[begin].buffer_pool_id, buffer_pool);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  vector<Page *> page_copies;
+  page_copies.reserve(end - begin);
+  for (size_t i = begin; i < end; i++) {
+    page_copies.push_back(pages[i].page);
+  }
+
+  rc = buffer_pool->flush_page_copies(pages[begin].page_num, page_copies);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to flush pages in background. file=%s, page num=%d, count=%d, rc=%s",
+             buffer_pool->filename(), pages[begin].page_num, static_cast<int>(end - begin), strrc(rc));
+  }
+  return rc;
+}
+
+void PageCleaner::add_sync_flush_count()
+{
+  sync_flush_count_++;
+  if (running_.load()) {
+    lock_guard<mutex> guard(thread_lock_);
+    wakeup_ = true;
+    thread_cond_.notify_all();
+  }
+}
+
+void PageCleaner::set_frame_flushing(Frame *frame, bool flushing)
+{
+  lock_guard<mutex> guard(flushing_lock_);
+  if (flushing) {
+    flushing_frames_.insert(frame);
+  } else {
+    flushing_frames_.erase(frame);
+    flushing_cond_.notify_all();
+  }
+  flushing_frame_num_.store(static_cast<int>(flushing_frames_.size()));
+}
+
+void PageCleaner::wait_frame_flushed(Frame *frame)
+{
+  if (flushing_frame_num_.load() == 0) {
+    return;
+  }
+
+  unique_lock<mutex> lock(flushing_lock_);
+  flushing_cond_.wait(lock, [this, frame]() { return flushing_frames_.count(frame) == 0; });
+}
@@ -0,0 +1,160 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/18.
+//
+
+#pragma once
+
+#include "common/lang/atomic.h"
+#include "common/lang/chrono.h"
+#include "common/lang/functional.h"
+#include "common/lang/memory.h"
+#include "common/lang/mutex.h"
+#include "common/lang/thread.h"
+#include "common/lang/unordered_set.h"
+#include "common/lang/vector.h"
+#include "common/rc.h"
+#include "storage/buffer/page.h"
+
+class BufferPoolManager;
+class BPFrameManager;
+class Frame;
+
+/**
+ * @brief 后台刷脏页线程
+ * @ingroup BufferPool
+ * @details 页帧只在被淘汰时才会刷到磁盘，如果要淘汰的是脏页，查询线程就要同步地写一次 DoubleWriteBuffer 和数据文件。
+ * PageCleaner 在后台定期检查每个分区中即将被淘汰的页帧(按照 FrameReplacer 的淘汰顺序)，
+ * 把其中没有被引用的脏页刷出去，让空闲页帧加上可以直接淘汰的干净页帧保持在总数的 clean_percent 以上。
+ *
+ * 刷页面时先在分区的锁内复制页面内容并清除脏标记，这时页帧没有被引用，复制出来的一定是完整的页面。
+ * 然后在锁外把页号连续的页面一起交给 DoubleWriteBuffer，DoubleWriteBuffer 写回数据文件时再把连续的页面合并成一次写。
+ * 刷页面期间页帧一直被 pin 住，不会被淘汰；其它线程要刷同一个页帧或者释放它时，需要先等待(wait_frame_flushed)，
+ * 保证磁盘上不会被旧的页面内容覆盖。
+ *
+ * 打开关闭 DiskBufferPool 时要持有 lock()，防止后台线程访问正在关闭的文件。
+ */
+class PageCleaner
+{
+public:
+  static constexpr int DEFAULT_CLEAN_PERCENT = 10;   ///< 默认保持多少比例的页帧可以直接淘汰
+  static constexpr int DEFAULT_INTERVAL_MS   = 100;  ///< 默认每隔多久检查一次
+  static constexpr int MAX_FLUSH_PAGE_NUM    = 64;   ///< 每一轮最多刷多少个页面
+
+  PageCleaner(BufferPoolManager &bp_manager, BPFrameManager &frame_manager);
+  ~PageCleaner();
+
+  /**
+   * @brief 启动后台线程
+   * @param clean_percent 希望保持的空闲以及干净页帧的比例，取值 (0, 100]
+   * @param interval_ms 每隔多久检查一次
+   */
+  RC   start(int clean_percent, int interval_ms = DEFAULT_INTERVAL_MS);
+  void stop();
+  bool running() const { return running_.load(); }
+
+  /**
+   * @brief 执行一轮刷脏页
+   * @details 后台线程定期调用，测试也可以直接调用
+   * @return 刷出的页面个数
+   */
+  int clean_once();
+
+  /**
+   * @brief 把 rec_lsn 比指定LSN小的脏页都刷出去
+   * @details 检查点调用。这些页面可能一直很热，不会出现在淘汰顺序的前面，clean_once 刷不到它们，
+   * 检查点就一直没办法推进。被引用着的页帧这一轮先跳过，下一轮再刷
+   * @return 刷出的页面个数
+   */
+  int flush_old_pages(LSN lsn);
+
+  /**
+   * @brief 有查询线程在淘汰页帧时同步地刷了脏页，唤醒后台线程尽快工作
+   */
+  void add_sync_flush_count();
+
+  /**
+   * @brief 页帧正在被后台线程刷出时，等待刷完
+   */
+  void wait_frame_flushed(Frame *frame);
+
+  /// @brief 打开关闭 DiskBufferPool 时使用的锁，与后台线程的一轮刷页面互斥
+  mutex &lock() { return lock_; }
+
+  int  clean_percent() const { return clean_percent_; }
+  void set_clean_percent(int clean_percent) { clean_percent_ = clean_percent; }
+
+  /// @brief 后台刷出的页面个数
+  uint64_t flushed_page_count() const { return flushed_page_count_.load(); }
+  /// @brief 后台刷页面的写请求个数，页号连续的页面合并成一个请求
+  uint64_t flush_write_count() const { return flush_write_count_.load(); }
+  /// @brief 最近一段时间内后台每秒刷出的页面个数
+  uint64_t flush_rate() const { return flush_rate_.load(); }
+  /// @brief 查询线程淘汰页帧时同步刷出的脏页个数
+  uint64_t sync_flush_count() const { return sync_flush_count_.load(); }
+
+private:
+  struct FlushPage
+  {
+    Frame  *frame;
+    int32_t buffer_pool_id;
+    PageNum page_num;
+    LSN     rec_lsn;  ///< 复制页面时的 rec_lsn，没有刷成功时恢复
+    Page   *page;     ///< 页面内容的副本
+  };
+
+  void thread_func();
+  void update_flush_rate();
+  void set_frame_flushing(Frame *frame, bool flushing);
+
+  /// @brief 复制页面内容并清除脏标记，把页帧放到 pages 中
+  function<void(Frame *)> collector(vector<FlushPage> &pages);
+
+  /**
+   * @brief 刷出收集到的页面，最后 unpin 这些页帧
+   * @return 刷出的页面个数
+   */
+  int flush_collected_pages(vector<FlushPage> &pages);
+
+  /**
+   * @brief 把同一个 buffer pool 中页号连续的页面一起刷出去
+   */
+  RC flush_pages(const vector<FlushPage> &pages, size_t begin, size_t end);
+
+private:
+  BufferPoolManager &bp_manager_;
+  BPFrameManager    &frame_manager_;
+
+  int clean_percent_ = DEFAULT_CLEAN_PERCENT;
+  int interval_ms_   = DEFAULT_INTERVAL_MS;
+
+  mutex              lock_;  ///< 一轮刷页面期间持有
+  vector<Page>       page_copies_;
+  atomic<bool>       running_{false};
+  mutex              thread_lock_;
+  condition_variable thread_cond_;
+  bool               wakeup_ = false;
+  unique_ptr<thread> thread_;
+
+  mutex                  flushing_lock_;
+  condition_variable     flushing_cond_;
+  unordered_set<Frame *> flushing_frames_;        ///< 正在刷出的页帧
+  atomic<int>            flushing_frame_num_{0};  ///< flushing_frames_ 的大小，没有刷页面时不需要加锁
+
+  atomic<uint64_t> flushed_page_count_{0};
+  atomic<uint64_t> flush_write_count_{0};
+  atomic<uint64_t> flush_rate_{0};
+  atomic<uint64_t> sync_flush_count_{0};
+
+  chrono::steady_clock::time_point rate_start_time_;
+  uint64_t                         rate_start_count_ = 0;
+};
@@ -49,7 +49,12 @@ RC DiskLogHandler::stop()
     return RC::INTERNAL;
   }
 
-  running_.store(false);
+  {
+    lock_guard guard(mutex_);
+    running_.store(false);
+  }
+  flush_cond_.notify_all();
+  flushed_cond_.notify_all();
 
   LOG_INFO("log handler stopped");
   return RC::SUCCESS;
@@ -99,6 +104,19 @@ RC DiskLogHandler::replay(LogReplayer &replayer, LSN start_lsn)
   return rc;
 }
 
+RC DiskLogHandler::truncate(LSN lsn)
+{
+  int removed_count = 0;
+  RC  rc            = file_manager_.remove_files_before(lsn, removed_count);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to remove clog files. lsn=%ld, rc=%s", lsn, strrc(rc));
+    return rc;
+  }
+
+  LOG_INFO("truncate clog files done. lsn=%ld, removed files=%d", lsn, removed_count);
+  return RC::SUCCESS;
+}
+
 RC DiskLogHandler::iterate(function<RC(LogEntry &)> consumer, LSN start_lsn)
 {
   vector<string> log_files;
@@ -133,40 +151,47 @@ RC DiskLogHandler::iterate(function<RC(LogEntry &)> consumer, LSN start_lsn)
   return RC::SUCCESS;
 }
 
-RC DiskLogHandler::_append(LSN &lsn, LogModule module, vector<char> &&data)
+RC DiskLogHandler::_append(LSN &lsn, LogModule module, span<const char> data)
 {
   ASSERT(running_.load(), "log handler is not running. lsn=%ld, module=%s, size=%d", 
         lsn, module.name(), data.size());
 
-  RC rc = entry_buffer_.append(lsn, module, std::move(data));
+  RC rc = entry_buffer_.append(lsn, module, data);
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to append log entry to buffer. rc=%s", strrc(rc));
     return rc;
   }
 
+  // 刷盘线程在持有 mutex_ 时检查有没有可以刷盘的日志，这里加锁后再通知，就不会丢失唤醒
+  lock_guard guard(mutex_);
+  flush_cond_.notify_one();
   return RC::SUCCESS;
 }
 
 RC DiskLogHandler::wait_lsn(LSN lsn)
 {
-  // 直接强制等待。在生产系统中，我们可能会使用条件变量来等待。
-  while (running_.load() && current_flushed_lsn() < lsn) {
-    this_thread::sleep_for(chrono::milliseconds(100));
+  if (current_flushed_lsn() < lsn) {
+    unique_lock lock(mutex_);
+    flushed_cond_.wait(lock, [this, lsn]() {
+      return !running_.load() || current_flushed_lsn() >= lsn || OB_FAIL(flush_rc_.load());
+    });
   }
 
   if (current_flushed_lsn() >= lsn) {
     return RC::SUCCESS;
-  } else {
-    return RC::INTERNAL;
   }
+
+  const RC flush_rc = flush_rc_.load();
+  return OB_FAIL(flush_rc) ? flush_rc : RC::INTERNAL;
 }
 
 void DiskLogHandler::thread_func()
 {
   /*
-  这个线程一直不停的循环，检查日志缓冲区中是否有日志在内存中，如果在内存中就刷新到磁盘。
-  这种做法很粗暴简单，与生产数据库的做法不同。生产数据库通常会在内存达到一定量，或者一定时间
-  之后，会刷新一下磁盘。这样做的好处是减少磁盘的IO次数，提高性能。
+  这个线程把日志缓冲区中的日志刷新到磁盘。每次取出缓冲区中所有的日志，只写一次文件、刷一次盘，
+  然后唤醒所有等待日志落盘的线程。刷盘期间新提交的事务会在下一批中一起刷盘，
+  这样磁盘的IO次数与提交的事务数无关，提交越频繁，每批的日志就越多(组提交)。
+  没有可以刷盘的日志时在条件变量上等待，追加日志时会被唤醒。
   */
   thread_set_name("LogHandler");
   LOG_INFO("log handler thread started");
@@ -196,13 +221,32 @@ void DiskLogHandler::thread_func()
     rc              = entry_buffer_.flush(file_writer, flush_count);
     if (OB_FAIL(rc) && RC::LOG_FILE_FULL != rc) {
       LOG_WARN("failed to flush log entry buffer. rc=%s", strrc(rc));
+
+      // 把错误告诉等待日志落盘的线程，然后等待一段时间再重试，避免空转
+      unique_lock lock(mutex_);
+      flush_rc_.store(rc);
+      flushed_cond_.notify_all();
+      flush_cond_.wait_for(lock, chrono::milliseconds(flush_interval_ms_), [this]() { return !running_.load(); });
+      continue;
+    }
+
+    if (flush_count > 0) {
+      lock_guard guard(mutex_);
+      flush_rc_.store(RC::SUCCESS);
+      flushed_cond_.notify_all();
     }
 
     if (flush_count == 0 && rc == RC::SUCCESS) {
-      this_thread::sleep_for(chrono::milliseconds(100));
-      continue;
+      unique_lock lock(mutex_);
+      flush_cond_.wait_for(lock, chrono::milliseconds(flush_interval_ms_), [this]() {
+        return !running_.load() || entry_buffer_.flushable();
+      });
     }
   }
 
+  {
+    lock_guard guard(mutex_);
+    flushed_cond_.notify_all();
+  }
   LOG_INFO("log handler thread stopped");
 }
@@ -17,8 +17,10 @@ See the Mulan PSL v2 for more details. */
 #include "common/types.h"
 #include "common/rc.h"
 #include "common/lang/vector.h"
+#include "common/lang/atomic.h"
 #include "common/lang/deque.h"
 #include "common/lang/memory.h"
+#include "common/lang/mutex.h"
 #include "common/lang/thread.h"
 #include "storage/clog/log_module.h"
 #include "storage/clog/log_file.h"
@@ -31,7 +33,8 @@ class LogReplayer;
  * @brief 对外提供服务的CLog模块
  * @ingroup CLog
  * @details 该模块负责日志的写入、读取、回放等功能。
- * 会在后台开启一个线程，一直尝试刷新内存中的日志到磁盘。
+ * 会在后台开启一个线程刷新内存中的日志到磁盘。追加日志时唤醒这个线程，没有日志时最多等待 flush_interval_ms。
+ * 每次把缓冲区中所有的日志一起写入并刷盘，等待日志落盘的事务一起被唤醒，也就是组提交(group commit)。
  * 所有的CLog日志文件都存放在指定的目录下，每个日志文件按照日志条数来划分。
  * 调用的顺序应该是：
  * @code {.cpp}
@@ -47,6 +50,9 @@ class LogReplayer;
  */
 class DiskLogHandler : public LogHandler
 {
+public:
+  static constexpr int DEFAULT_FLUSH_INTERVAL_MS = 10;
+
 public:
   DiskLogHandler()          = default;
   virtual ~DiskLogHandler() = default;
@@ -92,16 +98,29 @@ public:
 
   /**
    * @brief 等待指定的日志刷盘
-   *
+   * @details 在条件变量上等待，刷盘线程每刷完一批日志就唤醒所有等待者。
+   * 刷盘失败时等待者也会被唤醒，返回刷盘的错误码
    * @param lsn 想要等待的日志
    */
   RC wait_lsn(LSN lsn) override;
 
+  /**
+   * @brief 设置刷盘线程空闲时的等待时间
+   * @details 追加日志会立即唤醒刷盘线程，这个时间只是没有被唤醒时检查一次缓冲区的间隔
+   */
+  void set_flush_interval_ms(int interval_ms) { flush_interval_ms_ = interval_ms; }
+
   /// @brief 当前的LSN
   LSN current_lsn() const override { return entry_buffer_.current_lsn(); }
   /// @brief 当前刷新到哪个日志
   LSN current_flushed_lsn() const { return entry_buffer_.flushed_lsn(); }
 
+  /**
+   * @brief 删除所有日志都在检查点之前的日志文件
+   * @details 可以与刷盘线程同时执行，正在写入的最后一个文件不会删除
+   */
+  RC truncate(LSN lsn) override;
+
 private:
   /**
    * @brief 在缓存中增加一条日志
@@ -110,7 +129,7 @@ private:
    * @param[in] module  日志模块
    * @param[in] data    日志数据。具体的数据由各个模块自己定义
    */
-  RC _append(LSN &lsn, LogModule module, vector<char> &&data) override;
+  RC _append(LSN &lsn, LogModule module, span<const char> data) override;
 
 private:
   /**
@@ -122,6 +141,12 @@ private:
   unique_ptr<thread> thread_;          /// 刷新日志的线程
   atomic_bool        running_{false};  /// 是否还要继续运行
 
+  mutex              mutex_;                                          /// 保护下面两个条件变量
+  condition_variable flush_cond_;                                     /// 唤醒刷盘线程
+  condition_variable flushed_cond_;                                   /// 唤醒等待日志落盘的线程
+  int                flush_interval_ms_ = DEFAULT_FLUSH_INTERVAL_MS;  /// 刷盘线程空闲时的等待时间
+  atomic<RC>         flush_rc_{RC::SUCCESS};                          /// 最近一次刷盘的错误，成功刷盘后清除
+
   LogFileManager file_manager_;  /// 管理所有的日志文件
   LogEntryBuffer entry_buffer_;  /// 缓存日志
 
@@ -13,36 +13,60 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include "storage/clog/integrated_log_replayer.h"
+#include "common/lang/functional.h"
+#include "common/log/log.h"
+#include "common/thread/thread_util.h"
 #include "storage/clog/log_entry.h"
 
-IntegratedLogReplayer::IntegratedLogReplayer(BufferPoolManager &bpm)
+IntegratedLogReplayer::IntegratedLogReplayer(BufferPoolManager &bpm, int worker_num /* = 1 */)
     : buffer_pool_log_replayer_(bpm),
       record_log_replayer_(bpm),
       bplus_tree_log_replayer_(bpm),
       trx_log_replayer_(nullptr)
-{}
+{
+  start_workers(worker_num);
+}
 
-IntegratedLogReplayer::IntegratedLogReplayer(BufferPoolManager &bpm, unique_ptr<LogReplayer> trx_log_replayer)
+IntegratedLogReplayer::IntegratedLogReplayer(
+    BufferPoolManager &bpm, unique_ptr<LogReplayer> trx_log_replayer, int worker_num /* = 1 */)
     : buffer_pool_log_replayer_(bpm),
       record_log_replayer_(bpm),
       bplus_tree_log_replayer_(bpm),
       trx_log_replayer_(std::move(trx_log_replayer))
-{}
+{
+  start_workers(worker_num);
+}
+
+IntegratedLogReplayer::~IntegratedLogReplayer() { stop_workers(); }
 
 RC IntegratedLogReplayer::replay(const LogEntry &entry)
 {
-  switch (entry.module().id()) {
-    case LogModule::Id::BUFFER_POOL: return buffer_pool_log_replayer_.replay(entry);
-    case LogModule::Id::RECORD_MANAGER: return record_log_replayer_.replay(entry);
-    case LogModule::Id::BPLUS_TREE: return bplus_tree_log_replayer_.replay(entry);
-    case LogModule::Id::TRANSACTION: return trx_log_replayer_->replay(entry);
-    default: return RC::INVALID_ARGUMENT;
+  if (workers_.empty()) {
+    return apply(entry);
+  }
+
+  RC rc = worker_rc_.load();
+  if (OB_FAIL(rc)) {
+    return rc;
   }
+
+  int index = worker_index(entry);
+  if (index < 0) {
+    return apply(entry);
+  }
+  return dispatch(*workers_[index], entry);
 }
 
 RC IntegratedLogReplayer::on_done()
 {
-  RC rc = buffer_pool_log_replayer_.on_done();
+  RC rc = wait_workers_idle();
+  stop_workers();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to do parallel log replay. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  rc = buffer_pool_log_replayer_.on_done();
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to do buffer pool log replay. rc=%s", strrc(rc));
     return rc;
@@ -59,6 +83,10 @@ RC IntegratedLogReplayer::on_done()
     return rc;
   }
 
+  if (trx_log_replayer_ == nullptr) {
+    return RC::SUCCESS;
+  }
+
   rc = trx_log_replayer_->on_done();
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to do mvcc trx log replay. rc=%s", strrc(rc));
@@ -66,4 +94,146 @@ RC IntegratedLogReplayer::on_done()
   }
 
   return RC::SUCCESS;
-}
\ No newline at end of file
+}
+
+RC IntegratedLogReplayer::apply(const LogEntry &entry)
+{
+  switch (entry.module().id()) {
+    case LogModule::Id::BUFFER_POOL: return buffer_pool_log_replayer_.replay(entry);
+    case LogModule::Id::RECORD_MANAGER: return record_log_replayer_.replay(entry);
+    case LogModule::Id::BPLUS_TREE: return bplus_tree_log_replayer_.replay(entry);
+    case LogModule::Id::TRANSACTION: return trx_log_replayer_->replay(entry);
+    default: return RC::INVALID_ARGUMENT;
+  }
+}
+
+int IntegratedLogReplayer::worker_index(const LogEntry &entry) const
+{
+  int32_t buffer_pool_id = -1;
+  PageNum page_num       = BP_INVALID_PAGE_NUM;
+  switch (entry.module().id()) {
+    case LogModule::Id::RECORD_MANAGER: {
+      if (entry.payload_size() < RecordLogHeader::SIZE) {
+        return -1;
+      }
+      auto log_header = reinterpret_cast<const RecordLogHeader *>(entry.data());
+      buffer_pool_id  = log_header->buffer_pool_id;
+      page_num        = log_header->page_num;
+    } break;
+    case LogModule::Id::BUFFER_POOL: {
+      if (entry.payload_size() != sizeof(BufferPoolLogEntry)) {
+        return -1;
+      }
+      buffer_pool_id = reinterpret_cast<const BufferPoolLogEntry *>(entry.data())->buffer_pool_id;
+    } break;
+    case LogModule::Id::BPLUS_TREE: {
+      // B+树日志的开头是 buffer pool id，参考 BplusTreeLogger::redo
+      if (entry.payload_size() < static_cast<int32_t>(sizeof(buffer_pool_id))) {
+        return -1;
+      }
+      memcpy(&buffer_pool_id, entry.data(), sizeof(buffer_pool_id));
+    } break;
+    default: {
+      return -1;
+    }
+  }
+
+  const uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(buffer_pool_id)) << 32) |
+                       static_cast<uint32_t>(page_num);
+  return static_cast<int>(hash<uint64_t>()(key) % workers_.size());
+}
+
+RC IntegratedLogReplayer::dispatch(ReplayWorker &worker, const LogEntry &entry)
+{
+  LogEntry     copied_entry;
+  vector<char> data(entry.data(), entry.data() + entry.payload_size());
+  RC           rc = copied_entry.init(entry.lsn(), entry.module(), std::move(data));
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to copy log entry. entry=%s, rc=%s", entry.to_string().c_str(), strrc(rc));
+    return rc;
+  }
+
+  unique_lock<mutex> lock(worker.lock);
+  worker.cond.wait(lock, [&worker]() { return worker.entries.size() < ReplayWorker::MAX_PENDING_ENTRIES; });
+  worker.entries.push_back(std::move(copied_entry));
+  worker.cond.notify_all();
+  return RC::SUCCESS;
+}
+
+RC IntegratedLogReplayer::wait_workers_idle()
+{
+  for (unique_ptr<ReplayWorker> &worker : workers_) {
+    unique_lock<mutex> lock(worker->lock);
+    worker->cond.wait(lock, [&worker]() { return worker->entries.empty() && !worker->applying; });
+  }
+  return worker_rc_.load();
+}
+
+void IntegratedLogReplayer::start_workers(int worker_num)
+{
+#ifndef CONCURRENCY
+  if (worker_num > 1) {
+    LOG_INFO("parallel log replay requires CONCURRENCY, replay with single thread. worker num=%d", worker_num);
+    worker_num = 1;
+  }
+#endif
+
+  if (worker_num <= 1) {
+    return;
+  }
+
+  for (int i = 0; i < worker_num; i++) {
+    workers_.push_back(make_unique<ReplayWorker>());
+  }
+  for (unique_ptr<ReplayWorker> &worker : workers_) {
+    worker->worker_thread = thread(&IntegratedLogReplayer::worker_func, this, std::ref(*worker));
+  }
+  LOG_INFO("parallel log replay started. worker num=%d", worker_num);
+}
+
+void IntegratedLogReplayer::stop_workers()
+{
+  for (unique_ptr<ReplayWorker> &worker : workers_) {
+    lock_guard<mutex> guard(worker->lock);
+    worker->stopped = true;
+    worker->cond.notify_all();
+  }
+
+  for (unique_ptr<ReplayWorker> &worker : workers_) {
+    worker->worker_thread.join();
+  }
+  workers_.clear();
+}
+
+void IntegratedLogReplayer::worker_func(ReplayWorker &worker)
+{
+  common::thread_set_name("LogReplayer");
+
+  unique_lock<mutex> lock(worker.lock);
+  while (true) {
+    worker.cond.wait(lock, [&worker]() { return !worker.entries.empty() || worker.stopped; });
+    if (worker.entries.empty()) {
+      break;
+    }
+
+    LogEntry entry = std::move(worker.entries.front());
+    worker.entries.pop_front();
+    worker.applying = true;
+    worker.cond.notify_all();  // 队列有空位了
+    lock.unlock();
+
+    // 有日志回放失败后，后面的日志都不再回放，只是从队列中取出来
+    if (OB_SUCC(worker_rc_.load())) {
+      RC rc = apply(entry);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to replay log entry. entry=%s, rc=%s", entry.to_string().c_str(), strrc(rc));
+        RC expected = RC::SUCCESS;
+        worker_rc_.compare_exchange_strong(expected, rc);
+      }
+    }
+
+    lock.lock();
+    worker.applying = false;
+    worker.cond.notify_all();
+  }
+}
@@ -14,6 +14,13 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "common/lang/atomic.h"
+#include "common/lang/deque.h"
+#include "common/lang/memory.h"
+#include "common/lang/mutex.h"
+#include "common/lang/thread.h"
+#include "common/lang/vector.h"
+#include "storage/clog/log_entry.h"
 #include "storage/clog/log_replayer.h"
 #include "storage/buffer/buffer_pool_log.h"
 #include "storage/record/record_log.h"
@@ -25,7 +32,14 @@ class BufferPoolManager;
 /**
  * @brief 整体日志回放类
  * @ingroup Clog
- * @details 负责回放所有日志，是其它各模块日志回放的分发器
+ * @details 负责回放所有日志，是其它各模块日志回放的分发器。
+ * 默认在调用 replay 的线程上逐条回放。指定多个工作线程时，按照日志修改的页面把日志分给工作线程并行回放：
+ * - record manager 的日志只修改一个页面，按照 (buffer_pool_id, page_num) 分配；
+ * - buffer pool 的日志修改文件头和位图页面，B+树的一条日志会修改同一个文件的多个页面，这两种日志按照 buffer_pool_id 分配；
+ * - 事务日志回放时只记录事务的操作，不访问页面，直接在当前线程按顺序回放。
+ * 同一个页面的日志总是由同一个线程按照日志的顺序回放。on_done 时先等所有工作线程回放完，
+ * 再执行各个模块的 on_done，比如回滚未提交的事务。
+ * 并行回放依赖缓冲池的并发控制，只在 CONCURRENCY 编译模式下生效，否则退化成单线程回放。
  */
 class IntegratedLogReplayer : public LogReplayer
 {
@@ -36,15 +50,16 @@ public:
    * BufferPoolManager 在对应MySQL中，可以类比table space 的管理器。但是在这里，一个表可能会有多个table space(buffer
    * pool)。 比如一个数据文件、多个索引文件。
    */
-  IntegratedLogReplayer(BufferPoolManager &bpm);
+  IntegratedLogReplayer(BufferPoolManager &bpm, int worker_num = 1);
 
   /**
    * @brief 构造函数
    * @details
    * 区别于另一个构造函数，这个构造函数可以指定不同的事务日志回放器。比如进程启动时可以指定选择使用VacuousTrx还是MvccTrx。
+   * @param worker_num 并行回放的工作线程个数，不大于1时在当前线程回放
    */
-  IntegratedLogReplayer(BufferPoolManager &bpm, unique_ptr<LogReplayer> trx_log_replayer);
-  virtual ~IntegratedLogReplayer() = default;
+  IntegratedLogReplayer(BufferPoolManager &bpm, unique_ptr<LogReplayer> trx_log_replayer, int worker_num = 1);
+  virtual ~IntegratedLogReplayer();
 
   //! @copydoc LogReplayer::replay
   RC replay(const LogEntry &entry) override;
@@ -52,9 +67,45 @@ public:
   //! @copydoc LogReplayer::on_done
   RC on_done() override;
 
+  /// @brief 并行回放的工作线程个数，0 表示在当前线程回放
+  int worker_num() const { return static_cast<int>(workers_.size()); }
+
+private:
+  /**
+   * @brief 并行回放的工作线程
+   * @details 按照放入队列的顺序回放日志。队列的长度有上限，避免读日志比回放快很多时占用太多内存
+   */
+  struct ReplayWorker
+  {
+    static constexpr size_t MAX_PENDING_ENTRIES = 1024;  ///< 队列中最多放多少条日志
+
+    mutex              lock;
+    condition_variable cond;              ///< 队列有变化或者要停止时通知
+    deque<LogEntry>    entries;           ///< 等待回放的日志
+    bool               applying = false;  ///< 是否正在回放一条日志
+    bool               stopped  = false;  ///< 是否要停止。停止前会把队列中的日志回放完
+    thread             worker_thread;
+  };
+
+  void start_workers(int worker_num);
+  void stop_workers();
+  void worker_func(ReplayWorker &worker);
+
+  /// @brief 日志交给哪个工作线程回放。返回-1表示在当前线程回放
+  int worker_index(const LogEntry &entry) const;
+  /// @brief 把日志复制一份放到工作线程的队列中
+  RC dispatch(ReplayWorker &worker, const LogEntry &entry);
+  /// @brief 等待所有工作线程把队列中的日志回放完
+  RC wait_workers_idle();
+  /// @brief 交给对应模块的日志回放器回放
+  RC apply(const LogEntry &entry);
+
 private:
   BufferPoolLogReplayer   buffer_pool_log_replayer_;  ///< 缓冲池日志回放器
   RecordLogReplayer       record_log_replayer_;       ///< record manager 日志回放器
   BplusTreeLogReplayer    bplus_tree_log_replayer_;   ///< bplus tree 日志回放器
   unique_ptr<LogReplayer> trx_log_replayer_;          ///< trx 日志回放器
+
+  vector<unique_ptr<ReplayWorker>> workers_;                 ///< 并行回放的工作线程
+  atomic<RC>                       worker_rc_{RC::SUCCESS};  ///< 工作线程第一次回放失败的错误码
 };
\ No newline at end of file
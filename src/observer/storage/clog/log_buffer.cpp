@@ -12,12 +12,16 @@ See the Mulan PSL v2 for more details. */
 // Created by wangyunlai on 2024/01/31
 //
 
+#include <string.h>
+
 #include "storage/clog/log_buffer.h"
 #include "storage/clog/log_file.h"
-#include "common/lang/chrono.h"
+#include "common/lang/algorithm.h"
 
 using namespace common;
 
+LogEntryBuffer::LogEntryBuffer() { init(0); }
+
 RC LogEntryBuffer::init(LSN lsn, int32_t max_bytes /*= 0*/)
 {
   current_lsn_.store(lsn);
@@ -26,36 +30,86 @@ RC LogEntryBuffer::init(LSN lsn, int32_t max_bytes /*= 0*/)
   if (max_bytes > 0) {
     max_bytes_ = max_bytes;
   }
+
+  // 缓冲区末尾放不下一条日志时会跳过剩下的空间，缓冲区至少是最大日志的两倍，才能保证总能放下一条日志
+  const int64_t capacity = max(static_cast<int64_t>(max_bytes_), 2 * static_cast<int64_t>(LogEntry::max_size()));
+  if (capacity != capacity_) {
+    capacity_ = capacity;
+    buffer_   = unique_ptr<char[]>(new char[capacity_]);
+  }
+  if (!published_) {
+    published_ = make_unique<atomic<LSN>[]>(MAX_PENDING_ENTRIES);
+  }
+  for (int32_t i = 0; i < MAX_PENDING_ENTRIES; i++) {
+    published_[i].store(0);
+  }
+  reserved_pos_.store(0);
+  flushed_pos_.store(0);
   return RC::SUCCESS;
 }
 
 RC LogEntryBuffer::append(LSN &lsn, LogModule::Id module_id, vector<char> &&data)
 {
-  return append(lsn, LogModule(module_id), std::move(data));
+  return append(lsn, LogModule(module_id), span<const char>(data.data(), data.size()));
 }
 
 RC LogEntryBuffer::append(LSN &lsn, LogModule module, vector<char> &&data)
 {
-  /// 控制当前buffer使用的内存
-  /// 简单粗暴，强制原地等待
-  /// 但是如果当前想要新插入的日志比较大，不会做控制。所以理论上容纳的最大buffer内存是2*max_bytes_
-  while (bytes_.load() >= max_bytes_) {
-    this_thread::sleep_for(chrono::milliseconds(10));
+  return append(lsn, module, span<const char>(data.data(), data.size()));
+}
+
+RC LogEntryBuffer::append(LSN &lsn, LogModule module, span<const char> data)
+{
+  if (static_cast<int64_t>(data.size()) > LogEntry::max_payload_size()) {
+    LOG_WARN("log entry size is too large. size=%ld, max_payload_size=%d", data.size(), LogEntry::max_payload_size());
+    return RC::INVALID_ARGUMENT;
   }
 
-  LogEntry entry;
-  RC       rc = entry.init(lsn, module, std::move(data));
-  if (OB_FAIL(rc)) {
-    LOG_WARN("failed to init log entry. rc=%s", strrc(rc));
-    return rc;
+  const int64_t total_size = LogHeader::SIZE + static_cast<int64_t>(data.size());
+
+  // 在锁内分配LSN和存放的位置，保证日志在缓冲区中按照LSN排列。
+  // 缓冲区已经满了，或者没有刷盘的日志太多时，等待刷盘释放空间
+  int64_t pos       = 0;
+  int64_t tail_size = 0;  // 缓冲区末尾剩下的空间
+  int64_t start_pos = 0;
+  {
+    unique_lock lock(mutex_);
+    while (true) {
+      pos       = reserved_pos_.load();
+      tail_size = capacity_ - pos % capacity_;
+      start_pos = tail_size < total_size ? pos + tail_size : pos;
+
+      const bool has_space = start_pos + total_size - flushed_pos_.load() <= capacity_;
+      const bool has_slot  = current_lsn_.load() - flushed_lsn_.load() < MAX_PENDING_ENTRIES;
+      if (has_space && has_slot) {
+        break;
+      }
+      space_cond_.wait(lock);
+    }
+
+    lsn = ++current_lsn_;
+    reserved_pos_.store(start_pos + total_size);
   }
 
-  lock_guard guard(mutex_);
-  lsn = ++current_lsn_;
-  entry.set_lsn(lsn);
+  // 跳过缓冲区末尾的空间。能放下日志头时写一个长度是-1的日志头，否则刷盘时根据位置就知道要跳过
+  if (start_pos != pos && tail_size >= LogHeader::SIZE) {
+    LogHeader padding;
+    padding.lsn       = lsn;
+    padding.size      = -1;
+    padding.module_id = module.index();
+    memcpy(data_at(pos), &padding, LogHeader::SIZE);
+  }
+
+  LogHeader header;
+  header.lsn       = lsn;
+  header.size      = static_cast<int32_t>(data.size());
+  header.module_id = module.index();
 
-  entries_.push_back(std::move(entry));
-  bytes_ += entry.total_size();
+  char *entry_data = data_at(start_pos);
+  memcpy(entry_data, &header, LogHeader::SIZE);
+  memcpy(entry_data + LogHeader::SIZE, data.data(), data.size());
+
+  published_[lsn % MAX_PENDING_ENTRIES].store(lsn, std::memory_order_release);
   return RC::SUCCESS;
 }
 
@@ -63,38 +117,85 @@ RC LogEntryBuffer::flush(LogFileWriter &writer, int &count)
 {
   count = 0;
 
-  while (entry_number() > 0) {
-    LogEntry entry;
-    {
-      lock_guard guard(mutex_);
-      if (entries_.empty()) {
+  RC      rc        = RC::SUCCESS;
+  bool    file_full = false;
+  LSN     lsn       = flushed_lsn_.load() + 1;  // 下一条要写入文件的日志
+  int64_t pos       = flushed_pos_.load();      // 下一条日志的位置，可能需要跳过缓冲区末尾的空间
+  int64_t end_pos   = pos;                      // 已经写入文件的日志的结束位置
+
+  // 缓冲区中连续存放的一段日志，一次写入文件
+  int64_t region_pos       = pos;
+  LSN     region_first_lsn = lsn;
+  auto    write_region     = [&]() -> RC {
+    if (end_pos <= region_pos) {
+      return RC::SUCCESS;
+    }
+    return writer.append(span<const char>(data_at(region_pos), end_pos - region_pos), region_first_lsn, lsn - 1);
+  };
+
+  while (published_[lsn % MAX_PENDING_ENTRIES].load(std::memory_order_acquire) == lsn) {
+    const int64_t tail_size = capacity_ - pos % capacity_;
+
+    LogHeader header;
+    bool      wrap = tail_size < LogHeader::SIZE;
+    if (!wrap) {
+      memcpy(&header, data_at(pos), LogHeader::SIZE);
+      wrap = header.size < 0;
+    }
+
+    if (wrap) {
+      rc = write_region();
+      if (OB_FAIL(rc)) {
         break;
       }
-
-      LogEntry &front_entry = entries_.front();
-      ASSERT(front_entry.lsn() > 0 && front_entry.payload_size() > 0, "invalid log entry");
-      entry = std::move(entries_.front());
-      ASSERT(entry.payload_size() > 0 && entry.lsn() > 0, "invalid log entry");
-      entries_.pop_front();
-      bytes_ -= entry.total_size();
+      pos += tail_size;
+      region_pos       = pos;
+      region_first_lsn = lsn;
+      continue;
     }
 
-    RC rc = writer.write(entry);
-    if (OB_FAIL(rc)) {
-      lock_guard guard(mutex_);
-      entries_.emplace_front(std::move(entry));
-      LogEntry &front_entry = entries_.front();
-      ASSERT(front_entry.lsn() > 0 && front_entry.payload_size() > 0, "invalid log entry");
-      return rc;
-    } else {
-      ++count;
-      flushed_lsn_ = entry.lsn();
+    ASSERT(header.lsn == lsn, "invalid log entry. expect lsn=%ld, header=%s", lsn, header.to_string().c_str());
+    if (lsn > writer.end_lsn()) {
+      file_full = true;
+      break;
     }
+
+    pos += LogHeader::SIZE + header.size;
+    end_pos = pos;
+    lsn++;
+    count++;
   }
 
-  return RC::SUCCESS;
+  if (OB_SUCC(rc)) {
+    rc = write_region();
+  }
+  if (OB_SUCC(rc) && count > 0) {
+    rc = writer.sync();
+  }
+  if (OB_FAIL(rc)) {
+    // 写入失败的日志还在缓冲区中，下次重新写入
+    LOG_WARN("failed to flush log entries. lsn=[%ld, %ld], rc=%s", flushed_lsn_.load() + 1, lsn - 1, strrc(rc));
+    count = 0;
+    return rc;
+  }
+
+  if (count > 0) {
+    flushed_lsn_.store(lsn - 1);
+    flushed_pos_.store(end_pos);
+
+    lock_guard guard(mutex_);
+    space_cond_.notify_all();
+  }
+
+  return file_full ? RC::LOG_FILE_FULL : RC::SUCCESS;
+}
+
+bool LogEntryBuffer::flushable() const
+{
+  const LSN lsn = flushed_lsn_.load() + 1;
+  return published_[lsn % MAX_PENDING_ENTRIES].load(std::memory_order_acquire) == lsn;
 }
 
-int64_t LogEntryBuffer::bytes() const { return bytes_.load(); }
+int64_t LogEntryBuffer::bytes() const { return reserved_pos_.load() - flushed_pos_.load(); }
 
-int32_t LogEntryBuffer::entry_number() const { return entries_.size(); }
+int32_t LogEntryBuffer::entry_number() const { return static_cast<int32_t>(current_lsn_.load() - flushed_lsn_.load()); }
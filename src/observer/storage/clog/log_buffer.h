@@ -17,8 +17,9 @@ See the Mulan PSL v2 for more details. */
 #include "common/rc.h"
 #include "common/types.h"
 #include "common/lang/mutex.h"
+#include "common/lang/memory.h"
+#include "common/lang/span.h"
 #include "common/lang/vector.h"
-#include "common/lang/deque.h"
 #include "common/lang/atomic.h"
 #include "storage/clog/log_module.h"
 #include "storage/clog/log_entry.h"
@@ -29,31 +30,53 @@ class LogFileWriter;
  * @brief 日志数据缓冲区
  * @ingroup CLog
  * @details 缓存一部分日志在内存中而不是直接写入磁盘。
- * 这里的缓存没有考虑高性能操作，比如使用预分配内存、环形缓冲池等。
- * 在生产数据库中，通常会使用预分配内存形式的缓存来提高性能，并且可以减少内存碎片。
+ * 缓冲区是一块预先分配好的环形内存，日志按照写入文件的格式(日志头+数据)依次存放。
+ * 追加日志时只在很短的临界区中分配LSN和存放的位置，然后在锁外把数据直接复制到缓冲区中，
+ * 复制完成后在 published_ 中发布这条日志。刷盘时从上次刷到的位置开始，找到连续的已经发布的日志，
+ * 把它们在缓冲区中占用的连续内存一次写入文件。
+ * 缓冲区的末尾放不下一条日志时会跳过末尾剩下的空间，从头开始存放，跳过的部分不会写入文件。
+ * 缓冲区满了时，追加日志的线程在条件变量上等待刷盘释放空间。
  */
 class LogEntryBuffer
 {
 public:
-  LogEntryBuffer()  = default;
+  /// 最多有多少条已经分配了LSN但是还没有刷盘的日志
+  static constexpr int32_t MAX_PENDING_ENTRIES = 64 * 1024;
+
+public:
+  LogEntryBuffer();
   ~LogEntryBuffer() = default;
 
+  /**
+   * @brief 初始化缓冲区
+   * @details 构造时已经按照默认值初始化，可以直接使用
+   * @param lsn 当前最大的LSN
+   * @param max_bytes 缓冲区的大小。为了总能放下最大的日志，至少是最大日志大小的两倍
+   */
   RC init(LSN lsn, int32_t max_bytes = 0);
 
   /**
    * @brief 在缓冲区中追加一条日志
+   * @details 缓冲区没有足够的空间时会一直等待
    */
   RC append(LSN &lsn, LogModule::Id module_id, vector<char> &&data);
   RC append(LSN &lsn, LogModule module, vector<char> &&data);
+  RC append(LSN &lsn, LogModule module, span<const char> data);
 
   /**
    * @brief 刷新缓冲区中的日志到磁盘
-   *
+   * @details 把所有已经发布的日志都写入文件，最后只刷一次盘(组提交)。
+   * 当前文件写满时停下来，返回 RC::LOG_FILE_FULL
    * @param file_handle 使用它来写文件
    * @param count 刷了多少条日志
    */
   RC flush(LogFileWriter &file_writer, int &count);
 
+  /**
+   * @brief 下一条需要刷盘的日志是否已经复制完成，可以刷盘
+   */
+  bool flushable() const;
+
   /**
    * @brief 当前缓冲区中有多少字节的日志
    */
@@ -68,12 +91,24 @@ public:
   LSN flushed_lsn() const { return flushed_lsn_.load(); }
 
 private:
-  mutex           mutex_;    /// 当前数据结构一定会在多线程中访问，所以强制使用有效的锁，而不是有条件生效的common::Mutex
-  deque<LogEntry> entries_;  /// 日志缓冲区
-  atomic<int64_t> bytes_;    /// 当前缓冲区中的日志数据大小
+  /**
+   * @brief 把缓冲区中的逻辑位置转换成内存位置
+   * @details 逻辑位置从0开始一直增长，不会回绕，方便计算缓冲区中已经使用的空间
+   */
+  char *data_at(int64_t pos) const { return buffer_.get() + pos % capacity_; }
+
+private:
+  mutex              mutex_;       /// 分配LSN和存放位置时使用
+  condition_variable space_cond_;  /// 等待缓冲区中有足够的空间
+
+  unique_ptr<char[]>        buffer_;           /// 环形缓冲区
+  int64_t                   capacity_ = 0;     /// 缓冲区大小
+  unique_ptr<atomic<LSN>[]> published_;        /// 复制完成的日志，下标是LSN对 MAX_PENDING_ENTRIES 取模
+  atomic<int64_t>           reserved_pos_{0};  /// 已经分配出去的位置
+  atomic<int64_t>           flushed_pos_{0};   /// 已经刷盘的位置，它之前的空间可以重新使用
 
   atomic<LSN> current_lsn_{0};
   atomic<LSN> flushed_lsn_{0};
 
-  int32_t max_bytes_ = 4 * 1024 * 1024;  /// 缓冲区最大字节数
+  int32_t max_bytes_ = 8 * 1024 * 1024;  /// 缓冲区最大字节数
 };
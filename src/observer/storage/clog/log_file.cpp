@@ -152,7 +152,8 @@ RC LogFileWriter::open(const char *filename, int end_lsn)
   filename_ = filename;
   end_lsn_  = end_lsn;
 
-  fd_ = ::open(filename, O_WRONLY | O_APPEND | O_CREAT | O_SYNC, 0644);
+  // 不使用 O_SYNC，每次写入都落盘的代价太大。由 sync 在一批日志写完之后统一刷盘
+  fd_ = ::open(filename, O_WRONLY | O_APPEND | O_CREAT, 0644);
   if (fd_ < 0) {
     LOG_WARN("open file failed. filename=%s, error=%s", filename, strerror(errno));
     return RC::FILE_OPEN;
@@ -168,12 +169,26 @@ RC LogFileWriter::close()
     return RC::FILE_NOT_OPENED;
   }
 
+  RC rc = sync();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to sync log file before close. filename=%s, rc=%s", filename_.c_str(), strrc(rc));
+  }
+
   ::close(fd_);
   fd_ = -1;
-  return RC::SUCCESS;
+  return rc;
 }
 
 RC LogFileWriter::write(LogEntry &entry)
+{
+  RC rc = append(entry);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+  return sync();
+}
+
+RC LogFileWriter::append(const LogEntry &entry)
 {
   // 一个日志文件写的日志条数是有限制的
   if (entry.lsn() > end_lsn_) {
@@ -193,21 +208,69 @@ RC LogFileWriter::write(LogEntry &entry)
   /// WARNING 这里需要处理日志写一半的情况
   /// 日志只写成功一部分到文件中非常难处理
   int ret = writen(fd_, reinterpret_cast<const char *>(&entry.header()), LogHeader::SIZE);
+  if (0 == ret) {
+    ret = writen(fd_, entry.data(), entry.payload_size());
+  }
   if (0 != ret) {
-    LOG_WARN("write log entry header failed. filename=%s, ret = %d, error=%s, entry=%s", 
-             filename_.c_str(), ret, strerror(errno), entry.to_string().c_str());
+    LOG_WARN("write log entry failed. filename=%s, ret = %d, error=%s, entry=%s", 
+             filename_.c_str(), ret, strerror(ret), entry.to_string().c_str());
+    last_lsn_ = synced_lsn_;
     return RC::IOERR_WRITE;
   }
 
-  ret = writen(fd_, entry.data(), entry.payload_size());
+  last_lsn_ = entry.lsn();
+  LOG_TRACE("write log entry success. filename=%s, entry=%s", filename_.c_str(), entry.to_string().c_str());
+  return RC::SUCCESS;
+}
+
+RC LogFileWriter::append(span<const char> data, LSN first_lsn, LSN last_lsn)
+{
+  if (last_lsn > end_lsn_) {
+    return RC::LOG_FILE_FULL;
+  }
+
+  if (fd_ < 0) {
+    return RC::FILE_NOT_OPENED;
+  }
+
+  if (first_lsn <= last_lsn_ || first_lsn > last_lsn) {
+    LOG_WARN("write log entries failed. invalid lsn. filename=%s, last_lsn=%d, lsn=[%ld, %ld]", 
+             filename_.c_str(), last_lsn_, first_lsn, last_lsn);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  int ret = writen(fd_, data.data(), static_cast<int>(data.size()));
   if (0 != ret) {
-    LOG_WARN("write log entry payload failed. filename=%s, ret = %d, error=%s, entry=%s", 
-             filename_.c_str(), ret, strerror(errno), entry.to_string().c_str());
+    LOG_WARN("write log entries failed. filename=%s, size=%d, lsn=[%ld, %ld], ret=%d, error=%s",
+             filename_.c_str(), static_cast<int>(data.size()), first_lsn, last_lsn, ret, strerror(ret));
+    last_lsn_ = synced_lsn_;
     return RC::IOERR_WRITE;
   }
 
-  last_lsn_ = entry.lsn();
-  LOG_TRACE("write log entry success. filename=%s, entry=%s", filename_.c_str(), entry.to_string().c_str());
+  last_lsn_ = last_lsn;
+  LOG_TRACE("write log entries success. filename=%s, size=%d, lsn=[%ld, %ld]",
+            filename_.c_str(), static_cast<int>(data.size()), first_lsn, last_lsn);
+  return RC::SUCCESS;
+}
+
+RC LogFileWriter::sync()
+{
+  if (last_lsn_ == synced_lsn_) {
+    return RC::SUCCESS;
+  }
+
+  if (fd_ < 0) {
+    return RC::FILE_NOT_OPENED;
+  }
+
+  if (0 != ::fsync(fd_)) {
+    LOG_WARN("sync log file failed. filename=%s, last_lsn=%d, error=%s", filename_.c_str(), last_lsn_, strerror(errno));
+    last_lsn_ = synced_lsn_;
+    return RC::IOERR_SYNC;
+  }
+
+  LOG_TRACE("sync log file success. filename=%s, lsn=(%d, %d]", filename_.c_str(), synced_lsn_, last_lsn_);
+  synced_lsn_ = last_lsn_;
   return RC::SUCCESS;
 }
 
@@ -287,6 +350,8 @@ RC LogFileManager::list_files(vector<string> &files, LSN start_lsn)
 {
   files.clear();
 
+  lock_guard guard(lock_);
+
   // 这里的代码是AI自动生成的
   // 其实写的不好，我们只需要找到比start_lsn相等或者小的第一个日志文件就可以了
   for (auto &file : log_files_) {
@@ -300,7 +365,9 @@ RC LogFileManager::list_files(vector<string> &files, LSN start_lsn)
 
 RC LogFileManager::last_file(LogFileWriter &file_writer)
 {
+  unique_lock guard(lock_);
   if (log_files_.empty()) {
+    guard.unlock();
     return next_file(file_writer);
   }
 
@@ -314,6 +381,8 @@ RC LogFileManager::next_file(LogFileWriter &file_writer)
 {
   file_writer.close();
 
+  lock_guard guard(lock_);
+
   LSN lsn = 0;
   if (!log_files_.empty()) {
     lsn = log_files_.rbegin()->first + max_entry_number_per_file_;
@@ -325,3 +394,28 @@ RC LogFileManager::next_file(LogFileWriter &file_writer)
 
   return file_writer.open(file_path.c_str(), lsn + max_entry_number_per_file_ - 1);
 }
+
+RC LogFileManager::remove_files_before(LSN lsn, int &removed_count)
+{
+  removed_count = 0;
+
+  lock_guard guard(lock_);
+  while (log_files_.size() > 1) {
+    auto iter = log_files_.begin();
+    if (iter->first + max_entry_number_per_file_ - 1 >= lsn) {
+      break;
+    }
+
+    error_code ec;
+    filesystem::remove(iter->second, ec);
+    if (ec) {
+      LOG_WARN("failed to remove log file. file=%s, error=%s", iter->second.c_str(), ec.message().c_str());
+      return RC::IOERR_WRITE;
+    }
+
+    LOG_INFO("remove log file before check point. file=%s, check point lsn=%ld", iter->second.c_str(), lsn);
+    log_files_.erase(iter);
+    removed_count++;
+  }
+  return RC::SUCCESS;
+}
@@ -17,9 +17,11 @@ See the Mulan PSL v2 for more details. */
 #include "common/rc.h"
 #include "common/types.h"
 #include "common/lang/map.h"
+#include "common/lang/mutex.h"
 #include "common/lang/functional.h"
 #include "common/lang/filesystem.h"
 #include "common/lang/fstream.h"
+#include "common/lang/span.h"
 #include "common/lang/string.h"
 
 class LogEntry;
@@ -73,9 +75,31 @@ public:
   /// @brief 关闭当前文件
   RC close();
 
-  /// @brief 写入一条日志
+  /// @brief 写入一条日志，返回时日志已经落盘
   RC write(LogEntry &entry);
 
+  /**
+   * @brief 写入一条日志，调用 sync 时才会落盘
+   * @return RC::LOG_FILE_FULL 当前文件不能再写入这条日志
+   */
+  RC append(const LogEntry &entry);
+
+  /**
+   * @brief 写入一段连续的日志，调用 sync 时才会落盘
+   * @details 组提交时把缓冲区中连续存放的一批日志一次写入文件
+   * @param data 按照文件格式存放的日志，也就是日志头和数据依次排列
+   * @param first_lsn 第一条日志的LSN
+   * @param last_lsn 最后一条日志的LSN
+   * @return RC::LOG_FILE_FULL 当前文件不能再写入这些日志
+   */
+  RC append(span<const char> data, LSN first_lsn, LSN last_lsn);
+
+  /**
+   * @brief 把写入的日志刷盘
+   * @details 失败时写入的日志都不算数，调用者需要重新写入
+   */
+  RC sync();
+
   /**
    * @brief 当前文件是否已经打开
    */
@@ -90,11 +114,15 @@ public:
 
   const char *filename() const { return filename_.c_str(); }
 
+  /// @brief 当前文件允许写入的最大的LSN
+  LSN end_lsn() const { return end_lsn_; }
+
 private:
-  string filename_;       /// 日志文件名
-  int    fd_       = -1;  /// 日志文件描述符
-  int    last_lsn_ = 0;   /// 写入的最后一条日志LSN
-  int    end_lsn_  = 0;   /// 当前日志文件中允许写入的最大的LSN，包括这条日志
+  string filename_;         /// 日志文件名
+  int    fd_         = -1;  /// 日志文件描述符
+  int    last_lsn_   = 0;   /// 写入的最后一条日志LSN，包括还没有落盘的日志
+  int    synced_lsn_ = 0;   /// 已经落盘的最后一条日志LSN
+  int    end_lsn_    = 0;   /// 当前日志文件中允许写入的最大的LSN，包括这条日志
 };
 
 /**
@@ -137,6 +165,15 @@ public:
    */
   RC next_file(LogFileWriter &file_writer);
 
+  /**
+   * @brief 删除不再需要的日志文件
+   * @details 检查点之前的日志在恢复时不会再用到。文件中所有日志的LSN都比 lsn 小时才删除，
+   * 最后一个日志文件还在写入，不会删除
+   * @param lsn 检查点的LSN，这个LSN以及之后的日志需要保留
+   * @param removed_count 删除的文件个数
+   */
+  RC remove_files_before(LSN lsn, int &removed_count);
+
 private:
   /**
    * @brief 从文件名称中获取LSN
@@ -151,5 +188,6 @@ private:
   filesystem::path directory_;                  /// 日志文件存放的目录
   int              max_entry_number_per_file_;  /// 一个文件最大允许存放多少条日志
 
+  mutex                      lock_;       /// 保护 log_files_，删除文件与后台刷日志的线程同时进行
   map<LSN, filesystem::path> log_files_;  /// 日志文件名和第一个LSN的映射
 };
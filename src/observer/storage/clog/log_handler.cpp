@@ -15,19 +15,33 @@ See the Mulan PSL v2 for more details. */
 #include <string.h>
 
 #include "storage/clog/log_handler.h"
+#include "common/lang/algorithm.h"
 #include "common/lang/string.h"
+#include "common/lang/thread.h"
 #include "storage/clog/disk_log_handler.h"
 #include "storage/clog/vacuous_log_handler.h"
 
 RC LogHandler::append(LSN &lsn, LogModule::Id module, span<const char> data)
 {
-  vector<char> data_vec(data.begin(), data.end());
-  return append(lsn, module, std::move(data_vec));
+  return _append(lsn, LogModule(module), data);
 }
 
 RC LogHandler::append(LSN &lsn, LogModule::Id module, vector<char> &&data)
 {
-  return _append(lsn, LogModule(module), std::move(data));
+  return _append(lsn, LogModule(module), span<const char>(data.data(), data.size()));
+}
+
+LSN LogHandler::stable_lsn()
+{
+  // 先取当前LSN再看槽位。没有看到的登记发生在读取这个槽位之后，它之后写的日志LSN都比这里取到的大
+  LSN lsn = current_lsn();
+  for (const PendingSlot &slot : pending_slots_) {
+    const LSN pending_lsn = slot.lsn.load();
+    if (pending_lsn != FREE_SLOT_LSN && pending_lsn < lsn) {
+      lsn = pending_lsn;
+    }
+  }
+  return lsn;
 }
 
 RC LogHandler::create(const char *name, LogHandler *&log_handler)
@@ -44,4 +58,30 @@ RC LogHandler::create(const char *name, LogHandler *&log_handler)
     return RC::INVALID_ARGUMENT;
   }
   return RC::SUCCESS;
-}
\ No newline at end of file
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LogLsnGuard::LogLsnGuard(LogHandler &log_handler)
+{
+  // 每个线程从自己的槽位开始找，一般不会与其它线程竞争同一个槽位
+  static atomic<int> next_slot_index{0};
+  thread_local int   slot_index = next_slot_index.fetch_add(1) % LogHandler::PENDING_SLOT_NUM;
+
+  // 登记之后分配的LSN都比登记的LSN大
+  for (int i = 0;; i++) {
+    atomic<LSN> &slot = log_handler.pending_slots_[(slot_index + i) % LogHandler::PENDING_SLOT_NUM].lsn;
+
+    LSN expected = LogHandler::FREE_SLOT_LSN;
+    if (slot.load() == expected && slot.compare_exchange_strong(expected, log_handler.current_lsn())) {
+      slot_ = &slot;
+      break;
+    }
+
+    // 所有槽位都被占用了
+    if (i > 0 && i % LogHandler::PENDING_SLOT_NUM == 0) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+LogLsnGuard::~LogLsnGuard() { slot_->store(LogHandler::FREE_SLOT_LSN); }
@@ -18,6 +18,7 @@ See the Mulan PSL v2 for more details. */
 #include "common/types.h"
 #include "common/lang/functional.h"
 #include "common/lang/memory.h"
+#include "common/lang/atomic.h"
 #include "common/lang/span.h"
 #include "common/lang/vector.h"
 #include "storage/clog/log_module.h"
@@ -96,12 +97,61 @@ public:
 
   virtual LSN current_lsn() const = 0;
 
+  /**
+   * @brief 检查点最多可以推进到哪个LSN
+   * @details 修改页面时先写日志，之后才把LSN设置到页帧上，这期间页帧上还看不到这条日志。
+   * 写日志之前用 LogLsnGuard 登记，这里返回当前LSN和所有登记过的LSN中最小的一个。
+   */
+  LSN stable_lsn();
+
+  /**
+   * @brief 删除检查点之前的日志
+   * @details 检查点之前的日志在恢复时不会再用到，删除之后可以减少磁盘占用
+   * @param lsn 检查点的LSN，这个LSN以及之后的日志需要保留
+   */
+  virtual RC truncate(LSN lsn) = 0;
+
   static RC create(const char *name, LogHandler *&handler);
 
 private:
   /**
    * @brief 写入一条日志
-   * @details 子类应该重现实现这个函数
+   * @details 子类应该重现实现这个函数。返回之后就不能再访问data，需要的话要复制一份
+   */
+  virtual RC _append(LSN &lsn, LogModule module, span<const char> data) = 0;
+
+private:
+  friend class LogLsnGuard;
+
+  /// 登记LSN的槽位个数。同时写日志的线程比这个多时，登记需要等待其它线程取消登记
+  static constexpr int PENDING_SLOT_NUM = 64;
+  static constexpr LSN FREE_SLOT_LSN    = -1;
+
+  /**
+   * @brief 登记LSN的槽位，每个槽位独占一个cache line，写日志的线程之间不会互相干扰
    */
-  virtual RC _append(LSN &lsn, LogModule module, vector<char> &&data) = 0;
+  struct alignas(64) PendingSlot
+  {
+    atomic<LSN> lsn{FREE_SLOT_LSN};  ///< 已经登记、还没有记录到页帧或事务上的日志，都比这里的LSN大
+  };
+
+  PendingSlot pending_slots_[PENDING_SLOT_NUM];
+};
+
+/**
+ * @brief 登记一条正在写的日志，从写日志之前一直到日志的LSN记录到页帧(或者事务)上
+ * @ingroup CLog
+ * @details 析构时取消登记。见 LogHandler::stable_lsn
+ */
+class LogLsnGuard
+{
+public:
+  explicit LogLsnGuard(LogHandler &log_handler);
+  ~LogLsnGuard();
+
+  LogLsnGuard(const LogLsnGuard &)            = delete;
+  LogLsnGuard &operator=(const LogLsnGuard &) = delete;
+
+private:
+  atomic<LSN> *slot_ = nullptr;
 };
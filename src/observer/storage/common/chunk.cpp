@@ -10,6 +10,16 @@ See the Mulan PSL v2 for more details. */
 
 #include "storage/common/chunk.h"
 
+Column *Chunk::column_by_id(int col_id)
+{
+  for (size_t i = 0; i < column_ids_.size(); i++) {
+    if (column_ids_[i] == col_id) {
+      return columns_[i].get();
+    }
+  }
+  return nullptr;
+}
+
 void Chunk::add_column(unique_ptr<Column> col, int col_id)
 {
   columns_.push_back(std::move(col));
@@ -27,9 +37,42 @@ RC Chunk::reference(Chunk &chunk)
     columns_[i]->reference(chunk.column(i));
     column_ids_.push_back(chunk.column_ids(i));
   }
+  copy_selection(chunk);
   return RC::SUCCESS;
 }
 
+int Chunk::set_selection(const vector<uint8_t> &select)
+{
+  const int rows = this->rows();
+  selection_.resize(rows);
+
+  // 无分支地写入行号，有效的行才移动写入位置
+  int count = 0;
+  for (int i = 0; i < rows; i++) {
+    selection_[count] = i;
+    count += select[i] != 0 ? 1 : 0;
+  }
+
+  selection_.resize(count);
+  has_selection_ = count < rows;
+  if (!has_selection_) {
+    selection_.clear();
+  }
+  return count;
+}
+
+void Chunk::copy_selection(const Chunk &chunk)
+{
+  has_selection_ = chunk.has_selection_;
+  selection_     = chunk.selection_;
+}
+
+void Chunk::clear_selection()
+{
+  has_selection_ = false;
+  selection_.clear();
+}
+
 int Chunk::rows() const
 {
   if (!columns_.empty()) {
@@ -51,10 +94,12 @@ void Chunk::reset_data()
   for (auto &col : columns_) {
     col->reset_data();
   }
+  clear_selection();
 }
 
 void Chunk::reset()
 {
   columns_.clear();
   column_ids_.clear();
+  clear_selection();
 }
\ No newline at end of file
@@ -46,6 +46,13 @@ public:
     return column_ids_[i];
   }
 
+  /**
+   * @brief 按照列的 id 查找列
+   * @details 表扫描输出的 Chunk 只包含查询用到的字段，列的 id 是字段的 field_id，不能再用 field_id 作为下标
+   * @return 没有这一列时返回 nullptr
+   */
+  Column *column_by_id(int col_id);
+
   void add_column(unique_ptr<Column> col, int col_id);
 
   RC reference(Chunk &chunk);
@@ -60,6 +67,42 @@ public:
    */
   int capacity() const;
 
+  /**
+   * @brief 根据过滤结果设置选择向量
+   * @details 过滤之后不再复制数据，只记录哪些行有效，下游算子按照选择向量访问 Chunk 中的行，
+   * 需要连续的数据时再用 Column::append_selected 按列收集。所有行都有效时不设置选择向量。
+   * @param select 每行一个字节，非0表示这一行有效
+   * @return 有效的行数
+   */
+  int set_selection(const vector<uint8_t> &select);
+
+  /**
+   * @brief 复制另一个 Chunk 的选择向量，用于按行计算出来的新 Chunk
+   */
+  void copy_selection(const Chunk &chunk);
+
+  void clear_selection();
+
+  /**
+   * @brief 是否有选择向量。没有选择向量时所有行都有效
+   */
+  bool has_selection() const { return has_selection_; }
+
+  /**
+   * @brief 有效的行号，行号是递增的。没有选择向量时为空
+   */
+  const vector<int> &selection() const { return selection_; }
+
+  /**
+   * @brief 有效的行数
+   */
+  int selected_rows() const { return has_selection_ ? static_cast<int>(selection_.size()) : rows(); }
+
+  /**
+   * @brief 第 i 个有效行在 Column 中的行号
+   */
+  int row_index(int i) const { return has_selection_ ? selection_[i] : i; }
+
   /**
    * @brief 从 Chunk 中获得指定行指定列的 Value
    * @param col_idx 列索引
@@ -82,4 +125,7 @@ private:
   // TODO: remove it and support multi-tables,
   // `columnd_ids` store the ids of child operator that need to be output
   vector<int> column_ids_;
+
+  bool        has_selection_ = false;
+  vector<int> selection_;
 };
\ No newline at end of file
@@ -11,79 +11,91 @@ See the Mulan PSL v2 for more details. */
 #include "common/log/log.h"
 #include "storage/common/column.h"
 
-Column::Column(const FieldMeta &meta, size_t size)
-    : data_(nullptr),
-      count_(0),
-      capacity_(0),
-      own_(true),
-      attr_type_(meta.type()),
-      attr_len_(meta.len()),
-      column_type_(Type::NORMAL_COLUMN)
-{
-  // TODO: optimized the memory usage if it doesn't need to allocate memory
-  data_     = new char[size * attr_len_];
-  capacity_ = size;
-}
+Column::Column(const FieldMeta &meta, size_t size) { init(meta, size); }
 
-Column::Column(AttrType attr_type, int attr_len, size_t capacity)
+Column::Column(AttrType attr_type, int attr_len, size_t capacity, bool nullable)
 {
-  attr_type_   = attr_type;
-  attr_len_    = attr_len;
-  data_        = new char[capacity * attr_len_];
-  count_       = 0;
-  capacity_    = capacity;
-  own_         = true;
-  column_type_ = Type::NORMAL_COLUMN;
+  init(attr_type, attr_len, capacity, nullable);
 }
 
 void Column::init(const FieldMeta &meta, size_t size)
 {
-  reset();
-  data_        = new char[size * meta.len()];
-  count_       = 0;
-  capacity_    = size;
-  attr_type_   = meta.type();
-  attr_len_    = meta.len();
-  own_         = true;
-  column_type_ = Type::NORMAL_COLUMN;
+  // 记录中可以为 NULL 的字段最后有一个字节的 NULL 标记，列值不包含这个字节
+  init(meta.type(), meta.nullable() ? meta.len() - 1 : meta.len(), size, meta.nullable());
 }
 
-void Column::init(AttrType attr_type, int attr_len, size_t capacity)
+void Column::init(AttrType attr_type, int attr_len, size_t capacity, bool nullable)
 {
   reset();
-  data_        = new char[capacity * attr_len];
-  count_       = 0;
-  capacity_    = capacity;
-  own_         = true;
   attr_type_   = attr_type;
   attr_len_    = attr_len;
+  nullable_    = nullable;
+  var_len_     = is_var_len(attr_type, attr_len);
   column_type_ = Type::NORMAL_COLUMN;
+  alloc(capacity);
 }
 
 void Column::init(const Value &value)
 {
   reset();
-  attr_type_ = value.attr_type();
-  attr_len_  = value.length();
-  data_      = new char[attr_len_];
-  count_     = 1;
-  capacity_  = 1;
-  own_       = true;
-  memcpy(data_, value.data(), attr_len_);
+  attr_type_   = value.attr_type();
+  attr_len_    = value.length();
+  nullable_    = value.is_null();
   column_type_ = Type::CONSTANT_COLUMN;
+  alloc(1);
+  if (value.is_null()) {
+    set_null_bits(0, 1, true);
+    null_count_ = 1;
+  } else {
+    memcpy(data_, value.data(), attr_len_);
+  }
+  count_ = 1;
+}
+
+void Column::alloc(size_t capacity)
+{
+  if (var_len_) {
+    // 先按照每个字符串不超过 16 字节分配，不够时再扩展
+    offsets_       = new uint32_t[capacity + 1];
+    offsets_[0]    = 0;
+    heap_capacity_ = std::max(capacity * std::min(attr_len_, 16), static_cast<size_t>(1));
+    heap_          = new char[heap_capacity_];
+    heap_size_     = 0;
+  } else {
+    // TODO: optimized the memory usage if it doesn't need to allocate memory
+    data_ = new char[std::max(capacity * attr_len_, static_cast<size_t>(1))];
+  }
+  count_    = 0;
+  capacity_ = capacity;
+  own_      = true;
+  if (nullable_) {
+    null_bitmap_ = new char[(capacity + 7) / 8]();
+  }
+  null_count_ = 0;
 }
 
 void Column::reset()
 {
-  if (data_ != nullptr && own_) {
+  if (own_) {
     delete[] data_;
+    delete[] null_bitmap_;
+    delete[] offsets_;
+    delete[] heap_;
   }
-  data_      = nullptr;
-  count_     = 0;
-  capacity_  = 0;
-  own_       = false;
-  attr_type_ = AttrType::UNDEFINED;
-  attr_len_  = -1;
+  data_          = nullptr;
+  null_bitmap_   = nullptr;
+  offsets_       = nullptr;
+  heap_          = nullptr;
+  heap_size_     = 0;
+  heap_capacity_ = 0;
+  count_         = 0;
+  capacity_      = 0;
+  own_           = false;
+  attr_type_     = AttrType::UNDEFINED;
+  attr_len_      = -1;
+  nullable_      = false;
+  null_count_    = 0;
+  var_len_       = false;
 }
 
 RC Column::append_one(char *data) { return append(data, 1); }
@@ -99,7 +111,236 @@ RC Column::append(char *data, int count)
     return RC::INTERNAL;
   }
 
-  memcpy(data_ + count_ * attr_len_, data, count * attr_len_);
+  if (var_len_) {
+    for (int i = 0; i < count; i++) {
+      const char *str = data + static_cast<size_t>(i) * attr_len_;
+      put_string(count_ + i, str, strnlen(str, attr_len_));
+    }
+  } else {
+    memcpy(data_ + count_ * attr_len_, data, count * attr_len_);
+  }
+  if (nullable_) {
+    set_null_bits(count_, count, false);
+  }
+  count_ += count;
+  return RC::SUCCESS;
+}
+
+namespace {
+template <int LEN>
+void copy_field_values(char *dst, const char *src, int count)
+{
+  for (int i = 0; i < count; i++) {
+    memcpy(dst + i * LEN, src + i * (LEN + 1), LEN);
+  }
+}
+}  // namespace
+
+RC Column::append_field_data(const char *data, int count)
+{
+  if (!nullable_) {
+    return append(const_cast<char *>(data), count);
+  }
+  if (!own_) {
+    LOG_WARN("append data to non-owned column");
+    return RC::INTERNAL;
+  }
+  if (count_ + count > capacity_) {
+    LOG_WARN("append data to full column");
+    return RC::INTERNAL;
+  }
+
+  const int field_len = attr_len_ + 1;
+  if (var_len_) {
+    // NULL 行是空字符串
+    for (int i = 0; i < count; i++) {
+      const char *field = data + static_cast<size_t>(i) * field_len;
+      put_string(count_ + i, field, field[attr_len_] == '1' ? 0 : strnlen(field, attr_len_));
+    }
+  } else if (attr_len_ == 4) {
+    copy_field_values<4>(data_ + static_cast<size_t>(count_) * attr_len_, data, count);
+  } else {
+    char *dst = data_ + static_cast<size_t>(count_) * attr_len_;
+    for (int i = 0; i < count; i++) {
+      memcpy(dst + static_cast<size_t>(i) * attr_len_, data + static_cast<size_t>(i) * field_len, attr_len_);
+    }
+  }
+
+  for (int i = 0; i < count; i++) {
+    const bool is_null = data[static_cast<size_t>(i) * field_len + attr_len_] == '1';
+    set_null_bits(count_ + i, 1, is_null);
+    null_count_ += is_null ? 1 : 0;
+  }
+  count_ += count;
+  return RC::SUCCESS;
+}
+
+RC Column::append_null()
+{
+  if (!nullable_) {
+    LOG_WARN("append null to not nullable column");
+    return RC::INTERNAL;
+  }
+  if (!own_) {
+    LOG_WARN("append data to non-owned column");
+    return RC::INTERNAL;
+  }
+  if (count_ + 1 > capacity_) {
+    LOG_WARN("append data to full column");
+    return RC::INTERNAL;
+  }
+
+  if (var_len_) {
+    offsets_[count_ + 1] = offsets_[count_];
+  } else {
+    memset(data_ + static_cast<size_t>(count_) * attr_len_, 0, attr_len_);
+  }
+  set_null_bits(count_, 1, true);
+  null_count_++;
+  count_++;
+  return RC::SUCCESS;
+}
+
+RC Column::append_string(const char *str, int len)
+{
+  if (!own_) {
+    LOG_WARN("append data to non-owned column");
+    return RC::INTERNAL;
+  }
+  if (count_ + 1 > capacity_) {
+    LOG_WARN("append data to full column");
+    return RC::INTERNAL;
+  }
+
+  put_string(count_, str, len);
+  if (nullable_) {
+    set_null_bits(count_, 1, false);
+  }
+  count_++;
+  return RC::SUCCESS;
+}
+
+void Column::put_string(int index, const char *str, int len)
+{
+  if (var_len_) {
+    len = std::min(len, attr_len_);
+    reserve_heap(heap_size_ + len);
+    memcpy(heap_ + heap_size_, str, len);
+    heap_size_ += len;
+    offsets_[index + 1] = static_cast<uint32_t>(heap_size_);
+    return;
+  }
+
+  char *dst = data_ + static_cast<size_t>(index) * attr_len_;
+  len       = std::min(len, attr_len_);
+  memcpy(dst, str, len);
+  memset(dst + len, 0, attr_len_ - len);
+}
+
+void Column::reserve_heap(size_t size)
+{
+  if (size <= heap_capacity_) {
+    return;
+  }
+
+  const size_t new_capacity = std::max(size, heap_capacity_ * 2);
+  char        *new_heap     = new char[new_capacity];
+  memcpy(new_heap, heap_, heap_size_);
+  delete[] heap_;
+  heap_          = new_heap;
+  heap_capacity_ = new_capacity;
+}
+
+void Column::set_null(int index, bool is_null)
+{
+  ASSERT(nullable_ && index < capacity_, "invalid null index. nullable=%d, index=%d", nullable_, index);
+  const bool was_null = (null_bitmap_[index / 8] & (1 << (index % 8))) != 0;
+  if (was_null != is_null) {
+    set_null_bits(index, 1, is_null);
+    null_count_ += is_null ? 1 : -1;
+  }
+}
+
+void Column::set_null_bits(int begin, int count, bool is_null)
+{
+  for (int index = begin; index < begin + count; index++) {
+    if (is_null) {
+      null_bitmap_[index / 8] |= static_cast<char>(1 << (index % 8));
+    } else {
+      null_bitmap_[index / 8] &= static_cast<char>(~(1 << (index % 8)));
+    }
+  }
+}
+
+namespace {
+template <typename T>
+void gather_values(char *dst, const char *src, const int *selection, int count)
+{
+  T       *dst_values = reinterpret_cast<T *>(dst);
+  const T *src_values = reinterpret_cast<const T *>(src);
+  for (int i = 0; i < count; i++) {
+    dst_values[i] = src_values[selection[i]];
+  }
+}
+}  // namespace
+
+RC Column::append_selected(const Column &column, const int *selection, int count)
+{
+  if (!own_) {
+    LOG_WARN("append data to non-owned column");
+    return RC::INTERNAL;
+  }
+  if (count_ + count > capacity_) {
+    LOG_WARN("append data to full column");
+    return RC::INTERNAL;
+  }
+  if (column.attr_len() != attr_len_) {
+    LOG_WARN("column length mismatch. source=%d, target=%d", column.attr_len(), attr_len_);
+    return RC::INTERNAL;
+  }
+  if (column.has_null() && !nullable_) {
+    LOG_WARN("append null values to not nullable column");
+    return RC::INTERNAL;
+  }
+
+  char       *dst = data_ + static_cast<size_t>(count_) * attr_len_;
+  const char *src = column.data();
+  if (var_len_ || column.var_len()) {
+    for (int i = 0; i < count; i++) {
+      int         len = 0;
+      const char *str = column.string_at(selection[i], len);
+      put_string(count_ + i, str, len);
+    }
+  } else if (column.column_type() == Type::CONSTANT_COLUMN) {
+    for (int i = 0; i < count; i++) {
+      memcpy(dst + static_cast<size_t>(i) * attr_len_, src, attr_len_);
+    }
+  } else if (attr_len_ == sizeof(uint32_t) && reinterpret_cast<uintptr_t>(src) % alignof(uint32_t) == 0 &&
+             reinterpret_cast<uintptr_t>(dst) % alignof(uint32_t) == 0) {
+    gather_values<uint32_t>(dst, src, selection, count);
+  } else if (attr_len_ == sizeof(uint64_t) && reinterpret_cast<uintptr_t>(src) % alignof(uint64_t) == 0 &&
+             reinterpret_cast<uintptr_t>(dst) % alignof(uint64_t) == 0) {
+    gather_values<uint64_t>(dst, src, selection, count);
+  } else {
+    for (int i = 0; i < count; i++) {
+      memcpy(dst + static_cast<size_t>(i) * attr_len_, src + static_cast<size_t>(selection[i]) * attr_len_, attr_len_);
+    }
+  }
+
+  if (nullable_) {
+    if (!column.has_null()) {
+      set_null_bits(count_, count, false);
+    } else if (column.column_type() == Type::CONSTANT_COLUMN) {
+      set_null_bits(count_, count, true);
+      null_count_ += count;
+    } else {
+      for (int i = 0; i < count; i++) {
+        const bool is_null = column.is_null(selection[i]);
+        set_null_bits(count_ + i, 1, is_null);
+        null_count_ += is_null ? 1 : 0;
+      }
+    }
+  }
   count_ += count;
   return RC::SUCCESS;
 }
@@ -109,6 +350,18 @@ Value Column::get_value(int index) const
   if (index >= count_ || index < 0) {
     return Value();
   }
+  if (is_null(index)) {
+    Value value;
+    value.set_null();
+    return value;
+  }
+  if (var_len_) {
+    // heap 中的字符串没有结尾的 '\0'
+    int               len = 0;
+    const char       *str = string_at(index, len);
+    const std::string value(str, len);
+    return Value(attr_type_, const_cast<char *>(value.c_str()), len);
+  }
   return Value(attr_type_, &data_[index * attr_len_], attr_len_);
 }
 
@@ -127,4 +380,11 @@ void Column::reference(const Column &column)
   this->column_type_ = column.column_type();
   this->attr_type_   = column.attr_type();
   this->attr_len_    = column.attr_len();
-}
\ No newline at end of file
+  this->nullable_    = column.nullable_;
+  this->null_bitmap_ = column.null_bitmap_;
+  this->null_count_  = column.null_count_;
+  this->var_len_     = column.var_len_;
+  this->offsets_     = column.offsets_;
+  this->heap_        = column.heap_;
+  this->heap_size_   = column.heap_size_;
+}
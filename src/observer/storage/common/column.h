@@ -16,14 +16,19 @@ See the Mulan PSL v2 for more details. */
 
 /**
  * @brief A column contains multiple values in contiguous memory with a specified type.
+ * @details 可以为 NULL 的列用 null 位图记录每一行是否是 NULL。列值中不包含记录里的 NULL 标记字节，
+ * 列值的长度总是类型本身的长度，可以直接当作数组访问。NULL 行的列值是未定义的。
+ *
+ * TEXTS 以及长度超过 VAR_LEN_THRESHOLD 的 CHARS 使用变长的表示：所有的字符串紧挨着放在一块共享的内存(heap)中，
+ * 第 i 行的字符串是 heap[offsets[i], offsets[i+1])，不包含结尾的 '\0'。这样每一行只占用字符串实际的长度，
+ * 而不是字段定义的最大长度。变长列没有 data()，字符串统一通过 string_at 访问，定长的字符串列也可以这样访问。
  */
-// TODO: `Column` currently only support fixed-length type.
 class Column
 {
 public:
   enum class Type
   {
-    NORMAL_COLUMN,   /// Normal column represents a list of fixed-length values
+    NORMAL_COLUMN,   /// Normal column represents a list of values
     CONSTANT_COLUMN  /// Constant column represents a single value
   };
 
@@ -32,10 +37,10 @@ public:
   Column(Column &&)      = delete;
 
   Column(const FieldMeta &meta, size_t size = DEFAULT_CAPACITY);
-  Column(AttrType attr_type, int attr_len, size_t size = DEFAULT_CAPACITY);
+  Column(AttrType attr_type, int attr_len, size_t size = DEFAULT_CAPACITY, bool nullable = false);
 
   void init(const FieldMeta &meta, size_t size = DEFAULT_CAPACITY);
-  void init(AttrType attr_type, int attr_len, size_t size = DEFAULT_CAPACITY);
+  void init(AttrType attr_type, int attr_len, size_t size = DEFAULT_CAPACITY, bool nullable = false);
   void init(const Value &value);
 
   virtual ~Column() { reset(); }
@@ -52,21 +57,121 @@ public:
   RC append(char *data, int count);
 
   /**
-   * @brief 获取 index 位置的列值
+   * @brief 追加记录格式的字段数据
+   * @details 可以为 NULL 的字段在记录中最后有一个字节的 NULL 标记('1' 表示 NULL)，这里拆分成列值和 null 位图。
+   * 不可以为 NULL 的列与 append 相同
+   * @param data 第一个字段的起始地址，相邻字段之间相差 field_len() 个字节
+   * @param count 字段的个数
+   */
+  RC append_field_data(const char *data, int count);
+
+  /**
+   * @brief 追加一个 NULL 值，列必须可以为 NULL
+   */
+  RC append_null();
+
+  /**
+   * @brief 追加一个长度为 len 的字符串，不需要以 '\0' 结尾。定长列超出 attr_len 的部分被截断，不足时补 '\0'
+   */
+  RC append_string(const char *str, int len);
+
+  /**
+   * @brief 按照选择向量从另一个 Column 中收集列值，追加到当前 Column
+   * @details 按列进行收集，定长的 4/8 字节类型按照整数类型逐个赋值，其它长度逐个 memcpy，变长的字符串逐个复制到 heap 中。
+   * 常量列的值会被复制 count 次。
+   * @param column 源 Column，类型长度需要与当前 Column 一致
+   * @param selection 要收集的行号
+   * @param count 行号的个数
+   */
+  RC append_selected(const Column &column, const int *selection, int count);
+
+  /**
+   * @brief 获取 index 位置的列值，NULL 行返回 NULL 值
    */
   Value get_value(int index) const;
 
+  bool nullable() const { return nullable_; }
+
+  /**
+   * @brief 是否有 NULL 行。没有 NULL 行时，计算可以跳过 null 位图
+   */
+  bool has_null() const { return null_count_ > 0; }
+  int  null_count() const { return null_count_; }
+
+  /**
+   * @brief index 位置是否是 NULL。常量列只看第0行
+   */
+  bool is_null(int index) const
+  {
+    if (!nullable_) {
+      return false;
+    }
+    if (column_type_ == Type::CONSTANT_COLUMN) {
+      index = 0;
+    }
+    return (null_bitmap_[index / 8] & (1 << (index % 8))) != 0;
+  }
+
+  /**
+   * @brief 设置 index 位置是否是 NULL，index 必须小于容量。用于计算结果的列
+   */
+  void set_null(int index, bool is_null = true);
+
+  /**
+   * @brief 记录中字段的长度，可以为 NULL 时多一个字节的 NULL 标记
+   */
+  int field_len() const { return nullable_ ? attr_len_ + 1 : attr_len_; }
+
+  /**
+   * @brief 是否是变长列
+   */
+  bool var_len() const { return var_len_; }
+
+  /**
+   * @brief 这种类型和长度的列是否使用变长的表示
+   */
+  static bool is_var_len(AttrType attr_type, int attr_len)
+  {
+    return attr_type == AttrType::TEXTS || (attr_type == AttrType::CHARS && attr_len > VAR_LEN_THRESHOLD);
+  }
+
+  /**
+   * @brief 第 index 行的字符串，通过 len 返回长度。常量列只有第0行
+   * @details 定长列的字符串不足长度时以 '\0' 结尾，长度是结尾之前的部分
+   */
+  const char *string_at(int index, int &len) const
+  {
+    if (column_type_ == Type::CONSTANT_COLUMN) {
+      index = 0;
+    }
+    if (var_len_) {
+      len = static_cast<int>(offsets_[index + 1] - offsets_[index]);
+      return heap_ + offsets_[index];
+    }
+    const char *str = data_ + static_cast<size_t>(index) * attr_len_;
+    len             = static_cast<int>(strnlen(str, attr_len_));
+    return str;
+  }
+
   /**
    * @brief 获取列数据的实际大小（字节）
    */
-  int data_len() const { return count_ * attr_len_; }
+  int data_len() const { return var_len_ ? static_cast<int>(heap_size_) : count_ * attr_len_; }
 
+  /**
+   * @brief 定长列的数据。变长列没有定长的数据，返回 nullptr
+   */
   char *data() const { return data_; }
 
   /**
    * @brief 重置列数据，但不修改元信息
    */
-  void reset_data() { count_ = 0; }
+  void reset_data()
+  {
+    count_      = 0;
+    null_count_ = 0;
+    heap_size_  = 0;
+  }
 
   /**
    * @brief 引用另一个 Column
@@ -82,9 +187,12 @@ public:
   int      attr_len() const { return attr_len_; }
   Type     column_type() const { return column_type_; }
 
-private:
+public:
   static constexpr size_t DEFAULT_CAPACITY = 8192;
+  /// CHARS 的长度超过这个值时使用变长的表示
+  static constexpr int VAR_LEN_THRESHOLD = 32;
 
+private:
   char *data_ = nullptr;
   /// 当前列值数量
   int count_ = 0;
@@ -94,8 +202,29 @@ private:
   bool own_ = true;
   /// 列属性类型
   AttrType attr_type_ = AttrType::UNDEFINED;
-  /// 列属性类型长度（目前只支持定长）
+  /// 列属性类型长度，变长列是字符串的最大长度
   int attr_len_ = -1;
   /// 列类型
   Type column_type_ = Type::NORMAL_COLUMN;
+  /// 是否可以为 NULL
+  bool nullable_ = false;
+  /// 第 i 位表示第 i 行是否是 NULL，与 data_ 一起分配和引用
+  char *null_bitmap_ = nullptr;
+  /// NULL 行的个数
+  int null_count_ = 0;
+  /// 是否是变长列
+  bool var_len_ = false;
+  /// 变长列每一行字符串在 heap_ 中的起始位置，共 capacity_ + 1 个
+  uint32_t *offsets_ = nullptr;
+  /// 变长列的字符串
+  char  *heap_          = nullptr;
+  size_t heap_size_     = 0;
+  size_t heap_capacity_ = 0;
+
+private:
+  void alloc(size_t capacity);
+  void set_null_bits(int begin, int count, bool is_null);
+  void reserve_heap(size_t size);
+  /// 写入第 index 行的字符串，变长列的 index 必须是下一行。不检查容量，也不修改 null 位图
+  void put_string(int index, const char *str, int len);
 };
\ No newline at end of file
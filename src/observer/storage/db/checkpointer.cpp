@@ -0,0 +1,182 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/18.
+//
+
+#include "storage/db/checkpointer.h"
+
+#include "common/lang/algorithm.h"
+#include "common/lang/chrono.h"
+#include "common/log/log.h"
+#include "common/thread/thread_util.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/buffer/double_write_buffer.h"
+#include "storage/clog/log_handler.h"
+#include "storage/db/db.h"
+#include "storage/trx/trx.h"
+
+Checkpointer::Checkpointer(Db &db) : db_(db) {}
+
+Checkpointer::~Checkpointer() { stop(); }
+
+RC Checkpointer::start(int interval_ms /* = DEFAULT_INTERVAL_MS */)
+{
+  if (interval_ms <= 0) {
+    LOG_WARN("invalid checkpoint interval: %dms", interval_ms);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  if (running_.load()) {
+    LOG_WARN("checkpointer has already been started");
+    return RC::INTERNAL;
+  }
+
+  interval_ms_ = interval_ms;
+
+  running_.store(true);
+#ifdef CONCURRENCY
+  thread_ = make_unique<thread>(&Checkpointer::thread_func, this);
+  LOG_INFO("checkpointer started. db=%s, interval=%dms", db_.name(), interval_ms_);
+#else
+  last_checkpoint_time_ = chrono::steady_clock::now();
+  LOG_INFO("checkpointer started without background thread. db=%s, interval=%dms", db_.name(), interval_ms_);
+#endif
+  return RC::SUCCESS;
+}
+
+void Checkpointer::stop()
+{
+  if (!thread_) {
+    running_.store(false);
+    return;
+  }
+
+  {
+    lock_guard<mutex> guard(thread_lock_);
+    running_.store(false);
+    thread_cond_.notify_all();
+  }
+
+  thread_->join();
+  thread_.reset();
+  LOG_INFO("checkpointer stopped. db=%s, checkpoints=%ld", db_.name(), checkpoint_count_.load());
+}
+
+void Checkpointer::thread_func()
+{
+  common::thread_set_name("Checkpointer");
+  LOG_INFO("checkpointer thread started");
+
+  while (running_.load()) {
+    {
+      unique_lock<mutex> lock(thread_lock_);
+      thread_cond_.wait_for(lock, chrono::milliseconds(interval_ms_), [this]() { return !running_.load(); });
+    }
+
+    if (!running_.load()) {
+      break;
+    }
+
+    RC rc = checkpoint_once();
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to do checkpoint. db=%s, rc=%s", db_.name(), strrc(rc));
+    }
+  }
+
+  LOG_INFO("checkpointer thread stopped");
+}
+
+RC Checkpointer::checkpoint_if_need()
+{
+  if (!running_.load() || thread_) {
+    return RC::SUCCESS;
+  }
+
+  const auto now = chrono::steady_clock::now();
+  if (now - last_checkpoint_time_ < chrono::milliseconds(interval_ms_)) {
+    return RC::SUCCESS;
+  }
+
+  last_checkpoint_time_ = now;
+  return checkpoint_once();
+}
+
+RC Checkpointer::checkpoint_once()
+{
+  lock_guard<mutex> guard(lock_);
+
+  // 已经提交的事务回写到记录中之后，检查点才能越过它们的日志
+  RC rc = db_.trx_kit().write_back_commits();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to write back committed trxes. db=%s, rc=%s", db_.name(), strrc(rc));
+  }
+
+  LogHandler        &log_handler = db_.log_handler();
+  BufferPoolManager &bp_manager  = db_.buffer_pool_manager();
+
+  // 先取 limit_lsn 再看脏页和活跃事务：之后登记的日志LSN都比它大，之前登记的要么还在登记中，
+  // 要么已经反映到了页帧或事务上
+  const LSN limit_lsn = log_handler.stable_lsn();
+  if (limit_lsn <= db_.check_point_lsn()) {
+    return RC::SUCCESS;
+  }
+
+  // 刷出很早以前修改过的页面，它们可能一直很热，不会被淘汰
+  bp_manager.page_cleaner().flush_old_pages(limit_lsn);
+
+  LSN check_point_lsn = limit_lsn;
+  {
+    // 后台刷脏页时先清除脏标记，之后才把页面交给 double write buffer，持有锁保证这时没有这样的页面。
+    // 交给 double write buffer 的页面在推进检查点之前会写回数据文件并落盘
+    lock_guard<mutex> cleaner_guard(bp_manager.page_cleaner().lock());
+    const LSN         rec_lsn = bp_manager.get_frame_manager().min_rec_lsn();
+    if (rec_lsn != 0) {
+      check_point_lsn = min(check_point_lsn, rec_lsn);
+    }
+  }
+
+  const LSN trx_lsn = db_.trx_kit().oldest_active_lsn();
+  if (trx_lsn != 0) {
+    check_point_lsn = min(check_point_lsn, trx_lsn);
+  }
+
+  if (check_point_lsn <= db_.check_point_lsn()) {
+    LOG_TRACE("checkpoint cannot advance. db=%s, check point lsn=%ld, limit lsn=%ld, trx lsn=%ld",
+              db_.name(), db_.check_point_lsn(), limit_lsn, trx_lsn);
+    return RC::SUCCESS;
+  }
+
+  // 恢复时从检查点开始回放，这条日志必须已经落盘
+  rc = log_handler.wait_lsn(check_point_lsn);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to wait lsn. lsn=%ld, rc=%s", check_point_lsn, strrc(rc));
+    return rc;
+  }
+
+  // double write buffer 只是写了它自己的文件，还没有落盘。检查点越过这些页面的日志之前，
+  // 要把它们写回数据文件并落盘
+  auto &dblwr_buffer = static_cast<DiskDoubleWriteBuffer &>(*bp_manager.get_dblwr_buffer());
+  rc                 = dblwr_buffer.flush_page();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to flush double write buffer. db=%s, rc=%s", db_.name(), strrc(rc));
+    return rc;
+  }
+
+  rc = db_.advance_check_point(check_point_lsn);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  checkpoint_count_++;
+  LOG_INFO("checkpoint advanced. db=%s, check point lsn=%ld, limit lsn=%ld", db_.name(), check_point_lsn, limit_lsn);
+  return RC::SUCCESS;
+}
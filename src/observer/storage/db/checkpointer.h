@@ -0,0 +1,93 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/18.
+//
+
+#pragma once
+
+#include "common/lang/atomic.h"
+#include "common/lang/chrono.h"
+#include "common/lang/memory.h"
+#include "common/lang/mutex.h"
+#include "common/lang/thread.h"
+#include "common/rc.h"
+#include "common/types.h"
+
+class Db;
+
+/**
+ * @brief 后台模糊检查点
+ * @details 检查点之前的日志在恢复时不需要再回放。Db::sync 要求没有正在执行的事务，平时很难做检查点，
+ * 恢复时就要从很早的日志开始回放。后台线程定期推进检查点，不需要等待事务结束，也不会阻塞事务：
+ *
+ * - 每个脏页记录了第一条还没有刷到磁盘的修改对应的日志(Frame::rec_lsn)，检查点不能超过所有脏页中
+ *   最小的 rec_lsn。rec_lsn 很小的页面交给 PageCleaner 刷出去，让检查点可以往前走；
+ * - 检查点也不能超过活跃事务写的第一条日志(TrxKit::oldest_active_lsn)，否则恢复时没办法回滚这些事务；
+ * - 修改页面时先写日志再设置页面的LSN，两步之间页面还没有记录 rec_lsn。写日志之前会用 LogLsnGuard 登记，
+ *   检查点也不能超过 LogHandler::stable_lsn。
+ *
+ * 交给 double write buffer 的页面写回数据文件并落盘之后，检查点才记录到数据库的元数据中，之后删除检查点之前的日志文件。
+ *
+ * 非 CONCURRENCY 模式下页帧的锁都是空操作，后台线程回写提交事务号时可能和会话修改同一条记录交错，
+ * 所以不启动后台线程，由会话处理完一个请求之后调用 checkpoint_if_need。
+ */
+class Checkpointer
+{
+public:
+  static constexpr int DEFAULT_INTERVAL_MS = 1000;  ///< 默认每隔多久做一次检查点
+
+  explicit Checkpointer(Db &db);
+  ~Checkpointer();
+
+  /**
+   * @brief 启动后台线程
+   * @details 非 CONCURRENCY 模式下只记录间隔，见 checkpoint_if_need
+   * @param interval_ms 每隔多久做一次检查点
+   */
+  RC   start(int interval_ms = DEFAULT_INTERVAL_MS);
+  void stop();
+  bool running() const { return running_.load(); }
+
+  /**
+   * @brief 执行一轮检查点
+   * @details 后台线程定期调用，测试也可以直接调用
+   */
+  RC checkpoint_once();
+
+  /**
+   * @brief 距离上一轮超过了间隔时执行一轮检查点
+   * @details 非 CONCURRENCY 模式下由会话在两个请求之间调用，启动了后台线程时什么都不做
+   */
+  RC checkpoint_if_need();
+
+  /// @brief 推进过检查点的次数
+  uint64_t checkpoint_count() const { return checkpoint_count_.load(); }
+
+private:
+  void thread_func();
+
+private:
+  Db &db_;
+
+  int interval_ms_ = DEFAULT_INTERVAL_MS;
+
+  mutex lock_;  ///< 一轮检查点期间持有
+
+  chrono::steady_clock::time_point last_checkpoint_time_;  ///< checkpoint_if_need 上一次执行的时间
+
+  atomic<bool>       running_{false};
+  mutex              thread_lock_;
+  condition_variable thread_cond_;
+  unique_ptr<thread> thread_;
+
+  atomic<uint64_t> checkpoint_count_{0};
+};
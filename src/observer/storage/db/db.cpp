@@ -20,10 +20,12 @@ See the Mulan PSL v2 for more details. */
 #include <vector>
 #include <filesystem>
 
+#include "common/lang/chrono.h"
 #include "common/lang/string.h"
 #include "common/log/log.h"
 #include "common/os/path.h"
 #include "common/global_context.h"
+#include "storage/buffer/frame_replacer.h"
 #include "storage/common/meta_util.h"
 #include "storage/table/table.h"
 #include "storage/table/table_meta.h"
@@ -36,6 +38,19 @@ using namespace common;
 
 Db::~Db()
 {
+  // 检查点会刷页面、删除日志文件，最先停下来
+  checkpointer_.stop();
+
+  // 表删除之前把已经提交的事务回写到记录中
+  if (trx_kit_) {
+    trx_kit_->write_back_commits();
+  }
+
+  // 后台刷脏页会用到日志，先停下来
+  if (buffer_pool_manager_) {
+    buffer_pool_manager_->page_cleaner().stop();
+  }
+
   for (auto &iter : opened_tables_) {
     delete iter.second;
   }
@@ -49,7 +64,9 @@ Db::~Db()
   LOG_INFO("Db has been closed: %s", name_.c_str());
 }
 
-RC Db::init(const char *name, const char *dbpath, const char *trx_kit_name, const char *log_handler_name)
+RC Db::init(const char *name, const char *dbpath, const char *trx_kit_name, const char *log_handler_name,
+    const char *eviction_policy /* = nullptr */, int clean_percent /* = 0 */, int checkpoint_interval_ms /* = 0 */,
+    int redo_thread_num /* = 1 */)
 {
   RC rc = RC::SUCCESS;
 
@@ -71,7 +88,12 @@ RC Db::init(const char *name, const char *dbpath, const char *trx_kit_name, cons
 
   trx_kit_.reset(trx_kit);
 
-  buffer_pool_manager_ = make_unique<BufferPoolManager>();
+  if (FrameReplacer::create(eviction_policy, 0) == nullptr) {
+    LOG_ERROR("Unknown buffer pool eviction policy: %s", eviction_policy);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  buffer_pool_manager_ = make_unique<BufferPoolManager>(0 /*memory_size*/, eviction_policy);
   auto dblwr_buffer    = make_unique<DiskDoubleWriteBuffer>(*buffer_pool_manager_);
 
   const char      *double_write_buffer_filename  = "dblwr.db";
@@ -83,7 +105,7 @@ RC Db::init(const char *name, const char *dbpath, const char *trx_kit_name, cons
     return rc;
   }
 
-  rc = buffer_pool_manager_->init(std::move(dblwr_buffer));
+  rc = buffer_pool_manager_->init(std::move(dblwr_buffer), clean_percent);
   if (OB_FAIL(rc)) {
     LOG_ERROR("Failed to init buffer pool manager. dbpath=%s, rc=%s", dbpath, strrc(rc));
     return rc;
@@ -129,12 +151,20 @@ RC Db::init(const char *name, const char *dbpath, const char *trx_kit_name, cons
   }
 
   // 尝试恢复数据库，重做redo日志
-  rc = recover();
+  rc = recover(redo_thread_num);
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to recover db. dbpath=%s, rc=%s", dbpath, strrc(rc));
     return rc;
   }
 
+  if (checkpoint_interval_ms > 0) {
+    rc = checkpointer_.start(checkpoint_interval_ms);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to start checkpointer. dbpath=%s, rc=%s", dbpath, strrc(rc));
+      return rc;
+    }
+  }
+
   return rc;
 }
 
@@ -159,6 +189,7 @@ RC Db::create_table(const char *table_name, span<const AttrInfoSqlNode> attribut
   }
 
   opened_tables_[table_name] = table;
+  increase_schema_version();
   LOG_INFO("Create table success. table name=%s, table_id:%d", table_name, table_id);
   return RC::SUCCESS;
 }
@@ -193,6 +224,7 @@ RC Db::create_table(const char *table_name, std::vector<std::string> attr_names,
   }
 
   opened_tables_[table_name] = table;
+  increase_schema_version();
   LOG_INFO("Create table success. table name=%s, table_id:%d", table_name, table_id);
   return RC::SUCCESS;
 }
@@ -206,15 +238,23 @@ RC Db::drop_table(const char *table_name)
     return RC::SCHEMA_TABLE_NOT_EXIST;
   }
 
+  // 回写队列中的事务可能修改过这张表，删除之前先回写
+  auto rc = trx_kit_->write_back_commits();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to write back committed trxes. table=%s, rc=%s", table_name, strrc(rc));
+    return rc;
+  }
+
   // drop table
   auto table = it->second;
-  auto rc    = table->drop();
+  rc         = table->drop();
   if (rc != RC::SUCCESS) {
     LOG_ERROR("Failed to drop table %s.", table_name);
     return rc;
   }
 
   opened_tables_.erase(table_name);
+  increase_schema_version();
   // release memory
   delete table;
   LOG_INFO("Drop table success. table name=%s", table_name);
@@ -337,7 +377,13 @@ void Db::all_tables(vector<string> &table_names) const
 
 RC Db::sync()
 {
-  RC rc = RC::SUCCESS;
+  // 检查点会推进到当前的LSN，已经提交的事务要先回写到记录中
+  RC rc = trx_kit_->write_back_commits();
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to write back committed trxes. db=%s, rc=%s", name_.c_str(), strrc(rc));
+    return rc;
+  }
+
   // 调用所有表的sync函数刷新数据到磁盘
   for (const auto &table_pair : opened_tables_) {
     BaseTable *table = table_pair.second;
@@ -364,19 +410,40 @@ RC Db::sync()
     return rc;
   }
 
-  check_point_lsn_ = current_lsn;
-  rc               = flush_meta();
+  rc = advance_check_point(current_lsn);
   if (OB_FAIL(rc)) {
-    LOG_ERROR("Failed to flush meta. db=%s, rc=%d:%s", name_.c_str(), rc, strrc(rc));
     return rc;
   }
   LOG_INFO("Successfully sync db. db=%s", name_.c_str());
   return rc;
 }
 
-RC Db::recover()
+RC Db::advance_check_point(LSN lsn)
 {
-  LOG_TRACE("db recover begin. check_point_lsn=%d", check_point_lsn_);
+  lock_guard<mutex> guard(check_point_lock_);
+  if (lsn <= check_point_lsn_.load()) {
+    return RC::SUCCESS;
+  }
+
+  check_point_lsn_.store(lsn);
+  RC rc = flush_meta();
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to flush meta. db=%s, rc=%d:%s", name_.c_str(), rc, strrc(rc));
+    return rc;
+  }
+
+  // 元数据落盘之后，检查点之前的日志就不再需要了
+  rc = log_handler_->truncate(lsn);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("Failed to truncate log. db=%s, lsn=%ld, rc=%s", name_.c_str(), lsn, strrc(rc));
+  }
+  return RC::SUCCESS;
+}
+
+RC Db::recover(int redo_thread_num)
+{
+  LOG_TRACE("db recover begin. check_point_lsn=%ld", check_point_lsn());
+  const auto begin_time = chrono::steady_clock::now();
 
   LogReplayer *trx_log_replayer = trx_kit_->create_log_replayer(*this, *log_handler_);
   if (trx_log_replayer == nullptr) {
@@ -384,8 +451,10 @@ RC Db::recover()
     return RC::INTERNAL;
   }
 
-  IntegratedLogReplayer log_replayer(*buffer_pool_manager_, unique_ptr<LogReplayer>(trx_log_replayer));
-  RC                    rc = log_handler_->replay(log_replayer, check_point_lsn_ /*start_lsn*/);
+  IntegratedLogReplayer log_replayer(
+      *buffer_pool_manager_, unique_ptr<LogReplayer>(trx_log_replayer), redo_thread_num);
+  const int redo_worker_num = log_replayer.worker_num();
+  RC rc = log_handler_->replay(log_replayer, check_point_lsn() /*start_lsn*/);
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to replay log. rc=%s", strrc(rc));
     return rc;
@@ -403,7 +472,9 @@ RC Db::recover()
     return rc;
   }
 
-  LOG_INFO("Successfully recover db. db=%s checkpoint_lsn=%d", name_.c_str(), check_point_lsn_);
+  const auto cost_ms = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - begin_time).count();
+  LOG_INFO("Successfully recover db. db=%s checkpoint_lsn=%ld, redo threads=%d, cost=%ldms",
+           name_.c_str(), check_point_lsn(), redo_worker_num, static_cast<long>(cost_ms));
   return rc;
 }
 
@@ -411,7 +482,7 @@ RC Db::init_meta()
 {
   filesystem::path db_meta_file_path = db_meta_file(path_.c_str(), name_.c_str());
   if (!filesystem::exists(db_meta_file_path)) {
-    check_point_lsn_ = 0;
+    check_point_lsn_.store(0);
     LOG_INFO("Db meta file not exist. db=%s, file=%s", name_.c_str(), db_meta_file_path.c_str());
     return RC::SUCCESS;
   }
@@ -437,10 +508,16 @@ RC Db::init_meta()
       return RC::IOERR_TOO_LONG;
     }
 
-    buffer[n]        = '\0';
-    check_point_lsn_ = atoll(buffer);  // 当前元数据就这一个数字
-    LOG_INFO("Successfully read db meta file. db=%s, file=%s, check_point_lsn=%ld", 
-             name_.c_str(), db_meta_file_path.c_str(), check_point_lsn_);
+    buffer[n] = '\0';
+
+    // 元数据是检查点LSN和已经分配过的最大事务号，早期的元数据文件只有检查点LSN
+    char         *end    = nullptr;
+    const LSN     lsn    = strtoll(buffer, &end, 10);
+    const int32_t trx_id = static_cast<int32_t>(strtol(end, nullptr, 10));
+    check_point_lsn_.store(lsn);
+    trx_kit_->recover_trx_id(trx_id);
+    LOG_INFO("Successfully read db meta file. db=%s, file=%s, check_point_lsn=%ld, trx_id=%d", 
+             name_.c_str(), db_meta_file_path.c_str(), lsn, trx_id);
   }
   close(fd);
 
@@ -465,7 +542,8 @@ RC Db::flush_meta()
     return RC::IOERR_WRITE;
   }
 
-  string buffer = std::to_string(check_point_lsn_);
+  // 检查点之前的日志会被删除，恢复时不能再从日志中找回已经用过的事务号，一起记录下来
+  string buffer = std::to_string(check_point_lsn_.load()) + " " + std::to_string(trx_kit_->last_trx_id());
   int    n      = write(fd, buffer.c_str(), buffer.size());
   if (n < 0) {
     LOG_ERROR("Failed to write db meta file. db=%s, file=%s, errno=%s", 
@@ -475,6 +553,10 @@ RC Db::flush_meta()
     LOG_ERROR("Failed to write db meta file. db=%s, file=%s, buffer size=%ld, write size=%d", 
               name_.c_str(), temp_meta_file_path.c_str(), buffer.size(), n);
     rc = RC::IOERR_WRITE;
+  } else if (fsync(fd) != 0) {
+    LOG_ERROR("Failed to sync db meta file. db=%s, file=%s, errno=%s", 
+              name_.c_str(), temp_meta_file_path.c_str(), strerror(errno));
+    rc = RC::IOERR_SYNC;
   } else {
     error_code ec;
     filesystem::rename(temp_meta_file_path, meta_file_path, ec);
@@ -485,10 +567,11 @@ RC Db::flush_meta()
     } else {
 
       LOG_INFO("Successfully write db meta file. db=%s, file=%s, check_point_lsn=%ld", 
-               name_.c_str(), temp_meta_file_path.c_str(), check_point_lsn_);
+               name_.c_str(), temp_meta_file_path.c_str(), check_point_lsn_.load());
     }
   }
 
+  close(fd);
   return rc;
 }
 
@@ -14,7 +14,11 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <atomic>
+
 #include "common/rc.h"
+#include "common/lang/atomic.h"
+#include "common/lang/mutex.h"
 #include "common/lang/vector.h"
 #include "common/lang/string.h"
 #include "common/lang/unordered_map.h"
@@ -24,6 +28,7 @@ See the Mulan PSL v2 for more details. */
 #include "storage/buffer/disk_buffer_pool.h"
 #include "storage/clog/disk_log_handler.h"
 #include "storage/buffer/double_write_buffer.h"
+#include "storage/db/checkpointer.h"
 #include "storage/table/base_table.h"
 
 class Table;
@@ -55,9 +60,15 @@ public:
    * @param name   数据库名称
    * @param dbpath 当前数据库放在哪个目录下
    * @param trx_kit_name 使用哪种类型的事务模型
+   * @param eviction_policy 缓冲池的页帧淘汰策略，参考 FrameReplacer::create
+   * @param clean_percent 后台刷脏页希望保持的干净页帧比例，参考 PageCleaner。0 表示不启动
+   * @param checkpoint_interval_ms 后台做检查点的间隔，参考 Checkpointer。0 表示不启动
+   * @param redo_thread_num 恢复时并行回放日志的线程数，参考 IntegratedLogReplayer。不大于1时单线程回放
    * @note 数据库不是放在dbpath/name下，是直接使用dbpath目录
    */
-  RC init(const char *name, const char *dbpath, const char *trx_kit_name, const char *log_handler_name);
+  RC init(const char *name, const char *dbpath, const char *trx_kit_name, const char *log_handler_name,
+      const char *eviction_policy = nullptr, int clean_percent = 0, int checkpoint_interval_ms = 0,
+      int redo_thread_num = 1);
 
   /**
    * @brief 创建一个表
@@ -102,6 +113,19 @@ public:
    */
   RC sync();
 
+  /// @brief 当前的检查点，恢复时从这里开始回放日志
+  LSN check_point_lsn() const { return check_point_lsn_.load(); }
+
+  /**
+   * @brief 推进检查点
+   * @details 检查点只会往前推进，比当前的检查点小时什么都不做。检查点记录到元数据中之后，
+   * 删除检查点之前的日志文件
+   */
+  RC advance_check_point(LSN lsn);
+
+  /// @brief 后台检查点
+  Checkpointer &checkpointer() { return checkpointer_; }
+
   /// @brief 获取当前数据库的日志处理器
   LogHandler &log_handler();
 
@@ -111,15 +135,25 @@ public:
   /// @brief 获取当前数据库的事务管理器
   TrxKit &trx_kit();
 
+  /**
+   * @brief 数据库的模式版本号
+   * @details 建表、删表、创建索引时递增。执行计划缓存用它判断缓存的计划是否还能使用
+   */
+  uint64_t schema_version() const { return schema_version_.load(); }
+  void     increase_schema_version() { schema_version_++; }
+
 private:
   /// @brief 打开所有的表。在数据库初始化的时候会执行
   RC open_all_tables();
-  /// @brief 恢复数据。在数据库初始化的时候运行。
-  RC recover();
+  /**
+   * @brief 恢复数据。在数据库初始化的时候运行。
+   * @param redo_thread_num 并行回放日志的线程数
+   */
+  RC recover(int redo_thread_num);
 
   /// @brief 初始化元数据。在数据库初始化的时候，加载元数据
   RC init_meta();
-  /// @brief 刷新数据库的元数据到磁盘中。每次执行sync时会执行此操作
+  /// @brief 刷新数据库的元数据到磁盘中。每次推进检查点时会执行此操作
   RC flush_meta();
 
   /// @brief 初始化数据库的double buffer pool
@@ -136,5 +170,9 @@ private:
   /// 给每个table都分配一个ID，用来记录日志。这里假设所有的DDL都不会并发操作，所以相关的数据都不上锁
   int32_t next_table_id_ = 0;
 
-  LSN check_point_lsn_ = 0;  ///< 当前数据库的检查点LSN。会记录到磁盘中。
+  mutex        check_point_lock_;     ///< 推进检查点时持有
+  atomic<LSN>  check_point_lsn_{0};   ///< 当前数据库的检查点LSN。会记录到磁盘中。
+  Checkpointer checkpointer_{*this};  ///< 后台推进检查点
+
+  std::atomic<uint64_t> schema_version_{0};  ///< 模式版本号，只在内存中维护
 };
@@ -33,7 +33,8 @@ DefaultHandler::DefaultHandler() {}
 
 DefaultHandler::~DefaultHandler() noexcept { destroy(); }
 
-RC DefaultHandler::init(const char *base_dir, const char *trx_kit_name, const char *log_handler_name)
+RC DefaultHandler::init(const char *base_dir, const char *trx_kit_name, const char *log_handler_name,
+    const char *eviction_policy, int clean_percent, int checkpoint_interval_ms, int redo_thread_num)
 {
   // 检查目录是否存在，或者创建
   filesystem::path db_dir(base_dir);
@@ -44,10 +45,14 @@ RC DefaultHandler::init(const char *base_dir, const char *trx_kit_name, const ch
     return RC::INTERNAL;
   }
 
-  base_dir_         = base_dir;
-  db_dir_           = db_dir;
-  trx_kit_name_     = trx_kit_name;
-  log_handler_name_ = log_handler_name;
+  base_dir_               = base_dir;
+  db_dir_                 = db_dir;
+  trx_kit_name_           = trx_kit_name;
+  log_handler_name_       = log_handler_name;
+  eviction_policy_        = eviction_policy == nullptr ? "" : eviction_policy;
+  clean_percent_          = clean_percent;
+  checkpoint_interval_ms_ = checkpoint_interval_ms;
+  redo_thread_num_        = redo_thread_num;
 
   const char *sys_db = "sys";
 
@@ -143,7 +148,9 @@ RC DefaultHandler::open_db(const char *dbname)
   // open db
   Db *db  = new Db();
   RC  ret = RC::SUCCESS;
-  if ((ret = db->init(dbname, dbpath.c_str(), trx_kit_name_.c_str(), log_handler_name_.c_str())) != RC::SUCCESS) {
+  const char *eviction_policy = eviction_policy_.empty() ? nullptr : eviction_policy_.c_str();
+  if ((ret = db->init(dbname, dbpath.c_str(), trx_kit_name_.c_str(), log_handler_name_.c_str(), eviction_policy,
+           clean_percent_, checkpoint_interval_ms_, redo_thread_num_)) != RC::SUCCESS) {
     LOG_ERROR("Failed to open db: %s. error=%s", dbname, strrc(ret));
     delete db;
   } else {
@@ -38,8 +38,14 @@ public:
    * @param base_dir 存储引擎的根目录。所有的数据库相关数据文件都放在这个目录下
    * @param trx_kit_name 使用哪种类型的事务模型
    * @param log_handler_name 使用哪种类型的日志处理器
+   * @param eviction_policy 缓冲池的页帧淘汰策略
+   * @param clean_percent 后台刷脏页希望保持的干净页帧比例，0 表示不启动后台刷脏页
+   * @param checkpoint_interval_ms 后台做检查点的间隔，0 表示不启动后台检查点
+   * @param redo_thread_num 恢复时并行回放日志的线程数，不大于1时单线程回放
    */
-  RC   init(const char *base_dir, const char *trx_kit_name, const char *log_handler_name);
+  RC init(const char *base_dir, const char *trx_kit_name, const char *log_handler_name,
+      const char *eviction_policy = nullptr, int clean_percent = 0, int checkpoint_interval_ms = 0,
+      int redo_thread_num = 1);
   void destroy();
 
   /**
@@ -91,9 +97,13 @@ public:
   RC sync();
 
 private:
-  filesystem::path  base_dir_;          ///< 存储引擎的根目录
-  filesystem::path  db_dir_;            ///< 数据库文件的根目录
-  string            trx_kit_name_;      ///< 事务模型的名称
-  string            log_handler_name_;  ///< 日志处理器的名称
-  map<string, Db *> opened_dbs_;        ///< 打开的数据库
+  filesystem::path  base_dir_;                    ///< 存储引擎的根目录
+  filesystem::path  db_dir_;                      ///< 数据库文件的根目录
+  string            trx_kit_name_;                ///< 事务模型的名称
+  string            log_handler_name_;            ///< 日志处理器的名称
+  string            eviction_policy_;             ///< 缓冲池的页帧淘汰策略
+  int               clean_percent_          = 0;  ///< 后台刷脏页希望保持的干净页帧比例
+  int               checkpoint_interval_ms_ = 0;  ///< 后台做检查点的间隔
+  int               redo_thread_num_        = 1;  ///< 恢复时并行回放日志的线程数
+  map<string, Db *> opened_dbs_;                  ///< 打开的数据库
 };
@@ -16,6 +16,7 @@ See the Mulan PSL v2 for more details. */
 #include <span>
 
 #include "storage/index/bplus_tree.h"
+#include "common/lang/algorithm.h"
 #include "common/lang/lower_bound.h"
 #include "common/log/log.h"
 #include "common/global_context.h"
@@ -31,31 +32,106 @@ using namespace common;
  */
 #define FIRST_INDEX_PAGE 1
 
-int calc_internal_page_capacity(int attr_length)
+/**
+ * @brief 计算内部节点最多可以存放的元素个数
+ * @details 页面中除了页头，还要存放两个完整的键值作为上下界。元素中省略的公共前缀越长，能存放的元素越多
+ * @param attr_length 索引字段的总长度
+ * @param prefix_length 元素中省略的公共前缀长度
+ */
+int calc_internal_page_capacity(int attr_length, int prefix_length = 0)
 {
-  int item_size = attr_length + sizeof(RID) + sizeof(PageNum);
-  int capacity  = ((int)BP_PAGE_DATA_SIZE - InternalIndexNode::HEADER_SIZE) / item_size;
+  int key_length = attr_length + sizeof(RID);
+  int item_size  = key_length - prefix_length + sizeof(PageNum);
+  int capacity   = ((int)BP_PAGE_DATA_SIZE - InternalIndexNode::HEADER_SIZE - 2 * key_length) / item_size;
   return capacity;
 }
 
-int calc_leaf_page_capacity(int attr_length)
+int calc_leaf_page_capacity(int attr_length, int prefix_length = 0)
 {
-  int item_size = attr_length + sizeof(RID) + sizeof(RID);
-  int capacity  = ((int)BP_PAGE_DATA_SIZE - LeafIndexNode::HEADER_SIZE) / item_size;
+  int key_length = attr_length + sizeof(RID);
+  int item_size  = key_length - prefix_length + sizeof(RID);
+  int capacity   = ((int)BP_PAGE_DATA_SIZE - LeafIndexNode::HEADER_SIZE - 2 * key_length) / item_size;
   return capacity;
 }
 
+/**
+ * @brief 批量构建B+树时页面的填充比例
+ * @details 留一些空间给后续的插入，避免刚构建好的B+树一插入数据就要分裂页面
+ */
+static const double BULK_LOAD_FILL_FACTOR = 0.9;
+
+/**
+ * @brief 批量构建B+树时，计算一层中每个页面存放的元素个数
+ * @details 按顺序把每个页面尽量填充到 BULK_LOAD_FILL_FACTOR。页面的上下界是它自己和下一个页面的第一个键值，
+ * 页面中放的元素越多，上下界的公共前缀越短，能存放的元素也越少，所以用二分查找确定每个页面放多少个元素。
+ * 只有一个页面时它就是根节点，否则每个页面都不能少于 min_size，
+ * 这样后续删除数据时的合并与重新分配逻辑不需要关心这棵树是怎么构建出来的
+ * @param header 用于计算键值的公共前缀
+ * @param keys 这一层每个元素的键值，已经排好序
+ * @param max_size 省略的公共前缀长度为参数值时，页面最多存放的元素个数
+ */
+static vector<int> bulk_load_page_sizes(
+    const IndexFileHeader &header, const vector<const char *> &keys, const function<int(int)> &max_size)
+{
+  const int item_num    = static_cast<int>(keys.size());
+  const int static_size = max_size(0);
+  const int min_size    = static_size - static_size / 2;
+  auto      fill_size   = [&](int prefix_length) {
+    return max(min_size, static_cast<int>(max_size(prefix_length) * BULK_LOAD_FILL_FACTOR));
+  };
+
+  vector<int> sizes;
+  for (int start = 0; start < item_num;) {
+    // 最左边和最右边的页面少一个边界，不做前缀压缩
+    int size = fill_size(0);
+    if (start > 0 && start + size < item_num) {
+      int low  = size;
+      int high = min(item_num - start - 1, fill_size(header.common_prefix_length(keys[start], keys[start + size])));
+      while (low < high) {
+        const int middle = (low + high + 1) / 2;
+        if (middle <= fill_size(header.common_prefix_length(keys[start], keys[start + middle]))) {
+          low = middle;
+        } else {
+          high = middle - 1;
+        }
+      }
+      size = low;
+    }
+
+    size = min(size, item_num - start);
+    sizes.push_back(size);
+    start += size;
+  }
+
+  // 最后一个页面的元素太少时，从前一个页面挪一些过来。前一个页面的上界变小，公共前缀不会变短
+  const int page_num = static_cast<int>(sizes.size());
+  if (page_num > 1 && sizes[page_num - 1] < min_size) {
+    const int total = sizes[page_num - 2] + sizes[page_num - 1];
+    if (total <= static_size) {
+      sizes.pop_back();
+      sizes.back() = total;
+    } else {
+      sizes[page_num - 2] = total - min_size;
+      sizes[page_num - 1] = min_size;
+    }
+  }
+  return sizes;
+}
+
 /////////////////////////////////////////////////////////////////////////////////
 IndexNodeHandler::IndexNodeHandler(BplusTreeMiniTransaction &mtr, const IndexFileHeader &header, Frame *frame)
     : mtr_(mtr), header_(header), frame_(frame), node_((IndexNode *)frame->data())
 {}
 
-bool IndexNodeHandler::is_leaf() const { return node_->is_leaf; }
+bool IndexNodeHandler::is_leaf() const { return frozen_ ? frozen_is_leaf_ : node_->is_leaf; }
 void IndexNodeHandler::init_empty(bool leaf)
 {
-  node_->is_leaf = leaf;
-  node_->key_num = 0;
-  node_->parent  = BP_INVALID_PAGE_NUM;
+  node_->is_leaf        = leaf;
+  node_->has_low_fence  = false;
+  node_->has_high_fence = false;
+  node_->key_num        = 0;
+  node_->parent         = BP_INVALID_PAGE_NUM;
+  node_->prefix_length  = 0;
 }
 PageNum IndexNodeHandler::page_num() const { return frame_->page_num(); }
 
@@ -64,18 +140,36 @@ int IndexNodeHandler::key_size() const { return header_.key_length; }
 int IndexNodeHandler::value_size() const
 {
   // return header_.value_size;
-  return sizeof(RID);
+  return is_leaf() ? static_cast<int>(sizeof(RID)) : static_cast<int>(sizeof(PageNum));
 }
 
 int IndexNodeHandler::item_size() const { return key_size() + value_size(); }
 
-int IndexNodeHandler::size() const { return node_->key_num; }
+int IndexNodeHandler::size() const { return frozen_ ? frozen_size_ : node_->key_num; }
+
+int IndexNodeHandler::max_size() const { return max_size(prefix_length()); }
+
+int IndexNodeHandler::max_size(int prefix_length) const
+{
+  return is_leaf() ? calc_leaf_page_capacity(header_.attr_length, prefix_length)
+                   : calc_internal_page_capacity(header_.attr_length, prefix_length);
+}
 
-int IndexNodeHandler::max_size() const { return is_leaf() ? header_.leaf_max_size : header_.internal_max_size; }
+int IndexNodeHandler::max_size(const char *low_fence, const char *high_fence) const
+{
+  if (low_fence == nullptr || high_fence == nullptr) {
+    return max_size(0);
+  }
+  return max_size(header_.common_prefix_length(low_fence, high_fence));
+}
 
+/**
+ * @details 按照不做前缀压缩时的容量计算。元素个数不超过这个值的节点，无论上下界怎么变化都放得下，
+ * 所以重新分配时只要保证接收元素的节点原来少于 min_size 就可以
+ */
 int IndexNodeHandler::min_size() const
 {
-  const int max = this->max_size();
+  const int max = is_leaf() ? header_.leaf_max_size : header_.internal_max_size;
   return max - max / 2;
 }
 
@@ -94,6 +188,129 @@ RC IndexNodeHandler::set_parent_page_num(PageNum page_num)
   return rc;
 }
 
+int IndexNodeHandler::prefix_length() const { return frozen_ ? frozen_prefix_length_ : node_->prefix_length; }
+
+char *IndexNodeHandler::__fences() const
+{
+  return frame_->data() + (is_leaf() ? LeafIndexNode::HEADER_SIZE : InternalIndexNode::HEADER_SIZE);
+}
+
+const char *IndexNodeHandler::low_fence() const { return node_->has_low_fence ? __fences() : nullptr; }
+
+const char *IndexNodeHandler::high_fence() const { return node_->has_high_fence ? __fences() + key_size() : nullptr; }
+
+RC IndexNodeHandler::set_fences(const char *low_fence, const char *high_fence)
+{
+  // 新的上下界可能就是当前页面中的数据，先复制出来
+  auto copy_fence = [this](const char *fence) {
+    return fence == nullptr ? vector<char>() : vector<char>(fence, fence + key_size());
+  };
+  vector<char> low      = copy_fence(low_fence);
+  vector<char> high     = copy_fence(high_fence);
+  vector<char> old_low  = copy_fence(this->low_fence());
+  vector<char> old_high = copy_fence(this->high_fence());
+
+  RC rc = mtr_.logger().node_set_fences(*this, low, high, old_low, old_high);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to log set fences. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  return recover_set_fences(low.empty() ? nullptr : low.data(), high.empty() ? nullptr : high.data());
+}
+
+RC IndexNodeHandler::recover_set_fences(const char *low_fence, const char *high_fence)
+{
+  const int old_prefix_length = prefix_length();
+  const int new_prefix_length =
+      (low_fence != nullptr && high_fence != nullptr) ? header_.common_prefix_length(low_fence, high_fence) : 0;
+
+  // 公共前缀的长度变化时，所有元素都要重新编排。先按照原来的公共前缀取出完整的元素
+  // 长度不变时，节点中的键值同时在新旧两个范围内，省略的前缀内容也是一样的
+  vector<char> items;
+  if (new_prefix_length != old_prefix_length) {
+    copy_items(0, size(), items);
+  }
+
+  node_->has_low_fence  = (low_fence != nullptr);
+  node_->has_high_fence = (high_fence != nullptr);
+  if (low_fence != nullptr) {
+    memmove(__fences(), low_fence, key_size());
+  }
+  if (high_fence != nullptr) {
+    memmove(__fences() + key_size(), high_fence, key_size());
+  }
+
+  if (new_prefix_length != old_prefix_length) {
+    ASSERT(size() <= max_size(new_prefix_length), "too many items for the fences. size=%d", size());
+    node_->prefix_length = new_prefix_length;
+
+    const int item_size = this->item_size();
+    const int slot_size = __slot_size();
+    for (int i = 0; i < size(); i++) {
+      memcpy(__item_at(i), items.data() + static_cast<size_t>(i) * item_size + new_prefix_length, slot_size);
+    }
+  }
+  return RC::SUCCESS;
+}
+
+void IndexNodeHandler::copy_key(int index, char *key) const
+{
+  const int prefix_length = this->prefix_length();
+  memcpy(key, __fences(), prefix_length);
+  memcpy(key + prefix_length, __item_at(index), key_size() - prefix_length);
+}
+
+void IndexNodeHandler::copy_items(int index, int num, vector<char> &items) const
+{
+  const int item_size     = this->item_size();
+  const int prefix_length = this->prefix_length();
+  items.resize(static_cast<size_t>(num) * item_size);
+  for (int i = 0; i < num; i++) {
+    char *item = items.data() + static_cast<size_t>(i) * item_size;
+    memcpy(item, __fences(), prefix_length);
+    memcpy(item + prefix_length, __item_at(index + i), item_size - prefix_length);
+  }
+}
+
+const char *IndexNodeHandler::key_at(int index) const
+{
+  assert(index >= 0 && index < size());
+  key_buffer_.resize(key_size());
+  copy_key(index, key_buffer_.data());
+  return key_buffer_.data();
+}
+
+int IndexNodeHandler::lower_bound(
+    const KeyComparator &comparator, const char *key, int first, int last, bool *found) const
+{
+  const int    prefix_length = this->prefix_length();
+  vector<char> buffer(key_size());
+  memcpy(buffer.data(), __fences(), prefix_length);
+
+  auto compare = [&](int index) {
+    memcpy(buffer.data() + prefix_length, __item_at(index), key_size() - prefix_length);
+    return comparator(buffer.data(), key);
+  };
+
+  int count = last - first;
+  while (count > 0) {
+    const int step   = count / 2;
+    const int middle = first + step;
+    if (compare(middle) < 0) {
+      first = middle + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+
+  if (found != nullptr) {
+    *found = (first < last && compare(first) == 0);
+  }
+  return first;
+}
+
 /**
  * 检查一个节点经过插入或删除操作后是否需要分裂或合并操作
  * @return true 需要分裂或合并；
@@ -134,7 +351,8 @@ string to_string(const IndexNodeHandler &handler)
 
   ss << "PageNum:" << handler.page_num() << ",is_leaf:" << handler.is_leaf() << ","
      << "key_num:" << handler.size() << ","
-     << "parent:" << handler.parent_page_num() << ",";
+     << "parent:" << handler.parent_page_num() << ","
+     << "prefix_length:" << handler.prefix_length() << ",";
 
   return ss.str();
 }
@@ -152,33 +370,106 @@ bool IndexNodeHandler::validate() const
       LOG_WARN("root page internal node has less than 2 child. size=%d", size());
       return false;
     }
+
+    if (low_fence() != nullptr || high_fence() != nullptr) {
+      LOG_WARN("root page should not have fences. page num=%d", page_num());
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IndexNodeHandler::freeze_header()
+{
+  // 页面可能正在被修改，每个字段只读一次
+  const bool is_leaf       = node_->is_leaf;
+  const int  size          = node_->key_num;
+  const int  prefix_length = node_->prefix_length;
+  if (prefix_length < 0 || prefix_length > header_.attr_length) {
+    return false;
+  }
+
+  const int capacity = is_leaf ? calc_leaf_page_capacity(header_.attr_length, prefix_length)
+                               : calc_internal_page_capacity(header_.attr_length, prefix_length);
+  if (size < 0 || size > capacity) {
+    return false;
+  }
+
+  frozen_               = true;
+  frozen_is_leaf_       = is_leaf;
+  frozen_size_          = size;
+  frozen_prefix_length_ = prefix_length;
+  return true;
+}
+
+bool IndexNodeHandler::validate_fences(const IndexNodeHandler &parent_node, int index_in_parent) const
+{
+  // 最左边和最右边的子节点使用父节点自己的上下界
+  auto copy_fence = [this](const char *fence) {
+    return fence == nullptr ? vector<char>() : vector<char>(fence, fence + key_size());
+  };
+  vector<char> expected_low  = copy_fence(
+      index_in_parent == 0 ? parent_node.low_fence() : parent_node.key_at(index_in_parent));
+  vector<char> expected_high = copy_fence(index_in_parent == parent_node.size() - 1
+                                              ? parent_node.high_fence()
+                                              : parent_node.key_at(index_in_parent + 1));
+
+  auto same_fence = [this](const char *fence, const vector<char> &expected) {
+    if (fence == nullptr || expected.empty()) {
+      return fence == nullptr && expected.empty();
+    }
+    return memcmp(fence, expected.data(), key_size()) == 0;
+  };
+
+  if (!same_fence(low_fence(), expected_low) || !same_fence(high_fence(), expected_high)) {
+    LOG_WARN("fences are different from the keys in parent. this page num=%d, parent page num=%d, index in parent=%d",
+             page_num(), parent_node.page_num(), index_in_parent);
+    return false;
   }
   return true;
 }
 
+/**
+ * @details 日志中记录的是完整的元素，写入页面时省略公共前缀
+ */
 RC IndexNodeHandler::recover_insert_items(int index, const char *items, int num)
 {
-  const int item_size = this->item_size();
+  const int item_size     = this->item_size();
+  const int slot_size     = __slot_size();
+  const int prefix_length = this->prefix_length();
   if (index < size()) {
-    memmove(__item_at(index + num), __item_at(index), (static_cast<size_t>(size()) - index) * item_size);
+    memmove(__item_at(index + num), __item_at(index), (static_cast<size_t>(size()) - index) * slot_size);
   }
 
-  memcpy(__item_at(index), items, static_cast<size_t>(num) * item_size);
+  for (int i = 0; i < num; i++) {
+    memcpy(__item_at(index + i), items + static_cast<size_t>(i) * item_size + prefix_length, slot_size);
+  }
   increase_size(num);
   return RC::SUCCESS;
 }
 
 RC IndexNodeHandler::recover_remove_items(int index, int num)
 {
-  const int item_size = this->item_size();
+  const int slot_size = __slot_size();
   if (index < size() - num) {
-    memmove(__item_at(index), __item_at(index + num), (static_cast<size_t>(size()) - index - num) * item_size);
+    memmove(__item_at(index), __item_at(index + num), (static_cast<size_t>(size()) - index - num) * slot_size);
   }
 
   increase_size(-num);
   return RC::SUCCESS;
 }
 
+RC IndexNodeHandler::bulk_append(const char *items, int num)
+{
+  RC rc = mtr_.logger().node_insert_items(*this, size(), span<const char>(items, num * item_size()), num);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to log append items. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  return recover_insert_items(size(), items, num);
+}
+
 /////////////////////////////////////////////////////////////////////////////////
 LeafIndexNodeHandler::LeafIndexNodeHandler(BplusTreeMiniTransaction &mtr, const IndexFileHeader &header, Frame *frame)
     : IndexNodeHandler(mtr, header, frame), leaf_node_((LeafIndexNode *)frame->data())
@@ -210,12 +501,6 @@ RC LeafIndexNodeHandler::set_next_page(PageNum page_num)
 
 PageNum LeafIndexNodeHandler::next_page() const { return leaf_node_->next_brother; }
 
-char *LeafIndexNodeHandler::key_at(int index)
-{
-  assert(index >= 0 && index < size());
-  return __key_at(index);
-}
-
 char *LeafIndexNodeHandler::value_at(int index)
 {
   assert(index >= 0 && index < size());
@@ -224,11 +509,7 @@ char *LeafIndexNodeHandler::value_at(int index)
 
 int LeafIndexNodeHandler::lookup(const KeyComparator &comparator, const char *key, bool *found /* = nullptr */) const
 {
-  const int                    size = this->size();
-  common::BinaryIterator<char> iter_begin(item_size(), __key_at(0));
-  common::BinaryIterator<char> iter_end(item_size(), __key_at(size));
-  common::BinaryIterator<char> iter = lower_bound(iter_begin, iter_end, key, comparator, found);
-  return iter - iter_begin;
+  return lower_bound(comparator, key, 0, size(), found);
 }
 
 RC LeafIndexNodeHandler::insert(int index, const char *key, const char *value)
@@ -251,7 +532,9 @@ RC LeafIndexNodeHandler::remove(int index)
 {
   assert(index >= 0 && index < size());
 
-  RC rc = mtr_.logger().node_remove_items(*this, index, span<const char>(__item_at(index), item_size()), 1);
+  vector<char> item;
+  copy_items(index, 1, item);
+  RC rc = mtr_.logger().node_remove_items(*this, index, item, 1);
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to log remove item. rc=%s", strrc(rc));
     return rc;
@@ -272,34 +555,50 @@ int LeafIndexNodeHandler::remove(const char *key, const KeyComparator &comparato
   return 0;
 }
 
+/**
+ * @details 移动过去的第一个键值是两个节点的分界，同时作为当前节点的上界和新节点的下界。
+ * 新节点先设置好上下界再接收元素，当前节点的上界变小，能省略的前缀只会更长
+ */
 RC LeafIndexNodeHandler::move_half_to(LeafIndexNodeHandler &other)
 {
   const int size          = this->size();
   const int move_index    = size / 2;
   const int move_item_num = size - move_index;
 
-  other.append(__item_at(move_index), move_item_num);
+  vector<char> items;
+  copy_items(move_index, move_item_num, items);
+  const char *separator = items.data();
 
-  RC rc = mtr_.logger().node_remove_items(
-      *this, move_index, span<const char>(__item_at(move_index), move_item_num * item_size()), move_item_num);
+  RC rc = other.set_fences(separator, high_fence());
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to set fences of new leaf node. rc=%s", strrc(rc));
+    return rc;
+  }
+  other.append(items.data(), move_item_num);
+
+  rc = mtr_.logger().node_remove_items(*this, move_index, items, move_item_num);
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to log shrink leaf node. rc=%s", strrc(rc));
     return rc;
   }
 
   recover_remove_items(move_index, move_item_num);
-  return RC::SUCCESS;
+  return set_fences(low_fence(), separator);
 }
 RC LeafIndexNodeHandler::move_first_to_end(LeafIndexNodeHandler &other)
 {
-  other.append(__item_at(0));
+  vector<char> item;
+  copy_items(0, 1, item);
+  other.append(item.data());
 
   return this->remove(0);
 }
 
 RC LeafIndexNodeHandler::move_last_to_front(LeafIndexNodeHandler &other)
 {
-  other.preappend(__item_at(size() - 1));
+  vector<char> item;
+  copy_items(size() - 1, 1, item);
+  other.preappend(item.data());
 
   this->remove(size() - 1);
   return RC::SUCCESS;
@@ -309,11 +608,12 @@ RC LeafIndexNodeHandler::move_last_to_front(LeafIndexNodeHandler &other)
  */
 RC LeafIndexNodeHandler::move_to(LeafIndexNodeHandler &other)
 {
-  other.append(__item_at(0), this->size());
+  vector<char> items;
+  copy_items(0, this->size(), items);
+  other.append(items.data(), this->size());
   other.set_next_page(this->next_page());
 
-  RC rc = mtr_.logger().node_remove_items(
-      *this, 0, span<const char>(__item_at(0), this->size() * item_size()), this->size());
+  RC rc = mtr_.logger().node_remove_items(*this, 0, items, this->size());
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to log shrink leaf node. rc=%s", strrc(rc));
   }
@@ -338,15 +638,13 @@ RC LeafIndexNodeHandler::append(const char *item) { return append(item, 1); }
 
 RC LeafIndexNodeHandler::preappend(const char *item) { return insert(0, item, item + key_size()); }
 
-char *LeafIndexNodeHandler::__item_at(int index) const { return leaf_node_->array + (index * item_size()); }
-
 string to_string(const LeafIndexNodeHandler &handler, const KeyPrinter &printer)
 {
   stringstream ss;
   ss << to_string((const IndexNodeHandler &)handler) << ",next page:" << handler.next_page();
-  ss << ",values=[" << printer(handler.__key_at(0));
-  for (int i = 1; i < handler.size(); i++) {
-    ss << "," << printer(handler.__key_at(i));
+  ss << ",values=[";
+  for (int i = 0; i < handler.size(); i++) {
+    ss << (i == 0 ? "" : ",") << printer(handler.key_at(i));
   }
   ss << "]";
   return ss.str();
@@ -359,9 +657,11 @@ bool LeafIndexNodeHandler::validate(const KeyComparator &comparator, DiskBufferP
     return false;
   }
 
-  const int node_size = size();
+  const int    node_size = size();
+  vector<char> prev_key(key_size());
   for (int i = 1; i < node_size; i++) {
-    if (comparator(__key_at(i - 1), __key_at(i)) >= 0) {
+    copy_key(i - 1, prev_key.data());
+    if (comparator(prev_key.data(), key_at(i)) >= 0) {
       LOG_WARN("page number = %d, invalid key order. id1=%d,id2=%d, this=%s",
                page_num(), i - 1, i, to_string(*this).c_str());
       return false;
@@ -390,7 +690,7 @@ bool LeafIndexNodeHandler::validate(const KeyComparator &comparator, DiskBufferP
   }
 
   if (0 != index_in_parent) {
-    int cmp_result = comparator(__key_at(0), parent_node.key_at(index_in_parent));
+    int cmp_result = comparator(key_at(0), parent_node.key_at(index_in_parent));
     if (cmp_result < 0) {
       LOG_WARN("invalid leaf node. first item should be greate than or equal to parent item. "
                "this page num=%d, parent page num=%d, index in parent=%d",
@@ -401,7 +701,7 @@ bool LeafIndexNodeHandler::validate(const KeyComparator &comparator, DiskBufferP
   }
 
   if (index_in_parent < parent_node.size() - 1) {
-    int cmp_result = comparator(__key_at(size() - 1), parent_node.key_at(index_in_parent + 1));
+    int cmp_result = comparator(key_at(size() - 1), parent_node.key_at(index_in_parent + 1));
     if (cmp_result >= 0) {
       LOG_WARN("invalid leaf node. last item should be less than the item at the first after item in parent."
                "this page num=%d, parent page num=%d, parent item to compare=%d",
@@ -410,6 +710,11 @@ bool LeafIndexNodeHandler::validate(const KeyComparator &comparator, DiskBufferP
       return false;
     }
   }
+
+  if (!validate_fences(parent_node, index_in_parent)) {
+    bp->unpin_page(parent_frame);
+    return false;
+  }
   bp->unpin_page(parent_frame);
   return true;
 }
@@ -424,12 +729,10 @@ string to_string(const InternalIndexNodeHandler &node, const KeyPrinter &printer
 {
   stringstream ss;
   ss << to_string((const IndexNodeHandler &)node);
-  ss << ",children:["
-     << "{key:" << printer(node.__key_at(0)) << ","
-     << "value:" << *(PageNum *)node.__value_at(0) << "}";
-
-  for (int i = 1; i < node.size(); i++) {
-    ss << ",{key:" << printer(node.__key_at(i)) << ",value:" << *(PageNum *)node.__value_at(i) << "}";
+  ss << ",children:[";
+  for (int i = 0; i < node.size(); i++) {
+    ss << (i == 0 ? "" : ",") << "{key:" << printer(node.key_at(i)) << ",value:" << *(PageNum *)node.__value_at(i)
+       << "}";
   }
   ss << "]";
   return ss.str();
@@ -451,7 +754,8 @@ RC InternalIndexNodeHandler::create_new_root(PageNum first_page_num, const char
     LOG_WARN("failed to log create new root. rc=%s", strrc(rc));
   }
 
-  memset(__key_at(0), 0, key_size());
+  // 根节点没有上下界，元素中保存完整的键值
+  memset(__item_at(0), 0, key_size());
   memcpy(__value_at(0), &first_page_num, value_size());
   memcpy(__item_at(1), key, key_size());
   memcpy(__value_at(1), &page_num, value_size());
@@ -484,22 +788,33 @@ RC InternalIndexNodeHandler::insert(const char *key, PageNum page_num, const Key
 
 /**
  * @brief move half of the items to the other node ends
+ * @details the first moved key will be inserted into the parent, and it is also the fence between the two nodes
  */
 RC InternalIndexNodeHandler::move_half_to(InternalIndexNodeHandler &other)
 {
   const int size       = this->size();
   const int move_index = size / 2;
   const int move_num   = size - move_index;
-  RC        rc         = other.append(this->__item_at(move_index), size - move_index);
+
+  vector<char> items;
+  copy_items(move_index, move_num, items);
+  const char *separator = items.data();
+
+  RC rc = other.set_fences(separator, high_fence());
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to set fences of new internal node. rc=%d:%s", rc, strrc(rc));
+    return rc;
+  }
+
+  rc = other.append(items.data(), move_num);
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to copy item to new node. rc=%d:%s", rc, strrc(rc));
     return rc;
   }
 
-  mtr_.logger().node_remove_items(
-      *this, move_index, span<const char>(__item_at(move_index), move_num * item_size()), move_num);
+  mtr_.logger().node_remove_items(*this, move_index, items, move_num);
   increase_size(-(size - move_index));
-  return rc;
+  return set_fences(low_fence(), separator);
 }
 
 /**
@@ -521,33 +836,27 @@ int InternalIndexNodeHandler::lookup(const KeyComparator &comparator, const char
     return 0;
   }
 
-  common::BinaryIterator<char> iter_begin(item_size(), __key_at(1));
-  common::BinaryIterator<char> iter_end(item_size(), __key_at(size));
-  common::BinaryIterator<char> iter = lower_bound(iter_begin, iter_end, key, comparator, found);
-  int                          ret  = static_cast<int>(iter - iter_begin) + 1;
+  int ret = lower_bound(comparator, key, 1, size, found);
   if (insert_position) {
     *insert_position = ret;
   }
 
-  if (ret >= size || comparator(key, __key_at(ret)) < 0) {
+  if (ret >= size || comparator(key, key_at(ret)) < 0) {
     return ret - 1;
   }
   return ret;
 }
 
-char *InternalIndexNodeHandler::key_at(int index)
-{
-  assert(index >= 0 && index < size());
-  return __key_at(index);
-}
-
 void InternalIndexNodeHandler::set_key_at(int index, const char *key)
 {
   assert(index >= 0 && index < size());
 
-  mtr_.logger().internal_update_key(
-      *this, index, span<const char>(key, key_size()), span<const char>(__key_at(index), key_size()));
-  memcpy(__key_at(index), key, key_size());
+  vector<char> old_key(key_size());
+  copy_key(index, old_key.data());
+  mtr_.logger().internal_update_key(*this, index, span<const char>(key, key_size()), old_key);
+
+  // 新的键值同样在上下界的范围内，省略公共前缀
+  memcpy(__item_at(index), key + prefix_length(), key_size() - prefix_length());
 }
 
 PageNum InternalIndexNodeHandler::value_at(int index)
@@ -570,8 +879,10 @@ void InternalIndexNodeHandler::remove(int index)
 {
   assert(index >= 0 && index < size());
 
+  vector<char> item;
+  copy_items(index, 1, item);
   BplusTreeLogger &logger = mtr_.logger();
-  RC               rc     = logger.node_remove_items(*this, index, span<const char>(__item_at(index), item_size()), 1);
+  RC               rc     = logger.node_remove_items(*this, index, item, 1);
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to log remove item. rc=%s. node=%s", strrc(rc), to_string(*this).c_str());
   }
@@ -581,13 +892,15 @@ void InternalIndexNodeHandler::remove(int index)
 
 RC InternalIndexNodeHandler::move_to(InternalIndexNodeHandler &other)
 {
-  RC rc = other.append(__item_at(0), size());
+  vector<char> items;
+  copy_items(0, size(), items);
+  RC rc = other.append(items.data(), size());
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to copy items to other node. rc=%d:%s", rc, strrc(rc));
     return rc;
   }
 
-  rc = mtr_.logger().node_remove_items(*this, 0, span<const char>(__item_at(0), size() * item_size()), size());
+  rc = mtr_.logger().node_remove_items(*this, 0, items, size());
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to log shrink internal node. rc=%d:%s", rc, strrc(rc));
     return rc;
@@ -598,7 +911,9 @@ RC InternalIndexNodeHandler::move_to(InternalIndexNodeHandler &other)
 
 RC InternalIndexNodeHandler::move_first_to_end(InternalIndexNodeHandler &other)
 {
-  RC rc = other.append(__item_at(0));
+  vector<char> item;
+  copy_items(0, 1, item);
+  RC rc = other.append(item.data());
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to append item to others.");
     return rc;
@@ -610,13 +925,15 @@ RC InternalIndexNodeHandler::move_first_to_end(InternalIndexNodeHandler &other)
 
 RC InternalIndexNodeHandler::move_last_to_front(InternalIndexNodeHandler &other)
 {
-  RC rc = other.preappend(__item_at(size() - 1));
+  vector<char> item;
+  copy_items(size() - 1, 1, item);
+  RC rc = other.preappend(item.data());
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to preappend to others");
     return rc;
   }
 
-  rc = mtr_.logger().node_remove_items(*this, size() - 1, span<const char>(__item_at(size() - 1), item_size()), 1);
+  rc = mtr_.logger().node_remove_items(*this, size() - 1, item, 1);
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to log shrink internal node. rc=%d:%s", rc, strrc(rc));
     return rc;
@@ -666,8 +983,6 @@ RC InternalIndexNodeHandler::append(const char *item) { return this->append(item
 
 RC InternalIndexNodeHandler::preappend(const char *item) { return this->insert_items(0, item, 1); }
 
-char *InternalIndexNodeHandler::__item_at(int index) const { return internal_node_->array + (index * item_size()); }
-
 int InternalIndexNodeHandler::value_size() const { return sizeof(PageNum); }
 
 int InternalIndexNodeHandler::item_size() const { return key_size() + this->value_size(); }
@@ -679,15 +994,24 @@ bool InternalIndexNodeHandler::validate(const KeyComparator &comparator, DiskBuf
     return false;
   }
 
-  const int node_size = size();
+  const int    node_size = size();
+  vector<char> prev_key(key_size());
   for (int i = 2; i < node_size; i++) {
-    if (comparator(__key_at(i - 1), __key_at(i)) >= 0) {
+    copy_key(i - 1, prev_key.data());
+    if (comparator(prev_key.data(), key_at(i)) >= 0) {
       LOG_WARN("page number = %d, invalid key order. id1=%d,id2=%d, this=%s",
           page_num(), i - 1, i, to_string(*this).c_str());
       return false;
     }
   }
 
+  // 内部节点的第一个键值就是下界
+  if (low_fence() != nullptr && node_size > 0 && memcmp(key_at(0), low_fence(), key_size()) != 0) {
+    LOG_WARN("page number = %d, the first key is different from the low fence. this=%s",
+        page_num(), to_string(*this).c_str());
+    return false;
+  }
+
   for (int i = 0; result && i < node_size; i++) {
     PageNum page_num = *(PageNum *)__value_at(i);
     if (page_num < 0) {
@@ -696,7 +1020,7 @@ bool InternalIndexNodeHandler::validate(const KeyComparator &comparator, DiskBuf
       Frame *child_frame = nullptr;
       RC     rc          = bp->get_this_page(page_num, &child_frame);
       if (OB_FAIL(rc)) {
-        LOG_WARN("failed to fetch child page while validate internal page. page num=%d, rc=%d:%s", 
+        LOG_WARN("failed to fetch child page while validate internal page. page num=%d, rc=%d:%s",
                  page_num, rc, strrc(rc));
       } else {
         IndexNodeHandler child_node(mtr_, header_, child_frame);
@@ -737,7 +1061,7 @@ bool InternalIndexNodeHandler::validate(const KeyComparator &comparator, DiskBuf
   }
 
   if (0 != index_in_parent) {
-    int cmp_result = comparator(__key_at(1), parent_node.key_at(index_in_parent));
+    int cmp_result = comparator(key_at(1), parent_node.key_at(index_in_parent));
     if (cmp_result < 0) {
       LOG_WARN("invalid internal node. the second item should be greate than or equal to parent item. "
                "this page num=%d, parent page num=%d, index in parent=%d",
@@ -748,7 +1072,7 @@ bool InternalIndexNodeHandler::validate(const KeyComparator &comparator, DiskBuf
   }
 
   if (index_in_parent < parent_node.size() - 1) {
-    int cmp_result = comparator(__key_at(size() - 1), parent_node.key_at(index_in_parent + 1));
+    int cmp_result = comparator(key_at(size() - 1), parent_node.key_at(index_in_parent + 1));
     if (cmp_result >= 0) {
       LOG_WARN("invalid internal node. last item should be less than the item at the first after item in parent."
                "this page num=%d, parent page num=%d, parent item to compare=%d",
@@ -757,6 +1081,11 @@ bool InternalIndexNodeHandler::validate(const KeyComparator &comparator, DiskBuf
       return false;
     }
   }
+
+  if (!validate_fences(parent_node, index_in_parent)) {
+    bp->unpin_page(parent_frame);
+    return false;
+  }
   bp->unpin_page(parent_frame);
 
   return result;
@@ -914,6 +1243,11 @@ RC BplusTreeHandler::open(LogHandler &log_handler, DiskBufferPool &buffer_pool)
 
   char *pdata = frame->data();
   memcpy(&file_header_, pdata, sizeof(IndexFileHeader));
+  rc = file_header_.check_format();
+  if (OB_FAIL(rc)) {
+    buffer_pool.unpin_page(frame);
+    return rc;
+  }
   header_dirty_     = false;
   disk_buffer_pool_ = &buffer_pool;
   log_handler_      = &log_handler;
@@ -1207,6 +1541,131 @@ RC BplusTreeHandler::find_leaf_internal(BplusTreeMiniTransaction &mtr, BplusTree
   return RC::SUCCESS;
 }
 
+RC BplusTreeHandler::optimistic_find_leaf(BplusTreeMiniTransaction &mtr,
+    const function<PageNum(InternalIndexNodeHandler &)> &child_page_getter, Frame *&frame, uint64_t &version)
+{
+  LatchMemo &latch_memo = mtr.latch_memo();
+
+  // 根节点的页号没有放在页面中，使用 root_version_ 来校验
+  const uint64_t root_version = root_version_.load(std::memory_order_acquire);
+  if ((root_version & 1) != 0) {
+    return RC::LOCKED_NEED_WAIT;
+  }
+
+  auto validate_root = [this, root_version]() {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return root_version_.load(std::memory_order_relaxed) == root_version;
+  };
+
+  const PageNum root_page_num = file_header_.root_page;
+  if (root_page_num == BP_INVALID_PAGE_NUM) {
+    return validate_root() ? RC::EMPTY : RC::LOCKED_NEED_WAIT;
+  }
+
+  RC rc = latch_memo.get_page(root_page_num, frame);
+  if (OB_FAIL(rc)) {
+    if (!validate_root()) {
+      return RC::LOCKED_NEED_WAIT;
+    }
+    LOG_WARN("failed to fetch root page. page id=%d, rc=%d:%s", root_page_num, rc, strrc(rc));
+    return rc;
+  }
+  if (!frame->read_version(version) || !validate_root()) {
+    return RC::LOCKED_NEED_WAIT;
+  }
+
+  while (true) {
+    InternalIndexNodeHandler internal_node(mtr, file_header_, frame);
+    if (!internal_node.freeze_header()) {
+      return RC::LOCKED_NEED_WAIT;
+    }
+    if (internal_node.is_leaf()) {
+      return RC::SUCCESS;
+    }
+    if (internal_node.size() < 1) {
+      return RC::LOCKED_NEED_WAIT;
+    }
+
+    // 读到的页号可能是不一致的数据，必须先校验再访问
+    const PageNum child_page_num = child_page_getter(internal_node);
+    if (!frame->validate_version(version)) {
+      return RC::LOCKED_NEED_WAIT;
+    }
+
+    const int memo_point  = latch_memo.memo_point();
+    Frame    *child_frame = nullptr;
+    rc                    = latch_memo.get_page(child_page_num, child_frame);
+    if (OB_FAIL(rc)) {
+      if (!frame->validate_version(version)) {
+        return RC::LOCKED_NEED_WAIT;
+      }
+      LOG_WARN("failed to load page page_num:%d. rc=%s", child_page_num, strrc(rc));
+      return rc;
+    }
+
+    uint64_t child_version = 0;
+    if (!child_frame->read_version(child_version) || !frame->validate_version(version)) {
+      return RC::LOCKED_NEED_WAIT;
+    }
+
+    latch_memo.release_to(memo_point);  // 子节点是从一致的父节点中找到的，可以释放父节点了
+    frame   = child_frame;
+    version = child_version;
+  }
+}
+
+RC BplusTreeHandler::read_leaf(
+    BplusTreeMiniTransaction &mtr, const char *key, const function<void(LeafIndexNodeHandler &)> &reader)
+{
+  // 冲突太多时说明有写操作正在频繁修改这部分数据，改成加锁读取，避免一直重试
+  static const int MAX_OPTIMISTIC_RETRY = 16;
+
+  auto child_page_getter = [this, key](InternalIndexNodeHandler &internal_node) {
+    return key == nullptr ? internal_node.value_at(0)
+                          : internal_node.value_at(internal_node.lookup(key_comparator_, key));
+  };
+
+  LatchMemo &latch_memo = mtr.latch_memo();
+  for (int i = 0; i < MAX_OPTIMISTIC_RETRY; i++) {
+    Frame   *frame   = nullptr;
+    uint64_t version = 0;
+    RC       rc      = optimistic_find_leaf(mtr, child_page_getter, frame, version);
+    if (OB_SUCC(rc)) {
+      LeafIndexNodeHandler leaf_node(mtr, file_header_, frame);
+      if (!leaf_node.freeze_header() || !leaf_node.is_leaf()) {
+        rc = RC::LOCKED_NEED_WAIT;
+      } else {
+        reader(leaf_node);
+        if (!frame->validate_version(version)) {
+          rc = RC::LOCKED_NEED_WAIT;
+        }
+      }
+    }
+
+    latch_memo.release();
+    if (rc != RC::LOCKED_NEED_WAIT) {
+      return rc;
+    }
+  }
+
+  Frame *frame = nullptr;
+  RC     rc    = RC::SUCCESS;
+  if (nullptr == key) {
+    rc = left_most_page(mtr, frame);
+  } else {
+    rc = find_leaf(mtr, BplusTreeOperationType::READ, key, frame);
+  }
+
+  if (OB_SUCC(rc)) {
+    LeafIndexNodeHandler leaf_node(mtr, file_header_, frame);
+    reader(leaf_node);
+  } else if (rc != RC::EMPTY) {
+    LOG_WARN("failed to find leaf page. rc=%s", strrc(rc));
+  }
+  latch_memo.release();
+  return rc;
+}
+
 RC BplusTreeHandler::crabing_protocal_fetch_page(
     BplusTreeMiniTransaction &mtr, BplusTreeOperationType op, PageNum page_num, bool is_root_node, Frame *&frame)
 {
@@ -1259,7 +1718,8 @@ RC BplusTreeHandler::insert_entry_into_leaf_node(
   new_index_node.set_parent_page_num(leaf_node.parent_page_num());
   leaf_node.set_next_page(new_frame->page_num());
 
-  if (insert_position < leaf_node.size()) {
+  // 新节点的第一个键值已经是两个节点的上下界，不能再改变
+  if (key_comparator_(key, new_index_node.key_at(0)) < 0) {
     leaf_node.insert(insert_position, key, (const char *)rid);
   } else {
     new_index_node.insert(insert_position - leaf_node.size(), key, (const char *)rid);
@@ -1424,7 +1884,10 @@ void BplusTreeHandler::update_root_page_num_locked(BplusTreeMiniTransaction &mtr
   IndexFileHeader *file_header = reinterpret_cast<IndexFileHeader *>(frame->data());
   mtr.logger().update_root_page(frame, root_page_num, file_header->root_page);
   file_header->root_page = root_page_num;
+
+  root_version_.fetch_add(1, std::memory_order_acq_rel);
   file_header_.root_page = root_page_num;
+  root_version_.fetch_add(1, std::memory_order_release);
   header_dirty_          = true;
   frame->mark_dirty();
   LOG_DEBUG("set root page to %d", root_page_num);
@@ -1466,6 +1929,7 @@ MemPoolItem::item_unique_ptr BplusTreeHandler::make_key(const char *user_key, co
   }
   memcpy(static_cast<char *>(key.get()), user_key, file_header_.attr_length);
   memcpy(static_cast<char *>(key.get()) + file_header_.attr_length, &rid, sizeof(rid));
+  file_header_.normalize_key(static_cast<char *>(key.get()));
   return key;
 }
 
@@ -1539,6 +2003,284 @@ RC BplusTreeHandler::get_entry(const char *user_key, int key_len, list<RID> &rid
   return rc;
 }
 
+RC BplusTreeHandler::get_entries(const vector<const char *> &user_keys, vector<RID> &rids)
+{
+  const KeyComparator &comparator = key_comparator_;
+  rids.clear();
+
+  vector<const char *> sorted_keys(user_keys);
+  sort(sorted_keys.begin(), sorted_keys.end(), [&comparator](const char *left, const char *right) {
+    return comparator.compare_key(left, right) < 0;
+  });
+  auto last = unique(sorted_keys.begin(), sorted_keys.end(), [&comparator](const char *left, const char *right) {
+    return comparator.compare_key(left, right) == 0;
+  });
+  sorted_keys.erase(last, sorted_keys.end());
+
+  // 每个值在B+树中的开始位置
+  const int    key_length = file_header_.key_length;
+  const int    key_num    = static_cast<int>(sorted_keys.size());
+  vector<char> start_keys(static_cast<size_t>(key_num) * key_length);
+  for (int i = 0; i < key_num; i++) {
+    char *start_key = start_keys.data() + static_cast<size_t>(i) * key_length;
+    memcpy(start_key, sorted_keys[i], file_header_.attr_length);
+    memcpy(start_key + file_header_.attr_length, RID::min(), sizeof(RID));
+    file_header_.normalize_key(start_key);
+  }
+  auto start_key_at = [&](int index) { return start_keys.data() + static_cast<size_t>(index) * key_length; };
+
+  BplusTreeMiniTransaction mtr(*this);
+
+  int          key_index = 0;
+  vector<char> next_leaf_key;  // 下一个叶子节点的下界
+  vector<RID>  leaf_rids;
+  while (key_index < key_num) {
+    // 当前的值可能在上一个叶子节点中没有找全，需要从下一个叶子节点接着找
+    const char *search_key = start_key_at(key_index);
+    if (!next_leaf_key.empty() && comparator(next_leaf_key.data(), search_key) > 0) {
+      search_key = next_leaf_key.data();
+    }
+
+    int          leaf_key_index = key_index;
+    vector<char> leaf_high_fence;
+    auto         reader = [&](LeafIndexNodeHandler &leaf_node) {
+      leaf_key_index = key_index;
+      leaf_rids.clear();
+      leaf_high_fence.clear();
+
+      const int size  = leaf_node.size();
+      int       index = leaf_node.lookup(comparator, search_key);
+      while (leaf_key_index < key_num && index < size) {
+        const int result = comparator.compare_key(leaf_node.key_at(index), sorted_keys[leaf_key_index]);
+        if (result < 0) {
+          // 跳到当前的值在叶子节点中的位置。乐观读时数据可能不一致，至少向后移动一个位置
+          index = max(index + 1, leaf_node.lookup(comparator, start_key_at(leaf_key_index)));
+        } else if (result == 0) {
+          RID rid;
+          memcpy(&rid, leaf_node.value_at(index), sizeof(rid));
+          leaf_rids.push_back(rid);
+          index++;
+        } else {
+          leaf_key_index++;
+        }
+      }
+
+      const char *high_fence = leaf_node.high_fence();
+      if (index >= size && high_fence != nullptr) {
+        leaf_high_fence.assign(high_fence, high_fence + key_length);
+      }
+    };
+
+    RC rc = read_leaf(mtr, search_key, reader);
+    if (rc == RC::EMPTY) {
+      break;
+    } else if (OB_FAIL(rc)) {
+      LOG_WARN("failed to read leaf. rc=%s", strrc(rc));
+      return rc;
+    }
+
+    rids.insert(rids.end(), leaf_rids.begin(), leaf_rids.end());
+    // 已经到了最右边的叶子节点，剩下的值都不存在
+    key_index     = leaf_high_fence.empty() ? key_num : leaf_key_index;
+    next_leaf_key = std::move(leaf_high_fence);
+  }
+
+  sort(rids.begin(), rids.end(), [](const RID &left, const RID &right) { return RID::compare(&left, &right) < 0; });
+  return RC::SUCCESS;
+}
+
+RC BplusTreeHandler::bulk_load(char *keys, int num, bool unique)
+{
+  if (!is_empty()) {
+    LOG_WARN("cannot bulk load into a non-empty tree. root page=%d", file_header_.root_page);
+    return RC::INTERNAL;
+  }
+
+  if (num <= 0) {
+    return RC::SUCCESS;
+  }
+
+  const int key_length         = file_header_.key_length;
+  const int attr_length        = file_header_.attr_length;
+  const int leaf_item_size     = key_length + static_cast<int>(sizeof(RID));
+  const int internal_item_size = key_length + static_cast<int>(sizeof(PageNum));
+
+  // 只对键值的指针排序，不移动键值本身
+  vector<const char *> sorted_keys(num);
+  for (int i = 0; i < num; i++) {
+    char *key = keys + static_cast<size_t>(i) * key_length;
+    file_header_.normalize_key(key);
+    sorted_keys[i] = key;
+  }
+  sort(sorted_keys.begin(), sorted_keys.end(), [this](const char *key1, const char *key2) {
+    return key_comparator_.compare_for_sort(key1, key2) < 0;
+  });
+
+  if (unique) {
+    for (int i = 1; i < num; i++) {
+      if (key_comparator_.compare_key(sorted_keys[i - 1], sorted_keys[i]) == 0) {
+        LOG_WARN("duplicate key found while bulk loading. key=%s", key_printer_(sorted_keys[i]).c_str());
+        return RC::RECORD_DUPLICATE_KEY;
+      }
+    }
+  }
+
+  // 每一层的页面个数以及每个页面的元素个数只与这一层的键值有关，可以先计算出来。
+  // 每个页面的第一个键值就是上一层的键值，也是页面之间的上下界
+  vector<vector<int>>          level_sizes;
+  vector<vector<const char *>> level_keys;
+  level_keys.push_back(sorted_keys);
+  level_sizes.push_back(bulk_load_page_sizes(file_header_, level_keys.back(), [this](int prefix_length) {
+    return calc_leaf_page_capacity(file_header_.attr_length, prefix_length);
+  }));
+  while (level_sizes.back().size() > 1) {
+    vector<const char *> parent_keys;
+    int                  offset = 0;
+    for (int size : level_sizes.back()) {
+      parent_keys.push_back(level_keys.back()[offset]);
+      offset += size;
+    }
+    level_keys.push_back(std::move(parent_keys));
+    level_sizes.push_back(bulk_load_page_sizes(file_header_, level_keys.back(), [this](int prefix_length) {
+      return calc_internal_page_capacity(file_header_.attr_length, prefix_length);
+    }));
+  }
+
+  // 先分配好所有的页面，写每个页面时就已经知道父节点和兄弟节点的页号，每个页面只需要写一次
+  RC                      rc = RC::SUCCESS;
+  vector<vector<PageNum>> level_pages(level_sizes.size());
+  for (size_t level = 0; level < level_sizes.size(); level++) {
+    for (size_t i = 0; i < level_sizes[level].size(); i++) {
+      Frame *frame = nullptr;
+
+      BplusTreeMiniTransaction mtr(*this);
+      rc = mtr.latch_memo().allocate_page(frame);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to allocate page while bulk loading. rc=%s", strrc(rc));
+        return rc;
+      }
+      level_pages[level].push_back(frame->page_num());
+    }
+  }
+
+  // 从叶子节点开始一层一层地向上写。每个页面的第一个键值和页号，就是上一层的元素
+  vector<char> leaf_items;
+  vector<char> child_items;
+  vector<char> parent_items;
+  for (size_t level = 0; level < level_sizes.size(); level++) {
+    const bool             leaf       = (level == 0);
+    const bool             root_level = (level + 1 == level_sizes.size());
+    const vector<int>     &sizes      = level_sizes[level];
+    const vector<PageNum> &pages      = level_pages[level];
+
+    parent_items.clear();
+    parent_items.reserve(pages.size() * internal_item_size);
+
+    int offset          = 0;  // 当前页面的第一个元素在这一层中的位置
+    int parent_index    = 0;
+    int parent_children = 0;
+    for (size_t i = 0; i < pages.size(); i++) {
+      const char *items = nullptr;
+      if (leaf) {
+        leaf_items.resize(static_cast<size_t>(sizes[i]) * leaf_item_size);
+        for (int j = 0; j < sizes[i]; j++) {
+          const char *key  = sorted_keys[offset + j];
+          char       *item = leaf_items.data() + static_cast<size_t>(j) * leaf_item_size;
+          memcpy(item, key, key_length);
+          memcpy(item + key_length, key + attr_length, sizeof(RID));
+        }
+        items = leaf_items.data();
+      } else {
+        items = child_items.data() + static_cast<size_t>(offset) * internal_item_size;
+      }
+
+      parent_items.insert(parent_items.end(), items, items + key_length);
+      parent_items.insert(parent_items.end(),
+          reinterpret_cast<const char *>(&pages[i]),
+          reinterpret_cast<const char *>(&pages[i]) + sizeof(PageNum));
+
+      PageNum parent_page_num = BP_INVALID_PAGE_NUM;
+      if (!root_level) {
+        parent_page_num = level_pages[level + 1][parent_index];
+        if (++parent_children == level_sizes[level + 1][parent_index]) {
+          parent_index++;
+          parent_children = 0;
+        }
+      }
+      const PageNum next_page_num = (leaf && i + 1 < pages.size()) ? pages[i + 1] : BP_INVALID_PAGE_NUM;
+      const char   *low_fence     = (i > 0) ? items : nullptr;
+      const char   *high_fence    = (i + 1 < pages.size()) ? level_keys[level][offset + sizes[i]] : nullptr;
+
+      rc = bulk_load_page(pages[i], leaf, items, sizes[i], parent_page_num, next_page_num, low_fence, high_fence);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to write page while bulk loading. page=%d, level=%d, rc=%s",
+                 pages[i], static_cast<int>(level), strrc(rc));
+        return rc;
+      }
+      offset += sizes[i];
+    }
+
+    child_items.swap(parent_items);
+  }
+
+  {
+    BplusTreeMiniTransaction mtr(*this, &rc);
+    mtr.latch_memo().xlatch(&root_lock_);
+    update_root_page_num_locked(mtr, level_pages.back().front());
+  }
+
+  LOG_INFO("bulk loaded bplus tree. entries=%d, leaf pages=%d, height=%d, root page=%d",
+           num, static_cast<int>(level_pages.front().size()), static_cast<int>(level_pages.size()),
+           file_header_.root_page);
+  return rc;
+}
+
+RC BplusTreeHandler::bulk_load_page(PageNum page_num, bool leaf, const char *items, int item_num,
+    PageNum parent_page_num, PageNum next_page_num, const char *low_fence, const char *high_fence)
+{
+  RC                       rc = RC::SUCCESS;
+  BplusTreeMiniTransaction mtr(*this, &rc);
+
+  Frame *frame = nullptr;
+  rc           = mtr.latch_memo().get_page(page_num, frame);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to get page. page=%d, rc=%s", page_num, strrc(rc));
+    return rc;
+  }
+  mtr.latch_memo().xlatch(frame);
+
+  unique_ptr<IndexNodeHandler> node;
+  if (leaf) {
+    auto leaf_node = make_unique<LeafIndexNodeHandler>(mtr, file_header_, frame);
+    rc             = leaf_node->init_empty();
+    if (OB_SUCC(rc) && next_page_num != BP_INVALID_PAGE_NUM) {
+      rc = leaf_node->set_next_page(next_page_num);
+    }
+    node = std::move(leaf_node);
+  } else {
+    auto internal_node = make_unique<InternalIndexNodeHandler>(mtr, file_header_, frame);
+    rc                 = internal_node->init_empty();
+    node               = std::move(internal_node);
+  }
+
+  if (OB_SUCC(rc)) {
+    rc = node->set_fences(low_fence, high_fence);
+  }
+  if (OB_SUCC(rc)) {
+    rc = node->bulk_append(items, item_num);
+  }
+  if (OB_SUCC(rc) && parent_page_num != BP_INVALID_PAGE_NUM) {
+    rc = node->set_parent_page_num(parent_page_num);
+  }
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to init page. page=%d, rc=%s", page_num, strrc(rc));
+    return rc;
+  }
+
+  frame->mark_dirty();
+  return rc;
+}
+
 RC BplusTreeHandler::adjust_root(BplusTreeMiniTransaction &mtr, Frame *root_frame)
 {
   LatchMemo &latch_memo = mtr.latch_memo();
@@ -1635,8 +2377,11 @@ RC BplusTreeHandler::coalesce_or_redistribute(BplusTreeMiniTransaction &mtr, Fra
 
   latch_memo.xlatch(neighbor_frame);
 
-  IndexNodeHandlerType neighbor_node(mtr, file_header_, neighbor_frame);
-  if (index_node.size() + neighbor_node.size() > index_node.max_size()) {
+  // 合并之后的上下界是左边节点的下界和右边节点的上界，按照这个范围的公共前缀判断能否放得下
+  IndexNodeHandlerType  neighbor_node(mtr, file_header_, neighbor_frame);
+  IndexNodeHandlerType &left_node  = (index == 0) ? index_node : neighbor_node;
+  IndexNodeHandlerType &right_node = (index == 0) ? neighbor_node : index_node;
+  if (index_node.size() + neighbor_node.size() > left_node.max_size(left_node.low_fence(), right_node.high_fence())) {
     rc = redistribute<IndexNodeHandlerType>(mtr, neighbor_frame, frame, parent_frame, index);
   } else {
     rc = coalesce<IndexNodeHandlerType>(mtr, neighbor_frame, frame, parent_frame, index);
@@ -1682,7 +2427,13 @@ RC BplusTreeHandler::coalesce(
 
   parent_node.remove(index);
   // parent_node.validate(key_comparator_, disk_buffer_pool_, file_id_);
-  RC rc = right_node.move_to(left_node);
+  // 先扩大左边节点的上下界再接收数据
+  RC rc = left_node.set_fences(left_node.low_fence(), right_node.high_fence());
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to set fences of left node. rc=%d:%s", rc, strrc(rc));
+    return rc;
+  }
+  rc = right_node.move_to(left_node);
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to move right node to left. rc=%d:%s", rc, strrc(rc));
     return rc;
@@ -1713,19 +2464,28 @@ RC BplusTreeHandler::redistribute(
   if (neighbor_node.size() < node.size()) {
     LOG_ERROR("got invalid nodes. neighbor node size %d, this node size %d", neighbor_node.size(), node.size());
   }
+  // 移动一个元素之后，两个节点新的分界同时是父节点中的键值和两个节点的上下界。
+  // 接收元素的节点先扩大上下界，它的元素少于 min_size，公共前缀变短也放得下
+  vector<char> separator(file_header_.key_length);
   if (index == 0) {
     // the neighbor is at right
+    memcpy(separator.data(), neighbor_node.key_at(1), separator.size());
+    node.set_fences(node.low_fence(), separator.data());
     neighbor_node.move_first_to_end(node);
+    neighbor_node.set_fences(separator.data(), neighbor_node.high_fence());
     // neighbor_node.validate(key_comparator_, disk_buffer_pool_, file_id_);
     // node.validate(key_comparator_, disk_buffer_pool_, file_id_);
-    parent_node.set_key_at(index + 1, neighbor_node.key_at(0));
+    parent_node.set_key_at(index + 1, separator.data());
     // parent_node.validate(key_comparator_, disk_buffer_pool_, file_id_);
   } else {
     // the neighbor is at left
+    memcpy(separator.data(), neighbor_node.key_at(neighbor_node.size() - 1), separator.size());
+    node.set_fences(separator.data(), node.high_fence());
     neighbor_node.move_last_to_front(node);
+    neighbor_node.set_fences(neighbor_node.low_fence(), separator.data());
     // neighbor_node.validate(key_comparator_, disk_buffer_pool_, file_id_);
     // node.validate(key_comparator_, disk_buffer_pool_, file_id_);
-    parent_node.set_key_at(index, node.key_at(0));
+    parent_node.set_key_at(index, separator.data());
     // parent_node.validate(key_comparator_, disk_buffer_pool_, file_id_);
   }
 
@@ -1768,6 +2528,7 @@ RC BplusTreeHandler::delete_entry(const char *user_key, const RID *rid)
 
   memcpy(key, user_key, file_header_.attr_length);
   memcpy(key + file_header_.attr_length, rid, sizeof(*rid));
+  file_header_.normalize_key(key);
 
   BplusTreeOperationType op = BplusTreeOperationType::DELETE;
 
@@ -1801,16 +2562,15 @@ BplusTreeScanner::~BplusTreeScanner() { close(); }
 RC BplusTreeScanner::open(const char *left_user_key, int left_len, bool left_inclusive, const char *right_user_key,
     int right_len, bool right_inclusive)
 {
-  RC rc = RC::SUCCESS;
   if (inited_) {
     LOG_WARN("tree scanner has been inited");
     return RC::INTERNAL;
   }
 
-  inited_        = true;
-  first_emitted_ = false;
-
-  LatchMemo &latch_memo = mtr_.latch_memo();
+  inited_ = true;
+  rids_.clear();
+  rid_index_ = 0;
+  next_key_.clear();
 
   // 校验输入的键值是否是合法范围
   if (left_user_key && right_user_key) {
@@ -1822,183 +2582,170 @@ RC BplusTreeScanner::open(const char *left_user_key, int left_len, bool left_inc
     }
   }
 
-  if (nullptr == left_user_key) {
-    rc = tree_handler_.left_most_page(mtr_, current_frame_);
-    if (OB_FAIL(rc)) {
-      if (rc == RC::EMPTY) {
-        current_frame_ = nullptr;
-        return RC::SUCCESS;
-      }
-
-      LOG_WARN("failed to find left most page. rc=%s", strrc(rc));
-      return rc;
-    }
-
-    iter_index_ = 0;
-  } else {
-
-    char *fixed_left_key = const_cast<char *>(left_user_key);
-
-    MemPoolItem::item_unique_ptr left_pkey;
-    if (left_inclusive) {
-      left_pkey = tree_handler_.make_key(fixed_left_key, *RID::min());
-    } else {
-      left_pkey = tree_handler_.make_key(fixed_left_key, *RID::max());
-    }
-
-    const char *left_key = (const char *)left_pkey.get();
-
-    if (fixed_left_key != left_user_key) {
-      delete[] fixed_left_key;
-      fixed_left_key = nullptr;
-    }
-
-    rc = tree_handler_.find_leaf(mtr_, BplusTreeOperationType::READ, left_key, current_frame_);
-    if (rc == RC::EMPTY) {
-      rc             = RC::SUCCESS;
-      current_frame_ = nullptr;
-      return rc;
-    } else if (OB_FAIL(rc)) {
-      LOG_WARN("failed to find left page. rc=%s", strrc(rc));
-      return rc;
-    }
-
-    LeafIndexNodeHandler left_node(mtr_, tree_handler_.file_header_, current_frame_);
-    int                  left_index = left_node.lookup(tree_handler_.key_comparator_, left_key);
-    // lookup 返回的是适合插入的位置，还需要判断一下是否在合适的边界范围内
-    if (left_index >= left_node.size()) {  // 超出了当前页，就需要向后移动一个位置
-      const PageNum next_page_num = left_node.next_page();
-      if (next_page_num == BP_INVALID_PAGE_NUM) {  // 这里已经是最后一页，说明当前扫描，没有数据
-        latch_memo.release();
-        current_frame_ = nullptr;
-        return RC::SUCCESS;
-      }
-
-      rc = latch_memo.get_page(next_page_num, current_frame_);
-      if (OB_FAIL(rc)) {
-        LOG_WARN("failed to fetch next page. page num=%d, rc=%s", next_page_num, strrc(rc));
-        return rc;
-      }
-      latch_memo.slatch(current_frame_);
-
-      left_index = 0;
-    }
-    iter_index_ = left_index;
-  }
-
   // 没有指定右边界范围，那么就返回右边界最大值
   if (nullptr == right_user_key) {
     right_key_ = nullptr;
+  } else if (right_inclusive) {
+    right_key_ = tree_handler_.make_key(right_user_key, *RID::max());
   } else {
-
-    char *fixed_right_key = const_cast<char *>(right_user_key);
-    if (right_inclusive) {
-      right_key_ = tree_handler_.make_key(fixed_right_key, *RID::max());
-    } else {
-      right_key_ = tree_handler_.make_key(fixed_right_key, *RID::min());
-    }
-
-    if (fixed_right_key != right_user_key) {
-      delete[] fixed_right_key;
-      fixed_right_key = nullptr;
-    }
+    right_key_ = tree_handler_.make_key(right_user_key, *RID::min());
   }
 
-  if (touch_end()) {
-    current_frame_ = nullptr;
+  if (nullptr == left_user_key) {
+    return fetch_leaf(nullptr);
   }
 
-  return RC::SUCCESS;
-}
-
-void BplusTreeScanner::fetch_item(RID &rid)
-{
-  LeafIndexNodeHandler node(mtr_, tree_handler_.file_header_, current_frame_);
-  memcpy(&rid, node.value_at(iter_index_), sizeof(rid));
+  MemPoolItem::item_unique_ptr left_pkey;
+  if (left_inclusive) {
+    left_pkey = tree_handler_.make_key(left_user_key, *RID::min());
+  } else {
+    left_pkey = tree_handler_.make_key(left_user_key, *RID::max());
+  }
+  return fetch_leaf(static_cast<const char *>(left_pkey.get()));
 }
 
-bool BplusTreeScanner::touch_end()
+RC BplusTreeScanner::fetch_leaf(const char *key)
 {
-  if (right_key_ == nullptr) {
-    return false;
+  RC rc = tree_handler_.read_leaf(mtr_, key, [this, key](LeafIndexNodeHandler &node) { copy_leaf_items(node, key); });
+  if (OB_FAIL(rc)) {
+    rids_.clear();
+    next_key_.clear();
   }
-
-  LeafIndexNodeHandler node(mtr_, tree_handler_.file_header_, current_frame_);
-
-  const char *this_key       = node.key_at(iter_index_);
-  int         compare_result = tree_handler_.key_comparator_(this_key, static_cast<char *>(right_key_.get()));
-  return compare_result > 0;
+  return rc == RC::EMPTY ? RC::SUCCESS : rc;
 }
 
-RC BplusTreeScanner::next_entry(RID &rid)
+void BplusTreeScanner::copy_leaf_items(LeafIndexNodeHandler &node, const char *key)
 {
-  if (nullptr == current_frame_) {
-    return RC::RECORD_EOF;
-  }
+  rids_.clear();
+  rid_index_ = 0;
+  next_key_.clear();
 
-  if (!first_emitted_) {
-    fetch_item(rid);
-    first_emitted_ = true;
-    return RC::SUCCESS;
-  }
-
-  iter_index_++;
+  const KeyComparator &comparator = tree_handler_.key_comparator_;
+  const char          *right_key  = static_cast<const char *>(right_key_.get());
 
-  LeafIndexNodeHandler node(mtr_, tree_handler_.file_header_, current_frame_);
-  if (iter_index_ < node.size()) {
-    if (touch_end()) {
-      return RC::RECORD_EOF;
+  const int size = node.size();
+  for (int i = (nullptr == key) ? 0 : node.lookup(comparator, key); i < size; i++) {
+    if (right_key != nullptr && comparator(node.key_at(i), right_key) > 0) {
+      return;
     }
 
-    fetch_item(rid);
-    return RC::SUCCESS;
+    RID rid;
+    memcpy(&rid, node.value_at(i), sizeof(rid));
+    rids_.push_back(rid);
   }
 
-  RC      rc            = RC::SUCCESS;
-  PageNum next_page_num = node.next_page();
-  if (BP_INVALID_PAGE_NUM == next_page_num) {
-    return RC::RECORD_EOF;
+  // 下一个叶子节点中的键值都不小于当前节点的上界
+  const char *high_fence = node.high_fence();
+  if (high_fence != nullptr && (right_key == nullptr || comparator(high_fence, right_key) <= 0)) {
+    next_key_.assign(high_fence, high_fence + tree_handler_.file_header_.key_length);
   }
+}
 
-  LatchMemo &latch_memo = mtr_.latch_memo();
+RC BplusTreeScanner::next_entry(RID &rid)
+{
+  while (rid_index_ >= rids_.size()) {
+    if (next_key_.empty()) {
+      return RC::RECORD_EOF;
+    }
 
-  const int memo_point = latch_memo.memo_point();
-  rc                   = latch_memo.get_page(next_page_num, current_frame_);
-  if (OB_FAIL(rc)) {
-    LOG_WARN("failed to get next page. page num=%d, rc=%s", next_page_num, strrc(rc));
-    return rc;
-  }
+    vector<char> key = std::move(next_key_);
+    next_key_.clear();
 
-  /**
-   * 如果这里直接去加锁，那可能会造成死锁
-   * 因为这里访问页面的方式顺序与插入、删除的顺序不一样
-   * 如果加锁失败，就由上层做重试
-   */
-  bool locked = latch_memo.try_slatch(current_frame_);
-  if (!locked) {
-    return RC::LOCKED_NEED_WAIT;
+    RC rc = fetch_leaf(key.data());
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to fetch next leaf. rc=%s", strrc(rc));
+      return rc;
+    }
   }
 
-  latch_memo.release_to(memo_point);
-  iter_index_ = -1;  // `next` will add 1
-  return next_entry(rid);
+  rid = rids_[rid_index_++];
+  return RC::SUCCESS;
 }
 
 RC BplusTreeScanner::close()
 {
   inited_ = false;
+  rids_.clear();
+  next_key_.clear();
   LOG_TRACE("bplus tree scanner closed");
   return RC::SUCCESS;
 }
 
 RC IndexFileHeader::init(const IndexMeta &index)
 {
-  root_page   = BP_INVALID_PAGE_NUM;
+  magic          = MAGIC;
+  format_version = FORMAT_VERSION;
+  root_page      = BP_INVALID_PAGE_NUM;
   attr_length = index.fields_total_len();
   key_length  = attr_length + static_cast<int>(sizeof(RID));
 
   internal_max_size = calc_internal_page_capacity(index.fields_total_len());
   leaf_max_size     = calc_leaf_page_capacity(index.fields_total_len());
 
+  // 键值开头连续的字符串字段可以做前缀压缩
+  prefix_field_num = 0;
+  memset(prefix_field_len, 0, sizeof(prefix_field_len));
+  memset(prefix_field_nullable, 0, sizeof(prefix_field_nullable));
+  for (const FieldMeta &field : index.fields()) {
+    if (field.type() != AttrType::CHARS || prefix_field_num >= MAX_PREFIX_FIELD_NUM) {
+      break;
+    }
+    prefix_field_len[prefix_field_num]      = field.len();
+    prefix_field_nullable[prefix_field_num] = field.nullable();
+    prefix_field_num++;
+  }
+
   return RC::SUCCESS;
 }
+
+RC IndexFileHeader::check_format() const
+{
+  if (magic != MAGIC) {
+    LOG_ERROR("not a b+tree index file. magic=%x, expected=%x", magic, MAGIC);
+    return RC::INDEX_FORMAT_MISMATCH;
+  }
+  if (format_version != FORMAT_VERSION) {
+    LOG_ERROR("unsupported b+tree index format version. version=%d, expected=%d. please rebuild the index",
+              format_version, FORMAT_VERSION);
+    return RC::INDEX_FORMAT_MISMATCH;
+  }
+  return RC::SUCCESS;
+}
+
+int IndexFileHeader::common_prefix_length(const char *key1, const char *key2) const
+{
+  int length = 0;
+  for (int i = 0; i < prefix_field_num; i++) {
+    // NULL 值的比较规则与字符串不同，不能参与前缀压缩
+    const int field_len = prefix_field_len[i];
+    if (prefix_field_nullable[i] && (key1[length + field_len - 1] == '1' || key2[length + field_len - 1] == '1')) {
+      break;
+    }
+
+    int same_len = 0;
+    while (same_len < field_len && key1[length + same_len] == key2[length + same_len]) {
+      same_len++;
+    }
+    length += same_len;
+    if (same_len < field_len) {
+      break;
+    }
+  }
+  return length;
+}
+
+void IndexFileHeader::normalize_key(char *key) const
+{
+  int offset = 0;
+  for (int i = 0; i < prefix_field_num; i++) {
+    char     *data     = key + offset;
+    const int data_len = prefix_field_nullable[i] ? prefix_field_len[i] - 1 : prefix_field_len[i];
+    if (prefix_field_nullable[i] && data[data_len] == '1') {
+      memset(data, 0, data_len);
+    } else {
+      const int str_len = static_cast<int>(strnlen(data, data_len));
+      memset(data + str_len, 0, data_len - str_len);
+    }
+    offset += prefix_field_len[i];
+  }
+}
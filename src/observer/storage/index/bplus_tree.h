@@ -19,6 +19,7 @@ See the Mulan PSL v2 for more details. */
 
 #include <string.h>
 
+#include "common/lang/atomic.h"
 #include "common/lang/comparator.h"
 #include "common/lang/memory.h"
 #include "common/lang/sstream.h"
@@ -126,6 +127,39 @@ public:
     return 0;
   }
 
+  /**
+   * @brief 排序时使用的比较
+   * @details compare_key 中NULL与任何值比较都返回-1，两个NULL互相比较时不满足严格弱序，不能直接用来排序。
+   * 这里认为NULL之间相等并且小于其它值，与逐条插入时NULL总是放在最前面的结果一致
+   */
+  int compare_for_sort(const char *v1, const char *v2) const
+  {
+    auto  field_number  = index_.fields().size();
+    auto &fields_offset = index_.fields_offset();
+    for (size_t i = 0; i < field_number; i++) {
+      int   offset = fields_offset[i];
+      auto &field  = index_.fields()[i];
+      if (field.nullable()) {
+        bool v1_is_null = v1[offset + field.len() - 1] == '1';
+        bool v2_is_null = v2[offset + field.len() - 1] == '1';
+        if (v1_is_null || v2_is_null) {
+          if (v1_is_null && v2_is_null) {
+            continue;
+          }
+          return v1_is_null ? -1 : 1;
+        }
+      }
+      int result = attr_comparator_[i](v1 + offset, v2 + offset);
+      if (result != 0) {
+        return result;
+      }
+    }
+
+    const RID *rid1 = (const RID *)(v1 + index_.fields_total_len());
+    const RID *rid2 = (const RID *)(v2 + index_.fields_total_len());
+    return RID::compare(rid1, rid2);
+  }
+
   int operator()(const char *v1, const char *v2) const
   {
     auto result = compare_key(v1, v2);
@@ -174,23 +208,56 @@ private:
  */
 struct IndexFileHeader
 {
+  /// 最多有几个字段参与前缀压缩
+  static constexpr int MAX_PREFIX_FIELD_NUM = 8;
+  /// 索引文件的魔数，用来识别不是B+树索引的文件
+  static constexpr uint32_t MAGIC = 0x4D4F4258;
+  /// 页面格式的版本号，节点的存储格式变化时(比如增加了边界键值和前缀压缩)需要增加
+  static constexpr int32_t FORMAT_VERSION = 2;
+
   RC init(const IndexMeta &index);
 
-  PageNum root_page = BP_INVALID_PAGE_NUM;  ///< 根节点在磁盘中的页号
-  int32_t internal_max_size;                ///< 内部节点最大的键值对数
-  int32_t leaf_max_size;                    ///< 叶子节点最大的键值对数
-  int32_t attr_length;                      ///< 字段部分的长度
-  int32_t key_length;                       ///< 键的长度
+  /**
+   * @brief 检查从磁盘读出来的文件头是不是当前版本可以识别的格式
+   */
+  RC check_format() const;
+
+  /**
+   * @brief 计算两个键值可以压缩掉的公共前缀长度
+   * @details 只有键值开头连续的字符串字段可以压缩。字符串规范化之后，字节序与比较的结果一致，
+   * 所以两个键值之间的所有键值也都有这个前缀。遇到NULL值或者不相同的字节就停下来。
+   */
+  int common_prefix_length(const char *key1, const char *key2) const;
+
+  /**
+   * @brief 规范化键值
+   * @details 把字符串结束符之后的字节以及NULL字段的数据都清零，不影响比较的结果，
+   * 但是这样存储的键值才能按照字节计算公共前缀
+   */
+  void normalize_key(char *key) const;
+
+  uint32_t magic          = MAGIC;                       ///< 魔数
+  int32_t  format_version = FORMAT_VERSION;              ///< 页面格式的版本号
+  PageNum  root_page      = BP_INVALID_PAGE_NUM;         ///< 根节点在磁盘中的页号
+  int32_t  internal_max_size;                            ///< 内部节点最大的键值对数(不做前缀压缩时)
+  int32_t  leaf_max_size;                                ///< 叶子节点最大的键值对数(不做前缀压缩时)
+  int32_t  attr_length;                                  ///< 字段部分的长度
+  int32_t  key_length;                                   ///< 键的长度
+  int32_t  prefix_field_num;                             ///< 键值开头连续的字符串字段个数，这些字段可以做前缀压缩
+  int32_t  prefix_field_len[MAX_PREFIX_FIELD_NUM];       ///< 可以做前缀压缩的字段长度
+  bool     prefix_field_nullable[MAX_PREFIX_FIELD_NUM];  ///< 字段是否可以为NULL，可以为NULL的字段最后一个字节是NULL标记
 
   const string to_string() const
   {
     stringstream ss;
 
-    ss << "attr_length:" << attr_length << ","
+    ss << "format_version:" << format_version << ","
+       << "attr_length:" << attr_length << ","
        << "key_length:" << key_length << ","
        << "root_page:" << root_page << ","
        << "internal_max_size:" << internal_max_size << ","
-       << "leaf_max_size:" << leaf_max_size << ";";
+       << "leaf_max_size:" << leaf_max_size << ","
+       << "prefix_field_num:" << prefix_field_num << ";";
 
     return ss.str();
   }
@@ -201,16 +268,22 @@ struct IndexFileHeader
  * @ingroup BPlusTree
  * @code
  * storage format:
- * | page type | item number | parent page id |
+ * | page type | fence flags | item number | parent page id | prefix length |
  * @endcode
+ * @details 每个节点都记录了自己键值的范围 [low fence, high fence)，就是父节点中指向它的分隔键值。
+ * 最左边的节点没有下界，最右边的节点没有上界。上下界都存在时，它们的公共前缀也是节点中所有键值的公共前缀，
+ * 节点中的键值只存放这个前缀之后的部分，相同的页面可以放下更多的键值。
  */
 struct IndexNode
 {
-  static constexpr int HEADER_SIZE = 12;
-
-  bool    is_leaf;  /// 当前是叶子节点还是内部节点
-  int     key_num;  /// 当前页面上一共有多少个键值对
-  PageNum parent;   /// 父节点页面编号
+  static constexpr int HEADER_SIZE = 16;
+
+  bool    is_leaf;         /// 当前是叶子节点还是内部节点
+  bool    has_low_fence;   /// 是否有下界
+  bool    has_high_fence;  /// 是否有上界
+  int     key_num;         /// 当前页面上一共有多少个键值对
+  PageNum parent;          /// 父节点页面编号
+  int     prefix_length;   /// 所有键值的公共前缀长度，存放键值时省略这部分
 };
 
 /**
@@ -218,12 +291,14 @@ struct IndexNode
  * @ingroup BPlusTree
  * @code
  * storage format:
- * | common header | prev page id | next page id |
- * | key0, rid0 | key1, rid1 | ... | keyn, ridn |
+ * | common header | next page id |
+ * | low fence | high fence |
+ * | key0 suffix, rid0 | key1 suffix, rid1 | ... | keyn suffix, ridn |
  * @endcode
  * the key is in format: the key value of record and rid.
  * so the key in leaf page must be unique.
  * the value is rid.
+ * 上下界都是完整的键值，元素中的键值省略了公共前缀。
  * can you implenment a cluster index ?
  */
 struct LeafIndexNode : public IndexNode
@@ -243,8 +318,10 @@ struct LeafIndexNode : public IndexNode
  * @code
  * storage format:
  * | common header |
+ * | low fence | high fence |
  * | key(0),page_id(0) | key(1), page_id(1) | ... | key(n), page_id(n) |
  * @endcode
+ * 与叶子节点一样，键值省略了公共前缀。
  * the first key is ignored(key0).
  * so it will waste space, can you fix this?
  */
@@ -279,7 +356,7 @@ public:
 
   /// @brief 存储的键值大小
   virtual int key_size() const;
-  /// @brief 存储的值的大小。内部节点和叶子节点是不一样的，但是这里返回的是叶子节点存储的大小
+  /// @brief 存储的值的大小。内部节点和叶子节点是不一样的
   virtual int value_size() const;
   /// @brief 存储的键值对的大小。值是指叶子节点中存放的数据
   virtual int item_size() const;
@@ -292,6 +369,38 @@ public:
   PageNum parent_page_num() const;
   PageNum page_num() const;
 
+  /**
+   * @brief 公共前缀长度为 prefix_length 时，节点最多可以存放多少个元素
+   */
+  int max_size(int prefix_length) const;
+  /**
+   * @brief 节点的上下界设置为指定值时，最多可以存放多少个元素
+   */
+  int max_size(const char *low_fence, const char *high_fence) const;
+
+  /// @brief 节点中所有键值的公共前缀长度
+  int prefix_length() const;
+  /// @brief 节点的下界，没有下界时返回nullptr
+  const char *low_fence() const;
+  /// @brief 节点的上界，没有上界时返回nullptr
+  const char *high_fence() const;
+
+  /**
+   * @brief 设置节点的上下界
+   * @details 上下界决定了公共前缀，前缀变化时会重新编排节点中所有的元素。
+   * 调用者需要保证节点中的键值都在新的范围内，并且前缀变短时依然能放下所有的元素
+   * @param low_fence 下界，nullptr表示没有下界
+   * @param high_fence 上界，nullptr表示没有上界
+   */
+  RC set_fences(const char *low_fence, const char *high_fence);
+
+  /**
+   * @brief 获取指定位置的完整键值
+   * @details 节点中存放的键值省略了公共前缀，这里会把前缀拼回来。
+   * 返回的内存属于当前对象，下次调用 key_at 或 lookup 时就会被覆盖
+   */
+  const char *key_at(int index) const;
+
   /**
    * @brief 判断对指定的操作，是否安全的
    * @details 安全是指在操作执行后，节点不需要调整，比如分裂、合并或重新分配
@@ -305,28 +414,70 @@ public:
    */
   bool validate() const;
 
+  /**
+   * @brief 乐观读时固定页头
+   * @details 乐观读不加锁，页面随时可能被修改。这里先把决定元素位置的页头字段读出来并检查范围，
+   * 之后计算元素位置时都使用这些值，即使读到了不一致的数据也不会越界访问。读到的数据是否有效，
+   * 由调用者校验页面的版本号决定
+   * @return 页头的数据不合理时返回false，说明读到了正在修改的页面
+   */
+  bool freeze_header();
+
   Frame *frame() const { return frame_; }
 
   friend string to_string(const IndexNodeHandler &handler);
 
+  /**
+   * @note 日志中记录的都是完整的元素，写入页面时再省略公共前缀
+   */
   RC recover_insert_items(int index, const char *items, int num);
   RC recover_remove_items(int index, int num);
+  RC recover_set_fences(const char *low_fence, const char *high_fence);
+
+  /**
+   * @brief 在节点的最后追加一批元素，只记录一条日志
+   * @details 批量构建B+树时使用。不会修改子节点的父节点编号，由调用者负责
+   */
+  RC bulk_append(const char *items, int num);
 
 protected:
   /**
-   * @brief 获取指定元素的开始内存位置
-   * @note 这并不是一个纯虚函数，是为了可以直接使用 IndexNodeHandler 类。
-   * 但是使用这个类时，注意不能使用与这个函数相关的函数。
+   * @brief 在 [first, last) 范围内查找第一个不小于key的位置
+   * @details 与 common::lower_bound 一样。公共前缀只复制一次，每次比较时只复制前缀之后的部分
    */
-  virtual char *__item_at(int index) const { return nullptr; }
-  char         *__key_at(int index) const { return __item_at(index); }
-  char         *__value_at(int index) const { return __item_at(index) + key_size(); };
+  int lower_bound(const KeyComparator &comparator, const char *key, int first, int last, bool *found) const;
+
+  /**
+   * @brief 检查上下界与父节点中指向当前节点的分隔键值一致
+   */
+  bool validate_fences(const IndexNodeHandler &parent_node, int index_in_parent) const;
+
+  /// @brief 复制指定位置的完整键值
+  void copy_key(int index, char *key) const;
+  /// @brief 复制一些完整的元素，用于记录日志或移动到其它节点
+  void copy_items(int index, int num, vector<char> &items) const;
+
+  /// @brief 存放上下界的位置，元素存放在上下界之后
+  char *__fences() const;
+  /// @brief 元素在页面中存放的大小，省略了公共前缀
+  int   __slot_size() const { return item_size() - prefix_length(); }
+  /// @brief 获取指定元素的开始内存位置。注意这里的键值是省略了公共前缀的
+  char *__item_at(int index) const { return __fences() + 2 * key_size() + index * __slot_size(); }
+  char *__value_at(int index) const { return __item_at(index) + key_size() - prefix_length(); }
 
 protected:
   BplusTreeMiniTransaction &mtr_;
   const IndexFileHeader    &header_;
   Frame                    *frame_ = nullptr;
   IndexNode                *node_  = nullptr;
+
+  mutable vector<char> key_buffer_;  /// 拼接完整键值时使用的内存
+
+  /// 乐观读时固定下来的页头，参考 freeze_header
+  bool frozen_               = false;
+  bool frozen_is_leaf_       = false;
+  int  frozen_size_          = 0;
+  int  frozen_prefix_length_ = 0;
 };
 
 /**
@@ -343,7 +494,6 @@ public:
   RC      set_next_page(PageNum page_num);
   PageNum next_page() const;
 
-  char *key_at(int index);
   char *value_at(int index);
 
   /**
@@ -368,8 +518,6 @@ public:
   friend string to_string(const LeafIndexNodeHandler &handler, const KeyPrinter &printer);
 
 protected:
-  char *__item_at(int index) const override;
-
   RC append(const char *items, int num);
   RC append(const char *item);
   RC preappend(const char *item);
@@ -392,7 +540,6 @@ public:
   RC create_new_root(PageNum first_page_num, const char *key, PageNum page_num);
 
   RC      insert(const char *key, PageNum page_num, const KeyComparator &comparator);
-  char   *key_at(int index);
   PageNum value_at(int index);
 
   /**
@@ -434,8 +581,6 @@ private:
   RC preappend(const char *item);
 
 private:
-  char *__item_at(int index) const override;
-
   int value_size() const override;
   int item_size() const override;
 
@@ -501,6 +646,25 @@ public:
    */
   RC get_entry(const char *user_key, int key_len, list<RID> &rids);
 
+  /**
+   * @brief 批量查找多个值
+   * @details 先将要查找的值排序去重，再按顺序查找。下一个值还在当前叶子节点中时不会重新从根节点查找，
+   * 每个叶子节点最多读取一次。返回的RID按照页面排序，读取记录时每个页面只需要访问一次
+   * @param user_keys 要查找的值，长度都是 attr_length
+   * @param[out] rids 所有匹配的记录位置
+   */
+  RC get_entries(const vector<const char *> &user_keys, vector<RID> &rids);
+
+  /**
+   * @brief 批量构建B+树
+   * @details 只能在空的B+树上使用，比如创建索引时。先将所有的键值排序，再自底向上一层一层地填充页面。
+   * 每个页面只写一次，也只记录一次日志，不需要像逐条插入那样每次都从根节点查找、加锁以及分裂页面。
+   * @param keys 所有的键值，每个键值由user_key和RID组成，长度是 key_length，不需要有序。会在原地规范化
+   * @param num 键值的个数
+   * @param unique 是否唯一索引。有重复的user_key时返回 RECORD_DUPLICATE_KEY
+   */
+  RC bulk_load(char *keys, int num, bool unique);
+
   RC sync();
 
   /**
@@ -567,6 +731,31 @@ protected:
   RC find_leaf_internal(BplusTreeMiniTransaction &mtr, BplusTreeOperationType op,
       const function<PageNum(InternalIndexNodeHandler &)> &child_page_getter, Frame *&frame);
 
+  /**
+   * @brief 乐观地查找叶子节点(optimistic latch coupling)
+   * @details 从根节点向下查找时不加锁，只pin住页面。从父节点中找到子节点的页号后校验父节点的版本号，
+   * 读到子节点的版本号后再校验一次，保证子节点确实是从一致的父节点中找到的，然后才释放父节点。
+   * 只有写操作会加锁，读操作之间、读写操作之间都不会互相阻塞
+   * @param child_page_getter 用于获取子节点的函数
+   * @param[out] frame 返回找到的叶子节点，只pin住没有加锁
+   * @param[out] version 叶子节点的版本号，调用者读完叶子节点后需要校验
+   * @return 与写操作冲突时返回 RC::LOCKED_NEED_WAIT，由调用者重试
+   */
+  RC optimistic_find_leaf(BplusTreeMiniTransaction &mtr,
+      const function<PageNum(InternalIndexNodeHandler &)> &child_page_getter, Frame *&frame, uint64_t &version);
+
+  /**
+   * @brief 读取包含key的叶子节点
+   * @details 先乐观地读取，与写操作冲突的次数太多时，再加读锁读取。读取完成后就释放页面。
+   * reader 可能会被调用多次，只有最后一次读到的数据是有效的，所以每次调用都要丢弃上次的结果。
+   * 乐观读时 reader 看到的可能是不一致的数据，不能依赖数据的内容决定循环能否结束
+   * @param key 完整的键值，nullptr表示最左边的叶子节点
+   * @param reader 读取叶子节点中的数据
+   * @return B+树是空的时返回 RC::EMPTY，不会调用 reader
+   */
+  RC read_leaf(
+      BplusTreeMiniTransaction &mtr, const char *key, const function<void(LeafIndexNodeHandler &)> &reader);
+
   /**
    * @brief 使用crabing protocol 获取页面
    */
@@ -631,6 +820,13 @@ protected:
    */
   RC adjust_root(BplusTreeMiniTransaction &mtr, Frame *root_frame);
 
+  /**
+   * @brief 批量构建B+树时写入一个页面
+   * @details 页面已经分配好了，一次写入上下界、所有的元素、父节点以及下一个兄弟节点的页号
+   */
+  RC bulk_load_page(PageNum page_num, bool leaf, const char *items, int item_num, PageNum parent_page_num,
+      PageNum next_page_num, const char *low_fence, const char *high_fence);
+
 private:
   common::MemPoolItem::item_unique_ptr make_key(const char *user_key, const RID &rid);
 
@@ -645,6 +841,9 @@ protected:
   // 这个锁可以使用递归读写锁，但是这里偷懒先不改
   common::SharedMutex root_lock_;
 
+  /// 乐观读使用的根节点页号的版本号，与页面的版本号一样，修改根节点页号时是奇数
+  atomic<uint64_t> root_version_{0};
+
   KeyComparator key_comparator_;
   KeyPrinter    key_printer_;
 
@@ -684,8 +883,8 @@ public:
    * @param rid 当前默认所有值都是RID类型。对B+树来说并不是一个好的抽象
    * @return RC RECORD_EOF 表示遍历完成
    * TODO 需要增加返回 key 的接口
-   * @warning 不要在遍历时删除数据。删除数据会导致遍历器失效。
-   * 当前默认的走索引删除的逻辑就是这样做的，所以删除逻辑有BUG。
+   * @note 每次读取一整个叶子节点中的数据，读完就释放页面，不会在两次调用之间持有页面。
+   * 遍历时其它线程修改的数据，如果所在的叶子节点已经读过了，就不会看到
    */
   RC next_entry(RID &rid);
 
@@ -696,23 +895,26 @@ public:
   RC close();
 
 private:
-  void fetch_item(RID &rid);
+  /**
+   * @brief 读取包含key的叶子节点中在扫描范围内的数据
+   * @param key 从第一个不小于key的位置开始读取。nullptr表示从最左边的叶子节点开始
+   */
+  RC fetch_leaf(const char *key);
 
   /**
-   * @brief 判断是否到了扫描的结束位置
+   * @brief 复制叶子节点中从key开始的数据，并记录下一个叶子节点的开始位置
    */
-  bool touch_end();
+  void copy_leaf_items(LeafIndexNodeHandler &node, const char *key);
 
 private:
   bool                     inited_ = false;
   BplusTreeHandler        &tree_handler_;
   BplusTreeMiniTransaction mtr_;
 
-  /// 使用左右叶子节点和位置来表示扫描的起始位置和终止位置
-  /// 起始位置和终止位置都是有效的数据
-  Frame *current_frame_ = nullptr;
-
   common::MemPoolItem::item_unique_ptr right_key_;
-  int                                  iter_index_    = -1;
-  bool                                 first_emitted_ = false;
+
+  vector<RID> rids_;           /// 当前叶子节点中在扫描范围内的数据
+  size_t      rid_index_ = 0;  /// 下一个要返回的数据
+  /// 下一次从这个键值开始读取，也就是上一个叶子节点的上界。为空表示已经到了扫描的结束位置
+  vector<char> next_key_;
 };
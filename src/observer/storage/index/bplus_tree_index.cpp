@@ -82,10 +82,11 @@ RC BplusTreeIndex::close()
 
 RC BplusTreeIndex::insert_entry(const char *record, const RID *rid)
 {
-  char *entry = index_meta_.make_entry_from_record(record);
+  vector<char> entry(index_meta_.fields_total_len());
+  index_meta_.make_entry_from_record(entry.data(), record);
   if (index_meta_.unique()) {
     list<RID> entries;
-    RC        rc = index_handler_.get_entry(entry, index_meta_.fields_total_len(), entries);
+    RC        rc = index_handler_.get_entry(entry.data(), index_meta_.fields_total_len(), entries);
     if (OB_FAIL(rc)) {
       return rc;
     }
@@ -94,13 +95,61 @@ RC BplusTreeIndex::insert_entry(const char *record, const RID *rid)
     }
   }
 
-  return index_handler_.insert_entry(entry, rid);
+  return index_handler_.insert_entry(entry.data(), rid);
 }
 
 RC BplusTreeIndex::delete_entry(const char *record, const RID *rid)
 {
-  char *entry = index_meta_.make_entry_from_record(record);
-  return index_handler_.delete_entry(entry, rid);
+  vector<char> entry(index_meta_.fields_total_len());
+  index_meta_.make_entry_from_record(entry.data(), record);
+  return index_handler_.delete_entry(entry.data(), rid);
+}
+
+RC BplusTreeIndex::bulk_load(const function<RC(Record &)> &next_record, int64_t memory_limit)
+{
+  const int attr_length = index_meta_.fields_total_len();
+  const int key_length  = attr_length + static_cast<int>(sizeof(RID));
+
+  RC           rc = RC::SUCCESS;
+  vector<char> keys;
+  int          num = 0;
+  Record       record;
+  while (static_cast<int64_t>(keys.size()) < memory_limit && OB_SUCC(rc = next_record(record))) {
+    keys.resize(keys.size() + key_length);
+    char *key = keys.data() + static_cast<size_t>(num) * key_length;
+    index_meta_.make_entry_from_record(key, record.data());
+    memcpy(key + attr_length, &record.rid(), sizeof(RID));
+    num++;
+  }
+
+  if (OB_FAIL(rc) && rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to fetch record while bulk loading index. index=%s, rc=%s", index_meta_.name(), strrc(rc));
+    return rc;
+  }
+
+  const bool has_more = OB_SUCC(rc);
+  rc                  = index_handler_.bulk_load(keys.data(), num, index_meta_.unique());
+  if (OB_FAIL(rc) || !has_more) {
+    return rc;
+  }
+
+  // 超过内存限制了，剩下的记录逐条插入
+  LOG_INFO("too many keys to bulk load index, insert the rest one by one. index=%s, bulk loaded=%d, memory limit=%ld",
+           index_meta_.name(), num, memory_limit);
+  vector<char>().swap(keys);
+  while (OB_SUCC(rc = next_record(record))) {
+    rc = insert_entry(record.data(), &record.rid());
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to insert entry while bulk loading index. index=%s, rc=%s", index_meta_.name(), strrc(rc));
+      return rc;
+    }
+  }
+
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to fetch record while bulk loading index. index=%s, rc=%s", index_meta_.name(), strrc(rc));
+    return rc;
+  }
+  return RC::SUCCESS;
 }
 
 IndexScanner *BplusTreeIndex::create_scanner(
@@ -116,6 +165,11 @@ IndexScanner *BplusTreeIndex::create_scanner(
   return index_scanner;
 }
 
+RC BplusTreeIndex::get_entries(const vector<const char *> &keys, vector<RID> &rids)
+{
+  return index_handler_.get_entries(keys, rids);
+}
+
 RC BplusTreeIndex::sync() { return index_handler_.sync(); }
 
 ////////////////////////////////////////////////////////////////////////////////
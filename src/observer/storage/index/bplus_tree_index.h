@@ -23,6 +23,10 @@ See the Mulan PSL v2 for more details. */
  */
 class BplusTreeIndex : public Index
 {
+public:
+  /// 批量构建索引时，收集的键值最多占用多少内存
+  static constexpr int64_t BULK_LOAD_MEMORY_LIMIT = 64 * 1024 * 1024;
+
 public:
   BplusTreeIndex() = default;
   virtual ~BplusTreeIndex() noexcept;
@@ -36,12 +40,25 @@ public:
   RC insert_entry(const char *record, const RID *rid) override;
   RC delete_entry(const char *record, const RID *rid) override;
 
+  /**
+   * @brief 使用已有的数据批量构建索引
+   * @details 只能用于空的索引，比如创建索引时。先收集所有记录的键值，排序后自底向上构建B+树，
+   * 比逐条调用 insert_entry 快很多。唯一索引有重复的键值时返回 RECORD_DUPLICATE_KEY。
+   * B+树规划每一层的页面时需要看到所有的键值，所以键值都放在内存中。收集的键值超过 memory_limit 时，
+   * 先用已经收集的键值构建B+树，剩下的记录再逐条插入
+   * @param next_record 依次返回每一条记录，没有更多的记录时返回 RECORD_EOF
+   * @param memory_limit 收集的键值最多占用多少内存
+   */
+  RC bulk_load(const function<RC(Record &)> &next_record, int64_t memory_limit = BULK_LOAD_MEMORY_LIMIT);
+
   /**
    * 扫描指定范围的数据
    */
   IndexScanner *create_scanner(const char *left_key, int left_len, bool left_inclusive, const char *right_key,
       int right_len, bool right_inclusive) override;
 
+  RC get_entries(const vector<const char *> &keys, vector<RID> &rids) override;
+
   RC sync() override;
 
 private:
@@ -85,6 +85,13 @@ RC BplusTreeLogger::internal_update_key(
   return append_log_entry(make_unique<InternalUpdateKeyLogEntryHandler>(node_handler.frame(), index, key, old_key));
 }
 
+RC BplusTreeLogger::node_set_fences(IndexNodeHandler &node_handler, span<const char> low_fence,
+    span<const char> high_fence, span<const char> old_low_fence, span<const char> old_high_fence)
+{
+  return append_log_entry(make_unique<NodeSetFencesLogEntryHandler>(
+      node_handler.frame(), low_fence, high_fence, old_low_fence, old_high_fence));
+}
+
 RC BplusTreeLogger::set_parent_page(IndexNodeHandler &node_handler, PageNum page_num, PageNum old_page_num)
 {
   return append_log_entry(make_unique<SetParentPageLogEntryHandler>(node_handler.frame(), page_num, old_page_num));
@@ -116,7 +123,8 @@ RC BplusTreeLogger::commit()
 
   Serializer::BufferType &buffer_data = buffer.data();
 
-  RC rc = log_handler_.append(lsn, LogModule::Id::BPLUS_TREE, std::move(buffer_data));
+  LogLsnGuard lsn_guard(log_handler_);
+  RC          rc = log_handler_.append(lsn, LogModule::Id::BPLUS_TREE, std::move(buffer_data));
   if (RC::SUCCESS != rc) {
     LOG_WARN("failed to append log entry. rc=%s", strrc(rc));
     return rc;
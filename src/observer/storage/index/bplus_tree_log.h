@@ -122,6 +122,13 @@ public:
    */
   RC internal_update_key(IndexNodeHandler &node_handler, int index, span<const char> key, span<const char> old_key);
 
+  /**
+   * @brief 修改某个页面的上下界
+   * @details 空的键值表示没有这个边界。旧的上下界用于回滚
+   */
+  RC node_set_fences(IndexNodeHandler &node_handler, span<const char> low_fence, span<const char> high_fence,
+      span<const char> old_low_fence, span<const char> old_high_fence);
+
   /**
    * @brief 修改某个页面的父节点编号
    */
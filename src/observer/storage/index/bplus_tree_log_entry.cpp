@@ -34,6 +34,7 @@ string LogOperation::to_string() const
     case Type::INTERNAL_UPDATE_KEY: ss << "INTERNAL_UPDATE_KEY"; break;
     case Type::NODE_INSERT: ss << "NODE_INSERT"; break;
     case Type::NODE_REMOVE: ss << "NODE_REMOVE"; break;
+    case Type::NODE_SET_FENCES: ss << "NODE_SET_FENCES"; break;
     default: ss << "INVALID"; break;
   }
   return ss.str();
@@ -172,6 +173,10 @@ RC LogEntryHandler::from_buffer(
       rc = NormalOperationLogEntryHandler::deserialize(frame, operation, buffer, handler);
     } break;
 
+    case LogOperation::Type::NODE_SET_FENCES: {
+      rc = NodeSetFencesLogEntryHandler::deserialize(frame, buffer, handler);
+    } break;
+
     default: {
       LOG_ERROR("unknown log operation. operation=%d:%s", operation.index(), operation.to_string().c_str());
       return RC::INTERNAL;
@@ -561,6 +566,78 @@ RC InternalUpdateKeyLogEntryHandler::redo(BplusTreeMiniTransaction &mtr, BplusTr
   return RC::SUCCESS;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// NodeSetFencesLogEntryHandler
+NodeSetFencesLogEntryHandler::NodeSetFencesLogEntryHandler(Frame *frame, span<const char> low_fence,
+    span<const char> high_fence, span<const char> old_low_fence, span<const char> old_high_fence)
+    : NodeLogEntryHandler(LogOperation::Type::NODE_SET_FENCES, frame),
+      low_fence_(low_fence.begin(), low_fence.end()),
+      high_fence_(high_fence.begin(), high_fence.end()),
+      old_low_fence_(old_low_fence.begin(), old_low_fence.end()),
+      old_high_fence_(old_high_fence.begin(), old_high_fence.end())
+{}
+
+RC NodeSetFencesLogEntryHandler::serialize_body(Serializer &buffer) const
+{
+  buffer.write_int32(static_cast<int32_t>(low_fence_.size()));
+  buffer.write(low_fence_);
+  buffer.write_int32(static_cast<int32_t>(high_fence_.size()));
+  buffer.write(high_fence_);
+  return RC::SUCCESS;
+}
+
+string NodeSetFencesLogEntryHandler::to_string() const
+{
+  stringstream ss;
+  ss << LogEntryHandler::to_string() << ", has_low_fence=" << !low_fence_.empty()
+     << ", has_high_fence=" << !high_fence_.empty();
+  return ss.str();
+}
+
+RC NodeSetFencesLogEntryHandler::deserialize(Frame *frame, Deserializer &buffer, unique_ptr<LogEntryHandler> &handler)
+{
+  int ret = 0;
+
+  int32_t low_size = -1;
+  if ((ret = buffer.read_int32(low_size)) < 0 || low_size < 0) {
+    return RC::INTERNAL;
+  }
+  vector<char> low_fence(low_size);
+  if ((ret = buffer.read(low_fence)) < 0) {
+    return RC::INTERNAL;
+  }
+
+  int32_t high_size = -1;
+  if ((ret = buffer.read_int32(high_size)) < 0 || high_size < 0) {
+    return RC::INTERNAL;
+  }
+  vector<char> high_fence(high_size);
+  if ((ret = buffer.read(high_fence)) < 0) {
+    return RC::INTERNAL;
+  }
+
+  vector<char> old_fence(0);
+  handler = make_unique<NodeSetFencesLogEntryHandler>(frame, low_fence, high_fence, old_fence, old_fence);
+  return RC::SUCCESS;
+}
+
+RC NodeSetFencesLogEntryHandler::rollback(BplusTreeMiniTransaction &mtr, BplusTreeHandler &tree_handler)
+{
+  if (nullptr == frame()) {
+    return RC::INTERNAL;
+  }
+  IndexNodeHandler node_handler(mtr, tree_handler.file_header(), frame());
+  return node_handler.recover_set_fences(old_low_fence_.empty() ? nullptr : old_low_fence_.data(),
+      old_high_fence_.empty() ? nullptr : old_high_fence_.data());
+}
+
+RC NodeSetFencesLogEntryHandler::redo(BplusTreeMiniTransaction &mtr, BplusTreeHandler &tree_handler)
+{
+  IndexNodeHandler node_handler(mtr, tree_handler.file_header(), frame());
+  return node_handler.recover_set_fences(
+      low_fence_.empty() ? nullptr : low_fence_.data(), high_fence_.empty() ? nullptr : high_fence_.data());
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // UpdateRootPageLogEntryHandler
 
@@ -50,6 +50,7 @@ public:
     INTERNAL_UPDATE_KEY,       /// 更新内部节点的key
     NODE_INSERT,               /// 在节点中间(也可能是末尾)插入一些元素
     NODE_REMOVE,               /// 在节点中间(也可能是末尾)删除一些元素
+    NODE_SET_FENCES,           /// 修改节点的上下界
 
     MAX_TYPE,
   };
@@ -376,4 +377,31 @@ private:
   vector<char> old_key_;
 };
 
+/**
+ * @brief 修改节点上下界的日志处理类
+ * @details 空的键值表示没有这个边界。修改上下界可能会改变节点中省略的公共前缀，所以回滚和重做时都要重新编排元素
+ * @ingroup CLog
+ */
+class NodeSetFencesLogEntryHandler : public NodeLogEntryHandler
+{
+public:
+  NodeSetFencesLogEntryHandler(Frame *frame, span<const char> low_fence, span<const char> high_fence,
+      span<const char> old_low_fence, span<const char> old_high_fence);
+  virtual ~NodeSetFencesLogEntryHandler() = default;
+
+  RC serialize_body(common::Serializer &buffer) const override;
+  RC rollback(BplusTreeMiniTransaction &mtr, BplusTreeHandler &tree_handler) override;
+  RC redo(BplusTreeMiniTransaction &mtr, BplusTreeHandler &tree_handler) override;
+
+  string to_string() const override;
+
+  static RC deserialize(Frame *frame, common::Deserializer &buffer, unique_ptr<LogEntryHandler> &handler);
+
+private:
+  vector<char> low_fence_;
+  vector<char> high_fence_;
+  vector<char> old_low_fence_;
+  vector<char> old_high_fence_;
+};
+
 }  // namespace bplus_tree
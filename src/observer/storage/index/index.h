@@ -86,6 +86,15 @@ public:
     return nullptr;
   }
 
+  /**
+   * @brief 批量查找多个值
+   * @details 适合 IN 列表这种一次要查找很多个值的场景。返回的记录位置按照页面排序，
+   * 读取记录时每个页面只需要访问一次
+   * @param keys 要查找的值，每个值的长度都是索引字段的总长度
+   * @param[out] rids 所有匹配的记录位置
+   */
+  virtual RC get_entries(const vector<const char *> &keys, vector<RID> &rids) { return RC::UNSUPPORTED; }
+
   /**
    * @brief 同步索引数据到磁盘
    *
@@ -140,7 +140,10 @@ void LatchMemo::release()
   release_to(point);
 
   for (PageNum page_num : disposed_pages_) {
-    buffer_pool_->dispose_page(page_num);
+    RC rc = buffer_pool_->dispose_page(page_num);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to dispose page. page=%d, rc=%s", page_num, strrc(rc));
+    }
   }
   disposed_pages_.clear();
 }
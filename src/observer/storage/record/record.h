@@ -293,6 +293,7 @@ public:
   char       *data() { return this->data_; }
   const char *data() const { return this->data_; }
   int         len() const { return this->len_; }
+  bool        owner() const { return this->owner_; }  ///< 数据是否是复制出来的，而不是直接指向页面
 
   void set_rid(const RID &rid) { this->rid_ = rid; }
   void set_rid(const PageNum page_num, const SlotNum slot_num)
@@ -101,8 +101,9 @@ RC RecordLogHandler::init_new_page(Frame *frame, PageNum page_num, span<const ch
     memcpy(log_payload.data() + RecordLogHeader::SIZE, data.data(), data.size());
   }
 
-  LSN lsn = 0;
-  RC  rc  = log_handler_->append(lsn, LogModule::Id::RECORD_MANAGER, std::move(log_payload));
+  LogLsnGuard lsn_guard(*log_handler_);
+  LSN         lsn = 0;
+  RC          rc  = log_handler_->append(lsn, LogModule::Id::RECORD_MANAGER, std::move(log_payload));
   if (OB_SUCC(rc) && lsn > 0) {
     frame->set_lsn(lsn);
   }
@@ -121,8 +122,9 @@ RC RecordLogHandler::insert_record(Frame *frame, const RID &rid, const char *rec
   header->storage_format  = static_cast<int>(storage_format_);
   memcpy(log_payload.data() + RecordLogHeader::SIZE, record, record_size_);
 
-  LSN lsn = 0;
-  RC  rc  = log_handler_->append(lsn, LogModule::Id::RECORD_MANAGER, std::move(log_payload));
+  LogLsnGuard lsn_guard(*log_handler_);
+  LSN         lsn = 0;
+  RC          rc  = log_handler_->append(lsn, LogModule::Id::RECORD_MANAGER, std::move(log_payload));
   if (OB_SUCC(rc) && lsn > 0) {
     frame->set_lsn(lsn);
   }
@@ -141,8 +143,9 @@ RC RecordLogHandler::update_record(Frame *frame, const RID &rid, const char *rec
   header->storage_format  = static_cast<int>(storage_format_);
   memcpy(log_payload.data() + RecordLogHeader::SIZE, record, record_size_);
 
-  LSN lsn = 0;
-  RC  rc  = log_handler_->append(lsn, LogModule::Id::RECORD_MANAGER, std::move(log_payload));
+  LogLsnGuard lsn_guard(*log_handler_);
+  LSN         lsn = 0;
+  RC          rc  = log_handler_->append(lsn, LogModule::Id::RECORD_MANAGER, std::move(log_payload));
   if (OB_SUCC(rc) && lsn > 0) {
     frame->set_lsn(lsn);
   }
@@ -158,8 +161,9 @@ RC RecordLogHandler::delete_record(Frame *frame, const RID &rid)
   header.slot_num       = rid.slot_num;
   header.storage_format = static_cast<int>(storage_format_);
 
-  LSN lsn = 0;
-  RC  rc  = log_handler_->append(lsn,
+  LogLsnGuard lsn_guard(*log_handler_);
+  LSN         lsn = 0;
+  RC          rc  = log_handler_->append(lsn,
       LogModule::Id::RECORD_MANAGER,
       span<const char>(reinterpret_cast<const char *>(&header), RecordLogHeader::SIZE));
   if (OB_SUCC(rc) && lsn > 0) {
@@ -12,6 +12,7 @@ See the Mulan PSL v2 for more details. */
 // Created by Meiyi & Longda on 2021/4/13.
 //
 #include "storage/record/record_manager.h"
+#include "common/lang/limits.h"
 #include "common/log/log.h"
 #include "storage/common/condition_filter.h"
 #include "storage/trx/trx.h"
@@ -424,8 +425,58 @@ bool RecordPageHandler::is_full() const { return page_header_->record_num >= pag
 
 RC PaxRecordPageHandler::insert_record(const char *data, RID *rid)
 {
-  // your code here
-  exit(-1);
+  ASSERT(rw_mode_ != ReadWriteMode::READ_ONLY, 
+         "cannot insert record into page while the page is readonly");
+
+  if (page_header_->record_num == page_header_->record_capacity) {
+    LOG_WARN("Page is full, page_num %d:%d.", disk_buffer_pool_->file_desc(), frame_->page_num());
+    return RC::RECORD_NOMEM;
+  }
+
+  // 找到空闲位置
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  int    index = bitmap.next_unsetted_bit(0);
+  bitmap.set_bit(index);
+  page_header_->record_num++;
+
+  RC rc = log_handler_.insert_record(frame_, RID(get_page_num(), index), data);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to insert record. page_num %d:%d. rc=%s", disk_buffer_pool_->file_desc(), frame_->page_num(), strrc(rc));
+    // return rc; // ignore errors
+  }
+
+  split_record(index, data);
+
+  frame_->mark_dirty();
+
+  if (rid) {
+    rid->page_num = get_page_num();
+    rid->slot_num = index;
+  }
+
+  return RC::SUCCESS;
+}
+
+RC PaxRecordPageHandler::recover_insert_record(const char *data, const RID &rid)
+{
+  if (rid.slot_num >= page_header_->record_capacity) {
+    LOG_WARN("slot_num illegal, slot_num(%d) > record_capacity(%d).", rid.slot_num, page_header_->record_capacity);
+    return RC::RECORD_INVALID_RID;
+  }
+
+  // 更新位图
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  if (!bitmap.get_bit(rid.slot_num)) {
+    bitmap.set_bit(rid.slot_num);
+    page_header_->record_num++;
+  }
+
+  // 恢复数据
+  split_record(rid.slot_num, data);
+
+  frame_->mark_dirty();
+
+  return RC::SUCCESS;
 }
 
 RC PaxRecordPageHandler::delete_record(const RID *rid)
@@ -452,17 +503,120 @@ RC PaxRecordPageHandler::delete_record(const RID *rid)
   }
 }
 
+RC PaxRecordPageHandler::update_record(const RID &rid, const char *data)
+{
+  ASSERT(rw_mode_ != ReadWriteMode::READ_ONLY, "cannot update record from page while the page is readonly");
+
+  if (rid.slot_num >= page_header_->record_capacity) {
+    LOG_ERROR("Invalid slot_num %d, exceed page's record capacity, frame=%s, page_header=%s",
+              rid.slot_num, frame_->to_string().c_str(), page_header_->to_string().c_str());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  if (bitmap.get_bit(rid.slot_num)) {
+    frame_->mark_dirty();
+
+    split_record(rid.slot_num, data);
+
+    RC rc = log_handler_.update_record(frame_, rid, data);
+    if (OB_FAIL(rc)) {
+      LOG_ERROR("Failed to update record. page_num %d:%d. rc=%s", 
+                disk_buffer_pool_->file_desc(), frame_->page_num(), strrc(rc));
+      // return rc; // ignore errors
+    }
+
+    return RC::SUCCESS;
+  } else {
+    LOG_DEBUG("Invalid slot_num %d, slot is empty, page_num %d.", rid.slot_num, frame_->page_num());
+    return RC::RECORD_NOT_EXIST;
+  }
+}
+
 RC PaxRecordPageHandler::get_record(const RID &rid, Record &record)
 {
-  // your code here
-  exit(-1);
+  if (rid.slot_num >= page_header_->record_capacity) {
+    LOG_ERROR("Invalid slot_num %d, exceed page's record capacity, frame=%s, page_header=%s",
+              rid.slot_num, frame_->to_string().c_str(), page_header_->to_string().c_str());
+    return RC::RECORD_INVALID_RID;
+  }
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  if (!bitmap.get_bit(rid.slot_num)) {
+    LOG_ERROR("Invalid slot_num:%d, slot is empty, page_num %d.", rid.slot_num, frame_->page_num());
+    return RC::RECORD_NOT_EXIST;
+  }
+
+  // 列数据在页面中不连续，需要复制出来组装成一行
+  RC rc = record.new_record(page_header_->record_real_size);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  assemble_record(rid.slot_num, record.data());
+  record.set_rid(rid);
+  return RC::SUCCESS;
 }
 
 // TODO: specify the column_ids that chunk needed. currenly we get all columns
-RC PaxRecordPageHandler::get_chunk(Chunk &chunk)
+RC PaxRecordPageHandler::get_chunk(Chunk &chunk, SlotNum &start_slot)
 {
-  // your code here
-  exit(-1);
+  const int record_capacity = page_header_->record_capacity;
+
+  Bitmap bitmap(bitmap_, record_capacity);
+  int    begin = start_slot < record_capacity ? bitmap.next_setted_bit(start_slot) : -1;
+  if (begin == -1) {
+    start_slot = record_capacity;
+    return RC::RECORD_EOF;
+  }
+
+  int free_rows = numeric_limits<int>::max();
+  for (int i = 0; i < chunk.column_num(); i++) {
+    free_rows = min(free_rows, chunk.column(i).capacity() - chunk.column(i).count());
+  }
+
+  // 同一列的数据在页面中是连续的，按照连续的有效记录整段复制，chunk 装满时记下位置
+  while (begin != -1 && free_rows > 0) {
+    int end = bitmap.next_unsetted_bit(begin);
+    if (end == -1) {
+      end = record_capacity;
+    }
+    end = min(end, begin + free_rows);
+
+    for (int i = 0; i < chunk.column_num(); i++) {
+      chunk.column(i).append_field_data(get_field_data(begin, chunk.column_ids(i)), end - begin);
+    }
+
+    free_rows -= end - begin;
+    start_slot = end;
+    begin      = end < record_capacity ? bitmap.next_setted_bit(end) : -1;
+  }
+
+  if (begin == -1) {
+    start_slot = record_capacity;
+  }
+  return RC::SUCCESS;
+}
+
+void PaxRecordPageHandler::split_record(SlotNum slot_num, const char *data)
+{
+  // 记录中的字段按照列号依次排列
+  int field_offset = 0;
+  for (int col_id = 0; col_id < page_header_->column_num; col_id++) {
+    const int field_len = get_field_len(col_id);
+    memcpy(get_field_data(slot_num, col_id), data + field_offset, field_len);
+    field_offset += field_len;
+  }
+}
+
+void PaxRecordPageHandler::assemble_record(SlotNum slot_num, char *data)
+{
+  int field_offset = 0;
+  for (int col_id = 0; col_id < page_header_->column_num; col_id++) {
+    const int field_len = get_field_len(col_id);
+    memcpy(data + field_offset, get_field_data(slot_num, col_id), field_len);
+    field_offset += field_len;
+  }
 }
 
 char *PaxRecordPageHandler::get_field_data(SlotNum slot_num, int col_id)
@@ -703,6 +857,37 @@ RC RecordFileHandler::get_record(const RID &rid, Record &record)
   return rc;
 }
 
+RC RecordFileHandler::get_records(const vector<RID> &rids, vector<Record> &records)
+{
+  unique_ptr<RecordPageHandler> page_handler(RecordPageHandler::create(storage_format_));
+
+  records.clear();
+  records.reserve(rids.size());
+
+  RC rc = RC::SUCCESS;
+  for (const RID &rid : rids) {
+    if (page_handler->get_page_num() != rid.page_num) {
+      rc = page_handler->init(*disk_buffer_pool_, *log_handler_, rid.page_num, ReadWriteMode::READ_ONLY);
+      if (OB_FAIL(rc)) {
+        LOG_ERROR("Failed to init record page handler.page number=%d", rid.page_num);
+        return rc;
+      }
+    }
+
+    Record inplace_record;
+    rc = page_handler->get_record(rid, inplace_record);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get record from record page handle. rid=%s, rc=%s", rid.to_string().c_str(), strrc(rc));
+      return rc;
+    }
+
+    Record &record = records.emplace_back();
+    record.copy_data(inplace_record.data(), inplace_record.len());
+    record.set_rid(rid);
+  }
+  return rc;
+}
+
 RC RecordFileHandler::visit_record(const RID &rid, const function<bool(Record &)> &updater)
 {
   unique_ptr<RecordPageHandler> page_handler(RecordPageHandler::create(storage_format_));
@@ -900,12 +1085,13 @@ RC ChunkFileScanner::close_scan()
     delete record_page_handler_;
     record_page_handler_ = nullptr;
   }
+  chunk_slot_ = -1;
 
   return RC::SUCCESS;
 }
 
 RC ChunkFileScanner::open_scan_chunk(
-    Table *table, DiskBufferPool &buffer_pool, LogHandler &log_handler, ReadWriteMode mode)
+    Table *table, DiskBufferPool &buffer_pool, LogHandler &log_handler, ReadWriteMode mode, MorselQueue *morsels)
 {
   close_scan();
 
@@ -913,8 +1099,16 @@ RC ChunkFileScanner::open_scan_chunk(
   disk_buffer_pool_ = &buffer_pool;
   log_handler_      = &log_handler;
   rw_mode_          = mode;
+  morsels_          = morsels;
 
-  RC rc = bp_iterator_.init(buffer_pool, 1);
+  // 并行扫描时先不遍历任何页面，读取数据时再领取
+  RC rc = RC::SUCCESS;
+  if (morsels_ != nullptr) {
+    morsels_->set_page_count(buffer_pool.page_count());
+    rc = bp_iterator_.init(buffer_pool, 1, 1);
+  } else {
+    rc = bp_iterator_.init(buffer_pool, 1);
+  }
   if (rc != RC::SUCCESS) {
     LOG_WARN("failed to init bp iterator. rc=%d:%s", rc, strrc(rc));
     return rc;
@@ -932,23 +1126,39 @@ RC ChunkFileScanner::next_chunk(Chunk &chunk)
 {
   RC rc = RC::SUCCESS;
 
-  while (bp_iterator_.has_next()) {
+  while (true) {
+    if (chunk_slot_ >= 0) {
+      // 当前页面可能还没有读完
+      rc = record_page_handler_->get_chunk(chunk, chunk_slot_);
+      if (OB_SUCC(rc)) {
+        return rc;
+      } else if (rc != RC::RECORD_EOF) {
+        LOG_WARN("failed to get chunk from page. page_num=%d, rc=%s", record_page_handler_->get_page_num(), strrc(rc));
+        return rc;
+      }
+
+      record_page_handler_->cleanup();
+      chunk_slot_ = -1;
+    }
+
+    if (!bp_iterator_.has_next()) {
+      // 当前的 morsel 已经扫描完，领取下一个
+      PageNum begin = 0;
+      PageNum end   = 0;
+      if (morsels_ == nullptr || !morsels_->next(begin, end)) {
+        break;
+      }
+      bp_iterator_.init(*disk_buffer_pool_, begin, end);
+      continue;
+    }
+
     PageNum page_num = bp_iterator_.next();
-    record_page_handler_->cleanup();
     rc = record_page_handler_->init(*disk_buffer_pool_, *log_handler_, page_num, rw_mode_);
     if (OB_FAIL(rc)) {
       LOG_WARN("failed to init record page handler. page_num=%d, rc=%s", page_num, strrc(rc));
       return rc;
     }
-    rc = record_page_handler_->get_chunk(chunk);
-    if (rc == RC::SUCCESS) {
-      return rc;
-    } else if (rc == RC::RECORD_EOF) {
-      break;
-    } else {
-      LOG_WARN("failed to get chunk from page. page_num=%d, rc=%s", page_num, strrc(rc));
-      return rc;
-    }
+    chunk_slot_ = 0;
   }
 
   record_page_handler_->cleanup();
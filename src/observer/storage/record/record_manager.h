@@ -14,8 +14,11 @@ See the Mulan PSL v2 for more details. */
 //
 #pragma once
 
+#include "common/lang/algorithm.h"
+#include "common/lang/atomic.h"
 #include "common/lang/bitmap.h"
 #include "common/lang/sstream.h"
+#include "common/lang/unordered_set.h"
 #include "storage/buffer/disk_buffer_pool.h"
 #include "storage/common/chunk.h"
 #include "storage/record/record.h"
@@ -216,12 +219,14 @@ public:
   virtual RC get_record(const RID &rid, Record &record) { return RC::UNIMPLEMENTED; }
 
   /**
-   * @brief 获取整个页面中指定列的所有记录。
+   * @brief 从指定的槽位开始，获取页面中指定列的记录，直到页面结束或者 chunk 装满。
    *
    * @param chunk 由 chunk.column(i).col_id() 指定列。
+   * @param start_slot 从哪个槽位开始，返回下一次应该开始的槽位
+   * @return 从 start_slot 开始没有记录时返回 RECORD_EOF
    * 只需由 PaxRecordPageHandler 实现。
    */
-  virtual RC get_chunk(Chunk &chunk) { return RC::UNIMPLEMENTED; }
+  virtual RC get_chunk(Chunk &chunk, SlotNum &start_slot) { return RC::UNIMPLEMENTED; }
 
   /**
    * @brief 返回该记录页的页号
@@ -329,8 +334,12 @@ public:
    */
   virtual RC insert_record(const char *data, RID *rid) override;
 
+  virtual RC recover_insert_record(const char *data, const RID &rid) override;
+
   virtual RC delete_record(const RID *rid) override;
 
+  virtual RC update_record(const RID &rid, const char *data) override;
+
   /**
    * @brief 获取指定位置的记录数据
    *
@@ -341,11 +350,13 @@ public:
   virtual RC get_record(const RID &rid, Record &record) override;
 
   /**
-   * @brief 以 Chunk 格式获取整个页面中指定列的所有记录。
+   * @brief 以 Chunk 格式获取页面中指定列的记录。
+   * @details 页面中的记录可能比 chunk 的容量多，装满之后返回，下次从 start_slot 继续。
    *
    * @param chunk 由 chunk.column(i).col_id() 指定列。
+   * @param start_slot 从哪个槽位开始，返回下一次应该开始的槽位
    */
-  virtual RC get_chunk(Chunk &chunk) override;
+  virtual RC get_chunk(Chunk &chunk, SlotNum &start_slot) override;
 
 private:
   // get the field data by `slot_num` and `column id`
@@ -353,6 +364,12 @@ private:
 
   // get the field length by `column id`, all columns are fixed length.
   int get_field_len(int col_id);
+
+  // split the record into columns and write them to the page
+  void split_record(SlotNum slot_num, const char *data);
+
+  // read the columns of the record and assemble them into `data`
+  void assemble_record(SlotNum slot_num, char *data);
 };
 /**
  * @brief 管理整个文件中记录的增删改查
@@ -412,6 +429,14 @@ public:
 
   RC get_record(const RID &rid, Record &record);
 
+  /**
+   * @brief 批量读取记录
+   * @details 连续的多个记录在同一个页面时，只访问一次页面
+   * @param rids 要读取的记录，按照页面排序时效果最好
+   * @param[out] records 读取到的记录，与 rids 一一对应
+   */
+  RC get_records(const vector<RID> &rids, vector<Record> &records);
+
   RC visit_record(const RID &rid, const function<bool(Record &)> &updater);
 
 private:
@@ -493,10 +518,52 @@ private:
   Record             next_record_;                    ///< 获取的记录放在这里缓存起来
 };
 
+/**
+ * @brief 把文件的页面切分成多个连续的小段(morsel)，由多个扫描并发领取
+ * @ingroup RecordManager
+ * @details 并行扫描时每个线程扫描完一个 morsel 再领取下一个，处理得快的线程自然会多扫描一些，
+ * 不需要提前把页面平均分给每个线程。第0个页面是文件头，从第1个页面开始切分。
+ */
+class MorselQueue
+{
+public:
+  static constexpr int DEFAULT_MORSEL_SIZE = 32;  ///< 每个 morsel 的页面个数
+
+  explicit MorselQueue(int morsel_size = DEFAULT_MORSEL_SIZE) : morsel_size_(morsel_size) {}
+
+  /**
+   * @brief 设置需要切分的页面个数
+   * @details 在所有扫描开始领取之前设置，之后新分配的页面不会被扫描
+   */
+  void set_page_count(int page_count) { page_count_ = page_count; }
+
+  /**
+   * @brief 领取下一个 morsel
+   * @param[out] begin 第一个页面
+   * @param[out] end 最后一个页面的下一个页面
+   * @return 所有的页面都已经被领取时返回 false
+   */
+  bool next(PageNum &begin, PageNum &end)
+  {
+    begin = next_page_.fetch_add(morsel_size_);
+    if (begin >= page_count_) {
+      return false;
+    }
+    end = min(begin + morsel_size_, page_count_);
+    return true;
+  }
+
+private:
+  int              morsel_size_ = DEFAULT_MORSEL_SIZE;
+  int              page_count_  = 0;
+  atomic<PageNum> next_page_{1};
+};
+
 /**
  * @brief 遍历某个文件中所有记录，每次返回一个 Chunk
  * @ingroup RecordManager
- * @details 遍历所有的页面，每次以 Chunk 格式返回一个页面内的所有数据
+ * @details 遍历所有的页面，每次以 Chunk 格式返回一个页面内的所有数据。
+ * 指定了 MorselQueue 时只遍历从中领取的页面，多个 ChunkFileScanner 共享同一个 MorselQueue 就可以并行扫描一个文件。
  */
 class ChunkFileScanner
 {
@@ -505,7 +572,11 @@ public:
   ~ChunkFileScanner();
 
   // TODO: not support filter and transaction
-  RC open_scan_chunk(Table *table, DiskBufferPool &buffer_pool, LogHandler &log_handler, ReadWriteMode mode);
+  /**
+   * @param morsels 从哪里领取需要扫描的页面，为空时扫描所有的页面
+   */
+  RC open_scan_chunk(Table *table, DiskBufferPool &buffer_pool, LogHandler &log_handler, ReadWriteMode mode,
+      MorselQueue *morsels = nullptr);
 
   /**
    * @brief 关闭一个文件扫描，释放相应的资源
@@ -513,7 +584,9 @@ public:
   RC close_scan();
 
   /**
-   * @brief 每次调用获取一个页面中的所有记录。
+   * @brief 每次调用最多获取一个页面中的记录。
+   * @details 只读取 Chunk 中已有的列，列的 id 就是字段的 field_id，调用者只需要添加查询用到的字段。
+   * 页面中的记录比 Chunk 的容量多时，分多次返回
    */
   RC next_chunk(Chunk &chunk);
 
@@ -526,4 +599,6 @@ private:
 
   BufferPoolIterator bp_iterator_;                    ///< 遍历buffer pool的所有页面
   RecordPageHandler *record_page_handler_ = nullptr;  ///< 处理文件某页面的记录
+  MorselQueue       *morsels_             = nullptr;  ///< 并行扫描时从这里领取页面
+  SlotNum            chunk_slot_          = -1;       ///< 当前页面下次从哪个槽位开始读取，-1 表示没有打开页面
 };
@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "storage/record/record.h"
 #include "storage/table/table_meta.h"
 #include "storage/buffer/disk_buffer_pool.h"
@@ -30,6 +32,13 @@ public:
   const char      *name() const { return table_meta_.name(); }
   bool             is_mutable() const { return table_meta_.is_mutable(); }
 
+  /**
+   * @brief 数据版本号
+   * @details 表中的数据被修改，或者修改数据的事务提交时递增。查询缓存用它判断缓存的结果是否还有效
+   */
+  uint64_t     data_version() const { return data_version_.load(); }
+  virtual void increase_data_version() { data_version_++; }
+
   /**
    * @brief 根据给定的字段生成一个记录/行
    * @details 通常是由用户传过来的字段，按照schema信息组装成一个record。
@@ -72,4 +81,6 @@ protected:
   string          base_dir_;
   TableMeta       table_meta_{};
   DiskBufferPool *data_buffer_pool_ = nullptr;  /// 数据文件关联的buffer pool
+
+  std::atomic<uint64_t> data_version_{0};  /// 数据版本号，只在内存中维护
 };
@@ -25,6 +25,7 @@ class DiskBufferPool;
 class RecordFileHandler;
 class RecordFileScanner;
 class ChunkFileScanner;
+class MorselQueue;
 class ConditionFilter;
 class DefaultConditionFilter;
 class Index;
@@ -86,7 +87,10 @@ public:
 
   RC get_record_scanner(RecordFileScanner &scanner, Trx *trx, ReadWriteMode mode);
 
-  RC get_chunk_scanner(ChunkFileScanner &scanner, Trx *trx, ReadWriteMode mode);
+  /**
+   * @param morsels 并行扫描时从这里领取需要扫描的页面，参考 MorselQueue
+   */
+  RC get_chunk_scanner(ChunkFileScanner &scanner, Trx *trx, ReadWriteMode mode, MorselQueue *morsels = nullptr);
 
   RecordFileHandler *record_handler() const { return record_handler_; }
 
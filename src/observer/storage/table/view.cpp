@@ -402,3 +402,11 @@ RC View::init_member()
 
   return rc;
 }
+
+void View::increase_data_version()
+{
+  BaseTable::increase_data_version();
+  for (BaseTable *table : tables_) {
+    table->increase_data_version();
+  }
+}
@@ -57,6 +57,9 @@ public:
 
   RC sync() override;
 
+  /// @brief 通过视图修改数据时，实际修改的是基表，基表的版本号也要递增
+  void increase_data_version() override;
+
   const std::string &select_sql() { return select_sql_; }
 
   bool has_join() { return tables_.size() > 1; }
@@ -0,0 +1,59 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/18.
+//
+
+#include "storage/trx/commit_status_table.h"
+
+int32_t CommitStatusTable::commit(int32_t trx_id, atomic<int32_t> &last_trx_id)
+{
+  lock_.lock();
+  const int32_t commit_trx_id = ++last_trx_id;
+  commit_trx_ids_[trx_id]     = commit_trx_id;
+  lock_.unlock();
+  return commit_trx_id;
+}
+
+void CommitStatusTable::add(int32_t trx_id, int32_t commit_trx_id)
+{
+  lock_.lock();
+  commit_trx_ids_[trx_id] = commit_trx_id;
+  lock_.unlock();
+}
+
+bool CommitStatusTable::find(int32_t trx_id, int32_t &commit_trx_id) const
+{
+  bool found = false;
+  lock_.lock_shared();
+  auto iter = commit_trx_ids_.find(trx_id);
+  if (iter != commit_trx_ids_.end()) {
+    commit_trx_id = iter->second;
+    found         = true;
+  }
+  lock_.unlock_shared();
+  return found;
+}
+
+void CommitStatusTable::remove(int32_t trx_id)
+{
+  lock_.lock();
+  commit_trx_ids_.erase(trx_id);
+  lock_.unlock();
+}
+
+size_t CommitStatusTable::size() const
+{
+  lock_.lock_shared();
+  const size_t size = commit_trx_ids_.size();
+  lock_.unlock_shared();
+  return size;
+}
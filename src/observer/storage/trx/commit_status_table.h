@@ -0,0 +1,67 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/18.
+//
+
+#pragma once
+
+#include "common/lang/atomic.h"
+#include "common/lang/mutex.h"
+#include "common/lang/unordered_map.h"
+
+/**
+ * @brief 事务提交状态表
+ * @ingroup Transaction
+ * @details 记录已经提交、但是提交事务号还没有回写到行记录中的事务，即事务号到提交事务号的映射。
+ * 事务修改的行记录上保存的是负的事务号，访问到这样的记录时，先到这里查找事务是否已经提交。
+ * 这样事务提交时只需要在这里增加一项，不需要逐行修改记录，所有修改同时对其它事务可见。
+ * 提交事务号回写到记录之后，就可以把对应的项删除了。
+ */
+class CommitStatusTable final
+{
+public:
+  CommitStatusTable()  = default;
+  ~CommitStatusTable() = default;
+
+  /**
+   * @brief 分配提交事务号并记录事务已经提交
+   * @details 提交事务号在持有写锁时分配。这样新开始的事务拿到的事务号如果比提交事务号大，
+   * 一定可以在这里查到这个事务的提交状态。
+   * @param trx_id 提交的事务号
+   * @param last_trx_id 事务号分配器，提交事务号和事务号使用同一个序列
+   * @return 分配的提交事务号
+   */
+  int32_t commit(int32_t trx_id, atomic<int32_t> &last_trx_id);
+
+  /**
+   * @brief 记录事务已经提交
+   * @details 恢复时使用，提交事务号来自日志
+   */
+  void add(int32_t trx_id, int32_t commit_trx_id);
+
+  /**
+   * @brief 查找事务的提交事务号
+   * @return 事务已经提交并且还没有删除时返回true
+   */
+  bool find(int32_t trx_id, int32_t &commit_trx_id) const;
+
+  /**
+   * @brief 提交事务号已经回写到所有记录，删除这个事务的提交状态
+   */
+  void remove(int32_t trx_id);
+
+  size_t size() const;
+
+private:
+  mutable common::SharedMutex     lock_;
+  unordered_map<int32_t, int32_t> commit_trx_ids_;  ///< 事务号到提交事务号的映射
+};
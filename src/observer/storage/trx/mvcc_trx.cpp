@@ -124,6 +124,168 @@ LogReplayer *MvccTrxKit::create_log_replayer(Db &db, LogHandler &log_handler)
   return new MvccTrxLogReplayer(db, *this, log_handler);
 }
 
+LSN MvccTrxKit::oldest_active_lsn()
+{
+  LSN oldest_lsn = 0;
+  lock_.lock();
+  for (Trx *trx : trxes_) {
+    const LSN lsn = static_cast<MvccTrx *>(trx)->first_lsn();
+    if (lsn != 0 && (oldest_lsn == 0 || lsn < oldest_lsn)) {
+      oldest_lsn = lsn;
+    }
+  }
+  lock_.unlock();
+
+  // 先检查活跃事务再检查回写队列。事务提交时先进入回写队列再清理自己的 first_lsn，这样不会漏掉
+  committed_trxes_lock_.lock();
+  for (const unique_ptr<CommittedTrx> &committed_trx : committed_trxes_) {
+    const LSN lsn = committed_trx->lsn;
+    if (lsn != 0 && (oldest_lsn == 0 || lsn < oldest_lsn)) {
+      oldest_lsn = lsn;
+    }
+  }
+  committed_trxes_lock_.unlock();
+  return oldest_lsn;
+}
+
+void MvccTrxKit::recover_trx_id(int32_t trx_id)
+{
+  lock_.lock();
+  if (current_trx_id_ < trx_id) {
+    current_trx_id_ = trx_id;
+  }
+  lock_.unlock();
+}
+
+void MvccTrxKit::recover_commit(int32_t trx_id, int32_t commit_trx_id)
+{
+  commit_status_.add(trx_id, commit_trx_id);
+  recover_trx_id(commit_trx_id);
+}
+
+MvccTrxKit::CommittedTrx *MvccTrxKit::add_committed_trx(unique_ptr<CommittedTrx> committed_trx)
+{
+  CommittedTrx *ret = committed_trx.get();
+  committed_trxes_lock_.lock();
+  committed_trxes_.push_back(std::move(committed_trx));
+  committed_trxes_lock_.unlock();
+  return ret;
+}
+
+RC MvccTrxKit::write_back_commits()
+{
+  scoped_lock write_back_guard(write_back_lock_);
+  return write_back_commits_internal();
+}
+
+RC MvccTrxKit::write_back_commits_if_need()
+{
+  committed_trxes_lock_.lock();
+  const bool need_write_back = static_cast<int>(committed_trxes_.size()) >= WRITE_BACK_BATCH;
+  committed_trxes_lock_.unlock();
+  if (!need_write_back || !write_back_lock_.try_lock()) {
+    return RC::SUCCESS;
+  }
+
+  RC rc = write_back_commits_internal();
+  write_back_lock_.unlock();
+  return rc;
+}
+
+RC MvccTrxKit::write_back_commits_internal()
+{
+  // 正在回写的事务留在队列中，回写完成之后再删除，这样检查点仍然能看到它的LSN
+  RC rc = RC::SUCCESS;
+  while (true) {
+    CommittedTrx *committed_trx = nullptr;
+    committed_trxes_lock_.lock();
+    if (!committed_trxes_.empty() && committed_trxes_.front()->ready.load()) {
+      committed_trx = committed_trxes_.front().get();
+    }
+    committed_trxes_lock_.unlock();
+
+    if (nullptr == committed_trx) {
+      break;
+    }
+
+    rc = write_back_commit(*committed_trx);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to write back commit trx id. trx id=%d, commit trx id=%d, rc=%s",
+               committed_trx->trx_id, committed_trx->commit_trx_id, strrc(rc));
+      break;
+    }
+
+    // 这之后开始的事务只会读到回写过的记录
+    written_back_trxes_.push_back(WrittenBackTrx{committed_trx->trx_id, current_trx_id_.load()});
+
+    committed_trxes_lock_.lock();
+    committed_trxes_.pop_front();
+    committed_trxes_lock_.unlock();
+  }
+
+  remove_commit_status();
+  return rc;
+}
+
+void MvccTrxKit::remove_commit_status()
+{
+  // 回写之前已经开始的事务可能复制了还是负事务号的记录，比如索引扫描先复制记录，之后才判断可见性。
+  // 这些事务结束之前，提交状态还要留着
+  const int32_t min_active_id = min_active_trx_id();
+  while (!written_back_trxes_.empty() &&
+         (min_active_id == 0 || written_back_trxes_.front().max_trx_id < min_active_id)) {
+    commit_status_.remove(written_back_trxes_.front().trx_id);
+    written_back_trxes_.pop_front();
+  }
+}
+
+int32_t MvccTrxKit::min_active_trx_id()
+{
+  int32_t min_id = 0;
+  lock_.lock();
+  for (Trx *trx : trxes_) {
+    const int32_t trx_id = static_cast<MvccTrx *>(trx)->active_trx_id();
+    if (trx_id != 0 && (min_id == 0 || trx_id < min_id)) {
+      min_id = trx_id;
+    }
+  }
+  lock_.unlock();
+  return min_id;
+}
+
+RC MvccTrxKit::write_back_commit(CommittedTrx &committed_trx)
+{
+  const int32_t trx_id        = committed_trx.trx_id;
+  const int32_t commit_trx_id = committed_trx.commit_trx_id;
+  for (const Operation &operation : committed_trx.operations) {
+    BaseTable *table = operation.table();
+
+    Field begin_xid_field, end_xid_field;
+    MvccTrx::trx_fields(table, begin_xid_field, end_xid_field);
+
+    // 插入和更新的记录修改 begin xid，删除的记录修改 end xid
+    Field &xid_field = operation.type() == Operation::Type::DELETE ? end_xid_field : begin_xid_field;
+
+    // 记录可能已经被之后的事务修改过了，比如又被更新，这时就不需要回写了
+    auto record_updater = [trx_id, commit_trx_id, &xid_field](Record &record) -> bool {
+      if (xid_field.get_int(record) != -trx_id) {
+        return false;
+      }
+
+      xid_field.set_int(record, commit_trx_id);
+      return true;
+    };
+
+    RC rc = table->visit_record(operation.rid(), record_updater);
+    if (OB_FAIL(rc) && rc != RC::RECORD_NOT_EXIST) {
+      LOG_WARN("failed to write back commit trx id. table=%s, rid=%s, rc=%s",
+               table->name(), operation.rid().to_string().c_str(), strrc(rc));
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 MvccTrx::MvccTrx(MvccTrxKit &kit, LogHandler &log_handler) : trx_kit_(kit), log_handler_(log_handler) {}
@@ -133,6 +295,7 @@ MvccTrx::MvccTrx(MvccTrxKit &kit, LogHandler &log_handler, int32_t trx_id)
 {
   started_    = true;
   recovering_ = true;
+  active_trx_id_.store(trx_id);
 }
 
 MvccTrx::~MvccTrx() {}
@@ -157,6 +320,7 @@ RC MvccTrx::insert_record(BaseTable *table, Record &record)
          trx_id_, table->table_id(), record.rid().to_string().c_str(), record.len(), strrc(rc));
 
   operations_.emplace_back(Operation::Type::INSERT, table, record.rid());
+  add_written_table(table);
   return rc;
 }
 
@@ -194,6 +358,7 @@ RC MvccTrx::delete_record(BaseTable *table, Record &record)
       trx_id_, table->table_id(), record.rid().to_string().c_str(), record.len(), strrc(rc));
 
   operations_.emplace_back(Operation::Type::DELETE, table, record.rid());
+  add_written_table(table);
 
   return RC::SUCCESS;
 }
@@ -204,6 +369,9 @@ RC MvccTrx::update_record(BaseTable *table, Record &old_record, Record &new_reco
   Field end_field;
   trx_fields(table, begin_field, end_field);
 
+  // 回滚时会用旧数据覆盖回去。旧数据上可能还是其它已提交事务的负事务号，回写之后就查不到提交状态了，先换成提交事务号
+  resolve_xids(table, old_record);
+
   // 更新的处理和插入一样，begin 设置负值，但是 end 保持不变，因为可能遇到一个老事务对旧数据的修改
   begin_field.set_int(new_record, -trx_id_);
   end_field.set_int(new_record, trx_kit_.max_trx_id());
@@ -214,13 +382,13 @@ RC MvccTrx::update_record(BaseTable *table, Record &old_record, Record &new_reco
     return rc;
   }
 
-  // 不实现故障恢复应该不用日志
-  // rc = log_handler_.insert_record(trx_id_, table, record.rid());
-  // ASSERT(rc == RC::SUCCESS, "failed to append insert record log. trx id=%d, table id=%d, rid=%s, record len=%d,
-  // rc=%s",
-  //        trx_id_, table->table_id(), record.rid().to_string().c_str(), record.len(), strrc(rc));
+  // 日志中不记录更新前后的数据，恢复时只用来回写提交事务号
+  rc = log_handler_.update_record(trx_id_, table, old_record.rid());
+  ASSERT(rc == RC::SUCCESS, "failed to append update record log. trx id=%d, table id=%d, rid=%s, record len=%d, rc=%s",
+      trx_id_, table->table_id(), old_record.rid().to_string().c_str(), old_record.len(), strrc(rc));
 
   operations_.emplace_back(Operation::Type::UPDATE, table, old_record.rid(), old_record, new_record);
+  add_written_table(table);
   return rc;
 }
 
@@ -230,8 +398,15 @@ RC MvccTrx::visit_record(BaseTable *table, Record &record, ReadWriteMode mode)
   Field end_field;
   trx_fields(table, begin_field, end_field);
 
-  int32_t begin_xid = begin_field.get_int(record);
-  int32_t end_xid   = end_field.get_int(record);
+  // 负的事务号可能属于已经提交但还没有回写的事务，从提交状态表中找到提交事务号
+  const int32_t begin_xid = resolve_xid(begin_field.get_int(record));
+  const int32_t end_xid   = resolve_xid(end_field.get_int(record));
+
+  // 记录是复制出来的数据时，顺便把提交事务号写上，之后写回页面时就不需要再查找了
+  if (record.owner()) {
+    begin_field.set_int(record, begin_xid);
+    end_field.set_int(record, end_xid);
+  }
 
   RC rc = RC::SUCCESS;
   if (begin_xid > 0 && end_xid > 0) {
@@ -279,6 +454,40 @@ RC MvccTrx::visit_record(BaseTable *table, Record &record, ReadWriteMode mode)
   return rc;
 }
 
+/**
+ * @brief 查找负事务号对应的提交事务号
+ * @details 当前事务自己的修改以及没有提交的事务的修改，返回原来的事务号
+ */
+int32_t MvccTrx::resolve_xid(int32_t xid) const
+{
+  int32_t commit_xid = 0;
+  if (xid < 0 && -xid != trx_id_ && trx_kit_.find_commit_trx_id(-xid, commit_xid)) {
+    return commit_xid;
+  }
+  return xid;
+}
+
+void MvccTrx::resolve_xids(BaseTable *table, Record &record) const
+{
+  if (!record.owner()) {
+    return;
+  }
+
+  Field begin_field;
+  Field end_field;
+  trx_fields(table, begin_field, end_field);
+
+  begin_field.set_int(record, resolve_xid(begin_field.get_int(record)));
+  end_field.set_int(record, resolve_xid(end_field.get_int(record)));
+}
+
+void MvccTrx::add_written_table(BaseTable *table)
+{
+  if (find(written_tables_.begin(), written_tables_.end(), table) == written_tables_.end()) {
+    written_tables_.push_back(table);
+  }
+}
+
 /**
  * @brief 获取指定表上的事务使用的字段
  *
@@ -286,7 +495,7 @@ RC MvccTrx::visit_record(BaseTable *table, Record &record, ReadWriteMode mode)
  * @param begin_xid_field 返回处理begin_xid的字段
  * @param end_xid_field   返回处理end_xid的字段
  */
-void MvccTrx::trx_fields(BaseTable *table, Field &begin_xid_field, Field &end_xid_field) const
+void MvccTrx::trx_fields(BaseTable *table, Field &begin_xid_field, Field &end_xid_field)
 {
   const TableMeta      &table_meta = table->table_meta();
   span<const FieldMeta> trx_fields = table_meta.trx_fields();
@@ -305,117 +514,65 @@ RC MvccTrx::start_if_need()
     trx_id_ = trx_kit_.next_trx_id();
     LOG_DEBUG("current thread change to new trx with %d", trx_id_);
     started_ = true;
+    active_trx_id_.store(trx_id_);
   }
   return RC::SUCCESS;
 }
 
 RC MvccTrx::commit()
 {
-  int32_t commit_id = trx_kit_.next_trx_id();
+  // 没有修改过数据的事务不需要记录提交状态
+  int32_t commit_id = operations_.empty() ? trx_kit_.next_trx_id() : trx_kit_.commit_trx(trx_id_);
   return commit_with_trx_id(commit_id);
 }
 
 RC MvccTrx::commit_with_trx_id(int32_t commit_xid)
 {
-  // TODO 原子性提交BUG：这里存在一个很大的问题，不能让其他事务一次性看到当前事务更新到的数据或同时看不到
-
-  // 当前事务在提交时，会逐个修改之前修改过的行数据，调整版本号。
-  // 这造成的问题是，在某个时刻，有些行数据的版本号已经修改了，有些还没有。那可能会存在一个事务，能够看到已经修改完成版本号的行，但是看不到未修改的行。
-  // 比如事务A，插入了3条数据，在提交的时候，逐个修改版本号，某个情况下可能会存在下面的场景(假设A的事务ID是90，commit
-  // id是100)：
-  //
-  // record	begin xid	end xid	data
-  //   R1	100	  +∞	    ...
-  //   R2	100	  +∞	    ...
-  //   R3	-90	  +∞	    ...
-  // 此时有一个新的事务，假设事务号是 110，那么它可以看到记录R1和R2，但是看不到R3，因为R3从记录状态来看，还没有提交。
+  // 提交事务号已经记录在提交状态表中，其它事务访问到当前事务修改的记录时，会通过负的事务号查到提交事务号。
+  // 所以这里不再逐行修改记录，所有的修改同时对其它事务可见，提交的代价也与修改的行数无关。
+  // 记录上的事务号由 MvccTrxKit::write_back_commits 之后回写。
 
   RC rc    = RC::SUCCESS;
   started_ = false;
 
-  for (const Operation &operation : operations_) {
-    switch (operation.type()) {
-      case Operation::Type::INSERT: {
-        RID        rid   = operation.rid();
-        BaseTable *table = operation.table();
-
-        Field begin_xid_field, end_xid_field;
-        trx_fields(table, begin_xid_field, end_xid_field);
-
-        auto record_updater = [this, &begin_xid_field, commit_xid](Record &record) -> bool {
-          LOG_DEBUG("before commit insert record. trx id=%d, begin xid=%d, commit xid=%d, lbt=%s",
-                    trx_id_, begin_xid_field.get_int(record), commit_xid, lbt());
-          ASSERT(begin_xid_field.get_int(record) == -this->trx_id_ && (!recovering_), 
-                 "got an invalid record while committing. begin xid=%d, this trx id=%d", 
-                 begin_xid_field.get_int(record), trx_id_);
-
-          begin_xid_field.set_int(record, commit_xid);
-          return true;
-        };
-
-        rc = operation.table()->visit_record(rid, record_updater);
-        ASSERT(rc == RC::SUCCESS, "failed to get record while committing. rid=%s, rc=%s",
-               rid.to_string().c_str(), strrc(rc));
-      } break;
-
-      case Operation::Type::DELETE: {
-        RID        rid   = operation.rid();
-        BaseTable *table = operation.table();
-
-        Field begin_xid_field, end_xid_field;
-        trx_fields(table, begin_xid_field, end_xid_field);
-
-        auto record_updater = [this, &end_xid_field, commit_xid](Record &record) -> bool {
-          (void)this;
-          ASSERT(end_xid_field.get_int(record) == -trx_id_, 
-                 "got an invalid record while committing. end xid=%d, this trx id=%d", 
-                 end_xid_field.get_int(record), trx_id_);
-
-          end_xid_field.set_int(record, commit_xid);
-          return true;
-        };
-
-        rc = operation.table()->visit_record(rid, record_updater);
-        ASSERT(rc == RC::SUCCESS, "failed to get record while committing. rid=%s, rc=%s",
-               rid.to_string().c_str(), strrc(rc));
-      } break;
-
-      case Operation::Type::UPDATE: {
-        RID        rid   = operation.rid();
-        BaseTable *table = operation.table();
-
-        Field begin_xid_field, end_xid_field;
-        trx_fields(table, begin_xid_field, end_xid_field);
-
-        auto record_updater = [this, &begin_xid_field, commit_xid](Record &record) -> bool {
-          LOG_DEBUG("before commit update record. trx id=%d, begin xid=%d, commit xid=%d, lbt=%s",
-                   trx_id_, begin_xid_field.get_int(record), commit_xid, lbt());
-          ASSERT(begin_xid_field.get_int(record) == -trx_id_,
-                 "got an invalid record while committing. end xid=%d, this trx id=%d",
-                 begin_xid_field.get_int(record), trx_id_);
-
-          begin_xid_field.set_int(record, commit_xid);
-          return true;
-        };
-
-        rc = operation.table()->visit_record(rid, record_updater);
-        ASSERT(rc == RC::SUCCESS, "failed to get record while committing. rid=%s, rc=%s",
-               rid.to_string().c_str(), strrc(rc));
-      } break;
-
-      default: {
-        ASSERT(false, "unsupported operation. type=%d", static_cast<int>(operation.type()));
-      }
-    }
+  MvccTrxKit::CommittedTrx *committed_trx = nullptr;
+  if (!operations_.empty()) {
+    auto pending_trx           = make_unique<MvccTrxKit::CommittedTrx>();
+    pending_trx->trx_id        = trx_id_;
+    pending_trx->commit_trx_id = commit_xid;
+    // 只有更新操作时也写过日志，这时用当前的LSN作为下限，一定不会超过提交日志
+    pending_trx->lsn = first_lsn() != 0 ? first_lsn() : (recovering_ ? 0 : log_handler_.current_lsn());
+    pending_trx->operations.swap(operations_);
+
+    // 先进入回写队列，再写提交日志。提交日志会清理 first_lsn，检查点在这中间也不会越过当前事务的日志
+    committed_trx = trx_kit_.add_committed_trx(std::move(pending_trx));
   }
 
   if (!recovering_) {
     rc = log_handler_.commit(trx_id_, commit_xid);
   }
 
-  operations_.clear();
+  if (committed_trx != nullptr) {
+    committed_trx->ready.store(true);
+  }
+
+  // 修改对其它事务可见了，查询缓存中读过这些表的结果都要失效
+  for (BaseTable *table : written_tables_) {
+    table->increase_data_version();
+  }
+
+  written_tables_.clear();
+  active_trx_id_.store(0);
 
   LOG_TRACE("append trx commit log. trx id=%d, commit_xid=%d, rc=%s", trx_id_, commit_xid, strrc(rc));
+
+  // 不依赖检查点，回写队列积累了一批事务就回写，回写失败不影响当前事务的提交
+  if (OB_SUCC(rc) && committed_trx != nullptr && !recovering_) {
+    RC write_back_rc = trx_kit_.write_back_commits_if_need();
+    if (OB_FAIL(write_back_rc)) {
+      LOG_WARN("failed to write back committed trxes. rc=%s", strrc(write_back_rc));
+    }
+  }
   return rc;
 }
 
@@ -502,6 +659,11 @@ RC MvccTrx::rollback()
                      table->name(), rid.to_string().c_str(), strrc(rc));
             return rc;
           }
+
+          // 更新日志中没有旧数据，恢复时无法回滚更新
+          LOG_WARN("cannot rollback update record while recovering. table=%s, rid=%s, trx id=%d",
+                   table->name(), rid.to_string().c_str(), trx_id_);
+          continue;
         }
 
         // 直接用旧的记录的时间戳覆盖
@@ -517,6 +679,8 @@ RC MvccTrx::rollback()
   }
 
   operations_.clear();
+  written_tables_.clear();
+  active_trx_id_.store(0);
 
   if (!recovering_) {
     rc = log_handler_.rollback(trx_id_);
@@ -530,7 +694,8 @@ RC find_table(Db *db, const LogEntry &log_entry, BaseTable *&table)
   auto *trx_log_header = reinterpret_cast<const MvccTrxLogHeader *>(log_entry.data());
   switch (MvccTrxLogOperation(trx_log_header->operation_type).type()) {
     case MvccTrxLogOperation::Type::INSERT_RECORD:
-    case MvccTrxLogOperation::Type::DELETE_RECORD: {
+    case MvccTrxLogOperation::Type::DELETE_RECORD:
+    case MvccTrxLogOperation::Type::UPDATE_RECORD: {
       auto *trx_log_record = reinterpret_cast<const MvccTrxRecordLogEntry *>(log_entry.data());
       table                = db->find_table(trx_log_record->table_id);
       if (nullptr == table) {
@@ -554,7 +719,9 @@ RC MvccTrx::redo(Db *db, const LogEntry &log_entry)
     return rc;
   }
 
-  ASSERT(base_table->type() == TableType::Table, "Only tables support MVCC. The provided base_table is not of type Table.");
+  // 提交和回滚日志没有对应的表
+  ASSERT(base_table == nullptr || base_table->type() == TableType::Table,
+         "Only tables support MVCC. The provided base_table is not of type Table.");
   Table *table = static_cast<Table *>(base_table);
   switch (MvccTrxLogOperation(trx_log_header->operation_type).type()) {
     case MvccTrxLogOperation::Type::INSERT_RECORD: {
@@ -567,10 +734,21 @@ RC MvccTrx::redo(Db *db, const LogEntry &log_entry)
       operations_.push_back(Operation(Operation::Type::DELETE, table, trx_log_record->rid));
     } break;
 
+    case MvccTrxLogOperation::Type::UPDATE_RECORD: {
+      auto *trx_log_record = reinterpret_cast<const MvccTrxRecordLogEntry *>(log_entry.data());
+      operations_.push_back(Operation(Operation::Type::UPDATE, table, trx_log_record->rid));
+    } break;
+
     case MvccTrxLogOperation::Type::COMMIT: {
-      // auto *trx_log_record = reinterpret_cast<const MvccTrxCommitLogEntry *>(log_entry.data());
-      // commit_with_trx_id(trx_log_record->commit_trx_id);
-      // 遇到了提交日志，说明前面的记录都已经提交成功了
+      // 遇到了提交日志，说明前面的记录都已经提交成功了。
+      // 提交前记录上的事务号不一定回写过，先记录提交状态，回放结束后统一回写
+      auto *trx_log_record = reinterpret_cast<const MvccTrxCommitLogEntry *>(log_entry.data());
+      if (operations_.empty()) {
+        trx_kit_.recover_trx_id(trx_log_record->commit_trx_id);
+      } else {
+        trx_kit_.recover_commit(trx_id_, trx_log_record->commit_trx_id);
+      }
+      rc = commit_with_trx_id(trx_log_record->commit_trx_id);
     } break;
 
     case MvccTrxLogOperation::Type::ROLLBACK: {
@@ -584,5 +762,5 @@ RC MvccTrx::redo(Db *db, const LogEntry &log_entry)
     } break;
   }
 
-  return RC::SUCCESS;
+  return rc;
 }
@@ -14,7 +14,10 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "common/lang/deque.h"
+#include "common/lang/memory.h"
 #include "common/lang/vector.h"
+#include "storage/trx/commit_status_table.h"
 #include "storage/trx/trx.h"
 #include "storage/trx/mvcc_trx_log.h"
 
@@ -22,8 +25,20 @@ class CLogManager;
 class LogHandler;
 class MvccTrxLogHandler;
 
+/**
+ * @brief 多版本并发事务管理器
+ * @ingroup Transaction
+ * @details 事务提交时只把提交事务号记录到提交状态表中，不逐行修改记录上的事务号，提交的代价与修改的行数无关。
+ * 提交过的事务放到一个队列中，由 write_back_commits 在后台把提交事务号回写到行记录。回写之前复制出来的记录上
+ * 还是负的事务号，等到回写时已经开始的事务都结束之后，才从提交状态表中删除。
+ * 回写记录会写日志，在回写完成之前，检查点不能越过这个事务的日志，否则恢复时就找不回它的提交状态了。
+ * 队列中的事务比较多时，提交事务的线程也会回写，不开启检查点时队列和提交状态表也不会一直增长。
+ */
 class MvccTrxKit : public TrxKit
 {
+public:
+  static constexpr int WRITE_BACK_BATCH = 64;  ///< 回写队列中的事务达到这个数量时，提交的事务顺便回写
+
 public:
   MvccTrxKit() = default;
   virtual ~MvccTrxKit();
@@ -44,12 +59,84 @@ public:
 
   LogReplayer *create_log_replayer(Db &db, LogHandler &log_handler) override;
 
+  LSN     oldest_active_lsn() override;
+  int32_t last_trx_id() const override { return current_trx_id_.load(); }
+  void    recover_trx_id(int32_t trx_id) override;
+
+  /**
+   * @brief 把已经提交的事务的提交事务号回写到行记录中
+   * @details 检查点线程定期调用，也会在 sync、删除表和关闭数据库之前调用
+   */
+  RC write_back_commits() override;
+
+  /**
+   * @brief 回写队列中的事务达到 WRITE_BACK_BATCH 时回写
+   * @details 事务提交之后调用。其它线程正在回写时直接返回，不等待
+   */
+  RC write_back_commits_if_need();
+
 public:
   int32_t next_trx_id();
 
 public:
   int32_t max_trx_id() const;
 
+public:
+  /**
+   * @brief 已经提交、还没有把提交事务号回写到行记录中的事务
+   */
+  struct CommittedTrx
+  {
+    int32_t           trx_id        = 0;
+    int32_t           commit_trx_id = 0;
+    LSN               lsn           = 0;  ///< 事务写的第一条日志，回写完成之前检查点不能超过它
+    atomic<bool>      ready{false};       ///< 提交日志落盘之后才能回写，否则回写的记录可能比提交日志先落盘
+    vector<Operation> operations;         ///< 事务修改过的记录
+  };
+
+  /**
+   * @brief 分配提交事务号，并在提交状态表中记录事务已经提交
+   * @details 这之后其它事务就能同时看到这个事务的所有修改
+   */
+  int32_t commit_trx(int32_t trx_id) { return commit_status_.commit(trx_id, current_trx_id_); }
+
+  /**
+   * @brief 恢复时在提交状态表中记录事务已经提交
+   */
+  void recover_commit(int32_t trx_id, int32_t commit_trx_id);
+
+  /**
+   * @brief 查找事务的提交事务号
+   * @return 事务已经提交，但是提交事务号还没有回写到记录中时返回true
+   */
+  bool find_commit_trx_id(int32_t trx_id, int32_t &commit_trx_id) const
+  {
+    return commit_status_.find(trx_id, commit_trx_id);
+  }
+
+  /**
+   * @brief 把提交的事务放到回写队列中
+   * @return 队列中的事务，等到 CommittedTrx::ready 设置之后才会回写
+   */
+  CommittedTrx *add_committed_trx(unique_ptr<CommittedTrx> committed_trx);
+
+private:
+  /**
+   * @brief 不加锁的 write_back_commits，调用者持有 write_back_lock_
+   */
+  RC write_back_commits_internal();
+  RC write_back_commit(CommittedTrx &committed_trx);
+
+  /**
+   * @brief 删除已经回写、不会再有事务查找的提交状态
+   */
+  void remove_commit_status();
+
+  /**
+   * @brief 所有活跃事务中最小的事务号，没有活跃事务时返回0
+   */
+  int32_t min_active_trx_id();
+
 private:
   vector<FieldMeta> fields_;  // 存储事务数据需要用到的字段元数据，所有表结构都需要带的
 
@@ -57,6 +144,21 @@ private:
 
   common::Mutex lock_;
   vector<Trx *> trxes_;
+
+  /**
+   * @brief 已经回写、还留在提交状态表中的事务
+   */
+  struct WrittenBackTrx
+  {
+    int32_t trx_id     = 0;
+    int32_t max_trx_id = 0;  ///< 回写完成时最大的事务号，活跃事务的事务号都比它大之后才能删除提交状态
+  };
+
+  CommitStatusTable               commit_status_;         ///< 还没有回写的事务的提交状态
+  common::Mutex                   committed_trxes_lock_;  ///< 保护 committed_trxes_
+  common::Mutex                   write_back_lock_;       ///< 同一时间只有一个线程在回写，也保护 written_back_trxes_
+  deque<unique_ptr<CommittedTrx>> committed_trxes_;       ///< 等待回写的事务，按照提交顺序排列
+  deque<WrittenBackTrx>           written_back_trxes_;    ///< 按照回写的顺序排列
 };
 
 /**
@@ -100,9 +202,19 @@ public:
 
   int32_t id() const override { return trx_id_; }
 
+  /// @brief 当前事务写的第一条日志的LSN，还没有写过日志时返回0
+  LSN first_lsn() const { return log_handler_.first_lsn(); }
+
+  /// @brief 事务已经开始、还没有结束时返回事务号，否则返回0
+  int32_t active_trx_id() const { return active_trx_id_.load(); }
+
+  static void trx_fields(BaseTable *table, Field &begin_xid_field, Field &end_xid_field);
+
 private:
-  RC   commit_with_trx_id(int32_t commit_id);
-  void trx_fields(BaseTable *table, Field &begin_xid_field, Field &end_xid_field) const;
+  RC      commit_with_trx_id(int32_t commit_id);
+  int32_t resolve_xid(int32_t xid) const;
+  void    resolve_xids(BaseTable *table, Record &record) const;
+  void    add_written_table(BaseTable *table);
 
 private:
   static const int32_t MAX_TRX_ID = numeric_limits<int32_t>::max();
@@ -111,10 +223,12 @@ private:
   // using OperationSet = unordered_set<Operation, OperationHasher, OperationEqualer>;
   using OperationSet = vector<Operation>;
 
-  MvccTrxKit       &trx_kit_;
-  MvccTrxLogHandler log_handler_;
-  int32_t           trx_id_     = -1;
-  bool              started_    = false;
-  bool              recovering_ = false;
-  OperationSet      operations_;
+  MvccTrxKit         &trx_kit_;
+  MvccTrxLogHandler   log_handler_;
+  int32_t             trx_id_     = -1;
+  bool                started_    = false;
+  bool                recovering_ = false;
+  OperationSet        operations_;
+  vector<BaseTable *> written_tables_;    ///< 修改过的表，提交时让查询缓存失效
+  atomic<int32_t>     active_trx_id_{0};  ///< 给 MvccTrxKit 判断哪些提交状态还会被查找
 };
@@ -31,6 +31,7 @@ string MvccTrxLogOperation::to_string() const
     case Type::DELETE_RECORD: return ret + "DELETE_RECORD";
     case Type::COMMIT: return ret + "COMMIT";
     case Type::ROLLBACK: return ret + "ROLLBACK";
+    case Type::UPDATE_RECORD: return ret + "UPDATE_RECORD";
     default: return ret + "UNKNOWN";
   }
 }
@@ -70,32 +71,40 @@ MvccTrxLogHandler::~MvccTrxLogHandler() {}
 
 RC MvccTrxLogHandler::insert_record(int32_t trx_id, BaseTable *table, const RID &rid)
 {
-  ASSERT(trx_id > 0, "invalid trx_id:%d", trx_id);
+  return append_record_log(MvccTrxLogOperation::Type::INSERT_RECORD, trx_id, table, rid);
+}
 
-  MvccTrxRecordLogEntry log_entry;
-  log_entry.header.operation_type = MvccTrxLogOperation(MvccTrxLogOperation::Type::INSERT_RECORD).index();
-  log_entry.header.trx_id         = trx_id;
-  log_entry.table_id              = table->table_id();
-  log_entry.rid                   = rid;
+RC MvccTrxLogHandler::delete_record(int32_t trx_id, BaseTable *table, const RID &rid)
+{
+  return append_record_log(MvccTrxLogOperation::Type::DELETE_RECORD, trx_id, table, rid);
+}
 
-  LSN lsn = 0;
-  return log_handler_.append(
-      lsn, LogModule::Id::TRANSACTION, span<const char>(reinterpret_cast<const char *>(&log_entry), sizeof(log_entry)));
+RC MvccTrxLogHandler::update_record(int32_t trx_id, BaseTable *table, const RID &rid)
+{
+  return append_record_log(MvccTrxLogOperation::Type::UPDATE_RECORD, trx_id, table, rid);
 }
 
-RC MvccTrxLogHandler::delete_record(int32_t trx_id, BaseTable *table, const RID &rid)
+LSN MvccTrxLogHandler::current_lsn() const { return log_handler_.current_lsn(); }
+
+RC MvccTrxLogHandler::append_record_log(MvccTrxLogOperation::Type type, int32_t trx_id, BaseTable *table, const RID &rid)
 {
   ASSERT(trx_id > 0, "invalid trx_id:%d", trx_id);
 
   MvccTrxRecordLogEntry log_entry;
-  log_entry.header.operation_type = MvccTrxLogOperation(MvccTrxLogOperation::Type::DELETE_RECORD).index();
+  log_entry.header.operation_type = MvccTrxLogOperation(type).index();
   log_entry.header.trx_id         = trx_id;
   log_entry.table_id              = table->table_id();
   log_entry.rid                   = rid;
 
-  LSN lsn = 0;
-  return log_handler_.append(
+  // 记录到 first_lsn 之前，检查点也不能越过这条日志
+  LogLsnGuard lsn_guard(log_handler_);
+  LSN         lsn = 0;
+  RC          rc  = log_handler_.append(
       lsn, LogModule::Id::TRANSACTION, span<const char>(reinterpret_cast<const char *>(&log_entry), sizeof(log_entry)));
+  if (OB_SUCC(rc)) {
+    record_first_lsn(lsn);
+  }
+  return rc;
 }
 
 RC MvccTrxLogHandler::commit(int32_t trx_id, int32_t commit_trx_id)
@@ -116,7 +125,12 @@ RC MvccTrxLogHandler::commit(int32_t trx_id, int32_t commit_trx_id)
 
   // 我们在这里粗暴的等待日志写入到磁盘
   // 有必要的话，可以让上层来决定如何等待
-  return log_handler_.wait_lsn(lsn);
+  rc = log_handler_.wait_lsn(lsn);
+  if (OB_SUCC(rc)) {
+    // 提交日志落盘之后，恢复时就不需要这个事务之前的日志了
+    first_lsn_.store(0);
+  }
+  return rc;
 }
 
 RC MvccTrxLogHandler::rollback(int32_t trx_id)
@@ -128,8 +142,19 @@ RC MvccTrxLogHandler::rollback(int32_t trx_id)
   log_entry.header.trx_id         = trx_id;
 
   LSN lsn = 0;
-  return log_handler_.append(
+  RC  rc  = log_handler_.append(
       lsn, LogModule::Id::TRANSACTION, span<const char>(reinterpret_cast<const char *>(&log_entry), sizeof(log_entry)));
+  if (OB_SUCC(rc)) {
+    first_lsn_.store(0);
+  }
+  return rc;
+}
+
+void MvccTrxLogHandler::record_first_lsn(LSN lsn)
+{
+  if (first_lsn_.load() == 0) {
+    first_lsn_.store(lsn);
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -156,6 +181,7 @@ RC MvccTrxLogReplayer::replay(const LogEntry &entry)
   if (trx_iter == trx_map_.end()) {
     trx = static_cast<MvccTrx *>(trx_kit_.create_trx(log_handler_, header->trx_id));
     // trx = new MvccTrx(trx_kit_, log_handler_, header->trx_id);
+    trx_map_[header->trx_id] = trx;
   } else {
     trx = trx_iter->second;
   }
@@ -166,7 +192,6 @@ RC MvccTrxLogReplayer::replay(const LogEntry &entry)
   /// 如果事务结束了，需要从内存中把它删除
   if (MvccTrxLogOperation(header->operation_type).type() == MvccTrxLogOperation::Type::ROLLBACK ||
       MvccTrxLogOperation(header->operation_type).type() == MvccTrxLogOperation::Type::COMMIT) {
-    Trx *trx = trx_map_[header->trx_id];
     trx_kit_.destroy_trx(trx);
     trx_map_.erase(header->trx_id);
   }
@@ -180,9 +205,10 @@ RC MvccTrxLogReplayer::on_done()
   for (auto &pair : trx_map_) {
     MvccTrx *trx = pair.second;
     trx->rollback();  // 恢复时的rollback，可能遇到之前已经回滚一半的事务又再次调用回滚的情况
-    delete pair.second;
+    trx_kit_.destroy_trx(trx);
   }
   trx_map_.clear();
 
-  return RC::SUCCESS;
+  /// 回放过程中提交的事务只记录了提交状态，在这里把提交事务号回写到记录中
+  return trx_kit_.write_back_commits();
 }
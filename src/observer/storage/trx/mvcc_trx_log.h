@@ -16,6 +16,7 @@ See the Mulan PSL v2 for more details. */
 
 #include "common/rc.h"
 #include "common/types.h"
+#include "common/lang/atomic.h"
 #include "common/lang/string.h"
 #include "common/lang/unordered_map.h"
 #include "storage/record/record.h"
@@ -40,7 +41,8 @@ public:
     INSERT_RECORD,  ///< 插入一条记录
     DELETE_RECORD,  ///< 删除一条记录
     COMMIT,         ///< 提交事务
-    ROLLBACK        ///< 回滚事务
+    ROLLBACK,       ///< 回滚事务
+    UPDATE_RECORD,  ///< 更新一条记录
   };
 
 public:
@@ -72,7 +74,7 @@ struct MvccTrxLogHeader
 };
 
 /**
- * @brief 表示事务日志中操作行数据的日志，比如插入和删除
+ * @brief 表示事务日志中操作行数据的日志，比如插入、删除和更新
  * @ingroup CLog
  * @details 并不记录具体的行数据。
  */
@@ -122,6 +124,12 @@ public:
    */
   RC delete_record(int32_t trx_id, BaseTable *table, const RID &rid);
 
+  /**
+   * @brief 记录更新一条记录的日志
+   * @details 不记录更新前后的数据，恢复时只用来回写提交事务号
+   */
+  RC update_record(int32_t trx_id, BaseTable *table, const RID &rid);
+
   /**
    * @brief 记录提交事务的日志
    * @details 会等待日志落地
@@ -134,8 +142,22 @@ public:
    */
   RC rollback(int32_t trx_id);
 
+  /**
+   * @brief 事务写的第一条日志的LSN
+   * @details 事务提交或回滚之后清零。检查点线程会并发读取
+   */
+  LSN first_lsn() const { return first_lsn_.load(); }
+
+  /// @brief 当前已经分配的最大LSN
+  LSN current_lsn() const;
+
+private:
+  RC   append_record_log(MvccTrxLogOperation::Type type, int32_t trx_id, BaseTable *table, const RID &rid);
+  void record_first_lsn(LSN lsn);
+
 private:
   LogHandler &log_handler_;
+  atomic<LSN> first_lsn_{0};
 };
 
 /**
@@ -135,6 +135,31 @@ public:
 
   virtual LogReplayer *create_log_replayer(Db &db, LogHandler &log_handler) = 0;
 
+  /**
+   * @brief 还没有结束的事务写的第一条日志中最小的LSN
+   * @details 恢复时要从这里开始回放事务日志，才能回滚这些事务，检查点不能超过这个LSN
+   * @return 没有写过日志的活跃事务时返回0
+   */
+  virtual LSN oldest_active_lsn() = 0;
+
+  /**
+   * @brief 已经分配过的最大事务号
+   * @details 检查点之前的日志会被删除，恢复时不能再从日志中找回用过的事务号，需要记录在数据库的元数据中
+   */
+  virtual int32_t last_trx_id() const = 0;
+
+  /**
+   * @brief 恢复时设置已经分配过的最大事务号，之后分配的事务号都比它大
+   */
+  virtual void recover_trx_id(int32_t trx_id) = 0;
+
+  /**
+   * @brief 把已经提交的事务的提交事务号回写到行记录中
+   * @details 提交事务时可能只记录了事务状态，没有修改行记录，参考 MvccTrxKit。
+   * 做检查点、删除表和关闭数据库之前需要调用
+   */
+  virtual RC write_back_commits() { return RC::SUCCESS; }
+
 public:
   static TrxKit *create(const char *name);
 };
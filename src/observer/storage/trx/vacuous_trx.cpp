@@ -30,6 +30,12 @@ void VacuousTrxKit::all_trxes(vector<Trx *> &trxes) { return; }
 
 LogReplayer *VacuousTrxKit::create_log_replayer(Db &, LogHandler &) { return new VacuousTrxLogReplayer; }
 
+LSN VacuousTrxKit::oldest_active_lsn() { return 0; }
+
+int32_t VacuousTrxKit::last_trx_id() const { return 0; }
+
+void VacuousTrxKit::recover_trx_id(int32_t /*trx_id*/) {}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 RC VacuousTrx::insert_record(BaseTable *table, Record &record) { return table->insert_record(record); }
@@ -36,6 +36,10 @@ public:
   void destroy_trx(Trx *trx) override;
 
   LogReplayer *create_log_replayer(Db &db, LogHandler &log_handler) override;
+
+  LSN     oldest_active_lsn() override;
+  int32_t last_trx_id() const override;
+  void    recover_trx_id(int32_t trx_id) override;
 };
 
 class VacuousTrx : public Trx
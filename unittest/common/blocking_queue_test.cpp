@@ -0,0 +1,63 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/18.
+//
+
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "common/lang/memory.h"
+#include "common/queue/blocking_queue.h"
+
+using namespace common;
+
+TEST(BlockingQueue, test)
+{
+  BlockingQueue<int> queue(chrono::milliseconds(10));
+  EXPECT_EQ(0, queue.size());
+
+  int value = 0;
+  EXPECT_EQ(-1, queue.pop(value));
+
+  EXPECT_EQ(0, queue.push(1));
+  EXPECT_EQ(0, queue.push(2));
+  EXPECT_EQ(2, queue.size());
+
+  EXPECT_EQ(0, queue.pop(value));
+  EXPECT_EQ(1, value);
+  EXPECT_EQ(0, queue.pop(value));
+  EXPECT_EQ(2, value);
+  EXPECT_EQ(0, queue.size());
+}
+
+TEST(BlockingQueue, test_wait)
+{
+  BlockingQueue<unique_ptr<int>> queue(chrono::milliseconds(10 * 1000));
+
+  // pop 会等到其它线程放入数据
+  std::thread producer([&queue]() {
+    std::this_thread::sleep_for(chrono::milliseconds(50));
+    queue.push(make_unique<int>(1));
+  });
+
+  unique_ptr<int> value;
+  EXPECT_EQ(0, queue.pop(value));
+  ASSERT_NE(nullptr, value);
+  EXPECT_EQ(1, *value);
+  producer.join();
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -10,13 +10,14 @@ See the Mulan PSL v2 for more details. */
 
 #include <chrono>
 #include <iostream>
+#include <map>
 
 #include "gtest/gtest.h"
 #include "sql/expr/aggregate_hash_table.h"
 
 using namespace std;
 
-TEST(AggregateHashTableTest, DISABLED_standard_hash_table)
+TEST(AggregateHashTableTest, standard_hash_table)
 {
   // single group by column, single aggregate column
   {
@@ -87,8 +88,8 @@ TEST(AggregateHashTableTest, DISABLED_standard_hash_table)
         make_unique<Column>(group_chunk.column(0).attr_type(), group_chunk.column(0).attr_len()), 0);
     output_chunk.add_column(
         make_unique<Column>(group_chunk.column(1).attr_type(), group_chunk.column(1).attr_len()), 1);
-    output_chunk.add_column(make_unique<Column>(aggr_chunk.column(0).attr_type(), aggr_chunk.column(0).attr_len()), 1);
-    output_chunk.add_column(make_unique<Column>(aggr_chunk.column(1).attr_type(), aggr_chunk.column(1).attr_len()), 2);
+    output_chunk.add_column(make_unique<Column>(aggr_chunk.column(0).attr_type(), aggr_chunk.column(0).attr_len()), 2);
+    output_chunk.add_column(make_unique<Column>(aggr_chunk.column(1).attr_type(), aggr_chunk.column(1).attr_len()), 3);
     StandardAggregateHashTable::Scanner scanner(standard_hash_table.get());
     scanner.open_scan();
     rc = scanner.next(output_chunk);
@@ -103,6 +104,181 @@ TEST(AggregateHashTableTest, DISABLED_standard_hash_table)
   }
 }
 
+/**
+ * @brief 构造多种类型的 group by 列以及聚合列
+ * @details group by 列: INTS, CHARS(4), DATES
+ * 聚合列: COUNT(INTS), SUM(INTS), SUM(FLOATS), AVG(INTS), MAX(CHARS), MIN(FLOATS), MAX(DATES)
+ */
+static void make_chunks(int begin, int rows, int group_num, Chunk &group_chunk, Chunk &aggr_chunk)
+{
+  auto group1 = make_unique<Column>(AttrType::INTS, 4);
+  auto group2 = make_unique<Column>(AttrType::CHARS, 4);
+  auto group3 = make_unique<Column>(AttrType::DATES, 4);
+  auto aggr1  = make_unique<Column>(AttrType::INTS, 4);
+  auto aggr2  = make_unique<Column>(AttrType::INTS, 4);
+  auto aggr3  = make_unique<Column>(AttrType::FLOATS, 4);
+  auto aggr4  = make_unique<Column>(AttrType::INTS, 4);
+  auto aggr5  = make_unique<Column>(AttrType::CHARS, 4);
+  auto aggr6  = make_unique<Column>(AttrType::FLOATS, 4);
+  auto aggr7  = make_unique<Column>(AttrType::DATES, 4);
+  for (int i = begin; i < begin + rows; i++) {
+    int   key   = i % group_num;
+    int   date  = 20200101 + key % 28;
+    int   value = i % 1000 - 300;
+    float fval  = i % 100 + 0.5f;
+    char  str[4];
+    memset(str, 0, sizeof(str));
+    snprintf(str, sizeof(str), "%d", key % 3);
+    char name[4];
+    memset(name, 0, sizeof(name));
+    snprintf(name, sizeof(name), "%c%d", 'a' + i % 26, i % 10);
+
+    group1->append_one((char *)&key);
+    group2->append_one(str);
+    group3->append_one((char *)&date);
+    aggr1->append_one((char *)&value);
+    aggr2->append_one((char *)&value);
+    aggr3->append_one((char *)&fval);
+    aggr4->append_one((char *)&value);
+    aggr5->append_one(name);
+    aggr6->append_one((char *)&fval);
+    aggr7->append_one((char *)&date);
+  }
+  group_chunk.add_column(std::move(group1), 0);
+  group_chunk.add_column(std::move(group2), 1);
+  group_chunk.add_column(std::move(group3), 2);
+  aggr_chunk.add_column(std::move(aggr1), 0);
+  aggr_chunk.add_column(std::move(aggr2), 1);
+  aggr_chunk.add_column(std::move(aggr3), 2);
+  aggr_chunk.add_column(std::move(aggr4), 3);
+  aggr_chunk.add_column(std::move(aggr5), 4);
+  aggr_chunk.add_column(std::move(aggr6), 5);
+  aggr_chunk.add_column(std::move(aggr7), 6);
+}
+
+static const AggregateExpr::Type AGGREGATE_TYPES[] = {AggregateExpr::Type::COUNT,
+    AggregateExpr::Type::SUM,
+    AggregateExpr::Type::SUM,
+    AggregateExpr::Type::AVG,
+    AggregateExpr::Type::MAX,
+    AggregateExpr::Type::MIN,
+    AggregateExpr::Type::MAX};
+
+/**
+ * @brief 扫描哈希表中的所有分组，按照 group by 列的值记录每个分组的聚合结果
+ */
+static void scan_hash_table(
+    AggregateHashTable::Scanner &scanner, Chunk &group_chunk, Chunk &aggr_chunk, map<string, vector<string>> &result)
+{
+  const int group_column_num = group_chunk.column_num();
+  Chunk     output_chunk;
+  for (int i = 0; i < group_column_num; i++) {
+    output_chunk.add_column(
+        make_unique<Column>(group_chunk.column(i).attr_type(), group_chunk.column(i).attr_len()), i);
+  }
+  for (int i = 0; i < aggr_chunk.column_num(); i++) {
+    AttrType type;
+    int      len;
+    AggregateHashTable::aggregate_result_type(
+        AGGREGATE_TYPES[i], aggr_chunk.column(i).attr_type(), aggr_chunk.column(i).attr_len(), type, len);
+    output_chunk.add_column(make_unique<Column>(type, len), group_column_num + i);
+  }
+
+  scanner.open_scan();
+  while (scanner.next(output_chunk) == RC::SUCCESS) {
+    ASSERT_GT(output_chunk.rows(), 0);
+    for (int row = 0; row < output_chunk.rows(); row++) {
+      string key;
+      for (int i = 0; i < group_column_num; i++) {
+        key += output_chunk.get_value(i, row).to_string() + ",";
+      }
+      vector<string> values;
+      for (int i = group_column_num; i < output_chunk.column_num(); i++) {
+        values.push_back(output_chunk.get_value(i, row).to_string());
+      }
+      ASSERT_TRUE(result.emplace(key, values).second) << "duplicate group " << key;
+    }
+    output_chunk.reset_data();
+  }
+  scanner.close_scan();
+}
+
+TEST(AggregateHashTableTest, open_addressing_hash_table)
+{
+  vector<unique_ptr<AggregateExpr>> aggregate_exprs;
+  vector<Expression *>              aggregations;
+  for (AggregateExpr::Type type : AGGREGATE_TYPES) {
+    aggregate_exprs.push_back(make_unique<AggregateExpr>(type, nullptr));
+    aggregations.push_back(aggregate_exprs.back().get());
+  }
+
+  // 分组的个数从少到多，最多的情况下哈希表需要扩容多次，结果也需要多次扫描才能输出
+  for (int group_num : {1, 7, 1000, 20000}) {
+    StandardAggregateHashTable       standard_hash_table(aggregations);
+    OpenAddressingAggregateHashTable hash_table(aggregations);
+
+    const int rows_per_chunk = 8000;
+    Chunk     last_group_chunk;
+    Chunk     last_aggr_chunk;
+    for (int begin = 0; begin < 24000; begin += rows_per_chunk) {
+      Chunk group_chunk;
+      Chunk aggr_chunk;
+      make_chunks(begin, rows_per_chunk, group_num, group_chunk, aggr_chunk);
+      ASSERT_EQ(RC::SUCCESS, standard_hash_table.add_chunk(group_chunk, aggr_chunk));
+      ASSERT_EQ(RC::SUCCESS, hash_table.add_chunk(group_chunk, aggr_chunk));
+      if (begin == 0) {
+        make_chunks(begin, 1, group_num, last_group_chunk, last_aggr_chunk);
+      }
+    }
+
+    ASSERT_EQ(min(group_num, 24000), hash_table.size());
+    ASSERT_LE(hash_table.size() * 2, hash_table.capacity());
+
+    map<string, vector<string>> expected;
+    map<string, vector<string>> actual;
+    StandardAggregateHashTable::Scanner       standard_scanner(&standard_hash_table);
+    OpenAddressingAggregateHashTable::Scanner scanner(&hash_table);
+    scan_hash_table(standard_scanner, last_group_chunk, last_aggr_chunk, expected);
+    scan_hash_table(scanner, last_group_chunk, last_aggr_chunk, actual);
+    ASSERT_EQ(static_cast<size_t>(hash_table.size()), actual.size());
+    ASSERT_EQ(expected, actual);
+  }
+}
+
+TEST(AggregateHashTableTest, open_addressing_hash_table_constant_column)
+{
+  // count(*) 的参数是常量列
+  AggregateExpr        aggregate_expr(AggregateExpr::Type::COUNT, nullptr);
+  vector<Expression *> aggregations{&aggregate_expr};
+
+  Chunk group_chunk;
+  Chunk aggr_chunk;
+  auto  group = make_unique<Column>(AttrType::FLOATS, 4);
+  for (int i = 0; i < 100; i++) {
+    // 0.0 与 -0.0 是同一个分组
+    float key = (i % 2 == 0) ? 0.0f : -0.0f;
+    group->append_one((char *)&key);
+  }
+  auto count = make_unique<Column>();
+  count->init(Value(1));
+  group_chunk.add_column(std::move(group), 0);
+  aggr_chunk.add_column(std::move(count), 0);
+
+  OpenAddressingAggregateHashTable hash_table(aggregations);
+  ASSERT_EQ(RC::SUCCESS, hash_table.add_chunk(group_chunk, aggr_chunk));
+  ASSERT_EQ(1, hash_table.size());
+
+  Chunk output_chunk;
+  output_chunk.add_column(make_unique<Column>(AttrType::FLOATS, 4), 0);
+  output_chunk.add_column(make_unique<Column>(AttrType::INTS, 4), 1);
+  OpenAddressingAggregateHashTable::Scanner scanner(&hash_table);
+  scanner.open_scan();
+  ASSERT_EQ(RC::SUCCESS, scanner.next(output_chunk));
+  ASSERT_EQ(1, output_chunk.rows());
+  ASSERT_EQ(100, output_chunk.get_value(1, 0).get_int());
+  ASSERT_EQ(RC::RECORD_EOF, scanner.next(output_chunk));
+}
+
 #ifdef USE_SIMD
 TEST(AggregateHashTableTest, DISABLED_linear_probing_hash_table)
 {
@@ -12,7 +12,10 @@ See the Mulan PSL v2 for more details. */
 // Created by wangyunlai.wyl on 2021
 //
 
+#include <thread>
+
 #include "storage/buffer/disk_buffer_pool.h"
+#include "storage/buffer/frame_replacer.h"
 #include "gtest/gtest.h"
 
 void test_get(BPFrameManager &frame_manager)
@@ -125,6 +128,213 @@ TEST(test_frame_manager, test_frame_manager_simple_lru)
   frame_manager.cleanup();
 }
 
+TEST(test_frame_manager, test_frame_manager_purge_partitions)
+{
+  BPFrameManager frame_manager("Test");
+  frame_manager.init(2, 4);
+  ASSERT_EQ(4, frame_manager.partition_num());
+
+  // 两个文件的页面分散在所有分区中
+  std::vector<Frame *> frames;
+  for (int i = 0; true; i++) {
+    Frame *frame = frame_manager.alloc(i % 2, i / 2);
+    if (frame == nullptr) {
+      break;
+    }
+    frames.push_back(frame);
+  }
+  ASSERT_EQ(frames.size(), frame_manager.frame_num());
+  ASSERT_EQ(frames.size(), frame_manager.total_frame_num());
+
+  // 有引用的页面不能淘汰
+  int  purged_count = 0;
+  auto purger       = [&purged_count](Frame *frame) {
+    purged_count++;
+    return RC::SUCCESS;
+  };
+  ASSERT_EQ(0, frame_manager.purge_frames(1, purger));
+
+  for (Frame *frame : frames) {
+    frame->unpin();
+  }
+  frames[0]->pin();
+
+  // 一个分区中的页面不够时，继续从其它分区淘汰
+  const int count = static_cast<int>(frame_manager.frame_num()) - 1;
+  ASSERT_EQ(count, frame_manager.purge_frames(count, purger));
+  ASSERT_EQ(count, purged_count);
+  ASSERT_EQ(1, frame_manager.frame_num());
+  ASSERT_EQ(frames[0], frame_manager.get(0, 0));
+
+  frames[0]->unpin();
+  ASSERT_EQ(RC::SUCCESS, frame_manager.free(0, 0, frames[0]));
+  ASSERT_EQ(RC::SUCCESS, frame_manager.cleanup());
+}
+
+TEST(test_frame_manager, test_frame_manager_concurrency)
+{
+  BPFrameManager frame_manager("Test");
+  frame_manager.init(4);
+
+  const int thread_num               = 8;
+  const int page_num                 = 32;  // 每个线程使用的页面个数，总数不超过页帧的个数
+  const int loop_num                 = 200;
+  int       failed_count[thread_num] = {0};
+
+  auto worker = [&](int thread_index) {
+    for (int loop = 0; loop < loop_num; loop++) {
+      for (int i = 0; i < page_num; i++) {
+        Frame *frame = frame_manager.alloc(thread_index, i);
+        if (frame == nullptr || frame->page_num() != i) {
+          failed_count[thread_index]++;
+          continue;
+        }
+        frame->unpin();
+      }
+
+      for (int i = 0; i < page_num; i++) {
+        Frame *frame = frame_manager.get(thread_index, i);
+        if (frame == nullptr || frame->buffer_pool_id() != thread_index) {
+          failed_count[thread_index]++;
+          continue;
+        }
+        if (OB_FAIL(frame_manager.free(thread_index, i, frame))) {
+          failed_count[thread_index]++;
+        }
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < thread_num; i++) {
+    threads.emplace_back(worker, i);
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  for (int i = 0; i < thread_num; i++) {
+    ASSERT_EQ(0, failed_count[i]) << "thread " << i;
+  }
+  ASSERT_EQ(0, frame_manager.frame_num());
+  ASSERT_EQ(RC::SUCCESS, frame_manager.cleanup());
+}
+
+TEST(test_frame_manager, test_frame_manager_2q)
+{
+  BPFrameManager frame_manager("Test");
+  ASSERT_EQ(RC::INVALID_ARGUMENT, frame_manager.init(2, 4, "unknown"));
+
+  ASSERT_EQ(RC::SUCCESS, frame_manager.init(2, 4, "2q"));
+  ASSERT_STREQ("2q", frame_manager.eviction_policy());
+
+  test_get(frame_manager);
+  ASSERT_EQ(4, frame_manager.miss_count());
+  ASSERT_EQ(5, frame_manager.hit_count());
+
+  test_alloc(frame_manager);
+
+  frame_manager.cleanup();
+}
+
+/**
+ * @brief 模拟一个只有 capacity 个页帧的缓冲池，按顺序访问 pages 中的页面
+ * @return 没有命中的次数
+ */
+static int access_pages(FrameReplacer &replacer, std::vector<std::unique_ptr<Frame>> &frames, size_t capacity,
+    const std::vector<PageNum> &pages)
+{
+  int miss_count = 0;
+  for (PageNum page_num : pages) {
+    auto iter = std::find_if(frames.begin(), frames.end(), [page_num](const std::unique_ptr<Frame> &frame) {
+      return frame->page_num() == page_num;
+    });
+    if (iter != frames.end()) {
+      replacer.access(iter->get());
+      continue;
+    }
+
+    miss_count++;
+    if (frames.size() >= capacity) {
+      Frame *victim = nullptr;
+      replacer.foreach_victim([&victim](Frame *frame) {
+        victim = frame;
+        return false;
+      });
+      replacer.remove(victim, true /*evicted*/);
+      frames.erase(std::find_if(frames.begin(), frames.end(), [victim](const std::unique_ptr<Frame> &frame) {
+        return frame.get() == victim;
+      }));
+    }
+
+    auto frame = std::make_unique<Frame>();
+    frame->set_buffer_pool_id(0);
+    frame->set_page_num(page_num);
+    replacer.insert(frame.get());
+    frames.emplace_back(std::move(frame));
+  }
+  return miss_count;
+}
+
+TEST(test_frame_replacer, test_lru)
+{
+  auto                                replacer = FrameReplacer::create(nullptr, 4);
+  std::vector<std::unique_ptr<Frame>> frames;
+  ASSERT_STREQ("lru", replacer->name());
+  ASSERT_EQ(nullptr, FrameReplacer::create("unknown", 4));
+
+  ASSERT_EQ(4, access_pages(*replacer, frames, 4, {0, 1, 2, 3, 0}));
+
+  std::vector<PageNum> victims;
+  replacer->foreach_victim([&victims](Frame *frame) {
+    victims.push_back(frame->page_num());
+    return true;
+  });
+  ASSERT_EQ((std::vector<PageNum>{1, 2, 3, 0}), victims);
+
+  // 淘汰最久没有访问的 1
+  ASSERT_EQ(1, access_pages(*replacer, frames, 4, {4, 0, 2, 3}));
+  ASSERT_EQ(1, access_pages(*replacer, frames, 4, {1}));
+  ASSERT_EQ(0, access_pages(*replacer, frames, 4, {3}));
+}
+
+TEST(test_frame_replacer, test_2q_scan_resistant)
+{
+  const size_t         capacity = 16;
+  const int            loop_num = 10;
+  std::vector<PageNum> hot_pages;
+  for (int i = 0; i < 4; i++) {
+    hot_pages.push_back(i);
+  }
+
+  // 热点页面(比如B+树的内部节点)反复访问，每两次访问之间扫描 capacity 个新的页面
+  auto run = [&](FrameReplacer &replacer, int loop_begin, int loop_end) {
+    std::vector<std::unique_ptr<Frame>> frames;
+    int                                 hot_miss_count = 0;
+    for (int loop = 0; loop < loop_end; loop++) {
+      std::vector<PageNum> scan_pages;
+      for (size_t i = 0; i < capacity; i++) {
+        scan_pages.push_back(100 + loop * capacity + i);
+      }
+
+      const int miss_count = access_pages(replacer, frames, capacity, hot_pages);
+      hot_miss_count += loop >= loop_begin ? miss_count : 0;
+      access_pages(replacer, frames, capacity, scan_pages);
+    }
+    return hot_miss_count;
+  };
+
+  // LRU 中热点页面每次都被扫描挤出去
+  auto lru = FrameReplacer::create("lru", capacity);
+  ASSERT_EQ(static_cast<int>(hot_pages.size()) * loop_num, run(*lru, 0, loop_num));
+
+  // 2Q 中热点页面第二次读入时进入 Am 队列，之后扫描的页面只会替换 A1in 中的页面
+  TwoQueueFrameReplacer two_queue(capacity);
+  ASSERT_EQ(0, run(two_queue, 2, loop_num));
+  ASSERT_EQ(hot_pages.size(), two_queue.am_size());
+  ASSERT_EQ(capacity - hot_pages.size(), two_queue.a1in_size());
+}
+
 int main(int argc, char **argv)
 {
 
@@ -0,0 +1,459 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/18.
+//
+
+#include <string.h>
+
+#include "common/lang/algorithm.h"
+#include "common/lang/random.h"
+#include "common/lang/filesystem.h"
+#include "sql/parser/parse_defs.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/buffer/double_write_buffer.h"
+#include "storage/clog/vacuous_log_handler.h"
+#include "storage/db/db.h"
+#include "storage/index/bplus_tree.h"
+#include "storage/index/bplus_tree_index.h"
+#include "storage/table/table.h"
+#include "storage/trx/trx.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace common;
+
+/**
+ * @brief 在一个整数字段上创建B+树，测试结束时关闭并删除文件
+ */
+class BplusTreeBulkLoadTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    ::remove(file_name_);
+    ASSERT_EQ(RC::SUCCESS, bpm_.init(make_unique<VacuousDoubleWriteBuffer>()));
+    ASSERT_EQ(RC::SUCCESS, bpm_.create_file(file_name_));
+    ASSERT_EQ(RC::SUCCESS, bpm_.open_file(log_handler_, file_name_, buffer_pool_));
+  }
+
+  void TearDown() override
+  {
+    handler_.close();
+    ::remove(file_name_);
+  }
+
+  void create_tree(bool nullable, bool unique)
+  {
+    const int len = nullable ? sizeof(int) + 1 : sizeof(int);
+    FieldMeta field("id", AttrType::INTS, 0, len, true /*visible*/, 0, nullable);
+    ASSERT_EQ(RC::SUCCESS, index_meta_.init("bulk_load_index", IndexType::BPlusTreeIndex, {field}, unique));
+    ASSERT_EQ(RC::SUCCESS, handler_.create(log_handler_, *buffer_pool_, index_meta_));
+  }
+
+  /// 键值由user_key和RID组成。NULL值使用字段最后一个字节标记
+  void append_key(vector<char> &keys, int value, bool is_null, const RID &rid)
+  {
+    const int attr_length = index_meta_.fields_total_len();
+    const int offset      = static_cast<int>(keys.size());
+    keys.resize(keys.size() + attr_length + sizeof(RID));
+    memset(keys.data() + offset, 0, attr_length);
+    memcpy(keys.data() + offset, &value, sizeof(value));
+    if (attr_length > static_cast<int>(sizeof(int))) {
+      keys[offset + attr_length - 1] = is_null ? '1' : '0';
+    }
+    memcpy(keys.data() + offset + attr_length, &rid, sizeof(RID));
+  }
+
+  int scan_count()
+  {
+    BplusTreeScanner scanner(handler_);
+    EXPECT_EQ(RC::SUCCESS, scanner.open(nullptr, 0, true, nullptr, 0, true));
+
+    int count = 0;
+    RID rid;
+    while (scanner.next_entry(rid) == RC::SUCCESS) {
+      count++;
+    }
+    scanner.close();
+    return count;
+  }
+
+protected:
+  const char       *file_name_ = "bplus_tree_bulk_load.bp";
+  VacuousLogHandler log_handler_;
+  BufferPoolManager bpm_;
+  DiskBufferPool   *buffer_pool_ = nullptr;
+  IndexMeta         index_meta_;
+  BplusTreeHandler  handler_;
+};
+
+TEST_F(BplusTreeBulkLoadTest, build_and_modify)
+{
+  create_tree(false /*nullable*/, false /*unique*/);
+
+  // 每个值重复两次，乱序加载
+  const int   value_num = 60000;
+  vector<int> values;
+  for (int i = 0; i < value_num; i++) {
+    values.push_back(i);
+    values.push_back(i);
+  }
+  shuffle(values.begin(), values.end(), mt19937(0));
+
+  vector<char> keys;
+  for (size_t i = 0; i < values.size(); i++) {
+    append_key(keys, values[i], false, RID(static_cast<PageNum>(i / 1000), static_cast<SlotNum>(i % 1000)));
+  }
+  const int num = static_cast<int>(values.size());
+
+  ASSERT_EQ(RC::SUCCESS, handler_.bulk_load(keys.data(), num, false /*unique*/));
+  ASSERT_FALSE(handler_.is_empty());
+  ASSERT_TRUE(handler_.validate_tree());
+  ASSERT_EQ(num, scan_count());
+
+  // 已经有数据的B+树不能再批量加载
+  ASSERT_NE(RC::SUCCESS, handler_.bulk_load(keys.data(), num, false /*unique*/));
+
+  for (int value : {0, 1, value_num / 2, value_num - 1}) {
+    list<RID> rids;
+    ASSERT_EQ(RC::SUCCESS, handler_.get_entry(reinterpret_cast<const char *>(&value), sizeof(value), rids));
+    ASSERT_EQ(2, static_cast<int>(rids.size()));
+  }
+
+  // 批量构建的B+树可以继续插入和删除
+  for (int i = 0; i < 10000; i++) {
+    const int value = value_num + i;
+    RID       rid(100000, i);
+    ASSERT_EQ(RC::SUCCESS, handler_.insert_entry(reinterpret_cast<const char *>(&value), &rid));
+  }
+  for (size_t i = 0; i < values.size(); i += 2) {
+    RID rid(static_cast<PageNum>(i / 1000), static_cast<SlotNum>(i % 1000));
+    ASSERT_EQ(RC::SUCCESS, handler_.delete_entry(reinterpret_cast<const char *>(&values[i]), &rid));
+  }
+  ASSERT_TRUE(handler_.validate_tree());
+  ASSERT_EQ(num / 2 + 10000, scan_count());
+}
+
+TEST_F(BplusTreeBulkLoadTest, unique)
+{
+  create_tree(true /*nullable*/, true /*unique*/);
+
+  // NULL不算重复的值
+  vector<char> keys;
+  for (int i = 0; i < 1000; i++) {
+    append_key(keys, i, false, RID(1, i));
+  }
+  for (int i = 0; i < 10; i++) {
+    append_key(keys, 0, true, RID(2, i));
+  }
+  ASSERT_EQ(RC::SUCCESS, handler_.bulk_load(keys.data(), 1010, true /*unique*/));
+  ASSERT_TRUE(handler_.validate_tree());
+  ASSERT_EQ(1010, scan_count());
+}
+
+TEST_F(BplusTreeBulkLoadTest, duplicate_key)
+{
+  create_tree(true /*nullable*/, true /*unique*/);
+
+  vector<char> keys;
+  for (int i = 0; i < 1000; i++) {
+    append_key(keys, i, false, RID(1, i));
+  }
+  append_key(keys, 500, false, RID(2, 0));
+  ASSERT_EQ(RC::RECORD_DUPLICATE_KEY, handler_.bulk_load(keys.data(), 1001, true /*unique*/));
+  ASSERT_TRUE(handler_.is_empty());
+}
+
+TEST_F(BplusTreeBulkLoadTest, delete_while_scanning)
+{
+  create_tree(false /*nullable*/, false /*unique*/);
+
+  const int num = 20000;
+  for (int i = 0; i < num; i++) {
+    RID rid(1, i);
+    ASSERT_EQ(RC::SUCCESS, handler_.insert_entry(reinterpret_cast<const char *>(&i), &rid));
+  }
+
+  // 扫描器不会在两次 next_entry 之间持有页面，边扫描边删除时节点的合并不会影响扫描
+  BplusTreeScanner scanner(handler_);
+  ASSERT_EQ(RC::SUCCESS, scanner.open(nullptr, 0, true, nullptr, 0, true));
+
+  int count = 0;
+  RID rid;
+  RC  rc = RC::SUCCESS;
+  while ((rc = scanner.next_entry(rid)) == RC::SUCCESS) {
+    ASSERT_EQ(count, rid.slot_num);
+    ASSERT_EQ(RC::SUCCESS, handler_.delete_entry(reinterpret_cast<const char *>(&count), &rid));
+    count++;
+  }
+  ASSERT_EQ(RC::RECORD_EOF, rc);
+  scanner.close();
+
+  ASSERT_EQ(num, count);
+  ASSERT_TRUE(handler_.is_empty());
+}
+
+TEST_F(BplusTreeBulkLoadTest, get_entries)
+{
+  create_tree(false /*nullable*/, false /*unique*/);
+
+  // 偶数值每个重复三次，记录位置与键值的顺序无关
+  const int num = 20000;
+  for (int i = 0; i < num; i += 2) {
+    for (int j = 0; j < 3; j++) {
+      RID rid(num - i, j);
+      ASSERT_EQ(RC::SUCCESS, handler_.insert_entry(reinterpret_cast<const char *>(&i), &rid));
+    }
+  }
+
+  // 乱序、重复、不存在以及跨越多个叶子节点的值
+  vector<int> values = {num - 2, 7, 0, 4, 4, -1, num, num / 2, 1, num / 2 + 2, 12, 6000};
+  vector<const char *> keys;
+  for (const int &value : values) {
+    keys.push_back(reinterpret_cast<const char *>(&value));
+  }
+
+  vector<RID> rids;
+  ASSERT_EQ(RC::SUCCESS, handler_.get_entries(keys, rids));
+
+  vector<RID> expected;
+  for (int value : {0, 4, 12, 6000, num / 2, num / 2 + 2, num - 2}) {
+    for (int j = 0; j < 3; j++) {
+      expected.emplace_back(num - value, j);
+    }
+  }
+  sort(expected.begin(), expected.end(), [](const RID &a, const RID &b) { return RID::compare(&a, &b) < 0; });
+  ASSERT_EQ(expected.size(), rids.size());
+  for (size_t i = 0; i < rids.size(); i++) {
+    ASSERT_EQ(0, RID::compare(&expected[i], &rids[i]));
+  }
+
+  // 都不存在或者没有要查找的值
+  vector<int> missing = {-5, 3, num + 1};
+  keys.clear();
+  for (const int &value : missing) {
+    keys.push_back(reinterpret_cast<const char *>(&value));
+  }
+  ASSERT_EQ(RC::SUCCESS, handler_.get_entries(keys, rids));
+  ASSERT_TRUE(rids.empty());
+  ASSERT_EQ(RC::SUCCESS, handler_.get_entries({}, rids));
+  ASSERT_TRUE(rids.empty());
+}
+
+TEST_F(BplusTreeBulkLoadTest, open_checks_format)
+{
+  create_tree(false /*nullable*/, false /*unique*/);
+
+  // 索引文件头在第一个页面上(页面0是缓冲池自己的文件头)
+  auto modify_header = [this](const function<void(IndexFileHeader &)> &modifier) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool_->get_this_page(1, &frame));
+    modifier(*reinterpret_cast<IndexFileHeader *>(frame->data()));
+    frame->mark_dirty();
+    buffer_pool_->unpin_page(frame);
+  };
+
+  BplusTreeHandler reopened;
+  modify_header([](IndexFileHeader &header) { header.magic = 0; });
+  ASSERT_EQ(RC::INDEX_FORMAT_MISMATCH, reopened.open(log_handler_, *buffer_pool_));
+
+  modify_header([](IndexFileHeader &header) {
+    header.magic          = IndexFileHeader::MAGIC;
+    header.format_version = IndexFileHeader::FORMAT_VERSION - 1;
+  });
+  ASSERT_EQ(RC::INDEX_FORMAT_MISMATCH, reopened.open(log_handler_, *buffer_pool_));
+
+  modify_header([](IndexFileHeader &header) { header.format_version = IndexFileHeader::FORMAT_VERSION; });
+  ASSERT_EQ(RC::SUCCESS, reopened.open(log_handler_, *buffer_pool_));
+  ASSERT_EQ(handler_.file_header().key_length, reopened.file_header().key_length);
+}
+
+/**
+ * @brief 在一个很长的字符串字段上创建B+树，所有的键值都有很长的公共前缀
+ */
+class BplusTreePrefixTest : public BplusTreeBulkLoadTest
+{
+protected:
+  static const int FIELD_LEN = 1024;
+
+  void create_tree()
+  {
+    FieldMeta field("name", AttrType::CHARS, 0, FIELD_LEN, true /*visible*/, 0, false /*nullable*/);
+    ASSERT_EQ(RC::SUCCESS, index_meta_.init("prefix_index", IndexType::BPlusTreeIndex, {field}, false /*unique*/));
+    ASSERT_EQ(RC::SUCCESS, handler_.create(log_handler_, *buffer_pool_, index_meta_));
+  }
+
+  /// 只有最后8个字符不同
+  string make_value(int value)
+  {
+    string str(FIELD_LEN, 'a');
+    snprintf(str.data() + FIELD_LEN - 9, 10, "%08d", value);
+    str.resize(FIELD_LEN);
+    return str;
+  }
+
+  /// 不做前缀压缩时存放这些键值至少需要的叶子页面个数
+  int static_leaf_pages(int num) const { return num / handler_.file_header().leaf_max_size; }
+};
+
+TEST_F(BplusTreePrefixTest, bulk_load)
+{
+  create_tree();
+
+  const int   num = 20000;
+  vector<int> values(num);
+  for (int i = 0; i < num; i++) {
+    values[i] = i;
+  }
+  shuffle(values.begin(), values.end(), mt19937(0));
+
+  vector<char> keys;
+  for (int i = 0; i < num; i++) {
+    const string value = make_value(values[i]);
+    const RID    rid(1, i);
+    keys.insert(keys.end(), value.begin(), value.end());
+    keys.insert(keys.end(), reinterpret_cast<const char *>(&rid), reinterpret_cast<const char *>(&rid) + sizeof(RID));
+  }
+
+  ASSERT_EQ(RC::SUCCESS, handler_.bulk_load(keys.data(), num, false /*unique*/));
+  ASSERT_TRUE(handler_.validate_tree());
+  ASSERT_EQ(num, scan_count());
+  ASSERT_LT(buffer_pool_->page_count(), static_leaf_pages(num));
+
+  for (int value : {0, num / 2, num - 1}) {
+    const string key = make_value(value);
+    list<RID>    rids;
+    ASSERT_EQ(RC::SUCCESS, handler_.get_entry(key.data(), FIELD_LEN, rids));
+    ASSERT_EQ(1, static_cast<int>(rids.size()));
+  }
+}
+
+TEST_F(BplusTreePrefixTest, insert_and_delete)
+{
+  create_tree();
+
+  const int   num = 20000;
+  vector<int> values(num);
+  for (int i = 0; i < num; i++) {
+    values[i] = i;
+  }
+  shuffle(values.begin(), values.end(), mt19937(1));
+
+  for (int i = 0; i < num; i++) {
+    const string key = make_value(values[i]);
+    const RID    rid(1, values[i]);
+    ASSERT_EQ(RC::SUCCESS, handler_.insert_entry(key.data(), &rid));
+  }
+  ASSERT_TRUE(handler_.validate_tree());
+  ASSERT_EQ(num, scan_count());
+  ASSERT_LT(buffer_pool_->page_count(), static_leaf_pages(num));
+
+  // 删除大部分数据，触发节点的合并与重新分配
+  shuffle(values.begin(), values.end(), mt19937(2));
+  const int remain = num / 10;
+  for (int i = remain; i < num; i++) {
+    const string key = make_value(values[i]);
+    const RID    rid(1, values[i]);
+    ASSERT_EQ(RC::SUCCESS, handler_.delete_entry(key.data(), &rid));
+  }
+  ASSERT_TRUE(handler_.validate_tree());
+  ASSERT_EQ(remain, scan_count());
+
+  for (int i = 0; i < remain; i++) {
+    const string key = make_value(values[i]);
+    list<RID>    rids;
+    ASSERT_EQ(RC::SUCCESS, handler_.get_entry(key.data(), FIELD_LEN, rids));
+    ASSERT_EQ(1, static_cast<int>(rids.size()));
+  }
+}
+
+
+/**
+ * @brief 键值超过内存限制时，一部分批量构建，剩下的逐条插入
+ */
+TEST(BplusTreeIndex, bulk_load_memory_limit)
+{
+  filesystem::path directory("bplus_tree_index_bulk_load");
+  filesystem::remove_all(directory);
+  ASSERT_TRUE(filesystem::create_directories(directory));
+
+  auto db = make_unique<Db>();
+  ASSERT_EQ(RC::SUCCESS, db->init("bulk_load", directory.c_str(), "mvcc", "disk"));
+  AttrInfoSqlNode attr{AttrType::INTS, "id", 4, false};
+  ASSERT_EQ(RC::SUCCESS, db->create_table("t", span<const AttrInfoSqlNode>(&attr, 1)));
+  Table *table = static_cast<Table *>(db->find_table("t"));
+  ASSERT_NE(table, nullptr);
+
+  const int num       = 5000;
+  const int bulk_num  = 1000;
+  // 最后一条记录的值是 last_value，其它记录的值各不相同
+  auto load_keys = [table](BplusTreeIndex &index, int last_value, int64_t memory_limit) {
+    int i = 0;
+    return index.bulk_load(
+        [&](Record &record) {
+          if (i >= num) {
+            return RC::RECORD_EOF;
+          }
+          Value value(i == num - 1 ? last_value : i);
+          RC    rc = table->make_record(1, &value, record);
+          record.set_rid(RID(i / 100 + 1, i % 100));
+          i++;
+          return rc;
+        },
+        memory_limit);
+  };
+
+  const FieldMeta *field = table->table_meta().field("id");
+  ASSERT_NE(field, nullptr);
+  IndexMeta index_meta;
+  ASSERT_EQ(RC::SUCCESS, index_meta.init("id_index", IndexType::BPlusTreeIndex, {*field}, true /*unique*/));
+  const int64_t memory_limit = static_cast<int64_t>(bulk_num) * (index_meta.fields_total_len() + sizeof(RID));
+
+  {
+    BplusTreeIndex index;
+    ASSERT_EQ(RC::SUCCESS, index.create(table, (directory / "id_index.index").c_str(), index_meta));
+    ASSERT_EQ(RC::SUCCESS, load_keys(index, num, memory_limit));
+
+    IndexScanner *scanner = index.create_scanner(nullptr, 0, true, nullptr, 0, true);
+    ASSERT_NE(scanner, nullptr);
+    int count = 0;
+    RID rid;
+    while (scanner->next_entry(&rid) == RC::SUCCESS) {
+      count++;
+    }
+    scanner->destroy();
+    ASSERT_EQ(num, count);
+
+    // 批量构建的和逐条插入的键值都能找到
+    for (int value : {0, bulk_num - 1, bulk_num, num - 2, num}) {
+      vector<RID> rids;
+      ASSERT_EQ(RC::SUCCESS, index.get_entries({reinterpret_cast<const char *>(&value)}, rids));
+      ASSERT_EQ(1, static_cast<int>(rids.size()));
+    }
+  }
+
+  // 逐条插入的部分也会检查唯一性
+  {
+    BplusTreeIndex index;
+    ASSERT_EQ(RC::SUCCESS, index.create(table, (directory / "id_index2.index").c_str(), index_meta));
+    ASSERT_EQ(RC::RECORD_DUPLICATE_KEY, load_keys(index, 0, memory_limit));
+  }
+
+  db.reset();
+  filesystem::remove_all(directory);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
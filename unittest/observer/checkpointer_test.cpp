@@ -0,0 +1,76 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/18.
+//
+
+#include "gtest/gtest.h"
+
+#define private public
+#define protected public
+
+#include "common/lang/filesystem.h"
+#include "common/log/log.h"
+#include "common/value.h"
+#include "sql/parser/parse_defs.h"
+#include "storage/buffer/double_write_buffer.h"
+#include "storage/db/db.h"
+#include "storage/table/base_table.h"
+#include "storage/trx/trx.h"
+
+using namespace std;
+using namespace common;
+
+TEST(Checkpointer, flush_double_write_buffer)
+{
+  filesystem::path directory("checkpointer_flush_dblwr");
+  filesystem::remove_all(directory);
+  ASSERT_TRUE(filesystem::create_directories(directory));
+
+  auto db = make_unique<Db>();
+  ASSERT_EQ(RC::SUCCESS, db->init("checkpointer_test", directory.c_str(), "mvcc", "disk"));
+  AttrInfoSqlNode attr{AttrType::INTS, "id", 4, false};
+  ASSERT_EQ(RC::SUCCESS, db->create_table("t", span<const AttrInfoSqlNode>(&attr, 1)));
+  BaseTable *table = db->find_table("t");
+  ASSERT_NE(table, nullptr);
+
+  Trx *trx = db->trx_kit().create_trx(db->log_handler());
+  ASSERT_EQ(RC::SUCCESS, trx->start_if_need());
+  for (int i = 0; i < 1000; i++) {
+    Value  value(i);
+    Record record;
+    ASSERT_EQ(RC::SUCCESS, table->make_record(1, &value, record));
+    ASSERT_EQ(RC::SUCCESS, trx->insert_record(table, record));
+  }
+  ASSERT_EQ(RC::SUCCESS, trx->commit());
+  db->trx_kit().destroy_trx(trx);
+
+  // 检查点把修改过的页面交给 double write buffer。页面不多，不会装满 double write buffer，
+  // 推进检查点之前要主动写回数据文件，否则删除日志之后宕机，这些页面就只留在没有落盘的 double write buffer 中
+  Checkpointer &checkpointer = db->checkpointer();
+  const LSN     old_lsn      = db->check_point_lsn();
+  ASSERT_EQ(RC::SUCCESS, checkpointer.checkpoint_once());
+  ASSERT_GT(db->check_point_lsn(), old_lsn);
+
+  auto &dblwr_buffer = static_cast<DiskDoubleWriteBuffer &>(*db->buffer_pool_manager().get_dblwr_buffer());
+  ASSERT_TRUE(dblwr_buffer.dblwr_pages_.empty());
+
+  db.reset();
+  filesystem::remove_all(directory);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  filesystem::path log_filename = filesystem::path(argv[0]).filename();
+  LoggerFactory::init_default(log_filename.string() + ".log", LOG_LEVEL_TRACE);
+  return RUN_ALL_TESTS();
+}
@@ -60,6 +60,226 @@ TEST(ChunkTest, chunk_test)
   }
 }
 
+TEST(ChunkTest, selection)
+{
+  const int row_num = 10;
+  Chunk     chunk;
+  chunk.add_column(std::make_unique<Column>(AttrType::INTS, sizeof(int), row_num), 0);
+  chunk.add_column(std::make_unique<Column>(AttrType::CHARS, 3, row_num), 1);
+  for (int i = 0; i < row_num; i++) {
+    char str[3] = {'a', static_cast<char>('a' + i), 'z'};
+    chunk.column(0).append_one((char *)&i);
+    chunk.column(1).append_one(str);
+  }
+  ASSERT_FALSE(chunk.has_selection());
+  ASSERT_EQ(chunk.selected_rows(), row_num);
+
+  // 所有行都有效时不设置选择向量
+  vector<uint8_t> select(row_num, 1);
+  ASSERT_EQ(chunk.set_selection(select), row_num);
+  ASSERT_FALSE(chunk.has_selection());
+
+  for (int i = 0; i < row_num; i++) {
+    select[i] = (i % 3 == 0) ? 1 : 0;
+  }
+  ASSERT_EQ(chunk.set_selection(select), 4);
+  ASSERT_TRUE(chunk.has_selection());
+  ASSERT_EQ(chunk.rows(), row_num);
+  ASSERT_EQ(chunk.selected_rows(), 4);
+  for (int i = 0; i < chunk.selected_rows(); i++) {
+    ASSERT_EQ(chunk.row_index(i), i * 3);
+  }
+
+  Chunk chunk2;
+  chunk2.reference(chunk);
+  ASSERT_TRUE(chunk2.has_selection());
+  ASSERT_EQ(chunk2.selected_rows(), 4);
+  ASSERT_EQ(chunk2.get_value(0, chunk2.row_index(3)).get_int(), 9);
+
+  // 按列收集有效的行
+  Column ints(AttrType::INTS, sizeof(int), row_num);
+  Column chars(AttrType::CHARS, 3, row_num);
+  ASSERT_EQ(ints.append_selected(chunk.column(0), chunk.selection().data(), chunk.selected_rows()), RC::SUCCESS);
+  ASSERT_EQ(chars.append_selected(chunk.column(1), chunk.selection().data(), chunk.selected_rows()), RC::SUCCESS);
+  ASSERT_EQ(ints.count(), 4);
+  ASSERT_EQ(chars.count(), 4);
+  for (int i = 0; i < 4; i++) {
+    ASSERT_EQ(ints.get_value(i).get_int(), i * 3);
+    ASSERT_EQ(chars.data()[i * 3 + 1], 'a' + i * 3);
+  }
+
+  // 常量列复制多次
+  Column constant;
+  constant.init(Value(7));
+  ASSERT_EQ(ints.append_selected(constant, chunk.selection().data(), 2), RC::SUCCESS);
+  ASSERT_EQ(ints.count(), 6);
+  ASSERT_EQ(ints.get_value(5).get_int(), 7);
+
+  // 空间不够或者长度不一致时失败
+  ASSERT_EQ(ints.append_selected(chunk.column(0), chunk.selection().data(), chunk.selected_rows()), RC::SUCCESS);
+  ASSERT_NE(ints.append_selected(chunk.column(0), chunk.selection().data(), chunk.selected_rows()), RC::SUCCESS);
+  ASSERT_NE(chars.append_selected(chunk.column(0), chunk.selection().data(), 1), RC::SUCCESS);
+
+  // 一行都不满足
+  select.assign(row_num, 0);
+  ASSERT_EQ(chunk.set_selection(select), 0);
+  ASSERT_TRUE(chunk.has_selection());
+  ASSERT_EQ(chunk.selected_rows(), 0);
+
+  chunk.reset_data();
+  ASSERT_FALSE(chunk.has_selection());
+}
+
+TEST(ChunkTest, column_by_id)
+{
+  // 表扫描只输出用到的字段，列的 id 是 field_id，与下标不同
+  Chunk chunk;
+  chunk.add_column(std::make_unique<Column>(AttrType::INTS, sizeof(int), 4), 3);
+  chunk.add_column(std::make_unique<Column>(AttrType::FLOATS, sizeof(float), 4), 7);
+  ASSERT_EQ(chunk.column_by_id(3), chunk.column_ptr(0));
+  ASSERT_EQ(chunk.column_by_id(7), chunk.column_ptr(1));
+  ASSERT_EQ(chunk.column_by_id(0), nullptr);
+  ASSERT_EQ(chunk.column_by_id(1), nullptr);
+
+  Chunk chunk2;
+  chunk2.reference(chunk);
+  ASSERT_EQ(chunk2.column_by_id(7)->attr_type(), AttrType::FLOATS);
+}
+
+TEST(ChunkTest, null_bitmap)
+{
+  // 可以为 NULL 的字段在记录中是 4 字节的值加 1 字节的标记，列中只保存值
+  FieldMeta meta("col1", AttrType::INTS, 0, sizeof(int) + 1, true, 0, true /*nullable*/);
+  Column    column(meta, 16);
+  ASSERT_TRUE(column.nullable());
+  ASSERT_EQ(column.attr_len(), static_cast<int>(sizeof(int)));
+  ASSERT_EQ(column.field_len(), static_cast<int>(sizeof(int) + 1));
+
+  char fields[10 * (sizeof(int) + 1)];
+  for (int i = 0; i < 10; i++) {
+    char *field = fields + i * (sizeof(int) + 1);
+    memcpy(field, &i, sizeof(int));
+    field[sizeof(int)] = i % 3 == 0 ? '1' : 0;
+  }
+  ASSERT_EQ(column.append_field_data(fields, 10), RC::SUCCESS);
+  ASSERT_EQ(column.count(), 10);
+  ASSERT_EQ(column.null_count(), 4);
+  for (int i = 0; i < 10; i++) {
+    ASSERT_EQ(column.is_null(i), i % 3 == 0);
+    if (i % 3 != 0) {
+      ASSERT_EQ(reinterpret_cast<const int *>(column.data())[i], i);
+      ASSERT_EQ(column.get_value(i).get_int(), i);
+    } else {
+      ASSERT_TRUE(column.get_value(i).is_null());
+    }
+  }
+
+  ASSERT_EQ(column.append_null(), RC::SUCCESS);
+  ASSERT_TRUE(column.is_null(10));
+  column.set_null(10, false);
+  ASSERT_FALSE(column.is_null(10));
+  ASSERT_EQ(column.null_count(), 4);
+
+  // 收集时 null 位图跟着一起收集
+  const int selection[] = {0, 1, 3, 5};
+  Column    selected(AttrType::INTS, sizeof(int), 4, true /*nullable*/);
+  ASSERT_EQ(selected.append_selected(column, selection, 4), RC::SUCCESS);
+  ASSERT_EQ(selected.null_count(), 2);
+  ASSERT_TRUE(selected.is_null(0));
+  ASSERT_FALSE(selected.is_null(1));
+  ASSERT_TRUE(selected.is_null(2));
+  ASSERT_EQ(selected.get_value(3).get_int(), 5);
+
+  // 不可以为 NULL 的列不能收集 NULL 值
+  Column not_null(AttrType::INTS, sizeof(int), 4);
+  ASSERT_NE(not_null.append_selected(column, selection, 4), RC::SUCCESS);
+  ASSERT_NE(not_null.append_null(), RC::SUCCESS);
+
+  Column reference;
+  reference.reference(column);
+  ASSERT_EQ(reference.null_count(), 4);
+  ASSERT_TRUE(reference.is_null(9));
+
+  column.reset_data();
+  ASSERT_FALSE(column.has_null());
+
+  Value null_value;
+  null_value.set_null();
+  Column constant;
+  constant.init(null_value);
+  ASSERT_TRUE(constant.is_null(100));
+}
+
+TEST(ChunkTest, var_len_column)
+{
+  // char(64) 超过了变长的阈值，列中只保存字符串实际的长度
+  const int field_len = 64 + 1;
+  FieldMeta meta("col1", AttrType::CHARS, 0, field_len, true, 0, true /*nullable*/);
+  Column    column(meta, 16);
+  ASSERT_TRUE(column.var_len());
+  ASSERT_EQ(column.attr_len(), 64);
+  ASSERT_EQ(column.data(), nullptr);
+
+  char fields[10 * field_len];
+  memset(fields, 0, sizeof(fields));
+  for (int i = 0; i < 10; i++) {
+    char *field = fields + i * field_len;
+    memset(field, 'a' + i, i * 6 + 1);
+    field[64] = i % 4 == 0 ? '1' : 0;
+  }
+  ASSERT_EQ(column.append_field_data(fields, 10), RC::SUCCESS);
+  ASSERT_EQ(column.count(), 10);
+  ASSERT_EQ(column.null_count(), 3);
+  int heap_size = 0;
+  for (int i = 0; i < 10; i++) {
+    int         len = 0;
+    const char *str = column.string_at(i, len);
+    if (i % 4 == 0) {
+      ASSERT_TRUE(column.is_null(i));
+      ASSERT_EQ(len, 0);
+      ASSERT_TRUE(column.get_value(i).is_null());
+    } else {
+      ASSERT_EQ(len, i * 6 + 1);
+      ASSERT_EQ(string(str, len), string(i * 6 + 1, 'a' + i));
+      ASSERT_EQ(column.get_value(i).get_string(), string(i * 6 + 1, 'a' + i));
+      heap_size += len;
+    }
+  }
+  ASSERT_EQ(column.data_len(), heap_size);
+
+  // 超过字段长度的部分截断，字符串的内存不够时自动扩容
+  string long_str(100, 'z');
+  ASSERT_EQ(column.append_string(long_str.data(), long_str.size()), RC::SUCCESS);
+  int len = 0;
+  column.string_at(10, len);
+  ASSERT_EQ(len, 64);
+
+  // 收集时字符串复制到目标列自己的内存中
+  const int selection[] = {1, 4, 10};
+  Column    selected(AttrType::CHARS, 64, 3, true /*nullable*/);
+  ASSERT_EQ(selected.append_selected(column, selection, 3), RC::SUCCESS);
+  ASSERT_EQ(selected.count(), 3);
+  ASSERT_TRUE(selected.is_null(1));
+  ASSERT_EQ(selected.get_value(0).get_string(), string(7, 'b'));
+  ASSERT_EQ(selected.get_value(2).get_string(), string(64, 'z'));
+
+  Column reference;
+  reference.reference(column);
+  ASSERT_TRUE(reference.var_len());
+  ASSERT_EQ(reference.get_value(9).get_string(), string(55, 'j'));
+
+  column.reset_data();
+  ASSERT_EQ(column.data_len(), 0);
+  ASSERT_EQ(column.append_string("abc", 3), RC::SUCCESS);
+  ASSERT_EQ(column.get_value(0).get_string(), "abc");
+
+  // TEXT 总是变长的
+  Column text(AttrType::TEXTS, 65535, 2);
+  ASSERT_TRUE(text.var_len());
+  ASSERT_EQ(text.append_string(long_str.data(), long_str.size()), RC::SUCCESS);
+  ASSERT_EQ(text.data_len(), 100);
+}
+
 int main(int argc, char **argv)
 {
 
@@ -0,0 +1,84 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/18.
+//
+
+#include "gtest/gtest.h"
+
+#include "storage/trx/commit_status_table.h"
+#include "storage/trx/mvcc_trx.h"
+
+TEST(commit_status_table, commit_and_remove)
+{
+  CommitStatusTable table;
+  atomic<int32_t>   last_trx_id{10};
+
+  int32_t commit_trx_id = 0;
+  EXPECT_FALSE(table.find(5, commit_trx_id));
+
+  EXPECT_EQ(table.commit(5, last_trx_id), 11);
+  EXPECT_EQ(table.commit(7, last_trx_id), 12);
+  EXPECT_EQ(last_trx_id.load(), 12);
+  EXPECT_EQ(table.size(), 2);
+
+  ASSERT_TRUE(table.find(5, commit_trx_id));
+  EXPECT_EQ(commit_trx_id, 11);
+  ASSERT_TRUE(table.find(7, commit_trx_id));
+  EXPECT_EQ(commit_trx_id, 12);
+
+  table.remove(5);
+  EXPECT_FALSE(table.find(5, commit_trx_id));
+  EXPECT_TRUE(table.find(7, commit_trx_id));
+  EXPECT_EQ(table.size(), 1);
+
+  table.add(20, 25);
+  ASSERT_TRUE(table.find(20, commit_trx_id));
+  EXPECT_EQ(commit_trx_id, 25);
+}
+
+TEST(commit_status_table, mvcc_trx_kit)
+{
+  MvccTrxKit trx_kit;
+  ASSERT_EQ(trx_kit.init(), RC::SUCCESS);
+
+  const int32_t trx_id        = trx_kit.next_trx_id();
+  const int32_t commit_trx_id = trx_kit.commit_trx(trx_id);
+  EXPECT_GT(commit_trx_id, trx_id);
+  EXPECT_EQ(trx_kit.last_trx_id(), commit_trx_id);
+
+  // 新事务的事务号比提交事务号大，一定能查到提交状态
+  EXPECT_GT(trx_kit.next_trx_id(), commit_trx_id);
+
+  int32_t found_trx_id = 0;
+  ASSERT_TRUE(trx_kit.find_commit_trx_id(trx_id, found_trx_id));
+  EXPECT_EQ(found_trx_id, commit_trx_id);
+
+  // 恢复时记录的提交事务号也会推进事务号分配
+  trx_kit.recover_commit(100, 200);
+  ASSERT_TRUE(trx_kit.find_commit_trx_id(100, found_trx_id));
+  EXPECT_EQ(found_trx_id, 200);
+  EXPECT_EQ(trx_kit.last_trx_id(), 200);
+
+  // 回写队列是空的
+  EXPECT_EQ(trx_kit.write_back_commits(), RC::SUCCESS);
+  EXPECT_EQ(trx_kit.oldest_active_lsn(), 0);
+}
+
+int main(int argc, char **argv)
+{
+  // 分析gtest程序的命令行参数
+  testing::InitGoogleTest(&argc, argv);
+
+  // 调用RUN_ALL_TESTS()运行所有测试用例
+  // main函数返回RUN_ALL_TESTS()的运行结果
+  return RUN_ALL_TESTS();
+}
@@ -12,7 +12,9 @@ See the Mulan PSL v2 for more details. */
 // Created by wangyunlai on 2024/02/01
 //
 
+#include <fcntl.h>
 #include <filesystem>
+#include <unistd.h>
 
 #include "gtest/gtest.h"
 #include "common/log/log.h"
@@ -105,6 +107,352 @@ TEST(DiskBufferPool, allocate_dispose)
   ASSERT_EQ(buffer_pool_manager.close_file(buffer_pool_filename.c_str()), RC::SUCCESS);
 }
 
+TEST(DiskBufferPool, dispose_pinned_page)
+{
+  filesystem::path directory("buffer_pool");
+  filesystem::remove_all(directory);
+  filesystem::create_directories(directory);
+
+  filesystem::path buffer_pool_filename = directory / "dispose_pinned.bp";
+
+  BufferPoolManager buffer_pool_manager;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.init(make_unique<VacuousDoubleWriteBuffer>()));
+  VacuousLogHandler log_handler;
+
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.create_file(buffer_pool_filename.c_str()));
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+
+  const int page_num = 3;
+  for (int i = 0; i < page_num; ++i) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+    ASSERT_EQ(buffer_pool->unpin_page(frame), RC::SUCCESS);
+  }
+
+  // 还被pin着的页面不等待，延迟释放
+  Frame *pinned_frame = nullptr;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->get_this_page(2, &pinned_frame));
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->dispose_page(2));
+  ASSERT_EQ(1, pinned_frame->pin_count());
+  ASSERT_TRUE(buffer_pool->is_page_allocated(2));
+
+  // 仍然pin着的时候不会被重新分配出去
+  Frame *frame = nullptr;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+  const PageNum new_page_num = frame->page_num();
+  ASSERT_NE(2, new_page_num);
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->dispose_page(new_page_num));
+  ASSERT_TRUE(buffer_pool->is_page_allocated(2));
+
+  // unpin之后再分配页面时释放，可以重新分配出去
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(pinned_frame));
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+  ASSERT_EQ(2, frame->page_num());
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+  ASSERT_EQ(page_num, buffer_pool_page_count(buffer_pool));
+
+  // 关闭文件前还没有释放的页面会在关闭时释放
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->get_this_page(3, &pinned_frame));
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->dispose_page(3));
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(pinned_frame));
+  ASSERT_EQ(buffer_pool_manager.close_file(buffer_pool_filename.c_str()), RC::SUCCESS);
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+  ASSERT_EQ(page_num - 1, buffer_pool_page_count(buffer_pool));
+
+  ASSERT_EQ(buffer_pool_manager.close_file(buffer_pool_filename.c_str()), RC::SUCCESS);
+}
+
+TEST(DiskBufferPool, read_ahead)
+{
+  filesystem::path directory("buffer_pool");
+  filesystem::remove_all(directory);
+  filesystem::create_directories(directory);
+
+  filesystem::path buffer_pool_filename = directory / "read_ahead.bp";
+
+  BufferPoolManager buffer_pool_manager;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.init(make_unique<VacuousDoubleWriteBuffer>()));
+  VacuousLogHandler log_handler;
+
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.create_file(buffer_pool_filename.c_str()));
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+
+  // 每个页面的开头写上自己的页号
+  const int page_num = 200;
+  for (int i = 0; i < page_num; ++i) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+    *reinterpret_cast<PageNum *>(frame->data()) = frame->page_num();
+    frame->mark_dirty();
+    ASSERT_EQ(buffer_pool->unpin_page(frame), RC::SUCCESS);
+  }
+  ASSERT_EQ(buffer_pool_manager.close_file(buffer_pool_filename.c_str()), RC::SUCCESS);
+
+  // 只遍历页号，前 READ_AHEAD_TRIGGER 个页面之后的页面都会被预读。关闭文件时会等待预读完成
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+  ASSERT_EQ(page_num, buffer_pool_page_count(buffer_pool));
+  ASSERT_EQ(buffer_pool_manager.close_file(buffer_pool_filename.c_str()), RC::SUCCESS);
+  ASSERT_EQ(page_num - BufferPoolIterator::READ_AHEAD_TRIGGER, buffer_pool_manager.read_ahead_count());
+
+  // 一边扫描一边预读，读到的页面内容要正确
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+  BufferPoolIterator iterator;
+  ASSERT_EQ(RC::SUCCESS, iterator.init(*buffer_pool, 1));
+  int count = 0;
+  while (iterator.has_next()) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->get_this_page(iterator.next(), &frame));
+    frame->read_latch();
+    ASSERT_EQ(frame->page_num(), *reinterpret_cast<PageNum *>(frame->data()));
+    frame->read_unlatch();
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+    count++;
+  }
+  ASSERT_EQ(page_num, count);
+  ASSERT_EQ(buffer_pool_manager.close_file(buffer_pool_filename.c_str()), RC::SUCCESS);
+}
+
+TEST(DiskBufferPool, page_cleaner)
+{
+  filesystem::path directory("buffer_pool");
+  filesystem::remove_all(directory);
+  filesystem::create_directories(directory);
+
+  filesystem::path buffer_pool_filename = directory / "page_cleaner.bp";
+
+  // 只有 128 个页帧，写完之后空闲的页帧不到一半
+  BufferPoolManager buffer_pool_manager(DEFAULT_ITEM_NUM_PER_POOL * BP_PAGE_SIZE);
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.init(make_unique<VacuousDoubleWriteBuffer>()));
+  VacuousLogHandler log_handler;
+
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.create_file(buffer_pool_filename.c_str()));
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+
+  const int page_num = 100;
+  for (int i = 0; i < page_num; ++i) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+    *reinterpret_cast<PageNum *>(frame->data()) = frame->page_num();
+    frame->mark_dirty();
+    ASSERT_EQ(buffer_pool->unpin_page(frame), RC::SUCCESS);
+  }
+
+  // 没有启动后台线程，直接执行一轮
+  PageCleaner &page_cleaner = buffer_pool_manager.page_cleaner();
+  page_cleaner.set_clean_percent(50);
+  const int flushed = page_cleaner.clean_once();
+  ASSERT_GT(flushed, 0);
+  ASSERT_EQ(static_cast<uint64_t>(flushed), page_cleaner.flushed_page_count());
+  // 页号连续的页面合并成一次写
+  ASSERT_LT(page_cleaner.flush_write_count(), page_cleaner.flushed_page_count());
+  ASSERT_EQ(0, page_cleaner.sync_flush_count());
+
+  // 被刷出去的页帧变成干净的，磁盘上的内容就是页帧中的内容
+  int fd = open(buffer_pool_filename.c_str(), O_RDONLY);
+  ASSERT_GE(fd, 0);
+  int clean_count = 0;
+  for (Frame *frame : buffer_pool_manager.get_frame_manager().find_list(buffer_pool->id())) {
+    if (frame->page_num() != BP_HEADER_PAGE && !frame->dirty()) {
+      Page page;
+      ASSERT_EQ(static_cast<ssize_t>(sizeof(page)), pread(fd, &page, sizeof(page), frame->page_num() * sizeof(Page)));
+      ASSERT_EQ(frame->page_num(), *reinterpret_cast<PageNum *>(page.data));
+      clean_count++;
+    }
+    frame->unpin();
+  }
+  close(fd);
+  ASSERT_EQ(flushed, clean_count);
+
+  // 后台线程刷脏页时，页面的内容也要正确
+  ASSERT_EQ(RC::SUCCESS, page_cleaner.start(100 /*clean_percent*/, 10 /*interval_ms*/));
+  for (int i = 0; i < page_num; ++i) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->get_this_page(i + 1, &frame));
+    *reinterpret_cast<PageNum *>(frame->data() + sizeof(PageNum)) = frame->page_num();
+    frame->mark_dirty();
+    ASSERT_EQ(buffer_pool->unpin_page(frame), RC::SUCCESS);
+  }
+  page_cleaner.stop();
+  ASSERT_EQ(buffer_pool_manager.close_file(buffer_pool_filename.c_str()), RC::SUCCESS);
+
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+  for (int i = 0; i < page_num; ++i) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->get_this_page(i + 1, &frame));
+    ASSERT_EQ(i + 1, *reinterpret_cast<PageNum *>(frame->data()));
+    ASSERT_EQ(i + 1, *reinterpret_cast<PageNum *>(frame->data() + sizeof(PageNum)));
+    ASSERT_EQ(buffer_pool->unpin_page(frame), RC::SUCCESS);
+  }
+  ASSERT_EQ(buffer_pool_manager.close_file(buffer_pool_filename.c_str()), RC::SUCCESS);
+}
+
+TEST(DiskBufferPool, flush_old_pages)
+{
+  filesystem::path directory("buffer_pool");
+  filesystem::remove_all(directory);
+  filesystem::create_directories(directory);
+
+  filesystem::path buffer_pool_filename = directory / "flush_old_pages.bp";
+
+  BufferPoolManager buffer_pool_manager(DEFAULT_ITEM_NUM_PER_POOL * BP_PAGE_SIZE);
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.init(make_unique<VacuousDoubleWriteBuffer>()));
+  VacuousLogHandler log_handler;
+
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.create_file(buffer_pool_filename.c_str()));
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+
+  BPFrameManager &frame_manager = buffer_pool_manager.get_frame_manager();
+  PageCleaner    &page_cleaner  = buffer_pool_manager.page_cleaner();
+
+  // 不写日志时没有需要重做的脏页
+  const int page_num = 10;
+  for (int i = 0; i < page_num; ++i) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+    ASSERT_EQ(buffer_pool->unpin_page(frame), RC::SUCCESS);
+  }
+  ASSERT_EQ(0, frame_manager.min_rec_lsn());
+
+  // 模拟修改页面时写的日志，第 i 个页面的LSN是 10+i
+  for (int i = 1; i <= page_num; ++i) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->get_this_page(i, &frame));
+    frame->set_lsn(10 + i);
+    frame->mark_dirty();
+    ASSERT_EQ(10 + i, frame->rec_lsn());
+    ASSERT_EQ(buffer_pool->unpin_page(frame), RC::SUCCESS);
+  }
+  ASSERT_EQ(11, frame_manager.min_rec_lsn());
+
+  // 再次修改时 rec_lsn 不变
+  Frame *frame = nullptr;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->get_this_page(1, &frame));
+  frame->set_lsn(100);
+  ASSERT_EQ(11, frame->rec_lsn());
+  ASSERT_EQ(buffer_pool->unpin_page(frame), RC::SUCCESS);
+
+  // 刷出 rec_lsn 小于 15 的页面
+  ASSERT_EQ(4, page_cleaner.flush_old_pages(15));
+  ASSERT_EQ(15, frame_manager.min_rec_lsn());
+
+  // 刷出之后再修改，rec_lsn 是新的LSN
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->get_this_page(1, &frame));
+  ASSERT_FALSE(frame->dirty());
+  ASSERT_EQ(0, frame->rec_lsn());
+  frame->set_lsn(200);
+  frame->mark_dirty();
+  ASSERT_EQ(200, frame->rec_lsn());
+
+  // 刷页面失败时恢复成较小的 rec_lsn
+  frame->clear_dirty();
+  frame->set_lsn(300);
+  frame->restore_dirty(200);
+  ASSERT_TRUE(frame->dirty());
+  ASSERT_EQ(200, frame->rec_lsn());
+  ASSERT_EQ(buffer_pool->unpin_page(frame), RC::SUCCESS);
+
+  // 被引用着的页帧先跳过
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->get_this_page(5, &frame));
+  ASSERT_EQ(page_num - 4, page_cleaner.flush_old_pages(1000));
+  ASSERT_EQ(15, frame_manager.min_rec_lsn());
+  ASSERT_EQ(buffer_pool->unpin_page(frame), RC::SUCCESS);
+  ASSERT_EQ(1, page_cleaner.flush_old_pages(1000));
+  ASSERT_EQ(0, frame_manager.min_rec_lsn());
+
+  ASSERT_EQ(buffer_pool_manager.close_file(buffer_pool_filename.c_str()), RC::SUCCESS);
+}
+
+TEST(DiskBufferPool, allocation_map_segment)
+{
+  /*
+  文件头中的位图写满之后，文件继续增长，后面的页面由段的位图页面管理。
+  直接修改文件头，假装前面的页面都已经分配了，文件中间没有写过的部分是空洞，不占用磁盘空间。
+  */
+  filesystem::path directory("buffer_pool");
+  filesystem::remove_all(directory);
+  filesystem::create_directories(directory);
+
+  filesystem::path buffer_pool_filename = directory / "allocation_map.bp";
+
+  BufferPoolManager buffer_pool_manager;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.init(make_unique<VacuousDoubleWriteBuffer>()));
+  VacuousLogHandler log_handler;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.create_file(buffer_pool_filename.c_str()));
+
+  const int header_page_num = BPFileHeader::MAX_PAGE_NUM;
+  {
+    int fd = open(buffer_pool_filename.c_str(), O_RDWR);
+    ASSERT_GE(fd, 0);
+    Page page;
+    ASSERT_EQ(static_cast<ssize_t>(sizeof(page)), pread(fd, &page, sizeof(page), 0));
+    BPFileHeader *file_header    = reinterpret_cast<BPFileHeader *>(page.data);
+    file_header->page_count      = header_page_num - 1;
+    file_header->allocated_pages = header_page_num - 1;
+    memset(file_header->bitmap, 0xFF, header_page_num / 8);
+    Bitmap(file_header->bitmap, header_page_num).clear_bit(header_page_num - 1);
+    ASSERT_EQ(static_cast<ssize_t>(sizeof(page)), pwrite(fd, &page, sizeof(page), 0));
+    close(fd);
+  }
+
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+
+  // 文件头管理的最后一个页面，然后是新的段，段的第一个页面存放位图
+  vector<PageNum> page_nums;
+  for (int i = 0; i < 3; i++) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+    page_nums.push_back(frame->page_num());
+    ASSERT_EQ(buffer_pool->unpin_page(frame), RC::SUCCESS);
+  }
+  ASSERT_EQ(header_page_num - 1, page_nums[0]);
+  ASSERT_EQ(header_page_num + 1, page_nums[1]);
+  ASSERT_EQ(header_page_num + 2, page_nums[2]);
+  ASSERT_FALSE(buffer_pool->is_page_allocated(header_page_num));
+  ASSERT_NE(RC::SUCCESS, buffer_pool->dispose_page(header_page_num));
+
+  // 释放的页面会被重新分配，先分配页号小的
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->dispose_page(header_page_num + 1));
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->dispose_page(10));
+  ASSERT_FALSE(buffer_pool->is_page_allocated(header_page_num + 1));
+  for (PageNum expected : {10, header_page_num + 1}) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+    ASSERT_EQ(expected, frame->page_num());
+    ASSERT_EQ(buffer_pool->unpin_page(frame), RC::SUCCESS);
+  }
+
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->dispose_page(header_page_num + 2));
+  ASSERT_EQ(buffer_pool_manager.close_file(buffer_pool_filename.c_str()), RC::SUCCESS);
+
+  // 重新打开后从磁盘加载段的位图
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+  ASSERT_TRUE(buffer_pool->is_page_allocated(header_page_num + 1));
+  ASSERT_FALSE(buffer_pool->is_page_allocated(header_page_num + 2));
+
+  // 遍历时跳过位图页面
+  BufferPoolIterator iterator;
+  iterator.init(*buffer_pool, header_page_num - 2);
+  vector<PageNum> iterated;
+  while (iterator.has_next()) {
+    iterated.push_back(iterator.next());
+  }
+  ASSERT_EQ((vector<PageNum>{header_page_num - 2, header_page_num - 1, header_page_num + 1}), iterated);
+
+  Frame *frame = nullptr;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+  ASSERT_EQ(header_page_num + 2, frame->page_num());
+  ASSERT_EQ(buffer_pool->unpin_page(frame), RC::SUCCESS);
+  ASSERT_EQ(buffer_pool_manager.close_file(buffer_pool_filename.c_str()), RC::SUCCESS);
+
+  filesystem::remove_all(directory);
+}
+
 TEST(BufferPool, create)
 {
   filesystem::path test_directory("buffer_pool");
@@ -180,6 +180,120 @@ TEST(DiskLogHandler, multi_thread)
   ASSERT_EQ(RC::SUCCESS, handler.await_termination());
 }
 
+TEST(DiskLogHandler, group_commit)
+{
+  const char *directory = "test_log_handler_group_commit";
+  filesystem::remove_all(directory);
+
+  // 刷盘线程空闲时的等待时间很长，提交的事务只能依靠追加日志时的唤醒完成
+  DiskLogHandler  handler;
+  TestLogReplayer replayer;
+  handler.set_flush_interval_ms(60 * 1000);
+  ASSERT_EQ(RC::SUCCESS, handler.init(directory));
+  ASSERT_EQ(RC::SUCCESS, handler.replay(replayer, 0));
+  ASSERT_EQ(RC::SUCCESS, handler.start());
+
+  const int      thread_num = 8;
+  const int      times      = 500;
+  atomic<int>    failed_count{0};
+  vector<thread> threads;
+  for (int i = 0; i < thread_num; i++) {
+    threads.emplace_back([&handler, &failed_count]() {
+      for (int j = 0; j < times; j++) {
+        LSN lsn = 0;
+        RC  rc  = handler.append(lsn, LogModule::Id::TRANSACTION, vector<char>(10));
+        if (OB_SUCC(rc)) {
+          rc = handler.wait_lsn(lsn);
+        }
+        if (OB_FAIL(rc) || handler.current_flushed_lsn() < lsn) {
+          failed_count++;
+        }
+      }
+    });
+  }
+  for (thread &t : threads) {
+    t.join();
+  }
+
+  ASSERT_EQ(0, failed_count.load());
+  ASSERT_EQ(thread_num * times, handler.current_flushed_lsn());
+
+  // 停止之后等待日志会立即返回
+  ASSERT_EQ(RC::SUCCESS, handler.stop());
+  ASSERT_EQ(RC::INTERNAL, handler.wait_lsn(thread_num * times + 1));
+  ASSERT_EQ(RC::SUCCESS, handler.await_termination());
+
+  int  count             = 0;
+  auto log_entry_counter = [&count](LogEntry &) -> RC {
+    count++;
+    return RC::SUCCESS;
+  };
+  ASSERT_EQ(RC::SUCCESS, handler.iterate(log_entry_counter, 0));
+  ASSERT_EQ(thread_num * times, count);
+
+  filesystem::remove_all(directory);
+}
+
+TEST(DiskLogHandler, stable_lsn)
+{
+  const char *directory = "test_log_handler_stable_lsn";
+  filesystem::remove_all(directory);
+
+  DiskLogHandler  handler;
+  TestLogReplayer replayer;
+  ASSERT_EQ(RC::SUCCESS, handler.init(directory));
+  ASSERT_EQ(RC::SUCCESS, handler.replay(replayer, 0));
+  ASSERT_EQ(RC::SUCCESS, handler.start());
+
+  LSN lsn = 0;
+  ASSERT_EQ(RC::SUCCESS, handler.append(lsn, LogModule::Id::BUFFER_POOL, vector<char>(10)));
+  ASSERT_EQ(lsn, handler.stable_lsn());
+
+  {
+    // 登记之后写的日志还没有反映到页帧上，检查点不能越过它们
+    LogLsnGuard guard(handler);
+    for (int i = 0; i < 10; i++) {
+      LSN other_lsn = 0;
+      ASSERT_EQ(RC::SUCCESS, handler.append(other_lsn, LogModule::Id::BUFFER_POOL, vector<char>(10)));
+      ASSERT_GT(other_lsn, lsn);
+    }
+    ASSERT_EQ(lsn, handler.stable_lsn());
+
+    // 同一个线程可以同时登记多次，各自占用一个槽位
+    {
+      LogLsnGuard inner_guard(handler);
+      ASSERT_EQ(lsn, handler.stable_lsn());
+    }
+    ASSERT_EQ(lsn, handler.stable_lsn());
+  }
+  ASSERT_EQ(handler.current_lsn(), handler.stable_lsn());
+  ASSERT_EQ(lsn + 10, handler.stable_lsn());
+
+  // 登记的线程比槽位多时，等其它线程取消登记之后再登记
+  atomic<bool>   stop{false};
+  vector<thread> threads;
+  for (int i = 0; i < 100; i++) {
+    threads.emplace_back([&handler, &stop]() {
+      while (!stop.load()) {
+        LogLsnGuard guard(handler);
+        LSN         lsn = 0;
+        ASSERT_EQ(RC::SUCCESS, handler.append(lsn, LogModule::Id::BUFFER_POOL, vector<char>(10)));
+        ASSERT_GT(lsn, handler.stable_lsn());
+      }
+    });
+  }
+  this_thread::sleep_for(chrono::milliseconds(100));
+  stop.store(true);
+  for (thread &thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(handler.current_lsn(), handler.stable_lsn());
+
+  ASSERT_EQ(RC::SUCCESS, handler.stop());
+  ASSERT_EQ(RC::SUCCESS, handler.await_termination());
+  filesystem::remove_all(directory);
+}
+
 int main(int argc, char **argv)
 {
   testing::InitGoogleTest(&argc, argv);
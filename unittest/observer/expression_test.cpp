@@ -307,6 +307,93 @@ TEST(ComparisonExpr, comparison_expr_test)
   }
 }
 
+TEST(ComparisonExpr, string_and_null_eval_test)
+{
+  // char(4) 可以为 NULL，第 3 行是 NULL
+  const int               char_len = 4;
+  FieldMeta               field_meta("col1", AttrType::CHARS, 0, char_len + 1, true, 0, true /*nullable*/);
+  Field                   field(nullptr, &field_meta);
+  const char             *strings[] = {"abc", "abcd", "ab", "", "b", "abd"};
+  const int               count     = sizeof(strings) / sizeof(strings[0]);
+  std::unique_ptr<Column> column    = std::make_unique<Column>(field_meta, count);
+  for (int i = 0; i < count; i++) {
+    char buf[char_len + 1] = {0};
+    strncpy(buf, strings[i], char_len);
+    buf[char_len] = i == 3 ? '1' : 0;
+    ASSERT_EQ(column->append_field_data(buf, 1), RC::SUCCESS);
+  }
+  Chunk chunk;
+  chunk.add_column(std::move(column), 0);
+
+  auto eval = [&](CompOp op, const Value &value, std::vector<uint8_t> &select) {
+    select.assign(count, 1);
+    ComparisonExpr expr(op, std::make_unique<FieldExpr>(field), std::make_unique<ValueExpr>(value));
+    return expr.eval(chunk, select);
+  };
+
+  // 比较结果与按行执行时 compare_value 的结果一致
+  std::vector<uint8_t> select;
+  const CompOp         ops[] = {EQUAL_TO, NOT_EQUAL, LESS_THAN, LESS_EQUAL, GREAT_THAN, GREAT_EQUAL, LIKE_OP, NOT_LIKE_OP};
+  const char          *patterns[] = {"abc", "abcd", "abc%", "a_c%", "%b%", "%d", "b"};
+  for (CompOp op : ops) {
+    for (const char *pattern : patterns) {
+      Value value(pattern);
+      ASSERT_EQ(eval(op, value, select), RC::SUCCESS);
+
+      ComparisonExpr expr(op, std::make_unique<FieldExpr>(field), std::make_unique<ValueExpr>(value));
+      for (int i = 0; i < count; i++) {
+        bool expected = false;
+        if (i != 3) {
+          ASSERT_EQ(expr.compare_value(Value(strings[i]), value, expected), RC::SUCCESS);
+        }
+        ASSERT_EQ(select[i], expected ? 1 : 0) << "op=" << op << ", pattern=" << pattern << ", row=" << i;
+      }
+    }
+  }
+
+  // IS NULL 只看 null 位图，与 NULL 比较的结果总是 false
+  Value null_value(NullValue{});
+  ASSERT_EQ(eval(IS_OP, null_value, select), RC::SUCCESS);
+  ASSERT_EQ(select, std::vector<uint8_t>({0, 0, 0, 1, 0, 0}));
+  ASSERT_EQ(eval(IS_NOT_OP, null_value, select), RC::SUCCESS);
+  ASSERT_EQ(select, std::vector<uint8_t>({1, 1, 1, 0, 1, 1}));
+  ASSERT_EQ(eval(EQUAL_TO, null_value, select), RC::SUCCESS);
+  ASSERT_EQ(select, std::vector<uint8_t>(count, 0));
+  ASSERT_EQ(eval(IS_OP, Value("abc"), select), RC::NOT_NULL_AFTER_IS);
+}
+
+TEST(ComparisonExpr, date_and_mixed_type_eval_test)
+{
+  const int               count = 4;
+  FieldMeta               date_meta("col1", AttrType::DATES, 0, sizeof(int), true, 0, false /*nullable*/);
+  FieldMeta               int_meta("col2", AttrType::INTS, sizeof(int), sizeof(int), true, 1, false /*nullable*/);
+  std::unique_ptr<Column> dates = std::make_unique<Column>(date_meta, count);
+  std::unique_ptr<Column> ints  = std::make_unique<Column>(int_meta, count);
+  for (int i = 0; i < count; i++) {
+    int date = 20240101 + i;
+    dates->append_one(reinterpret_cast<char *>(&date));
+    ints->append_one(reinterpret_cast<char *>(&i));
+  }
+  Chunk chunk;
+  chunk.add_column(std::move(dates), 0);
+  chunk.add_column(std::move(ints), 1);
+
+  // 日期与字符串常量比较时，常量转换成日期
+  std::vector<uint8_t> select(count, 1);
+  ComparisonExpr       date_expr(GREAT_EQUAL,
+      std::make_unique<FieldExpr>(Field(nullptr, &date_meta)),
+      std::make_unique<ValueExpr>(Value("2024-01-03")));
+  ASSERT_EQ(date_expr.eval(chunk, select), RC::SUCCESS);
+  ASSERT_EQ(select, std::vector<uint8_t>({0, 0, 1, 1}));
+
+  // 整数与浮点数比较时，整数转换成浮点数
+  select.assign(count, 1);
+  ComparisonExpr int_expr(
+      LESS_THAN, std::make_unique<FieldExpr>(Field(nullptr, &int_meta)), std::make_unique<ValueExpr>(Value(1.5f)));
+  ASSERT_EQ(int_expr.eval(chunk, select), RC::SUCCESS);
+  ASSERT_EQ(select, std::vector<uint8_t>({1, 1, 0, 0}));
+}
+
 TEST(AggregateExpr, aggregate_expr_test)
 {
   Value                  int_value(1);
@@ -0,0 +1,154 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#include <algorithm>
+#include <memory>
+
+#include "sql/operator/hash_join_physical_operator.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace common;
+
+/**
+ * @brief 按照下标取元组中的值
+ */
+class CellExpr : public Expression
+{
+public:
+  explicit CellExpr(int index) : index_(index) {}
+
+  RC       get_value(const Tuple &tuple, Value &value) override { return tuple.cell_at(index_, value); }
+  ExprType type() const override { return ExprType::FIELD; }
+  AttrType value_type() const override { return AttrType::INTS; }
+
+private:
+  int index_;
+};
+
+/**
+ * @brief 输出一组固定数据的算子，每一行都是 (key, payload)
+ */
+class RowsPhysicalOperator : public PhysicalOperator
+{
+public:
+  explicit RowsPhysicalOperator(vector<vector<Value>> rows) : rows_(std::move(rows)) {}
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::STRING_LIST; }
+
+  RC open(Trx *) override
+  {
+    pos_ = -1;
+    return RC::SUCCESS;
+  }
+
+  RC next() override
+  {
+    if (++pos_ >= static_cast<int>(rows_.size())) {
+      return RC::RECORD_EOF;
+    }
+    tuple_.set_cells(rows_[pos_]);
+    return RC::SUCCESS;
+  }
+
+  RC     close() override { return RC::SUCCESS; }
+  Tuple *current_tuple() override { return &tuple_; }
+
+private:
+  vector<vector<Value>> rows_;
+  int                   pos_ = -1;
+  ValueListTuple        tuple_;
+};
+
+static vector<vector<Value>> make_rows(const vector<pair<int, int>> &key_payloads)
+{
+  vector<vector<Value>> rows;
+  for (auto &[key, payload] : key_payloads) {
+    rows.push_back({Value(key), Value(payload)});
+  }
+  return rows;
+}
+
+static vector<vector<int>> run_join(vector<vector<Value>> left_rows, vector<vector<Value>> right_rows)
+{
+  vector<unique_ptr<Expression>> left_keys;
+  vector<unique_ptr<Expression>> right_keys;
+  left_keys.emplace_back(new CellExpr(0));
+  right_keys.emplace_back(new CellExpr(0));
+
+  HashJoinPhysicalOperator join(std::move(left_keys), std::move(right_keys));
+  join.add_child(make_unique<RowsPhysicalOperator>(std::move(left_rows)));
+  join.add_child(make_unique<RowsPhysicalOperator>(std::move(right_rows)));
+
+  vector<vector<int>> results;
+  EXPECT_EQ(RC::SUCCESS, join.open(nullptr));
+  RC rc = RC::SUCCESS;
+  while (RC::SUCCESS == (rc = join.next())) {
+    Tuple *tuple = join.current_tuple();
+    EXPECT_EQ(4, tuple->cell_num());
+    vector<int> row;
+    for (int i = 0; i < tuple->cell_num(); i++) {
+      Value value;
+      EXPECT_EQ(RC::SUCCESS, tuple->cell_at(i, value));
+      row.push_back(value.get_int());
+    }
+    results.push_back(row);
+  }
+  EXPECT_EQ(RC::RECORD_EOF, rc);
+  EXPECT_EQ(RC::SUCCESS, join.close());
+
+  sort(results.begin(), results.end());
+  return results;
+}
+
+TEST(HashJoinPhysicalOperator, build_on_right)
+{
+  auto results = run_join(make_rows({{1, 10}, {2, 20}, {3, 30}, {2, 21}, {5, 50}, {6, 60}}), make_rows({{2, 200}, {3, 300}}));
+
+  vector<vector<int>> expected = {{2, 20, 2, 200}, {2, 21, 2, 200}, {3, 30, 3, 300}};
+  ASSERT_EQ(expected, results);
+}
+
+TEST(HashJoinPhysicalOperator, build_on_left)
+{
+  auto results = run_join(make_rows({{2, 20}, {4, 40}}), make_rows({{1, 100}, {2, 200}, {2, 201}, {3, 300}, {4, 400}}));
+
+  vector<vector<int>> expected = {{2, 20, 2, 200}, {2, 20, 2, 201}, {4, 40, 4, 400}};
+  ASSERT_EQ(expected, results);
+}
+
+TEST(HashJoinPhysicalOperator, empty_input)
+{
+  ASSERT_TRUE(run_join(make_rows({}), make_rows({{1, 100}})).empty());
+  ASSERT_TRUE(run_join(make_rows({{1, 10}}), make_rows({})).empty());
+}
+
+TEST(HashJoinPhysicalOperator, null_never_matches)
+{
+  vector<vector<Value>> left_rows = make_rows({{1, 10}});
+  vector<vector<Value>> right_rows = make_rows({{1, 100}});
+
+  Value null_value(NullValue{});
+  left_rows.push_back({null_value, Value(11)});
+  right_rows.push_back({null_value, Value(101)});
+
+  vector<vector<int>> expected = {{1, 10, 1, 100}};
+  ASSERT_EQ(expected, run_join(std::move(left_rows), std::move(right_rows)));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
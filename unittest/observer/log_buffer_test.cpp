@@ -18,6 +18,8 @@ See the Mulan PSL v2 for more details. */
 #define protected public
 #include "storage/clog/log_buffer.h"
 #include "storage/clog/log_file.h"
+#include "common/lang/chrono.h"
+#include "common/lang/thread.h"
 
 using namespace std;
 using namespace common;
@@ -66,6 +68,97 @@ TEST(LogEntryBuffer, test_append)
   filesystem::remove("test_log_entry_buffer.log");
 }
 
+TEST(LogEntryBuffer, wrap_around)
+{
+  // 日志很大，很快就会写到缓冲区的末尾，从头开始存放
+  const char *filename = "test_log_entry_buffer_wrap.log";
+  filesystem::remove(filename);
+
+  LogEntryBuffer buffer;
+  ASSERT_EQ(RC::SUCCESS, buffer.init(0));
+
+  LogFileWriter writer;
+  ASSERT_EQ(RC::SUCCESS, writer.open(filename, 1000));
+
+  const int times = 40;
+  int       count = 0;
+  for (int i = 0; i < times; i++) {
+    LSN          lsn = 0;
+    vector<char> data((i % 7 + 1) * 300 * 1024 + i, static_cast<char>(i));
+    ASSERT_EQ(RC::SUCCESS, buffer.append(lsn, LogModule::Id::BUFFER_POOL, std::move(data)));
+    ASSERT_EQ(i + 1, lsn);
+
+    if (i % 2 == 1) {
+      ASSERT_EQ(RC::SUCCESS, buffer.flush(writer, count));
+      ASSERT_EQ(2, count);
+    }
+  }
+  ASSERT_EQ(times, buffer.flushed_lsn());
+  ASSERT_EQ(0, buffer.bytes());
+  ASSERT_EQ(0, buffer.entry_number());
+  writer.close();
+
+  LogFileReader reader;
+  ASSERT_EQ(RC::SUCCESS, reader.open(filename));
+  LSN  expected_lsn = 1;
+  auto checker      = [&expected_lsn](LogEntry &entry) -> RC {
+    const int i = static_cast<int>(expected_lsn - 1);
+    EXPECT_EQ(expected_lsn, entry.lsn());
+    EXPECT_EQ((i % 7 + 1) * 300 * 1024 + i, entry.payload_size());
+    EXPECT_EQ(static_cast<char>(i), entry.data()[0]);
+    EXPECT_EQ(static_cast<char>(i), entry.data()[entry.payload_size() - 1]);
+    expected_lsn++;
+    return RC::SUCCESS;
+  };
+  ASSERT_EQ(RC::SUCCESS, reader.iterate(checker));
+  ASSERT_EQ(times + 1, expected_lsn);
+  reader.close();
+
+  filesystem::remove(filename);
+}
+
+TEST(LogEntryBuffer, wait_for_space)
+{
+  const char *filename = "test_log_entry_buffer_space.log";
+  filesystem::remove(filename);
+
+  LogEntryBuffer buffer;
+  ASSERT_EQ(RC::SUCCESS, buffer.init(0));
+
+  LogFileWriter writer;
+  ASSERT_EQ(RC::SUCCESS, writer.open(filename, 1000));
+
+  const int entry_size = LogEntry::max_payload_size() * 3 / 4;
+  LSN       lsn        = 0;
+  ASSERT_EQ(RC::SUCCESS, buffer.append(lsn, LogModule::Id::BUFFER_POOL, vector<char>(entry_size)));
+  ASSERT_EQ(RC::SUCCESS, buffer.append(lsn, LogModule::Id::BUFFER_POOL, vector<char>(entry_size)));
+
+  // 缓冲区放不下第三条日志，要等到前面的日志刷盘之后才能追加
+  atomic<bool> appended{false};
+  thread       appender([&buffer, &appended, entry_size]() {
+    LSN lsn = 0;
+    EXPECT_EQ(RC::SUCCESS, buffer.append(lsn, LogModule::Id::BUFFER_POOL, vector<char>(entry_size)));
+    EXPECT_EQ(3, lsn);
+    appended.store(true);
+  });
+
+  this_thread::sleep_for(chrono::milliseconds(100));
+  ASSERT_FALSE(appended.load());
+
+  int count = 0;
+  ASSERT_EQ(RC::SUCCESS, buffer.flush(writer, count));
+  ASSERT_EQ(2, count);
+
+  appender.join();
+  ASSERT_TRUE(appended.load());
+  ASSERT_EQ(RC::SUCCESS, buffer.flush(writer, count));
+  ASSERT_EQ(1, count);
+  ASSERT_EQ(3, buffer.flushed_lsn());
+
+  writer.close();
+  filesystem::remove(filename);
+}
+
 int main(int argc, char **argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,311 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/18.
+//
+
+#include "gtest/gtest.h"
+
+#define private public
+#define protected public
+
+#include "common/lang/filesystem.h"
+#include "common/log/log.h"
+#include "common/value.h"
+#include "sql/parser/parse_defs.h"
+#include "storage/clog/log_handler.h"
+#include "storage/db/db.h"
+#include "storage/field/field.h"
+#include "storage/table/base_table.h"
+#include "storage/trx/mvcc_trx.h"
+
+using namespace std;
+using namespace common;
+
+static const char *TABLE_NAME = "t";
+
+static unique_ptr<Db> open_db(const filesystem::path &directory)
+{
+  auto db = make_unique<Db>();
+  EXPECT_EQ(db->init("mvcc_trx_test", directory.c_str(), "mvcc", "disk"), RC::SUCCESS);
+  return db;
+}
+
+static unique_ptr<Db> create_db(const filesystem::path &directory)
+{
+  filesystem::remove_all(directory);
+  EXPECT_TRUE(filesystem::create_directories(directory));
+
+  unique_ptr<Db>  db = open_db(directory);
+  AttrInfoSqlNode attr{AttrType::INTS, "id", 4, false};
+  EXPECT_EQ(db->create_table(TABLE_NAME, span<const AttrInfoSqlNode>(&attr, 1)), RC::SUCCESS);
+  return db;
+}
+
+static MvccTrx *start_trx(Db &db)
+{
+  auto *trx = static_cast<MvccTrx *>(db.trx_kit().create_trx(db.log_handler()));
+  EXPECT_EQ(trx->start_if_need(), RC::SUCCESS);
+  return trx;
+}
+
+static RID insert(MvccTrx &trx, BaseTable *table, int id)
+{
+  Value  value(id);
+  Record record;
+  EXPECT_EQ(table->make_record(1, &value, record), RC::SUCCESS);
+  EXPECT_EQ(trx.insert_record(table, record), RC::SUCCESS);
+  return record.rid();
+}
+
+/// 页面上记录的 begin xid
+static int32_t begin_xid_on_page(BaseTable *table, const RID &rid)
+{
+  Record record;
+  EXPECT_EQ(table->get_record(rid, record), RC::SUCCESS);
+  Field begin_field, end_field;
+  MvccTrx::trx_fields(table, begin_field, end_field);
+  return begin_field.get_int(record);
+}
+
+static RC visit(MvccTrx &trx, BaseTable *table, const RID &rid)
+{
+  Record record;
+  RC     rc = table->get_record(rid, record);
+  if (OB_SUCC(rc)) {
+    rc = trx.visit_record(table, record, ReadWriteMode::READ_ONLY);
+  }
+  return rc;
+}
+
+TEST(MvccTrx, commit_visible_at_once)
+{
+  filesystem::path directory("mvcc_trx_commit_visible");
+  unique_ptr<Db>   db    = create_db(directory);
+  BaseTable       *table = db->find_table(TABLE_NAME);
+  ASSERT_NE(table, nullptr);
+  auto &trx_kit = static_cast<MvccTrxKit &>(db->trx_kit());
+
+  MvccTrx    *writer = start_trx(*db);
+  vector<RID> rids;
+  for (int i = 0; i < 10; i++) {
+    rids.push_back(insert(*writer, table, i));
+  }
+
+  MvccTrx *old_reader = start_trx(*db);
+  for (const RID &rid : rids) {
+    ASSERT_EQ(visit(*old_reader, table, rid), RC::RECORD_INVISIBLE);
+  }
+
+  ASSERT_EQ(writer->commit(), RC::SUCCESS);
+
+  // 提交时没有修改记录，页面上还是负的事务号，通过提交状态表一起变得可见
+  MvccTrx *reader = start_trx(*db);
+  for (const RID &rid : rids) {
+    ASSERT_EQ(begin_xid_on_page(table, rid), -writer->id());
+    ASSERT_EQ(visit(*reader, table, rid), RC::SUCCESS);
+    ASSERT_EQ(visit(*old_reader, table, rid), RC::RECORD_INVISIBLE);
+  }
+
+  int32_t commit_trx_id = 0;
+  ASSERT_TRUE(trx_kit.find_commit_trx_id(writer->id(), commit_trx_id));
+
+  ASSERT_EQ(reader->commit(), RC::SUCCESS);
+  ASSERT_EQ(old_reader->commit(), RC::SUCCESS);
+  ASSERT_EQ(trx_kit.write_back_commits(), RC::SUCCESS);
+  for (const RID &rid : rids) {
+    ASSERT_EQ(begin_xid_on_page(table, rid), commit_trx_id);
+  }
+  ASSERT_FALSE(trx_kit.find_commit_trx_id(writer->id(), commit_trx_id));
+
+  trx_kit.destroy_trx(writer);
+  trx_kit.destroy_trx(old_reader);
+  trx_kit.destroy_trx(reader);
+  db.reset();
+  filesystem::remove_all(directory);
+}
+
+TEST(MvccTrx, write_back_skips_overwritten_record)
+{
+  filesystem::path directory("mvcc_trx_write_back_skip");
+  unique_ptr<Db>   db    = create_db(directory);
+  BaseTable       *table = db->find_table(TABLE_NAME);
+  ASSERT_NE(table, nullptr);
+  auto &trx_kit = static_cast<MvccTrxKit &>(db->trx_kit());
+
+  MvccTrx  *trx1 = start_trx(*db);
+  const RID rid  = insert(*trx1, table, 1);
+  ASSERT_EQ(trx1->commit(), RC::SUCCESS);
+
+  // 第一个事务还没有回写，第二个事务就更新了这条记录
+  MvccTrx *trx2 = start_trx(*db);
+  Record   old_record;
+  ASSERT_EQ(table->get_record(rid, old_record), RC::SUCCESS);
+  ASSERT_EQ(trx2->visit_record(table, old_record, ReadWriteMode::READ_WRITE), RC::SUCCESS);
+
+  Value  value(2);
+  Record new_record;
+  ASSERT_EQ(table->make_record(1, &value, new_record), RC::SUCCESS);
+  new_record.set_rid(rid);
+  ASSERT_EQ(trx2->update_record(table, old_record, new_record), RC::SUCCESS);
+  ASSERT_EQ(begin_xid_on_page(table, rid), -trx2->id());
+
+  // 回写第一个事务时不能覆盖第二个事务写的事务号
+  ASSERT_EQ(trx_kit.write_back_commits(), RC::SUCCESS);
+  ASSERT_EQ(begin_xid_on_page(table, rid), -trx2->id());
+
+  ASSERT_EQ(trx2->commit(), RC::SUCCESS);
+  int32_t commit_trx_id = 0;
+  ASSERT_TRUE(trx_kit.find_commit_trx_id(trx2->id(), commit_trx_id));
+  ASSERT_EQ(trx_kit.write_back_commits(), RC::SUCCESS);
+  ASSERT_EQ(begin_xid_on_page(table, rid), commit_trx_id);
+
+  trx_kit.destroy_trx(trx1);
+  trx_kit.destroy_trx(trx2);
+  db.reset();
+  filesystem::remove_all(directory);
+}
+
+TEST(MvccTrx, committed_trx_holds_oldest_active_lsn)
+{
+  filesystem::path directory("mvcc_trx_oldest_active_lsn");
+  unique_ptr<Db>   db    = create_db(directory);
+  BaseTable       *table = db->find_table(TABLE_NAME);
+  ASSERT_NE(table, nullptr);
+  auto &trx_kit = static_cast<MvccTrxKit &>(db->trx_kit());
+
+  ASSERT_EQ(trx_kit.oldest_active_lsn(), 0);
+
+  MvccTrx *trx = start_trx(*db);
+  insert(*trx, table, 1);
+  const LSN first_lsn = trx->first_lsn();
+  ASSERT_NE(first_lsn, 0);
+  ASSERT_EQ(trx_kit.oldest_active_lsn(), first_lsn);
+
+  // 提交之后事务自己不再记录 first_lsn，回写之前由回写队列拦住检查点
+  ASSERT_EQ(trx->commit(), RC::SUCCESS);
+  ASSERT_EQ(trx->first_lsn(), 0);
+  ASSERT_EQ(trx_kit.oldest_active_lsn(), first_lsn);
+
+  ASSERT_EQ(trx_kit.write_back_commits(), RC::SUCCESS);
+  ASSERT_EQ(trx_kit.oldest_active_lsn(), 0);
+
+  trx_kit.destroy_trx(trx);
+  db.reset();
+  filesystem::remove_all(directory);
+}
+
+TEST(MvccTrx, recover_commit_not_written_back)
+{
+  filesystem::path directory("mvcc_trx_recover_commit");
+  unique_ptr<Db>   db    = create_db(directory);
+  BaseTable       *table = db->find_table(TABLE_NAME);
+  ASSERT_NE(table, nullptr);
+
+  MvccTrx    *trx = start_trx(*db);
+  vector<RID> rids;
+  for (int i = 0; i < 10; i++) {
+    rids.push_back(insert(*trx, table, i));
+  }
+  ASSERT_EQ(trx->commit(), RC::SUCCESS);
+  const int32_t trx_id = trx->id();
+  db->trx_kit().destroy_trx(trx);
+
+  // 模拟回写之前宕机：丢掉回写队列，页面上留下的都是负的事务号
+  auto &trx_kit = static_cast<MvccTrxKit &>(db->trx_kit());
+  trx_kit.committed_trxes_.clear();
+  db.reset();
+
+  db    = open_db(directory);
+  table = db->find_table(TABLE_NAME);
+  ASSERT_NE(table, nullptr);
+
+  // 恢复时根据提交日志找回提交状态，回放结束时回写
+  MvccTrx *reader = start_trx(*db);
+  for (const RID &rid : rids) {
+    const int32_t begin_xid = begin_xid_on_page(table, rid);
+    ASSERT_GT(begin_xid, trx_id);
+    ASSERT_EQ(visit(*reader, table, rid), RC::SUCCESS);
+  }
+
+  db->trx_kit().destroy_trx(reader);
+  db.reset();
+  filesystem::remove_all(directory);
+}
+
+TEST(MvccTrx, copied_record_after_write_back)
+{
+  filesystem::path directory("mvcc_trx_copied_record");
+  unique_ptr<Db>   db    = create_db(directory);
+  BaseTable       *table = db->find_table(TABLE_NAME);
+  ASSERT_NE(table, nullptr);
+  auto &trx_kit = static_cast<MvccTrxKit &>(db->trx_kit());
+
+  MvccTrx  *writer = start_trx(*db);
+  const RID rid    = insert(*writer, table, 1);
+  ASSERT_EQ(writer->commit(), RC::SUCCESS);
+
+  // 像索引扫描一样，先复制记录，之后才判断可见性。中间后台线程回写了提交事务号
+  MvccTrx *reader = start_trx(*db);
+  Record   record;
+  ASSERT_EQ(table->get_record(rid, record), RC::SUCCESS);
+
+  ASSERT_EQ(trx_kit.write_back_commits(), RC::SUCCESS);
+  ASSERT_GT(begin_xid_on_page(table, rid), 0);
+
+  int32_t commit_trx_id = 0;
+  ASSERT_TRUE(trx_kit.find_commit_trx_id(writer->id(), commit_trx_id));
+  ASSERT_EQ(reader->visit_record(table, record, ReadWriteMode::READ_ONLY), RC::SUCCESS);
+
+  // 回写之前开始的事务都结束之后，提交状态才会删除
+  ASSERT_EQ(reader->commit(), RC::SUCCESS);
+  ASSERT_EQ(trx_kit.write_back_commits(), RC::SUCCESS);
+  ASSERT_FALSE(trx_kit.find_commit_trx_id(writer->id(), commit_trx_id));
+
+  trx_kit.destroy_trx(writer);
+  trx_kit.destroy_trx(reader);
+  db.reset();
+  filesystem::remove_all(directory);
+}
+
+TEST(MvccTrx, write_back_without_checkpoint)
+{
+  filesystem::path directory("mvcc_trx_write_back_batch");
+  unique_ptr<Db>   db    = create_db(directory);
+  BaseTable       *table = db->find_table(TABLE_NAME);
+  ASSERT_NE(table, nullptr);
+  auto &trx_kit = static_cast<MvccTrxKit &>(db->trx_kit());
+
+  // 不调用 write_back_commits，提交的事务积累到一批时自己回写
+  vector<RID> rids;
+  for (int i = 0; i < MvccTrxKit::WRITE_BACK_BATCH * 3; i++) {
+    MvccTrx *trx = start_trx(*db);
+    rids.push_back(insert(*trx, table, i));
+    ASSERT_EQ(trx->commit(), RC::SUCCESS);
+    trx_kit.destroy_trx(trx);
+
+    ASSERT_LT(static_cast<int>(trx_kit.committed_trxes_.size()), MvccTrxKit::WRITE_BACK_BATCH);
+    ASSERT_LT(static_cast<int>(trx_kit.commit_status_.size()), MvccTrxKit::WRITE_BACK_BATCH);
+  }
+
+  ASSERT_GT(begin_xid_on_page(table, rids.front()), 0);
+
+  db.reset();
+  filesystem::remove_all(directory);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  filesystem::path log_filename = filesystem::path(argv[0]).filename();
+  LoggerFactory::init_default(log_filename.string() + ".log", LOG_LEVEL_TRACE);
+  return RUN_ALL_TESTS();
+}
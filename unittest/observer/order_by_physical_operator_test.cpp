@@ -0,0 +1,232 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#include <algorithm>
+#include <memory>
+
+#include "sql/expr/sort_key.h"
+#include "sql/operator/order_by_physical_operator.h"
+#include "sql/operator/top_n_physical_operator.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace common;
+
+/**
+ * @brief 按照下标取元组中的值
+ */
+class CellExpr : public Expression
+{
+public:
+  explicit CellExpr(int index) : index_(index) {}
+
+  RC       get_value(const Tuple &tuple, Value &value) override { return tuple.cell_at(index_, value); }
+  ExprType type() const override { return ExprType::FIELD; }
+  AttrType value_type() const override { return AttrType::INTS; }
+
+private:
+  int index_;
+};
+
+/**
+ * @brief 输出一组固定数据的算子，每一行都是 (key, name)
+ */
+class RowsPhysicalOperator : public PhysicalOperator
+{
+public:
+  explicit RowsPhysicalOperator(vector<vector<Value>> rows) : rows_(std::move(rows))
+  {
+    tuple_.set_names({TupleCellSpec("t", "key"), TupleCellSpec("t", "name")});
+  }
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::STRING_LIST; }
+
+  RC open(Trx *) override
+  {
+    pos_ = -1;
+    return RC::SUCCESS;
+  }
+
+  RC next() override
+  {
+    if (++pos_ >= static_cast<int>(rows_.size())) {
+      return RC::RECORD_EOF;
+    }
+    tuple_.set_cells(rows_[pos_]);
+    return RC::SUCCESS;
+  }
+
+  RC     close() override { return RC::SUCCESS; }
+  Tuple *current_tuple() override { return &tuple_; }
+
+private:
+  vector<vector<Value>> rows_;
+  int                   pos_ = -1;
+  ValueListTuple        tuple_;
+};
+
+static string make_key(const Value &value, bool is_asc)
+{
+  string key;
+  SortKey::append(value, is_asc, key);
+  return key;
+}
+
+TEST(SortKey, order)
+{
+  Value null_value;
+  null_value.set_null();
+
+  ASSERT_LT(make_key(null_value, true), make_key(Value(-1), true));
+  ASSERT_LT(make_key(Value(-100), true), make_key(Value(-1), true));
+  ASSERT_LT(make_key(Value(-1), true), make_key(Value(0), true));
+  ASSERT_LT(make_key(Value(1), true), make_key(Value(256), true));
+  ASSERT_LT(make_key(Value(-2.5f), true), make_key(Value(-1.5f), true));
+  ASSERT_LT(make_key(Value(-0.5f), true), make_key(Value(0.25f), true));
+  ASSERT_LT(make_key(Value("ab"), true), make_key(Value("abc"), true));
+  ASSERT_LT(make_key(Value("abc"), true), make_key(Value("b"), true));
+
+  ASSERT_GT(make_key(null_value, false), make_key(Value(-1), false));
+  ASSERT_GT(make_key(Value(1), false), make_key(Value(256), false));
+  ASSERT_GT(make_key(Value("ab"), false), make_key(Value("abc"), false));
+}
+
+static vector<pair<int, string>> run_sort(const vector<pair<int, string>> &input, bool is_asc, int64_t memory_limit,
+    size_t *spilled_run_num)
+{
+  vector<vector<Value>> rows;
+  for (auto &[key, name] : input) {
+    rows.push_back({Value(key), Value(name.c_str())});
+  }
+
+  vector<OrderBySqlNode> order_by(1);
+  order_by[0].expr   = make_unique<CellExpr>(0);
+  order_by[0].is_asc = is_asc;
+
+  OrderByPhysicalOperator sort(std::move(order_by), memory_limit);
+  sort.add_child(make_unique<RowsPhysicalOperator>(std::move(rows)));
+
+  vector<pair<int, string>> results;
+  EXPECT_EQ(RC::SUCCESS, sort.open(nullptr));
+  RC rc = RC::SUCCESS;
+  while (RC::SUCCESS == (rc = sort.next())) {
+    Tuple *tuple = sort.current_tuple();
+    Value  key;
+    Value  name;
+    EXPECT_EQ(RC::SUCCESS, tuple->cell_at(0, key));
+    EXPECT_EQ(RC::SUCCESS, tuple->cell_at(1, name));
+    results.emplace_back(key.get_int(), name.get_string());
+  }
+  EXPECT_EQ(RC::RECORD_EOF, rc);
+  *spilled_run_num = sort.spilled_run_num();
+  EXPECT_EQ(RC::SUCCESS, sort.close());
+  return results;
+}
+
+static vector<pair<int, string>> make_input(int num)
+{
+  vector<pair<int, string>> input;
+  for (int i = 0; i < num; i++) {
+    input.emplace_back((i * 7919) % 97, "name_" + to_string(i));
+  }
+  return input;
+}
+
+TEST(OrderByPhysicalOperator, in_memory)
+{
+  vector<pair<int, string>> input = make_input(500);
+
+  size_t spilled_run_num = 0;
+  auto   results         = run_sort(input, true, OrderByPhysicalOperator::DEFAULT_MEMORY_LIMIT, &spilled_run_num);
+  ASSERT_EQ(0, spilled_run_num);
+
+  stable_sort(input.begin(), input.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+  ASSERT_EQ(input, results);
+}
+
+TEST(OrderByPhysicalOperator, spill)
+{
+  vector<pair<int, string>> input = make_input(5000);
+
+  size_t spilled_run_num = 0;
+  auto   results         = run_sort(input, false, 16 * 1024, &spilled_run_num);
+  ASSERT_GT(spilled_run_num, 1);
+
+  stable_sort(input.begin(), input.end(), [](const auto &a, const auto &b) { return a.first > b.first; });
+  ASSERT_EQ(input, results);
+}
+
+TEST(OrderByPhysicalOperator, empty_input)
+{
+  size_t spilled_run_num = 0;
+  auto   results         = run_sort({}, true, 1, &spilled_run_num);
+  ASSERT_TRUE(results.empty());
+}
+
+static vector<pair<int, string>> run_top_n(const vector<pair<int, string>> &input, bool is_asc, int limit, int offset)
+{
+  vector<vector<Value>> rows;
+  for (auto &[key, name] : input) {
+    rows.push_back({Value(key), Value(name.c_str())});
+  }
+
+  vector<OrderBySqlNode> order_by(1);
+  order_by[0].expr   = make_unique<CellExpr>(0);
+  order_by[0].is_asc = is_asc;
+
+  TopNPhysicalOperator top_n(std::move(order_by), limit, offset);
+  top_n.add_child(make_unique<RowsPhysicalOperator>(std::move(rows)));
+
+  vector<pair<int, string>> results;
+  EXPECT_EQ(RC::SUCCESS, top_n.open(nullptr));
+  RC rc = RC::SUCCESS;
+  while (RC::SUCCESS == (rc = top_n.next())) {
+    Tuple *tuple = top_n.current_tuple();
+    Value  key;
+    Value  name;
+    EXPECT_EQ(RC::SUCCESS, tuple->cell_at(0, key));
+    EXPECT_EQ(RC::SUCCESS, tuple->cell_at(1, name));
+    results.emplace_back(key.get_int(), name.get_string());
+  }
+  EXPECT_EQ(RC::RECORD_EOF, rc);
+  EXPECT_EQ(RC::SUCCESS, top_n.close());
+  return results;
+}
+
+TEST(TopNPhysicalOperator, limit_offset)
+{
+  vector<pair<int, string>> input = make_input(1000);
+
+  vector<pair<int, string>> sorted = input;
+  stable_sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+
+  const int limits[][2] = {{10, 0}, {10, 25}, {0, 5}, {1000, 0}, {20, 990}, {10, 2000}};
+  for (auto &[limit, offset] : limits) {
+    vector<pair<int, string>> expected;
+    for (int i = offset; i < offset + limit && i < static_cast<int>(sorted.size()); i++) {
+      expected.push_back(sorted[i]);
+    }
+    ASSERT_EQ(expected, run_top_n(input, true, limit, offset)) << "limit=" << limit << ", offset=" << offset;
+  }
+
+  stable_sort(input.begin(), input.end(), [](const auto &a, const auto &b) { return a.first > b.first; });
+  vector<pair<int, string>> expected(input.begin() + 3, input.begin() + 13);
+  ASSERT_EQ(expected, run_top_n(make_input(1000), false, 10, 3));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,117 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/18.
+//
+
+#include <string.h>
+
+#include "gtest/gtest.h"
+#include "storage/buffer/frame.h"
+#include "storage/buffer/page.h"
+#include "storage/buffer/page_allocation_map.h"
+
+using namespace std;
+
+// 第0个段100个页面，后面每个段64个页面
+static const int FIRST_SEGMENT_CAPACITY = 100;
+static const int SEGMENT_CAPACITY       = 64;
+
+TEST(PageAllocationMap, layout)
+{
+  PageAllocationMap alloc_map(FIRST_SEGMENT_CAPACITY, SEGMENT_CAPACITY);
+
+  ASSERT_EQ(0, alloc_map.segment_of(0));
+  ASSERT_EQ(0, alloc_map.segment_of(99));
+  ASSERT_EQ(1, alloc_map.segment_of(100));
+  ASSERT_EQ(1, alloc_map.segment_of(163));
+  ASSERT_EQ(2, alloc_map.segment_of(164));
+
+  ASSERT_EQ(0, alloc_map.segment_first_page(0));
+  ASSERT_EQ(100, alloc_map.segment_first_page(1));
+  ASSERT_EQ(164, alloc_map.segment_first_page(2));
+
+  ASSERT_FALSE(alloc_map.is_map_page(0));
+  ASSERT_FALSE(alloc_map.is_map_page(99));
+  ASSERT_TRUE(alloc_map.is_map_page(100));
+  ASSERT_FALSE(alloc_map.is_map_page(101));
+  ASSERT_TRUE(alloc_map.is_map_page(164));
+}
+
+TEST(PageAllocationMap, allocate)
+{
+  PageAllocationMap alloc_map(FIRST_SEGMENT_CAPACITY, SEGMENT_CAPACITY);
+
+  char  bitmaps[3][SEGMENT_CAPACITY];
+  Frame frames[3];
+  memset(bitmaps, 0, sizeof(bitmaps));
+
+  // 文件头页面总是已经分配的
+  bitmaps[0][0] = 0x01;
+  alloc_map.add_segment(&frames[0], bitmaps[0]);
+  ASSERT_EQ(1, alloc_map.allocated_page_num());
+
+  int page_count = 1;
+  ASSERT_EQ(BP_INVALID_PAGE_NUM, alloc_map.find_free_page(page_count));
+
+  // 写满第0个段
+  for (; page_count < FIRST_SEGMENT_CAPACITY; page_count++) {
+    ASSERT_EQ(&frames[0], alloc_map.set_bit(page_count));
+  }
+  ASSERT_EQ(FIRST_SEGMENT_CAPACITY, alloc_map.allocated_page_num());
+  ASSERT_EQ(BP_INVALID_PAGE_NUM, alloc_map.find_free_page(page_count));
+
+  // 新的段，第一个页面是位图页面
+  bitmaps[1][0] = 0x01;
+  alloc_map.add_segment(&frames[1], bitmaps[1]);
+  page_count++;
+  ASSERT_TRUE(alloc_map.contains(100));
+  ASSERT_FALSE(alloc_map.contains(164));
+  for (int i = 0; i < 10; i++, page_count++) {
+    ASSERT_EQ(&frames[1], alloc_map.set_bit(page_count));
+  }
+  ASSERT_EQ(BP_INVALID_PAGE_NUM, alloc_map.find_free_page(page_count));
+
+  // 总是先找到页号最小的空闲页面
+  ASSERT_EQ(&frames[1], alloc_map.clear_bit(105));
+  ASSERT_EQ(&frames[0], alloc_map.clear_bit(70));
+  ASSERT_EQ(70, alloc_map.find_free_page(page_count));
+  alloc_map.set_bit(70);
+  ASSERT_EQ(105, alloc_map.find_free_page(page_count));
+  alloc_map.set_bit(105);
+  ASSERT_EQ(BP_INVALID_PAGE_NUM, alloc_map.find_free_page(page_count));
+
+  ASSERT_TRUE(alloc_map.get_bit(105));
+  ASSERT_FALSE(alloc_map.get_bit(page_count));
+  ASSERT_EQ(page_count, alloc_map.allocated_page_num());
+
+  // 遍历时跳过位图页面
+  ASSERT_EQ(99, alloc_map.next_allocated_page(99, page_count));
+  ASSERT_EQ(101, alloc_map.next_allocated_page(100, page_count));
+  ASSERT_EQ(BP_INVALID_PAGE_NUM, alloc_map.next_allocated_page(page_count, page_count));
+
+  alloc_map.clear_bit(1);
+  alloc_map.clear_bit(2);
+  ASSERT_EQ(3, alloc_map.next_allocated_page(1, page_count));
+
+  // 重新加载位图时恢复空闲页面的信息
+  alloc_map.clear();
+  alloc_map.add_segment(&frames[0], bitmaps[0]);
+  alloc_map.add_segment(&frames[1], bitmaps[1]);
+  ASSERT_EQ(page_count - 2, alloc_map.allocated_page_num());
+  ASSERT_EQ(1, alloc_map.find_free_page(page_count));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
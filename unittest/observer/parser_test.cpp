@@ -64,6 +64,35 @@ TEST(ParserTest, DISABLED_group_by_test)
   }
 }
 
+TEST(ParserTest, limit_offset_test)
+{
+  {
+    ParsedSqlResult result;
+    const char     *sql = "select a from tab limit 10;";
+    ASSERT_EQ(parse(sql, &result), RC::SUCCESS);
+    ASSERT_EQ(result.sql_nodes().size(), 1);
+    ASSERT_EQ(result.sql_nodes()[0]->flag, SCF_SELECT);
+    ASSERT_EQ(result.sql_nodes()[0]->selection.limit->number, 10);
+    ASSERT_EQ(result.sql_nodes()[0]->selection.limit->offset, 0);
+  }
+  {
+    ParsedSqlResult result;
+    const char     *sql = "select a from tab limit 10 offset 20;";
+    ASSERT_EQ(parse(sql, &result), RC::SUCCESS);
+    ASSERT_EQ(result.sql_nodes()[0]->flag, SCF_SELECT);
+    ASSERT_EQ(result.sql_nodes()[0]->selection.limit->number, 10);
+    ASSERT_EQ(result.sql_nodes()[0]->selection.limit->offset, 20);
+  }
+  {
+    ParsedSqlResult result;
+    const char     *sql = "select a from tab limit 20, 10;";
+    ASSERT_EQ(parse(sql, &result), RC::SUCCESS);
+    ASSERT_EQ(result.sql_nodes()[0]->flag, SCF_SELECT);
+    ASSERT_EQ(result.sql_nodes()[0]->selection.limit->number, 10);
+    ASSERT_EQ(result.sql_nodes()[0]->selection.limit->offset, 20);
+  }
+}
+
 int main(int argc, char **argv)
 {
 
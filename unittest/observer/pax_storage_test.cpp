@@ -36,7 +36,7 @@ using namespace common;
 class PaxRecordFileScannerWithParam : public testing::TestWithParam<int>
 {};
 
-TEST_P(PaxRecordFileScannerWithParam, DISABLED_test_file_iterator)
+TEST_P(PaxRecordFileScannerWithParam, test_file_iterator)
 {
   int               record_insert_num = GetParam();
   VacuousLogHandler log_handler;
@@ -92,7 +92,7 @@ TEST_P(PaxRecordFileScannerWithParam, DISABLED_test_file_iterator)
   ASSERT_EQ(rc, RC::SUCCESS);
   Chunk     chunk;
   FieldMeta fm;
-  fm.init("col1", AttrType::INTS, 0, 4, true, 0);
+  fm.init("col1", AttrType::INTS, 0, 4, true, 0, false /*nullable*/);
   auto col1 = std::make_unique<Column>(fm, 2048);
   chunk.add_column(std::move(col1), 0);
   count = 0;
@@ -176,7 +176,7 @@ TEST_P(PaxRecordFileScannerWithParam, DISABLED_test_file_iterator)
 class PaxPageHandlerTestWithParam : public testing::TestWithParam<int>
 {};
 
-TEST_P(PaxPageHandlerTestWithParam, DISABLED_PaxPageHandler)
+TEST_P(PaxPageHandlerTestWithParam, PaxPageHandler)
 {
   int               record_num = GetParam();
   VacuousLogHandler log_handler;
@@ -259,10 +259,10 @@ TEST_P(PaxPageHandlerTestWithParam, DISABLED_PaxPageHandler)
 
   Chunk     chunk1;
   FieldMeta fm1, fm2, fm3, fm4;
-  fm1.init("col1", AttrType::INTS, 0, 4, true, 0);
-  fm2.init("col2", AttrType::FLOATS, 4, 4, true, 1);
-  fm3.init("col3", AttrType::CHARS, 8, 4, true, 2);
-  fm4.init("col4", AttrType::CHARS, 12, 7, true, 3);
+  fm1.init("col1", AttrType::INTS, 0, 4, true, 0, false /*nullable*/);
+  fm2.init("col2", AttrType::FLOATS, 4, 4, true, 1, false /*nullable*/);
+  fm3.init("col3", AttrType::CHARS, 8, 4, true, 2, false /*nullable*/);
+  fm4.init("col4", AttrType::CHARS, 12, 7, true, 3, false /*nullable*/);
   auto col_1 = std::make_unique<Column>(fm1, 2048);
   chunk1.add_column(std::move(col_1), 0);
   auto col_2 = std::make_unique<Column>(fm2, 2048);
@@ -271,7 +271,8 @@ TEST_P(PaxPageHandlerTestWithParam, DISABLED_PaxPageHandler)
   chunk1.add_column(std::move(col_3), 2);
   auto col_4 = std::make_unique<Column>(fm4, 2048);
   chunk1.add_column(std::move(col_4), 3);
-  rc = record_page_handle->get_chunk(chunk1);
+  SlotNum start_slot = 0;
+  rc                 = record_page_handle->get_chunk(chunk1, start_slot);
   ASSERT_EQ(rc, RC::SUCCESS);
   ASSERT_EQ(chunk1.rows(), record_num);
   for (int i = 0; i < record_num; i++) {
@@ -285,10 +286,11 @@ TEST_P(PaxPageHandlerTestWithParam, DISABLED_PaxPageHandler)
 
   Chunk     chunk2;
   FieldMeta fm2_1;
-  fm2_1.init("col2", AttrType::FLOATS, 4, 4, true, 1);
+  fm2_1.init("col2", AttrType::FLOATS, 4, 4, true, 1, false /*nullable*/);
   auto col_2_1 = std::make_unique<Column>(fm2_1, 2048);
   chunk2.add_column(std::move(col_2_1), 1);
-  rc = record_page_handle->get_chunk(chunk2);
+  start_slot = 0;
+  rc         = record_page_handle->get_chunk(chunk2, start_slot);
   ASSERT_EQ(rc, RC::SUCCESS);
   ASSERT_EQ(chunk2.rows(), record_num);
   for (int i = 0; i < record_num; i++) {
@@ -315,7 +317,8 @@ TEST_P(PaxPageHandlerTestWithParam, DISABLED_PaxPageHandler)
 
   // get chunk
   chunk1.reset_data();
-  record_page_handle->get_chunk(chunk1);
+  start_slot = 0;
+  record_page_handle->get_chunk(chunk1, start_slot);
   ASSERT_EQ(chunk1.rows(), record_num - delete_num);
 
   int col1_expected = (int_base + 0 + int_base + record_num - 1) * record_num /2;
@@ -340,6 +343,84 @@ TEST_P(PaxPageHandlerTestWithParam, DISABLED_PaxPageHandler)
   delete bpm;
 }
 
+TEST(PaxChunkScanner, morsel_scan)
+{
+  VacuousLogHandler log_handler;
+
+  const char *record_manager_file = "morsel_scan.bp";
+  filesystem::remove(record_manager_file);
+
+  BufferPoolManager *bpm = new BufferPoolManager();
+  ASSERT_EQ(RC::SUCCESS, bpm->init(make_unique<VacuousDoubleWriteBuffer>()));
+  DiskBufferPool *bp = nullptr;
+  ASSERT_EQ(bpm->create_file(record_manager_file), RC::SUCCESS);
+  ASSERT_EQ(bpm->open_file(log_handler, record_manager_file, bp), RC::SUCCESS);
+
+  TableMeta table_meta;
+  table_meta.fields_.resize(2);
+  table_meta.fields_[0].attr_type_ = AttrType::INTS;
+  table_meta.fields_[0].attr_len_  = 4;
+  table_meta.fields_[0].field_id_  = 0;
+  table_meta.fields_[1].attr_type_ = AttrType::INTS;
+  table_meta.fields_[1].attr_len_  = 4;
+  table_meta.fields_[1].field_id_  = 1;
+
+  RecordFileHandler file_handler(StorageFormat::PAX_FORMAT);
+  ASSERT_EQ(file_handler.init(*bp, log_handler, &table_meta), RC::SUCCESS);
+
+  // 记录分布在多个页面中
+  const int record_num = 100000;
+  int64_t   expected   = 0;
+  for (int i = 0; i < record_num; i++) {
+    int record_data[2] = {i, 0};
+    RID rid;
+    ASSERT_EQ(file_handler.insert_record(reinterpret_cast<char *>(record_data), sizeof(record_data), &rid), RC::SUCCESS);
+    expected += i;
+  }
+
+  Table table;
+  table.table_meta_.storage_format_ = StorageFormat::PAX_FORMAT;
+
+  // 多个线程共享一个 MorselQueue，每个页面只会被一个线程扫描
+  const int        thread_num = 4;
+  MorselQueue      morsels(2 /*morsel_size*/);
+  ChunkFileScanner scanners[thread_num];
+  for (ChunkFileScanner &scanner : scanners) {
+    ASSERT_EQ(scanner.open_scan_chunk(&table, *bp, log_handler, ReadWriteMode::READ_ONLY, &morsels), RC::SUCCESS);
+  }
+
+  atomic<int>     count{0};
+  atomic<int64_t> sum{0};
+  vector<thread>  threads;
+  for (ChunkFileScanner &scanner : scanners) {
+    threads.emplace_back([&scanner, &count, &sum]() {
+      FieldMeta fm;
+      fm.init("col1", AttrType::INTS, 0, 4, true, 0, false /*nullable*/);
+      Chunk chunk;
+      chunk.add_column(make_unique<Column>(fm, BP_PAGE_DATA_SIZE / sizeof(int)), 0);
+      while (OB_SUCC(scanner.next_chunk(chunk))) {
+        for (int i = 0; i < chunk.rows(); i++) {
+          sum += chunk.get_value(0, i).get_int();
+        }
+        count += chunk.rows();
+        chunk.reset_data();
+      }
+    });
+  }
+  for (thread &t : threads) {
+    t.join();
+  }
+  ASSERT_EQ(count.load(), record_num);
+  ASSERT_EQ(sum.load(), expected);
+
+  for (ChunkFileScanner &scanner : scanners) {
+    scanner.close_scan();
+  }
+  bpm->close_file(record_manager_file);
+  delete bpm;
+  filesystem::remove(record_manager_file);
+}
+
 INSTANTIATE_TEST_SUITE_P(PaxFileScannerTests, PaxRecordFileScannerWithParam, testing::Values(1, 10, 100, 1000, 2000, 10000));
 
 INSTANTIATE_TEST_SUITE_P(PaxPageTests, PaxPageHandlerTestWithParam, testing::Values(1, 10, 100, 337));
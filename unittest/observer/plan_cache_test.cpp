@@ -0,0 +1,177 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#include <memory>
+
+#include "sql/expr/expression.h"
+#include "sql/operator/predicate_physical_operator.h"
+#include "sql/plan_cache/plan_cache.h"
+#include "rows_physical_operator.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace common;
+
+/**
+ * @brief 按照下标取元组中的值
+ */
+class CellExpr : public Expression
+{
+public:
+  explicit CellExpr(int index) : index_(index) {}
+
+  RC       get_value(const Tuple &tuple, Value &value) override { return tuple.cell_at(index_, value); }
+  ExprType type() const override { return ExprType::FIELD; }
+  AttrType value_type() const override { return AttrType::INTS; }
+
+private:
+  int index_;
+};
+
+static string parameterize(const char *sql, vector<PlanCacheLiteral> &literals)
+{
+  string text;
+  EXPECT_TRUE(PlanCache::parameterize(sql, text, literals)) << sql;
+  return text;
+}
+
+TEST(PlanCache, parameterize)
+{
+  vector<PlanCacheLiteral> literals;
+
+  string text = parameterize("select a,  b from t where a = 10 and  b='abc' and c>1.5;", literals);
+  ASSERT_EQ("select a , b from t where a = ?i and b = ?s and c > ?f ;", text);
+  ASSERT_EQ(3, literals.size());
+  ASSERT_EQ(10, literals[0].value.get_int());
+  ASSERT_EQ("abc", literals[1].value.get_string());
+  ASSERT_EQ(1.5f, literals[2].value.get_float());
+  ASSERT_FALSE(literals[0].fixed);
+
+  // 只有常量不同的语句得到相同的结果
+  ASSERT_EQ(text, parameterize("select a, b from t where a=20 and b=\"\" and c > 2.25;", literals));
+  ASSERT_EQ("", literals[1].value.get_string());
+
+  // 投影中的常量原样保留，LIMIT 的参数不是常量
+  text = parameterize("select a + 1, 'x' from t where a < 3 limit 5 offset 2;", literals);
+  ASSERT_EQ("select a + 1 , 'x' from t where a < ?i limit 5 offset 2 ;", text);
+  ASSERT_EQ(3, literals.size());
+  ASSERT_TRUE(literals[0].fixed);
+  ASSERT_TRUE(literals[1].fixed);
+  ASSERT_FALSE(literals[2].fixed);
+
+  // 子查询中的 FROM 不影响投影中常量的判断
+  text = parameterize("select (select 1 from t2 where b = 2) from t where a <= 3;", literals);
+  ASSERT_EQ("select ( select 1 from t2 where b = 2 ) from t where a <= ?i ;", text);
+  ASSERT_EQ(3, literals.size());
+
+  ASSERT_NE(parameterize("select a from t where a <= 1;", literals),
+      parameterize("select a from t where a < = 1;", literals));
+
+  string other;
+  ASSERT_FALSE(PlanCache::parameterize("insert into t values(1);", other, literals));
+  ASSERT_FALSE(PlanCache::parameterize("select a from t where b = 'abc;", other, literals));
+  ASSERT_FALSE(PlanCache::parameterize("  ", other, literals));
+}
+
+/**
+ * @brief 生成计划 select * from numbers where cell < param
+ */
+static unique_ptr<PhysicalOperator> make_plan(int num, int param, int param_index)
+{
+  auto value_expr = make_unique<ValueExpr>(Value(param));
+  value_expr->set_param_index(param_index);
+  auto comparison = make_unique<ComparisonExpr>(LESS_THAN, make_unique<CellExpr>(0), std::move(value_expr));
+
+  auto predicate = make_unique<PredicatePhysicalOperator>(std::move(comparison));
+  predicate->add_child(make_unique<RowsPhysicalOperator>(num));
+  return predicate;
+}
+
+TEST(PlanCache, reuse_plan)
+{
+  PlanCache cache;
+
+  vector<PlanCacheLiteral> literals;
+  string                   text = parameterize("select * from numbers where cell < 10;", literals);
+
+  bool                         used_chunk_mode = true;
+  unique_ptr<PhysicalOperator> plan;
+  ASSERT_EQ(RC::NOTFOUND, cache.get(text, 1, literals, plan, used_chunk_mode));
+  ASSERT_EQ(1, cache.miss_count());
+
+  plan = make_plan(100, 10, 0);
+  ASSERT_EQ(RC::SUCCESS, cache.put(text, 1, literals, plan, false));
+  ASSERT_EQ(10, run_plan(*plan));
+  plan.reset();
+
+  ASSERT_EQ(text, parameterize("select * from numbers where cell < 42;", literals));
+  ASSERT_EQ(RC::SUCCESS, cache.get(text, 1, literals, plan, used_chunk_mode));
+  ASSERT_FALSE(used_chunk_mode);
+  ASSERT_EQ(1, cache.hit_count());
+
+  // 计划正在使用时不能再取出来
+  unique_ptr<PhysicalOperator> other_plan;
+  ASSERT_EQ(RC::NOTFOUND, cache.get(text, 1, literals, other_plan, used_chunk_mode));
+
+  ASSERT_EQ(42, run_plan(*plan));
+  plan.reset();
+
+  // 模式版本号变化以后缓存失效
+  ASSERT_EQ(RC::NOTFOUND, cache.get(text, 2, literals, plan, used_chunk_mode));
+  ASSERT_EQ(0, cache.size());
+  ASSERT_EQ(1, cache.hit_count());
+  ASSERT_EQ(3, cache.miss_count());
+}
+
+TEST(PlanCache, uncacheable_plan)
+{
+  PlanCache cache;
+
+  vector<PlanCacheLiteral> literals;
+  string                   text = parameterize("select * from numbers where cell < 10;", literals);
+
+  // 常量在计划中找不到(比如被折叠了)
+  unique_ptr<PhysicalOperator> plan = make_plan(100, 10, -1);
+  ASSERT_EQ(RC::UNSUPPORTED, cache.put(text, 1, literals, plan, false));
+  ASSERT_EQ(PhysicalOperatorType::PREDICATE, plan->type());
+
+  // 常量的值与SQL中的不一致(比如做了类型转换)
+  plan = make_plan(100, 11, 0);
+  ASSERT_EQ(RC::UNSUPPORTED, cache.put(text, 1, literals, plan, false));
+  ASSERT_EQ(0, cache.size());
+}
+
+TEST(PlanCache, capacity)
+{
+  PlanCache cache(2);
+
+  vector<PlanCacheLiteral> literals;
+  string                   text = parameterize("select * from numbers where cell < 10;", literals);
+  for (int i = 0; i < 3; i++) {
+    unique_ptr<PhysicalOperator> plan = make_plan(100, 10, 0);
+    ASSERT_EQ(RC::SUCCESS, cache.put(text + to_string(i), 1, literals, plan, false));
+  }
+  ASSERT_EQ(2, cache.size());
+
+  bool                         used_chunk_mode = false;
+  unique_ptr<PhysicalOperator> plan;
+  ASSERT_EQ(RC::NOTFOUND, cache.get(text + "0", 1, literals, plan, used_chunk_mode));
+  ASSERT_EQ(RC::SUCCESS, cache.get(text + "2", 1, literals, plan, used_chunk_mode));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
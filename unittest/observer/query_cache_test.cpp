@@ -0,0 +1,130 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#include <memory>
+
+#include "sql/query_cache/query_cache.h"
+#include "storage/table/table.h"
+#include "rows_physical_operator.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace common;
+
+/**
+ * @brief 执行一次查询并缓存结果
+ */
+static void record(QueryCache &cache, const string &key, const vector<const BaseTable *> &tables, int num,
+    int read_num = -1)
+{
+  QueryCacheRecordPhysicalOperator oper(
+      cache, key, 1, QueryCache::table_versions(tables), make_unique<RowsPhysicalOperator>(num));
+  ASSERT_EQ(read_num < 0 ? num : read_num, run_plan(oper, read_num));
+}
+
+TEST(QueryCache, cacheable)
+{
+  ASSERT_TRUE(QueryCache::cacheable("select * from t;"));
+  ASSERT_TRUE(QueryCache::cacheable("  SELECT a from t where b = 'select';"));
+  ASSERT_FALSE(QueryCache::cacheable("select * from t where a in (select b from t2);"));
+  ASSERT_FALSE(QueryCache::cacheable("insert into t values(1);"));
+  ASSERT_FALSE(QueryCache::cacheable("explain select * from t;"));
+  ASSERT_FALSE(QueryCache::cacheable("create table t2 as select * from t;"));
+  ASSERT_FALSE(QueryCache::cacheable("select * from t where b = 'abc;"));
+}
+
+TEST(QueryCache, hit_and_invalidate)
+{
+  QueryCache cache;
+  Table      table;
+
+  vector<const BaseTable *>          tables = {&table};
+  shared_ptr<const QueryCacheResult> result;
+  ASSERT_EQ(RC::NOTFOUND, cache.get("q", 1, result));
+
+  record(cache, "q", tables, 100);
+  ASSERT_EQ(1, cache.size());
+  ASSERT_EQ(RC::SUCCESS, cache.get("q", 1, result));
+  ASSERT_EQ(100, result->rows.size());
+
+  QueryCacheResultPhysicalOperator replay(result);
+  ASSERT_EQ(PhysicalOperatorType::CACHED_RESULT, replay.type());
+  ASSERT_EQ(100, run_plan(replay));
+  ASSERT_EQ(100, run_plan(replay));
+
+  TupleSchema schema;
+  ASSERT_EQ(RC::SUCCESS, replay.tuple_schema(schema));
+  ASSERT_EQ(2, schema.cell_num());
+  ASSERT_STREQ("name", schema.cell_at(1).field_name());
+
+  // 表中的数据变化以后缓存失效
+  table.increase_data_version();
+  ASSERT_EQ(RC::NOTFOUND, cache.get("q", 1, result));
+  ASSERT_EQ(0, cache.size());
+  ASSERT_EQ(0, cache.memory_usage());
+
+  // 模式版本号变化以后缓存失效
+  record(cache, "q", tables, 10);
+  ASSERT_EQ(RC::NOTFOUND, cache.get("q", 2, result));
+  ASSERT_EQ(1, cache.hit_count());
+  ASSERT_EQ(3, cache.miss_count());
+}
+
+TEST(QueryCache, incomplete_result)
+{
+  QueryCache cache;
+  Table      table;
+
+  // 没有读完的结果不缓存
+  record(cache, "q", {&table}, 100, 10);
+  ASSERT_EQ(0, cache.size());
+
+  // 结果超过内存上限不缓存
+  cache.set_memory_limit(1024);
+  record(cache, "q", {&table}, 100);
+  ASSERT_EQ(0, cache.size());
+}
+
+TEST(QueryCache, memory_limit)
+{
+  QueryCache cache;
+  Table      table;
+
+  for (int i = 0; i < 10; i++) {
+    record(cache, "q" + to_string(i), {&table}, 100);
+  }
+  ASSERT_EQ(10, cache.size());
+
+  // 调小内存上限时淘汰最久没有使用的缓存项
+  shared_ptr<const QueryCacheResult> result;
+  ASSERT_EQ(RC::SUCCESS, cache.get("q0", 1, result));
+  cache.set_memory_limit(cache.memory_usage() / 3);
+  ASSERT_LE(cache.memory_usage(), cache.memory_limit());
+  ASSERT_EQ(3, cache.size());
+  ASSERT_EQ(RC::SUCCESS, cache.get("q0", 1, result));
+  ASSERT_EQ(RC::SUCCESS, cache.get("q9", 1, result));
+  ASSERT_EQ(RC::NOTFOUND, cache.get("q1", 1, result));
+
+  // 放入新的结果时淘汰旧的
+  record(cache, "q10", {&table}, 100);
+  ASSERT_EQ(3, cache.size());
+  ASSERT_EQ(RC::SUCCESS, cache.get("q10", 1, result));
+  ASSERT_LE(cache.memory_usage(), cache.memory_limit());
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -204,14 +204,14 @@ TEST(RecordFileScanner, test_record_file_iterator)
   delete bpm;
 }
 
-TEST(RecordManager, durability)
+/*
+ * 测试场景：
+ * 1. 创建一个文件，插入一些记录
+ * 2. 随机进行插入、更新、删除操作
+ * 3. 重启数据库，使用 replay_worker_num 个线程回放日志，检查记录是否恢复
+ */
+void test_durability(int replay_worker_num)
 {
-  /*
-   * 测试场景：
-   * 1. 创建一个文件，插入一些记录
-   * 2. 随机进行插入、更新、删除操作
-   * 3. 重启数据库，检查记录是否恢复
-   */
   filesystem::path directory("record_manager_durability");
   filesystem::remove_all(directory);
   ASSERT_TRUE(filesystem::create_directories(directory));
@@ -337,9 +337,10 @@ TEST(RecordManager, durability)
   ASSERT_EQ(bpm2.open_file(log_handler2, record_manager_file.c_str(), buffer_pool2), RC::SUCCESS);
   ASSERT_NE(buffer_pool2, nullptr);
 
-  IntegratedLogReplayer log_replayer2(bpm2);
+  IntegratedLogReplayer log_replayer2(bpm2, replay_worker_num);
   ASSERT_EQ(log_handler2.init(directory.c_str()), RC::SUCCESS);
   ASSERT_EQ(log_handler2.replay(log_replayer2, 0), RC::SUCCESS);
+  ASSERT_EQ(log_replayer2.on_done(), RC::SUCCESS);
   ASSERT_EQ(log_handler2.start(), RC::SUCCESS);
 
   RecordFileHandler record_file_handler2(StorageFormat::ROW_FORMAT);
@@ -355,6 +356,13 @@ TEST(RecordManager, durability)
   bpm2.close_file(record_manager_file.c_str());
 }
 
+TEST(RecordManager, durability) { test_durability(1 /*replay_worker_num*/); }
+
+#ifdef CONCURRENCY
+// 非 CONCURRENCY 模式下 IntegratedLogReplayer 会退化成单线程回放，这个用例就和 durability 重复了
+TEST(RecordManager, parallel_replay) { test_durability(4 /*replay_worker_num*/); }
+#endif
+
 int main(int argc, char **argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,92 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created on 2026/10/17.
+//
+
+#pragma once
+
+#include "common/lang/string.h"
+#include "sql/expr/tuple.h"
+#include "sql/operator/physical_operator.h"
+#include "gtest/gtest.h"
+
+/**
+ * @brief 测试用的算子，输出 num 行 (id, name)，第 i 行是 (i, "name_i")
+ */
+class RowsPhysicalOperator : public PhysicalOperator
+{
+public:
+  explicit RowsPhysicalOperator(int num) : num_(num)
+  {
+    tuple_.set_names({TupleCellSpec("t", "id"), TupleCellSpec("t", "name")});
+  }
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::STRING_LIST; }
+
+  RC open(Trx *) override
+  {
+    pos_ = -1;
+    return RC::SUCCESS;
+  }
+
+  RC next() override
+  {
+    if (++pos_ >= num_) {
+      return RC::RECORD_EOF;
+    }
+    tuple_.set_cells({Value(pos_), Value(("name_" + std::to_string(pos_)).c_str())});
+    return RC::SUCCESS;
+  }
+
+  RC     close() override { return RC::SUCCESS; }
+  Tuple *current_tuple() override { return &tuple_; }
+
+  RC tuple_schema(TupleSchema &schema) const override
+  {
+    schema.append_cell("t", "id");
+    schema.append_cell("t", "name");
+    return RC::SUCCESS;
+  }
+
+  RC visit_expressions(const function<RC(unique_ptr<Expression> &)> &) override { return RC::SUCCESS; }
+
+private:
+  int            num_;
+  int            pos_ = -1;
+  ValueListTuple tuple_;
+};
+
+/**
+ * @brief 执行计划，检查输出的是 RowsPhysicalOperator 的前若干行
+ * @param read_num 最多读取多少行，小于0时读到结束
+ * @return 读到的行数
+ */
+inline int run_plan(PhysicalOperator &plan, int read_num = -1)
+{
+  int count = 0;
+  EXPECT_EQ(RC::SUCCESS, plan.open(nullptr));
+  RC rc = RC::SUCCESS;
+  while (count != read_num && RC::SUCCESS == (rc = plan.next())) {
+    Value id;
+    Value name;
+    EXPECT_EQ(RC::SUCCESS, plan.current_tuple()->cell_at(0, id));
+    EXPECT_EQ(RC::SUCCESS, plan.current_tuple()->cell_at(1, name));
+    EXPECT_EQ(count, id.get_int());
+    EXPECT_EQ("name_" + std::to_string(count), name.get_string());
+    count++;
+  }
+  if (read_num < 0) {
+    EXPECT_EQ(RC::RECORD_EOF, rc);
+  }
+  EXPECT_EQ(RC::SUCCESS, plan.close());
+  return count;
+}